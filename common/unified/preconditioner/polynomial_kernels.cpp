@@ -0,0 +1,132 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2022, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+
+#include "core/preconditioner/polynomial_kernels.hpp"
+
+
+#include <ginkgo/core/base/math.hpp>
+
+
+#include "common/unified/base/kernel_launch.hpp"
+
+
+namespace gko {
+namespace kernels {
+namespace GKO_DEVICE_NAMESPACE {
+/**
+ * @brief The Polynomial preconditioner namespace.
+ *
+ * @ingroup polynomial
+ */
+namespace polynomial {
+
+
+template <typename ValueType>
+void horner_step(std::shared_ptr<const DefaultExecutor> exec,
+                 ValueType alpha, const matrix::Dense<ValueType>* y,
+                 ValueType beta, ValueType gamma,
+                 const matrix::Dense<ValueType>* b,
+                 matrix::Dense<ValueType>* x)
+{
+    if (is_zero(beta)) {
+        run_kernel(
+            exec,
+            [] GKO_KERNEL(auto row, auto col, auto alpha, auto y, auto gamma,
+                          auto b, auto x) {
+                x(row, col) = alpha * y(row, col) + gamma * b(row, col);
+            },
+            x->get_size(), alpha, y, gamma, b, x);
+    } else {
+        run_kernel(
+            exec,
+            [] GKO_KERNEL(auto row, auto col, auto alpha, auto y, auto beta,
+                          auto gamma, auto b, auto x) {
+                x(row, col) = alpha * y(row, col) + beta * x(row, col) +
+                              gamma * b(row, col);
+            },
+            x->get_size(), alpha, y, beta, gamma, b, x);
+    }
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_TYPE(GKO_DECLARE_POLYNOMIAL_HORNER_STEP_KERNEL);
+
+
+template <typename ValueType>
+void chebyshev_initialize(std::shared_ptr<const DefaultExecutor> exec,
+                          const matrix::Dense<ValueType>* b,
+                          ValueType inv_theta, matrix::Dense<ValueType>* r,
+                          matrix::Dense<ValueType>* d,
+                          matrix::Dense<ValueType>* x)
+{
+    run_kernel(
+        exec,
+        [] GKO_KERNEL(auto row, auto col, auto b, auto inv_theta, auto r,
+                      auto d, auto x) {
+            const auto b_val = b(row, col);
+            r(row, col) = b_val;
+            d(row, col) = x(row, col) = inv_theta * b_val;
+        },
+        b->get_size(), b, inv_theta, r, d, x);
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_TYPE(
+    GKO_DECLARE_POLYNOMIAL_CHEBYSHEV_INITIALIZE_KERNEL);
+
+
+template <typename ValueType>
+void chebyshev_step(std::shared_ptr<const DefaultExecutor> exec,
+                    const matrix::Dense<ValueType>* ad, ValueType c_d,
+                    ValueType c_r, matrix::Dense<ValueType>* r,
+                    matrix::Dense<ValueType>* d, matrix::Dense<ValueType>* x)
+{
+    run_kernel(
+        exec,
+        [] GKO_KERNEL(auto row, auto col, auto ad, auto c_d, auto c_r, auto r,
+                      auto d, auto x) {
+            const auto r_val = r(row, col) - ad(row, col);
+            const auto d_val = c_d * d(row, col) + c_r * r_val;
+            r(row, col) = r_val;
+            d(row, col) = d_val;
+            x(row, col) += d_val;
+        },
+        x->get_size(), ad, c_d, c_r, r, d, x);
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_TYPE(
+    GKO_DECLARE_POLYNOMIAL_CHEBYSHEV_STEP_KERNEL);
+
+
+}  // namespace polynomial
+}  // namespace GKO_DEVICE_NAMESPACE
+}  // namespace kernels
+}  // namespace gko
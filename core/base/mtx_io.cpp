@@ -38,6 +38,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <cstring>
 #include <limits>
 #include <map>
+#include <numeric>
 #include <regex>
 #include <string>
 #include <type_traits>
@@ -912,6 +913,174 @@ matrix_data<ValueType, IndexType> read_binary_raw(std::istream& is)
 }
 
 
+/**
+ * Returns the magic number at the end of the row block index trailer written
+ * by write_binary_indexed_raw.
+ */
+static constexpr uint64 binary_index_magic()
+{
+    constexpr char name[] = "GKOROWIX";
+    uint64 magic{};
+    for (int i = 7; i >= 0; i--) {
+        magic = magic * 256 + static_cast<uint64>(name[i]);
+    }
+    return magic;
+}
+
+
+namespace {
+
+
+template <typename FileValueType, typename FileIndexType>
+struct binary_entry_reader {
+    static constexpr auto entry_binary_size =
+        sizeof(FileValueType) + 2 * sizeof(FileIndexType);
+
+    uint64 read_row(uint64 entry)
+    {
+        FileIndexType row{};
+        GKO_CHECK_STREAM(
+            is.seekg(entries_begin +
+                     static_cast<std::streamoff>(entry * entry_binary_size)),
+            "failed seeking entry " + std::to_string(entry));
+        GKO_CHECK_STREAM(
+            is.read(reinterpret_cast<char*>(&row), sizeof(FileIndexType)),
+            "failed reading entry " + std::to_string(entry));
+        return static_cast<uint64>(row);
+    }
+
+    // returns the first entry in [begin, end) with a row index >= row
+    uint64 lower_bound(uint64 row, uint64 begin, uint64 end)
+    {
+        while (begin < end) {
+            const auto mid = begin + (end - begin) / 2;
+            if (read_row(mid) < row) {
+                begin = mid + 1;
+            } else {
+                end = mid;
+            }
+        }
+        return begin;
+    }
+
+    std::istream& is;
+    std::streamoff entries_begin;
+};
+
+
+template <typename FileValueType, typename FileIndexType, typename ValueType,
+          typename IndexType>
+matrix_data<ValueType, IndexType> read_binary_rows_convert(
+    std::istream& is, std::streamoff begin, uint64 num_rows, uint64 num_cols,
+    uint64 num_entries, span rows)
+{
+    binary_entry_reader<FileValueType, FileIndexType> reader{is, begin + 32};
+    const auto entries_end =
+        reader.entries_begin +
+        static_cast<std::streamoff>(num_entries * reader.entry_binary_size);
+    const auto row_begin = std::min<uint64>(rows.begin, num_rows);
+    const auto row_end = std::min<uint64>(rows.end, num_rows);
+    // narrow down the search range using the row block index, if available
+    uint64 first_lo = 0;
+    uint64 first_hi = num_entries;
+    uint64 last_lo = 0;
+    uint64 last_hi = num_entries;
+    GKO_CHECK_STREAM(is.seekg(0, std::ios_base::end),
+                     "failed seeking end of stream");
+    const auto stream_end = static_cast<std::streamoff>(is.tellg());
+    if (stream_end >= entries_end + 24) {
+        std::array<uint64, 3> trailer{};
+        GKO_CHECK_STREAM(is.seekg(stream_end - 24), "failed seeking trailer");
+        GKO_CHECK_STREAM(is.read(reinterpret_cast<char*>(trailer.data()), 24),
+                         "failed reading trailer");
+        const auto rows_per_block = trailer[0];
+        const auto num_blocks = trailer[1];
+        if (trailer[2] == binary_index_magic() && rows_per_block > 0 &&
+            stream_end ==
+                entries_end +
+                    static_cast<std::streamoff>((num_blocks + 1) * 8 + 24)) {
+            auto block_offset = [&](uint64 block) {
+                uint64 offset{};
+                block = std::min(block, num_blocks);
+                GKO_CHECK_STREAM(
+                    is.seekg(entries_end +
+                             static_cast<std::streamoff>(block * 8)),
+                    "failed seeking row block index");
+                GKO_CHECK_STREAM(
+                    is.read(reinterpret_cast<char*>(&offset), 8),
+                    "failed reading row block index");
+                return offset;
+            };
+            first_lo = block_offset(row_begin / rows_per_block);
+            first_hi = block_offset(row_begin / rows_per_block + 1);
+            last_lo = block_offset(row_end / rows_per_block);
+            last_hi = block_offset(row_end / rows_per_block + 1);
+        }
+    }
+    const auto first = reader.lower_bound(row_begin, first_lo, first_hi);
+    const auto last =
+        std::max(first, reader.lower_bound(row_end, last_lo, last_hi));
+    GKO_CHECK_STREAM(
+        is.seekg(reader.entries_begin +
+                 static_cast<std::streamoff>(first * reader.entry_binary_size)),
+        "failed seeking entry " + std::to_string(first));
+    auto result = read_binary_convert<FileValueType, FileIndexType, ValueType,
+                                      IndexType>(is, num_rows, num_cols,
+                                                 last - first);
+    for (const auto& entry : result.nonzeros) {
+        if (static_cast<uint64>(entry.row) < row_begin ||
+            static_cast<uint64>(entry.row) >= row_end) {
+            throw GKO_STREAM_ERROR("entries are not sorted by row index");
+        }
+    }
+    return result;
+}
+
+
+}  // namespace
+
+
+template <typename ValueType, typename IndexType>
+matrix_data<ValueType, IndexType> read_binary_rows_raw(std::istream& is,
+                                                       span rows)
+{
+    const auto begin = static_cast<std::streamoff>(is.tellg());
+    GKO_CHECK_STREAM(is, "failed reading stream position");
+    std::array<char, 32> header{};
+    GKO_CHECK_STREAM(is.read(header.data(), 32), "failed reading header");
+    uint64 magic{};
+    uint64 num_rows{};
+    uint64 num_cols{};
+    uint64 num_entries{};
+    std::memcpy(&magic, &header[0], 8);
+    std::memcpy(&num_rows, &header[8], 8);
+    std::memcpy(&num_cols, &header[16], 8);
+    std::memcpy(&num_entries, &header[24], 8);
+#define DECLARE_OVERLOAD(_vtype, _itype)                                       \
+    else if (magic == binary_format_magic<_vtype, _itype>())                   \
+    {                                                                          \
+        return read_binary_rows_convert<_vtype, _itype, ValueType, IndexType>( \
+            is, begin, num_rows, num_cols, num_entries, rows);                 \
+    }
+    if (false) {
+    }
+    DECLARE_OVERLOAD(double, int32)
+    DECLARE_OVERLOAD(float, int32)
+    DECLARE_OVERLOAD(std::complex<double>, int32)
+    DECLARE_OVERLOAD(std::complex<float>, int32)
+    DECLARE_OVERLOAD(double, int64)
+    DECLARE_OVERLOAD(float, int64)
+    DECLARE_OVERLOAD(std::complex<double>, int64)
+    DECLARE_OVERLOAD(std::complex<float>, int64)
+#undef DECLARE_OVERLOAD
+    else
+    {
+        throw GKO_STREAM_ERROR("invalid header magic number '" +
+                               std::string(header.data(), 8) + "'");
+    }
+}
+
+
 template <typename ValueType, typename IndexType>
 matrix_data<ValueType, IndexType> read_generic_raw(std::istream& is)
 {
@@ -955,6 +1124,37 @@ void write_binary_raw(std::ostream& os,
 }
 
 
+template <typename ValueType, typename IndexType>
+void write_binary_indexed_raw(std::ostream& os,
+                              const matrix_data<ValueType, IndexType>& data,
+                              size_type rows_per_block)
+{
+    if (rows_per_block == 0) {
+        throw GKO_STREAM_ERROR("rows_per_block must be positive");
+    }
+    auto sorted = data;
+    sorted.ensure_row_major_order();
+    write_binary_raw(os, sorted);
+    const uint64 num_blocks = ceildiv(sorted.size[0], rows_per_block);
+    std::vector<uint64> block_offsets(num_blocks + 1);
+    for (const auto& entry : sorted.nonzeros) {
+        block_offsets[entry.row / rows_per_block + 1]++;
+    }
+    std::partial_sum(block_offsets.begin(), block_offsets.end(),
+                     block_offsets.begin());
+    GKO_CHECK_STREAM(
+        os.write(reinterpret_cast<const char*>(block_offsets.data()),
+                 block_offsets.size() * sizeof(uint64)),
+        "failed writing row block index");
+    std::array<uint64, 3> trailer{static_cast<uint64>(rows_per_block),
+                                  num_blocks, binary_index_magic()};
+    GKO_CHECK_STREAM(
+        os.write(reinterpret_cast<const char*>(trailer.data()), 24),
+        "failed writing row block index");
+    os.flush();
+}
+
+
 /**
  * Writes raw data to the stream.
  *
@@ -986,12 +1186,23 @@ void write_raw(std::ostream& os, const matrix_data<ValueType, IndexType>& data,
 #define GKO_DECLARE_WRITE_BINARY_RAW(ValueType, IndexType) \
     void write_binary_raw(std::ostream& os,                \
                           const matrix_data<ValueType, IndexType>& data)
+#define GKO_DECLARE_READ_BINARY_ROWS_RAW(ValueType, IndexType) \
+    matrix_data<ValueType, IndexType> read_binary_rows_raw( \
+        std::istream& is, span rows)
+#define GKO_DECLARE_WRITE_BINARY_INDEXED_RAW(ValueType, IndexType)       \
+    void write_binary_indexed_raw(                                       \
+        std::ostream& os, const matrix_data<ValueType, IndexType>& data, \
+        size_type rows_per_block)
 #define GKO_DECLARE_READ_GENERIC_RAW(ValueType, IndexType) \
     matrix_data<ValueType, IndexType> read_generic_raw(std::istream& is)
 GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(GKO_DECLARE_READ_RAW);
 GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(GKO_DECLARE_WRITE_RAW);
 GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(GKO_DECLARE_READ_BINARY_RAW);
 GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(GKO_DECLARE_WRITE_BINARY_RAW);
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(
+    GKO_DECLARE_READ_BINARY_ROWS_RAW);
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(
+    GKO_DECLARE_WRITE_BINARY_INDEXED_RAW);
 GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(GKO_DECLARE_READ_GENERIC_RAW);
 
 
@@ -0,0 +1,170 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2022, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#ifndef GKO_CORE_COMPONENTS_DENSE_BLOCK_HPP_
+#define GKO_CORE_COMPONENTS_DENSE_BLOCK_HPP_
+
+
+#include <utility>
+
+
+#include <ginkgo/core/base/math.hpp>
+
+
+namespace gko {
+namespace dense_block {
+
+
+/**
+ * @internal
+ *
+ * Computes c -= a * b for column-major bs x bs blocks, as they are stored in
+ * a matrix::Fbcsr.
+ */
+template <typename ValueType>
+inline void multiply_sub(int bs, const ValueType* a, const ValueType* b,
+                         ValueType* c)
+{
+    for (int j = 0; j < bs; ++j) {
+        for (int k = 0; k < bs; ++k) {
+            const auto b_kj = b[k + j * bs];
+            for (int i = 0; i < bs; ++i) {
+                c[i + j * bs] -= a[i + k * bs] * b_kj;
+            }
+        }
+    }
+}
+
+
+/**
+ * @internal
+ *
+ * Computes c = a * b for column-major bs x bs blocks.
+ */
+template <typename ValueType>
+inline void multiply(int bs, const ValueType* a, const ValueType* b,
+                     ValueType* c)
+{
+    for (int i = 0; i < bs * bs; ++i) {
+        c[i] = zero<ValueType>();
+    }
+    for (int j = 0; j < bs; ++j) {
+        for (int k = 0; k < bs; ++k) {
+            const auto b_kj = b[k + j * bs];
+            for (int i = 0; i < bs; ++i) {
+                c[i + j * bs] += a[i + k * bs] * b_kj;
+            }
+        }
+    }
+}
+
+
+/**
+ * @internal
+ *
+ * Computes y -= a * x for a column-major bs x bs block a.
+ */
+template <typename ValueType>
+inline void multiply_sub_vector(int bs, const ValueType* a, const ValueType* x,
+                                ValueType* y)
+{
+    for (int k = 0; k < bs; ++k) {
+        for (int i = 0; i < bs; ++i) {
+            y[i] -= a[i + k * bs] * x[k];
+        }
+    }
+}
+
+
+/**
+ * @internal
+ *
+ * Computes the inverse of a column-major bs x bs block using Gauss-Jordan
+ * elimination with partial pivoting. The input block is overwritten.
+ *
+ * @return false if the block is singular, in which case the inverse is
+ *         filled with NaN, similar to the division by a zero pivot in the
+ *         scalar algorithms.
+ */
+template <typename ValueType>
+inline bool invert(int bs, ValueType* block, ValueType* inverse)
+{
+    using std::swap;
+    for (int j = 0; j < bs; ++j) {
+        for (int i = 0; i < bs; ++i) {
+            inverse[i + j * bs] = i == j ? one<ValueType>() : zero<ValueType>();
+        }
+    }
+    for (int k = 0; k < bs; ++k) {
+        auto pivot = k;
+        for (int i = k + 1; i < bs; ++i) {
+            if (abs(block[i + k * bs]) > abs(block[pivot + k * bs])) {
+                pivot = i;
+            }
+        }
+        if (is_zero(block[pivot + k * bs])) {
+            for (int i = 0; i < bs * bs; ++i) {
+                inverse[i] = nan<ValueType>();
+            }
+            return false;
+        }
+        if (pivot != k) {
+            for (int j = 0; j < bs; ++j) {
+                swap(block[k + j * bs], block[pivot + j * bs]);
+                swap(inverse[k + j * bs], inverse[pivot + j * bs]);
+            }
+        }
+        const auto scale = one<ValueType>() / block[k + k * bs];
+        for (int j = 0; j < bs; ++j) {
+            block[k + j * bs] *= scale;
+            inverse[k + j * bs] *= scale;
+        }
+        for (int i = 0; i < bs; ++i) {
+            const auto factor = block[i + k * bs];
+            if (i == k || is_zero(factor)) {
+                continue;
+            }
+            for (int j = 0; j < bs; ++j) {
+                block[i + j * bs] -= factor * block[k + j * bs];
+                inverse[i + j * bs] -= factor * inverse[k + j * bs];
+            }
+        }
+    }
+    return true;
+}
+
+
+}  // namespace dense_block
+}  // namespace gko
+
+
+#endif  // GKO_CORE_COMPONENTS_DENSE_BLOCK_HPP_
@@ -46,6 +46,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "core/distributed/matrix_kernels.hpp"
 #include "core/distributed/partition_kernels.hpp"
 #include "core/distributed/vector_kernels.hpp"
+#include "core/factorization/block_ilu_kernels.hpp"
 #include "core/factorization/cholesky_kernels.hpp"
 #include "core/factorization/factorization_kernels.hpp"
 #include "core/factorization/ic_kernels.hpp"
@@ -55,6 +56,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "core/factorization/par_ict_kernels.hpp"
 #include "core/factorization/par_ilu_kernels.hpp"
 #include "core/factorization/par_ilut_kernels.hpp"
+#include "core/matrix/block_ell_kernels.hpp"
+#include "core/matrix/compressed_csr_kernels.hpp"
 #include "core/matrix/coo_kernels.hpp"
 #include "core/matrix/csr_kernels.hpp"
 #include "core/matrix/dense_kernels.hpp"
@@ -65,12 +68,17 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "core/matrix/hybrid_kernels.hpp"
 #include "core/matrix/sellp_kernels.hpp"
 #include "core/matrix/sparsity_csr_kernels.hpp"
+#include "core/matrix/stencil_kernels.hpp"
+#include "core/matrix/symmetric_csr_kernels.hpp"
 #include "core/multigrid/pgm_kernels.hpp"
 #include "core/preconditioner/isai_kernels.hpp"
 #include "core/preconditioner/jacobi_kernels.hpp"
+#include "core/preconditioner/polynomial_kernels.hpp"
+#include "core/preconditioner/spai_kernels.hpp"
 #include "core/reorder/rcm_kernels.hpp"
 #include "core/solver/bicg_kernels.hpp"
 #include "core/solver/bicgstab_kernels.hpp"
+#include "core/solver/block_trs_kernels.hpp"
 #include "core/solver/cb_gmres_kernels.hpp"
 #include "core/solver/cg_kernels.hpp"
 #include "core/solver/cgs_kernels.hpp"
@@ -266,6 +274,7 @@ namespace distributed_matrix {
 
 
 GKO_STUB_VALUE_AND_LOCAL_GLOBAL_INDEX_TYPE(GKO_DECLARE_BUILD_LOCAL_NONLOCAL);
+GKO_STUB_VALUE_AND_INDEX_TYPE(GKO_DECLARE_ROW_SUBSET_SPMV);
 
 
 }  // namespace distributed_matrix
@@ -389,6 +398,17 @@ GKO_STUB_VALUE_AND_INDEX_TYPE(GKO_DECLARE_UPPER_TRS_SOLVE_KERNEL);
 }  // namespace upper_trs
 
 
+namespace block_trs {
+
+
+GKO_STUB_VALUE_AND_INDEX_TYPE(GKO_DECLARE_BLOCK_TRS_INVERT_DIAGONAL_KERNEL);
+GKO_STUB_VALUE_AND_INDEX_TYPE(GKO_DECLARE_BLOCK_TRS_SOLVE_LOWER_KERNEL);
+GKO_STUB_VALUE_AND_INDEX_TYPE(GKO_DECLARE_BLOCK_TRS_SOLVE_UPPER_KERNEL);
+
+
+}  // namespace block_trs
+
+
 namespace fcg {
 
 
@@ -511,13 +531,75 @@ GKO_STUB_VALUE_AND_INDEX_TYPE(
 }  // namespace sparsity_csr
 
 
+namespace symmetric_csr {
+
+
+GKO_STUB_VALUE_AND_INDEX_TYPE(GKO_DECLARE_SYMMETRIC_CSR_SPMV_KERNEL);
+GKO_STUB_VALUE_AND_INDEX_TYPE(GKO_DECLARE_SYMMETRIC_CSR_ADVANCED_SPMV_KERNEL);
+GKO_STUB_VALUE_AND_INDEX_TYPE(
+    GKO_DECLARE_SYMMETRIC_CSR_COUNT_UPPER_NONZEROS_PER_ROW_KERNEL);
+GKO_STUB_VALUE_AND_INDEX_TYPE(GKO_DECLARE_SYMMETRIC_CSR_EXTRACT_UPPER_KERNEL);
+GKO_STUB_VALUE_AND_INDEX_TYPE(GKO_DECLARE_SYMMETRIC_CSR_CONVERT_TO_CSR_KERNEL);
+
+
+}  // namespace symmetric_csr
+
+
+namespace compressed_csr {
+
+
+GKO_STUB_VALUE_AND_INDEX_TYPE(GKO_DECLARE_COMPRESSED_CSR_SPMV_KERNEL);
+GKO_STUB_VALUE_AND_INDEX_TYPE(GKO_DECLARE_COMPRESSED_CSR_ADVANCED_SPMV_KERNEL);
+GKO_STUB_VALUE_AND_INDEX_TYPE(
+    GKO_DECLARE_COMPRESSED_CSR_COUNT_ROW_WORDS_KERNEL);
+GKO_STUB_VALUE_AND_INDEX_TYPE(
+    GKO_DECLARE_COMPRESSED_CSR_COMPRESS_FROM_CSR_KERNEL);
+GKO_STUB_VALUE_AND_INDEX_TYPE(
+    GKO_DECLARE_COMPRESSED_CSR_DECOMPRESS_TO_CSR_KERNEL);
+
+
+}  // namespace compressed_csr
+
+
+namespace block_ell {
+
+
+GKO_STUB_VALUE_AND_INDEX_TYPE(GKO_DECLARE_BLOCK_ELL_SPMV_KERNEL);
+GKO_STUB_VALUE_AND_INDEX_TYPE(GKO_DECLARE_BLOCK_ELL_ADVANCED_SPMV_KERNEL);
+GKO_STUB_VALUE_AND_INDEX_TYPE(
+    GKO_DECLARE_BLOCK_ELL_COMPUTE_MAX_BLOCKS_PER_ROW_KERNEL);
+GKO_STUB_VALUE_AND_INDEX_TYPE(GKO_DECLARE_BLOCK_ELL_FILL_IN_FROM_CSR_KERNEL);
+GKO_STUB_VALUE_AND_INDEX_TYPE(
+    GKO_DECLARE_BLOCK_ELL_COUNT_NONZEROS_PER_ROW_KERNEL);
+GKO_STUB_VALUE_AND_INDEX_TYPE(GKO_DECLARE_BLOCK_ELL_CONVERT_TO_CSR_KERNEL);
+
+
+}  // namespace block_ell
+
+
+namespace stencil {
+
+
+GKO_STUB_VALUE_AND_INDEX_TYPE(GKO_DECLARE_STENCIL_SPMV_KERNEL);
+GKO_STUB_VALUE_AND_INDEX_TYPE(GKO_DECLARE_STENCIL_ADVANCED_SPMV_KERNEL);
+GKO_STUB_VALUE_AND_INDEX_TYPE(
+    GKO_DECLARE_STENCIL_COUNT_NONZEROS_PER_ROW_KERNEL);
+GKO_STUB_VALUE_AND_INDEX_TYPE(GKO_DECLARE_STENCIL_FILL_IN_CSR_KERNEL);
+
+
+}  // namespace stencil
+
+
 namespace csr {
 
 
 GKO_STUB_VALUE_AND_INDEX_TYPE(GKO_DECLARE_CSR_SPMV_KERNEL);
 GKO_STUB_VALUE_AND_INDEX_TYPE(GKO_DECLARE_CSR_ADVANCED_SPMV_KERNEL);
+GKO_STUB_MIXED_VALUE_AND_INDEX_TYPE(GKO_DECLARE_CSR_MIXED_SPMV_KERNEL);
+GKO_STUB_MIXED_VALUE_AND_INDEX_TYPE(GKO_DECLARE_CSR_ADVANCED_MIXED_SPMV_KERNEL);
 GKO_STUB_VALUE_AND_INDEX_TYPE(GKO_DECLARE_CSR_SPGEMM_KERNEL);
 GKO_STUB_VALUE_AND_INDEX_TYPE(GKO_DECLARE_CSR_ADVANCED_SPGEMM_KERNEL);
+GKO_STUB_VALUE_AND_INDEX_TYPE(GKO_DECLARE_CSR_MASKED_SPGEMM_KERNEL);
 GKO_STUB_VALUE_AND_INDEX_TYPE(GKO_DECLARE_CSR_SPGEAM_KERNEL);
 GKO_STUB_VALUE_AND_INDEX_TYPE(GKO_DECLARE_CSR_FILL_IN_DENSE_KERNEL);
 GKO_STUB_VALUE_AND_INDEX_TYPE(GKO_DECLARE_CSR_CONVERT_TO_ELL_KERNEL);
@@ -692,6 +774,27 @@ GKO_STUB_VALUE_AND_INDEX_TYPE(GKO_DECLARE_ISAI_SCATTER_EXCESS_SOLUTION_KERNEL);
 }  // namespace isai
 
 
+namespace polynomial {
+
+
+GKO_STUB_VALUE_TYPE(GKO_DECLARE_POLYNOMIAL_HORNER_STEP_KERNEL);
+GKO_STUB_VALUE_TYPE(GKO_DECLARE_POLYNOMIAL_CHEBYSHEV_INITIALIZE_KERNEL);
+GKO_STUB_VALUE_TYPE(GKO_DECLARE_POLYNOMIAL_CHEBYSHEV_STEP_KERNEL);
+
+
+}  // namespace polynomial
+
+
+namespace spai {
+
+
+GKO_STUB_VALUE_AND_INDEX_TYPE(GKO_DECLARE_SPAI_GENERATE_GENERAL_KERNEL);
+GKO_STUB_VALUE_AND_INDEX_TYPE(GKO_DECLARE_SPAI_GENERATE_SPD_KERNEL);
+
+
+}  // namespace spai
+
+
 namespace cholesky {
 
 
@@ -736,6 +839,18 @@ GKO_STUB_VALUE_AND_INDEX_TYPE(GKO_DECLARE_ILU_COMPUTE_LU_KERNEL);
 }  // namespace ilu_factorization
 
 
+namespace block_ilu_factorization {
+
+
+GKO_STUB_VALUE_AND_INDEX_TYPE(
+    GKO_DECLARE_BLOCK_ILU_INITIALIZE_ROW_PTRS_L_U_KERNEL);
+GKO_STUB_VALUE_AND_INDEX_TYPE(GKO_DECLARE_BLOCK_ILU_INITIALIZE_L_U_KERNEL);
+GKO_STUB_VALUE_AND_INDEX_TYPE(GKO_DECLARE_BLOCK_ILU_COMPUTE_LU_KERNEL);
+
+
+}  // namespace block_ilu_factorization
+
+
 namespace lu_factorization {
 
 
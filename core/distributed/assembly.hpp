@@ -0,0 +1,204 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2022, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+
+#ifndef GKO_CORE_DISTRIBUTED_ASSEMBLY_HPP_
+#define GKO_CORE_DISTRIBUTED_ASSEMBLY_HPP_
+
+
+#include <ginkgo/config.hpp>
+
+
+#if GINKGO_BUILD_MPI
+
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+
+#include <ginkgo/core/base/matrix_data.hpp>
+#include <ginkgo/core/base/mpi.hpp>
+#include <ginkgo/core/base/temporary_clone.hpp>
+#include <ginkgo/core/distributed/partition.hpp>
+
+
+namespace gko {
+namespace detail {
+
+
+/**
+ * Sends each entry of the given matrix data to the process owning its row
+ * according to the given partition.
+ *
+ * This is a collective operation, every process of the communicator has to
+ * call it, even if it has no entries to send.
+ *
+ * @param comm  the communicator
+ * @param data  the entries of this process, they can belong to any row
+ * @param partition  the row partition which determines the owner of each entry
+ *
+ * @return  the entries owned by this process, collected from all processes.
+ *          The entries are sorted in row-major order and duplicates are summed
+ *          up.
+ */
+template <typename ValueType, typename LocalIndexType, typename GlobalIndexType>
+matrix_data<ValueType, GlobalIndexType> communicate_to_owners(
+    experimental::mpi::communicator comm,
+    const matrix_data<ValueType, GlobalIndexType>& data,
+    const experimental::distributed::Partition<LocalIndexType,
+                                               GlobalIndexType>* partition)
+{
+    using experimental::distributed::comm_index_type;
+    auto host = partition->get_executor()->get_master();
+    auto host_partition = make_temporary_clone(host, partition);
+    const auto range_bounds = host_partition->get_range_bounds();
+    const auto part_ids = host_partition->get_part_ids();
+    const auto num_ranges = host_partition->get_num_ranges();
+    const auto num_parts = static_cast<size_type>(comm.size());
+    const auto num_entries = data.nonzeros.size();
+
+    // determine the owner of each entry
+    std::vector<comm_index_type> owners(num_entries);
+    std::vector<comm_index_type> send_sizes(num_parts);
+    std::vector<comm_index_type> send_offsets(num_parts + 1);
+    for (size_type i = 0; i < num_entries; i++) {
+        auto range = std::distance(
+            range_bounds + 1,
+            std::upper_bound(range_bounds + 1, range_bounds + num_ranges + 1,
+                             data.nonzeros[i].row));
+        owners[i] = part_ids[range];
+        send_sizes[owners[i]]++;
+    }
+    std::partial_sum(send_sizes.begin(), send_sizes.end(),
+                     send_offsets.begin() + 1);
+    std::vector<comm_index_type> recv_sizes(num_parts);
+    std::vector<comm_index_type> recv_offsets(num_parts + 1);
+    comm.all_to_all(host, send_sizes.data(), 1, recv_sizes.data(), 1);
+    std::partial_sum(recv_sizes.begin(), recv_sizes.end(),
+                     recv_offsets.begin() + 1);
+
+    // pack the entries ordered by their owner
+    using entry_type = matrix_data_entry<ValueType, GlobalIndexType>;
+    std::vector<entry_type> send_entries(num_entries);
+    auto fill_offsets = send_offsets;
+    for (size_type i = 0; i < num_entries; i++) {
+        send_entries[fill_offsets[owners[i]]++] = data.nonzeros[i];
+    }
+
+    // exchange whole entries, so a single all-to-all suffices
+    const auto num_recv = static_cast<size_type>(recv_offsets.back());
+    matrix_data<ValueType, GlobalIndexType> result{data.size};
+    result.nonzeros.resize(num_recv);
+    experimental::mpi::contiguous_type entry_mpi_type(sizeof(entry_type),
+                                                      MPI_BYTE);
+    comm.all_to_all_v(host, send_entries.data(), send_sizes.data(),
+                      send_offsets.data(), entry_mpi_type.get(),
+                      result.nonzeros.data(), recv_sizes.data(),
+                      recv_offsets.data(), entry_mpi_type.get());
+    result.sum_duplicates();
+    return result;
+}
+
+
+/**
+ * Returns whether both partitions assign the same global ranges to the same
+ * parts. The comparison happens on the host.
+ */
+template <typename LocalIndexType, typename GlobalIndexType>
+bool have_same_ranges(
+    const experimental::distributed::Partition<LocalIndexType,
+                                               GlobalIndexType>* first,
+    const experimental::distributed::Partition<LocalIndexType,
+                                               GlobalIndexType>* second)
+{
+    if (first->get_size() != second->get_size() ||
+        first->get_num_ranges() != second->get_num_ranges()) {
+        return false;
+    }
+    const auto host = first->get_executor()->get_master();
+    const auto host_first = make_temporary_clone(host, first);
+    const auto host_second = make_temporary_clone(host, second);
+    const auto num_ranges = first->get_num_ranges();
+    return std::equal(host_first->get_range_bounds(),
+                      host_first->get_range_bounds() + num_ranges + 1,
+                      host_second->get_range_bounds()) &&
+           std::equal(host_first->get_part_ids(),
+                      host_first->get_part_ids() + num_ranges,
+                      host_second->get_part_ids());
+}
+
+
+/**
+ * Computes the global index of each local index of a part.
+ *
+ * @param partition  the partition
+ * @param part_id  the part whose indices are mapped
+ *
+ * @return  the global indices of the part, ordered by their local index
+ */
+template <typename LocalIndexType, typename GlobalIndexType>
+std::vector<GlobalIndexType> build_local_to_global(
+    const experimental::distributed::Partition<LocalIndexType,
+                                               GlobalIndexType>* partition,
+    experimental::distributed::comm_index_type part_id)
+{
+    auto host = partition->get_executor()->get_master();
+    auto host_partition = make_temporary_clone(host, partition);
+    const auto range_bounds = host_partition->get_range_bounds();
+    const auto range_starts = host_partition->get_range_starting_indices();
+    const auto part_ids = host_partition->get_part_ids();
+    std::vector<GlobalIndexType> local_to_global(
+        host_partition->get_part_size(part_id));
+    for (size_type range = 0; range < host_partition->get_num_ranges();
+         range++) {
+        if (part_ids[range] != part_id) {
+            continue;
+        }
+        for (auto idx = range_bounds[range]; idx < range_bounds[range + 1];
+             idx++) {
+            local_to_global[range_starts[range] + idx - range_bounds[range]] =
+                idx;
+        }
+    }
+    return local_to_global;
+}
+
+
+}  // namespace detail
+}  // namespace gko
+
+
+#endif  // GINKGO_BUILD_MPI
+
+
+#endif  // GKO_CORE_DISTRIBUTED_ASSEMBLY_HPP_
@@ -38,10 +38,14 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 
 #include <ginkgo/config.hpp>
+#include <ginkgo/core/distributed/matrix.hpp>
 #include <ginkgo/core/distributed/vector.hpp>
 #include <ginkgo/core/matrix/dense.hpp>
 
 
+#include "core/base/dispatch_helper.hpp"
+
+
 namespace gko {
 namespace detail {
 
@@ -168,6 +172,37 @@ void vector_dispatch(T* linop, F&& f, Args&&... args)
 }
 
 
+/**
+ * create_vector creates a vector with nrhs columns which can be applied to the
+ * given operator. It creates a distributed vector with the same row
+ * distribution if the operator is distributed.
+ *
+ * @tparam ValueType  the value type of the vector
+ */
+template <typename ValueType>
+std::shared_ptr<LinOp> create_vector(std::shared_ptr<const Executor> exec,
+                                     const LinOp* op, size_type nrhs)
+{
+#if GINKGO_BUILD_MPI
+    if (gko::detail::is_distributed(op)) {
+        using experimental::distributed::Matrix;
+        std::shared_ptr<LinOp> vec;
+        run<const Matrix<ValueType, int32, int32>*,
+            const Matrix<ValueType, int32, int64>*,
+            const Matrix<ValueType, int64, int64>*>(op, [&](auto mtx) {
+            vec = experimental::distributed::Vector<ValueType>::create(
+                exec, mtx->get_communicator(),
+                dim<2>{mtx->get_size()[0], nrhs},
+                dim<2>{mtx->get_local_matrix()->get_size()[0], nrhs});
+        });
+        return vec;
+    }
+#endif
+    return matrix::Dense<ValueType>::create(exec,
+                                            dim<2>{op->get_size()[0], nrhs});
+}
+
+
 }  // namespace detail
 }  // namespace gko
 
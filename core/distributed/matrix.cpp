@@ -33,11 +33,18 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ginkgo/core/distributed/matrix.hpp>
 
 
+#include <algorithm>
+#include <map>
+#include <numeric>
+
+
 #include <ginkgo/core/base/precision_dispatch.hpp>
+#include <ginkgo/core/distributed/partition.hpp>
 #include <ginkgo/core/distributed/vector.hpp>
 #include <ginkgo/core/matrix/csr.hpp>
 
 
+#include "core/distributed/assembly.hpp"
 #include "core/distributed/matrix_kernels.hpp"
 
 
@@ -50,12 +57,139 @@ namespace {
 
 GKO_REGISTER_OPERATION(build_local_nonlocal,
                        distributed_matrix::build_local_nonlocal);
+GKO_REGISTER_OPERATION(row_subset_spmv, distributed_matrix::row_subset_spmv);
 
 
 }  // namespace
 }  // namespace matrix
 
 
+namespace {
+
+
+/**
+ * Writes the locally owned rows of a distributed matrix with local row indices
+ * and global column indices, sorted in row-major order.
+ */
+template <typename ValueType, typename LocalIndexType, typename GlobalIndexType>
+matrix_data<ValueType, GlobalIndexType> write_local_rows(
+    const Matrix<ValueType, LocalIndexType, GlobalIndexType>* mtx)
+{
+    using local_data_type = matrix_data<ValueType, LocalIndexType>;
+    const auto local_mtx = mtx->get_local_matrix();
+    matrix_data<ValueType, GlobalIndexType> data{
+        dim<2>{local_mtx->get_size()[0], mtx->get_size()[1]}};
+    if (!mtx->get_col_partition()) {
+        return data;
+    }
+    const auto col_map = ::gko::detail::build_local_to_global(
+        mtx->get_col_partition().get(), mtx->get_communicator().rank());
+    const array<GlobalIndexType> non_local_map{
+        mtx->get_executor()->get_master(), mtx->get_non_local_to_global()};
+    local_data_type local_data;
+    local_data_type non_local_data;
+    as<WritableToMatrixData<ValueType, LocalIndexType>>(local_mtx.get())
+        ->write(local_data);
+    as<WritableToMatrixData<ValueType, LocalIndexType>>(
+        mtx->get_non_local_matrix().get())
+        ->write(non_local_data);
+    data.nonzeros.reserve(local_data.nonzeros.size() +
+                          non_local_data.nonzeros.size());
+    for (const auto& entry : local_data.nonzeros) {
+        data.nonzeros.emplace_back(entry.row, col_map[entry.column],
+                                   entry.value);
+    }
+    for (const auto& entry : non_local_data.nonzeros) {
+        data.nonzeros.emplace_back(
+            entry.row, non_local_map.get_const_data()[entry.column],
+            entry.value);
+    }
+    data.ensure_row_major_order();
+    return data;
+}
+
+
+/**
+ * Writes the locally owned rows of a distributed matrix with global row and
+ * column indices.
+ */
+template <typename ValueType, typename LocalIndexType, typename GlobalIndexType>
+matrix_data<ValueType, GlobalIndexType> write_global_rows(
+    const Matrix<ValueType, LocalIndexType, GlobalIndexType>* mtx)
+{
+    auto data = write_local_rows(mtx);
+    data.size = mtx->get_size();
+    if (mtx->get_row_partition()) {
+        const auto row_map = ::gko::detail::build_local_to_global(
+            mtx->get_row_partition().get(), mtx->get_communicator().rank());
+        for (auto& entry : data.nonzeros) {
+            entry.row = row_map[entry.row];
+        }
+    }
+    return data;
+}
+
+
+/**
+ * Creates an empty distributed matrix that uses the same storage formats as
+ * the given matrix.
+ */
+template <typename ValueType, typename LocalIndexType, typename GlobalIndexType>
+std::unique_ptr<Matrix<ValueType, LocalIndexType, GlobalIndexType>>
+create_with_same_formats(
+    const Matrix<ValueType, LocalIndexType, GlobalIndexType>* mtx)
+{
+    return Matrix<ValueType, LocalIndexType, GlobalIndexType>::create(
+        mtx->get_executor(), mtx->get_communicator(),
+        as<LinOp>(mtx->get_local_matrix()->create_default()).get(),
+        as<LinOp>(mtx->get_non_local_matrix()->create_default()).get());
+}
+
+
+/**
+ * Throws if the matrix has no row and column partition, i.e. if it has not
+ * been read with read_distributed.
+ */
+template <typename ValueType, typename LocalIndexType, typename GlobalIndexType>
+void ensure_has_partitions(
+    const Matrix<ValueType, LocalIndexType, GlobalIndexType>* mtx)
+{
+    if (!mtx->get_row_partition() || !mtx->get_col_partition()) {
+        GKO_UNSUPPORTED_MATRIX_PROPERTY(
+            "the distributed matrix needs to be read with read_distributed "
+            "first");
+    }
+}
+
+
+template <typename ValueType, typename LocalIndexType, typename GlobalIndexType>
+std::unique_ptr<LinOp> transpose_impl(
+    const Matrix<ValueType, LocalIndexType, GlobalIndexType>* mtx,
+    bool conjugate)
+{
+    ensure_has_partitions(mtx);
+    // every entry is sent to the owner of its column, which owns the
+    // corresponding row of the transpose
+    auto data = write_global_rows(mtx);
+    data.size = gko::transpose(data.size);
+    for (auto& entry : data.nonzeros) {
+        std::swap(entry.row, entry.column);
+        if (conjugate) {
+            entry.value = conj(entry.value);
+        }
+    }
+    auto result = create_with_same_formats(mtx);
+    result->read_distributed(
+        ::gko::detail::communicate_to_owners(mtx->get_communicator(), data,
+                                             mtx->get_col_partition().get()),
+        mtx->get_col_partition().get(), mtx->get_row_partition().get());
+    return result;
+}
+
+
+}  // namespace
+
+
 template <typename ValueType, typename LocalIndexType, typename GlobalIndexType>
 Matrix<ValueType, LocalIndexType, GlobalIndexType>::Matrix(
     std::shared_ptr<const Executor> exec, mpi::communicator comm)
@@ -82,6 +216,13 @@ Matrix<ValueType, LocalIndexType, GlobalIndexType>::Matrix(
       send_sizes_(comm.size()),
       recv_offsets_(comm.size() + 1),
       recv_sizes_(comm.size()),
+      interior_rows_{exec},
+      boundary_rows_{exec},
+      overlap_mode_{overlap_mode::local_non_local},
+      node_aware_communication_{false},
+      node_aware_max_num_cols_{1},
+      reduced_precision_communication_{false},
+      reduced_precision_exchange_{false},
       gather_idxs_{exec},
       non_local_to_global_{exec},
       one_scalar_{},
@@ -113,8 +254,25 @@ void Matrix<ValueType, LocalIndexType, GlobalIndexType>::convert_to(
     result->recv_offsets_ = this->recv_offsets_;
     result->recv_sizes_ = this->recv_sizes_;
     result->send_sizes_ = this->send_sizes_;
+    result->send_neighbors_ = this->send_neighbors_;
+    result->neighbor_send_offsets_ = this->neighbor_send_offsets_;
+    result->neighbor_send_sizes_ = this->neighbor_send_sizes_;
+    result->recv_neighbors_ = this->recv_neighbors_;
+    result->neighbor_recv_offsets_ = this->neighbor_recv_offsets_;
+    result->neighbor_recv_sizes_ = this->neighbor_recv_sizes_;
+    result->neighbor_comm_ = this->neighbor_comm_;
+    result->interior_rows_ = this->interior_rows_;
+    result->boundary_rows_ = this->boundary_rows_;
+    result->overlap_mode_ = this->overlap_mode_;
+    result->node_aware_communication_ = this->node_aware_communication_;
+    result->node_aware_max_num_cols_ = this->node_aware_max_num_cols_;
+    result->reduced_precision_communication_ =
+        this->reduced_precision_communication_;
     result->non_local_to_global_ = this->non_local_to_global_;
+    result->row_partition_ = this->row_partition_;
+    result->col_partition_ = this->col_partition_;
     result->set_size(this->get_size());
+    result->init_node_exchange();
 }
 
 
@@ -132,9 +290,27 @@ void Matrix<ValueType, LocalIndexType, GlobalIndexType>::move_to(
     result->recv_offsets_ = std::move(this->recv_offsets_);
     result->recv_sizes_ = std::move(this->recv_sizes_);
     result->send_sizes_ = std::move(this->send_sizes_);
+    result->send_neighbors_ = std::move(this->send_neighbors_);
+    result->neighbor_send_offsets_ = std::move(this->neighbor_send_offsets_);
+    result->neighbor_send_sizes_ = std::move(this->neighbor_send_sizes_);
+    result->recv_neighbors_ = std::move(this->recv_neighbors_);
+    result->neighbor_recv_offsets_ = std::move(this->neighbor_recv_offsets_);
+    result->neighbor_recv_sizes_ = std::move(this->neighbor_recv_sizes_);
+    result->neighbor_comm_ = std::move(this->neighbor_comm_);
+    result->interior_rows_ = std::move(this->interior_rows_);
+    result->boundary_rows_ = std::move(this->boundary_rows_);
+    result->overlap_mode_ = std::move(this->overlap_mode_);
+    result->node_aware_communication_ = this->node_aware_communication_;
+    result->node_aware_max_num_cols_ = this->node_aware_max_num_cols_;
+    result->reduced_precision_communication_ =
+        this->reduced_precision_communication_;
+    this->node_exchange_.reset();
     result->non_local_to_global_ = std::move(this->non_local_to_global_);
+    result->row_partition_ = std::move(this->row_partition_);
+    result->col_partition_ = std::move(this->col_partition_);
     result->set_size(this->get_size());
     this->set_size({});
+    result->init_node_exchange();
 }
 
 
@@ -158,6 +334,8 @@ void Matrix<ValueType, LocalIndexType, GlobalIndexType>::read_distributed(
     auto global_num_cols = col_partition->get_size();
     dim<2> global_dim{global_num_rows, global_num_cols};
     this->set_size(global_dim);
+    row_partition_ = gko::clone(exec, row_partition);
+    col_partition_ = gko::clone(exec, col_partition);
 
     // temporary storage for the output
     array<local_index_type> local_row_idxs{exec};
@@ -183,6 +361,25 @@ void Matrix<ValueType, LocalIndexType, GlobalIndexType>::read_distributed(
     const auto num_local_cols =
         static_cast<size_type>(col_partition->get_part_size(local_part));
     const auto num_non_local_cols = non_local_to_global_.get_num_elems();
+
+    // split the local rows into interior rows without non-local entries and
+    // boundary rows, used by overlap_mode::interior_boundary
+    const array<local_index_type> host_non_local_row_idxs{exec->get_master(),
+                                                         non_local_row_idxs};
+    std::vector<bool> is_boundary_row(num_local_rows, false);
+    for (size_type i = 0; i < host_non_local_row_idxs.get_num_elems(); ++i) {
+        is_boundary_row[host_non_local_row_idxs.get_const_data()[i]] = true;
+    }
+    std::vector<local_index_type> interior_rows;
+    std::vector<local_index_type> boundary_rows;
+    for (size_type row = 0; row < num_local_rows; ++row) {
+        (is_boundary_row[row] ? boundary_rows : interior_rows)
+            .push_back(static_cast<local_index_type>(row));
+    }
+    interior_rows_ = array<local_index_type>{exec, interior_rows.begin(),
+                                             interior_rows.end()};
+    boundary_rows_ = array<local_index_type>{exec, boundary_rows.begin(),
+                                             boundary_rows.end()};
     device_matrix_data<value_type, local_index_type> local_data{
         exec, dim<2>{num_local_rows, num_local_cols}, std::move(local_row_idxs),
         std::move(local_col_idxs), std::move(local_values)};
@@ -222,6 +419,31 @@ void Matrix<ValueType, LocalIndexType, GlobalIndexType>::read_distributed(
     if (use_host_buffer) {
         gather_idxs_.set_executor(exec);
     }
+
+    // exchange step 3: set up a neighborhood communicator that only contains
+    // the ranks this rank actually exchanges halo data with, so the halo
+    // exchange in communicate does not scale with the communicator size
+    send_neighbors_.clear();
+    neighbor_send_offsets_.clear();
+    neighbor_send_sizes_.clear();
+    recv_neighbors_.clear();
+    neighbor_recv_offsets_.clear();
+    neighbor_recv_sizes_.clear();
+    for (comm_index_type rank = 0; rank < comm.size(); ++rank) {
+        if (send_sizes_[rank] > 0) {
+            send_neighbors_.push_back(rank);
+            neighbor_send_offsets_.push_back(send_offsets_[rank]);
+            neighbor_send_sizes_.push_back(send_sizes_[rank]);
+        }
+        if (recv_sizes_[rank] > 0) {
+            recv_neighbors_.push_back(rank);
+            neighbor_recv_offsets_.push_back(recv_offsets_[rank]);
+            neighbor_recv_sizes_.push_back(recv_sizes_[rank]);
+        }
+    }
+    neighbor_comm_ = std::make_shared<mpi::communicator>(comm, recv_neighbors_,
+                                                         send_neighbors_);
+    this->init_node_exchange();
 }
 
 
@@ -259,47 +481,471 @@ void Matrix<ValueType, LocalIndexType, GlobalIndexType>::read_distributed(
 }
 
 
+template <typename ValueType, typename LocalIndexType, typename GlobalIndexType>
+void Matrix<ValueType, LocalIndexType, GlobalIndexType>::read_distributed(
+    const matrix_assembly_data<value_type, global_index_type>& data,
+    const Partition<local_index_type, global_index_type>* row_partition,
+    const Partition<local_index_type, global_index_type>* col_partition)
+{
+    this->read_distributed(
+        ::gko::detail::communicate_to_owners(this->get_communicator(),
+                                             data.get_ordered_data(),
+                                             row_partition),
+        row_partition, col_partition);
+}
+
+
+template <typename ValueType, typename LocalIndexType, typename GlobalIndexType>
+void Matrix<ValueType, LocalIndexType, GlobalIndexType>::read_distributed(
+    const matrix_assembly_data<value_type, global_index_type>& data,
+    const Partition<local_index_type, global_index_type>* partition)
+{
+    this->read_distributed(data, partition, partition);
+}
+
+
+template <typename ValueType, typename LocalIndexType, typename GlobalIndexType>
+void Matrix<ValueType, LocalIndexType, GlobalIndexType>::redistribute(
+    const Partition<local_index_type, global_index_type>* row_partition,
+    const Partition<local_index_type, global_index_type>* col_partition)
+{
+    GKO_ASSERT_EQ(row_partition->get_size(), this->get_size()[0]);
+    GKO_ASSERT_EQ(col_partition->get_size(), this->get_size()[1]);
+    this->read_distributed(
+        ::gko::detail::communicate_to_owners(this->get_communicator(),
+                                             write_global_rows(this),
+                                             row_partition),
+        row_partition, col_partition);
+}
+
+
+template <typename ValueType, typename LocalIndexType, typename GlobalIndexType>
+void Matrix<ValueType, LocalIndexType, GlobalIndexType>::redistribute(
+    const Partition<local_index_type, global_index_type>* partition)
+{
+    this->redistribute(partition, partition);
+}
+
+
+template <typename ValueType, typename LocalIndexType, typename GlobalIndexType>
+std::unique_ptr<LinOp>
+Matrix<ValueType, LocalIndexType, GlobalIndexType>::transpose() const
+{
+    return transpose_impl(this, false);
+}
+
+
+template <typename ValueType, typename LocalIndexType, typename GlobalIndexType>
+std::unique_ptr<LinOp>
+Matrix<ValueType, LocalIndexType, GlobalIndexType>::conj_transpose() const
+{
+    return transpose_impl(this, true);
+}
+
+
+template <typename ValueType, typename LocalIndexType, typename GlobalIndexType>
+std::unique_ptr<Matrix<ValueType, LocalIndexType, GlobalIndexType>>
+Matrix<ValueType, LocalIndexType, GlobalIndexType>::multiply(
+    const Matrix* other) const
+{
+    using entry_type = matrix_data_entry<value_type, global_index_type>;
+    using local_data_type = matrix_data<value_type, local_index_type>;
+    GKO_ASSERT_CONFORMANT(this, other);
+    ensure_has_partitions(this);
+    ensure_has_partitions(other);
+    if (!::gko::detail::have_same_ranges(col_partition_.get(),
+                                         other->row_partition_.get())) {
+        GKO_UNSUPPORTED_MATRIX_PROPERTY(
+            "the row partition of the right factor has to match the column "
+            "partition of the left factor");
+    }
+    GKO_ASSERT_EQ(local_mtx_->get_size()[1],
+                  other->local_mtx_->get_size()[0]);
+    auto host = this->get_executor()->get_master();
+    const auto comm = this->get_communicator();
+    const auto num_parts = comm.size();
+
+    // the local rows of other are the rows for the local columns of this
+    const auto other_rows = write_local_rows(other);
+    std::vector<size_type> other_row_ptrs(other->local_mtx_->get_size()[0] + 1);
+    for (const auto& entry : other_rows.nonzeros) {
+        other_row_ptrs[entry.row + 1]++;
+    }
+    std::partial_sum(other_row_ptrs.begin(), other_row_ptrs.end(),
+                     other_row_ptrs.begin());
+
+    // fetch the rows of other for the non-local columns of this, using the
+    // communication pattern of the halo exchange: first the row lengths,
+    // then the entries
+    const array<local_index_type> host_gather_idxs{host, gather_idxs_};
+    const auto gather_idxs = host_gather_idxs.get_const_data();
+    std::vector<comm_index_type> send_row_sizes(send_offsets_.back());
+    for (size_type i = 0; i < send_row_sizes.size(); i++) {
+        send_row_sizes[i] = static_cast<comm_index_type>(
+            other_row_ptrs[gather_idxs[i] + 1] -
+            other_row_ptrs[gather_idxs[i]]);
+    }
+    std::vector<comm_index_type> recv_row_sizes(recv_offsets_.back());
+    comm.all_to_all_v(host, send_row_sizes.data(), send_sizes_.data(),
+                      send_offsets_.data(), recv_row_sizes.data(),
+                      recv_sizes_.data(), recv_offsets_.data());
+    std::vector<comm_index_type> send_entry_sizes(num_parts);
+    std::vector<comm_index_type> recv_entry_sizes(num_parts);
+    for (comm_index_type part = 0; part < num_parts; part++) {
+        send_entry_sizes[part] = std::accumulate(
+            send_row_sizes.begin() + send_offsets_[part],
+            send_row_sizes.begin() + send_offsets_[part + 1], 0);
+        recv_entry_sizes[part] = std::accumulate(
+            recv_row_sizes.begin() + recv_offsets_[part],
+            recv_row_sizes.begin() + recv_offsets_[part + 1], 0);
+    }
+    std::vector<comm_index_type> send_entry_offsets(num_parts + 1);
+    std::vector<comm_index_type> recv_entry_offsets(num_parts + 1);
+    std::partial_sum(send_entry_sizes.begin(), send_entry_sizes.end(),
+                     send_entry_offsets.begin() + 1);
+    std::partial_sum(recv_entry_sizes.begin(), recv_entry_sizes.end(),
+                     recv_entry_offsets.begin() + 1);
+    std::vector<entry_type> send_entries;
+    send_entries.reserve(send_entry_offsets.back());
+    for (size_type i = 0; i < send_row_sizes.size(); i++) {
+        send_entries.insert(
+            send_entries.end(),
+            other_rows.nonzeros.begin() + other_row_ptrs[gather_idxs[i]],
+            other_rows.nonzeros.begin() + other_row_ptrs[gather_idxs[i] + 1]);
+    }
+    std::vector<entry_type> recv_entries(recv_entry_offsets.back());
+    mpi::contiguous_type entry_mpi_type(sizeof(entry_type), MPI_BYTE);
+    comm.all_to_all_v(host, send_entries.data(), send_entry_sizes.data(),
+                      send_entry_offsets.data(), entry_mpi_type.get(),
+                      recv_entries.data(), recv_entry_sizes.data(),
+                      recv_entry_offsets.data(), entry_mpi_type.get());
+    std::vector<size_type> recv_row_ptrs(recv_row_sizes.size() + 1);
+    std::partial_sum(recv_row_sizes.begin(), recv_row_sizes.end(),
+                     recv_row_ptrs.begin() + 1);
+
+    // compute the local rows of the product in global column indices
+    local_data_type local_data;
+    local_data_type non_local_data;
+    as<WritableToMatrixData<value_type, local_index_type>>(local_mtx_.get())
+        ->write(local_data);
+    as<WritableToMatrixData<value_type, local_index_type>>(
+        non_local_mtx_.get())
+        ->write(non_local_data);
+    local_data.ensure_row_major_order();
+    non_local_data.ensure_row_major_order();
+    const auto row_map =
+        ::gko::detail::build_local_to_global(row_partition_.get(), comm.rank());
+    matrix_data<value_type, global_index_type> data{
+        dim<2>{this->get_size()[0], other->get_size()[1]}};
+    std::map<global_index_type, value_type> row_accumulator;
+    auto local_it = local_data.nonzeros.begin();
+    auto non_local_it = non_local_data.nonzeros.begin();
+    for (size_type row = 0; row < row_map.size(); row++) {
+        row_accumulator.clear();
+        for (; local_it != local_data.nonzeros.end() &&
+               static_cast<size_type>(local_it->row) == row;
+             ++local_it) {
+            for (auto nz = other_row_ptrs[local_it->column];
+                 nz < other_row_ptrs[local_it->column + 1]; nz++) {
+                const auto& entry = other_rows.nonzeros[nz];
+                row_accumulator[entry.column] += local_it->value * entry.value;
+            }
+        }
+        for (; non_local_it != non_local_data.nonzeros.end() &&
+               static_cast<size_type>(non_local_it->row) == row;
+             ++non_local_it) {
+            for (auto nz = recv_row_ptrs[non_local_it->column];
+                 nz < recv_row_ptrs[non_local_it->column + 1]; nz++) {
+                const auto& entry = recv_entries[nz];
+                row_accumulator[entry.column] +=
+                    non_local_it->value * entry.value;
+            }
+        }
+        for (const auto& entry : row_accumulator) {
+            data.nonzeros.emplace_back(row_map[row], entry.first,
+                                       entry.second);
+        }
+    }
+    auto result = create_with_same_formats(this);
+    result->read_distributed(data, row_partition_.get(),
+                             other->col_partition_.get());
+    return result;
+}
+
+
+template <typename ValueType, typename LocalIndexType, typename GlobalIndexType>
+struct Matrix<ValueType, LocalIndexType, GlobalIndexType>::node_exchange {
+    node_exchange(std::shared_ptr<const Executor> exec, const Matrix& mtx,
+                  size_type max_num_cols)
+        : node_comm{mtx.get_communicator().node_local_communicator()},
+          node_ranks(mtx.get_communicator().size(), -1),
+          peer_send_offsets(mtx.get_communicator().size()),
+          peer_send_sizes(node_comm.size()),
+          remote_send_sizes{mtx.neighbor_send_sizes_},
+          remote_recv_sizes{mtx.neighbor_recv_sizes_},
+          max_num_cols{max_num_cols},
+          window{exec,
+                 static_cast<int>(2 * mtx.send_offsets_.back() * max_num_cols),
+                 node_comm},
+          peer_buffers(node_comm.size()),
+          current_buffer{0},
+          pending_num_cols{0}
+    {
+        const auto comm = mtx.get_communicator();
+        const auto rank = comm.rank();
+        const auto send_size = mtx.send_offsets_.back();
+        std::vector<int> global_ranks(node_comm.size());
+        node_comm.all_gather(exec, &rank, 1, global_ranks.data(), 1);
+        node_comm.all_gather(exec, &send_size, 1, peer_send_sizes.data(), 1);
+        for (int node_rank = 0; node_rank < node_comm.size(); node_rank++) {
+            node_ranks[global_ranks[node_rank]] = node_rank;
+        }
+        comm.all_to_all(exec, mtx.send_offsets_.data(), 1,
+                        peer_send_offsets.data(), 1);
+        for (size_type i = 0; i < mtx.send_neighbors_.size(); i++) {
+            if (node_ranks[mtx.send_neighbors_[i]] >= 0) {
+                remote_send_sizes[i] = 0;
+            }
+        }
+        for (size_type i = 0; i < mtx.recv_neighbors_.size(); i++) {
+            if (node_ranks[mtx.recv_neighbors_[i]] >= 0) {
+                remote_recv_sizes[i] = 0;
+            }
+        }
+        window.lock_all(MPI_MODE_NOCHECK);
+        for (int node_rank = 0; node_rank < node_comm.size(); node_rank++) {
+            peer_buffers[node_rank] = window.shared_query(node_rank);
+        }
+    }
+
+    ~node_exchange() { MPI_Win_unlock_all(window.get_window()); }
+
+    // returns the given one of the two send buffers of a rank on the node
+    value_type* get_send_buffer(int node_rank, int buffer) const
+    {
+        return peer_buffers[node_rank] +
+               buffer * peer_send_sizes[node_rank] * max_num_cols;
+    }
+
+    mpi::communicator node_comm;
+    // node local rank of each rank, -1 for ranks on other nodes
+    std::vector<int> node_ranks;
+    // offset of the rows sent to this rank in the send buffer of each rank
+    std::vector<comm_index_type> peer_send_offsets;
+    // number of rows in the send buffers of each rank, by node local rank
+    std::vector<comm_index_type> peer_send_sizes;
+    // neighbor message sizes, excluding the neighbors on the same node
+    std::vector<comm_index_type> remote_send_sizes;
+    std::vector<comm_index_type> remote_recv_sizes;
+    // the maximum number of columns that fit into the send buffers
+    size_type max_num_cols;
+    mpi::window<value_type> window;
+    // memory of all ranks on the node, indexed by node local rank
+    std::vector<value_type*> peer_buffers;
+    // the send buffer used by the last exchange
+    int current_buffer;
+    // the number of columns of the last exchange, if its values from the
+    // ranks on the node still need to be copied by unpack_recv_buffer
+    size_type pending_num_cols;
+};
+
+
 template <typename ValueType, typename LocalIndexType, typename GlobalIndexType>
 mpi::request Matrix<ValueType, LocalIndexType, GlobalIndexType>::communicate(
     const local_vector_type* local_b) const
 {
     auto exec = this->get_executor();
-    const auto comm = this->get_communicator();
     auto num_cols = local_b->get_size()[1];
     auto send_size = send_offsets_.back();
     auto recv_size = recv_offsets_.back();
     auto send_dim = dim<2>{static_cast<size_type>(send_size), num_cols};
     auto recv_dim = dim<2>{static_cast<size_type>(recv_size), num_cols};
     recv_buffer_.init(exec, recv_dim);
+    reduced_precision_exchange_ =
+        this->uses_reduced_precision_communication(num_cols);
+    if (node_exchange_) {
+        // drop the intra-node values of an exchange that was never unpacked
+        node_exchange_->pending_num_cols = 0;
+    }
+    if (this->uses_node_aware_communication(num_cols)) {
+        return this->communicate_node_aware(local_b);
+    }
     send_buffer_.init(exec, send_dim);
 
     local_b->row_gather(&gather_idxs_, send_buffer_.get());
 
     auto use_host_buffer = exec->get_master() != exec && !mpi::is_gpu_aware();
+    auto comm_exec = use_host_buffer ? exec->get_master() : exec;
+    auto start_exchange = [&](const auto* send_ptr, auto* recv_ptr) {
+        using comm_value_type = std::decay_t<decltype(*recv_ptr)>;
+        mpi::contiguous_type type(
+            num_cols, mpi::type_impl<comm_value_type>::get_type());
+        exec->synchronize();
+        if (!neighbor_comm_) {
+            // no matrix has been read, so there is nothing to exchange
+            return mpi::request{};
+        }
+        const auto& comm = *neighbor_comm_;
+#ifdef GINKGO_FORCE_SPMV_BLOCKING_COMM
+        comm.neighbor_all_to_all_v(
+            comm_exec, send_ptr, neighbor_send_sizes_.data(),
+            neighbor_send_offsets_.data(), type.get(), recv_ptr,
+            neighbor_recv_sizes_.data(), neighbor_recv_offsets_.data(),
+            type.get());
+        return mpi::request{};
+#else
+        return comm.i_neighbor_all_to_all_v(
+            comm_exec, send_ptr, neighbor_send_sizes_.data(),
+            neighbor_send_offsets_.data(), type.get(), recv_ptr,
+            neighbor_recv_sizes_.data(), neighbor_recv_offsets_.data(),
+            type.get());
+#endif
+    };
+
+    if (reduced_precision_exchange_) {
+        // the conversion also moves the values to the host buffers if needed,
+        // unpack_recv_buffer converts the received values back
+        reduced_recv_buffer_.init(comm_exec, recv_dim);
+        reduced_send_buffer_.init(comm_exec, send_dim);
+        send_buffer_->convert_to(reduced_send_buffer_.get());
+        return start_exchange(reduced_send_buffer_->get_const_values(),
+                              reduced_recv_buffer_->get_values());
+    }
     if (use_host_buffer) {
         host_recv_buffer_.init(exec->get_master(), recv_dim);
         host_send_buffer_.init(exec->get_master(), send_dim);
         host_send_buffer_->copy_from(send_buffer_.get());
     }
+    return start_exchange(use_host_buffer
+                              ? host_send_buffer_->get_const_values()
+                              : send_buffer_->get_const_values(),
+                          use_host_buffer ? host_recv_buffer_->get_values()
+                                          : recv_buffer_->get_values());
+}
+
+
+template <typename ValueType, typename LocalIndexType, typename GlobalIndexType>
+bool Matrix<ValueType, LocalIndexType, GlobalIndexType>::
+    uses_node_aware_communication(size_type num_cols) const
+{
+    auto exec = this->get_executor();
+    return node_exchange_ && exec == exec->get_master() &&
+           num_cols <= node_exchange_->max_num_cols;
+}
+
+
+template <typename ValueType, typename LocalIndexType, typename GlobalIndexType>
+bool Matrix<ValueType, LocalIndexType, GlobalIndexType>::
+    uses_reduced_precision_communication(size_type num_cols) const
+{
+    return reduced_precision_communication_ &&
+           sizeof(next_precision<value_type>) < sizeof(value_type) &&
+           !this->uses_node_aware_communication(num_cols);
+}
+
+
+template <typename ValueType, typename LocalIndexType, typename GlobalIndexType>
+void Matrix<ValueType, LocalIndexType, GlobalIndexType>::
+    set_node_aware_communication(bool enabled, size_type max_num_cols)
+{
+    node_aware_communication_ = enabled;
+    node_aware_max_num_cols_ = max_num_cols;
+    this->init_node_exchange();
+}
+
+
+template <typename ValueType, typename LocalIndexType, typename GlobalIndexType>
+void Matrix<ValueType, LocalIndexType, GlobalIndexType>::init_node_exchange()
+{
+    auto exec = this->get_executor();
+    // the old window needs to be freed before allocating a new one
+    node_exchange_.reset();
+    if (node_aware_communication_ && neighbor_comm_ &&
+        exec == exec->get_master()) {
+        node_exchange_ = std::make_shared<node_exchange>(
+            exec, *this, node_aware_max_num_cols_);
+    }
+}
+
+
+template <typename ValueType, typename LocalIndexType, typename GlobalIndexType>
+void Matrix<ValueType, LocalIndexType, GlobalIndexType>::unpack_recv_buffer()
+    const
+{
+    auto exec = this->get_executor();
+    if (node_exchange_ && node_exchange_->pending_num_cols > 0) {
+        auto& node = *node_exchange_;
+        const auto num_cols = node.pending_num_cols;
+        auto recv_ptr = recv_buffer_->get_values();
+        // the barrier in communicate_node_aware made the values visible
+        node.window.sync();
+        for (size_type i = 0; i < recv_neighbors_.size(); i++) {
+            const auto node_rank = node.node_ranks[recv_neighbors_[i]];
+            if (node_rank >= 0) {
+                std::copy_n(node.get_send_buffer(node_rank,
+                                                 node.current_buffer) +
+                                node.peer_send_offsets[recv_neighbors_[i]] *
+                                    num_cols,
+                            neighbor_recv_sizes_[i] * num_cols,
+                            recv_ptr + neighbor_recv_offsets_[i] * num_cols);
+            }
+        }
+        node.pending_num_cols = 0;
+    }
+    if (reduced_precision_exchange_) {
+        recv_buffer_->copy_from(reduced_recv_buffer_.get());
+    } else if (exec->get_master() != exec && !mpi::is_gpu_aware()) {
+        recv_buffer_->copy_from(host_recv_buffer_.get());
+    }
+}
+
+
+template <typename ValueType, typename LocalIndexType, typename GlobalIndexType>
+mpi::request
+Matrix<ValueType, LocalIndexType, GlobalIndexType>::communicate_node_aware(
+    const local_vector_type* local_b) const
+{
+    auto exec = this->get_executor();
+    const auto num_cols = local_b->get_size()[1];
+    const auto send_size = static_cast<size_type>(send_offsets_.back());
+    auto& node = *node_exchange_;
+    // alternate between the two send buffers, so the buffer written here was
+    // last read before the other ranks entered the barrier of the previous
+    // exchange, and no second barrier is needed after reading
+    node.current_buffer = 1 - node.current_buffer;
+    // gather the send buffer directly into the shared memory window
+    auto send_buffer = local_vector_type::create(
+        exec, dim<2>{send_size, num_cols},
+        make_array_view(
+            exec, send_size * num_cols,
+            node.get_send_buffer(node.node_comm.rank(), node.current_buffer)),
+        num_cols);
+    local_b->row_gather(&gather_idxs_, send_buffer.get());
+    auto recv_ptr = recv_buffer_->get_values();
 
     mpi::contiguous_type type(num_cols, mpi::type_impl<ValueType>::get_type());
-    auto send_ptr = use_host_buffer ? host_send_buffer_->get_const_values()
-                                    : send_buffer_->get_const_values();
-    auto recv_ptr = use_host_buffer ? host_recv_buffer_->get_values()
-                                    : recv_buffer_->get_values();
-    exec->synchronize();
+    const auto& comm = *neighbor_comm_;
 #ifdef GINKGO_FORCE_SPMV_BLOCKING_COMM
-    comm.all_to_all_v(use_host_buffer ? exec->get_master() : exec, send_ptr,
-                      send_sizes_.data(), send_offsets_.data(), type.get(),
-                      recv_ptr, recv_sizes_.data(), recv_offsets_.data(),
-                      type.get());
-    return {};
+    comm.neighbor_all_to_all_v(
+        exec, send_buffer->get_const_values(), node.remote_send_sizes.data(),
+        neighbor_send_offsets_.data(), type.get(), recv_ptr,
+        node.remote_recv_sizes.data(), neighbor_recv_offsets_.data(),
+        type.get());
+    mpi::request req;
 #else
-    return comm.i_all_to_all_v(
-        use_host_buffer ? exec->get_master() : exec, send_ptr,
-        send_sizes_.data(), send_offsets_.data(), type.get(), recv_ptr,
-        recv_sizes_.data(), recv_offsets_.data(), type.get());
+    auto req = comm.i_neighbor_all_to_all_v(
+        exec, send_buffer->get_const_values(), node.remote_send_sizes.data(),
+        neighbor_send_offsets_.data(), type.get(), recv_ptr,
+        node.remote_recv_sizes.data(), neighbor_recv_offsets_.data(),
+        type.get());
 #endif
+
+    // wait until all ranks on the node have written their send buffers, the
+    // values are copied by unpack_recv_buffer after the local SpMV
+    node.window.sync();
+    node.node_comm.synchronize();
+    node.pending_num_cols = num_cols;
+    return req;
 }
 
 
@@ -318,16 +964,17 @@ void Matrix<ValueType, LocalIndexType, GlobalIndexType>::apply_impl(
                     dense_x->get_local_values()),
                 dense_x->get_local_vector()->get_stride());
 
+            if (overlap_mode_ == overlap_mode::interior_boundary &&
+                this->apply_interior_boundary(nullptr,
+                                              dense_b->get_local_vector(),
+                                              nullptr, local_x.get())) {
+                return;
+            }
+
             auto req = this->communicate(dense_b->get_local_vector());
             local_mtx_->apply(dense_b->get_local_vector(), local_x.get());
             req.wait();
-
-            auto exec = this->get_executor();
-            auto use_host_buffer =
-                exec->get_master() != exec && !mpi::is_gpu_aware();
-            if (use_host_buffer) {
-                recv_buffer_->copy_from(host_recv_buffer_.get());
-            }
+            this->unpack_recv_buffer();
             non_local_mtx_->apply(one_scalar_.get(), recv_buffer_.get(),
                                   one_scalar_.get(), local_x.get());
         },
@@ -351,17 +998,18 @@ void Matrix<ValueType, LocalIndexType, GlobalIndexType>::apply_impl(
                     dense_x->get_local_values()),
                 dense_x->get_local_vector()->get_stride());
 
+            if (overlap_mode_ == overlap_mode::interior_boundary &&
+                this->apply_interior_boundary(local_alpha,
+                                              dense_b->get_local_vector(),
+                                              local_beta, local_x.get())) {
+                return;
+            }
+
             auto req = this->communicate(dense_b->get_local_vector());
             local_mtx_->apply(local_alpha, dense_b->get_local_vector(),
                               local_beta, local_x.get());
             req.wait();
-
-            auto exec = this->get_executor();
-            auto use_host_buffer =
-                exec->get_master() != exec && !mpi::is_gpu_aware();
-            if (use_host_buffer) {
-                recv_buffer_->copy_from(host_recv_buffer_.get());
-            }
+            this->unpack_recv_buffer();
             non_local_mtx_->apply(local_alpha, recv_buffer_.get(),
                                   one_scalar_.get(), local_x.get());
         },
@@ -369,11 +1017,47 @@ void Matrix<ValueType, LocalIndexType, GlobalIndexType>::apply_impl(
 }
 
 
+template <typename ValueType, typename LocalIndexType, typename GlobalIndexType>
+bool Matrix<ValueType, LocalIndexType, GlobalIndexType>::
+    apply_interior_boundary(const local_vector_type* alpha,
+                            const local_vector_type* local_b,
+                            const local_vector_type* beta,
+                            local_vector_type* local_x) const
+{
+    using local_csr_type = gko::matrix::Csr<value_type, local_index_type>;
+    auto exec = this->get_executor();
+    // the row subset SpMV is only implemented for host executors
+    if (exec != exec->get_master()) {
+        return false;
+    }
+    auto local_csr = dynamic_cast<const local_csr_type*>(local_mtx_.get());
+    auto non_local_csr =
+        dynamic_cast<const local_csr_type*>(non_local_mtx_.get());
+    if (!local_csr || !non_local_csr) {
+        return false;
+    }
+    // communicate gathers the send buffer before starting the exchange, so
+    // the interior rows can be computed while the messages are in flight
+    auto req = this->communicate(local_b);
+    exec->run(matrix::make_row_subset_spmv(
+        interior_rows_, alpha, local_csr, local_b,
+        static_cast<const local_csr_type*>(nullptr),
+        static_cast<const local_vector_type*>(nullptr), beta, local_x));
+    req.wait();
+    this->unpack_recv_buffer();
+    exec->run(matrix::make_row_subset_spmv(boundary_rows_, alpha, local_csr,
+                                           local_b, non_local_csr,
+                                           recv_buffer_.get(), beta, local_x));
+    return true;
+}
+
+
 template <typename ValueType, typename LocalIndexType, typename GlobalIndexType>
 Matrix<ValueType, LocalIndexType, GlobalIndexType>::Matrix(const Matrix& other)
     : EnableDistributedLinOp<Matrix<value_type, local_index_type,
                                     global_index_type>>{other.get_executor()},
-      DistributedBase{other.get_communicator()}
+      DistributedBase{other.get_communicator()},
+      reduced_precision_exchange_{false}
 {
     *this = other;
 }
@@ -384,7 +1068,8 @@ Matrix<ValueType, LocalIndexType, GlobalIndexType>::Matrix(
     Matrix&& other) noexcept
     : EnableDistributedLinOp<Matrix<value_type, local_index_type,
                                     global_index_type>>{other.get_executor()},
-      DistributedBase{other.get_communicator()}
+      DistributedBase{other.get_communicator()},
+      reduced_precision_exchange_{false}
 {
     *this = std::move(other);
 }
@@ -406,9 +1091,26 @@ Matrix<ValueType, LocalIndexType, GlobalIndexType>::operator=(
         recv_offsets_ = other.recv_offsets_;
         send_sizes_ = other.send_sizes_;
         recv_sizes_ = other.recv_sizes_;
+        send_neighbors_ = other.send_neighbors_;
+        neighbor_send_offsets_ = other.neighbor_send_offsets_;
+        neighbor_send_sizes_ = other.neighbor_send_sizes_;
+        recv_neighbors_ = other.recv_neighbors_;
+        neighbor_recv_offsets_ = other.neighbor_recv_offsets_;
+        neighbor_recv_sizes_ = other.neighbor_recv_sizes_;
+        neighbor_comm_ = other.neighbor_comm_;
+        interior_rows_ = other.interior_rows_;
+        boundary_rows_ = other.boundary_rows_;
+        overlap_mode_ = other.overlap_mode_;
+        node_aware_communication_ = other.node_aware_communication_;
+        node_aware_max_num_cols_ = other.node_aware_max_num_cols_;
+        reduced_precision_communication_ =
+            other.reduced_precision_communication_;
         non_local_to_global_ = other.non_local_to_global_;
+        row_partition_ = other.row_partition_;
+        col_partition_ = other.col_partition_;
         one_scalar_.init(this->get_executor(), dim<2>{1, 1});
         one_scalar_->fill(one<value_type>());
+        this->init_node_exchange();
     }
     return *this;
 }
@@ -430,7 +1132,24 @@ Matrix<ValueType, LocalIndexType, GlobalIndexType>::operator=(Matrix&& other)
         recv_offsets_ = std::move(other.recv_offsets_);
         send_sizes_ = std::move(other.send_sizes_);
         recv_sizes_ = std::move(other.recv_sizes_);
+        send_neighbors_ = std::move(other.send_neighbors_);
+        neighbor_send_offsets_ = std::move(other.neighbor_send_offsets_);
+        neighbor_send_sizes_ = std::move(other.neighbor_send_sizes_);
+        recv_neighbors_ = std::move(other.recv_neighbors_);
+        neighbor_recv_offsets_ = std::move(other.neighbor_recv_offsets_);
+        neighbor_recv_sizes_ = std::move(other.neighbor_recv_sizes_);
+        neighbor_comm_ = std::move(other.neighbor_comm_);
+        interior_rows_ = std::move(other.interior_rows_);
+        boundary_rows_ = std::move(other.boundary_rows_);
+        overlap_mode_ = std::move(other.overlap_mode_);
+        node_aware_communication_ = other.node_aware_communication_;
+        node_aware_max_num_cols_ = other.node_aware_max_num_cols_;
+        reduced_precision_communication_ =
+            other.reduced_precision_communication_;
+        node_exchange_ = std::move(other.node_exchange_);
         non_local_to_global_ = std::move(other.non_local_to_global_);
+        row_partition_ = std::move(other.row_partition_);
+        col_partition_ = std::move(other.col_partition_);
         one_scalar_.init(this->get_executor(), dim<2>{1, 1});
         one_scalar_->fill(one<value_type>());
     }
@@ -39,6 +39,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ginkgo/core/base/matrix_data.hpp>
 #include <ginkgo/core/base/types.hpp>
 #include <ginkgo/core/distributed/partition.hpp>
+#include <ginkgo/core/matrix/csr.hpp>
+#include <ginkgo/core/matrix/dense.hpp>
 
 
 #include "core/base/kernel_declaration.hpp"
@@ -67,12 +69,33 @@ namespace kernels {
         array<GlobalIndexType>& non_local_to_global)
 
 
+/**
+ * Computes x(rows) = alpha * (local_mtx(rows, :) * local_b +
+ * non_local_mtx(rows, :) * recv_b) + beta * x(rows) for the given subset of
+ * local rows, leaving all other rows of x untouched. If alpha and beta are
+ * nullptr, x(rows) is overwritten by the product, if non_local_mtx and recv_b
+ * are nullptr, only the local entries are used.
+ */
+#define GKO_DECLARE_ROW_SUBSET_SPMV(ValueType, LocalIndexType)            \
+    void row_subset_spmv(                                                 \
+        std::shared_ptr<const DefaultExecutor> exec,                      \
+        const array<LocalIndexType>& rows,                                \
+        const matrix::Dense<ValueType>* alpha,                            \
+        const matrix::Csr<ValueType, LocalIndexType>* local_mtx,          \
+        const matrix::Dense<ValueType>* local_b,                          \
+        const matrix::Csr<ValueType, LocalIndexType>* non_local_mtx,      \
+        const matrix::Dense<ValueType>* recv_b,                           \
+        const matrix::Dense<ValueType>* beta, matrix::Dense<ValueType>* x)
+
+
 #define GKO_DECLARE_ALL_AS_TEMPLATES                                    \
     using comm_index_type = experimental::distributed::comm_index_type; \
     template <typename ValueType, typename LocalIndexType,              \
               typename GlobalIndexType>                                 \
     GKO_DECLARE_BUILD_LOCAL_NONLOCAL(ValueType, LocalIndexType,         \
-                                     GlobalIndexType)
+                                     GlobalIndexType);                  \
+    template <typename ValueType, typename LocalIndexType>              \
+    GKO_DECLARE_ROW_SUBSET_SPMV(ValueType, LocalIndexType)
 
 
 GKO_DECLARE_FOR_ALL_EXECUTOR_NAMESPACES(distributed_matrix,
@@ -0,0 +1,103 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2022, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#include <ginkgo/core/distributed/mtx_io.hpp>
+
+
+#include <ginkgo/core/base/array.hpp>
+#include <ginkgo/core/base/exception_helpers.hpp>
+#include <ginkgo/core/base/mtx_io.hpp>
+
+
+namespace gko {
+namespace experimental {
+namespace distributed {
+
+
+template <typename ValueType, typename LocalIndexType,
+          typename GlobalIndexType>
+device_matrix_data<ValueType, GlobalIndexType> read_binary_distributed_raw(
+    std::shared_ptr<const Executor> exec, std::istream& is,
+    const Partition<LocalIndexType, GlobalIndexType>* partition,
+    comm_index_type part_id)
+{
+    const auto host_exec = exec->get_master();
+    const auto part_exec = partition->get_executor();
+    const auto num_ranges = partition->get_num_ranges();
+    const auto range_bounds =
+        make_const_array_view(part_exec, num_ranges + 1,
+                              partition->get_range_bounds())
+            .copy_to_array();
+    const auto part_ids = make_const_array_view(part_exec, num_ranges,
+                                                partition->get_part_ids())
+                              .copy_to_array();
+    const array<GlobalIndexType> host_range_bounds{host_exec, range_bounds};
+    const array<comm_index_type> host_part_ids{host_exec, part_ids};
+    const auto begin = is.tellg();
+    // an empty row range still provides the size of the matrix
+    auto data =
+        read_binary_rows_raw<ValueType, GlobalIndexType>(is, span{0, 0});
+    GKO_ASSERT_EQ(data.size[0], partition->get_size());
+    for (size_type range = 0; range < num_ranges; range++) {
+        if (host_part_ids.get_const_data()[range] != part_id) {
+            continue;
+        }
+        is.seekg(begin);
+        const auto range_data =
+            read_binary_rows_raw<ValueType, GlobalIndexType>(
+                is, span{static_cast<size_type>(
+                             host_range_bounds.get_const_data()[range]),
+                         static_cast<size_type>(
+                             host_range_bounds.get_const_data()[range + 1])});
+        data.nonzeros.insert(data.nonzeros.end(), range_data.nonzeros.begin(),
+                             range_data.nonzeros.end());
+    }
+    return device_matrix_data<ValueType, GlobalIndexType>::create_from_host(
+        exec, data);
+}
+
+
+#define GKO_DECLARE_READ_BINARY_DISTRIBUTED_RAW(ValueType, LocalIndexType,  \
+                                                GlobalIndexType)            \
+    device_matrix_data<ValueType, GlobalIndexType>                          \
+    read_binary_distributed_raw(                                            \
+        std::shared_ptr<const Executor> exec, std::istream& is,             \
+        const Partition<LocalIndexType, GlobalIndexType>* partition,        \
+        comm_index_type part_id)
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_LOCAL_GLOBAL_INDEX_TYPE(
+    GKO_DECLARE_READ_BINARY_DISTRIBUTED_RAW);
+
+
+}  // namespace distributed
+}  // namespace experimental
+}  // namespace gko
@@ -0,0 +1,526 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2022, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+
+#include <ginkgo/core/distributed/partition_helpers.hpp>
+
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <queue>
+#include <utility>
+#include <vector>
+
+
+#include <ginkgo/core/base/exception_helpers.hpp>
+#include <ginkgo/core/base/temporary_clone.hpp>
+#include <ginkgo/core/matrix/csr.hpp>
+
+
+namespace gko {
+namespace experimental {
+namespace distributed {
+namespace {
+
+
+/**
+ * An undirected graph in CSR format with vertex and edge weights. The weight
+ * of a vertex is the number of rows it represents, the weight of an edge is
+ * the number of matrix entries coupling its endpoints.
+ */
+template <typename IndexType>
+struct weighted_graph {
+    IndexType get_num_vertices() const
+    {
+        return static_cast<IndexType>(vertex_weights.size());
+    }
+
+    std::vector<IndexType> row_ptrs;
+    std::vector<IndexType> col_idxs;
+    std::vector<IndexType> edge_weights;
+    std::vector<IndexType> vertex_weights;
+};
+
+
+/**
+ * Builds the symmetrized adjacency graph of the given entries, ignoring the
+ * diagonal.
+ */
+template <typename IndexType>
+weighted_graph<IndexType> build_graph(
+    IndexType num_vertices, std::vector<std::pair<IndexType, IndexType>> edges)
+{
+    const auto num_entries = edges.size();
+    for (size_type i = 0; i < num_entries; i++) {
+        edges.emplace_back(edges[i].second, edges[i].first);
+    }
+    edges.erase(std::remove_if(edges.begin(), edges.end(),
+                               [](std::pair<IndexType, IndexType> edge) {
+                                   return edge.first == edge.second;
+                               }),
+                edges.end());
+    std::sort(edges.begin(), edges.end());
+    weighted_graph<IndexType> graph;
+    graph.row_ptrs.assign(num_vertices + 1, 0);
+    graph.vertex_weights.assign(num_vertices, 1);
+    for (size_type i = 0; i < edges.size(); i++) {
+        if (i > 0 && edges[i] == edges[i - 1]) {
+            graph.edge_weights.back()++;
+        } else {
+            graph.col_idxs.push_back(edges[i].second);
+            graph.edge_weights.push_back(1);
+            graph.row_ptrs[edges[i].first + 1]++;
+        }
+    }
+    std::partial_sum(graph.row_ptrs.begin(), graph.row_ptrs.end(),
+                     graph.row_ptrs.begin());
+    return graph;
+}
+
+
+/**
+ * Computes a heavy-edge matching: every vertex is matched with the unmatched
+ * neighbor it shares the heaviest edge with, unless the combined vertex would
+ * be heavier than max_vertex_weight. The vertices are visited by increasing
+ * degree, so vertices with few neighbors still find a partner.
+ *
+ * @return  the number of coarse vertices, coarse_map maps every vertex to its
+ *          coarse vertex.
+ */
+template <typename IndexType>
+IndexType match_heavy_edges(const weighted_graph<IndexType>& graph,
+                            IndexType max_vertex_weight,
+                            std::vector<IndexType>& coarse_map)
+{
+    const auto num_vertices = graph.get_num_vertices();
+    std::vector<IndexType> order(num_vertices);
+    std::iota(order.begin(), order.end(), IndexType{});
+    std::stable_sort(order.begin(), order.end(),
+                     [&graph](IndexType a, IndexType b) {
+                         return graph.row_ptrs[a + 1] - graph.row_ptrs[a] <
+                                graph.row_ptrs[b + 1] - graph.row_ptrs[b];
+                     });
+    coarse_map.assign(num_vertices, -1);
+    IndexType num_coarse{};
+    for (auto vertex : order) {
+        if (coarse_map[vertex] != -1) {
+            continue;
+        }
+        auto partner = vertex;
+        IndexType max_weight{};
+        for (auto nz = graph.row_ptrs[vertex]; nz < graph.row_ptrs[vertex + 1];
+             nz++) {
+            const auto neighbor = graph.col_idxs[nz];
+            if (coarse_map[neighbor] == -1 &&
+                graph.edge_weights[nz] > max_weight &&
+                graph.vertex_weights[vertex] +
+                        graph.vertex_weights[neighbor] <=
+                    max_vertex_weight) {
+                partner = neighbor;
+                max_weight = graph.edge_weights[nz];
+            }
+        }
+        coarse_map[vertex] = num_coarse;
+        coarse_map[partner] = num_coarse;
+        num_coarse++;
+    }
+    return num_coarse;
+}
+
+
+/**
+ * Contracts the graph along the given mapping to coarse vertices. The weights
+ * of merged vertices and parallel edges are summed up, edges inside a coarse
+ * vertex are dropped.
+ */
+template <typename IndexType>
+weighted_graph<IndexType> contract(const weighted_graph<IndexType>& fine,
+                                   const std::vector<IndexType>& coarse_map,
+                                   IndexType num_coarse)
+{
+    const auto num_fine = fine.get_num_vertices();
+    // group the fine vertices by their coarse vertex
+    std::vector<IndexType> member_ptrs(num_coarse + 1);
+    std::vector<IndexType> members(num_fine);
+    for (IndexType vertex = 0; vertex < num_fine; vertex++) {
+        member_ptrs[coarse_map[vertex] + 1]++;
+    }
+    std::partial_sum(member_ptrs.begin(), member_ptrs.end(),
+                     member_ptrs.begin());
+    auto fill_ptrs = member_ptrs;
+    for (IndexType vertex = 0; vertex < num_fine; vertex++) {
+        members[fill_ptrs[coarse_map[vertex]]++] = vertex;
+    }
+    weighted_graph<IndexType> coarse;
+    coarse.row_ptrs.push_back(0);
+    coarse.vertex_weights.assign(num_coarse, 0);
+    std::vector<IndexType> accumulator(num_coarse);
+    std::vector<IndexType> marker(num_coarse, -1);
+    std::vector<IndexType> neighbors;
+    for (IndexType cvertex = 0; cvertex < num_coarse; cvertex++) {
+        neighbors.clear();
+        for (auto i = member_ptrs[cvertex]; i < member_ptrs[cvertex + 1]; i++) {
+            const auto vertex = members[i];
+            coarse.vertex_weights[cvertex] += fine.vertex_weights[vertex];
+            for (auto nz = fine.row_ptrs[vertex];
+                 nz < fine.row_ptrs[vertex + 1]; nz++) {
+                const auto cneighbor = coarse_map[fine.col_idxs[nz]];
+                if (cneighbor == cvertex) {
+                    continue;
+                }
+                if (marker[cneighbor] != cvertex) {
+                    marker[cneighbor] = cvertex;
+                    accumulator[cneighbor] = 0;
+                    neighbors.push_back(cneighbor);
+                }
+                accumulator[cneighbor] += fine.edge_weights[nz];
+            }
+        }
+        std::sort(neighbors.begin(), neighbors.end());
+        for (auto cneighbor : neighbors) {
+            coarse.col_idxs.push_back(cneighbor);
+            coarse.edge_weights.push_back(accumulator[cneighbor]);
+        }
+        coarse.row_ptrs.push_back(static_cast<IndexType>(neighbors.size()) +
+                                  coarse.row_ptrs.back());
+    }
+    return coarse;
+}
+
+
+/**
+ * Partitions the graph by greedy graph growing: the parts are grown one after
+ * another from a seed vertex, always adding the unassigned vertex with the
+ * strongest connection to the current part, until the part has its share of
+ * the remaining vertex weight. The seeds are the first unassigned vertices
+ * starting from first_seed.
+ */
+template <typename IndexType>
+std::vector<comm_index_type> grow_partition(
+    const weighted_graph<IndexType>& graph, comm_index_type num_parts,
+    IndexType first_seed)
+{
+    const auto num_vertices = graph.get_num_vertices();
+    std::vector<comm_index_type> parts(num_vertices, -1);
+    std::vector<IndexType> connection(num_vertices);
+    auto remaining_weight = std::accumulate(graph.vertex_weights.begin(),
+                                            graph.vertex_weights.end(),
+                                            IndexType{});
+    IndexType num_seeds_tried{};
+    for (comm_index_type part = 0; part < num_parts - 1; part++) {
+        const auto target_weight = remaining_weight / (num_parts - part);
+        IndexType part_weight{};
+        // max-heap of (connection, -vertex), outdated entries are skipped
+        std::priority_queue<std::pair<IndexType, IndexType>> candidates;
+        while (part_weight < target_weight) {
+            if (candidates.empty()) {
+                // the part is not connected, continue from a new seed
+                auto seed = (first_seed + num_seeds_tried) % num_vertices;
+                while (num_seeds_tried < num_vertices && parts[seed] != -1) {
+                    num_seeds_tried++;
+                    seed = (first_seed + num_seeds_tried) % num_vertices;
+                }
+                if (num_seeds_tried == num_vertices) {
+                    break;
+                }
+                candidates.emplace(0, -seed);
+            }
+            const auto candidate = candidates.top();
+            candidates.pop();
+            const auto vertex = -candidate.second;
+            if (parts[vertex] != -1 || candidate.first != connection[vertex]) {
+                continue;
+            }
+            parts[vertex] = part;
+            part_weight += graph.vertex_weights[vertex];
+            for (auto nz = graph.row_ptrs[vertex];
+                 nz < graph.row_ptrs[vertex + 1]; nz++) {
+                const auto neighbor = graph.col_idxs[nz];
+                if (parts[neighbor] == -1) {
+                    connection[neighbor] += graph.edge_weights[nz];
+                    candidates.emplace(connection[neighbor], -neighbor);
+                }
+            }
+        }
+        remaining_weight -= part_weight;
+        std::fill(connection.begin(), connection.end(), 0);
+    }
+    std::replace(parts.begin(), parts.end(), -1, num_parts - 1);
+    return parts;
+}
+
+
+/**
+ * Refines the partition by moving boundary vertices to the neighboring part
+ * with the largest reduction of the edge cut (the Fiduccia-Mattheyses gain),
+ * as long as the target part stays below max_part_weight. Moves without gain
+ * are only done if they improve the balance, and vertices of overweight parts
+ * are moved even with negative gain.
+ */
+template <typename IndexType>
+void refine_partition(const weighted_graph<IndexType>& graph,
+                      comm_index_type num_parts, IndexType max_part_weight,
+                      std::vector<comm_index_type>& parts)
+{
+    constexpr int max_passes = 8;
+    const auto num_vertices = graph.get_num_vertices();
+    std::vector<IndexType> part_weights(num_parts);
+    for (IndexType vertex = 0; vertex < num_vertices; vertex++) {
+        part_weights[parts[vertex]] += graph.vertex_weights[vertex];
+    }
+    std::vector<IndexType> connection(num_parts);
+    std::vector<comm_index_type> neighbor_parts;
+    for (int pass = 0; pass < max_passes; pass++) {
+        bool moved = false;
+        for (IndexType vertex = 0; vertex < num_vertices; vertex++) {
+            const auto from = parts[vertex];
+            const auto weight = graph.vertex_weights[vertex];
+            neighbor_parts.clear();
+            for (auto nz = graph.row_ptrs[vertex];
+                 nz < graph.row_ptrs[vertex + 1]; nz++) {
+                const auto part = parts[graph.col_idxs[nz]];
+                if (connection[part] == 0 && part != from) {
+                    neighbor_parts.push_back(part);
+                }
+                connection[part] += graph.edge_weights[nz];
+            }
+            const auto overweight = part_weights[from] > max_part_weight;
+            auto best_part = from;
+            IndexType best_gain{};
+            for (auto part : neighbor_parts) {
+                const auto gain = connection[part] - connection[from];
+                if (part_weights[part] + weight > max_part_weight) {
+                    continue;
+                }
+                const auto improves_balance =
+                    part_weights[part] + weight < part_weights[from];
+                if ((overweight && best_part == from) || gain > best_gain ||
+                    (gain == best_gain && improves_balance &&
+                     (best_part == from ||
+                      part_weights[part] < part_weights[best_part]))) {
+                    best_part = part;
+                    best_gain = gain;
+                }
+            }
+            for (auto part : neighbor_parts) {
+                connection[part] = 0;
+            }
+            connection[from] = 0;
+            if (best_part != from && part_weights[from] > weight) {
+                parts[vertex] = best_part;
+                part_weights[from] -= weight;
+                part_weights[best_part] += weight;
+                moved = true;
+            }
+        }
+        if (!moved) {
+            break;
+        }
+    }
+}
+
+
+/**
+ * Returns the total weight of the edges between different parts.
+ */
+template <typename IndexType>
+IndexType compute_edge_cut(const weighted_graph<IndexType>& graph,
+                           const std::vector<comm_index_type>& parts)
+{
+    IndexType cut{};
+    for (IndexType vertex = 0; vertex < graph.get_num_vertices(); vertex++) {
+        for (auto nz = graph.row_ptrs[vertex]; nz < graph.row_ptrs[vertex + 1];
+             nz++) {
+            if (parts[vertex] != parts[graph.col_idxs[nz]]) {
+                cut += graph.edge_weights[nz];
+            }
+        }
+    }
+    return cut;
+}
+
+
+template <typename IndexType>
+std::vector<comm_index_type> partition_graph(weighted_graph<IndexType> graph,
+                                             comm_index_type num_parts,
+                                             double imbalance)
+{
+    const auto num_vertices = graph.get_num_vertices();
+    if (num_parts == 1) {
+        return std::vector<comm_index_type>(num_vertices, 0);
+    }
+    const auto total_weight = num_vertices;
+    const auto max_part_weight = std::max<IndexType>(
+        static_cast<IndexType>(
+            std::ceil((1.0 + imbalance) * total_weight / num_parts)),
+        1);
+    // coarsen until the graph is small enough to be partitioned directly or
+    // the matching doesn't reduce its size significantly anymore
+    const auto coarsening_limit = std::max<IndexType>(20 * num_parts, 100);
+    const auto max_vertex_weight = std::max<IndexType>(
+        static_cast<IndexType>(1.5 * total_weight / coarsening_limit), 1);
+    std::vector<weighted_graph<IndexType>> levels;
+    std::vector<std::vector<IndexType>> coarse_maps;
+    levels.push_back(std::move(graph));
+    while (levels.back().get_num_vertices() > coarsening_limit) {
+        std::vector<IndexType> coarse_map;
+        const auto num_coarse =
+            match_heavy_edges(levels.back(), max_vertex_weight, coarse_map);
+        if (num_coarse > 0.95 * levels.back().get_num_vertices()) {
+            break;
+        }
+        levels.push_back(contract(levels.back(), coarse_map, num_coarse));
+        coarse_maps.push_back(std::move(coarse_map));
+    }
+    // the coarsest graph is small, so the initial partition is grown from
+    // several seeds and the one with the smallest edge cut is kept
+    constexpr IndexType num_initial_tries = 8;
+    const auto& coarsest = levels.back();
+    std::vector<comm_index_type> parts;
+    IndexType best_cut{};
+    for (IndexType i = 0; i < num_initial_tries; i++) {
+        const auto seed = static_cast<IndexType>(
+            static_cast<int64>(i) * coarsest.get_num_vertices() /
+            num_initial_tries);
+        auto candidate = grow_partition(coarsest, num_parts, seed);
+        refine_partition(coarsest, num_parts, max_part_weight, candidate);
+        const auto cut = compute_edge_cut(coarsest, candidate);
+        if (parts.empty() || cut < best_cut) {
+            parts = std::move(candidate);
+            best_cut = cut;
+        }
+    }
+    // project the partition back to the finer levels and refine it there
+    for (auto level = coarse_maps.size(); level > 0; level--) {
+        const auto& coarse_map = coarse_maps[level - 1];
+        std::vector<comm_index_type> fine_parts(coarse_map.size());
+        for (size_type vertex = 0; vertex < coarse_map.size(); vertex++) {
+            fine_parts[vertex] = parts[coarse_map[vertex]];
+        }
+        parts = std::move(fine_parts);
+        refine_partition(levels[level - 1], num_parts, max_part_weight, parts);
+    }
+    return parts;
+}
+
+
+template <typename LocalIndexType, typename GlobalIndexType>
+std::unique_ptr<Partition<LocalIndexType, GlobalIndexType>>
+build_partition_from_edges(
+    std::shared_ptr<const Executor> exec, size_type num_vertices,
+    std::vector<std::pair<GlobalIndexType, GlobalIndexType>> edges,
+    comm_index_type num_parts, double imbalance)
+{
+    GKO_ASSERT(num_parts > 0);
+    auto parts = partition_graph(
+        build_graph(static_cast<GlobalIndexType>(num_vertices),
+                    std::move(edges)),
+        num_parts, imbalance);
+    array<comm_index_type> mapping{exec->get_master(), parts.begin(),
+                                   parts.end()};
+    return Partition<LocalIndexType, GlobalIndexType>::build_from_mapping(
+        exec, mapping, num_parts);
+}
+
+
+}  // namespace
+
+
+template <typename LocalIndexType, typename GlobalIndexType,
+          typename ValueType>
+std::unique_ptr<Partition<LocalIndexType, GlobalIndexType>>
+build_partition_from_graph(
+    std::shared_ptr<const Executor> exec,
+    const matrix::Csr<ValueType, GlobalIndexType>* graph,
+    comm_index_type num_parts, double imbalance)
+{
+    GKO_ASSERT_IS_SQUARE_MATRIX(graph);
+    auto host_graph = make_temporary_clone(exec->get_master(), graph);
+    const auto num_rows = host_graph->get_size()[0];
+    const auto row_ptrs = host_graph->get_const_row_ptrs();
+    const auto col_idxs = host_graph->get_const_col_idxs();
+    std::vector<std::pair<GlobalIndexType, GlobalIndexType>> edges;
+    edges.reserve(host_graph->get_num_stored_elements());
+    for (size_type row = 0; row < num_rows; row++) {
+        for (auto nz = row_ptrs[row]; nz < row_ptrs[row + 1]; nz++) {
+            edges.emplace_back(static_cast<GlobalIndexType>(row),
+                               col_idxs[nz]);
+        }
+    }
+    return build_partition_from_edges<LocalIndexType>(
+        std::move(exec), num_rows, std::move(edges), num_parts, imbalance);
+}
+
+#define GKO_DECLARE_BUILD_PARTITION_FROM_CSR_GRAPH(_value, _local, _global) \
+    std::unique_ptr<Partition<_local, _global>>                             \
+    build_partition_from_graph<_local, _global, _value>(                    \
+        std::shared_ptr<const Executor> exec,                               \
+        const matrix::Csr<_value, _global>* graph,                          \
+        comm_index_type num_parts, double imbalance)
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_LOCAL_GLOBAL_INDEX_TYPE(
+    GKO_DECLARE_BUILD_PARTITION_FROM_CSR_GRAPH);
+
+
+template <typename LocalIndexType, typename GlobalIndexType,
+          typename ValueType>
+std::unique_ptr<Partition<LocalIndexType, GlobalIndexType>>
+build_partition_from_graph(
+    std::shared_ptr<const Executor> exec,
+    const device_matrix_data<ValueType, GlobalIndexType>& graph,
+    comm_index_type num_parts, double imbalance)
+{
+    GKO_ASSERT_EQ(graph.get_size()[0], graph.get_size()[1]);
+    const auto host_graph = graph.copy_to_host();
+    std::vector<std::pair<GlobalIndexType, GlobalIndexType>> edges;
+    edges.reserve(host_graph.nonzeros.size());
+    for (const auto& entry : host_graph.nonzeros) {
+        edges.emplace_back(entry.row, entry.column);
+    }
+    return build_partition_from_edges<LocalIndexType>(
+        std::move(exec), host_graph.size[0], std::move(edges), num_parts,
+        imbalance);
+}
+
+#define GKO_DECLARE_BUILD_PARTITION_FROM_DATA_GRAPH(_value, _local, _global) \
+    std::unique_ptr<Partition<_local, _global>>                              \
+    build_partition_from_graph<_local, _global, _value>(                     \
+        std::shared_ptr<const Executor> exec,                                \
+        const device_matrix_data<_value, _global>& graph,                    \
+        comm_index_type num_parts, double imbalance)
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_LOCAL_GLOBAL_INDEX_TYPE(
+    GKO_DECLARE_BUILD_PARTITION_FROM_DATA_GRAPH);
+
+
+}  // namespace distributed
+}  // namespace experimental
+}  // namespace gko
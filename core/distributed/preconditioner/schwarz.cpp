@@ -0,0 +1,319 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2022, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+
+#include <ginkgo/core/distributed/preconditioner/schwarz.hpp>
+
+
+#include <algorithm>
+#include <numeric>
+#include <unordered_map>
+#include <vector>
+
+
+#include <ginkgo/core/base/exception_helpers.hpp>
+#include <ginkgo/core/base/matrix_data.hpp>
+#include <ginkgo/core/base/precision_dispatch.hpp>
+#include <ginkgo/core/distributed/partition.hpp>
+#include <ginkgo/core/matrix/csr.hpp>
+#include <ginkgo/core/matrix/dense.hpp>
+
+
+#include "core/distributed/assembly.hpp"
+#include "core/distributed/helpers.hpp"
+
+
+namespace gko {
+namespace experimental {
+namespace distributed {
+namespace preconditioner {
+
+
+template <typename ValueType, typename LocalIndexType, typename GlobalIndexType>
+void Schwarz<ValueType, LocalIndexType, GlobalIndexType>::generate(
+    std::shared_ptr<const LinOp> system_matrix)
+{
+    if (!parameters_.local_solver) {
+        GKO_NOT_IMPLEMENTED;
+    }
+    auto dist_mtx = std::dynamic_pointer_cast<const matrix_type>(system_matrix);
+    if (!dist_mtx) {
+        GKO_NOT_SUPPORTED(system_matrix);
+    }
+    if (parameters_.overlap == 0) {
+        local_matrix_ = dist_mtx->get_local_matrix();
+    } else if (parameters_.overlap == 1) {
+        GKO_ASSERT_IS_SQUARE_MATRIX(dist_mtx);
+        system_matrix_ = dist_mtx;
+        local_matrix_ = this->build_overlapping_matrix(dist_mtx.get());
+    } else {
+        GKO_NOT_IMPLEMENTED;
+    }
+    local_solver_ = parameters_.local_solver->generate(local_matrix_);
+}
+
+
+template <typename ValueType, typename LocalIndexType, typename GlobalIndexType>
+std::unique_ptr<LinOp>
+Schwarz<ValueType, LocalIndexType, GlobalIndexType>::build_overlapping_matrix(
+    const matrix_type* mtx) const
+{
+    using csr_type = gko::matrix::Csr<ValueType, LocalIndexType>;
+    auto exec = this->get_executor();
+    auto host_exec = exec->get_master();
+    auto comm = mtx->get_communicator();
+    const auto rank = comm.rank();
+    const auto num_parts = comm.size();
+    // the gather indices refer to local columns, but they are used as local
+    // rows below, which requires matching row and column partitions
+    if (!mtx->get_row_partition() || !mtx->get_col_partition() ||
+        !::gko::detail::have_same_ranges(mtx->get_row_partition().get(),
+                                         mtx->get_col_partition().get())) {
+        GKO_NOT_SUPPORTED(mtx);
+    }
+    // the halo rows are exchanged on the host, since this only happens once
+    auto local = csr_type::create(host_exec);
+    auto non_local = csr_type::create(host_exec);
+    local->copy_from(mtx->get_local_matrix().get());
+    non_local->copy_from(mtx->get_non_local_matrix().get());
+    auto part = gko::clone(host_exec, mtx->get_col_partition());
+    const array<LocalIndexType> gather_idxs{host_exec, mtx->get_gather_idxs()};
+    const array<GlobalIndexType> non_local_to_global{
+        host_exec, mtx->get_non_local_to_global()};
+    GKO_ASSERT_EQ(static_cast<size_type>(part->get_part_size(rank)),
+                  local->get_size()[0]);
+    const auto num_rows = static_cast<LocalIndexType>(local->get_size()[0]);
+    const auto num_halo =
+        static_cast<LocalIndexType>(non_local_to_global.get_num_elems());
+
+    // build the mappings between owned local and global indices
+    const auto range_bounds = part->get_range_bounds();
+    const auto range_starts = part->get_range_starting_indices();
+    const auto part_ids = part->get_part_ids();
+    const auto num_ranges = part->get_num_ranges();
+    std::vector<GlobalIndexType> local_to_global(num_rows);
+    for (size_type range = 0; range < num_ranges; ++range) {
+        if (part_ids[range] == rank) {
+            std::iota(local_to_global.begin() + range_starts[range],
+                      local_to_global.begin() + range_starts[range] +
+                          (range_bounds[range + 1] - range_bounds[range]),
+                      range_bounds[range]);
+        }
+    }
+    std::unordered_map<GlobalIndexType, LocalIndexType> global_to_overlap;
+    for (LocalIndexType i = 0; i < num_rows; ++i) {
+        global_to_overlap[local_to_global[i]] = i;
+    }
+    for (LocalIndexType i = 0; i < num_halo; ++i) {
+        global_to_overlap[non_local_to_global.get_const_data()[i]] =
+            num_rows + i;
+    }
+
+    // exchange step 1: number of nonzeros for each requested row
+    const auto local_row_ptrs = local->get_const_row_ptrs();
+    const auto local_cols = local->get_const_col_idxs();
+    const auto local_vals = local->get_const_values();
+    const auto non_local_row_ptrs = non_local->get_const_row_ptrs();
+    const auto non_local_cols = non_local->get_const_col_idxs();
+    const auto non_local_vals = non_local->get_const_values();
+    const auto& send_sizes = mtx->get_send_sizes();
+    const auto& send_offsets = mtx->get_send_offsets();
+    const auto& recv_sizes = mtx->get_recv_sizes();
+    const auto& recv_offsets = mtx->get_recv_offsets();
+    const auto num_send_rows = send_offsets.back();
+    const auto num_recv_rows = recv_offsets.back();
+    GKO_ASSERT_EQ(num_recv_rows, num_halo);
+    std::vector<comm_index_type> send_row_nnz(num_send_rows);
+    for (comm_index_type i = 0; i < num_send_rows; ++i) {
+        const auto row = gather_idxs.get_const_data()[i];
+        send_row_nnz[i] = static_cast<comm_index_type>(
+            (local_row_ptrs[row + 1] - local_row_ptrs[row]) +
+            (non_local_row_ptrs[row + 1] - non_local_row_ptrs[row]));
+    }
+    std::vector<comm_index_type> recv_row_nnz(num_recv_rows);
+    comm.all_to_all_v(host_exec, send_row_nnz.data(), send_sizes.data(),
+                      send_offsets.data(), recv_row_nnz.data(),
+                      recv_sizes.data(), recv_offsets.data());
+
+    // exchange step 2: the column indices and values of the requested rows
+    std::vector<comm_index_type> send_nnz_sizes(num_parts);
+    std::vector<comm_index_type> send_nnz_offsets(num_parts + 1, 0);
+    std::vector<comm_index_type> recv_nnz_sizes(num_parts);
+    std::vector<comm_index_type> recv_nnz_offsets(num_parts + 1, 0);
+    for (comm_index_type p = 0; p < num_parts; ++p) {
+        send_nnz_sizes[p] =
+            std::accumulate(send_row_nnz.begin() + send_offsets[p],
+                            send_row_nnz.begin() + send_offsets[p + 1], 0);
+        recv_nnz_sizes[p] =
+            std::accumulate(recv_row_nnz.begin() + recv_offsets[p],
+                            recv_row_nnz.begin() + recv_offsets[p + 1], 0);
+    }
+    std::partial_sum(send_nnz_sizes.begin(), send_nnz_sizes.end(),
+                     send_nnz_offsets.begin() + 1);
+    std::partial_sum(recv_nnz_sizes.begin(), recv_nnz_sizes.end(),
+                     recv_nnz_offsets.begin() + 1);
+    std::vector<GlobalIndexType> send_cols;
+    std::vector<ValueType> send_vals;
+    send_cols.reserve(send_nnz_offsets.back());
+    send_vals.reserve(send_nnz_offsets.back());
+    for (comm_index_type i = 0; i < num_send_rows; ++i) {
+        const auto row = gather_idxs.get_const_data()[i];
+        for (auto nz = local_row_ptrs[row]; nz < local_row_ptrs[row + 1];
+             ++nz) {
+            send_cols.push_back(local_to_global[local_cols[nz]]);
+            send_vals.push_back(local_vals[nz]);
+        }
+        for (auto nz = non_local_row_ptrs[row];
+             nz < non_local_row_ptrs[row + 1]; ++nz) {
+            send_cols.push_back(
+                non_local_to_global.get_const_data()[non_local_cols[nz]]);
+            send_vals.push_back(non_local_vals[nz]);
+        }
+    }
+    std::vector<GlobalIndexType> recv_cols(recv_nnz_offsets.back());
+    std::vector<ValueType> recv_vals(recv_nnz_offsets.back());
+    comm.all_to_all_v(host_exec, send_cols.data(), send_nnz_sizes.data(),
+                      send_nnz_offsets.data(), recv_cols.data(),
+                      recv_nnz_sizes.data(), recv_nnz_offsets.data());
+    comm.all_to_all_v(host_exec, send_vals.data(), send_nnz_sizes.data(),
+                      send_nnz_offsets.data(), recv_vals.data(),
+                      recv_nnz_sizes.data(), recv_nnz_offsets.data());
+
+    // assemble the owned rows followed by the halo rows, restricted to the
+    // columns of the overlapping subdomain
+    const auto num_overlap_rows = static_cast<size_type>(num_rows + num_halo);
+    matrix_data<ValueType, LocalIndexType> data{
+        dim<2>{num_overlap_rows, num_overlap_rows}};
+    for (LocalIndexType row = 0; row < num_rows; ++row) {
+        for (auto nz = local_row_ptrs[row]; nz < local_row_ptrs[row + 1];
+             ++nz) {
+            data.nonzeros.emplace_back(row, local_cols[nz], local_vals[nz]);
+        }
+        for (auto nz = non_local_row_ptrs[row];
+             nz < non_local_row_ptrs[row + 1]; ++nz) {
+            data.nonzeros.emplace_back(row, num_rows + non_local_cols[nz],
+                                       non_local_vals[nz]);
+        }
+    }
+    size_type nz = 0;
+    for (LocalIndexType halo_row = 0; halo_row < num_halo; ++halo_row) {
+        for (comm_index_type i = 0; i < recv_row_nnz[halo_row]; ++i, ++nz) {
+            auto it = global_to_overlap.find(recv_cols[nz]);
+            if (it != global_to_overlap.end()) {
+                data.nonzeros.emplace_back(num_rows + halo_row, it->second,
+                                           recv_vals[nz]);
+            }
+        }
+    }
+    data.ensure_row_major_order();
+    auto result = mtx->get_local_matrix()->create_default(exec);
+    as<ReadableFromMatrixData<ValueType, LocalIndexType>>(result.get())
+        ->read(data);
+    return result;
+}
+
+
+template <typename ValueType, typename LocalIndexType, typename GlobalIndexType>
+template <typename VectorType>
+void Schwarz<ValueType, LocalIndexType, GlobalIndexType>::apply_dense_impl(
+    const VectorType* dense_b, VectorType* dense_x) const
+{
+    auto local_b = gko::detail::get_local(dense_b);
+    auto local_x = gko::detail::get_local(dense_x);
+    if (!system_matrix_) {
+        local_solver_->apply(local_b, local_x);
+        return;
+    }
+    auto exec = this->get_executor();
+    const auto num_rows = local_b->get_size()[0];
+    const auto num_cols = local_b->get_size()[1];
+    const auto num_overlap_rows = local_matrix_->get_size()[0];
+    const dim<2> overlap_dim{num_overlap_rows, num_cols};
+    overlap_b_.init(exec, overlap_dim);
+    overlap_x_.init(exec, overlap_dim);
+    const span owned{0, num_rows};
+    const span halo{num_rows, num_overlap_rows};
+    const span cols{0, num_cols};
+
+    auto req = system_matrix_->communicate(local_b);
+    overlap_b_->create_submatrix(owned, cols)->copy_from(local_b);
+    overlap_x_->create_submatrix(owned, cols)->copy_from(local_x);
+    req.wait();
+    if (num_overlap_rows > num_rows) {
+        system_matrix_->unpack_recv_buffer();
+        overlap_b_->create_submatrix(halo, cols)
+            ->copy_from(system_matrix_->get_recv_buffer());
+        overlap_x_->create_submatrix(halo, cols)->fill(zero<ValueType>());
+    }
+
+    local_solver_->apply(overlap_b_.get(), overlap_x_.get());
+    local_x->copy_from(overlap_x_->create_submatrix(owned, cols).get());
+}
+
+
+template <typename ValueType, typename LocalIndexType, typename GlobalIndexType>
+void Schwarz<ValueType, LocalIndexType, GlobalIndexType>::apply_impl(
+    const LinOp* b, LinOp* x) const
+{
+    precision_dispatch_real_complex_distributed<ValueType>(
+        [this](auto dense_b, auto dense_x) {
+            this->apply_dense_impl(dense_b, dense_x);
+        },
+        b, x);
+}
+
+
+template <typename ValueType, typename LocalIndexType, typename GlobalIndexType>
+void Schwarz<ValueType, LocalIndexType, GlobalIndexType>::apply_impl(
+    const LinOp* alpha, const LinOp* b, const LinOp* beta, LinOp* x) const
+{
+    precision_dispatch_real_complex_distributed<ValueType>(
+        [this](auto dense_alpha, auto dense_b, auto dense_beta, auto dense_x) {
+            auto x_clone = dense_x->clone();
+            this->apply_dense_impl(dense_b, x_clone.get());
+            dense_x->scale(dense_beta);
+            dense_x->add_scaled(dense_alpha, x_clone.get());
+        },
+        alpha, b, beta, x);
+}
+
+
+#define GKO_DECLARE_SCHWARZ(ValueType, LocalIndexType, GlobalIndexType) \
+    class Schwarz<ValueType, LocalIndexType, GlobalIndexType>
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_LOCAL_GLOBAL_INDEX_TYPE(
+    GKO_DECLARE_SCHWARZ);
+
+
+}  // namespace preconditioner
+}  // namespace distributed
+}  // namespace experimental
+}  // namespace gko
@@ -0,0 +1,195 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2022, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#include <ginkgo/core/distributed/reduction_batch.hpp>
+
+
+#include <ginkgo/core/base/exception_helpers.hpp>
+
+
+#include "core/matrix/dense_kernels.hpp"
+
+
+namespace gko {
+namespace experimental {
+namespace distributed {
+namespace reduction_batch {
+namespace {
+
+
+GKO_REGISTER_OPERATION(compute_sqrt, dense::compute_sqrt);
+
+
+}  // namespace
+}  // namespace reduction_batch
+
+
+template <typename ValueType>
+ReductionBatch<ValueType>::ReductionBatch(std::shared_ptr<const Executor> exec,
+                                          mpi::communicator comm)
+    : DistributedBase{comm},
+      exec_{std::move(exec)},
+      num_values_{},
+      pending_{false},
+      use_host_buffer_{exec_->get_master() != exec_ && !mpi::is_gpu_aware()},
+      tmp_{exec_}
+{}
+
+
+template <typename ValueType>
+void ReductionBatch<ValueType>::add_dot(const vector_type* a,
+                                        const vector_type* b, LinOp* result)
+{
+    GKO_ASSERT_EQUAL_DIMENSIONS(a, b);
+    GKO_ASSERT_EQUAL_DIMENSIONS(result, dim<2>(1, a->get_size()[1]));
+    as<dense_type>(result);
+    this->add_entry(reduction_kind::dot, a, b, result);
+}
+
+
+template <typename ValueType>
+void ReductionBatch<ValueType>::add_conj_dot(const vector_type* a,
+                                             const vector_type* b,
+                                             LinOp* result)
+{
+    GKO_ASSERT_EQUAL_DIMENSIONS(a, b);
+    GKO_ASSERT_EQUAL_DIMENSIONS(result, dim<2>(1, a->get_size()[1]));
+    as<dense_type>(result);
+    this->add_entry(reduction_kind::conj_dot, a, b, result);
+}
+
+
+template <typename ValueType>
+void ReductionBatch<ValueType>::add_norm2(const vector_type* a, LinOp* result)
+{
+    GKO_ASSERT_EQUAL_DIMENSIONS(result, dim<2>(1, a->get_size()[1]));
+    as<real_dense_type>(result);
+    this->add_entry(reduction_kind::norm2, a, a, result);
+}
+
+
+template <typename ValueType>
+void ReductionBatch<ValueType>::add_entry(reduction_kind kind,
+                                          const vector_type* a,
+                                          const vector_type* b, LinOp* result)
+{
+    GKO_ASSERT_EQ(pending_, false);
+    const auto num_cols = a->get_size()[1];
+    entries_.push_back({kind, a, b, result, num_values_, num_cols});
+    num_values_ += num_cols;
+}
+
+
+template <typename ValueType>
+void ReductionBatch<ValueType>::start()
+{
+    GKO_ASSERT_EQ(pending_, false);
+    pending_ = true;
+    if (num_values_ == 0) {
+        return;
+    }
+    buffer_.init(exec_, dim<2>{1, num_values_});
+    for (const auto& entry : entries_) {
+        auto view = buffer_->create_submatrix(
+            span{0, 1}, span{entry.offset, entry.offset + entry.num_cols});
+        auto local_a = entry.a->get_local_vector();
+        auto local_b = entry.b->get_local_vector();
+        if (entry.kind == reduction_kind::dot) {
+            local_a->compute_dot(local_b, view.get(), tmp_);
+        } else {
+            local_a->compute_conj_dot(local_b, view.get(), tmp_);
+        }
+    }
+    exec_->synchronize();
+    const auto comm = this->get_communicator();
+    const auto count = static_cast<int>(num_values_);
+    if (use_host_buffer_) {
+        host_buffer_.init(exec_->get_master(), buffer_->get_size());
+        host_buffer_->copy_from(buffer_.get());
+        request_ = comm.i_all_reduce(
+            exec_->get_master(), host_buffer_->get_values(), count, MPI_SUM);
+    } else {
+        request_ =
+            comm.i_all_reduce(exec_, buffer_->get_values(), count, MPI_SUM);
+    }
+}
+
+
+template <typename ValueType>
+void ReductionBatch<ValueType>::wait()
+{
+    GKO_ASSERT_EQ(pending_, true);
+    // without any values, start didn't set up the buffer, and the results of
+    // the entries (vectors without columns) are empty
+    if (num_values_ > 0) {
+        request_.wait();
+        if (use_host_buffer_) {
+            buffer_->copy_from(host_buffer_.get());
+        }
+        for (const auto& entry : entries_) {
+            auto view = buffer_->create_submatrix(
+                span{0, 1},
+                span{entry.offset, entry.offset + entry.num_cols});
+            if (entry.kind == reduction_kind::norm2) {
+                // the conjugate dot product of a vector with itself is real
+                // and non-negative, so its absolute value is the squared norm
+                auto norm = view->compute_absolute();
+                exec_->run(reduction_batch::make_compute_sqrt(norm.get()));
+                entry.result->copy_from(norm.get());
+            } else {
+                entry.result->copy_from(view.get());
+            }
+        }
+    }
+    entries_.clear();
+    num_values_ = 0;
+    pending_ = false;
+}
+
+
+template <typename ValueType>
+void ReductionBatch<ValueType>::reduce()
+{
+    this->start();
+    this->wait();
+}
+
+
+#define GKO_DECLARE_DISTRIBUTED_REDUCTION_BATCH(ValueType) \
+    class ReductionBatch<ValueType>
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_TYPE(GKO_DECLARE_DISTRIBUTED_REDUCTION_BATCH);
+
+
+}  // namespace distributed
+}  // namespace experimental
+}  // namespace gko
@@ -36,6 +36,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ginkgo/core/distributed/partition.hpp>
 
 
+#include "core/distributed/assembly.hpp"
 #include "core/distributed/vector_kernels.hpp"
 #include "core/matrix/dense_kernels.hpp"
 
@@ -158,6 +159,36 @@ void Vector<ValueType>::read_distributed(
 }
 
 
+template <typename ValueType>
+template <typename LocalIndexType, typename GlobalIndexType>
+void Vector<ValueType>::redistribute(
+    const Partition<LocalIndexType, GlobalIndexType>* old_partition,
+    const Partition<LocalIndexType, GlobalIndexType>* new_partition)
+{
+    GKO_ASSERT_EQ(old_partition->get_size(), this->get_size()[0]);
+    GKO_ASSERT_EQ(new_partition->get_size(), this->get_size()[0]);
+    const auto comm = this->get_communicator();
+    const auto row_map =
+        ::gko::detail::build_local_to_global(old_partition, comm.rank());
+    GKO_ASSERT_EQ(row_map.size(), local_.get_size()[0]);
+    auto host_local =
+        make_temporary_clone(this->get_executor()->get_master(), &local_);
+    const auto num_cols = this->get_size()[1];
+    matrix_data<ValueType, GlobalIndexType> data{this->get_size()};
+    data.nonzeros.reserve(row_map.size() * num_cols);
+    for (size_type row = 0; row < row_map.size(); row++) {
+        for (size_type col = 0; col < num_cols; col++) {
+            data.nonzeros.emplace_back(row_map[row],
+                                       static_cast<GlobalIndexType>(col),
+                                       host_local->at(row, col));
+        }
+    }
+    this->read_distributed(
+        ::gko::detail::communicate_to_owners(comm, data, new_partition),
+        new_partition);
+}
+
+
 template <typename ValueType>
 void Vector<ValueType>::fill(const ValueType value)
 {
@@ -532,7 +563,11 @@ GKO_INSTANTIATE_FOR_EACH_VALUE_TYPE(GKO_DECLARE_DISTRIBUTED_VECTOR);
     template void                                                              \
     Vector<ValueType>::read_distributed<LocalIndexType, GlobalIndexType>(      \
         const matrix_data<ValueType, GlobalIndexType>& data,                   \
-        const Partition<LocalIndexType, GlobalIndexType>* partition)
+        const Partition<LocalIndexType, GlobalIndexType>* partition);          \
+    template void                                                              \
+    Vector<ValueType>::redistribute<LocalIndexType, GlobalIndexType>(          \
+        const Partition<LocalIndexType, GlobalIndexType>* old_partition,       \
+        const Partition<LocalIndexType, GlobalIndexType>* new_partition)
 
 GKO_INSTANTIATE_FOR_EACH_VALUE_AND_LOCAL_GLOBAL_INDEX_TYPE(
     GKO_DECLARE_DISTRIBUTED_VECTOR_READ_DISTRIBUTED);
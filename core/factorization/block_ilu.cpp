@@ -0,0 +1,138 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2022, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#include <ginkgo/core/factorization/block_ilu.hpp>
+
+
+#include <memory>
+
+
+#include <ginkgo/core/base/array.hpp>
+#include <ginkgo/core/base/exception_helpers.hpp>
+
+
+#include "core/factorization/block_ilu_kernels.hpp"
+
+
+namespace gko {
+namespace factorization {
+namespace block_ilu_factorization {
+namespace {
+
+
+GKO_REGISTER_OPERATION(initialize_row_ptrs_l_u,
+                       block_ilu_factorization::initialize_row_ptrs_l_u);
+GKO_REGISTER_OPERATION(initialize_l_u, block_ilu_factorization::initialize_l_u);
+GKO_REGISTER_OPERATION(compute_lu, block_ilu_factorization::compute_lu);
+
+
+}  // anonymous namespace
+}  // namespace block_ilu_factorization
+
+
+template <typename ValueType, typename IndexType>
+std::unique_ptr<Composition<ValueType>>
+BlockIlu<ValueType, IndexType>::generate_l_u(
+    const std::shared_ptr<const LinOp>& system_matrix, bool skip_sorting) const
+{
+    GKO_ASSERT_IS_SQUARE_MATRIX(system_matrix);
+
+    const auto exec = this->get_executor();
+
+    // Converts the system matrix to FBCSR, keeping its block size if it
+    // already is one.
+    // Throws an exception if it is not convertible.
+    std::unique_ptr<matrix_type> local_system_matrix;
+    if (auto fbcsr = dynamic_cast<const matrix_type*>(system_matrix.get())) {
+        local_system_matrix = gko::clone(exec, fbcsr);
+    } else {
+        local_system_matrix = matrix_type::create(exec, parameters_.block_size);
+        as<ConvertibleTo<matrix_type>>(system_matrix.get())
+            ->convert_to(local_system_matrix.get());
+    }
+
+    // Fbcsr only supports sorting for the compiled block sizes, so avoid
+    // sorting if it is not necessary
+    if (!skip_sorting && !local_system_matrix->is_sorted_by_column_index()) {
+        local_system_matrix->sort_by_column_index();
+    }
+
+    // Separate L and U factors: nnz
+    const auto matrix_size = local_system_matrix->get_size();
+    const auto block_size = local_system_matrix->get_block_size();
+    const auto num_block_rows =
+        static_cast<size_type>(local_system_matrix->get_num_block_rows());
+    array<IndexType> l_row_ptrs{exec, num_block_rows + 1};
+    array<IndexType> u_row_ptrs{exec, num_block_rows + 1};
+    exec->run(block_ilu_factorization::make_initialize_row_ptrs_l_u(
+        local_system_matrix.get(), l_row_ptrs.get_data(),
+        u_row_ptrs.get_data()));
+
+    // Get number of blocks from device memory
+    auto l_nnz = static_cast<size_type>(
+        exec->copy_val_to_host(l_row_ptrs.get_data() + num_block_rows));
+    auto u_nnz = static_cast<size_type>(
+        exec->copy_val_to_host(u_row_ptrs.get_data() + num_block_rows));
+
+    // Init arrays
+    const auto block_nnz = static_cast<size_type>(block_size * block_size);
+    array<IndexType> l_col_idxs{exec, l_nnz};
+    array<ValueType> l_vals{exec, l_nnz * block_nnz};
+    std::shared_ptr<matrix_type> l_factor = matrix_type::create(
+        exec, matrix_size, block_size, std::move(l_vals), std::move(l_col_idxs),
+        std::move(l_row_ptrs));
+    array<IndexType> u_col_idxs{exec, u_nnz};
+    array<ValueType> u_vals{exec, u_nnz * block_nnz};
+    std::shared_ptr<matrix_type> u_factor = matrix_type::create(
+        exec, matrix_size, block_size, std::move(u_vals), std::move(u_col_idxs),
+        std::move(u_row_ptrs));
+
+    // Separate L and U: columns and values
+    exec->run(block_ilu_factorization::make_initialize_l_u(
+        local_system_matrix.get(), l_factor.get(), u_factor.get()));
+
+    // Compute the block LU factorization in-place on L and U
+    exec->run(block_ilu_factorization::make_compute_lu(l_factor.get(),
+                                                       u_factor.get()));
+
+    return Composition<ValueType>::create(std::move(l_factor),
+                                          std::move(u_factor));
+}
+
+
+#define GKO_DECLARE_BLOCK_ILU(ValueType, IndexType) \
+    class BlockIlu<ValueType, IndexType>
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(GKO_DECLARE_BLOCK_ILU);
+
+
+}  // namespace factorization
+}  // namespace gko
@@ -0,0 +1,307 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2022, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#include <ginkgo/core/matrix/block_ell.hpp>
+
+
+#include <limits>
+#include <utility>
+#include <vector>
+
+
+#include <ginkgo/core/base/exception_helpers.hpp>
+#include <ginkgo/core/base/executor.hpp>
+#include <ginkgo/core/base/precision_dispatch.hpp>
+#include <ginkgo/core/base/temporary_clone.hpp>
+#include <ginkgo/core/base/utils.hpp>
+#include <ginkgo/core/matrix/csr.hpp>
+#include <ginkgo/core/matrix/dense.hpp>
+
+
+#include "core/components/prefix_sum_kernels.hpp"
+#include "core/matrix/block_ell_kernels.hpp"
+
+
+namespace gko {
+namespace matrix {
+namespace block_ell {
+namespace {
+
+
+GKO_REGISTER_OPERATION(spmv, block_ell::spmv);
+GKO_REGISTER_OPERATION(advanced_spmv, block_ell::advanced_spmv);
+GKO_REGISTER_OPERATION(count_nonzeros_per_row,
+                       block_ell::count_nonzeros_per_row);
+GKO_REGISTER_OPERATION(convert_to_csr, block_ell::convert_to_csr);
+GKO_REGISTER_OPERATION(prefix_sum, components::prefix_sum);
+
+
+}  // anonymous namespace
+}  // namespace block_ell
+
+
+template <typename ValueType, typename IndexType>
+BlockEll<ValueType, IndexType>::BlockEll(std::shared_ptr<const Executor> exec,
+                                         int block_size, const dim<2>& size,
+                                         size_type num_stored_blocks_per_row)
+    : EnableLinOp<BlockEll>(exec),
+      block_size_{},
+      num_stored_blocks_per_row_{},
+      values_{exec},
+      col_idxs_{exec}
+{
+    this->resize(block_size, size, num_stored_blocks_per_row);
+}
+
+
+template <typename ValueType, typename IndexType>
+void BlockEll<ValueType, IndexType>::resize(int block_size, const dim<2>& size,
+                                            size_type num_stored_blocks_per_row)
+{
+    if (block_size > 0) {
+        GKO_ASSERT_BLOCK_SIZE_CONFORMANT(size[0], block_size);
+        GKO_ASSERT_BLOCK_SIZE_CONFORMANT(size[1], block_size);
+    } else {
+        // without a block size, the matrix can only be empty
+        GKO_ASSERT_EQ(size[0], 0);
+        GKO_ASSERT_EQ(size[1], 0);
+    }
+    block_size_ = block_size;
+    num_stored_blocks_per_row_ = num_stored_blocks_per_row;
+    this->set_size(size);
+    const auto num_blocks =
+        this->get_num_block_rows() * num_stored_blocks_per_row;
+    col_idxs_.resize_and_reset(num_blocks);
+    values_.resize_and_reset(num_blocks * block_size * block_size);
+}
+
+
+template <typename ValueType, typename IndexType>
+BlockEll<ValueType, IndexType>& BlockEll<ValueType, IndexType>::operator=(
+    const BlockEll& other)
+{
+    if (&other != this) {
+        EnableLinOp<BlockEll>::operator=(other);
+        block_size_ = other.block_size_;
+        num_stored_blocks_per_row_ = other.num_stored_blocks_per_row_;
+        values_ = other.values_;
+        col_idxs_ = other.col_idxs_;
+    }
+    return *this;
+}
+
+
+template <typename ValueType, typename IndexType>
+BlockEll<ValueType, IndexType>& BlockEll<ValueType, IndexType>::operator=(
+    BlockEll&& other)
+{
+    if (&other != this) {
+        EnableLinOp<BlockEll>::operator=(std::move(other));
+        block_size_ = std::exchange(other.block_size_, 0);
+        num_stored_blocks_per_row_ =
+            std::exchange(other.num_stored_blocks_per_row_, 0);
+        values_ = std::move(other.values_);
+        col_idxs_ = std::move(other.col_idxs_);
+    }
+    return *this;
+}
+
+
+template <typename ValueType, typename IndexType>
+BlockEll<ValueType, IndexType>::BlockEll(const BlockEll& other)
+    : BlockEll(other.get_executor())
+{
+    *this = other;
+}
+
+
+template <typename ValueType, typename IndexType>
+BlockEll<ValueType, IndexType>::BlockEll(BlockEll&& other)
+    : BlockEll(other.get_executor())
+{
+    *this = std::move(other);
+}
+
+
+template <typename ValueType, typename IndexType>
+int BlockEll<ValueType, IndexType>::detect_block_size(
+    const Csr<ValueType, IndexType>* mtx, int max_block_size)
+{
+    auto host_mtx =
+        make_temporary_clone(mtx->get_executor()->get_master(), mtx);
+    const auto row_ptrs = host_mtx->get_const_row_ptrs();
+    const auto col_idxs = host_mtx->get_const_col_idxs();
+    const auto num_rows = static_cast<int64>(mtx->get_size()[0]);
+    const auto num_cols = static_cast<int64>(mtx->get_size()[1]);
+    int best_block_size = 1;
+    auto best_storage = std::numeric_limits<double>::infinity();
+    // last_block_row[bcol] is the last block row containing block column bcol
+    std::vector<int64> last_block_row;
+    for (int block_size = 1; block_size <= max_block_size; block_size++) {
+        if (num_rows % block_size != 0 || num_cols % block_size != 0) {
+            continue;
+        }
+        last_block_row.assign(num_cols / block_size, -1);
+        int64 num_blocks{};
+        for (int64 row = 0; row < num_rows; row++) {
+            const auto block_row = row / block_size;
+            for (auto nz = row_ptrs[row]; nz < row_ptrs[row + 1]; nz++) {
+                const auto block_col = col_idxs[nz] / block_size;
+                if (last_block_row[block_col] != block_row) {
+                    last_block_row[block_col] = block_row;
+                    num_blocks++;
+                }
+            }
+        }
+        const auto storage =
+            static_cast<double>(num_blocks) *
+            (block_size * block_size * sizeof(ValueType) + sizeof(IndexType));
+        if (storage < best_storage) {
+            best_storage = storage;
+            best_block_size = block_size;
+        }
+    }
+    return best_block_size;
+}
+
+
+template <typename ValueType, typename IndexType>
+void BlockEll<ValueType, IndexType>::apply_impl(const LinOp* b, LinOp* x) const
+{
+    precision_dispatch_real_complex<ValueType>(
+        [this](auto dense_b, auto dense_x) {
+            this->get_executor()->run(
+                block_ell::make_spmv(this, dense_b, dense_x));
+        },
+        b, x);
+}
+
+
+template <typename ValueType, typename IndexType>
+void BlockEll<ValueType, IndexType>::apply_impl(const LinOp* alpha,
+                                                const LinOp* b,
+                                                const LinOp* beta,
+                                                LinOp* x) const
+{
+    precision_dispatch_real_complex<ValueType>(
+        [this](auto dense_alpha, auto dense_b, auto dense_beta, auto dense_x) {
+            this->get_executor()->run(block_ell::make_advanced_spmv(
+                dense_alpha, this, dense_b, dense_beta, dense_x));
+        },
+        alpha, b, beta, x);
+}
+
+
+template <typename ValueType, typename IndexType>
+void BlockEll<ValueType, IndexType>::convert_to(
+    Csr<ValueType, IndexType>* result) const
+{
+    auto exec = this->get_executor();
+    const auto num_rows = this->get_size()[0];
+    array<index_type> row_ptrs{exec, num_rows + 1};
+    exec->run(
+        block_ell::make_count_nonzeros_per_row(this, row_ptrs.get_data()));
+    exec->run(block_ell::make_prefix_sum(row_ptrs.get_data(), num_rows + 1));
+    const auto nnz = static_cast<size_type>(
+        exec->copy_val_to_host(row_ptrs.get_const_data() + num_rows));
+    auto tmp = Csr<ValueType, IndexType>::create(
+        exec, this->get_size(), array<value_type>{exec, nnz},
+        array<index_type>{exec, nnz}, std::move(row_ptrs),
+        result->get_strategy());
+    exec->run(block_ell::make_convert_to_csr(this, tmp.get()));
+    tmp->move_to(result);
+}
+
+
+template <typename ValueType, typename IndexType>
+void BlockEll<ValueType, IndexType>::move_to(Csr<ValueType, IndexType>* result)
+{
+    this->convert_to(result);
+}
+
+
+template <typename ValueType, typename IndexType>
+void BlockEll<ValueType, IndexType>::convert_to(Dense<ValueType>* result) const
+{
+    auto tmp = Csr<ValueType, IndexType>::create(this->get_executor());
+    this->convert_to(tmp.get());
+    tmp->convert_to(result);
+}
+
+
+template <typename ValueType, typename IndexType>
+void BlockEll<ValueType, IndexType>::move_to(Dense<ValueType>* result)
+{
+    this->convert_to(result);
+}
+
+
+template <typename ValueType, typename IndexType>
+void BlockEll<ValueType, IndexType>::read(const device_mat_data& data)
+{
+    auto tmp = Csr<ValueType, IndexType>::create(this->get_executor());
+    tmp->read(data);
+    tmp->convert_to(this);
+}
+
+
+template <typename ValueType, typename IndexType>
+void BlockEll<ValueType, IndexType>::read(device_mat_data&& data)
+{
+    this->read(data);
+    data.empty_out();
+}
+
+
+template <typename ValueType, typename IndexType>
+void BlockEll<ValueType, IndexType>::read(const mat_data& data)
+{
+    this->read(device_mat_data::create_from_host(this->get_executor(), data));
+}
+
+
+template <typename ValueType, typename IndexType>
+void BlockEll<ValueType, IndexType>::write(mat_data& data) const
+{
+    auto tmp = Csr<ValueType, IndexType>::create(this->get_executor());
+    this->convert_to(tmp.get());
+    tmp->write(data);
+}
+
+
+#define GKO_DECLARE_BLOCK_ELL_MATRIX(ValueType, IndexType) \
+    class BlockEll<ValueType, IndexType>
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(GKO_DECLARE_BLOCK_ELL_MATRIX);
+
+
+}  // namespace matrix
+}  // namespace gko
@@ -0,0 +1,227 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2022, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#include <ginkgo/core/matrix/compressed_csr.hpp>
+
+
+#include <ginkgo/core/base/exception_helpers.hpp>
+#include <ginkgo/core/base/executor.hpp>
+#include <ginkgo/core/base/precision_dispatch.hpp>
+#include <ginkgo/core/base/utils.hpp>
+#include <ginkgo/core/matrix/csr.hpp>
+#include <ginkgo/core/matrix/dense.hpp>
+
+
+#include "core/matrix/compressed_csr_kernels.hpp"
+
+
+namespace gko {
+namespace matrix {
+namespace compressed_csr {
+namespace {
+
+
+GKO_REGISTER_OPERATION(spmv, compressed_csr::spmv);
+GKO_REGISTER_OPERATION(advanced_spmv, compressed_csr::advanced_spmv);
+GKO_REGISTER_OPERATION(decompress_to_csr, compressed_csr::decompress_to_csr);
+
+
+}  // anonymous namespace
+}  // namespace compressed_csr
+
+
+template <typename ValueType, typename IndexType>
+CompressedCsr<ValueType, IndexType>&
+CompressedCsr<ValueType, IndexType>::operator=(const CompressedCsr& other)
+{
+    if (&other != this) {
+        EnableLinOp<CompressedCsr>::operator=(other);
+        values_ = other.values_;
+        row_ptrs_ = other.row_ptrs_;
+        col_bases_ = other.col_bases_;
+        col_widths_ = other.col_widths_;
+        col_offsets_ = other.col_offsets_;
+        col_deltas_ = other.col_deltas_;
+    }
+    return *this;
+}
+
+
+template <typename ValueType, typename IndexType>
+CompressedCsr<ValueType, IndexType>&
+CompressedCsr<ValueType, IndexType>::operator=(CompressedCsr&& other)
+{
+    if (&other != this) {
+        EnableLinOp<CompressedCsr>::operator=(std::move(other));
+        values_ = std::move(other.values_);
+        row_ptrs_ = std::move(other.row_ptrs_);
+        col_bases_ = std::move(other.col_bases_);
+        col_widths_ = std::move(other.col_widths_);
+        col_offsets_ = std::move(other.col_offsets_);
+        col_deltas_ = std::move(other.col_deltas_);
+        // restore other invariant
+        other.row_ptrs_.resize_and_reset(1);
+        other.row_ptrs_.fill(0);
+        other.col_offsets_.resize_and_reset(1);
+        other.col_offsets_.fill(0);
+    }
+    return *this;
+}
+
+
+template <typename ValueType, typename IndexType>
+CompressedCsr<ValueType, IndexType>::CompressedCsr(const CompressedCsr& other)
+    : CompressedCsr(other.get_executor())
+{
+    *this = other;
+}
+
+
+template <typename ValueType, typename IndexType>
+CompressedCsr<ValueType, IndexType>::CompressedCsr(CompressedCsr&& other)
+    : CompressedCsr(other.get_executor())
+{
+    *this = std::move(other);
+}
+
+
+template <typename ValueType, typename IndexType>
+void CompressedCsr<ValueType, IndexType>::apply_impl(const LinOp* b,
+                                                    LinOp* x) const
+{
+    precision_dispatch_real_complex<ValueType>(
+        [this](auto dense_b, auto dense_x) {
+            this->get_executor()->run(
+                compressed_csr::make_spmv(this, dense_b, dense_x));
+        },
+        b, x);
+}
+
+
+template <typename ValueType, typename IndexType>
+void CompressedCsr<ValueType, IndexType>::apply_impl(const LinOp* alpha,
+                                                    const LinOp* b,
+                                                    const LinOp* beta,
+                                                    LinOp* x) const
+{
+    precision_dispatch_real_complex<ValueType>(
+        [this](auto dense_alpha, auto dense_b, auto dense_beta, auto dense_x) {
+            this->get_executor()->run(compressed_csr::make_advanced_spmv(
+                dense_alpha, this, dense_b, dense_beta, dense_x));
+        },
+        alpha, b, beta, x);
+}
+
+
+template <typename ValueType, typename IndexType>
+void CompressedCsr<ValueType, IndexType>::convert_to(
+    Csr<ValueType, IndexType>* result) const
+{
+    auto exec = this->get_executor();
+    {
+        auto tmp = make_temporary_clone(exec, result);
+        tmp->row_ptrs_.resize_and_reset(this->get_size()[0] + 1);
+        tmp->col_idxs_.resize_and_reset(this->get_num_stored_elements());
+        tmp->values_.resize_and_reset(this->get_num_stored_elements());
+        tmp->set_size(this->get_size());
+        exec->run(compressed_csr::make_decompress_to_csr(this, tmp.get()));
+    }
+    result->make_srow();
+}
+
+
+template <typename ValueType, typename IndexType>
+void CompressedCsr<ValueType, IndexType>::move_to(
+    Csr<ValueType, IndexType>* result)
+{
+    this->convert_to(result);
+}
+
+
+template <typename ValueType, typename IndexType>
+void CompressedCsr<ValueType, IndexType>::convert_to(
+    Dense<ValueType>* result) const
+{
+    auto tmp = Csr<ValueType, IndexType>::create(this->get_executor());
+    this->convert_to(tmp.get());
+    tmp->convert_to(result);
+}
+
+
+template <typename ValueType, typename IndexType>
+void CompressedCsr<ValueType, IndexType>::move_to(Dense<ValueType>* result)
+{
+    this->convert_to(result);
+}
+
+
+template <typename ValueType, typename IndexType>
+void CompressedCsr<ValueType, IndexType>::read(const device_mat_data& data)
+{
+    auto tmp = Csr<ValueType, IndexType>::create(this->get_executor());
+    tmp->read(data);
+    tmp->convert_to(this);
+}
+
+
+template <typename ValueType, typename IndexType>
+void CompressedCsr<ValueType, IndexType>::read(device_mat_data&& data)
+{
+    this->read(data);
+    data.empty_out();
+}
+
+
+template <typename ValueType, typename IndexType>
+void CompressedCsr<ValueType, IndexType>::read(const mat_data& data)
+{
+    this->read(device_mat_data::create_from_host(this->get_executor(), data));
+}
+
+
+template <typename ValueType, typename IndexType>
+void CompressedCsr<ValueType, IndexType>::write(mat_data& data) const
+{
+    auto tmp = Csr<ValueType, IndexType>::create(this->get_executor());
+    this->convert_to(tmp.get());
+    tmp->write(data);
+}
+
+
+#define GKO_DECLARE_COMPRESSED_CSR_MATRIX(ValueType, IndexType) \
+    class CompressedCsr<ValueType, IndexType>
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(
+    GKO_DECLARE_COMPRESSED_CSR_MATRIX);
+
+
+}  // namespace matrix
+}  // namespace gko
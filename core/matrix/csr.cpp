@@ -33,6 +33,10 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ginkgo/core/matrix/csr.hpp>
 
 
+#include <algorithm>
+#include <numeric>
+
+
 #include <ginkgo/core/base/array.hpp>
 #include <ginkgo/core/base/exception_helpers.hpp>
 #include <ginkgo/core/base/executor.hpp>
@@ -40,6 +44,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ginkgo/core/base/math.hpp>
 #include <ginkgo/core/base/precision_dispatch.hpp>
 #include <ginkgo/core/base/utils.hpp>
+#include <ginkgo/core/matrix/block_ell.hpp>
+#include <ginkgo/core/matrix/compressed_csr.hpp>
 #include <ginkgo/core/matrix/coo.hpp>
 #include <ginkgo/core/matrix/dense.hpp>
 #include <ginkgo/core/matrix/ell.hpp>
@@ -47,6 +53,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ginkgo/core/matrix/identity.hpp>
 #include <ginkgo/core/matrix/sellp.hpp>
 #include <ginkgo/core/matrix/sparsity_csr.hpp>
+#include <ginkgo/core/matrix/symmetric_csr.hpp>
 
 
 #include "core/base/device_matrix_data_kernels.hpp"
@@ -54,10 +61,13 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "core/components/fill_array_kernels.hpp"
 #include "core/components/format_conversion_kernels.hpp"
 #include "core/components/prefix_sum_kernels.hpp"
+#include "core/matrix/block_ell_kernels.hpp"
+#include "core/matrix/compressed_csr_kernels.hpp"
 #include "core/matrix/csr_kernels.hpp"
 #include "core/matrix/ell_kernels.hpp"
 #include "core/matrix/hybrid_kernels.hpp"
 #include "core/matrix/sellp_kernels.hpp"
+#include "core/matrix/symmetric_csr_kernels.hpp"
 
 
 namespace gko {
@@ -68,14 +78,25 @@ namespace {
 
 GKO_REGISTER_OPERATION(spmv, csr::spmv);
 GKO_REGISTER_OPERATION(advanced_spmv, csr::advanced_spmv);
+GKO_REGISTER_OPERATION(mixed_spmv, csr::mixed_spmv);
+GKO_REGISTER_OPERATION(advanced_mixed_spmv, csr::advanced_mixed_spmv);
 GKO_REGISTER_OPERATION(spgemm, csr::spgemm);
 GKO_REGISTER_OPERATION(advanced_spgemm, csr::advanced_spgemm);
+GKO_REGISTER_OPERATION(masked_spgemm, csr::masked_spgemm);
 GKO_REGISTER_OPERATION(spgeam, csr::spgeam);
 GKO_REGISTER_OPERATION(convert_idxs_to_ptrs, components::convert_idxs_to_ptrs);
 GKO_REGISTER_OPERATION(convert_ptrs_to_idxs, components::convert_ptrs_to_idxs);
 GKO_REGISTER_OPERATION(fill_in_dense, csr::fill_in_dense);
 GKO_REGISTER_OPERATION(compute_slice_sets, sellp::compute_slice_sets);
 GKO_REGISTER_OPERATION(convert_to_sellp, csr::convert_to_sellp);
+GKO_REGISTER_OPERATION(count_upper_nonzeros_per_row,
+                       symmetric_csr::count_upper_nonzeros_per_row);
+GKO_REGISTER_OPERATION(extract_upper, symmetric_csr::extract_upper);
+GKO_REGISTER_OPERATION(count_row_words, compressed_csr::count_row_words);
+GKO_REGISTER_OPERATION(compress_from_csr, compressed_csr::compress_from_csr);
+GKO_REGISTER_OPERATION(compute_max_blocks_per_row,
+                       block_ell::compute_max_blocks_per_row);
+GKO_REGISTER_OPERATION(fill_in_block_ell, block_ell::fill_in_from_csr);
 GKO_REGISTER_OPERATION(compute_max_row_nnz, ell::compute_max_row_nnz);
 GKO_REGISTER_OPERATION(convert_to_ell, csr::convert_to_ell);
 GKO_REGISTER_OPERATION(convert_to_fbcsr, csr::convert_to_fbcsr);
@@ -115,6 +136,78 @@ GKO_REGISTER_OPERATION(check_diagonal_entries,
                        csr::check_diagonal_entries_exist);
 
 
+template <typename ValueType, typename IndexType>
+void run_spmv(const Csr<ValueType, IndexType>* a, const Dense<ValueType>* b,
+              Dense<ValueType>* x)
+{
+    a->get_executor()->run(make_spmv(a, b, x));
+}
+
+
+// vectors in a different precision than the matrix: the values are read in
+// the matrix precision, but the products are accumulated in the highest
+// precision involved
+template <typename InputValueType, typename MatrixValueType,
+          typename OutputValueType, typename IndexType>
+void run_spmv(const Csr<MatrixValueType, IndexType>* a,
+              const Dense<InputValueType>* b, Dense<OutputValueType>* x)
+{
+    a->get_executor()->run(make_mixed_spmv(a, b, x));
+}
+
+
+template <typename ValueType, typename IndexType>
+void run_advanced_spmv(const Dense<ValueType>* alpha,
+                       const Csr<ValueType, IndexType>* a,
+                       const Dense<ValueType>* b, const Dense<ValueType>* beta,
+                       Dense<ValueType>* x)
+{
+    a->get_executor()->run(make_advanced_spmv(alpha, a, b, beta, x));
+}
+
+
+template <typename InputValueType, typename MatrixValueType,
+          typename OutputValueType, typename IndexType>
+void run_advanced_spmv(const Dense<MatrixValueType>* alpha,
+                       const Csr<MatrixValueType, IndexType>* a,
+                       const Dense<InputValueType>* b,
+                       const Dense<OutputValueType>* beta,
+                       Dense<OutputValueType>* x)
+{
+    a->get_executor()->run(make_advanced_mixed_spmv(alpha, a, b, beta, x));
+}
+
+
+/**
+ * Computes the row permutation of SELL-C-sigma: within each window of
+ * sorting_window consecutive rows, the rows are stably sorted by decreasing
+ * number of nonzeros. This is only done once per conversion, so it runs on the
+ * host.
+ */
+template <typename IndexType>
+array<IndexType> compute_sellp_permutation(const array<IndexType>& row_ptrs,
+                                           size_type num_rows,
+                                           size_type sorting_window)
+{
+    const auto exec = row_ptrs.get_executor();
+    const array<IndexType> host_row_ptrs{exec->get_master(), row_ptrs};
+    const auto ptrs = host_row_ptrs.get_const_data();
+    array<IndexType> permutation{exec->get_master(), num_rows};
+    const auto perm = permutation.get_data();
+    std::iota(perm, perm + num_rows, IndexType{});
+    for (size_type begin = 0; begin < num_rows; begin += sorting_window) {
+        const auto end = std::min(begin + sorting_window, num_rows);
+        std::stable_sort(perm + begin, perm + end,
+                         [ptrs](IndexType a, IndexType b) {
+                             const auto a_nnz = ptrs[a + 1] - ptrs[a];
+                             const auto b_nnz = ptrs[b + 1] - ptrs[b];
+                             return a_nnz > b_nnz;
+                         });
+    }
+    return array<IndexType>{exec, std::move(permutation)};
+}
+
+
 }  // anonymous namespace
 }  // namespace csr
 
@@ -190,10 +283,9 @@ void Csr<ValueType, IndexType>::apply_impl(const LinOp* b, LinOp* x) const
         auto x_csr = as<TCsr>(x);
         this->get_executor()->run(csr::make_spgemm(this, b_csr, x_csr));
     } else {
-        precision_dispatch_real_complex<ValueType>(
+        mixed_precision_dispatch_real_complex<ValueType>(
             [this](auto dense_b, auto dense_x) {
-                this->get_executor()->run(
-                    csr::make_spmv(this, dense_b, dense_x));
+                csr::run_spmv(this, dense_b, dense_x);
             },
             b, x);
     }
@@ -222,13 +314,16 @@ void Csr<ValueType, IndexType>::apply_impl(const LinOp* alpha, const LinOp* b,
             csr::make_spgeam(as<Dense<ValueType>>(alpha), this,
                              as<Dense<ValueType>>(beta), lend(x_copy), x_csr));
     } else {
-        precision_dispatch_real_complex<ValueType>(
-            [this](auto dense_alpha, auto dense_b, auto dense_beta,
-                   auto dense_x) {
-                this->get_executor()->run(csr::make_advanced_spmv(
-                    dense_alpha, this, dense_b, dense_beta, dense_x));
+        mixed_precision_dispatch_real_complex<ValueType>(
+            [this, alpha, beta](auto dense_b, auto dense_x) {
+                auto dense_alpha = make_temporary_conversion<ValueType>(alpha);
+                auto dense_beta = make_temporary_conversion<
+                    typename std::decay_t<decltype(*dense_x)>::value_type>(
+                    beta);
+                csr::run_advanced_spmv(dense_alpha.get(), this, dense_b,
+                                       dense_beta.get(), dense_x);
             },
-            alpha, b, beta, x);
+            b, x);
     }
 }
 
@@ -335,22 +430,36 @@ void Csr<ValueType, IndexType>::convert_to(
     auto exec = this->get_executor();
     const auto stride_factor = result->get_stride_factor();
     const auto slice_size = result->get_slice_size();
+    const auto sorting_window = result->get_sorting_window();
     const auto num_rows = this->get_size()[0];
     const auto num_slices = ceildiv(num_rows, slice_size);
     auto tmp = make_temporary_clone(exec, result);
-    tmp->slice_sets_.resize_and_reset(num_slices + 1);
-    tmp->slice_lengths_.resize_and_reset(num_slices);
-    tmp->stride_factor_ = stride_factor;
-    tmp->slice_size_ = slice_size;
-    exec->run(csr::make_compute_slice_sets(this->row_ptrs_, slice_size,
-                                           stride_factor, tmp->get_slice_sets(),
-                                           tmp->get_slice_lengths()));
-    auto total_cols =
-        exec->copy_val_to_host(tmp->get_slice_sets() + num_slices);
-    tmp->col_idxs_.resize_and_reset(total_cols * slice_size);
-    tmp->values_.resize_and_reset(total_cols * slice_size);
-    tmp->set_size(this->get_size());
-    exec->run(csr::make_convert_to_sellp(this, tmp.get()));
+    // fills the slices with the rows of source in their given order
+    auto convert = [&](const Csr* source) {
+        tmp->slice_sets_.resize_and_reset(num_slices + 1);
+        tmp->slice_lengths_.resize_and_reset(num_slices);
+        tmp->stride_factor_ = stride_factor;
+        tmp->slice_size_ = slice_size;
+        exec->run(csr::make_compute_slice_sets(
+            source->row_ptrs_, slice_size, stride_factor,
+            tmp->get_slice_sets(), tmp->get_slice_lengths()));
+        auto total_cols =
+            exec->copy_val_to_host(tmp->get_slice_sets() + num_slices);
+        tmp->col_idxs_.resize_and_reset(total_cols * slice_size);
+        tmp->values_.resize_and_reset(total_cols * slice_size);
+        tmp->set_size(this->get_size());
+        exec->run(csr::make_convert_to_sellp(source, tmp.get()));
+    };
+    if (sorting_window > 1) {
+        auto permutation = csr::compute_sellp_permutation(
+            this->row_ptrs_, num_rows, sorting_window);
+        auto sorted = as<Csr>(this->row_permute(&permutation));
+        convert(sorted.get());
+        tmp->permutation_ = std::move(permutation);
+    } else {
+        convert(this);
+        tmp->permutation_.clear();
+    }
 }
 
 
@@ -434,6 +543,93 @@ void Csr<ValueType, IndexType>::move_to(Fbcsr<ValueType, IndexType>* result)
 }
 
 
+template <typename ValueType, typename IndexType>
+void Csr<ValueType, IndexType>::convert_to(
+    SymmetricCsr<ValueType, IndexType>* result) const
+{
+    GKO_ASSERT_IS_SQUARE_MATRIX(this);
+    auto exec = this->get_executor();
+    const auto num_rows = this->get_size()[0];
+    auto tmp = make_temporary_clone(exec, result);
+    tmp->row_ptrs_.resize_and_reset(num_rows + 1);
+    exec->run(
+        csr::make_count_upper_nonzeros_per_row(this, tmp->get_row_ptrs()));
+    exec->run(csr::make_prefix_sum(tmp->get_row_ptrs(), num_rows + 1));
+    const auto nnz = static_cast<size_type>(
+        exec->copy_val_to_host(tmp->get_const_row_ptrs() + num_rows));
+    tmp->col_idxs_.resize_and_reset(nnz);
+    tmp->values_.resize_and_reset(nnz);
+    tmp->set_size(this->get_size());
+    exec->run(csr::make_extract_upper(this, tmp.get()));
+}
+
+
+template <typename ValueType, typename IndexType>
+void Csr<ValueType, IndexType>::move_to(
+    SymmetricCsr<ValueType, IndexType>* result)
+{
+    this->convert_to(result);
+}
+
+
+template <typename ValueType, typename IndexType>
+void Csr<ValueType, IndexType>::convert_to(
+    CompressedCsr<ValueType, IndexType>* result) const
+{
+    auto exec = this->get_executor();
+    const auto num_rows = this->get_size()[0];
+    auto tmp = make_temporary_clone(exec, result);
+    tmp->row_ptrs_.resize_and_reset(num_rows + 1);
+    tmp->values_.resize_and_reset(this->get_num_stored_elements());
+    tmp->col_bases_.resize_and_reset(num_rows);
+    tmp->col_widths_.resize_and_reset(num_rows);
+    tmp->col_offsets_.resize_and_reset(num_rows + 1);
+    exec->run(csr::make_count_row_words(this, tmp->get_col_widths(),
+                                        tmp->get_col_offsets()));
+    exec->run(csr::make_prefix_sum(tmp->get_col_offsets(), num_rows + 1));
+    const auto num_words = static_cast<size_type>(
+        exec->copy_val_to_host(tmp->get_const_col_offsets() + num_rows));
+    tmp->col_deltas_.resize_and_reset(num_words);
+    tmp->set_size(this->get_size());
+    exec->run(csr::make_compress_from_csr(this, tmp.get()));
+}
+
+
+template <typename ValueType, typename IndexType>
+void Csr<ValueType, IndexType>::move_to(
+    CompressedCsr<ValueType, IndexType>* result)
+{
+    this->convert_to(result);
+}
+
+
+template <typename ValueType, typename IndexType>
+void Csr<ValueType, IndexType>::convert_to(
+    BlockEll<ValueType, IndexType>* result) const
+{
+    auto exec = this->get_executor();
+    auto block_size = result->get_block_size();
+    if (block_size == 0) {
+        block_size = BlockEll<ValueType, IndexType>::detect_block_size(this);
+    }
+    GKO_ASSERT_BLOCK_SIZE_CONFORMANT(this->get_size()[0], block_size);
+    GKO_ASSERT_BLOCK_SIZE_CONFORMANT(this->get_size()[1], block_size);
+    size_type num_blocks_per_row{};
+    exec->run(csr::make_compute_max_blocks_per_row(this, block_size,
+                                                   num_blocks_per_row));
+    auto tmp = make_temporary_clone(exec, result);
+    tmp->resize(block_size, this->get_size(), num_blocks_per_row);
+    exec->run(csr::make_fill_in_block_ell(this, tmp.get()));
+}
+
+
+template <typename ValueType, typename IndexType>
+void Csr<ValueType, IndexType>::move_to(BlockEll<ValueType, IndexType>* result)
+{
+    this->convert_to(result);
+}
+
+
 template <typename ValueType, typename IndexType>
 void Csr<ValueType, IndexType>::read(const mat_data& data)
 {
@@ -653,6 +849,20 @@ bool Csr<ValueType, IndexType>::is_sorted_by_column_index() const
 }
 
 
+template <typename ValueType, typename IndexType>
+void Csr<ValueType, IndexType>::multiply_masked(const Csr* b,
+                                                Csr* result) const
+{
+    GKO_ASSERT_CONFORMANT(this, b);
+    GKO_ASSERT_EQUAL_ROWS(this, result);
+    GKO_ASSERT_EQUAL_COLS(b, result);
+    auto exec = this->get_executor();
+    exec->run(csr::make_masked_spgemm(
+        this, make_temporary_clone(exec, b).get(),
+        make_temporary_clone(exec, result).get()));
+}
+
+
 template <typename ValueType, typename IndexType>
 std::unique_ptr<Csr<ValueType, IndexType>>
 Csr<ValueType, IndexType>::create_submatrix(const gko::span& row_span,
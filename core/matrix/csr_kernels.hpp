@@ -70,6 +70,23 @@ namespace kernels {
                        const matrix::Dense<ValueType>* beta,        \
                        matrix::Dense<ValueType>* c)
 
+#define GKO_DECLARE_CSR_MIXED_SPMV_KERNEL(InputValueType, MatrixValueType, \
+                                          OutputValueType, IndexType)      \
+    void mixed_spmv(std::shared_ptr<const DefaultExecutor> exec,           \
+                    const matrix::Csr<MatrixValueType, IndexType>* a,      \
+                    const matrix::Dense<InputValueType>* b,                \
+                    matrix::Dense<OutputValueType>* c)
+
+#define GKO_DECLARE_CSR_ADVANCED_MIXED_SPMV_KERNEL(                     \
+    InputValueType, MatrixValueType, OutputValueType, IndexType)        \
+    void advanced_mixed_spmv(                                           \
+        std::shared_ptr<const DefaultExecutor> exec,                    \
+        const matrix::Dense<MatrixValueType>* alpha,                    \
+        const matrix::Csr<MatrixValueType, IndexType>* a,               \
+        const matrix::Dense<InputValueType>* b,                         \
+        const matrix::Dense<OutputValueType>* beta,                     \
+        matrix::Dense<OutputValueType>* c)
+
 #define GKO_DECLARE_CSR_SPGEMM_KERNEL(ValueType, IndexType)  \
     void spgemm(std::shared_ptr<const DefaultExecutor> exec, \
                 const matrix::Csr<ValueType, IndexType>* a,  \
@@ -85,6 +102,12 @@ namespace kernels {
                          const matrix::Csr<ValueType, IndexType>* d,  \
                          matrix::Csr<ValueType, IndexType>* c)
 
+#define GKO_DECLARE_CSR_MASKED_SPGEMM_KERNEL(ValueType, IndexType)  \
+    void masked_spgemm(std::shared_ptr<const DefaultExecutor> exec, \
+                       const matrix::Csr<ValueType, IndexType>* a,  \
+                       const matrix::Csr<ValueType, IndexType>* b,  \
+                       matrix::Csr<ValueType, IndexType>* c)
+
 #define GKO_DECLARE_CSR_SPGEAM_KERNEL(ValueType, IndexType)  \
     void spgeam(std::shared_ptr<const DefaultExecutor> exec, \
                 const matrix::Dense<ValueType>* alpha,       \
@@ -245,11 +268,21 @@ namespace kernels {
     GKO_DECLARE_CSR_SPMV_KERNEL(ValueType, IndexType);                     \
     template <typename ValueType, typename IndexType>                      \
     GKO_DECLARE_CSR_ADVANCED_SPMV_KERNEL(ValueType, IndexType);            \
+    template <typename InputValueType, typename MatrixValueType,           \
+              typename OutputValueType, typename IndexType>                \
+    GKO_DECLARE_CSR_MIXED_SPMV_KERNEL(InputValueType, MatrixValueType,     \
+                                      OutputValueType, IndexType);         \
+    template <typename InputValueType, typename MatrixValueType,           \
+              typename OutputValueType, typename IndexType>                \
+    GKO_DECLARE_CSR_ADVANCED_MIXED_SPMV_KERNEL(                            \
+        InputValueType, MatrixValueType, OutputValueType, IndexType);      \
     template <typename ValueType, typename IndexType>                      \
     GKO_DECLARE_CSR_SPGEMM_KERNEL(ValueType, IndexType);                   \
     template <typename ValueType, typename IndexType>                      \
     GKO_DECLARE_CSR_ADVANCED_SPGEMM_KERNEL(ValueType, IndexType);          \
     template <typename ValueType, typename IndexType>                      \
+    GKO_DECLARE_CSR_MASKED_SPGEMM_KERNEL(ValueType, IndexType);            \
+    template <typename ValueType, typename IndexType>                      \
     GKO_DECLARE_CSR_SPGEAM_KERNEL(ValueType, IndexType);                   \
     template <typename ValueType, typename IndexType>                      \
     GKO_DECLARE_CSR_FILL_IN_DENSE_KERNEL(ValueType, IndexType);            \
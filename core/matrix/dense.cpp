@@ -791,11 +791,19 @@ template <typename IndexType>
 void Dense<ValueType>::convert_impl(Sellp<ValueType, IndexType>* result) const
 {
     auto exec = this->get_executor();
+    if (result->get_sorting_window() > 1) {
+        // the row permutation of SELL-C-sigma is computed by the Csr conversion
+        auto csr = Csr<ValueType, IndexType>::create(exec);
+        this->convert_to(csr.get());
+        csr->convert_to(result);
+        return;
+    }
     const auto num_rows = this->get_size()[0];
     const auto stride_factor = result->get_stride_factor();
     const auto slice_size = result->get_slice_size();
     const auto num_slices = ceildiv(num_rows, slice_size);
     auto tmp = make_temporary_clone(exec, result);
+    tmp->permutation_.clear();
     tmp->stride_factor_ = stride_factor;
     tmp->slice_size_ = slice_size;
     tmp->slice_sets_.resize_and_reset(num_slices + 1);
@@ -90,6 +90,8 @@ Sellp<ValueType, IndexType>& Sellp<ValueType, IndexType>::operator=(
         slice_sets_ = other.slice_sets_;
         slice_size_ = other.slice_size_;
         stride_factor_ = other.stride_factor_;
+        sorting_window_ = other.sorting_window_;
+        permutation_ = other.permutation_;
     }
     return *this;
 }
@@ -108,9 +110,12 @@ Sellp<ValueType, IndexType>& Sellp<ValueType, IndexType>::operator=(
         // slice_size and stride_factor are immutable
         slice_size_ = other.slice_size_;
         stride_factor_ = other.stride_factor_;
+        sorting_window_ = other.sorting_window_;
+        permutation_ = std::move(other.permutation_);
         // restore other invariant
         other.slice_sets_.resize_and_reset(1);
         other.slice_sets_.fill(0);
+        other.permutation_.clear();
     }
     return *this;
 }
@@ -165,6 +170,8 @@ void Sellp<ValueType, IndexType>::convert_to(
     result->slice_sets_ = this->slice_sets_;
     result->slice_size_ = this->slice_size_;
     result->stride_factor_ = this->stride_factor_;
+    result->sorting_window_ = this->sorting_window_;
+    result->permutation_ = this->permutation_;
     result->set_size(this->get_size());
 }
 
@@ -181,6 +188,13 @@ template <typename ValueType, typename IndexType>
 void Sellp<ValueType, IndexType>::convert_to(Dense<ValueType>* result) const
 {
     auto exec = this->get_executor();
+    if (this->get_const_permutation()) {
+        // restoring the original row order is handled by the Csr conversion
+        auto csr = Csr<ValueType, IndexType>::create(exec);
+        this->convert_to(csr.get());
+        csr->convert_to(result);
+        return;
+    }
     auto tmp_result = make_temporary_output_clone(exec, result);
     tmp_result->resize(this->get_size());
     tmp_result->fill(zero<ValueType>());
@@ -201,8 +215,8 @@ void Sellp<ValueType, IndexType>::convert_to(
 {
     auto exec = this->get_executor();
     const auto num_rows = this->get_size()[0];
-    {
-        auto tmp = make_temporary_clone(exec, result);
+    // converts the rows in the order in which they are stored
+    auto convert_stored = [&](Csr<ValueType, IndexType>* tmp) {
         tmp->row_ptrs_.resize_and_reset(num_rows + 1);
         exec->run(sellp::make_count_nonzeros_per_row(
             this, tmp->row_ptrs_.get_data()));
@@ -213,7 +227,18 @@ void Sellp<ValueType, IndexType>::convert_to(
         tmp->col_idxs_.resize_and_reset(nnz);
         tmp->values_.resize_and_reset(nnz);
         tmp->set_size(this->get_size());
-        exec->run(sellp::make_convert_to_csr(this, tmp.get()));
+        exec->run(sellp::make_convert_to_csr(this, tmp));
+    };
+    if (this->get_const_permutation()) {
+        auto stored =
+            Csr<ValueType, IndexType>::create(exec, result->get_strategy());
+        convert_stored(stored.get());
+        as<Csr<ValueType, IndexType>>(
+            stored->inverse_row_permute(&permutation_))
+            ->move_to(result);
+    } else {
+        auto tmp = make_temporary_clone(exec, result);
+        convert_stored(tmp.get());
     }
     result->make_srow();
 }
@@ -230,6 +255,14 @@ template <typename ValueType, typename IndexType>
 void Sellp<ValueType, IndexType>::read(const device_mat_data& data)
 {
     auto exec = this->get_executor();
+    if (sorting_window_ > 1) {
+        // the row permutation of SELL-C-sigma is computed by the Csr conversion
+        auto csr = Csr<ValueType, IndexType>::create(exec);
+        csr->read(data);
+        csr->convert_to(this);
+        return;
+    }
+    permutation_.clear();
     const auto size = data.get_size();
     slice_lengths_.resize_and_reset(ceildiv(size[0], slice_size_));
     slice_sets_.resize_and_reset(ceildiv(size[0], slice_size_) + 1);
@@ -270,6 +303,7 @@ template <typename ValueType, typename IndexType>
 void Sellp<ValueType, IndexType>::write(mat_data& data) const
 {
     auto tmp = make_temporary_clone(this->get_executor()->get_master(), this);
+    const auto permutation = tmp->get_const_permutation();
 
     data = {tmp->get_size(), {}};
 
@@ -287,12 +321,19 @@ void Sellp<ValueType, IndexType>::write(mat_data& data) const
                     const auto col = tmp->col_at(row_in_slice, slice_offset, i);
                     const auto val = tmp->val_at(row_in_slice, slice_offset, i);
                     if (col != invalid_index<IndexType>()) {
-                        data.nonzeros.emplace_back(row, col, val);
+                        const auto orig_row =
+                            permutation
+                                ? static_cast<size_type>(permutation[row])
+                                : row;
+                        data.nonzeros.emplace_back(orig_row, col, val);
                     }
                 }
             }
         }
     }
+    if (permutation) {
+        data.ensure_row_major_order();
+    }
 }
 
 
@@ -301,6 +342,11 @@ std::unique_ptr<Diagonal<ValueType>>
 Sellp<ValueType, IndexType>::extract_diagonal() const
 {
     auto exec = this->get_executor();
+    if (this->get_const_permutation()) {
+        auto csr = Csr<ValueType, IndexType>::create(exec);
+        this->convert_to(csr.get());
+        return csr->extract_diagonal();
+    }
 
     const auto diag_size = std::min(this->get_size()[0], this->get_size()[1]);
     auto diag = Diagonal<ValueType>::create(exec, diag_size);
@@ -329,9 +375,11 @@ Sellp<ValueType, IndexType>::compute_absolute() const
 
     auto abs_sellp = absolute_type::create(
         exec, this->get_size(), this->get_slice_size(),
-        this->get_stride_factor(), this->get_total_cols());
+        this->get_stride_factor(), this->get_total_cols(),
+        this->get_sorting_window());
 
     abs_sellp->col_idxs_ = col_idxs_;
+    abs_sellp->permutation_ = permutation_;
     abs_sellp->slice_lengths_ = slice_lengths_;
     abs_sellp->slice_sets_ = slice_sets_;
     exec->run(sellp::make_outplace_absolute_array(
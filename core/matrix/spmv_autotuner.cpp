@@ -0,0 +1,375 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2022, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#include <ginkgo/core/matrix/spmv_autotuner.hpp>
+
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <sstream>
+
+
+#include <ginkgo/core/base/exception.hpp>
+#include <ginkgo/core/base/exception_helpers.hpp>
+#include <ginkgo/core/base/name_demangling.hpp>
+#include <ginkgo/core/base/temporary_clone.hpp>
+#include <ginkgo/core/matrix/coo.hpp>
+#include <ginkgo/core/matrix/csr.hpp>
+#include <ginkgo/core/matrix/dense.hpp>
+#include <ginkgo/core/matrix/ell.hpp>
+#include <ginkgo/core/matrix/hybrid.hpp>
+#include <ginkgo/core/matrix/sellp.hpp>
+
+
+namespace gko {
+namespace matrix {
+namespace {
+
+
+// Ell candidates storing more than this many entries per nonzero are not
+// tried, since their conversion may run out of memory
+constexpr double max_ell_padding = 8.0;
+
+
+int log_bucket(double value)
+{
+    return static_cast<int>(std::floor(2.0 * std::log2(value + 1.0)));
+}
+
+
+bool is_gpu_executor(const std::shared_ptr<const Executor>& exec)
+{
+    return std::dynamic_pointer_cast<const CudaExecutor>(exec) ||
+           std::dynamic_pointer_cast<const HipExecutor>(exec) ||
+           std::dynamic_pointer_cast<const DpcppExecutor>(exec);
+}
+
+
+template <typename CsrType>
+std::shared_ptr<typename CsrType::strategy_type> make_load_balance(
+    const std::shared_ptr<const Executor>& exec)
+{
+    using load_balance = typename CsrType::load_balance;
+    if (auto cuda_exec = std::dynamic_pointer_cast<const CudaExecutor>(exec)) {
+        return std::make_shared<load_balance>(cuda_exec);
+    } else if (auto hip_exec =
+                   std::dynamic_pointer_cast<const HipExecutor>(exec)) {
+        return std::make_shared<load_balance>(hip_exec);
+    } else if (auto dpcpp_exec =
+                   std::dynamic_pointer_cast<const DpcppExecutor>(exec)) {
+        return std::make_shared<load_balance>(dpcpp_exec);
+    }
+    return std::make_shared<typename CsrType::classical>();
+}
+
+
+template <typename ResultType, typename CsrType>
+std::unique_ptr<LinOp> convert_csr(const CsrType* mtx,
+                                   std::unique_ptr<ResultType> result)
+{
+    mtx->convert_to(result.get());
+    return result;
+}
+
+
+}  // anonymous namespace
+
+
+std::string spmv_matrix_features::get_key() const
+{
+    const auto empty_tenths = static_cast<int>(
+        10.0 * num_empty_rows / std::max<size_type>(num_rows, 1));
+    std::ostringstream key;
+    key << "rows" << log_bucket(num_rows) << "-mean"
+        << log_bucket(mean_row_nonzeros) << "-dev"
+        << log_bucket(row_nonzeros_deviation) << "-ell"
+        << log_bucket(ell_padding) << "-sellp" << log_bucket(sellp_padding)
+        << "-empty" << empty_tenths;
+    return key.str();
+}
+
+
+template <typename ValueType, typename IndexType>
+SpmvAutotuner<ValueType, IndexType>::SpmvAutotuner(
+    std::shared_ptr<const Executor> exec, spmv_tuning_mode mode,
+    size_type num_repetitions, size_type num_rhs)
+    : exec_{std::move(exec)},
+      mode_{mode},
+      num_repetitions_{std::max<size_type>(num_repetitions, 1)},
+      num_rhs_{std::max<size_type>(num_rhs, 1)},
+      last_from_cache_{false}
+{}
+
+
+template <typename ValueType, typename IndexType>
+void SpmvAutotuner<ValueType, IndexType>::set_cache_file(std::string filename)
+{
+    cache_file_ = std::move(filename);
+    std::ifstream stream{cache_file_};
+    std::string key;
+    std::string format;
+    while (stream >> key >> format) {
+        cache_[key] = format;
+    }
+}
+
+
+template <typename ValueType, typename IndexType>
+void SpmvAutotuner<ValueType, IndexType>::write_cache() const
+{
+    std::ofstream stream{cache_file_};
+    if (!stream) {
+        throw GKO_STREAM_ERROR("unable to write the SpMV autotuner cache " +
+                               cache_file_);
+    }
+    for (const auto& entry : cache_) {
+        stream << entry.first << ' ' << entry.second << '\n';
+    }
+}
+
+
+template <typename ValueType, typename IndexType>
+std::vector<std::string> SpmvAutotuner<ValueType, IndexType>::get_candidates()
+    const
+{
+    std::vector<std::string> candidates{"csr"};
+    if (is_gpu_executor(exec_)) {
+        // the Csr strategies only make a difference on GPUs
+        candidates.insert(candidates.end(),
+                          {"csr_classical", "csr_load_balance",
+                           "csr_merge_path", "csr_sparselib"});
+    }
+    candidates.insert(candidates.end(), {"coo", "ell", "sellp", "hybrid",
+                                         "hybrid_minimal_storage"});
+    return candidates;
+}
+
+
+template <typename ValueType, typename IndexType>
+std::unique_ptr<LinOp> SpmvAutotuner<ValueType, IndexType>::convert(
+    const csr_type* mtx, const std::string& format) const
+{
+    using hybrid_type = Hybrid<ValueType, IndexType>;
+    using minimal_storage_limit = typename hybrid_type::minimal_storage_limit;
+    if (format.compare(0, 3, "csr") == 0) {
+        auto result = csr_type::create(exec_);
+        auto strategy = result->get_strategy();
+        if (format == "csr_classical") {
+            strategy = std::make_shared<typename csr_type::classical>();
+        } else if (format == "csr_load_balance") {
+            strategy = make_load_balance<csr_type>(exec_);
+        } else if (format == "csr_merge_path") {
+            strategy = std::make_shared<typename csr_type::merge_path>();
+        } else if (format == "csr_sparselib") {
+            strategy = std::make_shared<typename csr_type::sparselib>();
+        } else if (format != "csr") {
+            throw NotSupported(__FILE__, __LINE__, __func__, format);
+        }
+        result->copy_from(mtx);
+        result->set_strategy(strategy);
+        return result;
+    } else if (format == "coo") {
+        return convert_csr(mtx, Coo<ValueType, IndexType>::create(exec_));
+    } else if (format == "ell") {
+        return convert_csr(mtx, Ell<ValueType, IndexType>::create(exec_));
+    } else if (format == "sellp") {
+        return convert_csr(mtx, Sellp<ValueType, IndexType>::create(exec_));
+    } else if (format == "hybrid") {
+        return convert_csr(
+            mtx, hybrid_type::create(
+                     exec_, std::make_shared<
+                                typename hybrid_type::imbalance_limit>()));
+    } else if (format == "hybrid_minimal_storage") {
+        return convert_csr(
+            mtx, hybrid_type::create(
+                     exec_, std::make_shared<minimal_storage_limit>()));
+    }
+    throw NotSupported(__FILE__, __LINE__, __func__, format);
+}
+
+
+template <typename ValueType, typename IndexType>
+spmv_matrix_features SpmvAutotuner<ValueType, IndexType>::compute_features(
+    const csr_type* mtx)
+{
+    auto host_mtx =
+        make_temporary_clone(mtx->get_executor()->get_master(), mtx);
+    const auto row_ptrs = host_mtx->get_const_row_ptrs();
+    spmv_matrix_features features{};
+    features.num_rows = mtx->get_size()[0];
+    features.num_cols = mtx->get_size()[1];
+    features.num_nonzeros = mtx->get_num_stored_elements();
+    size_type sellp_entries{};
+    size_type slice_max{};
+    double sum_squares{};
+    for (size_type row = 0; row < features.num_rows; row++) {
+        const auto row_nnz =
+            static_cast<size_type>(row_ptrs[row + 1] - row_ptrs[row]);
+        features.num_empty_rows += row_nnz == 0 ? 1 : 0;
+        features.max_row_nonzeros =
+            std::max(features.max_row_nonzeros, row_nnz);
+        sum_squares += static_cast<double>(row_nnz) * row_nnz;
+        slice_max = std::max(slice_max, row_nnz);
+        if ((row + 1) % default_slice_size == 0 ||
+            row + 1 == features.num_rows) {
+            sellp_entries += slice_max * default_slice_size;
+            slice_max = 0;
+        }
+    }
+    if (features.num_rows > 0) {
+        features.mean_row_nonzeros =
+            static_cast<double>(features.num_nonzeros) / features.num_rows;
+        features.row_nonzeros_deviation = std::sqrt(std::max(
+            sum_squares / features.num_rows -
+                features.mean_row_nonzeros * features.mean_row_nonzeros,
+            0.0));
+    }
+    if (features.num_nonzeros > 0) {
+        const auto nnz = static_cast<double>(features.num_nonzeros);
+        features.ell_padding =
+            features.max_row_nonzeros * features.num_rows / nnz;
+        features.sellp_padding = sellp_entries / nnz;
+    }
+    return features;
+}
+
+
+template <typename ValueType, typename IndexType>
+std::string SpmvAutotuner<ValueType, IndexType>::choose_by_model(
+    const spmv_matrix_features& features)
+{
+    if (features.num_nonzeros == 0) {
+        return "csr";
+    }
+    if (features.ell_padding <= 1.1) {
+        return "ell";
+    }
+    if (features.sellp_padding <= 1.3) {
+        return "sellp";
+    }
+    if (features.num_empty_rows * 2 > features.num_rows) {
+        return "coo";
+    }
+    if (features.row_nonzeros_deviation > 2.0 * features.mean_row_nonzeros) {
+        return "hybrid";
+    }
+    return "csr";
+}
+
+
+template <typename ValueType, typename IndexType>
+double SpmvAutotuner<ValueType, IndexType>::time_spmv(const LinOp* mtx) const
+{
+    using vec = Dense<ValueType>;
+    auto b = vec::create(exec_, dim<2>{mtx->get_size()[1], num_rhs_});
+    auto x = vec::create(exec_, dim<2>{mtx->get_size()[0], num_rhs_});
+    b->fill(one<ValueType>());
+    x->fill(zero<ValueType>());
+    // warm up caches and lazily initialized library handles
+    mtx->apply(b.get(), x.get());
+    exec_->synchronize();
+    const auto start = std::chrono::steady_clock::now();
+    for (size_type i = 0; i < num_repetitions_; i++) {
+        mtx->apply(b.get(), x.get());
+    }
+    exec_->synchronize();
+    const auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(end - start).count() /
+           num_repetitions_;
+}
+
+
+template <typename ValueType, typename IndexType>
+std::string SpmvAutotuner<ValueType, IndexType>::get_cache_key(
+    const spmv_matrix_features& features) const
+{
+    std::ostringstream key;
+    key << name_demangling::get_dynamic_type(*exec_) << '-'
+        << name_demangling::get_type_name(typeid(ValueType)) << '-'
+        << name_demangling::get_type_name(typeid(IndexType)) << "-rhs"
+        << num_rhs_ << '-' << features.get_key();
+    return key.str();
+}
+
+
+template <typename ValueType, typename IndexType>
+std::unique_ptr<LinOp> SpmvAutotuner<ValueType, IndexType>::tune(
+    const csr_type* mtx)
+{
+    const auto features = compute_features(mtx);
+    const auto key = this->get_cache_key(features);
+    last_timings_.clear();
+    const auto cached = cache_.find(key);
+    if (cached != cache_.end()) {
+        last_format_ = cached->second;
+        last_from_cache_ = true;
+        return this->convert(mtx, last_format_);
+    }
+    last_from_cache_ = false;
+    if (mode_ == spmv_tuning_mode::model) {
+        // model decisions are cheap, so they are not cached
+        last_format_ = choose_by_model(features);
+        return this->convert(mtx, last_format_);
+    }
+    std::unique_ptr<LinOp> best;
+    auto best_time = std::numeric_limits<double>::infinity();
+    for (const auto& format : this->get_candidates()) {
+        if (format == "ell" && features.ell_padding > max_ell_padding) {
+            continue;
+        }
+        auto candidate = this->convert(mtx, format);
+        const auto time = this->time_spmv(candidate.get());
+        last_timings_[format] = time;
+        if (time < best_time) {
+            best_time = time;
+            best = std::move(candidate);
+            last_format_ = format;
+        }
+    }
+    cache_[key] = last_format_;
+    if (!cache_file_.empty()) {
+        this->write_cache();
+    }
+    return best;
+}
+
+
+#define GKO_DECLARE_SPMV_AUTOTUNER(ValueType, IndexType) \
+    class SpmvAutotuner<ValueType, IndexType>
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(GKO_DECLARE_SPMV_AUTOTUNER);
+
+
+}  // namespace matrix
+}  // namespace gko
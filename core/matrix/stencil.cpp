@@ -0,0 +1,217 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2022, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#include <ginkgo/core/matrix/stencil.hpp>
+
+
+#include <utility>
+
+
+#include <ginkgo/core/base/exception_helpers.hpp>
+#include <ginkgo/core/base/executor.hpp>
+#include <ginkgo/core/base/precision_dispatch.hpp>
+#include <ginkgo/core/base/utils.hpp>
+#include <ginkgo/core/matrix/csr.hpp>
+#include <ginkgo/core/matrix/dense.hpp>
+
+
+#include "core/components/prefix_sum_kernels.hpp"
+#include "core/matrix/stencil_kernels.hpp"
+
+
+namespace gko {
+namespace matrix {
+namespace stencil {
+namespace {
+
+
+GKO_REGISTER_OPERATION(spmv, stencil::spmv);
+GKO_REGISTER_OPERATION(advanced_spmv, stencil::advanced_spmv);
+GKO_REGISTER_OPERATION(count_nonzeros_per_row, stencil::count_nonzeros_per_row);
+GKO_REGISTER_OPERATION(fill_in_csr, stencil::fill_in_csr);
+GKO_REGISTER_OPERATION(prefix_sum, components::prefix_sum);
+
+
+}  // anonymous namespace
+}  // namespace stencil
+
+
+template <typename ValueType, typename IndexType>
+Stencil<ValueType, IndexType>::Stencil(std::shared_ptr<const Executor> exec,
+                                       const dim<3>& grid_size,
+                                       array<index_type> offsets,
+                                       array<value_type> coefficients)
+    : EnableLinOp<Stencil>(
+          exec, dim<2>{grid_size[0] * grid_size[1] * grid_size[2]}),
+      grid_size_{grid_size},
+      offsets_{exec, std::move(offsets)},
+      coefficients_{exec, std::move(coefficients)}
+{
+    GKO_ASSERT_EQ(offsets_.get_num_elems() % 3, 0);
+    const auto num_points = this->get_num_points();
+    const auto num_rows = this->get_size()[0];
+    if (coefficients_.get_num_elems() != num_points * num_rows) {
+        GKO_ASSERT_EQ(coefficients_.get_num_elems(), num_points);
+    }
+}
+
+
+template <typename ValueType, typename IndexType>
+Stencil<ValueType, IndexType>& Stencil<ValueType, IndexType>::operator=(
+    const Stencil& other)
+{
+    if (&other != this) {
+        EnableLinOp<Stencil>::operator=(other);
+        grid_size_ = other.grid_size_;
+        offsets_ = other.offsets_;
+        coefficients_ = other.coefficients_;
+    }
+    return *this;
+}
+
+
+template <typename ValueType, typename IndexType>
+Stencil<ValueType, IndexType>& Stencil<ValueType, IndexType>::operator=(
+    Stencil&& other)
+{
+    if (&other != this) {
+        EnableLinOp<Stencil>::operator=(std::move(other));
+        grid_size_ = std::exchange(other.grid_size_, dim<3>{0, 0, 0});
+        offsets_ = std::move(other.offsets_);
+        coefficients_ = std::move(other.coefficients_);
+    }
+    return *this;
+}
+
+
+template <typename ValueType, typename IndexType>
+Stencil<ValueType, IndexType>::Stencil(const Stencil& other)
+    : Stencil(other.get_executor())
+{
+    *this = other;
+}
+
+
+template <typename ValueType, typename IndexType>
+Stencil<ValueType, IndexType>::Stencil(Stencil&& other)
+    : Stencil(other.get_executor())
+{
+    *this = std::move(other);
+}
+
+
+template <typename ValueType, typename IndexType>
+void Stencil<ValueType, IndexType>::apply_impl(const LinOp* b, LinOp* x) const
+{
+    precision_dispatch_real_complex<ValueType>(
+        [this](auto dense_b, auto dense_x) {
+            this->get_executor()->run(
+                stencil::make_spmv(this, dense_b, dense_x));
+        },
+        b, x);
+}
+
+
+template <typename ValueType, typename IndexType>
+void Stencil<ValueType, IndexType>::apply_impl(const LinOp* alpha,
+                                               const LinOp* b,
+                                               const LinOp* beta,
+                                               LinOp* x) const
+{
+    precision_dispatch_real_complex<ValueType>(
+        [this](auto dense_alpha, auto dense_b, auto dense_beta, auto dense_x) {
+            this->get_executor()->run(stencil::make_advanced_spmv(
+                dense_alpha, this, dense_b, dense_beta, dense_x));
+        },
+        alpha, b, beta, x);
+}
+
+
+template <typename ValueType, typename IndexType>
+void Stencil<ValueType, IndexType>::convert_to(
+    Csr<ValueType, IndexType>* result) const
+{
+    auto exec = this->get_executor();
+    const auto num_rows = this->get_size()[0];
+    array<index_type> row_ptrs{exec, num_rows + 1};
+    exec->run(stencil::make_count_nonzeros_per_row(this, row_ptrs.get_data()));
+    exec->run(stencil::make_prefix_sum(row_ptrs.get_data(), num_rows + 1));
+    const auto nnz = static_cast<size_type>(
+        exec->copy_val_to_host(row_ptrs.get_const_data() + num_rows));
+    auto tmp = Csr<ValueType, IndexType>::create(
+        exec, this->get_size(), array<value_type>{exec, nnz},
+        array<index_type>{exec, nnz}, std::move(row_ptrs),
+        result->get_strategy());
+    exec->run(stencil::make_fill_in_csr(this, tmp.get()));
+    tmp->move_to(result);
+}
+
+
+template <typename ValueType, typename IndexType>
+void Stencil<ValueType, IndexType>::move_to(Csr<ValueType, IndexType>* result)
+{
+    this->convert_to(result);
+}
+
+
+template <typename ValueType, typename IndexType>
+void Stencil<ValueType, IndexType>::convert_to(Dense<ValueType>* result) const
+{
+    auto tmp = Csr<ValueType, IndexType>::create(this->get_executor());
+    this->convert_to(tmp.get());
+    tmp->convert_to(result);
+}
+
+
+template <typename ValueType, typename IndexType>
+void Stencil<ValueType, IndexType>::move_to(Dense<ValueType>* result)
+{
+    this->convert_to(result);
+}
+
+
+template <typename ValueType, typename IndexType>
+void Stencil<ValueType, IndexType>::write(mat_data& data) const
+{
+    auto tmp = Csr<ValueType, IndexType>::create(this->get_executor());
+    this->convert_to(tmp.get());
+    tmp->write(data);
+}
+
+
+#define GKO_DECLARE_STENCIL_MATRIX(ValueType, IndexType) \
+    class Stencil<ValueType, IndexType>
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(GKO_DECLARE_STENCIL_MATRIX);
+
+
+}  // namespace matrix
+}  // namespace gko
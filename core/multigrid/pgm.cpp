@@ -39,6 +39,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ginkgo/core/base/polymorphic_object.hpp>
 #include <ginkgo/core/base/types.hpp>
 #include <ginkgo/core/base/utils.hpp>
+#include <ginkgo/core/distributed/matrix.hpp>
+#include <ginkgo/core/distributed/partition.hpp>
 #include <ginkgo/core/matrix/coo.hpp>
 #include <ginkgo/core/matrix/csr.hpp>
 #include <ginkgo/core/matrix/dense.hpp>
@@ -47,9 +49,12 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ginkgo/core/matrix/sparsity_csr.hpp>
 
 
+#include "core/base/dispatch_helper.hpp"
 #include "core/base/utils.hpp"
 #include "core/components/fill_array_kernels.hpp"
 #include "core/components/format_conversion_kernels.hpp"
+#include "core/distributed/assembly.hpp"
+#include "core/distributed/helpers.hpp"
 #include "core/matrix/csr_builder.hpp"
 #include "core/multigrid/pgm_kernels.hpp"
 
@@ -141,34 +146,20 @@ std::shared_ptr<matrix::Csr<ValueType, IndexType>> generate_coarse(
 }
 
 
-}  // namespace
-
-
-template <typename ValueType, typename IndexType>
-void Pgm<ValueType, IndexType>::generate()
+template <typename ValueType, typename IndexType, typename ParametersType>
+IndexType compute_aggregates(std::shared_ptr<const Executor> exec,
+                             const matrix::Csr<ValueType, IndexType>* pgm_op,
+                             const ParametersType& parameters,
+                             array<IndexType>& agg)
 {
-    using csr_type = matrix::Csr<ValueType, IndexType>;
     using real_type = remove_complex<ValueType>;
-    using weight_csr_type = remove_complex<csr_type>;
-    auto exec = this->get_executor();
-    const auto num_rows = this->system_matrix_->get_size()[0];
-    array<IndexType> strongest_neighbor(this->get_executor(), num_rows);
-    array<IndexType> intermediate_agg(this->get_executor(),
-                                      parameters_.deterministic * num_rows);
-    // Only support csr matrix currently.
-    const csr_type* pgm_op =
-        dynamic_cast<const csr_type*>(system_matrix_.get());
-    std::shared_ptr<const csr_type> pgm_op_shared_ptr{};
-    // If system matrix is not csr or need sorting, generate the csr.
-    if (!parameters_.skip_sorting || !pgm_op) {
-        pgm_op_shared_ptr = convert_to_with_sorting<csr_type>(
-            exec, system_matrix_, parameters_.skip_sorting);
-        pgm_op = pgm_op_shared_ptr.get();
-        // keep the same precision data in fine_op
-        this->set_fine_op(pgm_op_shared_ptr);
-    }
+    using weight_csr_type = remove_complex<matrix::Csr<ValueType, IndexType>>;
+    const auto num_rows = pgm_op->get_size()[0];
+    array<IndexType> strongest_neighbor(exec, num_rows);
+    array<IndexType> intermediate_agg(exec,
+                                      parameters.deterministic * num_rows);
     // Initial agg = -1
-    exec->run(pgm::make_fill_array(agg_.get_data(), agg_.get_num_elems(),
+    exec->run(pgm::make_fill_array(agg.get_data(), agg.get_num_elems(),
                                    -one<IndexType>()));
     IndexType num_unagg = num_rows;
     IndexType num_unagg_prev = num_rows;
@@ -184,35 +175,66 @@ void Pgm<ValueType, IndexType>::generate()
                    lend(weight_mtx));
     // Extract the diagonal value of matrix
     auto diag = weight_mtx->extract_diagonal();
-    for (int i = 0; i < parameters_.max_iterations; i++) {
+    for (int i = 0; i < parameters.max_iterations; i++) {
         // Find the strongest neighbor of each row
         exec->run(pgm::make_find_strongest_neighbor(
-            weight_mtx.get(), diag.get(), agg_, strongest_neighbor));
+            weight_mtx.get(), diag.get(), agg, strongest_neighbor));
         // Match edges
-        exec->run(pgm::make_match_edge(strongest_neighbor, agg_));
+        exec->run(pgm::make_match_edge(strongest_neighbor, agg));
         // Get the num_unagg
-        exec->run(pgm::make_count_unagg(agg_, &num_unagg));
+        exec->run(pgm::make_count_unagg(agg, &num_unagg));
         // no new match, all match, or the ratio of num_unagg/num is lower
         // than parameter.max_unassigned_ratio
         if (num_unagg == 0 || num_unagg == num_unagg_prev ||
-            num_unagg < parameters_.max_unassigned_ratio * num_rows) {
+            num_unagg < parameters.max_unassigned_ratio * num_rows) {
             break;
         }
         num_unagg_prev = num_unagg;
     }
     // Handle the left unassign points
-    if (num_unagg != 0 && parameters_.deterministic) {
+    if (num_unagg != 0 && parameters.deterministic) {
         // copy the agg to intermediate_agg
-        intermediate_agg = agg_;
+        intermediate_agg = agg;
     }
     if (num_unagg != 0) {
         // Assign all left points
         exec->run(pgm::make_assign_to_exist_agg(weight_mtx.get(), diag.get(),
-                                                agg_, intermediate_agg));
+                                                agg, intermediate_agg));
     }
     IndexType num_agg = 0;
     // Renumber the index
-    exec->run(pgm::make_renumber(agg_, &num_agg));
+    exec->run(pgm::make_renumber(agg, &num_agg));
+    return num_agg;
+}
+
+
+}  // namespace
+
+
+template <typename ValueType, typename IndexType>
+void Pgm<ValueType, IndexType>::generate()
+{
+#if GINKGO_BUILD_MPI
+    if (gko::detail::is_distributed(system_matrix_.get())) {
+        this->generate_distributed();
+        return;
+    }
+#endif
+    using csr_type = matrix::Csr<ValueType, IndexType>;
+    auto exec = this->get_executor();
+    // Only support csr matrix currently.
+    const csr_type* pgm_op =
+        dynamic_cast<const csr_type*>(system_matrix_.get());
+    std::shared_ptr<const csr_type> pgm_op_shared_ptr{};
+    // If system matrix is not csr or need sorting, generate the csr.
+    if (!parameters_.skip_sorting || !pgm_op) {
+        pgm_op_shared_ptr = convert_to_with_sorting<csr_type>(
+            exec, system_matrix_, parameters_.skip_sorting);
+        pgm_op = pgm_op_shared_ptr.get();
+        // keep the same precision data in fine_op
+        this->set_fine_op(pgm_op_shared_ptr);
+    }
+    auto num_agg = compute_aggregates(exec, pgm_op, parameters_, agg_);
 
     gko::dim<2>::dimension_type coarse_dim = num_agg;
     auto fine_dim = system_matrix_->get_size()[0];
@@ -236,6 +258,189 @@ void Pgm<ValueType, IndexType>::generate()
 }
 
 
+#if GINKGO_BUILD_MPI
+
+
+template <typename ValueType, typename IndexType>
+void Pgm<ValueType, IndexType>::generate_distributed()
+{
+    // IndexType is the local index type, the global index type has to be at
+    // least as large
+    using narrow_global_index_type =
+        std::conditional_t<std::is_same<IndexType, int32>::value, int32,
+                           int64>;
+    run<const experimental::distributed::Matrix<ValueType, IndexType, int64>*,
+        const experimental::distributed::Matrix<ValueType, IndexType,
+                                                narrow_global_index_type>*>(
+        system_matrix_.get(), [this](auto mtx) {
+            using matrix_type = std::decay_t<decltype(*mtx)>;
+            using global_index_type = typename matrix_type::global_index_type;
+            using csr_type = matrix::Csr<ValueType, IndexType>;
+            using experimental::distributed::comm_index_type;
+            using partition_type =
+                experimental::distributed::Partition<IndexType,
+                                                     global_index_type>;
+            auto exec = this->get_executor();
+            auto host = exec->get_master();
+            auto comm = mtx->get_communicator();
+            const auto rank = comm.rank();
+            const auto num_ranks = comm.size();
+            auto row_partition =
+                make_temporary_clone(host, mtx->get_row_partition().get());
+
+            // aggregate the local rows, the aggregates stay on this process
+            auto local_csr = convert_to_with_sorting<csr_type>(
+                exec, mtx->get_local_matrix(), parameters_.skip_sorting);
+            const auto num_rows = local_csr->get_size()[0];
+            agg_.resize_and_reset(num_rows);
+            IndexType num_agg = 0;
+            if (num_rows > 0) {
+                num_agg = compute_aggregates(exec, local_csr.get(),
+                                             parameters_, agg_);
+            }
+
+            // number the aggregates globally by process
+            std::vector<global_index_type> coarse_offsets(num_ranks + 1);
+            global_index_type local_num_agg = num_agg;
+            comm.all_gather(host, &local_num_agg, 1, coarse_offsets.data() + 1,
+                            1);
+            std::partial_sum(coarse_offsets.begin() + 1, coarse_offsets.end(),
+                             coarse_offsets.begin() + 1);
+            const auto coarse_size = coarse_offsets.back();
+            array<IndexType> host_agg(host, agg_);
+            std::vector<global_index_type> local_to_coarse(num_rows);
+            std::vector<global_index_type> local_to_global(num_rows);
+            for (size_type i = 0; i < num_rows; i++) {
+                local_to_coarse[i] =
+                    coarse_offsets[rank] + host_agg.get_const_data()[i];
+            }
+            for (size_type range = 0;
+                 range < row_partition->get_num_ranges(); range++) {
+                if (row_partition->get_part_ids()[range] == rank) {
+                    const auto begin = row_partition->get_range_bounds()[range];
+                    const auto end =
+                        row_partition->get_range_bounds()[range + 1];
+                    const auto start =
+                        row_partition->get_range_starting_indices()[range];
+                    for (auto row = begin; row < end; row++) {
+                        local_to_global[start + (row - begin)] = row;
+                    }
+                }
+            }
+
+            // exchange the aggregates of the non-local columns
+            array<IndexType> gather_idxs(host, mtx->get_gather_idxs());
+            const auto& send_offsets = mtx->get_send_offsets();
+            const auto& recv_offsets = mtx->get_recv_offsets();
+            std::vector<global_index_type> send_coarse(send_offsets.back());
+            std::vector<global_index_type> non_local_to_coarse(
+                recv_offsets.back());
+            for (size_type i = 0; i < send_coarse.size(); i++) {
+                send_coarse[i] =
+                    local_to_coarse[gather_idxs.get_const_data()[i]];
+            }
+            comm.all_to_all_v(host, send_coarse.data(),
+                              mtx->get_send_sizes().data(),
+                              send_offsets.data(), non_local_to_coarse.data(),
+                              mtx->get_recv_sizes().data(),
+                              recv_offsets.data());
+
+            // Galerkin product with the piecewise constant prolongation
+            const dim<2> coarse_dim{static_cast<size_type>(coarse_size),
+                                    static_cast<size_type>(coarse_size)};
+            matrix_data<ValueType, global_index_type> coarse_data{coarse_dim};
+            auto host_local = make_temporary_clone(host, local_csr.get());
+            auto host_non_local = csr_type::create(host);
+            host_non_local->copy_from(mtx->get_non_local_matrix().get());
+            for (size_type row = 0; row < num_rows; row++) {
+                for (auto nz = host_local->get_const_row_ptrs()[row];
+                     nz < host_local->get_const_row_ptrs()[row + 1]; nz++) {
+                    coarse_data.nonzeros.emplace_back(
+                        local_to_coarse[row],
+                        local_to_coarse[host_local->get_const_col_idxs()[nz]],
+                        host_local->get_const_values()[nz]);
+                }
+                for (auto nz = host_non_local->get_const_row_ptrs()[row];
+                     nz < host_non_local->get_const_row_ptrs()[row + 1];
+                     nz++) {
+                    coarse_data.nonzeros.emplace_back(
+                        local_to_coarse[row],
+                        non_local_to_coarse[host_non_local
+                                                ->get_const_col_idxs()[nz]],
+                        host_non_local->get_const_values()[nz]);
+                }
+            }
+            matrix_data<ValueType, global_index_type> prolong_data{
+                dim<2>{mtx->get_size()[0], coarse_dim[0]}};
+            matrix_data<ValueType, global_index_type> restrict_data{
+                dim<2>{coarse_dim[0], mtx->get_size()[0]}};
+            for (size_type row = 0; row < num_rows; row++) {
+                prolong_data.nonzeros.emplace_back(local_to_global[row],
+                                                   local_to_coarse[row],
+                                                   one<ValueType>());
+                restrict_data.nonzeros.emplace_back(local_to_coarse[row],
+                                                    local_to_global[row],
+                                                    one<ValueType>());
+            }
+
+            // without agglomeration, each process owns its own aggregates
+            array<global_index_type> coarse_ranges{host, coarse_offsets.begin(),
+                                                   coarse_offsets.end()};
+            const auto min_rows = static_cast<global_index_type>(
+                parameters_.min_coarse_rows_per_rank);
+            const bool agglomerate = coarse_size < min_rows * num_ranks;
+            if (agglomerate) {
+                // spread the active processes evenly over all processes
+                const auto num_active = std::max<global_index_type>(
+                    coarse_size / min_rows, 1);
+                const auto stride = static_cast<comm_index_type>(
+                    ceildiv(num_ranks, num_active));
+                const auto num_strided = ceildiv(num_ranks, stride);
+                auto ranges = coarse_ranges.get_data();
+                for (comm_index_type part = 0; part < num_ranks; part++) {
+                    const auto active = part / stride;
+                    ranges[part + 1] =
+                        part % stride == 0
+                            ? coarse_size * (active + 1) / num_strided
+                            : ranges[part];
+                }
+            }
+            auto coarse_partition = share(partition_type::build_from_contiguous(
+                exec, array<global_index_type>{exec, coarse_ranges}));
+            if (agglomerate) {
+                coarse_data = gko::detail::communicate_to_owners(
+                    comm, coarse_data, coarse_partition.get());
+                restrict_data = gko::detail::communicate_to_owners(
+                    comm, restrict_data, coarse_partition.get());
+            } else {
+                coarse_data.sum_duplicates();
+                restrict_data.ensure_row_major_order();
+            }
+
+            // keep the storage formats of the fine matrix
+            auto coarse = share(matrix_type::create(
+                exec, comm,
+                as<LinOp>(mtx->get_local_matrix()->create_default()).get(),
+                as<LinOp>(mtx->get_non_local_matrix()->create_default())
+                    .get()));
+            coarse->read_distributed(coarse_data, coarse_partition.get());
+            auto prolong = share(matrix_type::create(exec, comm));
+            prolong->read_distributed(prolong_data,
+                                      mtx->get_row_partition().get(),
+                                      coarse_partition.get());
+            auto restrict_op = share(matrix_type::create(exec, comm));
+            restrict_op->read_distributed(restrict_data,
+                                          coarse_partition.get(),
+                                          mtx->get_row_partition().get());
+
+            this->set_multigrid_level(prolong, coarse, restrict_op);
+        });
+}
+
+
+#endif
+
+
 #define GKO_DECLARE_PGM(_vtype, _itype) class Pgm<_vtype, _itype>
 GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(GKO_DECLARE_PGM);
 
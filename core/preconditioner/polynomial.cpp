@@ -0,0 +1,316 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2022, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+
+#include <ginkgo/core/preconditioner/polynomial.hpp>
+
+
+#include <cmath>
+#include <random>
+
+
+#include <ginkgo/core/base/exception_helpers.hpp>
+#include <ginkgo/core/base/executor.hpp>
+#include <ginkgo/core/base/math.hpp>
+#include <ginkgo/core/base/precision_dispatch.hpp>
+#include <ginkgo/core/matrix/dense.hpp>
+
+
+#include "core/distributed/helpers.hpp"
+#include "core/preconditioner/polynomial_kernels.hpp"
+
+
+namespace gko {
+namespace preconditioner {
+namespace polynomial {
+namespace {
+
+
+GKO_REGISTER_OPERATION(horner_step, polynomial::horner_step);
+GKO_REGISTER_OPERATION(chebyshev_initialize, polynomial::chebyshev_initialize);
+GKO_REGISTER_OPERATION(chebyshev_step, polynomial::chebyshev_step);
+
+
+/**
+ * Computes the coefficients c_0, ..., c_d of p(t) = sum_k c_k t^k, such that
+ * the residual polynomial 1 - t p(t) is minimal in the least squares sense at
+ * the Chebyshev nodes of [lower, 1]. The overdetermined system is solved by
+ * a QR decomposition based on modified Gram-Schmidt.
+ */
+std::vector<double> compute_least_squares_coefficients(size_type degree,
+                                                       double lower)
+{
+    const auto num_coeffs = degree + 1;
+    const auto num_nodes = 4 * num_coeffs;
+    const auto pi = std::acos(-1.0);
+    // column-major num_nodes x num_coeffs matrix with entries t_i^(k+1)
+    std::vector<double> q(num_nodes * num_coeffs);
+    std::vector<double> r(num_coeffs * num_coeffs, 0.0);
+    for (size_type i = 0; i < num_nodes; ++i) {
+        const auto t = (1.0 + lower) / 2 +
+                       (1.0 - lower) / 2 *
+                           std::cos(pi * (2 * i + 1) / (2 * num_nodes));
+        auto power = t;
+        for (size_type k = 0; k < num_coeffs; ++k) {
+            q[k * num_nodes + i] = power;
+            power *= t;
+        }
+    }
+    for (size_type k = 0; k < num_coeffs; ++k) {
+        const auto col_k = q.begin() + k * num_nodes;
+        for (size_type j = 0; j < k; ++j) {
+            const auto col_j = q.begin() + j * num_nodes;
+            double dot{};
+            for (size_type i = 0; i < num_nodes; ++i) {
+                dot += col_j[i] * col_k[i];
+            }
+            r[k * num_coeffs + j] = dot;
+            for (size_type i = 0; i < num_nodes; ++i) {
+                col_k[i] -= dot * col_j[i];
+            }
+        }
+        double norm{};
+        for (size_type i = 0; i < num_nodes; ++i) {
+            norm += col_k[i] * col_k[i];
+        }
+        norm = std::sqrt(norm);
+        r[k * num_coeffs + k] = norm;
+        for (size_type i = 0; i < num_nodes; ++i) {
+            col_k[i] /= norm;
+        }
+    }
+    // solve R c = Q^T 1
+    std::vector<double> coeffs(num_coeffs);
+    for (size_type k = 0; k < num_coeffs; ++k) {
+        double sum{};
+        for (size_type i = 0; i < num_nodes; ++i) {
+            sum += q[k * num_nodes + i];
+        }
+        coeffs[k] = sum;
+    }
+    for (auto k = static_cast<int64>(num_coeffs) - 1; k >= 0; --k) {
+        for (auto j = k + 1; j < static_cast<int64>(num_coeffs); ++j) {
+            coeffs[k] -= r[j * num_coeffs + k] * coeffs[j];
+        }
+        coeffs[k] /= r[k * num_coeffs + k];
+    }
+    return coeffs;
+}
+
+
+template <typename VectorType>
+VectorType* get_work_vector(std::unique_ptr<LinOp>& cache,
+                            const VectorType* b)
+{
+    auto vec = dynamic_cast<VectorType*>(cache.get());
+    if (!vec || vec->get_executor() != b->get_executor() ||
+        gko::detail::get_local(vec)->get_size() !=
+            gko::detail::get_local(b)->get_size()) {
+        cache = gko::detail::create_with_config_of(b);
+        vec = static_cast<VectorType*>(cache.get());
+    }
+    return vec;
+}
+
+
+}  // anonymous namespace
+}  // namespace polynomial
+
+
+template <typename ValueType>
+void Polynomial<ValueType>::generate()
+{
+    GKO_ASSERT_IS_SQUARE_MATRIX(system_matrix_);
+    max_eigenvalue_ = parameters_.max_eigenvalue;
+    if (max_eigenvalue_ <= 0.0) {
+        max_eigenvalue_ = 1.1 * this->estimate_max_eigenvalue();
+    }
+    min_eigenvalue_ = parameters_.min_eigenvalue;
+    if (min_eigenvalue_ <= 0.0) {
+        min_eigenvalue_ = max_eigenvalue_ / parameters_.eigenvalue_ratio;
+    }
+    if (!(min_eigenvalue_ > 0.0 && min_eigenvalue_ < max_eigenvalue_)) {
+        GKO_UNSUPPORTED_MATRIX_PROPERTY(
+            "the spectral bounds need to satisfy 0 < min_eigenvalue < "
+            "max_eigenvalue");
+    }
+    if (parameters_.kind == polynomial::kind::least_squares) {
+        coefficients_ = polynomial::compute_least_squares_coefficients(
+            parameters_.degree, min_eigenvalue_ / max_eigenvalue_);
+    }
+}
+
+
+template <typename ValueType>
+double Polynomial<ValueType>::estimate_max_eigenvalue() const
+{
+    using real_type = remove_complex<ValueType>;
+    auto exec = this->get_executor();
+    auto host_exec = exec->get_master();
+    auto v = gko::detail::create_vector<ValueType>(exec, system_matrix_.get(),
+                                                   1);
+    auto w = gko::detail::create_vector<ValueType>(exec, system_matrix_.get(),
+                                                   1);
+    auto norm = matrix::Dense<real_type>::create(exec, dim<2>{1, 1});
+    // a fixed pseudo-random start vector, which is very unlikely to be
+    // orthogonal to the dominant eigenvector
+    std::default_random_engine engine{};
+    std::uniform_real_distribution<real_type> dist(0.0, 1.0);
+    gko::detail::vector_dispatch<ValueType>(v.get(), [&](auto vec) {
+        auto local = gko::detail::get_local(vec);
+        auto host = matrix::Dense<ValueType>::create(host_exec,
+                                                     local->get_size());
+        for (size_type row = 0; row < host->get_size()[0]; ++row) {
+            host->at(row, 0) = static_cast<ValueType>(dist(engine));
+        }
+        local->copy_from(host.get());
+        vec->compute_norm2(norm.get());
+        vec->inv_scale(norm.get());
+    });
+    double estimate{};
+    for (size_type i = 0; i < parameters_.power_iterations; ++i) {
+        system_matrix_->apply(v.get(), w.get());
+        gko::detail::vector_dispatch<ValueType>(w.get(), [&](auto vec) {
+            vec->compute_norm2(norm.get());
+            vec->inv_scale(norm.get());
+        });
+        estimate = static_cast<double>(
+            exec->copy_val_to_host(norm->get_const_values()));
+        std::swap(v, w);
+    }
+    return estimate;
+}
+
+
+template <typename ValueType>
+template <typename VectorType>
+void Polynomial<ValueType>::apply_dense_impl(const VectorType* dense_b,
+                                             VectorType* dense_x) const
+{
+    using polynomial::get_work_vector;
+    auto exec = this->get_executor();
+    auto ad = get_work_vector(cache_.ad, dense_b);
+    auto local_b = gko::detail::get_local(dense_b);
+    auto local_x = gko::detail::get_local(dense_x);
+    auto local_ad = gko::detail::get_local(ad);
+    const auto degree = parameters_.degree;
+    const auto inv_max = 1.0 / max_eigenvalue_;
+    switch (parameters_.kind) {
+    case polynomial::kind::neumann: {
+        // x_{k+1} = (I - A / max) x_k + b / max
+        const auto omega = static_cast<ValueType>(inv_max);
+        exec->run(polynomial::make_horner_step(
+            zero<ValueType>(), local_b, zero<ValueType>(), omega, local_b,
+            local_x));
+        for (size_type k = 0; k < degree; ++k) {
+            system_matrix_->apply(dense_x, ad);
+            exec->run(polynomial::make_horner_step(-omega, local_ad,
+                                                   one<ValueType>(), omega,
+                                                   local_b, local_x));
+        }
+        break;
+    }
+    case polynomial::kind::least_squares: {
+        // Horner scheme for x = sum_k c_k (A / max)^k b / max
+        exec->run(polynomial::make_horner_step(
+            zero<ValueType>(), local_b, zero<ValueType>(),
+            static_cast<ValueType>(coefficients_[degree] * inv_max), local_b,
+            local_x));
+        for (auto k = degree; k > 0; --k) {
+            system_matrix_->apply(dense_x, ad);
+            exec->run(polynomial::make_horner_step(
+                static_cast<ValueType>(inv_max), local_ad, zero<ValueType>(),
+                static_cast<ValueType>(coefficients_[k - 1] * inv_max),
+                local_b, local_x));
+        }
+        break;
+    }
+    case polynomial::kind::chebyshev: {
+        // Chebyshev iteration with zero initial guess, see Saad, Alg. 12.1
+        auto r = get_work_vector(cache_.r, dense_b);
+        auto d = get_work_vector(cache_.d, dense_b);
+        auto local_r = gko::detail::get_local(r);
+        auto local_d = gko::detail::get_local(d);
+        const auto theta = (max_eigenvalue_ + min_eigenvalue_) / 2;
+        const auto delta = (max_eigenvalue_ - min_eigenvalue_) / 2;
+        const auto sigma = theta / delta;
+        auto rho = 1.0 / sigma;
+        exec->run(polynomial::make_chebyshev_initialize(
+            local_b, static_cast<ValueType>(1.0 / theta), local_r, local_d,
+            local_x));
+        for (size_type k = 0; k < degree; ++k) {
+            system_matrix_->apply(d, ad);
+            const auto rho_new = 1.0 / (2.0 * sigma - rho);
+            exec->run(polynomial::make_chebyshev_step(
+                local_ad, static_cast<ValueType>(rho_new * rho),
+                static_cast<ValueType>(2.0 * rho_new / delta), local_r,
+                local_d, local_x));
+            rho = rho_new;
+        }
+        break;
+    }
+    }
+}
+
+
+template <typename ValueType>
+void Polynomial<ValueType>::apply_impl(const LinOp* b, LinOp* x) const
+{
+    experimental::precision_dispatch_real_complex_distributed<ValueType>(
+        [this](auto dense_b, auto dense_x) {
+            this->apply_dense_impl(dense_b, dense_x);
+        },
+        b, x);
+}
+
+
+template <typename ValueType>
+void Polynomial<ValueType>::apply_impl(const LinOp* alpha, const LinOp* b,
+                                       const LinOp* beta, LinOp* x) const
+{
+    experimental::precision_dispatch_real_complex_distributed<ValueType>(
+        [this](auto dense_alpha, auto dense_b, auto dense_beta, auto dense_x) {
+            auto x_clone = dense_x->clone();
+            this->apply_dense_impl(dense_b, x_clone.get());
+            dense_x->scale(dense_beta);
+            dense_x->add_scaled(dense_alpha, x_clone.get());
+        },
+        alpha, b, beta, x);
+}
+
+
+#define GKO_DECLARE_POLYNOMIAL(ValueType) class Polynomial<ValueType>
+GKO_INSTANTIATE_FOR_EACH_VALUE_TYPE(GKO_DECLARE_POLYNOMIAL);
+
+
+}  // namespace preconditioner
+}  // namespace gko
@@ -0,0 +1,100 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2022, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+
+#ifndef GKO_CORE_PRECONDITIONER_POLYNOMIAL_KERNELS_HPP_
+#define GKO_CORE_PRECONDITIONER_POLYNOMIAL_KERNELS_HPP_
+
+
+#include <memory>
+
+
+#include <ginkgo/core/base/executor.hpp>
+#include <ginkgo/core/base/types.hpp>
+#include <ginkgo/core/matrix/dense.hpp>
+
+
+#include "core/base/kernel_declaration.hpp"
+
+
+namespace gko {
+namespace kernels {
+namespace polynomial {
+
+
+#define GKO_DECLARE_POLYNOMIAL_HORNER_STEP_KERNEL(ValueType)             \
+    void horner_step(std::shared_ptr<const DefaultExecutor> exec,        \
+                     ValueType alpha, const matrix::Dense<ValueType>* y, \
+                     ValueType beta, ValueType gamma,                    \
+                     const matrix::Dense<ValueType>* b,                  \
+                     matrix::Dense<ValueType>* x)
+
+#define GKO_DECLARE_POLYNOMIAL_CHEBYSHEV_INITIALIZE_KERNEL(ValueType)      \
+    void chebyshev_initialize(std::shared_ptr<const DefaultExecutor> exec, \
+                              const matrix::Dense<ValueType>* b,           \
+                              ValueType inv_theta,                         \
+                              matrix::Dense<ValueType>* r,                 \
+                              matrix::Dense<ValueType>* d,                 \
+                              matrix::Dense<ValueType>* x)
+
+#define GKO_DECLARE_POLYNOMIAL_CHEBYSHEV_STEP_KERNEL(ValueType)            \
+    void chebyshev_step(std::shared_ptr<const DefaultExecutor> exec,       \
+                        const matrix::Dense<ValueType>* ad, ValueType c_d, \
+                        ValueType c_r, matrix::Dense<ValueType>* r,        \
+                        matrix::Dense<ValueType>* d,                       \
+                        matrix::Dense<ValueType>* x)
+
+
+#define GKO_DECLARE_ALL_AS_TEMPLATES                               \
+    template <typename ValueType>                                  \
+    GKO_DECLARE_POLYNOMIAL_HORNER_STEP_KERNEL(ValueType);          \
+    template <typename ValueType>                                  \
+    GKO_DECLARE_POLYNOMIAL_CHEBYSHEV_INITIALIZE_KERNEL(ValueType); \
+    template <typename ValueType>                                  \
+    GKO_DECLARE_POLYNOMIAL_CHEBYSHEV_STEP_KERNEL(ValueType)
+
+
+}  // namespace polynomial
+
+
+GKO_DECLARE_FOR_ALL_EXECUTOR_NAMESPACES(polynomial,
+                                        GKO_DECLARE_ALL_AS_TEMPLATES);
+
+
+#undef GKO_DECLARE_ALL_AS_TEMPLATES
+
+
+}  // namespace kernels
+}  // namespace gko
+
+
+#endif  // GKO_CORE_PRECONDITIONER_POLYNOMIAL_KERNELS_HPP_
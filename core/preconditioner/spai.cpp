@@ -0,0 +1,133 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2022, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+
+#include <ginkgo/core/preconditioner/spai.hpp>
+
+
+#include <algorithm>
+#include <memory>
+
+
+#include <ginkgo/core/base/array.hpp>
+#include <ginkgo/core/base/exception_helpers.hpp>
+#include <ginkgo/core/base/executor.hpp>
+#include <ginkgo/core/base/utils.hpp>
+#include <ginkgo/core/matrix/csr.hpp>
+#include <ginkgo/core/matrix/ell.hpp>
+
+
+#include "core/base/utils.hpp"
+#include "core/preconditioner/spai_kernels.hpp"
+
+
+namespace gko {
+namespace preconditioner {
+namespace spai {
+namespace {
+
+
+GKO_REGISTER_OPERATION(generate_general, spai::generate_general);
+GKO_REGISTER_OPERATION(generate_spd, spai::generate_spd);
+
+
+}  // anonymous namespace
+}  // namespace spai
+
+
+template <spai_type SpaiType, typename ValueType, typename IndexType>
+void Spai<SpaiType, ValueType, IndexType>::generate_inverse(
+    std::shared_ptr<const LinOp> system_matrix)
+{
+    using Ell = matrix::Ell<ValueType, IndexType>;
+    GKO_ASSERT_IS_SQUARE_MATRIX(system_matrix);
+    if (parameters_.adaptive_steps < 0) {
+        GKO_NOT_SUPPORTED(parameters_.adaptive_steps);
+    }
+    auto exec = this->get_executor();
+    auto host_exec = exec->get_master();
+    auto mtx = convert_to_with_sorting<Csr>(exec, system_matrix,
+                                            parameters_.skip_sorting);
+    const auto num_rows = mtx->get_size()[0];
+
+    // the initial pattern is at most the row of A plus the diagonal entry,
+    // and every adaptive step adds at most entries_per_step entries
+    array<IndexType> host_row_ptrs{host_exec, num_rows + 1};
+    host_exec->copy_from(exec.get(), num_rows + 1, mtx->get_const_row_ptrs(),
+                         host_row_ptrs.get_data());
+    size_type max_initial_nnz{};
+    for (size_type row = 0; row < num_rows; ++row) {
+        max_initial_nnz = std::max(
+            max_initial_nnz,
+            static_cast<size_type>(host_row_ptrs.get_const_data()[row + 1] -
+                                   host_row_ptrs.get_const_data()[row]));
+    }
+    const auto max_row_nnz = std::min(
+        num_rows, max_initial_nnz + 1 +
+                      static_cast<size_type>(parameters_.adaptive_steps) *
+                          parameters_.entries_per_step);
+
+    auto result = Ell::create(exec, mtx->get_size(), max_row_nnz);
+    const auto tolerance =
+        static_cast<remove_complex<ValueType>>(parameters_.tolerance);
+    if (SpaiType == spai_type::general) {
+        auto trans = as<Csr>(mtx->transpose());
+        exec->run(spai::make_generate_general(
+            mtx.get(), trans.get(), parameters_.adaptive_steps,
+            parameters_.entries_per_step, tolerance, result.get()));
+    } else {
+        exec->run(spai::make_generate_spd(
+            mtx.get(), parameters_.adaptive_steps,
+            parameters_.entries_per_step, tolerance, result.get()));
+    }
+    auto inverse = share(Csr::create(exec));
+    result->convert_to(inverse.get());
+    if (SpaiType == spai_type::spd) {
+        auto inverse_transp = share(inverse->conj_transpose());
+        approximate_inverse_ = Comp::create(inverse_transp, inverse);
+    } else {
+        approximate_inverse_ = inverse;
+    }
+}
+
+
+#define GKO_DECLARE_GENERAL_SPAI(ValueType, IndexType) \
+    class Spai<spai_type::general, ValueType, IndexType>
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(GKO_DECLARE_GENERAL_SPAI);
+
+#define GKO_DECLARE_SPD_SPAI(ValueType, IndexType) \
+    class Spai<spai_type::spd, ValueType, IndexType>
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(GKO_DECLARE_SPD_SPAI);
+
+
+}  // namespace preconditioner
+}  // namespace gko
@@ -0,0 +1,95 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2022, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+
+#ifndef GKO_CORE_PRECONDITIONER_SPAI_KERNELS_HPP_
+#define GKO_CORE_PRECONDITIONER_SPAI_KERNELS_HPP_
+
+
+#include <ginkgo/core/preconditioner/spai.hpp>
+
+
+#include <memory>
+
+
+#include <ginkgo/core/base/executor.hpp>
+#include <ginkgo/core/base/math.hpp>
+#include <ginkgo/core/base/types.hpp>
+#include <ginkgo/core/matrix/csr.hpp>
+#include <ginkgo/core/matrix/ell.hpp>
+
+
+#include "core/base/kernel_declaration.hpp"
+
+
+namespace gko {
+namespace kernels {
+namespace spai {
+
+
+#define GKO_DECLARE_SPAI_GENERATE_GENERAL_KERNEL(ValueType, IndexType)    \
+    void generate_general(std::shared_ptr<const DefaultExecutor> exec,    \
+                          const matrix::Csr<ValueType, IndexType>* mtx,   \
+                          const matrix::Csr<ValueType, IndexType>* trans, \
+                          int num_steps, size_type entries_per_step,      \
+                          remove_complex<ValueType> tolerance,            \
+                          matrix::Ell<ValueType, IndexType>* inverse)
+
+#define GKO_DECLARE_SPAI_GENERATE_SPD_KERNEL(ValueType, IndexType)  \
+    void generate_spd(std::shared_ptr<const DefaultExecutor> exec,  \
+                      const matrix::Csr<ValueType, IndexType>* mtx, \
+                      int num_steps, size_type entries_per_step,    \
+                      remove_complex<ValueType> tolerance,          \
+                      matrix::Ell<ValueType, IndexType>* factor)
+
+
+#define GKO_DECLARE_ALL_AS_TEMPLATES                                \
+    template <typename ValueType, typename IndexType>               \
+    GKO_DECLARE_SPAI_GENERATE_GENERAL_KERNEL(ValueType, IndexType); \
+    template <typename ValueType, typename IndexType>               \
+    GKO_DECLARE_SPAI_GENERATE_SPD_KERNEL(ValueType, IndexType)
+
+
+}  // namespace spai
+
+
+GKO_DECLARE_FOR_ALL_EXECUTOR_NAMESPACES(spai, GKO_DECLARE_ALL_AS_TEMPLATES);
+
+
+#undef GKO_DECLARE_ALL_AS_TEMPLATES
+
+
+}  // namespace kernels
+}  // namespace gko
+
+
+#endif  // GKO_CORE_PRECONDITIONER_SPAI_KERNELS_HPP_
@@ -0,0 +1,511 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2022, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+
+#ifndef GKO_CORE_PRECONDITIONER_SPAI_UTILS_HPP_
+#define GKO_CORE_PRECONDITIONER_SPAI_UTILS_HPP_
+
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+
+#include <ginkgo/core/base/math.hpp>
+#include <ginkgo/core/base/types.hpp>
+#include <ginkgo/core/matrix/csr.hpp>
+#include <ginkgo/core/matrix/ell.hpp>
+
+
+namespace gko {
+namespace preconditioner {
+namespace spai {
+
+
+/**
+ * @internal
+ *
+ * Work space for the generation of a single row of an adaptive SPAI. It is
+ * allocated once per thread and reset after each row, so generating a row
+ * only costs time proportional to the size of its local problem.
+ */
+template <typename ValueType, typename IndexType>
+struct row_workspace {
+    explicit row_workspace(size_type size)
+        : row_map(size, invalid_index<IndexType>()),
+          col_map(size, invalid_index<IndexType>()),
+          accumulator(size, zero<ValueType>()),
+          touched(size, false)
+    {}
+
+    // global index -> position in rows, or invalid_index if not present
+    std::vector<IndexType> row_map;
+    // global index -> position in cols, or invalid_index if not present
+    std::vector<IndexType> col_map;
+    std::vector<ValueType> accumulator;
+    std::vector<bool> touched;
+    std::vector<IndexType> rows;
+    std::vector<IndexType> cols;
+    std::vector<IndexType> touched_list;
+    std::vector<ValueType> system;
+    std::vector<ValueType> factor;
+    std::vector<ValueType> rhs;
+    std::vector<ValueType> solution;
+    std::vector<std::pair<remove_complex<ValueType>, IndexType>> candidates;
+};
+
+
+/**
+ * @internal
+ *
+ * Solves the least-squares problem min ||S x - rhs|| for a dense column-major
+ * num_rows x num_cols matrix S with num_rows >= num_cols using a QR
+ * decomposition based on modified Gram-Schmidt. S is overwritten by Q.
+ * Linearly dependent columns get a zero solution component.
+ */
+template <typename ValueType>
+void solve_least_squares(size_type num_rows, size_type num_cols,
+                         ValueType* mtx, ValueType* r_factor,
+                         const ValueType* rhs, ValueType* solution)
+{
+    for (size_type k = 0; k < num_cols; ++k) {
+        const auto col_k = mtx + k * num_rows;
+        for (size_type j = 0; j < k; ++j) {
+            const auto col_j = mtx + j * num_rows;
+            auto dot = zero<ValueType>();
+            for (size_type i = 0; i < num_rows; ++i) {
+                dot += conj(col_j[i]) * col_k[i];
+            }
+            r_factor[k * num_cols + j] = dot;
+            for (size_type i = 0; i < num_rows; ++i) {
+                col_k[i] -= dot * col_j[i];
+            }
+        }
+        remove_complex<ValueType> norm{};
+        for (size_type i = 0; i < num_rows; ++i) {
+            norm += squared_norm(col_k[i]);
+        }
+        norm = sqrt(norm);
+        if (norm > zero<remove_complex<ValueType>>()) {
+            for (size_type i = 0; i < num_rows; ++i) {
+                col_k[i] /= norm;
+            }
+            r_factor[k * num_cols + k] = norm;
+        } else {
+            r_factor[k * num_cols + k] = one<ValueType>();
+        }
+    }
+    for (size_type k = 0; k < num_cols; ++k) {
+        auto dot = zero<ValueType>();
+        for (size_type i = 0; i < num_rows; ++i) {
+            dot += conj(mtx[k * num_rows + i]) * rhs[i];
+        }
+        solution[k] = dot;
+    }
+    for (auto k = static_cast<int64>(num_cols) - 1; k >= 0; --k) {
+        for (auto j = k + 1; j < static_cast<int64>(num_cols); ++j) {
+            solution[k] -= r_factor[j * num_cols + k] * solution[j];
+        }
+        solution[k] /= r_factor[k * num_cols + k];
+    }
+}
+
+
+/**
+ * @internal
+ *
+ * Solves the Hermitian positive definite system A x = rhs for a dense
+ * column-major size x size matrix A using a Cholesky decomposition, which
+ * overwrites the lower triangle of A.
+ *
+ * @return  false if A is not numerically positive definite
+ */
+template <typename ValueType>
+bool solve_hpd(size_type size, ValueType* mtx, const ValueType* rhs,
+               ValueType* solution)
+{
+    for (size_type k = 0; k < size; ++k) {
+        auto diag = real(mtx[k * size + k]);
+        for (size_type j = 0; j < k; ++j) {
+            diag -= squared_norm(mtx[j * size + k]);
+        }
+        if (!(diag > zero<remove_complex<ValueType>>())) {
+            return false;
+        }
+        diag = sqrt(diag);
+        mtx[k * size + k] = diag;
+        for (size_type i = k + 1; i < size; ++i) {
+            auto value = mtx[k * size + i];
+            for (size_type j = 0; j < k; ++j) {
+                value -= mtx[j * size + i] * conj(mtx[j * size + k]);
+            }
+            mtx[k * size + i] = value / diag;
+        }
+    }
+    // forward substitution with L
+    for (size_type i = 0; i < size; ++i) {
+        auto value = rhs[i];
+        for (size_type j = 0; j < i; ++j) {
+            value -= mtx[j * size + i] * solution[j];
+        }
+        solution[i] = value / mtx[i * size + i];
+    }
+    // backward substitution with L^H
+    for (auto i = static_cast<int64>(size) - 1; i >= 0; --i) {
+        auto value = solution[i];
+        for (auto j = i + 1; j < static_cast<int64>(size); ++j) {
+            value -= conj(mtx[i * size + j]) * solution[j];
+        }
+        solution[i] = value / mtx[i * size + i];
+    }
+    return true;
+}
+
+
+/**
+ * @internal
+ *
+ * Keeps the `count` candidates with the largest reduction at the beginning
+ * of the candidate list and returns how many of them are valid.
+ */
+template <typename ValueType, typename IndexType>
+size_type select_candidates(
+    std::vector<std::pair<remove_complex<ValueType>, IndexType>>& candidates,
+    size_type count)
+{
+    count = std::min(count, candidates.size());
+    std::partial_sort(
+        candidates.begin(), candidates.begin() + count, candidates.end(),
+        [](const std::pair<remove_complex<ValueType>, IndexType>& a,
+           const std::pair<remove_complex<ValueType>, IndexType>& b) {
+            return a.first > b.first ||
+                   (a.first == b.first && a.second < b.second);
+        });
+    while (count > 0 && !(candidates[count - 1].first >
+                          zero<remove_complex<ValueType>>())) {
+        count--;
+    }
+    return count;
+}
+
+
+/**
+ * @internal
+ *
+ * Generates row `row` of the adaptive SPAI M with M A ~ I and stores it in
+ * the corresponding row of `inverse`.
+ *
+ * @param mtx  the sorted system matrix A
+ * @param trans  the transpose of A, used to access the columns of A
+ */
+template <typename ValueType, typename IndexType>
+void generate_general_row(IndexType row,
+                          const matrix::Csr<ValueType, IndexType>* mtx,
+                          const matrix::Csr<ValueType, IndexType>* trans,
+                          int num_steps, size_type entries_per_step,
+                          remove_complex<ValueType> tolerance,
+                          row_workspace<ValueType, IndexType>& ws,
+                          matrix::Ell<ValueType, IndexType>* inverse)
+{
+    using real_type = remove_complex<ValueType>;
+    const auto row_ptrs = mtx->get_const_row_ptrs();
+    const auto col_idxs = mtx->get_const_col_idxs();
+    const auto vals = mtx->get_const_values();
+    const auto t_row_ptrs = trans->get_const_row_ptrs();
+    const auto t_col_idxs = trans->get_const_col_idxs();
+    const auto max_row_nnz = inverse->get_num_stored_elements_per_row();
+    auto& cols = ws.cols;
+    auto& rows = ws.rows;
+    cols.assign(col_idxs + row_ptrs[row], col_idxs + row_ptrs[row + 1]);
+    if (!std::binary_search(cols.begin(), cols.end(), row)) {
+        cols.insert(std::lower_bound(cols.begin(), cols.end(), row), row);
+    }
+    for (int step = 0;; ++step) {
+        // collect the rows I of the least-squares problem
+        rows.clear();
+        for (size_type p = 0; p < cols.size(); ++p) {
+            const auto col = cols[p];
+            ws.col_map[col] = static_cast<IndexType>(p);
+            for (auto nz = row_ptrs[col]; nz < row_ptrs[col + 1]; ++nz) {
+                const auto l = col_idxs[nz];
+                if (ws.row_map[l] == invalid_index<IndexType>()) {
+                    ws.row_map[l] = static_cast<IndexType>(rows.size());
+                    rows.push_back(l);
+                }
+            }
+        }
+        if (ws.row_map[row] == invalid_index<IndexType>()) {
+            ws.row_map[row] = static_cast<IndexType>(rows.size());
+            rows.push_back(row);
+        }
+        const auto num_rows = rows.size();
+        const auto num_cols = cols.size();
+        // S(l, p) = A(cols[p], l), the rhs is the unit vector e_row
+        ws.system.assign(num_rows * num_cols, zero<ValueType>());
+        ws.factor.assign(num_cols * num_cols, zero<ValueType>());
+        ws.rhs.assign(num_rows, zero<ValueType>());
+        ws.solution.assign(num_cols, zero<ValueType>());
+        for (size_type p = 0; p < num_cols; ++p) {
+            const auto col = cols[p];
+            for (auto nz = row_ptrs[col]; nz < row_ptrs[col + 1]; ++nz) {
+                ws.system[p * num_rows + ws.row_map[col_idxs[nz]]] = vals[nz];
+            }
+        }
+        ws.rhs[ws.row_map[row]] = one<ValueType>();
+        solve_least_squares(num_rows, num_cols, ws.system.data(),
+                            ws.factor.data(), ws.rhs.data(),
+                            ws.solution.data());
+        // residual r = S x - e_row on I, reusing the rhs storage
+        for (auto& value : ws.rhs) {
+            value = -value;
+        }
+        for (size_type p = 0; p < num_cols; ++p) {
+            const auto col = cols[p];
+            for (auto nz = row_ptrs[col]; nz < row_ptrs[col + 1]; ++nz) {
+                ws.rhs[ws.row_map[col_idxs[nz]]] += ws.solution[p] * vals[nz];
+            }
+        }
+        real_type res_norm{};
+        for (const auto& value : ws.rhs) {
+            res_norm += squared_norm(value);
+        }
+        auto done = step >= num_steps || num_cols >= max_row_nnz ||
+                    sqrt(res_norm) <= tolerance;
+        if (!done) {
+            // rank the new columns k by the reduction |a_k^H r|^2 / |a_k|^2
+            ws.candidates.clear();
+            for (size_type li = 0; li < num_rows; ++li) {
+                if (is_zero(ws.rhs[li])) {
+                    continue;
+                }
+                const auto l = rows[li];
+                for (auto nz = t_row_ptrs[l]; nz < t_row_ptrs[l + 1]; ++nz) {
+                    const auto k = t_col_idxs[nz];
+                    if (ws.col_map[k] != invalid_index<IndexType>() ||
+                        ws.touched[k]) {
+                        continue;
+                    }
+                    ws.touched[k] = true;
+                    ws.touched_list.push_back(k);
+                    auto dot = zero<ValueType>();
+                    real_type norm{};
+                    for (auto k_nz = row_ptrs[k]; k_nz < row_ptrs[k + 1];
+                         ++k_nz) {
+                        const auto pos = ws.row_map[col_idxs[k_nz]];
+                        if (pos != invalid_index<IndexType>()) {
+                            dot += conj(vals[k_nz]) * ws.rhs[pos];
+                        }
+                        norm += squared_norm(vals[k_nz]);
+                    }
+                    if (norm > zero<real_type>()) {
+                        ws.candidates.emplace_back(squared_norm(dot) / norm,
+                                                   k);
+                    }
+                }
+            }
+            for (auto k : ws.touched_list) {
+                ws.touched[k] = false;
+            }
+            ws.touched_list.clear();
+            const auto count = select_candidates<ValueType>(
+                ws.candidates,
+                std::min(entries_per_step, max_row_nnz - num_cols));
+            for (size_type c = 0; c < count; ++c) {
+                cols.push_back(ws.candidates[c].second);
+            }
+            done = count == 0;
+        }
+        for (auto l : rows) {
+            ws.row_map[l] = invalid_index<IndexType>();
+        }
+        for (auto col : cols) {
+            ws.col_map[col] = invalid_index<IndexType>();
+        }
+        if (done) {
+            break;
+        }
+        std::sort(cols.begin(), cols.end());
+    }
+    for (size_type p = 0; p < max_row_nnz; ++p) {
+        if (p < ws.solution.size()) {
+            inverse->col_at(row, p) = cols[p];
+            inverse->val_at(row, p) = ws.solution[p];
+        } else {
+            inverse->col_at(row, p) = invalid_index<IndexType>();
+            inverse->val_at(row, p) = zero<ValueType>();
+        }
+    }
+}
+
+
+/**
+ * @internal
+ *
+ * Generates row `row` of the adaptive FSAI factor G with G A G^H ~ I and
+ * stores it in the corresponding row of `factor`.
+ *
+ * @param mtx  the sorted Hermitian positive definite system matrix A
+ * @param diag  the diagonal of A
+ */
+template <typename ValueType, typename IndexType>
+void generate_spd_row(IndexType row,
+                      const matrix::Csr<ValueType, IndexType>* mtx,
+                      const ValueType* diag, int num_steps,
+                      size_type entries_per_step,
+                      remove_complex<ValueType> tolerance,
+                      row_workspace<ValueType, IndexType>& ws,
+                      matrix::Ell<ValueType, IndexType>* factor)
+{
+    using real_type = remove_complex<ValueType>;
+    const auto row_ptrs = mtx->get_const_row_ptrs();
+    const auto col_idxs = mtx->get_const_col_idxs();
+    const auto vals = mtx->get_const_values();
+    const auto max_row_nnz = factor->get_num_stored_elements_per_row();
+    auto& cols = ws.cols;
+    cols.clear();
+    for (auto nz = row_ptrs[row]; nz < row_ptrs[row + 1]; ++nz) {
+        if (col_idxs[nz] < row) {
+            cols.push_back(col_idxs[nz]);
+        }
+    }
+    cols.push_back(row);
+    bool success{};
+    for (int step = 0;; ++step) {
+        const auto size = cols.size();
+        for (size_type p = 0; p < size; ++p) {
+            ws.col_map[cols[p]] = static_cast<IndexType>(p);
+        }
+        // A(J, J) and the unit vector belonging to the diagonal entry, which
+        // is the last one, since all other entries are left of it
+        ws.system.assign(size * size, zero<ValueType>());
+        ws.rhs.assign(size, zero<ValueType>());
+        ws.solution.assign(size, zero<ValueType>());
+        for (size_type p = 0; p < size; ++p) {
+            const auto col = cols[p];
+            for (auto nz = row_ptrs[col]; nz < row_ptrs[col + 1]; ++nz) {
+                const auto pos = ws.col_map[col_idxs[nz]];
+                if (pos != invalid_index<IndexType>()) {
+                    ws.system[pos * size + p] = vals[nz];
+                }
+            }
+        }
+        ws.rhs[size - 1] = one<ValueType>();
+        success = solve_hpd(size, ws.system.data(), ws.rhs.data(),
+                            ws.solution.data()) &&
+                  real(ws.solution[size - 1]) > zero<real_type>();
+        auto done = !success || step >= num_steps || size >= max_row_nnz;
+        if (!done) {
+            // the Kaporin functional of the normalized row g = y / y_row is
+            // 1 / y_row, adding entry k reduces it by |(A g)_k|^2 / A_kk
+            const auto inv_diag = one<ValueType>() / ws.solution[size - 1];
+            ws.candidates.clear();
+            for (size_type p = 0; p < size - 1; ++p) {
+                const auto col = cols[p];
+                const auto g = ws.solution[p] * inv_diag;
+                for (auto nz = row_ptrs[col]; nz < row_ptrs[col + 1]; ++nz) {
+                    const auto k = col_idxs[nz];
+                    if (k >= row ||
+                        ws.col_map[k] != invalid_index<IndexType>()) {
+                        continue;
+                    }
+                    if (!ws.touched[k]) {
+                        ws.touched[k] = true;
+                        ws.touched_list.push_back(k);
+                    }
+                    ws.accumulator[k] += conj(vals[nz]) * g;
+                }
+            }
+            // the diagonal entry of g is one
+            for (auto nz = row_ptrs[row]; nz < row_ptrs[row + 1]; ++nz) {
+                const auto k = col_idxs[nz];
+                if (k >= row || ws.col_map[k] != invalid_index<IndexType>()) {
+                    continue;
+                }
+                if (!ws.touched[k]) {
+                    ws.touched[k] = true;
+                    ws.touched_list.push_back(k);
+                }
+                ws.accumulator[k] += conj(vals[nz]);
+            }
+            const auto inv_functional = real(ws.solution[size - 1]);
+            for (auto k : ws.touched_list) {
+                ws.candidates.emplace_back(squared_norm(ws.accumulator[k]) /
+                                               abs(diag[k]) * inv_functional,
+                                           k);
+                ws.accumulator[k] = zero<ValueType>();
+                ws.touched[k] = false;
+            }
+            ws.touched_list.clear();
+            const auto count = select_candidates<ValueType>(
+                ws.candidates,
+                std::min(entries_per_step, max_row_nnz - size));
+            done = count == 0 || ws.candidates[0].first <= tolerance;
+            if (!done) {
+                for (size_type c = 0; c < count; ++c) {
+                    cols.push_back(ws.candidates[c].second);
+                }
+            }
+        }
+        for (auto col : cols) {
+            ws.col_map[col] = invalid_index<IndexType>();
+        }
+        if (done) {
+            break;
+        }
+        std::sort(cols.begin(), cols.end());
+    }
+    if (!success) {
+        // fall back to the diagonal scaling if the local system is not
+        // positive definite
+        cols.assign(1, row);
+        ws.solution.assign(1, one<ValueType>() / diag[row]);
+    }
+    const remove_complex<ValueType> scale =
+        one<remove_complex<ValueType>>() / sqrt(abs(ws.solution.back()));
+    for (size_type p = 0; p < max_row_nnz; ++p) {
+        if (p < cols.size()) {
+            factor->col_at(row, p) = cols[p];
+            factor->val_at(row, p) = conj(ws.solution[p]) * scale;
+        } else {
+            factor->col_at(row, p) = invalid_index<IndexType>();
+            factor->val_at(row, p) = zero<ValueType>();
+        }
+    }
+}
+
+
+}  // namespace spai
+}  // namespace preconditioner
+}  // namespace gko
+
+
+#endif  // GKO_CORE_PRECONDITIONER_SPAI_UTILS_HPP_
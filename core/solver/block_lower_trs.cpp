@@ -0,0 +1,194 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2022, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#include <ginkgo/core/solver/block_triangular.hpp>
+
+
+#include <ginkgo/core/base/array.hpp>
+#include <ginkgo/core/base/exception_helpers.hpp>
+#include <ginkgo/core/base/executor.hpp>
+#include <ginkgo/core/base/polymorphic_object.hpp>
+#include <ginkgo/core/base/precision_dispatch.hpp>
+#include <ginkgo/core/base/types.hpp>
+#include <ginkgo/core/base/utils.hpp>
+#include <ginkgo/core/matrix/dense.hpp>
+#include <ginkgo/core/matrix/fbcsr.hpp>
+
+
+#include "core/solver/block_trs_kernels.hpp"
+
+
+namespace gko {
+namespace solver {
+namespace block_lower_trs {
+namespace {
+
+
+GKO_REGISTER_OPERATION(invert_diagonal, block_trs::invert_diagonal);
+GKO_REGISTER_OPERATION(solve, block_trs::solve_lower);
+
+
+}  // anonymous namespace
+}  // namespace block_lower_trs
+
+
+template <typename ValueType, typename IndexType>
+BlockLowerTrs<ValueType, IndexType>::BlockLowerTrs(const BlockLowerTrs& other)
+    : EnableLinOp<BlockLowerTrs>(other.get_executor())
+{
+    *this = other;
+}
+
+
+template <typename ValueType, typename IndexType>
+BlockLowerTrs<ValueType, IndexType>::BlockLowerTrs(BlockLowerTrs&& other)
+    : EnableLinOp<BlockLowerTrs>(other.get_executor())
+{
+    *this = std::move(other);
+}
+
+
+template <typename ValueType, typename IndexType>
+BlockLowerTrs<ValueType, IndexType>&
+BlockLowerTrs<ValueType, IndexType>::operator=(const BlockLowerTrs& other)
+{
+    if (this != &other) {
+        EnableLinOp<BlockLowerTrs>::operator=(other);
+        EnableSolverBase<BlockLowerTrs, FbcsrMatrix>::operator=(other);
+        this->parameters_ = other.parameters_;
+        this->generate();
+    }
+    return *this;
+}
+
+
+template <typename ValueType, typename IndexType>
+BlockLowerTrs<ValueType, IndexType>&
+BlockLowerTrs<ValueType, IndexType>::operator=(BlockLowerTrs&& other)
+{
+    if (this != &other) {
+        EnableLinOp<BlockLowerTrs>::operator=(std::move(other));
+        EnableSolverBase<BlockLowerTrs, FbcsrMatrix>::operator=(
+            std::move(other));
+        this->parameters_ = std::exchange(other.parameters_, parameters_type{});
+        if (this->get_executor() == other.get_executor()) {
+            this->diag_inv_ = std::move(other.diag_inv_);
+        } else {
+            this->generate();
+        }
+    }
+    return *this;
+}
+
+
+template <typename ValueType, typename IndexType>
+std::unique_ptr<LinOp> BlockLowerTrs<ValueType, IndexType>::transpose() const
+{
+    return transposed_type::build()
+        .with_unit_diagonal(this->parameters_.unit_diagonal)
+        .on(this->get_executor())
+        ->generate(share(this->get_system_matrix()->transpose()));
+}
+
+
+template <typename ValueType, typename IndexType>
+std::unique_ptr<LinOp> BlockLowerTrs<ValueType, IndexType>::conj_transpose()
+    const
+{
+    return transposed_type::build()
+        .with_unit_diagonal(this->parameters_.unit_diagonal)
+        .on(this->get_executor())
+        ->generate(share(this->get_system_matrix()->conj_transpose()));
+}
+
+
+template <typename ValueType, typename IndexType>
+void BlockLowerTrs<ValueType, IndexType>::generate()
+{
+    const auto exec = this->get_executor();
+    const auto mtx = this->get_system_matrix();
+    if (mtx && !this->get_parameters().unit_diagonal) {
+        const auto bs = static_cast<size_type>(mtx->get_block_size());
+        diag_inv_ = array<ValueType>{
+            exec, static_cast<size_type>(mtx->get_num_block_rows()) * bs * bs};
+        exec->run(block_lower_trs::make_invert_diagonal(mtx.get(),
+                                                         diag_inv_.get_data()));
+    } else {
+        diag_inv_ = array<ValueType>{exec};
+    }
+}
+
+
+template <typename ValueType, typename IndexType>
+void BlockLowerTrs<ValueType, IndexType>::apply_impl(const LinOp* b,
+                                                     LinOp* x) const
+{
+    if (!this->get_system_matrix()) {
+        return;
+    }
+    precision_dispatch_real_complex<ValueType>(
+        [this](auto dense_b, auto dense_x) {
+            this->get_executor()->run(block_lower_trs::make_solve(
+                lend(this->get_system_matrix()), diag_inv_.get_const_data(),
+                this->get_parameters().unit_diagonal, dense_b, dense_x));
+        },
+        b, x);
+}
+
+
+template <typename ValueType, typename IndexType>
+void BlockLowerTrs<ValueType, IndexType>::apply_impl(const LinOp* alpha,
+                                                     const LinOp* b,
+                                                     const LinOp* beta,
+                                                     LinOp* x) const
+{
+    if (!this->get_system_matrix()) {
+        return;
+    }
+    precision_dispatch_real_complex<ValueType>(
+        [this](auto dense_alpha, auto dense_b, auto dense_beta, auto dense_x) {
+            auto x_clone = dense_x->clone();
+            this->apply_impl(dense_b, x_clone.get());
+            dense_x->scale(dense_beta);
+            dense_x->add_scaled(dense_alpha, x_clone.get());
+        },
+        alpha, b, beta, x);
+}
+
+
+#define GKO_DECLARE_BLOCK_LOWER_TRS(_vtype, _itype) \
+    class BlockLowerTrs<_vtype, _itype>
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(GKO_DECLARE_BLOCK_LOWER_TRS);
+
+
+}  // namespace solver
+}  // namespace gko
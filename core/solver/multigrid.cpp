@@ -43,6 +43,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ginkgo/core/base/math.hpp>
 #include <ginkgo/core/base/utils.hpp>
 #include <ginkgo/core/base/utils_helper.hpp>
+#include <ginkgo/core/distributed/matrix.hpp>
+#include <ginkgo/core/distributed/vector.hpp>
 #include <ginkgo/core/matrix/dense.hpp>
 #include <ginkgo/core/solver/ir.hpp>
 #include <ginkgo/core/stop/iteration.hpp>
@@ -50,6 +52,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "core/base/dispatch_helper.hpp"
 #include "core/components/fill_array_kernels.hpp"
+#include "core/distributed/helpers.hpp"
 #include "core/solver/ir_kernels.hpp"
 #include "core/solver/multigrid_kernels.hpp"
 #include "core/solver/solver_base.hpp"
@@ -237,12 +240,12 @@ struct MultigridState {
      *
      * @param level  the current level index
      * @param cycle  the multigrid cycle
-     * @param current_nrows  the number of rows of current fine matrix
-     * @param next_nrows  the number of rows of next coarse matrix
+     * @param fine_op  the current fine matrix
+     * @param coarse_op  the next coarse matrix
      */
     template <typename ValueType>
     void allocate_memory(int level, multigrid::cycle cycle,
-                         size_type current_nrows, size_type next_nrows);
+                         const LinOp* fine_op, const LinOp* coarse_op);
 
     /**
      * run the cycle of the level
@@ -292,7 +295,6 @@ void MultigridState::generate(const LinOp* system_matrix_in,
     system_matrix = system_matrix_in;
     multigrid = multigrid_in;
     nrhs = nrhs_in;
-    auto current_nrows = system_matrix->get_size()[0];
     auto mg_level_list = multigrid->get_mg_level_list();
     auto list_size = mg_level_list.size();
     auto cycle = multigrid->get_cycle();
@@ -304,50 +306,48 @@ void MultigridState::generate(const LinOp* system_matrix_in,
     clear_and_reserve(neg_one_list, list_size);
     // Allocate memory first such that reusing allocation in each iter.
     for (int i = 0; i < mg_level_list.size(); i++) {
-        auto next_nrows = mg_level_list.at(i)->get_coarse_op()->get_size()[0];
         auto mg_level = mg_level_list.at(i);
 
         run<gko::multigrid::EnableMultigridLevel, float, double,
             std::complex<float>, std::complex<double>>(
             mg_level,
-            [&, this](auto mg_level, auto i, auto cycle, auto current_nrows,
-                      auto next_nrows) {
+            [&, this](auto mg_level, auto i, auto cycle) {
                 using value_type =
                     typename std::decay_t<decltype(*mg_level)>::value_type;
-                using vec = matrix::Dense<value_type>;
-                this->allocate_memory<value_type>(i, cycle, current_nrows,
-                                                  next_nrows);
-                auto exec = as<LinOp>(multigrid->get_mg_level_list().at(i))
-                                ->get_executor();
+                this->allocate_memory<value_type>(
+                    i, cycle, mg_level->get_fine_op().get(),
+                    mg_level->get_coarse_op().get());
             },
-            i, cycle, current_nrows, next_nrows);
-
-        current_nrows = next_nrows;
+            i, cycle);
     }
 }
 
 
 template <typename ValueType>
 void MultigridState::allocate_memory(int level, multigrid::cycle cycle,
-                                     size_type current_nrows,
-                                     size_type next_nrows)
+                                     const LinOp* fine_op,
+                                     const LinOp* coarse_op)
 {
     using vec = matrix::Dense<ValueType>;
-    using norm_vec = matrix::Dense<remove_complex<ValueType>>;
 
     auto exec =
         as<LinOp>(multigrid->get_mg_level_list().at(level))->get_executor();
-    r_list.emplace_back(vec::create(exec, dim<2>{current_nrows, nrhs}));
+    r_list.emplace_back(
+        gko::detail::create_vector<ValueType>(exec, fine_op, nrhs));
     if (level != 0) {
         // allocate the previous level
-        g_list.emplace_back(vec::create(exec, dim<2>{current_nrows, nrhs}));
-        e_list.emplace_back(vec::create(exec, dim<2>{current_nrows, nrhs}));
+        g_list.emplace_back(
+            gko::detail::create_vector<ValueType>(exec, fine_op, nrhs));
+        e_list.emplace_back(
+            gko::detail::create_vector<ValueType>(exec, fine_op, nrhs));
         next_one_list.emplace_back(initialize<vec>({one<ValueType>()}, exec));
     }
     if (level + 1 == multigrid->get_mg_level_list().size()) {
         // the last level allocate the g, e for coarsest solver
-        g_list.emplace_back(vec::create(exec, dim<2>{next_nrows, nrhs}));
-        e_list.emplace_back(vec::create(exec, dim<2>{next_nrows, nrhs}));
+        g_list.emplace_back(
+            gko::detail::create_vector<ValueType>(exec, coarse_op, nrhs));
+        e_list.emplace_back(
+            gko::detail::create_vector<ValueType>(exec, coarse_op, nrhs));
         next_one_list.emplace_back(initialize<vec>({one<ValueType>()}, exec));
     }
     one_list.emplace_back(initialize<vec>({one<ValueType>()}, exec));
@@ -413,8 +413,8 @@ void MultigridState::run_cycle(multigrid::cycle cycle, size_type level,
             } else {
                 // x in first level is already filled by zero outside.
                 if (level != 0) {
-                    dynamic_cast<matrix::Dense<ValueType>*>(x)->fill(
-                        zero<ValueType>());
+                    gko::detail::vector_dispatch<ValueType>(
+                        x, [](auto vec) { vec->fill(zero<ValueType>()); });
                 }
                 pre_smoother->apply(b, x);
             }
@@ -435,7 +435,8 @@ void MultigridState::run_cycle(multigrid::cycle cycle, size_type level,
     // next level
     if (level + 1 == total_level) {
         // the coarsest solver use the last level valuetype
-        as_vec<ValueType>(e)->fill(zero<ValueType>());
+        gko::detail::vector_dispatch<ValueType>(
+            e.get(), [](auto vec) { vec->fill(zero<ValueType>()); });
     }
     auto next_level_matrix =
         (level + 1 < total_level)
@@ -33,6 +33,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ginkgo/core/base/mtx_io.hpp>
 
 
+#include <algorithm>
 #include <cstring>
 #include <sstream>
 
@@ -575,6 +576,132 @@ TEST(MtxReader, ReadsComplexBinary)
 }
 
 
+std::string build_sorted_binary_real_data()
+{
+    gko::matrix_data<double, gko::int64> data{gko::dim<2>{64, 32}};
+    data.nonzeros.emplace_back(0, 1, 0.0);
+    data.nonzeros.emplace_back(1, 1, 2.5);
+    data.nonzeros.emplace_back(4, 2, -2.5);
+    data.nonzeros.emplace_back(16, 25, 0.0);
+    std::stringstream ss;
+    gko::write_binary_raw(ss, data);
+    return ss.str();
+}
+
+
+TEST(MtxReader, ReadsBinaryRows)
+{
+    auto raw_data = build_sorted_binary_real_data();
+    auto test_read = [&](auto mtx_data) {
+        SCOPED_TRACE(gko::name_demangling::get_static_type(mtx_data));
+        using value_type =
+            typename std::decay_t<decltype(mtx_data)>::value_type;
+        using index_type =
+            typename std::decay_t<decltype(mtx_data)>::index_type;
+        std::stringstream ss{raw_data};
+
+        auto data =
+            gko::read_binary_rows_raw<value_type, index_type>(ss, {1, 5});
+
+        ASSERT_EQ(data.size, gko::dim<2>(64, 32));
+        ASSERT_EQ(data.nonzeros.size(), 2);
+        ASSERT_EQ(data.nonzeros[0].row, 1);
+        ASSERT_EQ(data.nonzeros[1].row, 4);
+        ASSERT_EQ(data.nonzeros[0].column, 1);
+        ASSERT_EQ(data.nonzeros[1].column, 2);
+        ASSERT_EQ(data.nonzeros[0].value, value_type{2.5});
+        ASSERT_EQ(data.nonzeros[1].value, value_type{-2.5});
+    };
+
+    test_read(gko::matrix_data<float, gko::int32>{});
+    test_read(gko::matrix_data<double, gko::int32>{});
+    test_read(gko::matrix_data<std::complex<float>, gko::int32>{});
+    test_read(gko::matrix_data<std::complex<double>, gko::int32>{});
+    test_read(gko::matrix_data<float, gko::int64>{});
+    test_read(gko::matrix_data<double, gko::int64>{});
+    test_read(gko::matrix_data<std::complex<float>, gko::int64>{});
+    test_read(gko::matrix_data<std::complex<double>, gko::int64>{});
+}
+
+
+TEST(MtxReader, ReadsEmptyBinaryRows)
+{
+    std::stringstream ss{build_sorted_binary_real_data()};
+
+    auto data = gko::read_binary_rows_raw<double, gko::int32>(ss, {5, 16});
+
+    ASSERT_EQ(data.size, gko::dim<2>(64, 32));
+    ASSERT_EQ(data.nonzeros.size(), 0);
+}
+
+
+TEST(MtxReader, ReadsBinaryRowsWithRowBlockIndex)
+{
+    gko::matrix_data<double, gko::int64> data{gko::dim<2>{10, 4}};
+    for (gko::int64 row = 0; row < 10; row++) {
+        for (gko::int64 col = 0; col < row % 4; col++) {
+            data.nonzeros.emplace_back(row, col, row + 0.5 * col);
+        }
+    }
+    std::stringstream ss;
+    gko::write_binary_indexed_raw(ss, data, 3);
+
+    for (gko::size_type begin = 0; begin <= 10; begin++) {
+        for (gko::size_type end = begin; end <= 10; end++) {
+            SCOPED_TRACE(std::to_string(begin) + " " + std::to_string(end));
+            ss.seekg(0);
+            auto rows =
+                gko::read_binary_rows_raw<double, gko::int64>(ss, {begin, end});
+
+            auto expected = data;
+            expected.nonzeros.erase(
+                std::remove_if(expected.nonzeros.begin(),
+                               expected.nonzeros.end(),
+                               [&](auto entry) {
+                                   const auto row =
+                                       static_cast<gko::size_type>(entry.row);
+                                   return row < begin || row >= end;
+                               }),
+                expected.nonzeros.end());
+            ASSERT_EQ(rows.size, data.size);
+            ASSERT_EQ(rows.nonzeros, expected.nonzeros);
+        }
+    }
+}
+
+
+TEST(MtxReader, ReadsBinaryWithRowBlockIndex)
+{
+    gko::matrix_data<double, gko::int32> data{gko::dim<2>{5, 3}};
+    data.nonzeros.emplace_back(3, 1, 1.0);
+    data.nonzeros.emplace_back(0, 2, 2.0);
+    data.nonzeros.emplace_back(4, 0, 3.0);
+    std::stringstream ss;
+    gko::write_binary_indexed_raw(ss, data, 2);
+
+    auto result = gko::read_binary_raw<double, gko::int32>(ss);
+
+    data.ensure_row_major_order();
+    ASSERT_EQ(result.size, data.size);
+    ASSERT_EQ(result.nonzeros, data.nonzeros);
+}
+
+
+TEST(MtxReader, FailsReadingBinaryRowsIfUnsorted)
+{
+    gko::matrix_data<double, gko::int32> data{gko::dim<2>{5, 3}};
+    data.nonzeros.emplace_back(1, 1, 1.0);
+    data.nonzeros.emplace_back(0, 2, 2.0);
+    data.nonzeros.emplace_back(4, 0, 3.0);
+    data.nonzeros.emplace_back(3, 0, 3.0);
+    std::stringstream ss;
+    gko::write_binary_raw(ss, data);
+
+    ASSERT_THROW((gko::read_binary_rows_raw<double, gko::int32>(ss, {0, 1})),
+                 gko::StreamError);
+}
+
+
 TEST(MtxReader, ReadsGenericBinary)
 {
     auto raw_data = build_binary_real_data();
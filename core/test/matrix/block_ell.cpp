@@ -0,0 +1,228 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2022, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#include <ginkgo/core/matrix/block_ell.hpp>
+
+
+#include <gtest/gtest.h>
+
+
+#include <ginkgo/core/base/exception.hpp>
+#include <ginkgo/core/matrix/csr.hpp>
+
+
+#include "core/test/utils.hpp"
+
+
+namespace {
+
+
+template <typename ValueIndexType>
+class BlockEll : public ::testing::Test {
+protected:
+    using value_type =
+        typename std::tuple_element<0, decltype(ValueIndexType())>::type;
+    using index_type =
+        typename std::tuple_element<1, decltype(ValueIndexType())>::type;
+    using Mtx = gko::matrix::BlockEll<value_type, index_type>;
+    using Csr = gko::matrix::Csr<value_type, index_type>;
+
+    BlockEll()
+        : exec(gko::ReferenceExecutor::create()),
+          mtx(Mtx::create(exec, 2, gko::dim<2>{4, 6}, 2))
+    {
+        // block row 0: blocks in block columns 0 and 2
+        // block row 1: a single block in block column 1
+        auto c = mtx->get_col_idxs();
+        c[0] = 0;
+        c[1] = 1;
+        c[2] = 2;
+        c[3] = gko::invalid_index<index_type>();
+        auto v = mtx->get_values();
+        for (int i = 0; i < 12; i++) {
+            v[i] = static_cast<value_type>(i + 1);
+        }
+        for (int i = 12; i < 16; i++) {
+            v[i] = gko::zero<value_type>();
+        }
+    }
+
+    std::shared_ptr<const gko::Executor> exec;
+    std::unique_ptr<Mtx> mtx;
+
+    void assert_equal_to_original_mtx(const Mtx* m)
+    {
+        auto c = m->get_const_col_idxs();
+        auto v = m->get_const_values();
+        ASSERT_EQ(m->get_size(), gko::dim<2>(4, 6));
+        ASSERT_EQ(m->get_block_size(), 2);
+        ASSERT_EQ(m->get_num_block_rows(), 2);
+        ASSERT_EQ(m->get_num_stored_blocks_per_row(), 2);
+        ASSERT_EQ(m->get_num_stored_elements(), 16);
+        EXPECT_EQ(c[0], 0);
+        EXPECT_EQ(c[1], 1);
+        EXPECT_EQ(c[2], 2);
+        EXPECT_EQ(c[3], gko::invalid_index<index_type>());
+        for (int i = 0; i < 12; i++) {
+            EXPECT_EQ(v[i], static_cast<value_type>(i + 1));
+        }
+    }
+
+    void assert_empty(const Mtx* m)
+    {
+        ASSERT_EQ(m->get_size(), gko::dim<2>(0, 0));
+        ASSERT_EQ(m->get_block_size(), 0);
+        ASSERT_EQ(m->get_num_stored_blocks_per_row(), 0);
+        ASSERT_EQ(m->get_num_stored_elements(), 0);
+    }
+};
+
+TYPED_TEST_SUITE(BlockEll, gko::test::ValueIndexTypes,
+                 PairTypenameNameGenerator);
+
+
+TYPED_TEST(BlockEll, KnowsItsSize)
+{
+    ASSERT_EQ(this->mtx->get_size(), gko::dim<2>(4, 6));
+    ASSERT_EQ(this->mtx->get_block_size(), 2);
+    ASSERT_EQ(this->mtx->get_num_stored_elements(), 16);
+}
+
+
+TYPED_TEST(BlockEll, ContainsCorrectData)
+{
+    this->assert_equal_to_original_mtx(this->mtx.get());
+}
+
+
+TYPED_TEST(BlockEll, CanBeEmpty)
+{
+    using Mtx = typename TestFixture::Mtx;
+    auto empty = Mtx::create(this->exec);
+
+    this->assert_empty(empty.get());
+}
+
+
+TYPED_TEST(BlockEll, ThrowsOnNonConformantSize)
+{
+    using Mtx = typename TestFixture::Mtx;
+
+    ASSERT_THROW(Mtx::create(this->exec, 2, gko::dim<2>{3, 4}, 1),
+                 gko::Error);
+}
+
+
+TYPED_TEST(BlockEll, CanBeCopied)
+{
+    using Mtx = typename TestFixture::Mtx;
+    auto copy = Mtx::create(this->exec);
+
+    copy->copy_from(this->mtx.get());
+
+    this->assert_equal_to_original_mtx(this->mtx.get());
+    this->mtx->get_values()[0] = 42.0;
+    this->assert_equal_to_original_mtx(copy.get());
+}
+
+
+TYPED_TEST(BlockEll, CanBeMoved)
+{
+    using Mtx = typename TestFixture::Mtx;
+    auto copy = Mtx::create(this->exec);
+
+    copy->copy_from(std::move(this->mtx));
+
+    this->assert_equal_to_original_mtx(copy.get());
+}
+
+
+TYPED_TEST(BlockEll, CanBeCloned)
+{
+    auto clone = this->mtx->clone();
+
+    this->assert_equal_to_original_mtx(this->mtx.get());
+    this->mtx->get_values()[0] = 42.0;
+    this->assert_equal_to_original_mtx(clone.get());
+}
+
+
+TYPED_TEST(BlockEll, CanBeCleared)
+{
+    this->mtx->clear();
+
+    this->assert_empty(this->mtx.get());
+}
+
+
+TYPED_TEST(BlockEll, DetectsBlockSize)
+{
+    using Csr = typename TestFixture::Csr;
+    using Mtx = typename TestFixture::Mtx;
+    using value_type = typename TestFixture::value_type;
+    using index_type = typename TestFixture::index_type;
+    gko::matrix_data<value_type, index_type> data{gko::dim<2>{6, 6}};
+    // 2x2 dense diagonal blocks and one off-diagonal block
+    for (int block = 0; block < 3; block++) {
+        for (int i = 0; i < 2; i++) {
+            for (int j = 0; j < 2; j++) {
+                data.nonzeros.emplace_back(2 * block + i, 2 * block + j, 1.0);
+            }
+        }
+    }
+    for (int i = 0; i < 2; i++) {
+        for (int j = 0; j < 2; j++) {
+            data.nonzeros.emplace_back(i, 4 + j, 2.0);
+        }
+    }
+    data.ensure_row_major_order();
+    auto csr = Csr::create(this->exec);
+    csr->read(data);
+
+    ASSERT_EQ(Mtx::detect_block_size(csr.get()), 2);
+}
+
+
+TYPED_TEST(BlockEll, DetectsBlockSizeOneWithoutSubstructure)
+{
+    using Csr = typename TestFixture::Csr;
+    using Mtx = typename TestFixture::Mtx;
+    auto csr = gko::initialize<Csr>(
+        {{1.0, 0.0, 0.0, 2.0}, {0.0, 3.0, 0.0, 0.0}, {0.0, 0.0, 4.0, 0.0},
+         {5.0, 0.0, 0.0, 6.0}},
+        this->exec);
+
+    ASSERT_EQ(Mtx::detect_block_size(csr.get()), 1);
+}
+
+
+}  // namespace
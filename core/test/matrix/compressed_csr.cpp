@@ -0,0 +1,226 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2022, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#include <ginkgo/core/matrix/compressed_csr.hpp>
+
+
+#include <cstring>
+
+
+#include <gtest/gtest.h>
+
+
+#include <ginkgo/core/base/exception.hpp>
+#include <ginkgo/core/matrix/csr.hpp>
+
+
+#include "core/test/utils.hpp"
+
+
+namespace {
+
+
+// reads the k-th delta of a row from the byte-addressed delta storage
+template <typename DeltaType>
+DeltaType load_delta(const gko::uint64* row_words, gko::size_type k)
+{
+    DeltaType delta;
+    std::memcpy(&delta,
+                reinterpret_cast<const unsigned char*>(row_words) +
+                    k * sizeof(DeltaType),
+                sizeof(DeltaType));
+    return delta;
+}
+
+
+template <typename ValueIndexType>
+class CompressedCsr : public ::testing::Test {
+protected:
+    using value_type =
+        typename std::tuple_element<0, decltype(ValueIndexType())>::type;
+    using index_type =
+        typename std::tuple_element<1, decltype(ValueIndexType())>::type;
+    using Mtx = gko::matrix::CompressedCsr<value_type, index_type>;
+
+    CompressedCsr()
+        : exec(gko::ReferenceExecutor::create()), mtx(Mtx::create(exec))
+    {
+        mtx->read(gko::matrix_data<value_type, index_type>{{3, 300},
+                                                            {{0, 1, 1.0},
+                                                             {0, 3, 2.0},
+                                                             {1, 0, 3.0},
+                                                             {1, 299, 4.0}}});
+    }
+
+    std::shared_ptr<const gko::Executor> exec;
+    std::unique_ptr<Mtx> mtx;
+
+    void assert_equal_to_original_mtx(const Mtx* m)
+    {
+        auto v = m->get_const_values();
+        auto r = m->get_const_row_ptrs();
+        auto b = m->get_const_col_bases();
+        auto w = m->get_const_col_widths();
+        auto o = m->get_const_col_offsets();
+        auto d = m->get_const_col_deltas();
+        ASSERT_EQ(m->get_size(), gko::dim<2>(3, 300));
+        ASSERT_EQ(m->get_num_stored_elements(), 4);
+        EXPECT_EQ(r[0], 0);
+        EXPECT_EQ(r[1], 2);
+        EXPECT_EQ(r[2], 4);
+        EXPECT_EQ(r[3], 4);
+        EXPECT_EQ(b[0], 1);
+        EXPECT_EQ(b[1], 0);
+        EXPECT_EQ(b[2], 0);
+        EXPECT_EQ(w[0], 1);
+        EXPECT_EQ(w[1], 2);
+        EXPECT_EQ(o[0], 0);
+        EXPECT_EQ(o[1], 1);
+        EXPECT_EQ(o[2], 2);
+        EXPECT_EQ(o[3], 2);
+        EXPECT_EQ(load_delta<gko::uint8>(d, 0), 0);
+        EXPECT_EQ(load_delta<gko::uint8>(d, 1), 2);
+        EXPECT_EQ(load_delta<gko::uint16>(d + 1, 0), 0);
+        EXPECT_EQ(load_delta<gko::uint16>(d + 1, 1), 299);
+        EXPECT_EQ(v[0], value_type{1.0});
+        EXPECT_EQ(v[1], value_type{2.0});
+        EXPECT_EQ(v[2], value_type{3.0});
+        EXPECT_EQ(v[3], value_type{4.0});
+    }
+
+    void assert_empty(const Mtx* m)
+    {
+        ASSERT_EQ(m->get_size(), gko::dim<2>(0, 0));
+        ASSERT_EQ(m->get_num_stored_elements(), 0);
+        ASSERT_EQ(m->get_const_values(), nullptr);
+        ASSERT_EQ(m->get_const_col_deltas(), nullptr);
+        ASSERT_NE(m->get_const_row_ptrs(), nullptr);
+        ASSERT_NE(m->get_const_col_offsets(), nullptr);
+    }
+};
+
+TYPED_TEST_SUITE(CompressedCsr, gko::test::ValueIndexTypes,
+                 PairTypenameNameGenerator);
+
+
+TYPED_TEST(CompressedCsr, KnowsItsSize)
+{
+    ASSERT_EQ(this->mtx->get_size(), gko::dim<2>(3, 300));
+    ASSERT_EQ(this->mtx->get_num_stored_elements(), 4);
+}
+
+
+TYPED_TEST(CompressedCsr, ContainsCorrectData)
+{
+    this->assert_equal_to_original_mtx(this->mtx.get());
+}
+
+
+TYPED_TEST(CompressedCsr, KnowsItsIndexBytes)
+{
+    using index_type = typename TestFixture::index_type;
+
+    ASSERT_EQ(this->mtx->get_num_index_bytes(),
+              2 * sizeof(gko::uint64) + 3 + 7 * sizeof(index_type));
+}
+
+
+TYPED_TEST(CompressedCsr, CanBeEmpty)
+{
+    using Mtx = typename TestFixture::Mtx;
+    auto mtx = Mtx::create(this->exec);
+
+    this->assert_empty(mtx.get());
+}
+
+
+TYPED_TEST(CompressedCsr, CanBeCopied)
+{
+    using Mtx = typename TestFixture::Mtx;
+    auto copy = Mtx::create(this->exec);
+
+    copy->copy_from(this->mtx.get());
+
+    this->assert_equal_to_original_mtx(this->mtx.get());
+    this->mtx->get_values()[1] = 5.0;
+    this->assert_equal_to_original_mtx(copy.get());
+}
+
+
+TYPED_TEST(CompressedCsr, CanBeMoved)
+{
+    using Mtx = typename TestFixture::Mtx;
+    auto copy = Mtx::create(this->exec);
+
+    copy->copy_from(std::move(this->mtx));
+
+    this->assert_equal_to_original_mtx(copy.get());
+}
+
+
+TYPED_TEST(CompressedCsr, CanBeCloned)
+{
+    auto clone = this->mtx->clone();
+
+    this->assert_equal_to_original_mtx(this->mtx.get());
+    this->mtx->get_values()[1] = 5.0;
+    this->assert_equal_to_original_mtx(clone.get());
+}
+
+
+TYPED_TEST(CompressedCsr, CanBeCleared)
+{
+    this->mtx->clear();
+
+    this->assert_empty(this->mtx.get());
+}
+
+
+TYPED_TEST(CompressedCsr, GeneratesCorrectMatrixData)
+{
+    using value_type = typename TestFixture::value_type;
+    using index_type = typename TestFixture::index_type;
+    using tpl = typename gko::matrix_data<value_type, index_type>::nonzero_type;
+    gko::matrix_data<value_type, index_type> data;
+
+    this->mtx->write(data);
+
+    ASSERT_EQ(data.size, gko::dim<2>(3, 300));
+    ASSERT_EQ(data.nonzeros.size(), 4);
+    EXPECT_EQ(data.nonzeros[0], tpl(0, 1, value_type{1.0}));
+    EXPECT_EQ(data.nonzeros[1], tpl(0, 3, value_type{2.0}));
+    EXPECT_EQ(data.nonzeros[2], tpl(1, 0, value_type{3.0}));
+    EXPECT_EQ(data.nonzeros[3], tpl(1, 299, value_type{4.0}));
+}
+
+
+}  // namespace
@@ -179,6 +179,20 @@ TYPED_TEST(Sellp, CanBeConstructedWithSliceSizeAndStrideFactor)
 }
 
 
+TYPED_TEST(Sellp, CanBeConstructedWithSortingWindow)
+{
+    using Mtx = typename TestFixture::Mtx;
+    auto mtx = Mtx::create(this->exec, 2, 4, 8);
+
+    ASSERT_EQ(mtx->get_size(), gko::dim<2>(0, 0));
+    ASSERT_EQ(mtx->get_num_stored_elements(), 0);
+    ASSERT_EQ(mtx->get_slice_size(), 2);
+    ASSERT_EQ(mtx->get_stride_factor(), 4);
+    ASSERT_EQ(mtx->get_sorting_window(), 8);
+    ASSERT_EQ(mtx->get_const_permutation(), nullptr);
+}
+
+
 TYPED_TEST(Sellp, CanBeCopied)
 {
     using Mtx = typename TestFixture::Mtx;
@@ -243,6 +257,30 @@ TYPED_TEST(Sellp, CanBeReadFromMatrixDataWithSliceSizeAndStrideFactor)
 }
 
 
+TYPED_TEST(Sellp, CanBeReadFromMatrixDataWithSortingWindow)
+{
+    using Mtx = typename TestFixture::Mtx;
+    using value_type = typename TestFixture::value_type;
+    using index_type = typename TestFixture::index_type;
+    gko::matrix_data<value_type, index_type> data{
+        {3, 3},
+        {{0, 0, 1.0}, {1, 0, 2.0}, {1, 1, 3.0}, {1, 2, 4.0}, {2, 2, 5.0}}};
+    auto m = Mtx::create(this->exec, 1, 1, 3);
+    gko::matrix_data<value_type, index_type> result;
+
+    m->read(data);
+    m->write(result);
+
+    ASSERT_EQ(m->get_sorting_window(), 3);
+    // the row with the most nonzeros is stored first
+    ASSERT_NE(m->get_const_permutation(), nullptr);
+    EXPECT_EQ(m->get_const_permutation()[0], 1);
+    EXPECT_EQ(m->get_const_slice_lengths()[0], 3);
+    EXPECT_EQ(result.size, data.size);
+    EXPECT_EQ(result.nonzeros, data.nonzeros);
+}
+
+
 TYPED_TEST(Sellp, GeneratesCorrectMatrixData)
 {
     using value_type = typename TestFixture::value_type;
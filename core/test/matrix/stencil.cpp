@@ -0,0 +1,236 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2022, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#include <ginkgo/core/matrix/stencil.hpp>
+
+
+#include <gtest/gtest.h>
+
+
+#include <ginkgo/core/base/exception.hpp>
+
+
+#include "core/test/utils.hpp"
+
+
+namespace {
+
+
+template <typename ValueIndexType>
+class Stencil : public ::testing::Test {
+protected:
+    using value_type =
+        typename std::tuple_element<0, decltype(ValueIndexType())>::type;
+    using index_type =
+        typename std::tuple_element<1, decltype(ValueIndexType())>::type;
+    using Mtx = gko::matrix::Stencil<value_type, index_type>;
+
+    Stencil()
+        : exec(gko::ReferenceExecutor::create()),
+          mtx(Mtx::create(exec, gko::dim<3>{4, 3, 2},
+                          gko::array<index_type>{exec, {0, 0, 0, -1, 0, 0}},
+                          gko::array<value_type>{exec, {2.0, -1.0}}))
+    {}
+
+    std::shared_ptr<const gko::Executor> exec;
+    std::unique_ptr<Mtx> mtx;
+
+    void assert_equal_to_original_mtx(const Mtx* m)
+    {
+        auto o = m->get_const_offsets();
+        auto c = m->get_const_coefficients();
+        ASSERT_EQ(m->get_size(), gko::dim<2>(24, 24));
+        ASSERT_EQ(m->get_grid_size(), gko::dim<3>(4, 3, 2));
+        ASSERT_EQ(m->get_num_points(), 2);
+        ASSERT_EQ(m->get_num_stored_coefficients(), 2);
+        ASSERT_FALSE(m->has_variable_coefficients());
+        EXPECT_EQ(o[0], 0);
+        EXPECT_EQ(o[1], 0);
+        EXPECT_EQ(o[2], 0);
+        EXPECT_EQ(o[3], -1);
+        EXPECT_EQ(o[4], 0);
+        EXPECT_EQ(o[5], 0);
+        EXPECT_EQ(c[0], value_type{2.0});
+        EXPECT_EQ(c[1], value_type{-1.0});
+    }
+
+    void assert_empty(const Mtx* m)
+    {
+        ASSERT_EQ(m->get_size(), gko::dim<2>(0, 0));
+        ASSERT_EQ(m->get_grid_size(), gko::dim<3>(0, 0, 0));
+        ASSERT_EQ(m->get_num_points(), 0);
+        ASSERT_EQ(m->get_num_stored_coefficients(), 0);
+    }
+};
+
+TYPED_TEST_SUITE(Stencil, gko::test::ValueIndexTypes,
+                 PairTypenameNameGenerator);
+
+
+TYPED_TEST(Stencil, KnowsItsSize)
+{
+    ASSERT_EQ(this->mtx->get_size(), gko::dim<2>(24, 24));
+    ASSERT_EQ(this->mtx->get_grid_size(), gko::dim<3>(4, 3, 2));
+}
+
+
+TYPED_TEST(Stencil, ContainsCorrectData)
+{
+    this->assert_equal_to_original_mtx(this->mtx.get());
+}
+
+
+TYPED_TEST(Stencil, CanBeEmpty)
+{
+    using Mtx = typename TestFixture::Mtx;
+    auto empty = Mtx::create(this->exec);
+
+    this->assert_empty(empty.get());
+}
+
+
+TYPED_TEST(Stencil, CanHaveVariableCoefficients)
+{
+    using Mtx = typename TestFixture::Mtx;
+    using index_type = typename TestFixture::index_type;
+    using value_type = typename TestFixture::value_type;
+
+    auto m = Mtx::create(
+        this->exec, gko::dim<3>{3, 1, 1},
+        gko::array<index_type>{this->exec, {0, 0, 0, 1, 0, 0}},
+        gko::array<value_type>{this->exec, {1.0, 2.0, 3.0, 4.0, 5.0, 6.0}});
+
+    ASSERT_EQ(m->get_size(), gko::dim<2>(3, 3));
+    ASSERT_EQ(m->get_num_points(), 2);
+    ASSERT_EQ(m->get_num_stored_coefficients(), 6);
+    ASSERT_TRUE(m->has_variable_coefficients());
+}
+
+
+TYPED_TEST(Stencil, ThrowsOnIncompleteOffsets)
+{
+    using Mtx = typename TestFixture::Mtx;
+    using index_type = typename TestFixture::index_type;
+    using value_type = typename TestFixture::value_type;
+
+    ASSERT_THROW(Mtx::create(this->exec, gko::dim<3>{4, 1, 1},
+                             gko::array<index_type>{this->exec, {0, 0}},
+                             gko::array<value_type>{this->exec, {1.0}}),
+                 gko::ValueMismatch);
+}
+
+
+TYPED_TEST(Stencil, ThrowsOnWrongNumberOfCoefficients)
+{
+    using Mtx = typename TestFixture::Mtx;
+    using index_type = typename TestFixture::index_type;
+    using value_type = typename TestFixture::value_type;
+
+    ASSERT_THROW(
+        Mtx::create(this->exec, gko::dim<3>{4, 1, 1},
+                    gko::array<index_type>{this->exec, {0, 0, 0}},
+                    gko::array<value_type>{this->exec, {1.0, 2.0, 3.0}}),
+        gko::ValueMismatch);
+}
+
+
+TYPED_TEST(Stencil, CanBeCopied)
+{
+    using Mtx = typename TestFixture::Mtx;
+    auto copy = Mtx::create(this->exec);
+
+    copy->copy_from(this->mtx.get());
+
+    this->assert_equal_to_original_mtx(this->mtx.get());
+    this->assert_equal_to_original_mtx(copy.get());
+}
+
+
+TYPED_TEST(Stencil, CanBeMoved)
+{
+    using Mtx = typename TestFixture::Mtx;
+    auto copy = Mtx::create(this->exec);
+
+    copy->copy_from(std::move(this->mtx));
+
+    this->assert_equal_to_original_mtx(copy.get());
+}
+
+
+TYPED_TEST(Stencil, MoveLeavesEmptyStencil)
+{
+    using Mtx = typename TestFixture::Mtx;
+
+    auto moved = Mtx(std::move(*this->mtx));
+
+    this->assert_equal_to_original_mtx(&moved);
+    this->assert_empty(this->mtx.get());
+}
+
+
+TYPED_TEST(Stencil, CanBeCloned)
+{
+    auto clone = this->mtx->clone();
+
+    this->assert_equal_to_original_mtx(this->mtx.get());
+    this->assert_equal_to_original_mtx(clone.get());
+}
+
+
+TYPED_TEST(Stencil, CanBeCleared)
+{
+    this->mtx->clear();
+
+    this->assert_empty(this->mtx.get());
+}
+
+
+TYPED_TEST(Stencil, CanBeWritten)
+{
+    using value_type = typename TestFixture::value_type;
+    using index_type = typename TestFixture::index_type;
+    gko::matrix_data<value_type, index_type> data;
+
+    this->mtx->write(data);
+
+    ASSERT_EQ(data.size, gko::dim<2>(24, 24));
+    ASSERT_EQ(data.nonzeros.size(), 42);
+    EXPECT_EQ(data.nonzeros[0], (gko::matrix_data_entry<value_type, index_type>{
+                                    0, 0, value_type{2.0}}));
+    EXPECT_EQ(data.nonzeros[1], (gko::matrix_data_entry<value_type, index_type>{
+                                    1, 0, value_type{-1.0}}));
+    EXPECT_EQ(data.nonzeros[2], (gko::matrix_data_entry<value_type, index_type>{
+                                    1, 1, value_type{2.0}}));
+}
+
+
+}  // namespace
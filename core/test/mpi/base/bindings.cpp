@@ -30,6 +30,7 @@ THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
 OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ******************************<GINKGO LICENSE>*******************************/
 
+#include <algorithm>
 #include <memory>
 
 
@@ -301,6 +302,31 @@ TYPED_TEST(MpiBindings, CanPutValuesWithFence)
 }
 
 
+TYPED_TEST(MpiBindings, CanAccessSharedWindowOfOtherRanks)
+{
+    using window = gko::experimental::mpi::window<TypeParam>;
+    auto comm = gko::experimental::mpi::communicator(MPI_COMM_WORLD)
+                    .node_local_communicator();
+    auto my_rank = comm.rank();
+    auto num_ranks = comm.size();
+    auto win = window(this->ref, 4, comm);
+    win.lock_all(MPI_MODE_NOCHECK);
+
+    std::fill_n(win.shared_query(my_rank), 4, TypeParam(my_rank + 1));
+    win.sync();
+    comm.synchronize();
+    win.sync();
+    auto other_rank = (my_rank + 1) % num_ranks;
+    auto other_data = win.shared_query(other_rank);
+    auto data = std::vector<TypeParam>(other_data, other_data + 4);
+    comm.synchronize();
+    win.unlock_all();
+
+    auto ref = std::vector<TypeParam>(4, TypeParam(other_rank + 1));
+    ASSERT_EQ(data, ref);
+}
+
+
 TYPED_TEST(MpiBindings, CanAccumulateValues)
 {
     using window = gko::experimental::mpi::window<TypeParam>;
@@ -1448,6 +1474,68 @@ TYPED_TEST(MpiBindings, NonBlockingAllToAllVWorksCorrectly)
 }
 
 
+TYPED_TEST(MpiBindings, NeighborAllToAllVWorksCorrectly)
+{
+    auto comm = gko::experimental::mpi::communicator(MPI_COMM_WORLD);
+    auto my_rank = comm.rank();
+    auto num_ranks = comm.size();
+    auto left = (my_rank + num_ranks - 1) % num_ranks;
+    auto right = (my_rank + 1) % num_ranks;
+    // every rank sends one value to the right and two values to the left
+    auto neighbor_comm = gko::experimental::mpi::communicator(
+        comm, std::vector<int>{left, right}, std::vector<int>{right, left});
+    auto send_array = gko::array<TypeParam>{
+        this->ref, I<TypeParam>{static_cast<TypeParam>(my_rank),
+                                static_cast<TypeParam>(10 * my_rank + 1),
+                                static_cast<TypeParam>(10 * my_rank + 2)}};
+    auto recv_array = gko::array<TypeParam>{this->ref, 3};
+    auto ref_array = gko::array<TypeParam>{
+        this->ref, I<TypeParam>{static_cast<TypeParam>(left),
+                                static_cast<TypeParam>(10 * right + 1),
+                                static_cast<TypeParam>(10 * right + 2)}};
+    std::vector<int> send_counts{1, 2};
+    std::vector<int> send_offsets{0, 1};
+    std::vector<int> recv_counts{1, 2};
+    std::vector<int> recv_offsets{0, 1};
+
+    neighbor_comm.neighbor_all_to_all_v(
+        this->ref, send_array.get_const_data(), send_counts.data(),
+        send_offsets.data(), recv_array.get_data(), recv_counts.data(),
+        recv_offsets.data());
+
+    GKO_ASSERT_ARRAY_EQ(recv_array, ref_array);
+}
+
+
+TYPED_TEST(MpiBindings, NonBlockingNeighborAllToAllVWorksCorrectly)
+{
+    auto comm = gko::experimental::mpi::communicator(MPI_COMM_WORLD);
+    auto my_rank = comm.rank();
+    auto num_ranks = comm.size();
+    auto left = (my_rank + num_ranks - 1) % num_ranks;
+    auto right = (my_rank + 1) % num_ranks;
+    // every rank only receives from the left and sends to the right
+    auto neighbor_comm = gko::experimental::mpi::communicator(
+        comm, std::vector<int>{left}, std::vector<int>{right});
+    auto send_array = gko::array<TypeParam>{
+        this->ref, I<TypeParam>{static_cast<TypeParam>(my_rank),
+                                static_cast<TypeParam>(my_rank + 1)}};
+    auto recv_array = gko::array<TypeParam>{this->ref, 2};
+    auto ref_array = gko::array<TypeParam>{
+        this->ref, I<TypeParam>{static_cast<TypeParam>(left),
+                                static_cast<TypeParam>(left + 1)}};
+    int count = 2;
+    int offset = 0;
+
+    auto req = neighbor_comm.i_neighbor_all_to_all_v(
+        this->ref, send_array.get_const_data(), &count, &offset,
+        recv_array.get_data(), &count, &offset);
+
+    req.wait();
+    GKO_ASSERT_ARRAY_EQ(recv_array, ref_array);
+}
+
+
 TYPED_TEST(MpiBindings, CanScanValues)
 {
     auto comm = gko::experimental::mpi::communicator(MPI_COMM_WORLD);
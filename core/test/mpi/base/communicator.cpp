@@ -86,6 +86,16 @@ TEST_F(Communicator, CommKnowsItsLocalRank)
 }
 
 
+TEST_F(Communicator, CanCreateNodeLocalCommunicator)
+{
+    auto node_comm = comm.node_local_communicator();
+
+    // Expect all ranks to be in the node local communicator when on one node
+    EXPECT_EQ(node_comm.size(), comm.size());
+    EXPECT_EQ(node_comm.rank(), comm.node_local_rank());
+}
+
+
 TEST_F(Communicator, CommunicatorCanBeCopyConstructed)
 {
     gko::experimental::mpi::communicator copy(comm);
@@ -0,0 +1,149 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2022, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+
+#include <ginkgo/core/distributed/preconditioner/schwarz.hpp>
+
+
+#include <gtest/gtest.h>
+
+
+#include <ginkgo/core/base/exception.hpp>
+#include <ginkgo/core/matrix/csr.hpp>
+#include <ginkgo/core/preconditioner/jacobi.hpp>
+
+
+#include "core/test/utils.hpp"
+
+
+namespace {
+
+
+template <typename ValueLocalGlobalIndexType>
+class SchwarzFactory : public ::testing::Test {
+protected:
+    using value_type =
+        typename std::tuple_element<0, decltype(
+                                           ValueLocalGlobalIndexType())>::type;
+    using local_index_type =
+        typename std::tuple_element<1, decltype(
+                                           ValueLocalGlobalIndexType())>::type;
+    using global_index_type =
+        typename std::tuple_element<2, decltype(
+                                           ValueLocalGlobalIndexType())>::type;
+    using Schwarz = gko::experimental::distributed::preconditioner::Schwarz<
+        value_type, local_index_type, global_index_type>;
+    using Jacobi = gko::preconditioner::Jacobi<value_type, local_index_type>;
+    using Mtx =
+        gko::experimental::distributed::Matrix<value_type, local_index_type,
+                                               global_index_type>;
+
+    SchwarzFactory()
+        : exec(gko::ReferenceExecutor::create()),
+          jacobi_factory(Jacobi::build().on(exec)),
+          mtx(Mtx::create(exec, MPI_COMM_WORLD))
+    {
+        schwarz = Schwarz::build()
+                      .with_local_solver(jacobi_factory)
+                      .on(exec)
+                      ->generate(mtx);
+    }
+
+    std::shared_ptr<const gko::Executor> exec;
+    std::unique_ptr<Schwarz> schwarz;
+    std::shared_ptr<typename Jacobi::Factory> jacobi_factory;
+    std::shared_ptr<Mtx> mtx;
+};
+
+TYPED_TEST_SUITE(SchwarzFactory, gko::test::ValueLocalGlobalIndexTypes,
+                 TupleTypenameNameGenerator);
+
+
+TYPED_TEST(SchwarzFactory, KnowsItsExecutor)
+{
+    ASSERT_EQ(this->schwarz->get_executor(), this->exec);
+}
+
+
+TYPED_TEST(SchwarzFactory, CanSetLocalFactory)
+{
+    ASSERT_EQ(this->schwarz->get_parameters().local_solver,
+              this->jacobi_factory);
+}
+
+
+TYPED_TEST(SchwarzFactory, HasNoOverlapByDefault)
+{
+    ASSERT_EQ(this->schwarz->get_parameters().overlap, 0u);
+}
+
+
+TYPED_TEST(SchwarzFactory, GeneratesLocalSolverFromLocalMatrix)
+{
+    using Jacobi = typename TestFixture::Jacobi;
+
+    ASSERT_NE(gko::as<Jacobi>(this->schwarz->get_local_solver()), nullptr);
+    ASSERT_EQ(this->schwarz->get_local_matrix(),
+              this->mtx->get_local_matrix());
+}
+
+
+TYPED_TEST(SchwarzFactory, ThrowsOnNonDistributedMatrix)
+{
+    using Schwarz = typename TestFixture::Schwarz;
+    using value_type = typename TestFixture::value_type;
+    using local_index_type = typename TestFixture::local_index_type;
+    auto csr = gko::share(
+        gko::matrix::Csr<value_type, local_index_type>::create(this->exec));
+
+    ASSERT_THROW(Schwarz::build()
+                     .with_local_solver(this->jacobi_factory)
+                     .on(this->exec)
+                     ->generate(csr),
+                 gko::NotSupported);
+}
+
+
+TYPED_TEST(SchwarzFactory, ThrowsOnUnsupportedOverlap)
+{
+    using Schwarz = typename TestFixture::Schwarz;
+
+    ASSERT_THROW(Schwarz::build()
+                     .with_local_solver(this->jacobi_factory)
+                     .with_overlap(2u)
+                     .on(this->exec)
+                     ->generate(this->mtx),
+                 gko::NotImplemented);
+}
+
+
+}  // namespace
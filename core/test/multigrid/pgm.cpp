@@ -65,6 +65,7 @@ protected:
                           .with_max_unassigned_ratio(0.1)
                           .with_deterministic(true)
                           .with_skip_sorting(true)
+                          .with_min_coarse_rows_per_rank(8u)
                           .on(exec))
 
     {}
@@ -92,6 +93,7 @@ TYPED_TEST(PgmFactory, DefaultSetting)
     ASSERT_EQ(factory->get_parameters().max_unassigned_ratio, 0.05);
     ASSERT_EQ(factory->get_parameters().deterministic, false);
     ASSERT_EQ(factory->get_parameters().skip_sorting, false);
+    ASSERT_EQ(factory->get_parameters().min_coarse_rows_per_rank, 0u);
 }
 
 
@@ -119,4 +121,11 @@ TYPED_TEST(PgmFactory, SetSkipSorting)
 }
 
 
+TYPED_TEST(PgmFactory, SetMinCoarseRowsPerRank)
+{
+    ASSERT_EQ(this->pgm_factory->get_parameters().min_coarse_rows_per_rank,
+              8u);
+}
+
+
 }  // namespace
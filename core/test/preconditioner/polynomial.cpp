@@ -0,0 +1,112 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2022, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+
+#include <ginkgo/core/preconditioner/polynomial.hpp>
+
+
+#include <memory>
+
+
+#include <gtest/gtest.h>
+
+
+#include "core/test/utils.hpp"
+
+
+namespace {
+
+
+template <typename T>
+class PolynomialFactory : public ::testing::Test {
+protected:
+    using value_type = T;
+    using Polynomial = gko::preconditioner::Polynomial<value_type>;
+
+    PolynomialFactory()
+        : exec(gko::ReferenceExecutor::create()),
+          factory(Polynomial::build().on(exec))
+    {}
+
+    std::shared_ptr<const gko::Executor> exec;
+    std::unique_ptr<typename Polynomial::Factory> factory;
+};
+
+TYPED_TEST_SUITE(PolynomialFactory, gko::test::ValueTypes,
+                 TypenameNameGenerator);
+
+
+TYPED_TEST(PolynomialFactory, KnowsItsExecutor)
+{
+    ASSERT_EQ(this->factory->get_executor(), this->exec);
+}
+
+
+TYPED_TEST(PolynomialFactory, HasDefaultParameters)
+{
+    const auto& params = this->factory->get_parameters();
+
+    ASSERT_EQ(params.kind, gko::preconditioner::polynomial::kind::chebyshev);
+    ASSERT_EQ(params.degree, 3u);
+    ASSERT_EQ(params.max_eigenvalue, 0.0);
+    ASSERT_EQ(params.min_eigenvalue, 0.0);
+    ASSERT_EQ(params.eigenvalue_ratio, 30.0);
+    ASSERT_EQ(params.power_iterations, 10u);
+}
+
+
+TYPED_TEST(PolynomialFactory, SetsParametersCorrectly)
+{
+    using Polynomial = typename TestFixture::Polynomial;
+
+    auto factory =
+        Polynomial::build()
+            .with_kind(gko::preconditioner::polynomial::kind::least_squares)
+            .with_degree(5u)
+            .with_max_eigenvalue(4.0)
+            .with_min_eigenvalue(0.5)
+            .with_eigenvalue_ratio(10.0)
+            .with_power_iterations(20u)
+            .on(this->exec);
+
+    const auto& params = factory->get_parameters();
+    ASSERT_EQ(params.kind,
+              gko::preconditioner::polynomial::kind::least_squares);
+    ASSERT_EQ(params.degree, 5u);
+    ASSERT_EQ(params.max_eigenvalue, 4.0);
+    ASSERT_EQ(params.min_eigenvalue, 0.5);
+    ASSERT_EQ(params.eigenvalue_ratio, 10.0);
+    ASSERT_EQ(params.power_iterations, 20u);
+}
+
+
+}  // namespace
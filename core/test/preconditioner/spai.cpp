@@ -0,0 +1,133 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2022, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+
+#include <ginkgo/core/preconditioner/spai.hpp>
+
+
+#include <memory>
+
+
+#include <gtest/gtest.h>
+
+
+#include <ginkgo/core/base/exception.hpp>
+#include <ginkgo/core/matrix/csr.hpp>
+
+
+#include "core/test/utils.hpp"
+
+
+namespace {
+
+
+template <typename ValueIndexType>
+class SpaiFactory : public ::testing::Test {
+protected:
+    using value_type =
+        typename std::tuple_element<0, decltype(ValueIndexType())>::type;
+    using index_type =
+        typename std::tuple_element<1, decltype(ValueIndexType())>::type;
+    using GeneralSpai =
+        gko::preconditioner::GeneralSpai<value_type, index_type>;
+    using SpdSpai = gko::preconditioner::SpdSpai<value_type, index_type>;
+
+    SpaiFactory()
+        : exec(gko::ReferenceExecutor::create()),
+          general_spai_factory(GeneralSpai::build().on(exec)),
+          spd_spai_factory(SpdSpai::build().on(exec))
+    {}
+
+    std::shared_ptr<const gko::Executor> exec;
+    std::unique_ptr<typename GeneralSpai::Factory> general_spai_factory;
+    std::unique_ptr<typename SpdSpai::Factory> spd_spai_factory;
+};
+
+TYPED_TEST_SUITE(SpaiFactory, gko::test::ValueIndexTypes,
+                 PairTypenameNameGenerator);
+
+
+TYPED_TEST(SpaiFactory, KnowsItsExecutor)
+{
+    ASSERT_EQ(this->general_spai_factory->get_executor(), this->exec);
+    ASSERT_EQ(this->spd_spai_factory->get_executor(), this->exec);
+}
+
+
+TYPED_TEST(SpaiFactory, HasDefaultParameters)
+{
+    const auto& params = this->general_spai_factory->get_parameters();
+
+    ASSERT_FALSE(params.skip_sorting);
+    ASSERT_EQ(params.adaptive_steps, 2);
+    ASSERT_EQ(params.entries_per_step, 4u);
+    ASSERT_EQ(params.tolerance, 0.0);
+}
+
+
+TYPED_TEST(SpaiFactory, SetsParametersCorrectly)
+{
+    using GeneralSpai = typename TestFixture::GeneralSpai;
+    using SpdSpai = typename TestFixture::SpdSpai;
+
+    auto general_factory = GeneralSpai::build()
+                               .with_skip_sorting(true)
+                               .with_adaptive_steps(3)
+                               .with_entries_per_step(2u)
+                               .with_tolerance(0.1)
+                               .on(this->exec);
+    auto spd_factory =
+        SpdSpai::build().with_adaptive_steps(0).on(this->exec);
+
+    const auto& params = general_factory->get_parameters();
+    ASSERT_TRUE(params.skip_sorting);
+    ASSERT_EQ(params.adaptive_steps, 3);
+    ASSERT_EQ(params.entries_per_step, 2u);
+    ASSERT_EQ(params.tolerance, 0.1);
+    ASSERT_EQ(spd_factory->get_parameters().adaptive_steps, 0);
+}
+
+
+TYPED_TEST(SpaiFactory, ThrowsOnNegativeAdaptiveSteps)
+{
+    using GeneralSpai = typename TestFixture::GeneralSpai;
+    using Csr = gko::matrix::Csr<typename TestFixture::value_type,
+                                 typename TestFixture::index_type>;
+    auto mtx = gko::share(Csr::create(this->exec, gko::dim<2>{2, 2}));
+    auto factory =
+        GeneralSpai::build().with_adaptive_steps(-1).on(this->exec);
+
+    ASSERT_THROW(factory->generate(mtx), gko::NotSupported);
+}
+
+
+}  // namespace
@@ -61,6 +61,20 @@ namespace distributed_matrix {
 #include "common/cuda_hip/distributed/matrix_kernels.hpp.inc"
 
 
+template <typename ValueType, typename LocalIndexType>
+void row_subset_spmv(
+    std::shared_ptr<const DefaultExecutor> exec,
+    const array<LocalIndexType>& rows, const matrix::Dense<ValueType>* alpha,
+    const matrix::Csr<ValueType, LocalIndexType>* local_mtx,
+    const matrix::Dense<ValueType>* local_b,
+    const matrix::Csr<ValueType, LocalIndexType>* non_local_mtx,
+    const matrix::Dense<ValueType>* recv_b,
+    const matrix::Dense<ValueType>* beta,
+    matrix::Dense<ValueType>* x) GKO_NOT_IMPLEMENTED;
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(GKO_DECLARE_ROW_SUBSET_SPMV);
+
+
 }  // namespace distributed_matrix
 }  // namespace cuda
 }  // namespace kernels
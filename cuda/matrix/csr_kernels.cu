@@ -48,6 +48,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ginkgo/core/base/array.hpp>
 #include <ginkgo/core/base/exception_helpers.hpp>
 #include <ginkgo/core/base/math.hpp>
+#include <ginkgo/core/base/precision_dispatch.hpp>
 #include <ginkgo/core/matrix/coo.hpp>
 #include <ginkgo/core/matrix/dense.hpp>
 #include <ginkgo/core/matrix/ell.hpp>
@@ -55,6 +56,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ginkgo/core/matrix/sellp.hpp>
 
 
+#include "core/base/mixed_precision_types.hpp"
 #include "core/components/fill_array_kernels.hpp"
 #include "core/components/format_conversion_kernels.hpp"
 #include "core/components/prefix_sum_kernels.hpp"
@@ -542,6 +544,71 @@ GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(
     GKO_DECLARE_CSR_ADVANCED_SPMV_KERNEL);
 
 
+template <typename InputValueType, typename MatrixValueType,
+          typename OutputValueType, typename IndexType>
+void mixed_spmv(std::shared_ptr<const CudaExecutor> exec,
+                const matrix::Csr<MatrixValueType, IndexType>* a,
+                const matrix::Dense<InputValueType>* b,
+                matrix::Dense<OutputValueType>* c)
+{
+    using arithmetic_type =
+        highest_precision<InputValueType, OutputValueType, MatrixValueType>;
+    const auto nrows = a->get_size()[0];
+    const auto num_rhs = c->get_size()[1];
+    if (nrows == 0 || num_rhs == 0) {
+        return;
+    }
+    // one warp per row and right-hand side column
+    const dim3 block_size(default_block_size, 1, 1);
+    const dim3 grid_size(ceildiv(nrows * config::warp_size, default_block_size),
+                         num_rhs, 1);
+    kernel::mixed_spmv<cuda_type<arithmetic_type>>
+        <<<grid_size, block_size>>>(
+            static_cast<IndexType>(nrows),
+            as_cuda_type(a->get_const_values()), a->get_const_col_idxs(),
+            a->get_const_row_ptrs(), as_cuda_type(b->get_const_values()),
+            b->get_stride(), as_cuda_type(c->get_values()),
+            c->get_stride());
+}
+
+GKO_INSTANTIATE_FOR_EACH_MIXED_VALUE_AND_INDEX_TYPE(
+    GKO_DECLARE_CSR_MIXED_SPMV_KERNEL);
+
+
+template <typename InputValueType, typename MatrixValueType,
+          typename OutputValueType, typename IndexType>
+void advanced_mixed_spmv(std::shared_ptr<const CudaExecutor> exec,
+                         const matrix::Dense<MatrixValueType>* alpha,
+                         const matrix::Csr<MatrixValueType, IndexType>* a,
+                         const matrix::Dense<InputValueType>* b,
+                         const matrix::Dense<OutputValueType>* beta,
+                         matrix::Dense<OutputValueType>* c)
+{
+    using arithmetic_type =
+        highest_precision<InputValueType, OutputValueType, MatrixValueType>;
+    const auto nrows = a->get_size()[0];
+    const auto num_rhs = c->get_size()[1];
+    if (nrows == 0 || num_rhs == 0) {
+        return;
+    }
+    // one warp per row and right-hand side column
+    const dim3 block_size(default_block_size, 1, 1);
+    const dim3 grid_size(ceildiv(nrows * config::warp_size, default_block_size),
+                         num_rhs, 1);
+    kernel::mixed_spmv<cuda_type<arithmetic_type>>
+        <<<grid_size, block_size>>>(
+            static_cast<IndexType>(nrows),
+            as_cuda_type(alpha->get_const_values()),
+            as_cuda_type(a->get_const_values()), a->get_const_col_idxs(),
+            a->get_const_row_ptrs(), as_cuda_type(b->get_const_values()),
+            b->get_stride(), as_cuda_type(beta->get_const_values()),
+            as_cuda_type(c->get_values()), c->get_stride());
+}
+
+GKO_INSTANTIATE_FOR_EACH_MIXED_VALUE_AND_INDEX_TYPE(
+    GKO_DECLARE_CSR_ADVANCED_MIXED_SPMV_KERNEL);
+
+
 template <typename ValueType, typename IndexType>
 void spgemm(std::shared_ptr<const CudaExecutor> exec,
             const matrix::Csr<ValueType, IndexType>* a,
@@ -861,6 +928,16 @@ GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(
     GKO_DECLARE_CSR_ADVANCED_SPGEMM_KERNEL);
 
 
+template <typename ValueType, typename IndexType>
+void masked_spgemm(std::shared_ptr<const CudaExecutor> exec,
+                   const matrix::Csr<ValueType, IndexType>* a,
+                   const matrix::Csr<ValueType, IndexType>* b,
+                   matrix::Csr<ValueType, IndexType>* c) GKO_NOT_IMPLEMENTED;
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(
+    GKO_DECLARE_CSR_MASKED_SPGEMM_KERNEL);
+
+
 template <typename ValueType, typename IndexType>
 void spgeam(std::shared_ptr<const DefaultExecutor> exec,
             const matrix::Dense<ValueType>* alpha,
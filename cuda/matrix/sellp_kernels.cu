@@ -78,6 +78,7 @@ void spmv(std::shared_ptr<const CudaExecutor> exec,
             a->get_size()[0], b->get_size()[1], b->get_stride(),
             c->get_stride(), a->get_slice_size(), a->get_const_slice_sets(),
             as_cuda_type(a->get_const_values()), a->get_const_col_idxs(),
+            a->get_const_permutation(),
             as_cuda_type(b->get_const_values()), as_cuda_type(c->get_values()));
     }
 }
@@ -102,6 +103,7 @@ void advanced_spmv(std::shared_ptr<const CudaExecutor> exec,
             c->get_stride(), a->get_slice_size(), a->get_const_slice_sets(),
             as_cuda_type(alpha->get_const_values()),
             as_cuda_type(a->get_const_values()), a->get_const_col_idxs(),
+            a->get_const_permutation(),
             as_cuda_type(b->get_const_values()),
             as_cuda_type(beta->get_const_values()),
             as_cuda_type(c->get_values()));
@@ -0,0 +1,86 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2022, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#include "core/solver/block_trs_kernels.hpp"
+
+
+#include <ginkgo/core/base/exception_helpers.hpp>
+#include <ginkgo/core/matrix/dense.hpp>
+#include <ginkgo/core/matrix/fbcsr.hpp>
+
+
+namespace gko {
+namespace kernels {
+namespace cuda {
+/**
+ * @brief The BLOCK_TRS solver namespace.
+ *
+ * @ingroup block_trs
+ */
+namespace block_trs {
+
+
+template <typename ValueType, typename IndexType>
+void invert_diagonal(std::shared_ptr<const CudaExecutor> exec,
+                     const matrix::Fbcsr<ValueType, IndexType>* matrix,
+                     ValueType* diag_inv) GKO_NOT_IMPLEMENTED;
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(
+    GKO_DECLARE_BLOCK_TRS_INVERT_DIAGONAL_KERNEL);
+
+
+template <typename ValueType, typename IndexType>
+void solve_lower(std::shared_ptr<const CudaExecutor> exec,
+                 const matrix::Fbcsr<ValueType, IndexType>* matrix,
+                 const ValueType* diag_inv, bool unit_diag,
+                 const matrix::Dense<ValueType>* b,
+                 matrix::Dense<ValueType>* x) GKO_NOT_IMPLEMENTED;
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(
+    GKO_DECLARE_BLOCK_TRS_SOLVE_LOWER_KERNEL);
+
+
+template <typename ValueType, typename IndexType>
+void solve_upper(std::shared_ptr<const CudaExecutor> exec,
+                 const matrix::Fbcsr<ValueType, IndexType>* matrix,
+                 const ValueType* diag_inv, bool unit_diag,
+                 const matrix::Dense<ValueType>* b,
+                 matrix::Dense<ValueType>* x) GKO_NOT_IMPLEMENTED;
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(
+    GKO_DECLARE_BLOCK_TRS_SOLVE_UPPER_KERNEL);
+
+
+}  // namespace block_trs
+}  // namespace cuda
+}  // namespace kernels
+}  // namespace gko
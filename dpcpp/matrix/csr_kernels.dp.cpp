@@ -43,6 +43,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ginkgo/core/base/array.hpp>
 #include <ginkgo/core/base/exception_helpers.hpp>
 #include <ginkgo/core/base/math.hpp>
+#include <ginkgo/core/base/precision_dispatch.hpp>
 #include <ginkgo/core/matrix/coo.hpp>
 #include <ginkgo/core/matrix/dense.hpp>
 #include <ginkgo/core/matrix/ell.hpp>
@@ -50,6 +51,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ginkgo/core/matrix/sellp.hpp>
 
 
+#include "core/base/mixed_precision_types.hpp"
 #include "core/base/utils.hpp"
 #include "core/components/fill_array_kernels.hpp"
 #include "core/components/prefix_sum_kernels.hpp"
@@ -1344,6 +1346,97 @@ GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(
     GKO_DECLARE_CSR_ADVANCED_SPMV_KERNEL);
 
 
+template <typename InputValueType, typename MatrixValueType,
+          typename OutputValueType, typename IndexType>
+void mixed_spmv(std::shared_ptr<const DpcppExecutor> exec,
+                const matrix::Csr<MatrixValueType, IndexType>* a,
+                const matrix::Dense<InputValueType>* b,
+                matrix::Dense<OutputValueType>* c)
+{
+    using arithmetic_type =
+        highest_precision<InputValueType, OutputValueType, MatrixValueType>;
+    const auto num_rows = a->get_size()[0];
+    const auto num_rhs = c->get_size()[1];
+    if (num_rows == 0 || num_rhs == 0) {
+        return;
+    }
+    const auto row_ptrs = a->get_const_row_ptrs();
+    const auto col_idxs = a->get_const_col_idxs();
+    const auto vals = a->get_const_values();
+    const auto b_vals = b->get_const_values();
+    const auto b_stride = b->get_stride();
+    auto c_vals = c->get_values();
+    const auto c_stride = c->get_stride();
+    exec->get_queue()->submit([&](sycl::handler& cgh) {
+        cgh.parallel_for(
+            sycl::range<2>{num_rows, num_rhs}, [=](sycl::id<2> idx) {
+                const auto row = static_cast<size_type>(idx[0]);
+                const auto col = static_cast<size_type>(idx[1]);
+                auto sum = zero<arithmetic_type>();
+                for (auto nz = row_ptrs[row]; nz < row_ptrs[row + 1]; nz++) {
+                    sum += static_cast<arithmetic_type>(vals[nz]) *
+                           static_cast<arithmetic_type>(
+                               b_vals[col_idxs[nz] * b_stride + col]);
+                }
+                c_vals[row * c_stride + col] =
+                    static_cast<OutputValueType>(sum);
+            });
+    });
+}
+
+GKO_INSTANTIATE_FOR_EACH_MIXED_VALUE_AND_INDEX_TYPE(
+    GKO_DECLARE_CSR_MIXED_SPMV_KERNEL);
+
+
+template <typename InputValueType, typename MatrixValueType,
+          typename OutputValueType, typename IndexType>
+void advanced_mixed_spmv(std::shared_ptr<const DpcppExecutor> exec,
+                         const matrix::Dense<MatrixValueType>* alpha,
+                         const matrix::Csr<MatrixValueType, IndexType>* a,
+                         const matrix::Dense<InputValueType>* b,
+                         const matrix::Dense<OutputValueType>* beta,
+                         matrix::Dense<OutputValueType>* c)
+{
+    using arithmetic_type =
+        highest_precision<InputValueType, OutputValueType, MatrixValueType>;
+    const auto num_rows = a->get_size()[0];
+    const auto num_rhs = c->get_size()[1];
+    if (num_rows == 0 || num_rhs == 0) {
+        return;
+    }
+    const auto row_ptrs = a->get_const_row_ptrs();
+    const auto col_idxs = a->get_const_col_idxs();
+    const auto vals = a->get_const_values();
+    const auto b_vals = b->get_const_values();
+    const auto b_stride = b->get_stride();
+    auto c_vals = c->get_values();
+    const auto c_stride = c->get_stride();
+    const auto alpha_val = alpha->get_const_values();
+    const auto beta_val = beta->get_const_values();
+    exec->get_queue()->submit([&](sycl::handler& cgh) {
+        cgh.parallel_for(
+            sycl::range<2>{num_rows, num_rhs}, [=](sycl::id<2> idx) {
+                const auto row = static_cast<size_type>(idx[0]);
+                const auto col = static_cast<size_type>(idx[1]);
+                auto sum = zero<arithmetic_type>();
+                for (auto nz = row_ptrs[row]; nz < row_ptrs[row + 1]; nz++) {
+                    sum += static_cast<arithmetic_type>(vals[nz]) *
+                           static_cast<arithmetic_type>(
+                               b_vals[col_idxs[nz] * b_stride + col]);
+                }
+                const auto c_ind = row * c_stride + col;
+                c_vals[c_ind] = static_cast<OutputValueType>(
+                    static_cast<arithmetic_type>(alpha_val[0]) * sum +
+                    static_cast<arithmetic_type>(beta_val[0]) *
+                        static_cast<arithmetic_type>(c_vals[c_ind]));
+            });
+    });
+}
+
+GKO_INSTANTIATE_FOR_EACH_MIXED_VALUE_AND_INDEX_TYPE(
+    GKO_DECLARE_CSR_ADVANCED_MIXED_SPMV_KERNEL);
+
+
 namespace kernel {
 
 
@@ -1870,6 +1963,16 @@ GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(
     GKO_DECLARE_CSR_ADVANCED_SPGEMM_KERNEL);
 
 
+template <typename ValueType, typename IndexType>
+void masked_spgemm(std::shared_ptr<const DpcppExecutor> exec,
+                   const matrix::Csr<ValueType, IndexType>* a,
+                   const matrix::Csr<ValueType, IndexType>* b,
+                   matrix::Csr<ValueType, IndexType>* c) GKO_NOT_IMPLEMENTED;
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(
+    GKO_DECLARE_CSR_MASKED_SPGEMM_KERNEL);
+
+
 template <typename ValueType, typename IndexType>
 void spgeam(std::shared_ptr<const DpcppExecutor> exec,
             const matrix::Dense<ValueType>* alpha,
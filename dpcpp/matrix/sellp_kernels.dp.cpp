@@ -75,6 +75,7 @@ void spmv_kernel(size_type num_rows, size_type num_right_hand_sides,
                  const size_type* __restrict__ slice_sets,
                  const ValueType* __restrict__ a,
                  const IndexType* __restrict__ cols,
+                 const IndexType* __restrict__ permutation,
                  const ValueType* __restrict__ b, ValueType* __restrict__ c,
                  sycl::nd_item<3> item_ct1)
 {
@@ -91,7 +92,8 @@ void spmv_kernel(size_type num_rows, size_type num_right_hand_sides,
                 val += a[ind] * b[col * b_stride + column_id];
             }
         }
-        c[row * c_stride + column_id] = val;
+        const auto out_row = permutation ? permutation[row] : row;
+        c[out_row * c_stride + column_id] = val;
     }
 }
 
@@ -106,6 +108,7 @@ void advanced_spmv_kernel(size_type num_rows, size_type num_right_hand_sides,
                           const ValueType* __restrict__ alpha,
                           const ValueType* __restrict__ a,
                           const IndexType* __restrict__ cols,
+                          const IndexType* __restrict__ permutation,
                           const ValueType* __restrict__ b,
                           const ValueType* __restrict__ beta,
                           ValueType* __restrict__ c, sycl::nd_item<3> item_ct1)
@@ -123,8 +126,9 @@ void advanced_spmv_kernel(size_type num_rows, size_type num_right_hand_sides,
                 val += a[ind] * b[col * b_stride + column_id];
             }
         }
-        c[row * c_stride + column_id] =
-            beta[0] * c[row * c_stride + column_id] + alpha[0] * val;
+        const auto out_row = permutation ? permutation[row] : row;
+        c[out_row * c_stride + column_id] =
+            beta[0] * c[out_row * c_stride + column_id] + alpha[0] * val;
     }
 }
 
@@ -147,7 +151,8 @@ void spmv(std::shared_ptr<const DpcppExecutor> exec,
                 b->get_size()[1], b->get_stride(), c->get_stride(),
                 a->get_slice_size(), a->get_const_slice_sets(),
                 a->get_const_values(), a->get_const_col_idxs(),
-                b->get_const_values(), c->get_values());
+                a->get_const_permutation(), b->get_const_values(),
+                c->get_values());
 }
 
 GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(GKO_DECLARE_SELLP_SPMV_KERNEL);
@@ -169,7 +174,8 @@ void advanced_spmv(std::shared_ptr<const DpcppExecutor> exec,
         gridSize, blockSize, 0, exec->get_queue(), a->get_size()[0],
         b->get_size()[1], b->get_stride(), c->get_stride(), a->get_slice_size(),
         a->get_const_slice_sets(), alpha->get_const_values(),
-        a->get_const_values(), a->get_const_col_idxs(), b->get_const_values(),
+        a->get_const_values(), a->get_const_col_idxs(),
+        a->get_const_permutation(), b->get_const_values(),
         beta->get_const_values(), c->get_values());
 }
 
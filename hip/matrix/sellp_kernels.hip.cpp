@@ -83,6 +83,7 @@ void spmv(std::shared_ptr<const HipExecutor> exec,
             b->get_size()[1], b->get_stride(), c->get_stride(),
             a->get_slice_size(), a->get_const_slice_sets(),
             as_hip_type(a->get_const_values()), a->get_const_col_idxs(),
+            a->get_const_permutation(),
             as_hip_type(b->get_const_values()), as_hip_type(c->get_values()));
     }
 }
@@ -109,6 +110,7 @@ void advanced_spmv(std::shared_ptr<const HipExecutor> exec,
             a->get_slice_size(), a->get_const_slice_sets(),
             as_hip_type(alpha->get_const_values()),
             as_hip_type(a->get_const_values()), a->get_const_col_idxs(),
+            a->get_const_permutation(),
             as_hip_type(b->get_const_values()),
             as_hip_type(beta->get_const_values()),
             as_hip_type(c->get_values()));
@@ -37,6 +37,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <memory>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 
 #include <ginkgo/config.hpp>
@@ -479,6 +480,27 @@ public:
         this->comm_.reset(new MPI_Comm(comm_out), comm_deleter{});
     }
 
+    /**
+     * Create a distributed graph communicator from an existing communicator
+     * (MPI_Dist_graph_create_adjacent). The neighborhood collectives of the
+     * new communicator only involve the given source and destination ranks.
+     *
+     * @param comm  The input communicator object.
+     * @param sources  the ranks this rank receives data from
+     * @param destinations  the ranks this rank sends data to
+     */
+    communicator(const communicator& comm, const std::vector<int>& sources,
+                 const std::vector<int>& destinations)
+    {
+        MPI_Comm comm_out;
+        GKO_ASSERT_NO_MPI_ERRORS(MPI_Dist_graph_create_adjacent(
+            comm.get(), static_cast<int>(sources.size()), sources.data(),
+            MPI_UNWEIGHTED, static_cast<int>(destinations.size()),
+            destinations.data(), MPI_UNWEIGHTED, MPI_INFO_NULL, false,
+            &comm_out));
+        this->comm_.reset(new MPI_Comm(comm_out), comm_deleter{});
+    }
+
     /**
      * Return the underlying MPI_Comm object.
      *
@@ -507,6 +529,25 @@ public:
      */
     int node_local_rank() const { return get_node_local_rank(); };
 
+    /**
+     * Create a communicator containing the ranks of this communicator that
+     * can share memory with the calling process, i.e. that run on the same
+     * node (MPI_Comm_split_type with MPI_COMM_TYPE_SHARED). The ranks keep
+     * their relative order.
+     *
+     * @return  the node local communicator
+     */
+    communicator node_local_communicator() const
+    {
+        MPI_Comm comm_out;
+        GKO_ASSERT_NO_MPI_ERRORS(
+            MPI_Comm_split_type(this->get(), MPI_COMM_TYPE_SHARED, 0,
+                                MPI_INFO_NULL, &comm_out));
+        communicator result{comm_out};
+        result.comm_.reset(new MPI_Comm(comm_out), comm_deleter{});
+        return result;
+    }
+
     /**
      * Compare two communicator objects for equality.
      *
@@ -1410,6 +1451,137 @@ public:
             recv_offsets, type_impl<RecvType>::get_type());
     }
 
+    /**
+     * Communicate data from all ranks to their neighbors with
+     * offsets (MPI_Neighbor_alltoallv). The communicator needs to be a
+     * distributed graph communicator, the counts and offsets are given per
+     * source and destination rank. See MPI documentation for more details.
+     *
+     * @param exec  The executor, on which the message buffers are located.
+     * @param send_buffer  the buffer to send
+     * @param send_count  the number of elements to send to each destination
+     * @param send_offsets  the offsets for the send buffer
+     * @param send_type  the MPI_Datatype for the send buffer
+     * @param recv_buffer  the buffer to gather into
+     * @param recv_count  the number of elements to receive from each source
+     * @param recv_offsets  the offsets for the recv buffer
+     * @param recv_type  the MPI_Datatype for the recv buffer
+     */
+    void neighbor_all_to_all_v(std::shared_ptr<const Executor> exec,
+                               const void* send_buffer, const int* send_counts,
+                               const int* send_offsets, MPI_Datatype send_type,
+                               void* recv_buffer, const int* recv_counts,
+                               const int* recv_offsets,
+                               MPI_Datatype recv_type) const
+    {
+        auto guard = exec->get_scoped_device_id_guard();
+        GKO_ASSERT_NO_MPI_ERRORS(MPI_Neighbor_alltoallv(
+            send_buffer, send_counts, send_offsets, send_type, recv_buffer,
+            recv_counts, recv_offsets, recv_type, this->get()));
+    }
+
+    /**
+     * Communicate data from all ranks to their neighbors with
+     * offsets (MPI_Neighbor_alltoallv). See MPI documentation for more
+     * details.
+     *
+     * @param exec  The executor, on which the message buffers are located.
+     * @param send_buffer  the buffer to send
+     * @param send_count  the number of elements to send to each destination
+     * @param send_offsets  the offsets for the send buffer
+     * @param recv_buffer  the buffer to gather into
+     * @param recv_count  the number of elements to receive from each source
+     * @param recv_offsets  the offsets for the recv buffer
+     *
+     * @tparam SendType  the type of the data to send. Has to be a type which
+     *                   has a specialization of type_impl that defines its
+     *                   MPI_Datatype.
+     * @tparam RecvType  the type of the data to receive. The same restrictions
+     *                   as for SendType apply.
+     */
+    template <typename SendType, typename RecvType>
+    void neighbor_all_to_all_v(std::shared_ptr<const Executor> exec,
+                               const SendType* send_buffer,
+                               const int* send_counts, const int* send_offsets,
+                               RecvType* recv_buffer, const int* recv_counts,
+                               const int* recv_offsets) const
+    {
+        this->neighbor_all_to_all_v(
+            std::move(exec), send_buffer, send_counts, send_offsets,
+            type_impl<SendType>::get_type(), recv_buffer, recv_counts,
+            recv_offsets, type_impl<RecvType>::get_type());
+    }
+
+    /**
+     * Communicate data from all ranks to their neighbors with
+     * offsets (MPI_Ineighbor_alltoallv). See MPI documentation for more
+     * details.
+     *
+     * @param exec  The executor, on which the message buffers are located.
+     * @param send_buffer  the buffer to send
+     * @param send_count  the number of elements to send to each destination
+     * @param send_offsets  the offsets for the send buffer
+     * @param send_type  the MPI_Datatype for the send buffer
+     * @param recv_buffer  the buffer to gather into
+     * @param recv_count  the number of elements to receive from each source
+     * @param recv_offsets  the offsets for the recv buffer
+     * @param recv_type  the MPI_Datatype for the recv buffer
+     *
+     * @return  the request handle for the call
+     */
+    request i_neighbor_all_to_all_v(std::shared_ptr<const Executor> exec,
+                                    const void* send_buffer,
+                                    const int* send_counts,
+                                    const int* send_offsets,
+                                    MPI_Datatype send_type, void* recv_buffer,
+                                    const int* recv_counts,
+                                    const int* recv_offsets,
+                                    MPI_Datatype recv_type) const
+    {
+        auto guard = exec->get_scoped_device_id_guard();
+        request req;
+        GKO_ASSERT_NO_MPI_ERRORS(MPI_Ineighbor_alltoallv(
+            send_buffer, send_counts, send_offsets, send_type, recv_buffer,
+            recv_counts, recv_offsets, recv_type, this->get(), req.get()));
+        return req;
+    }
+
+    /**
+     * Communicate data from all ranks to their neighbors with
+     * offsets (MPI_Ineighbor_alltoallv). See MPI documentation for more
+     * details.
+     *
+     * @param exec  The executor, on which the message buffers are located.
+     * @param send_buffer  the buffer to send
+     * @param send_count  the number of elements to send to each destination
+     * @param send_offsets  the offsets for the send buffer
+     * @param recv_buffer  the buffer to gather into
+     * @param recv_count  the number of elements to receive from each source
+     * @param recv_offsets  the offsets for the recv buffer
+     *
+     * @tparam SendType  the type of the data to send. Has to be a type which
+     *                   has a specialization of type_impl that defines its
+     *                   MPI_Datatype.
+     * @tparam RecvType  the type of the data to receive. The same restrictions
+     *                   as for SendType apply.
+     *
+     * @return  the request handle for the call
+     */
+    template <typename SendType, typename RecvType>
+    request i_neighbor_all_to_all_v(std::shared_ptr<const Executor> exec,
+                                    const SendType* send_buffer,
+                                    const int* send_counts,
+                                    const int* send_offsets,
+                                    RecvType* recv_buffer,
+                                    const int* recv_counts,
+                                    const int* recv_offsets) const
+    {
+        return this->i_neighbor_all_to_all_v(
+            std::move(exec), send_buffer, send_counts, send_offsets,
+            type_impl<SendType>::get_type(), recv_buffer, recv_counts,
+            recv_offsets, type_impl<RecvType>::get_type());
+    }
+
     /**
      * Does a scan operation with the given operator.
      * (MPI_Scan). See MPI documentation for more details.
@@ -1591,6 +1763,34 @@ public:
         }
     }
 
+    /**
+     * Allocate a window object in memory that is shared between all ranks of
+     * the communicator (MPI_Win_allocate_shared). A collective operation.
+     *
+     * The memory of every rank can be accessed directly through
+     * shared_query, so all ranks of the communicator need to run on the same
+     * node, see communicator::node_local_communicator.
+     *
+     * @param exec  The executor, on which the memory is accessed. Shared
+     *              memory is host memory, so this needs to be a host executor.
+     * @param num_elems  the number of elements of type ValueType allocated by
+     *                   the calling rank.
+     * @param comm  the node local communicator whose ranks share the window.
+     * @param input_info  the MPI_Info object used to set certain properties.
+     */
+    window(std::shared_ptr<const Executor> exec, int num_elems,
+           const communicator& comm, MPI_Info input_info = MPI_INFO_NULL)
+    {
+        if (exec != exec->get_master()) {
+            GKO_NOT_SUPPORTED(*exec);
+        }
+        ValueType* base{};
+        GKO_ASSERT_NO_MPI_ERRORS(MPI_Win_allocate_shared(
+            static_cast<MPI_Aint>(num_elems) * sizeof(ValueType),
+            sizeof(ValueType), input_info, comm.get(), &base,
+            &this->window_));
+    }
+
     /**
      * Get the underlying window object of MPI_Win type.
      *
@@ -1703,6 +1903,24 @@ public:
         GKO_ASSERT_NO_MPI_ERRORS(MPI_Win_flush_local_all(this->window_));
     }
 
+    /**
+     * Get a pointer to the memory of a rank in a window allocated in shared
+     * memory (MPI_Win_shared_query).
+     *
+     * @param rank  the rank whose memory should be accessed
+     *
+     * @return  the base pointer of the memory of the rank
+     */
+    ValueType* shared_query(int rank) const
+    {
+        MPI_Aint size{};
+        int disp_unit{};
+        ValueType* base{};
+        GKO_ASSERT_NO_MPI_ERRORS(MPI_Win_shared_query(
+            this->window_, rank, &size, &disp_unit, &base));
+        return base;
+    }
+
     /**
      * Synchronize the public and private buffers for the window object
      */
@@ -96,6 +96,37 @@ template <typename ValueType = default_precision, typename IndexType = int32>
 matrix_data<ValueType, IndexType> read_binary_raw(std::istream& is);
 
 
+/**
+ * Reads the entries of a contiguous range of rows from a matrix stored in
+ * Ginkgo's binary matrix format.
+ *
+ * In contrast to gko::read_binary_raw, only the entries inside the row range
+ * are read from the stream: their position is found by a binary search over
+ * the fixed-size entry blocks, which is narrowed down to a single row block if
+ * the stream contains the row block index written by
+ * gko::write_binary_indexed_raw. This allows multiple processes to read
+ * disjoint parts of a large matrix from the same file without parsing or
+ * storing all of it.
+ *
+ * @tparam ValueType  type of matrix values
+ * @tparam IndexType  type of matrix indexes
+ *
+ * @param is  seekable input stream positioned at the start of the matrix
+ * @param rows  the range of rows to read
+ *
+ * @return A matrix_data structure with the size of the full matrix, containing
+ *         only the nonzero elements in the given rows. The nonzero elements
+ *         are sorted in lexicographic order of their (row, column) indexes.
+ *
+ * @note The entries in the stream need to be sorted by row index, as they are
+ *       when written by gko::write_binary_indexed_raw or by gko::write_binary
+ *       from a matrix.
+ */
+template <typename ValueType = default_precision, typename IndexType = int32>
+matrix_data<ValueType, IndexType> read_binary_rows_raw(std::istream& is,
+                                                       span rows);
+
+
 /**
  * Reads a matrix stored in either binary or matrix market format from an input
  * stream.
@@ -170,6 +201,32 @@ void write_binary_raw(std::ostream& os,
                       const matrix_data<ValueType, IndexType>& data);
 
 
+/**
+ * Writes a matrix_data structure to a stream in binary format, sorted by row
+ * and followed by an index of row blocks.
+ *
+ * The header and entries are the same as the ones written by
+ * gko::write_binary_raw, so the result can still be read by
+ * gko::read_binary_raw. They are followed by a trailer consisting of
+ * num_blocks + 1 uint64 values storing the index of the first entry of each
+ * block of `rows_per_block` rows (and the total number of entries), and the
+ * three uint64 values rows_per_block, num_blocks and the magic GKOROWIX.
+ * gko::read_binary_rows_raw uses this index to locate the entries of a row
+ * range without searching the whole file.
+ *
+ * @tparam ValueType  type of matrix values
+ * @tparam IndexType  type of matrix indexes
+ *
+ * @param os  output stream where the data is to be written
+ * @param data  the matrix data to write
+ * @param rows_per_block  the number of rows per indexed block
+ */
+template <typename ValueType, typename IndexType>
+void write_binary_indexed_raw(std::ostream& os,
+                              const matrix_data<ValueType, IndexType>& data,
+                              size_type rows_per_block = 1024);
+
+
 /**
  * Reads a matrix stored in matrix market format from an input stream.
  *
@@ -41,6 +41,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 
 #include <ginkgo/core/base/dense_cache.hpp>
+#include <ginkgo/core/base/matrix_assembly_data.hpp>
 #include <ginkgo/core/base/mpi.hpp>
 #include <ginkgo/core/distributed/base.hpp>
 #include <ginkgo/core/distributed/lin_op.hpp>
@@ -155,6 +156,28 @@ template <typename ValueType>
 class Vector;
 
 
+/**
+ * Selects how a distributed Matrix overlaps the halo exchange with the
+ * computation of the local SpMV.
+ */
+enum class overlap_mode {
+    /**
+     * The local matrix is applied to all rows while the halo exchange is in
+     * progress, afterwards the non-local matrix is applied to all rows in a
+     * second pass.
+     */
+    local_non_local,
+    /**
+     * The interior rows, i.e. rows without non-local entries, are computed
+     * while the halo exchange is in progress. The remaining boundary rows are
+     * computed afterwards in a single pass over their local and non-local
+     * entries. This requires both stored matrices to be Csr matrices and a
+     * host executor (Reference or OpenMP), otherwise local_non_local is used.
+     */
+    interior_boundary
+};
+
+
 /**
  * The Matrix class defines a (MPI-)distributed matrix.
  *
@@ -253,7 +276,16 @@ class Vector;
  * // Applying to distributed multi-vectors computes an SpMV/SpMM product
  * A->apply(b, x)              // x = A*b
  * A->apply(alpha, b, beta, x) // x = alpha*A*b + beta*x
+ *
+ * // Distributed matrices can be multiplied and transposed
+ * auto C = A->multiply(B)     // C = A*B
+ * auto At = A->transpose()    // At = A^T
  * ```
+ * How the halo exchange is overlapped with the local computation can be
+ * chosen with set_overlap_mode. With set_node_aware_communication, ranks on
+ * the same node exchange their halo values through shared memory instead of
+ * MPI messages. With set_reduced_precision_communication, the halo values are
+ * sent in a lower precision to save bandwidth.
  *
  * @tparam ValueType  The underlying value type.
  * @tparam LocalIndexType  The index type used by the local matrices.
@@ -268,6 +300,7 @@ class Matrix
           Matrix<ValueType, LocalIndexType, GlobalIndexType>>,
       public ConvertibleTo<
           Matrix<next_precision<ValueType>, LocalIndexType, GlobalIndexType>>,
+      public Transposable,
       public DistributedBase {
     friend class EnableCreateMethod<Matrix>;
     friend class EnableDistributedPolymorphicObject<Matrix, LinOp>;
@@ -357,6 +390,106 @@ public:
         const Partition<local_index_type, global_index_type>* row_partition,
         const Partition<local_index_type, global_index_type>* col_partition);
 
+    /**
+     * Reads a square matrix from the matrix_assembly_data structure and a
+     * global partition.
+     *
+     * In contrast to the other overloads, the assembly data can contain
+     * entries for any global row. The entries for rows owned by other
+     * processes are sent to their owners with a single all-to-all
+     * communication, and the entries of all processes for the same position
+     * are summed up. This allows e.g. adding element contributions of a
+     * finite element assembly directly, regardless of which process owns the
+     * rows they belong to.
+     *
+     * @note This is a collective operation, all processes of the communicator
+     *       have to call it, even if they have no entries.
+     *
+     * @param data  The matrix_assembly_data structure.
+     * @param partition  The global row and column partition.
+     */
+    void read_distributed(
+        const matrix_assembly_data<value_type, global_index_type>& data,
+        const Partition<local_index_type, global_index_type>* partition);
+
+    /**
+     * Reads a matrix from the matrix_assembly_data structure, a global row
+     * partition, and a global column partition. The entries are sent to the
+     * processes owning their rows, see the overload above.
+     *
+     * @param data  The matrix_assembly_data structure.
+     * @param row_partition  The global row partition.
+     * @param col_partition  The global col partition.
+     */
+    void read_distributed(
+        const matrix_assembly_data<value_type, global_index_type>& data,
+        const Partition<local_index_type, global_index_type>* row_partition,
+        const Partition<local_index_type, global_index_type>* col_partition);
+
+    /**
+     * Migrates the matrix to a new global row and column partition.
+     *
+     * Each process sends the entries of its rows directly to their new
+     * owners, the global matrix is never assembled on a single process.
+     * Afterwards, the local and non-local matrices and the communication
+     * pattern are rebuilt as if the matrix had been read with the new
+     * partitions. The overlap mode and communication settings are kept.
+     *
+     * @note This is a collective operation, all processes of the communicator
+     *       have to call it.
+     *
+     * @param row_partition  The new global row partition.
+     * @param col_partition  The new global col partition.
+     */
+    void redistribute(
+        const Partition<local_index_type, global_index_type>* row_partition,
+        const Partition<local_index_type, global_index_type>* col_partition);
+
+    /**
+     * Migrates the matrix to a new global partition, which is used for both
+     * rows and columns, see the overload above.
+     *
+     * @param partition  The new global row and column partition.
+     */
+    void redistribute(
+        const Partition<local_index_type, global_index_type>* partition);
+
+    /**
+     * The transposed matrix uses the column partition of this matrix as its
+     * row partition and vice versa. Each entry is sent to the owner of its
+     * column, the global matrix is never assembled on a single process.
+     *
+     * @throw UnsupportedMatrixProperty  if the matrix has not been read with
+     *                                   read_distributed.
+     */
+    std::unique_ptr<LinOp> transpose() const override;
+
+    std::unique_ptr<LinOp> conj_transpose() const override;
+
+    /**
+     * Computes the distributed sparse matrix product of this matrix with
+     * another distributed matrix.
+     *
+     * The rows of `other` belonging to the non-local columns of this matrix
+     * are fetched from their owners along the communication pattern of the
+     * halo exchange, then each process computes its own rows of the product.
+     * The product has the row partition of this matrix, the column partition
+     * of `other`, and the storage formats of this matrix.
+     *
+     * @note The row partition of `other` has to match the column partition of
+     *       this matrix. This is a collective operation, all processes of the
+     *       communicator have to call it.
+     *
+     * @param other  The right factor of the product.
+     *
+     * @return  The product of this matrix and `other`.
+     *
+     * @throw UnsupportedMatrixProperty  if one of the matrices has not been
+     *                                   read with read_distributed, or if the
+     *                                   partitions don't match.
+     */
+    std::unique_ptr<Matrix> multiply(const Matrix* other) const;
+
     /**
      * Get read access to the stored local matrix.
      *
@@ -374,6 +507,275 @@ public:
         return non_local_mtx_;
     }
 
+    /**
+     * Starts a non-blocking communication of the values of b that are shared
+     * with other processors. Only the neighbors set up by read_distributed
+     * take part in the exchange.
+     *
+     * @param local_b  The full local vector to be communicated. The subset of
+     *                 shared values is automatically extracted.
+     * @return  MPI request for the non-blocking communication.
+     */
+    mpi::request communicate(const local_vector_type* local_b) const;
+
+    /**
+     * Stores the values received by communicate in the receive buffer. This
+     * has to be called after the request returned by communicate has
+     * completed. With the node-aware halo exchange, this also copies the
+     * values of the ranks on the same node.
+     */
+    void unpack_recv_buffer() const;
+
+    /**
+     * Get read access to the halo values received by the last call to
+     * communicate, in the order of the columns of the non-local matrix.
+     *
+     * @note  The values are only valid after unpack_recv_buffer was called.
+     *
+     * @return  the received halo values, or nullptr if communicate has not
+     *          been called yet
+     */
+    const local_vector_type* get_recv_buffer() const
+    {
+        return recv_buffer_.get();
+    }
+
+    /**
+     * Get read access to the row partition used in the last call to
+     * read_distributed.
+     *
+     * @return  Shared pointer to the row partition, or nullptr if the matrix
+     *          has not been read yet.
+     */
+    std::shared_ptr<const Partition<local_index_type, global_index_type>>
+    get_row_partition() const
+    {
+        return row_partition_;
+    }
+
+    /**
+     * Get read access to the column partition used in the last call to
+     * read_distributed.
+     *
+     * @return  Shared pointer to the column partition, or nullptr if the
+     *          matrix has not been read yet.
+     */
+    std::shared_ptr<const Partition<local_index_type, global_index_type>>
+    get_col_partition() const
+    {
+        return col_partition_;
+    }
+
+    /**
+     * Get read access to the mapping from the (compressed) columns of the
+     * non-local matrix to global column indices.
+     *
+     * @return  The array mapping non-local column indices to global indices.
+     */
+    const array<global_index_type>& get_non_local_to_global() const
+    {
+        return non_local_to_global_;
+    }
+
+    /**
+     * Get read access to the local row indices that are sent to other
+     * processes during the halo exchange. The indices sent to process `i`
+     * are stored in `[get_send_offsets()[i], get_send_offsets()[i + 1])`.
+     *
+     * @return  The array of local row indices that are sent.
+     */
+    const array<local_index_type>& get_gather_idxs() const
+    {
+        return gather_idxs_;
+    }
+
+    /**
+     * Get read access to the number of rows sent to each process during the
+     * halo exchange.
+     *
+     * @return  The number of rows sent to each process.
+     */
+    const std::vector<comm_index_type>& get_send_sizes() const
+    {
+        return send_sizes_;
+    }
+
+    /**
+     * Get read access to the offsets into get_gather_idxs() for each process.
+     *
+     * @return  The offsets of the rows sent to each process.
+     */
+    const std::vector<comm_index_type>& get_send_offsets() const
+    {
+        return send_offsets_;
+    }
+
+    /**
+     * Get read access to the number of rows received from each process during
+     * the halo exchange. The rows received from process `i` correspond to the
+     * non-local columns `[get_recv_offsets()[i], get_recv_offsets()[i + 1])`.
+     *
+     * @return  The number of rows received from each process.
+     */
+    const std::vector<comm_index_type>& get_recv_sizes() const
+    {
+        return recv_sizes_;
+    }
+
+    /**
+     * Get read access to the offsets of the rows received from each process.
+     *
+     * @return  The offsets of the rows received from each process.
+     */
+    const std::vector<comm_index_type>& get_recv_offsets() const
+    {
+        return recv_offsets_;
+    }
+
+    /**
+     * Get read access to the ranks that this process sends rows to during the
+     * halo exchange, in increasing order. Only these ranks take part in the
+     * neighborhood communication of communicate().
+     *
+     * @return  The ranks rows are sent to.
+     */
+    const std::vector<comm_index_type>& get_send_neighbors() const
+    {
+        return send_neighbors_;
+    }
+
+    /**
+     * Get read access to the ranks that this process receives rows from during
+     * the halo exchange, in increasing order.
+     *
+     * @return  The ranks rows are received from.
+     */
+    const std::vector<comm_index_type>& get_recv_neighbors() const
+    {
+        return recv_neighbors_;
+    }
+
+    /**
+     * Get read access to the local rows that have no non-local entries, in
+     * increasing order.
+     *
+     * @return  The interior rows.
+     */
+    const array<local_index_type>& get_interior_rows() const
+    {
+        return interior_rows_;
+    }
+
+    /**
+     * Get read access to the local rows that have non-local entries, in
+     * increasing order.
+     *
+     * @return  The boundary rows.
+     */
+    const array<local_index_type>& get_boundary_rows() const
+    {
+        return boundary_rows_;
+    }
+
+    /**
+     * Sets how the halo exchange is overlapped with the local computation in
+     * apply.
+     *
+     * @param mode  the new overlap mode
+     */
+    void set_overlap_mode(overlap_mode mode) { overlap_mode_ = mode; }
+
+    /**
+     * Returns how the halo exchange is overlapped with the local computation
+     * in apply.
+     *
+     * @return  the overlap mode
+     */
+    overlap_mode get_overlap_mode() const { return overlap_mode_; }
+
+    /**
+     * Enables or disables the node-aware halo exchange.
+     *
+     * If enabled, each rank gathers its send buffer into an MPI shared memory
+     * window that is accessible by all ranks on the same node. Ranks on the
+     * same node then copy the halo values directly from each other's send
+     * buffers in unpack_recv_buffer, so the copies overlap with the local
+     * SpMV, and only the messages to ranks on other nodes are sent through
+     * MPI. Each rank holds two send buffers in the window, which are used
+     * alternately, so a rank can only overwrite a send buffer after all ranks
+     * on the node have read it in the previous exchange. This requires a host
+     * executor, for other executors the regular halo exchange is used.
+     *
+     * The window is allocated with room for max_num_cols columns by this
+     * function if a matrix has already been read, and otherwise by
+     * read_distributed. Applies to vectors with more columns use the regular
+     * halo exchange.
+     *
+     * @note The window is allocated and freed collectively by all ranks of
+     *       the communicator. This function, read_distributed, copying or
+     *       converting the matrix, assigning to it and destroying it are
+     *       collective operations while the node-aware halo exchange is
+     *       enabled, so they have to be called on all ranks in the same order.
+     *
+     * @param enabled  whether the node-aware halo exchange should be used
+     * @param max_num_cols  the maximum number of columns of the vectors whose
+     *                      halo values are exchanged through the window
+     */
+    void set_node_aware_communication(bool enabled,
+                                      size_type max_num_cols = 1);
+
+    /**
+     * Returns whether the node-aware halo exchange is enabled.
+     *
+     * @return  true if the node-aware halo exchange is used on host executors
+     */
+    bool get_node_aware_communication() const
+    {
+        return node_aware_communication_;
+    }
+
+    /**
+     * Returns the maximum number of columns of the node-aware halo exchange.
+     *
+     * @return  the number of columns the shared memory window has room for
+     */
+    size_type get_node_aware_max_num_cols() const
+    {
+        return node_aware_max_num_cols_;
+    }
+
+    /**
+     * Enables or disables sending the halo values in reduced precision.
+     *
+     * If enabled, the send buffer is converted to next_precision<ValueType>
+     * before the halo exchange, and the received values are converted back
+     * before they are used. Only the halo values lose accuracy, which is
+     * usually acceptable for inexact applies, e.g. within preconditioners or
+     * in Krylov iterations far from convergence. The setting can be changed
+     * between two applies.
+     *
+     * @note This only has an effect if next_precision<ValueType> is smaller
+     *       than ValueType, e.g. for double and std::complex<double>. If the
+     *       node-aware halo exchange is used, it takes precedence.
+     *
+     * @param enabled  whether the halo values should be sent in reduced
+     *                 precision
+     */
+    void set_reduced_precision_communication(bool enabled)
+    {
+        reduced_precision_communication_ = enabled;
+    }
+
+    /**
+     * Returns whether the halo values are sent in reduced precision.
+     *
+     * @return  true if the halo values are sent in reduced precision
+     */
+    bool get_reduced_precision_communication() const
+    {
+        return reduced_precision_communication_;
+    }
+
     /**
      * Copy constructs a Matrix.
      *
@@ -527,32 +929,95 @@ protected:
                     const LinOp* non_local_matrix_template);
 
     /**
-     * Starts a non-blocking communication of the values of b that are shared
-     * with other processors.
+     * Performs the halo exchange of communicate through the shared memory
+     * window of the node-aware halo exchange, see
+     * set_node_aware_communication.
      *
-     * @param local_b  The full local vector to be communicated. The subset of
-     *                 shared values is automatically extracted.
-     * @return  MPI request for the non-blocking communication.
+     * @param local_b  The full local vector to be communicated.
+     * @return  MPI request for the non-blocking exchange with other nodes.
      */
-    mpi::request communicate(const local_vector_type* local_b) const;
+    mpi::request communicate_node_aware(const local_vector_type* local_b) const;
+
+    /**
+     * Returns whether the next call to communicate with a vector of num_cols
+     * columns uses the node-aware halo exchange, see
+     * set_node_aware_communication.
+     */
+    bool uses_node_aware_communication(size_type num_cols) const;
+
+    /**
+     * Returns whether the next call to communicate with a vector of num_cols
+     * columns sends the halo values in reduced precision, see
+     * set_reduced_precision_communication.
+     */
+    bool uses_reduced_precision_communication(size_type num_cols) const;
+
+    /**
+     * Frees the shared memory window of the node-aware halo exchange and
+     * allocates a new one for the current communication pattern if the
+     * node-aware halo exchange is enabled. A collective operation.
+     */
+    void init_node_exchange();
 
     void apply_impl(const LinOp* b, LinOp* x) const override;
 
     void apply_impl(const LinOp* alpha, const LinOp* b, const LinOp* beta,
                     LinOp* x) const override;
 
+    /**
+     * Computes the local part of alpha * A * b + beta * x with the interior and
+     * boundary rows computed separately, see overlap_mode::interior_boundary.
+     * If alpha and beta are nullptr, x = A * b is computed.
+     *
+     * @return  true if the product was computed, false if the stored matrices
+     *          or the executor don't support this mode.
+     */
+    bool apply_interior_boundary(const local_vector_type* alpha,
+                                 const local_vector_type* local_b,
+                                 const local_vector_type* beta,
+                                 local_vector_type* local_x) const;
+
 private:
+    struct node_exchange;
+
     std::vector<comm_index_type> send_offsets_;
     std::vector<comm_index_type> send_sizes_;
     std::vector<comm_index_type> recv_offsets_;
     std::vector<comm_index_type> recv_sizes_;
+    std::vector<comm_index_type> send_neighbors_;
+    std::vector<comm_index_type> neighbor_send_offsets_;
+    std::vector<comm_index_type> neighbor_send_sizes_;
+    std::vector<comm_index_type> recv_neighbors_;
+    std::vector<comm_index_type> neighbor_recv_offsets_;
+    std::vector<comm_index_type> neighbor_recv_sizes_;
+    // distributed graph communicator over the neighbors, nullptr as long as
+    // no matrix has been read
+    std::shared_ptr<mpi::communicator> neighbor_comm_;
+    array<local_index_type> interior_rows_;
+    array<local_index_type> boundary_rows_;
+    overlap_mode overlap_mode_;
+    bool node_aware_communication_;
+    size_type node_aware_max_num_cols_;
+    bool reduced_precision_communication_;
+    // whether the last call to communicate sent the halo values in reduced
+    // precision, so unpack_recv_buffer doesn't depend on the current settings
+    mutable bool reduced_precision_exchange_;
+    // shared memory state of the node-aware halo exchange, nullptr if it is
+    // disabled or no matrix has been read
+    std::shared_ptr<node_exchange> node_exchange_;
     array<local_index_type> gather_idxs_;
     array<global_index_type> non_local_to_global_;
+    std::shared_ptr<const Partition<local_index_type, global_index_type>>
+        row_partition_;
+    std::shared_ptr<const Partition<local_index_type, global_index_type>>
+        col_partition_;
     gko::detail::DenseCache<value_type> one_scalar_;
     gko::detail::DenseCache<value_type> host_send_buffer_;
     gko::detail::DenseCache<value_type> host_recv_buffer_;
     gko::detail::DenseCache<value_type> send_buffer_;
     gko::detail::DenseCache<value_type> recv_buffer_;
+    gko::detail::DenseCache<next_precision<value_type>> reduced_send_buffer_;
+    gko::detail::DenseCache<next_precision<value_type>> reduced_recv_buffer_;
     std::shared_ptr<LinOp> local_mtx_;
     std::shared_ptr<LinOp> non_local_mtx_;
 };
@@ -0,0 +1,90 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2022, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#ifndef GKO_PUBLIC_CORE_DISTRIBUTED_MTX_IO_HPP_
+#define GKO_PUBLIC_CORE_DISTRIBUTED_MTX_IO_HPP_
+
+
+#include <istream>
+#include <memory>
+
+
+#include <ginkgo/core/base/device_matrix_data.hpp>
+#include <ginkgo/core/base/executor.hpp>
+#include <ginkgo/core/base/types.hpp>
+#include <ginkgo/core/distributed/partition.hpp>
+
+
+namespace gko {
+namespace experimental {
+namespace distributed {
+
+
+/**
+ * Reads the rows owned by one part of a partition from a matrix stored in
+ * Ginkgo's binary matrix format.
+ *
+ * Each owned range of rows is read with gko::read_binary_rows_raw, so only
+ * the entries of these rows are read from the stream and stored. Calling this
+ * function on every process with its own rank as part id thus reads the
+ * whole matrix in parallel, without any process holding the global matrix
+ * data. The result can be passed directly to Matrix::read_distributed or
+ * Vector::read_distributed with the same partition.
+ *
+ * @param exec  the Executor on which the data should be stored
+ * @param is  seekable input stream positioned at the start of the matrix
+ * @param partition  the row partition, its size needs to match the number of
+ *                   rows of the matrix
+ * @param part_id  the part whose rows are read
+ *
+ * @return  the entries of all rows owned by part_id, using global indices and
+ *          the size of the global matrix
+ *
+ * @note The entries in the stream need to be sorted by row index, see
+ *       gko::read_binary_rows_raw. Streams written by
+ *       gko::write_binary_indexed_raw additionally contain a row block index
+ *       that avoids searching the whole file.
+ */
+template <typename ValueType, typename LocalIndexType,
+          typename GlobalIndexType>
+device_matrix_data<ValueType, GlobalIndexType> read_binary_distributed_raw(
+    std::shared_ptr<const Executor> exec, std::istream& is,
+    const Partition<LocalIndexType, GlobalIndexType>* partition,
+    comm_index_type part_id);
+
+
+}  // namespace distributed
+}  // namespace experimental
+}  // namespace gko
+
+
+#endif  // GKO_PUBLIC_CORE_DISTRIBUTED_MTX_IO_HPP_
@@ -0,0 +1,122 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2022, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+
+#ifndef GKO_PUBLIC_CORE_DISTRIBUTED_PARTITION_HELPERS_HPP_
+#define GKO_PUBLIC_CORE_DISTRIBUTED_PARTITION_HELPERS_HPP_
+
+
+#include <memory>
+
+
+#include <ginkgo/core/base/device_matrix_data.hpp>
+#include <ginkgo/core/base/executor.hpp>
+#include <ginkgo/core/base/types.hpp>
+#include <ginkgo/core/distributed/partition.hpp>
+
+
+namespace gko {
+namespace matrix {
+
+
+template <typename ValueType, typename IndexType>
+class Csr;
+
+
+}  // namespace matrix
+
+
+namespace experimental {
+namespace distributed {
+
+
+/**
+ * Builds a partition of the rows of a matrix by partitioning its adjacency
+ * graph, such that the number of rows per part is balanced and the number of
+ * entries coupling different parts is small. Since the halo of a distributed
+ * matrix consists of exactly these entries, this reduces the communication
+ * volume of the distributed SpMV compared to contiguous partitions.
+ *
+ * The graph is partitioned by a multilevel scheme: it is repeatedly coarsened
+ * by heavy-edge matching, the coarsest graph is partitioned by greedy graph
+ * growing, and the partition is refined on every level during uncoarsening by
+ * moving boundary vertices between parts (Fiduccia-Mattheyses gains under the
+ * balance constraint).
+ *
+ * The graph is given by the sparsity pattern of a square matrix, the values of
+ * the entries are ignored. The pattern doesn't need to be symmetric, it is
+ * symmetrized internally.
+ *
+ * @note The partitioning is computed sequentially on the host and is
+ *       deterministic, so all processes can compute the same partition
+ *       independently from the same global matrix.
+ *
+ * @param exec  the Executor on which the partition should be built
+ * @param graph  the matrix whose adjacency graph is partitioned
+ * @param num_parts  the number of parts
+ * @param imbalance  the maximum relative imbalance of the parts, i.e. no part
+ *                   has more than `(1 + imbalance) * size / num_parts` rows,
+ *                   unless a single row is heavier than that slack.
+ *
+ * @return  a Partition mapping each row to its part
+ */
+template <typename LocalIndexType, typename GlobalIndexType,
+          typename ValueType>
+std::unique_ptr<Partition<LocalIndexType, GlobalIndexType>>
+build_partition_from_graph(
+    std::shared_ptr<const Executor> exec,
+    const matrix::Csr<ValueType, GlobalIndexType>* graph,
+    comm_index_type num_parts, double imbalance = 0.03);
+
+
+/**
+ * @copydoc build_partition_from_graph(std::shared_ptr<const Executor>, const
+ * matrix::Csr<ValueType, GlobalIndexType>*, comm_index_type, double)
+ *
+ * @note The graph is given by the (global) matrix entries instead of a Csr
+ *       matrix, duplicate entries are allowed.
+ */
+template <typename LocalIndexType, typename GlobalIndexType,
+          typename ValueType>
+std::unique_ptr<Partition<LocalIndexType, GlobalIndexType>>
+build_partition_from_graph(
+    std::shared_ptr<const Executor> exec,
+    const device_matrix_data<ValueType, GlobalIndexType>& graph,
+    comm_index_type num_parts, double imbalance = 0.03);
+
+
+}  // namespace distributed
+}  // namespace experimental
+}  // namespace gko
+
+
+#endif  // GKO_PUBLIC_CORE_DISTRIBUTED_PARTITION_HELPERS_HPP_
@@ -0,0 +1,230 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2022, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+
+#ifndef GKO_PUBLIC_CORE_DISTRIBUTED_PRECONDITIONER_SCHWARZ_HPP_
+#define GKO_PUBLIC_CORE_DISTRIBUTED_PRECONDITIONER_SCHWARZ_HPP_
+
+
+#include <ginkgo/config.hpp>
+
+
+#if GINKGO_BUILD_MPI
+
+
+#include <ginkgo/core/base/abstract_factory.hpp>
+#include <ginkgo/core/base/dense_cache.hpp>
+#include <ginkgo/core/base/lin_op.hpp>
+#include <ginkgo/core/distributed/matrix.hpp>
+#include <ginkgo/core/distributed/vector.hpp>
+
+
+namespace gko {
+namespace experimental {
+namespace distributed {
+/**
+ * @brief The Preconditioner namespace.
+ *
+ * @ingroup precond
+ */
+namespace preconditioner {
+
+
+/**
+ * A Schwarz preconditioner is a simple domain decomposition preconditioner
+ * that generalizes the Block Jacobi preconditioner, incorporating options for
+ * different local subdomain solvers and overlaps between the subdomains.
+ *
+ * Each process treats the rows it owns (together with the optional overlap)
+ * as its subdomain and generates the local solver from the corresponding
+ * diagonal block of the distributed system matrix. Any LinOpFactory can be
+ * used as local solver, e.g. incomplete factorizations, direct solvers or
+ * multigrid.
+ *
+ * Without overlap (the default), the preconditioner is a block Jacobi
+ * preconditioner with one block per process, which requires no
+ * communication when it is applied.
+ *
+ * With an overlap of one, each subdomain is extended by the rows of the
+ * system matrix that belong to the non-local columns of the process, i.e.
+ * the halo rows that are already exchanged in a distributed SpMV. These rows
+ * are fetched once during the generation of the preconditioner, and the halo
+ * values of the right hand side are exchanged with the same communication
+ * pattern as the distributed SpMV. The result on the halo is discarded
+ * afterwards, which results in a restricted additive Schwarz (RAS)
+ * preconditioner.
+ *
+ * @note The overlap requires the system matrix to be square and to use the
+ *       same partition for its rows and columns.
+ *
+ * See Saad, Y., "Iterative Methods for Sparse Linear Systems", Chapter 14
+ * for a general treatment and variations of the method.
+ *
+ * @tparam ValueType  precision of matrix elements
+ * @tparam LocalIndexType  integral type of the preconditioner
+ * @tparam GlobalIndexType  integral type of the preconditioner
+ *
+ * @ingroup schwarz
+ * @ingroup precond
+ * @ingroup LinOp
+ */
+template <typename ValueType = default_precision,
+          typename LocalIndexType = int32, typename GlobalIndexType = int64>
+class Schwarz
+    : public EnableLinOp<Schwarz<ValueType, LocalIndexType, GlobalIndexType>> {
+    friend class EnableLinOp<Schwarz>;
+    friend class EnablePolymorphicObject<Schwarz, LinOp>;
+
+public:
+    using EnableLinOp<Schwarz>::convert_to;
+    using EnableLinOp<Schwarz>::move_to;
+    using value_type = ValueType;
+    using index_type = GlobalIndexType;
+    using local_index_type = LocalIndexType;
+    using global_index_type = GlobalIndexType;
+    using matrix_type = Matrix<ValueType, LocalIndexType, GlobalIndexType>;
+
+    /**
+     * Returns the solver that is applied on the local subdomain.
+     *
+     * @return  the local solver
+     */
+    std::shared_ptr<const LinOp> get_local_solver() const
+    {
+        return local_solver_;
+    }
+
+    /**
+     * Returns the matrix of the local subdomain, including the overlap if it
+     * is used.
+     *
+     * @return  the local subdomain matrix
+     */
+    std::shared_ptr<const LinOp> get_local_matrix() const
+    {
+        return local_matrix_;
+    }
+
+    GKO_CREATE_FACTORY_PARAMETERS(parameters, Factory)
+    {
+        /**
+         * Local solver factory.
+         */
+        std::shared_ptr<const LinOpFactory> GKO_FACTORY_PARAMETER_SCALAR(
+            local_solver, nullptr);
+
+        /**
+         * Number of layers of overlap between the subdomains.
+         *
+         * An overlap of 0 results in a block Jacobi preconditioner, an
+         * overlap of 1 in a restricted additive Schwarz preconditioner.
+         * Larger overlaps are currently not supported.
+         */
+        size_type GKO_FACTORY_PARAMETER_SCALAR(overlap, 0u);
+    };
+    GKO_ENABLE_LIN_OP_FACTORY(Schwarz, parameters, Factory);
+    GKO_ENABLE_BUILD_METHOD(Factory);
+
+protected:
+    /**
+     * Creates an empty Schwarz preconditioner.
+     *
+     * @param exec  the executor this object is assigned to
+     */
+    explicit Schwarz(std::shared_ptr<const Executor> exec)
+        : EnableLinOp<Schwarz>(std::move(exec))
+    {}
+
+    /**
+     * Creates a Schwarz preconditioner from a matrix using a
+     * Schwarz::Factory.
+     *
+     * @param factory  the factory to use to create the preconditoner
+     * @param system_matrix  the matrix this preconditioner should be created
+     *                       from
+     */
+    explicit Schwarz(const Factory* factory,
+                     std::shared_ptr<const LinOp> system_matrix)
+        : EnableLinOp<Schwarz>(factory->get_executor(),
+                               gko::transpose(system_matrix->get_size())),
+          parameters_{factory->get_parameters()}
+    {
+        this->generate(system_matrix);
+    }
+
+    /**
+     * Generates the preconditioner.
+     *
+     * @param system_matrix  the source matrix used to generate the
+     *                       preconditioner
+     */
+    void generate(std::shared_ptr<const LinOp> system_matrix);
+
+    /**
+     * Builds the local subdomain matrix extended by one layer of overlap.
+     *
+     * @param mtx  the distributed system matrix
+     *
+     * @return  the extended local matrix, where the rows and columns
+     *          [0, n) correspond to the owned rows, and the rows and columns
+     *          [n, n + h) to the non-local columns of the system matrix.
+     */
+    std::unique_ptr<LinOp> build_overlapping_matrix(
+        const matrix_type* mtx) const;
+
+    template <typename VectorType>
+    void apply_dense_impl(const VectorType* b, VectorType* x) const;
+
+    void apply_impl(const LinOp* b, LinOp* x) const override;
+
+    void apply_impl(const LinOp* alpha, const LinOp* b, const LinOp* beta,
+                    LinOp* x) const override;
+
+private:
+    std::shared_ptr<const matrix_type> system_matrix_;
+    std::shared_ptr<const LinOp> local_matrix_;
+    std::shared_ptr<const LinOp> local_solver_;
+    gko::detail::DenseCache<value_type> overlap_b_;
+    gko::detail::DenseCache<value_type> overlap_x_;
+};
+
+
+}  // namespace preconditioner
+}  // namespace distributed
+}  // namespace experimental
+}  // namespace gko
+
+
+#endif  // GINKGO_BUILD_MPI
+
+
+#endif  // GKO_PUBLIC_CORE_DISTRIBUTED_PRECONDITIONER_SCHWARZ_HPP_
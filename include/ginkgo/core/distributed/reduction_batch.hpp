@@ -0,0 +1,212 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2022, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#ifndef GKO_PUBLIC_CORE_DISTRIBUTED_REDUCTION_BATCH_HPP_
+#define GKO_PUBLIC_CORE_DISTRIBUTED_REDUCTION_BATCH_HPP_
+
+
+#include <ginkgo/config.hpp>
+
+
+#if GINKGO_BUILD_MPI
+
+
+#include <vector>
+
+
+#include <ginkgo/core/base/dense_cache.hpp>
+#include <ginkgo/core/base/mpi.hpp>
+#include <ginkgo/core/distributed/base.hpp>
+#include <ginkgo/core/distributed/vector.hpp>
+#include <ginkgo/core/matrix/dense.hpp>
+
+
+namespace gko {
+namespace experimental {
+namespace distributed {
+
+
+/**
+ * ReductionBatch combines several global reductions on distributed Vectors
+ * into a single MPI reduction.
+ *
+ * Each of Vector::compute_dot, Vector::compute_conj_dot and
+ * Vector::compute_norm2 performs its own blocking all-reduce. A solver that
+ * needs several of these values per iteration can instead register them with
+ * a ReductionBatch, which computes all local contributions into one packed
+ * buffer and reduces that buffer with a single all-reduce:
+ * ```
+ * ReductionBatch<ValueType> batch{exec, comm};
+ * batch.add_dot(r.get(), r_hat.get(), rho.get());
+ * batch.add_norm2(r.get(), res_norm.get());
+ * batch.reduce();
+ * ```
+ * The reduction can also be performed non-blocking: start() computes the
+ * local contributions and posts an mpi::communicator::i_all_reduce, so
+ * independent work can overlap the communication. The results are only
+ * written after a call to wait():
+ * ```
+ * batch.start();
+ * // ... work that does not depend on rho or res_norm ...
+ * batch.wait();
+ * ```
+ * After wait() (or reduce()) returns, the batch is empty and can be reused.
+ *
+ * @note The registered vectors and result objects are not owned by the batch,
+ *       they have to stay alive and unmodified until the reduction is
+ *       completed.
+ * @note Norms are computed as the square root of the conjugate dot product of
+ *       a vector with itself, so they can share the packed buffer with the
+ *       dot products.
+ *
+ * @tparam ValueType  The precision of the vectors and dot products.
+ *
+ * @ingroup distributed
+ */
+template <typename ValueType = double>
+class ReductionBatch : public DistributedBase {
+public:
+    using value_type = ValueType;
+    using vector_type = Vector<value_type>;
+    using dense_type = matrix::Dense<value_type>;
+    using real_dense_type = matrix::Dense<remove_complex<value_type>>;
+
+    /**
+     * Creates an empty ReductionBatch.
+     *
+     * @param exec  the executor on which the local contributions are computed
+     * @param comm  the communicator over which the reduction is performed
+     */
+    ReductionBatch(std::shared_ptr<const Executor> exec,
+                   mpi::communicator comm);
+
+    /**
+     * Adds the column-wise dot product of a and b to the batch.
+     *
+     * @param a  the first vector
+     * @param b  the second vector, with the same size as a
+     * @param result  a Dense row vector with one entry per column of a, it
+     *                receives the result when the reduction completes
+     */
+    void add_dot(const vector_type* a, const vector_type* b, LinOp* result);
+
+    /**
+     * Adds the column-wise conjugate dot product of a and b to the batch.
+     *
+     * @param a  the first vector, which will be conjugated
+     * @param b  the second vector, with the same size as a
+     * @param result  a Dense row vector with one entry per column of a, it
+     *                receives the result when the reduction completes
+     */
+    void add_conj_dot(const vector_type* a, const vector_type* b,
+                      LinOp* result);
+
+    /**
+     * Adds the column-wise Euclidean norm of a to the batch.
+     *
+     * @param a  the vector
+     * @param result  a real-valued Dense row vector with one entry per column
+     *                of a, it receives the result when the reduction completes
+     */
+    void add_norm2(const vector_type* a, LinOp* result);
+
+    /**
+     * Computes the local contributions of all registered reductions and
+     * starts the non-blocking global reduction.
+     *
+     * No reductions may be added until wait() has been called.
+     */
+    void start();
+
+    /**
+     * Waits for the global reduction started by start() to complete and
+     * writes the results. Afterwards, the batch is empty.
+     */
+    void wait();
+
+    /**
+     * Performs all registered reductions with a single blocking all-reduce.
+     * This is equivalent to calling start() followed by wait().
+     */
+    void reduce();
+
+    /**
+     * Returns the number of values that are reduced by the batch, i.e. the
+     * accumulated number of columns of all registered reductions.
+     *
+     * @return the number of reduced values
+     */
+    size_type get_num_values() const noexcept { return num_values_; }
+
+    /**
+     * Returns whether a global reduction was started and not yet completed.
+     *
+     * @return true if start() was called without a subsequent wait()
+     */
+    bool is_pending() const noexcept { return pending_; }
+
+private:
+    enum class reduction_kind { dot, conj_dot, norm2 };
+
+    struct entry {
+        reduction_kind kind;
+        const vector_type* a;
+        const vector_type* b;
+        LinOp* result;
+        size_type offset;
+        size_type num_cols;
+    };
+
+    void add_entry(reduction_kind kind, const vector_type* a,
+                   const vector_type* b, LinOp* result);
+
+    std::shared_ptr<const Executor> exec_;
+    std::vector<entry> entries_;
+    size_type num_values_;
+    bool pending_;
+    bool use_host_buffer_;
+    mpi::request request_;
+    ::gko::detail::DenseCache<value_type> buffer_;
+    ::gko::detail::DenseCache<value_type> host_buffer_;
+    array<char> tmp_;
+};
+
+
+}  // namespace distributed
+}  // namespace experimental
+}  // namespace gko
+
+
+#endif  // GINKGO_BUILD_MPI
+
+
+#endif  // GKO_PUBLIC_CORE_DISTRIBUTED_REDUCTION_BATCH_HPP_
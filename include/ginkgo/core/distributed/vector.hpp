@@ -154,6 +154,24 @@ public:
         const matrix_data<ValueType, GlobalIndexType>& data,
         const Partition<LocalIndexType, GlobalIndexType>* partition);
 
+    /**
+     * Migrates the vector from its current global row partition to a new one.
+     *
+     * Each process sends its rows directly to their new owners, the global
+     * vector is never assembled on a single process.
+     *
+     * @note This is a collective operation, all processes of the communicator
+     *       have to call it.
+     *
+     * @param old_partition  The global row partition the vector is currently
+     *                       distributed by.
+     * @param new_partition  The new global row partition.
+     */
+    template <typename LocalIndexType, typename GlobalIndexType>
+    void redistribute(
+        const Partition<LocalIndexType, GlobalIndexType>* old_partition,
+        const Partition<LocalIndexType, GlobalIndexType>* new_partition);
+
     void convert_to(Vector<next_precision<ValueType>>* result) const override;
 
     void move_to(Vector<next_precision<ValueType>>* result) override;
@@ -0,0 +1,273 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2022, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#ifndef GKO_PUBLIC_CORE_MATRIX_BLOCK_ELL_HPP_
+#define GKO_PUBLIC_CORE_MATRIX_BLOCK_ELL_HPP_
+
+
+#include <ginkgo/core/base/array.hpp>
+#include <ginkgo/core/base/lin_op.hpp>
+
+
+namespace gko {
+namespace matrix {
+
+
+template <typename ValueType>
+class Dense;
+
+template <typename ValueType, typename IndexType>
+class Csr;
+
+
+/**
+ * BlockEll is a blocked ELL format: the matrix is divided into dense
+ * `block_size x block_size` blocks, and every block row stores the same number
+ * of blocks (the largest number of nonzero blocks in any block row, obtainable
+ * through get_num_stored_blocks_per_row()). Like in Ell, the blocks and their
+ * block column indexes are stored in column-major fashion, i.e. the k-th block
+ * of block row `i` is stored at position `k * num_block_rows + i`, and padding
+ * blocks are marked by the block column index invalid_index<IndexType>(). The
+ * entries of each block are stored in row-major order.
+ *
+ * Storing a single column index per block and processing every block with a
+ * fully unrolled dense kernel makes the SpMV much faster than Csr for matrices
+ * with dense substructure, e.g. from PDEs with multiple unknowns per node.
+ *
+ * When converting a Csr matrix to a BlockEll matrix with block size 0 (the
+ * default), the block size is chosen automatically by detect_block_size().
+ * Converting a BlockEll matrix back to Csr stores all entries of the nonzero
+ * blocks, including explicit zeros.
+ *
+ * @tparam ValueType  precision of matrix elements
+ * @tparam IndexType  precision of matrix indexes
+ *
+ * @ingroup block_ell
+ * @ingroup mat_formats
+ * @ingroup LinOp
+ */
+template <typename ValueType = default_precision, typename IndexType = int32>
+class BlockEll : public EnableLinOp<BlockEll<ValueType, IndexType>>,
+                 public EnableCreateMethod<BlockEll<ValueType, IndexType>>,
+                 public ConvertibleTo<Csr<ValueType, IndexType>>,
+                 public ConvertibleTo<Dense<ValueType>>,
+                 public ReadableFromMatrixData<ValueType, IndexType>,
+                 public WritableToMatrixData<ValueType, IndexType> {
+    friend class EnableCreateMethod<BlockEll>;
+    friend class EnablePolymorphicObject<BlockEll, LinOp>;
+    friend class Csr<ValueType, IndexType>;
+
+public:
+    using EnableLinOp<BlockEll>::convert_to;
+    using EnableLinOp<BlockEll>::move_to;
+    using ReadableFromMatrixData<ValueType, IndexType>::read;
+
+    using value_type = ValueType;
+    using index_type = IndexType;
+    using mat_data = matrix_data<ValueType, IndexType>;
+    using device_mat_data = device_matrix_data<ValueType, IndexType>;
+
+    void convert_to(Csr<ValueType, IndexType>* result) const override;
+
+    void move_to(Csr<ValueType, IndexType>* result) override;
+
+    void convert_to(Dense<ValueType>* result) const override;
+
+    void move_to(Dense<ValueType>* result) override;
+
+    void read(const mat_data& data) override;
+
+    void read(const device_mat_data& data) override;
+
+    void read(device_mat_data&& data) override;
+
+    void write(mat_data& data) const override;
+
+    /**
+     * Chooses the block size for a matrix: among all block sizes up to
+     * `max_block_size` that divide both matrix dimensions, it returns the one
+     * for which the blocked storage (the values of all nonzero blocks plus one
+     * column index per block) is smallest. Matrices without dense
+     * substructure thus get block size 1.
+     *
+     * @param mtx  the matrix
+     * @param max_block_size  the largest block size to consider
+     *
+     * @return the block size with the smallest blocked storage
+     */
+    static int detect_block_size(const Csr<ValueType, IndexType>* mtx,
+                                 int max_block_size = 8);
+
+    /**
+     * Returns the size of the dense blocks, or 0 if the block size is chosen
+     * automatically on conversion and no matrix was converted yet.
+     *
+     * @return the block size
+     */
+    int get_block_size() const noexcept { return block_size_; }
+
+    /**
+     * Returns the number of block rows.
+     *
+     * @return the number of block rows
+     */
+    size_type get_num_block_rows() const noexcept
+    {
+        return block_size_ == 0 ? 0 : this->get_size()[0] / block_size_;
+    }
+
+    /**
+     * Returns the number of blocks stored in every block row.
+     *
+     * @return the number of blocks stored in every block row
+     */
+    size_type get_num_stored_blocks_per_row() const noexcept
+    {
+        return num_stored_blocks_per_row_;
+    }
+
+    /**
+     * Returns the number of elements explicitly stored in the matrix,
+     * including the padding.
+     *
+     * @return the number of elements explicitly stored in the matrix
+     */
+    size_type get_num_stored_elements() const noexcept
+    {
+        return values_.get_num_elems();
+    }
+
+    /**
+     * Returns the values of the matrix.
+     *
+     * @return the values of the matrix.
+     */
+    value_type* get_values() noexcept { return values_.get_data(); }
+
+    /**
+     * @copydoc BlockEll::get_values()
+     *
+     * @note This is the constant version of the function, which can be
+     *       significantly more memory efficient than the non-constant version,
+     *       so always prefer this version.
+     */
+    const value_type* get_const_values() const noexcept
+    {
+        return values_.get_const_data();
+    }
+
+    /**
+     * Returns the block column indexes of the matrix.
+     *
+     * @return the block column indexes of the matrix.
+     */
+    index_type* get_col_idxs() noexcept { return col_idxs_.get_data(); }
+
+    /**
+     * @copydoc BlockEll::get_col_idxs()
+     *
+     * @note This is the constant version of the function, which can be
+     *       significantly more memory efficient than the non-constant version,
+     *       so always prefer this version.
+     */
+    const index_type* get_const_col_idxs() const noexcept
+    {
+        return col_idxs_.get_const_data();
+    }
+
+    /**
+     * Copy-assigns a BlockEll matrix. Preserves the executor, copies the data.
+     */
+    BlockEll& operator=(const BlockEll&);
+
+    /**
+     * Move-assigns a BlockEll matrix. Preserves the executor, moves the data
+     * and leaves the moved-from object in an empty state (0x0 LinOp with
+     * unchanged executor and block size 0).
+     */
+    BlockEll& operator=(BlockEll&&);
+
+    /**
+     * Copy-constructs a BlockEll matrix. Inherits the executor and the data.
+     */
+    BlockEll(const BlockEll&);
+
+    /**
+     * Move-constructs a BlockEll matrix. Inherits the executor, moves the data
+     * and leaves the moved-from object in an empty state (0x0 LinOp with
+     * unchanged executor and block size 0).
+     */
+    BlockEll(BlockEll&&);
+
+protected:
+    /**
+     * Creates an uninitialized BlockEll matrix of the specified size.
+     *
+     * @param exec  Executor associated to the matrix
+     * @param block_size  the size of the dense blocks, or 0 to detect the
+     *                    block size when converting a matrix to BlockEll
+     * @param size  size of the matrix, needs to be divisible by the block size
+     * @param num_stored_blocks_per_row  the number of blocks stored in every
+     *                                   block row
+     */
+    BlockEll(std::shared_ptr<const Executor> exec, int block_size = 0,
+             const dim<2>& size = dim<2>{},
+             size_type num_stored_blocks_per_row = 0);
+
+    /**
+     * Resizes the matrix and its storage.
+     *
+     * @param block_size  the new block size
+     * @param size  the new size of the matrix
+     * @param num_stored_blocks_per_row  the new number of blocks per block row
+     */
+    void resize(int block_size, const dim<2>& size,
+                size_type num_stored_blocks_per_row);
+
+    void apply_impl(const LinOp* b, LinOp* x) const override;
+
+    void apply_impl(const LinOp* alpha, const LinOp* b, const LinOp* beta,
+                    LinOp* x) const override;
+
+private:
+    int block_size_;
+    size_type num_stored_blocks_per_row_;
+    array<value_type> values_;
+    array<index_type> col_idxs_;
+};
+
+
+}  // namespace matrix
+}  // namespace gko
+
+
+#endif  // GKO_PUBLIC_CORE_MATRIX_BLOCK_ELL_HPP_
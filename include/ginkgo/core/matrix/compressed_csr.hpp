@@ -0,0 +1,327 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2022, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#ifndef GKO_PUBLIC_CORE_MATRIX_COMPRESSED_CSR_HPP_
+#define GKO_PUBLIC_CORE_MATRIX_COMPRESSED_CSR_HPP_
+
+
+#include <ginkgo/core/base/array.hpp>
+#include <ginkgo/core/base/lin_op.hpp>
+
+
+namespace gko {
+namespace matrix {
+
+
+template <typename ValueType>
+class Dense;
+
+template <typename ValueType, typename IndexType>
+class Csr;
+
+
+/**
+ * CompressedCsr is a CSR matrix format with compressed column indexes.
+ *
+ * Instead of storing the full column index of every nonzero, each row stores
+ * its smallest column index as a base (see get_const_col_bases()) and the
+ * differences of the column indexes to this base as unsigned integers with the
+ * smallest width that fits all of them: 1 byte if the columns of the row span
+ * less than 256 columns, 2 bytes for less than 65536 columns, and 4 or 8 bytes
+ * otherwise. The width of each row is stored in get_const_col_widths(). The
+ * deltas of each row are stored as consecutive native-endian integers in the
+ * bytes starting at the 64-bit word get_const_col_offsets()[row] of
+ * get_const_col_deltas(), i.e. the k-th delta of a row occupies the bytes
+ * [k * width, (k + 1) * width) after the start of that word. The words only
+ * serve as storage that keeps the deltas of every row properly aligned and the
+ * offsets small enough for the index type, so the deltas have to be accessed
+ * bytewise and not by shifting and masking the words, whose byte order depends
+ * on the endianness of the platform.
+ *
+ * For matrices with a small bandwidth, like most finite element matrices, this
+ * reduces the memory needed for the column indexes by a factor of 2-4, which
+ * directly reduces the memory traffic of the bandwidth-bound SpMV.
+ *
+ * The values and row pointers are stored as in Csr.
+ *
+ * @tparam ValueType  precision of matrix elements
+ * @tparam IndexType  precision of matrix indexes
+ *
+ * @ingroup compressed_csr
+ * @ingroup mat_formats
+ * @ingroup LinOp
+ */
+template <typename ValueType = default_precision, typename IndexType = int32>
+class CompressedCsr
+    : public EnableLinOp<CompressedCsr<ValueType, IndexType>>,
+      public EnableCreateMethod<CompressedCsr<ValueType, IndexType>>,
+      public ConvertibleTo<Csr<ValueType, IndexType>>,
+      public ConvertibleTo<Dense<ValueType>>,
+      public ReadableFromMatrixData<ValueType, IndexType>,
+      public WritableToMatrixData<ValueType, IndexType> {
+    friend class EnableCreateMethod<CompressedCsr>;
+    friend class EnablePolymorphicObject<CompressedCsr, LinOp>;
+    friend class Csr<ValueType, IndexType>;
+
+public:
+    using EnableLinOp<CompressedCsr>::convert_to;
+    using EnableLinOp<CompressedCsr>::move_to;
+    using ReadableFromMatrixData<ValueType, IndexType>::read;
+
+    using value_type = ValueType;
+    using index_type = IndexType;
+    using mat_data = matrix_data<ValueType, IndexType>;
+    using device_mat_data = device_matrix_data<ValueType, IndexType>;
+
+    void convert_to(Csr<ValueType, IndexType>* result) const override;
+
+    void move_to(Csr<ValueType, IndexType>* result) override;
+
+    void convert_to(Dense<ValueType>* result) const override;
+
+    void move_to(Dense<ValueType>* result) override;
+
+    void read(const mat_data& data) override;
+
+    void read(const device_mat_data& data) override;
+
+    void read(device_mat_data&& data) override;
+
+    void write(mat_data& data) const override;
+
+    /**
+     * Returns the values of the matrix.
+     *
+     * @return the values of the matrix.
+     */
+    value_type* get_values() noexcept { return values_.get_data(); }
+
+    /**
+     * @copydoc CompressedCsr::get_values()
+     *
+     * @note This is the constant version of the function, which can be
+     *       significantly more memory efficient than the non-constant version,
+     *       so always prefer this version.
+     */
+    const value_type* get_const_values() const noexcept
+    {
+        return values_.get_const_data();
+    }
+
+    /**
+     * Returns the row pointers of the matrix.
+     *
+     * @return the row pointers of the matrix.
+     */
+    index_type* get_row_ptrs() noexcept { return row_ptrs_.get_data(); }
+
+    /**
+     * @copydoc CompressedCsr::get_row_ptrs()
+     *
+     * @note This is the constant version of the function, which can be
+     *       significantly more memory efficient than the non-constant version,
+     *       so always prefer this version.
+     */
+    const index_type* get_const_row_ptrs() const noexcept
+    {
+        return row_ptrs_.get_const_data();
+    }
+
+    /**
+     * Returns the smallest column index of each row.
+     *
+     * @return the column index bases of the rows.
+     */
+    index_type* get_col_bases() noexcept { return col_bases_.get_data(); }
+
+    /**
+     * @copydoc CompressedCsr::get_col_bases()
+     *
+     * @note This is the constant version of the function, which can be
+     *       significantly more memory efficient than the non-constant version,
+     *       so always prefer this version.
+     */
+    const index_type* get_const_col_bases() const noexcept
+    {
+        return col_bases_.get_const_data();
+    }
+
+    /**
+     * Returns the offsets of the rows in the column delta words.
+     *
+     * @return the word offsets of the rows.
+     */
+    index_type* get_col_offsets() noexcept { return col_offsets_.get_data(); }
+
+    /**
+     * @copydoc CompressedCsr::get_col_offsets()
+     *
+     * @note This is the constant version of the function, which can be
+     *       significantly more memory efficient than the non-constant version,
+     *       so always prefer this version.
+     */
+    const index_type* get_const_col_offsets() const noexcept
+    {
+        return col_offsets_.get_const_data();
+    }
+
+    /**
+     * Returns the number of bytes used for each column index delta of a row.
+     *
+     * @return the column index delta widths of the rows.
+     */
+    uint8* get_col_widths() noexcept { return col_widths_.get_data(); }
+
+    /**
+     * @copydoc CompressedCsr::get_col_widths()
+     *
+     * @note This is the constant version of the function, which can be
+     *       significantly more memory efficient than the non-constant version,
+     *       so always prefer this version.
+     */
+    const uint8* get_const_col_widths() const noexcept
+    {
+        return col_widths_.get_const_data();
+    }
+
+    /**
+     * Returns the storage of the byte-addressed column index deltas.
+     *
+     * @return the encoded column index deltas.
+     */
+    uint64* get_col_deltas() noexcept { return col_deltas_.get_data(); }
+
+    /**
+     * @copydoc CompressedCsr::get_col_deltas()
+     *
+     * @note This is the constant version of the function, which can be
+     *       significantly more memory efficient than the non-constant version,
+     *       so always prefer this version.
+     */
+    const uint64* get_const_col_deltas() const noexcept
+    {
+        return col_deltas_.get_const_data();
+    }
+
+    /**
+     * Returns the number of elements explicitly stored in the matrix.
+     *
+     * @return the number of elements explicitly stored in the matrix
+     */
+    size_type get_num_stored_elements() const noexcept
+    {
+        return values_.get_num_elems();
+    }
+
+    /**
+     * Returns the number of bytes used to store the column indexes, including
+     * the row bases, widths and offsets.
+     *
+     * @return the number of bytes used for the column indexes.
+     */
+    size_type get_num_index_bytes() const noexcept
+    {
+        return col_deltas_.get_num_elems() * sizeof(uint64) +
+               col_widths_.get_num_elems() +
+               (col_bases_.get_num_elems() + col_offsets_.get_num_elems()) *
+                   sizeof(index_type);
+    }
+
+    /**
+     * Copy-assigns a CompressedCsr matrix. Preserves the executor, copies the
+     * data.
+     */
+    CompressedCsr& operator=(const CompressedCsr&);
+
+    /**
+     * Move-assigns a CompressedCsr matrix. Preserves the executor, moves the
+     * data and leaves the moved-from object in an empty state (0x0 LinOp with
+     * unchanged executor, no nonzeros and valid row pointers and offsets).
+     */
+    CompressedCsr& operator=(CompressedCsr&&);
+
+    /**
+     * Copy-constructs a CompressedCsr matrix. Inherits the executor and the
+     * data.
+     */
+    CompressedCsr(const CompressedCsr&);
+
+    /**
+     * Move-constructs a CompressedCsr matrix. Inherits the executor, moves the
+     * data and leaves the moved-from object in an empty state (0x0 LinOp with
+     * unchanged executor, no nonzeros and valid row pointers and offsets).
+     */
+    CompressedCsr(CompressedCsr&&);
+
+protected:
+    /**
+     * Creates an empty CompressedCsr matrix of the specified size. The data
+     * is usually filled in by converting from Csr or reading matrix data.
+     *
+     * @param exec  Executor associated to the matrix
+     * @param size  size of the matrix
+     */
+    CompressedCsr(std::shared_ptr<const Executor> exec,
+                  const dim<2>& size = dim<2>{})
+        : EnableLinOp<CompressedCsr>(exec, size),
+          values_(exec),
+          row_ptrs_(exec, size[0] + 1),
+          col_bases_(exec, size[0]),
+          col_widths_(exec, size[0]),
+          col_offsets_(exec, size[0] + 1),
+          col_deltas_(exec)
+    {
+        row_ptrs_.fill(0);
+        col_bases_.fill(0);
+        col_offsets_.fill(0);
+    }
+
+    void apply_impl(const LinOp* b, LinOp* x) const override;
+
+    void apply_impl(const LinOp* alpha, const LinOp* b, const LinOp* beta,
+                    LinOp* x) const override;
+
+private:
+    array<value_type> values_;
+    array<index_type> row_ptrs_;
+    array<index_type> col_bases_;
+    array<uint8> col_widths_;
+    array<index_type> col_offsets_;
+    array<uint64> col_deltas_;
+};
+
+
+}  // namespace matrix
+}  // namespace gko
+
+
+#endif  // GKO_PUBLIC_CORE_MATRIX_COMPRESSED_CSR_HPP_
@@ -65,6 +65,15 @@ class Sellp;
 template <typename ValueType, typename IndexType>
 class SparsityCsr;
 
+template <typename ValueType, typename IndexType>
+class SymmetricCsr;
+
+template <typename ValueType, typename IndexType>
+class CompressedCsr;
+
+template <typename ValueType, typename IndexType>
+class BlockEll;
+
 template <typename ValueType, typename IndexType>
 class Csr;
 
@@ -134,6 +143,9 @@ class Csr : public EnableLinOp<Csr<ValueType, IndexType>>,
             public ConvertibleTo<Hybrid<ValueType, IndexType>>,
             public ConvertibleTo<Sellp<ValueType, IndexType>>,
             public ConvertibleTo<SparsityCsr<ValueType, IndexType>>,
+            public ConvertibleTo<SymmetricCsr<ValueType, IndexType>>,
+            public ConvertibleTo<CompressedCsr<ValueType, IndexType>>,
+            public ConvertibleTo<BlockEll<ValueType, IndexType>>,
             public DiagonalExtractable<ValueType>,
             public ReadableFromMatrixData<ValueType, IndexType>,
             public WritableToMatrixData<ValueType, IndexType>,
@@ -151,6 +163,9 @@ class Csr : public EnableLinOp<Csr<ValueType, IndexType>>,
     friend class Hybrid<ValueType, IndexType>;
     friend class Sellp<ValueType, IndexType>;
     friend class SparsityCsr<ValueType, IndexType>;
+    friend class SymmetricCsr<ValueType, IndexType>;
+    friend class CompressedCsr<ValueType, IndexType>;
+    friend class BlockEll<ValueType, IndexType>;
     friend class Fbcsr<ValueType, IndexType>;
     friend class CsrBuilder<ValueType, IndexType>;
     friend class Csr<to_complex<ValueType>, IndexType>;
@@ -739,6 +754,40 @@ public:
 
     void move_to(SparsityCsr<ValueType, IndexType>* result) override;
 
+    /**
+     * Converts the matrix to a SymmetricCsr matrix, which only stores the
+     * upper triangle of this matrix. The lower triangle of this matrix is
+     * assumed to be its (conjugate) transpose and ignored.
+     *
+     * @param result  the SymmetricCsr matrix to store the upper triangle in.
+     *                Whether it is interpreted as symmetric or Hermitian is
+     *                determined by result.
+     */
+    void convert_to(SymmetricCsr<ValueType, IndexType>* result) const override;
+
+    void move_to(SymmetricCsr<ValueType, IndexType>* result) override;
+
+    /**
+     * Converts the matrix to a CompressedCsr matrix, which stores the column
+     * indexes of each row as deltas to the smallest column index of the row.
+     *
+     * @param result  the CompressedCsr matrix to store the compressed matrix
+     *                in.
+     */
+    void convert_to(CompressedCsr<ValueType, IndexType>* result) const override;
+
+    void move_to(CompressedCsr<ValueType, IndexType>* result) override;
+
+    /**
+     * Converts the matrix to a BlockEll matrix. If the block size of the
+     * result is 0, it is chosen by BlockEll::detect_block_size.
+     *
+     * @param result  the BlockEll matrix to store the blocked matrix in.
+     */
+    void convert_to(BlockEll<ValueType, IndexType>* result) const override;
+
+    void move_to(BlockEll<ValueType, IndexType>* result) override;
+
     void read(const mat_data& data) override;
 
     void read(const device_mat_data& data) override;
@@ -788,6 +837,21 @@ public:
      */
     bool is_sorted_by_column_index() const;
 
+    /**
+     * Computes the product of this matrix with another CSR matrix, evaluated
+     * only at the nonzero positions of the result. The sparsity pattern of
+     * `result` is not changed and its values are overwritten, contributions
+     * to entries outside of its pattern are discarded.
+     *
+     * When `result` was computed as the product of matrices with the same
+     * sparsity patterns, e.g. by a previous call to apply, this recomputes
+     * its values without repeating the symbolic phase of the product.
+     *
+     * @param b  the right-hand factor of the product
+     * @param result  the matrix whose sparsity pattern is used as a mask
+     */
+    void multiply_masked(const Csr* b, Csr* result) const;
+
     /**
      * Returns the values of the matrix.
      *
@@ -60,6 +60,16 @@ class Csr;
  * This implementation uses the column index value invalid_index<IndexType>()
  * to mark padding entries that are not part of the sparsity pattern.
  *
+ * If the matrix is created with a sorting window (sigma) larger than 1, it is
+ * stored in the SELL-C-sigma format: within each window of sigma consecutive
+ * rows, the rows are sorted by decreasing number of nonzeros before they are
+ * distributed to the slices, which reduces the padding in each slice. The
+ * resulting row permutation is stored with the matrix and applied
+ * transparently, so the sorted storage is only visible through the raw
+ * accessors and get_const_permutation(). The sorting window is set on the
+ * target matrix before converting into it or reading data into it, e.g. by
+ * creating it with `Sellp::create(exec, slice_size, stride_factor, sigma)`.
+ *
  * @tparam ValueType  precision of matrix elements
  * @tparam IndexType  precision of matrix indexes
  *
@@ -217,6 +227,28 @@ public:
      */
     size_type get_stride_factor() const noexcept { return stride_factor_; }
 
+    /**
+     * Returns the sorting window (sigma) of SELL-C-sigma.
+     *
+     * @return the sorting window, 1 if the rows are stored in their original
+     *         order.
+     */
+    size_type get_sorting_window() const noexcept { return sorting_window_; }
+
+    /**
+     * Returns the row permutation of SELL-C-sigma: the i-th stored row is the
+     * row `permutation[i]` of the matrix.
+     *
+     * @return the row permutation, or nullptr if the rows are stored in their
+     *         original order.
+     */
+    const index_type* get_const_permutation() const noexcept
+    {
+        return permutation_.get_num_elems() > 0
+                   ? permutation_.get_const_data()
+                   : nullptr;
+    }
+
     /**
      * Returns the total column number.
      *
@@ -347,6 +379,24 @@ protected:
                 default_stride_factor, total_cols)
     {}
 
+    /**
+     * Creates an empty Sellp matrix with the specified parameters, which are
+     * used when data is read or converted into it.
+     *
+     * @param exec  Executor associated to the matrix
+     * @param slice_size  number of rows in each slice
+     * @param stride_factor  factor for the stride in each slice (strides
+     *                        should be multiples of the stride_factor)
+     * @param sorting_window  number of consecutive rows that are sorted by
+     *                        their number of nonzeros (sigma of SELL-C-sigma),
+     *                        1 keeps the original row order.
+     */
+    Sellp(std::shared_ptr<const Executor> exec, size_type slice_size,
+          size_type stride_factor, size_type sorting_window)
+        : Sellp(std::move(exec), dim<2>{}, slice_size, stride_factor, 0,
+                sorting_window)
+    {}
+
     /**
      * Creates an uninitialized Sellp matrix of the specified size.
      *
@@ -356,16 +406,22 @@ protected:
      * @param stride_factor  factor for the stride in each slice (strides
      *                        should be multiples of the stride_factor)
      * @param total_cols   number of the sum of all cols in every slice.
+     * @param sorting_window  number of consecutive rows that are sorted by
+     *                        their number of nonzeros (sigma of SELL-C-sigma),
+     *                        1 keeps the original row order.
      */
     Sellp(std::shared_ptr<const Executor> exec, const dim<2>& size,
-          size_type slice_size, size_type stride_factor, size_type total_cols)
+          size_type slice_size, size_type stride_factor, size_type total_cols,
+          size_type sorting_window = 1)
         : EnableLinOp<Sellp>(exec, size),
           values_(exec, slice_size * total_cols),
           col_idxs_(exec, slice_size * total_cols),
           slice_lengths_(exec, ceildiv(size[0], slice_size)),
           slice_sets_(exec, ceildiv(size[0], slice_size) + 1),
           slice_size_(slice_size),
-          stride_factor_(stride_factor)
+          stride_factor_(stride_factor),
+          sorting_window_(sorting_window),
+          permutation_(exec)
     {
         slice_sets_.fill(0);
         slice_lengths_.fill(0);
@@ -389,6 +445,8 @@ private:
     array<size_type> slice_sets_;
     size_type slice_size_;
     size_type stride_factor_;
+    size_type sorting_window_;
+    array<index_type> permutation_;
 };
 
 
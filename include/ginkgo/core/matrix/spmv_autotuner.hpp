@@ -0,0 +1,277 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2022, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#ifndef GKO_PUBLIC_CORE_MATRIX_SPMV_AUTOTUNER_HPP_
+#define GKO_PUBLIC_CORE_MATRIX_SPMV_AUTOTUNER_HPP_
+
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+
+#include <ginkgo/core/base/executor.hpp>
+#include <ginkgo/core/base/lin_op.hpp>
+#include <ginkgo/core/base/types.hpp>
+
+
+namespace gko {
+namespace matrix {
+
+
+template <typename ValueType, typename IndexType>
+class Csr;
+
+
+/**
+ * Selects how the SpmvAutotuner chooses the format of a matrix.
+ */
+enum class spmv_tuning_mode {
+    /**
+     * Chooses the format from the row length statistics of the matrix without
+     * running any SpMV.
+     */
+    model,
+    /**
+     * Converts the matrix to all candidate formats and times a few SpMVs with
+     * each of them.
+     */
+    trial
+};
+
+
+/**
+ * The row length statistics of a sparse matrix the SpmvAutotuner bases its
+ * decisions on.
+ */
+struct spmv_matrix_features {
+    size_type num_rows;
+    size_type num_cols;
+    size_type num_nonzeros;
+    size_type num_empty_rows;
+    size_type max_row_nonzeros;
+    /** mean number of nonzeros per row */
+    double mean_row_nonzeros;
+    /** standard deviation of the number of nonzeros per row */
+    double row_nonzeros_deviation;
+    /** ratio of the entries stored by Ell to the number of nonzeros */
+    double ell_padding;
+    /** ratio of the entries stored by Sellp to the number of nonzeros */
+    double sellp_padding;
+
+    /**
+     * Returns the key of the matrix in the decision cache. Matrices with
+     * similar statistics (e.g. the same order of magnitude of the size and
+     * similar row length distributions) share the same key, so that decisions
+     * carry over to matrices that were never tuned.
+     *
+     * @return the cache key of the matrix
+     */
+    std::string get_key() const;
+};
+
+
+/**
+ * SpmvAutotuner chooses the fastest storage format and SpMV strategy for a
+ * matrix on a given executor and returns the matrix in that format.
+ *
+ * The candidates are Csr with all strategies available on the executor, Coo,
+ * Ell, Sellp and Hybrid with its imbalance and minimal storage strategies.
+ * Depending on the spmv_tuning_mode, the choice is made either by timing a few
+ * SpMVs with every candidate, or by a cheap model based on the row length
+ * statistics (Ell and Sellp for little padding, Coo for many empty rows,
+ * Hybrid for highly imbalanced rows and Csr otherwise).
+ *
+ * Decisions can be persisted in a cache file which maps the cache key of a
+ * matrix (see get_cache_key) to the chosen format. Matrices whose key is
+ * already in the cache are converted without any tuning. Since the best format
+ * depends on the hardware, the key includes the executor type, so a cache file
+ * can be shared between executor types, but not between different hardware.
+ *
+ * ```cpp
+ * auto tuner = gko::matrix::SpmvAutotuner<double, int>{exec};
+ * tuner.set_cache_file("spmv_formats.txt");
+ * auto tuned = tuner.tune(csr.get());
+ * tuned->apply(b.get(), x.get());
+ * ```
+ *
+ * @tparam ValueType  precision of the matrix elements
+ * @tparam IndexType  precision of the matrix indexes
+ *
+ * @ingroup mat_formats
+ */
+template <typename ValueType = default_precision, typename IndexType = int32>
+class SpmvAutotuner {
+public:
+    using value_type = ValueType;
+    using index_type = IndexType;
+    using csr_type = Csr<ValueType, IndexType>;
+
+    /**
+     * Creates an autotuner for the given executor.
+     *
+     * @param exec  the executor the SpMVs are run on
+     * @param mode  whether to time the candidates or use the model
+     * @param num_repetitions  the number of timed SpMVs per candidate
+     * @param num_rhs  the number of right-hand sides the SpMVs are timed with
+     */
+    explicit SpmvAutotuner(std::shared_ptr<const Executor> exec,
+                           spmv_tuning_mode mode = spmv_tuning_mode::trial,
+                           size_type num_repetitions = 10,
+                           size_type num_rhs = 1);
+
+    /**
+     * Uses the given file as persistent decision cache. Existing decisions are
+     * loaded from the file (a missing file is treated as an empty cache), and
+     * the file is rewritten whenever a new decision is made.
+     *
+     * @param filename  the name of the cache file
+     */
+    void set_cache_file(std::string filename);
+
+    /**
+     * Chooses the best format for the matrix and converts it to this format.
+     *
+     * @param mtx  the matrix to tune
+     *
+     * @return the matrix in the chosen format, on the autotuner's executor
+     */
+    std::unique_ptr<LinOp> tune(const csr_type* mtx);
+
+    /**
+     * Returns the key of a matrix in the decision cache. It extends
+     * spmv_matrix_features::get_key by the executor type, the value and index
+     * type and the number of right-hand sides.
+     *
+     * @param features  the row length statistics of the matrix
+     *
+     * @return the cache key of the matrix
+     */
+    std::string get_cache_key(const spmv_matrix_features& features) const;
+
+    /**
+     * Converts the matrix to the given candidate format.
+     *
+     * @param mtx  the matrix to convert
+     * @param format  one of the names returned by get_candidates()
+     *
+     * @return the matrix in the given format, on the autotuner's executor
+     */
+    std::unique_ptr<LinOp> convert(const csr_type* mtx,
+                                   const std::string& format) const;
+
+    /**
+     * Returns the names of the candidate formats on the autotuner's executor.
+     *
+     * @return the names of the candidate formats
+     */
+    std::vector<std::string> get_candidates() const;
+
+    /**
+     * Returns the format chosen by the last call to tune().
+     *
+     * @return the name of the last chosen format
+     */
+    const std::string& get_last_format() const noexcept
+    {
+        return last_format_;
+    }
+
+    /**
+     * Returns whether the last decision was taken from the cache.
+     *
+     * @return true if the last decision was taken from the cache
+     */
+    bool last_from_cache() const noexcept { return last_from_cache_; }
+
+    /**
+     * Returns the average SpMV runtime in seconds of every candidate timed by
+     * the last call to tune(). It is empty if no trials were run.
+     *
+     * @return the runtimes of the candidates of the last trials
+     */
+    const std::map<std::string, double>& get_last_timings() const noexcept
+    {
+        return last_timings_;
+    }
+
+    /**
+     * Returns the cached decisions, mapping cache keys to formats.
+     *
+     * @return the cached decisions
+     */
+    const std::map<std::string, std::string>& get_cache() const noexcept
+    {
+        return cache_;
+    }
+
+    /**
+     * Computes the row length statistics of a matrix.
+     *
+     * @param mtx  the matrix
+     *
+     * @return the row length statistics of the matrix
+     */
+    static spmv_matrix_features compute_features(const csr_type* mtx);
+
+    /**
+     * Chooses a format from the row length statistics alone.
+     *
+     * @param features  the row length statistics of the matrix
+     *
+     * @return the name of the chosen format
+     */
+    static std::string choose_by_model(const spmv_matrix_features& features);
+
+private:
+    double time_spmv(const LinOp* mtx) const;
+
+    void write_cache() const;
+
+    std::shared_ptr<const Executor> exec_;
+    spmv_tuning_mode mode_;
+    size_type num_repetitions_;
+    size_type num_rhs_;
+    std::string cache_file_;
+    std::map<std::string, std::string> cache_;
+    std::string last_format_;
+    bool last_from_cache_;
+    std::map<std::string, double> last_timings_;
+};
+
+
+}  // namespace matrix
+}  // namespace gko
+
+
+#endif  // GKO_PUBLIC_CORE_MATRIX_SPMV_AUTOTUNER_HPP_
@@ -0,0 +1,254 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2022, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#ifndef GKO_PUBLIC_CORE_MATRIX_STENCIL_HPP_
+#define GKO_PUBLIC_CORE_MATRIX_STENCIL_HPP_
+
+
+#include <ginkgo/core/base/array.hpp>
+#include <ginkgo/core/base/lin_op.hpp>
+
+
+namespace gko {
+namespace matrix {
+
+
+template <typename ValueType>
+class Dense;
+
+template <typename ValueType, typename IndexType>
+class Csr;
+
+
+/**
+ * Stencil is a matrix-free operator applying a stencil on a structured grid.
+ *
+ * The grid has `grid_size[0] x grid_size[1] x grid_size[2]` points, 1D and 2D
+ * grids use 1 for the unused dimensions. The grid point (x, y, z) corresponds
+ * to the row and column `x + grid_size[0] * (y + grid_size[1] * z)`, so the
+ * first dimension is the fastest running one.
+ *
+ * The stencil consists of a set of points, given by their offsets
+ * `(dx, dy, dz)` (stored consecutively in the offset array) and their
+ * coefficients. Applying the stencil to a vector b computes
+ *
+ *     c(x, y, z) = sum_p coefficient_p * b(x + dx_p, y + dy_p, z + dz_p),
+ *
+ * where all neighbors outside of the grid are skipped, which corresponds to
+ * homogeneous Dirichlet boundary conditions. The offsets of different stencil
+ * points need to be distinct. The coefficients can either be constant, with
+ * one coefficient per stencil point, or vary over the grid, with the
+ * coefficient of stencil point p at grid row r stored at `p * num_rows + r`.
+ *
+ * Compared to assembling the operator as a Csr matrix, only the (constant)
+ * coefficients need to be read from memory, so the SpMV only streams the
+ * input and output vectors. For setting up preconditioners, the stencil can
+ * be converted to a Csr matrix.
+ *
+ * @tparam ValueType  precision of the coefficients
+ * @tparam IndexType  precision of the offsets and of converted matrices
+ *
+ * @ingroup stencil
+ * @ingroup mat_formats
+ * @ingroup LinOp
+ */
+template <typename ValueType = default_precision, typename IndexType = int32>
+class Stencil : public EnableLinOp<Stencil<ValueType, IndexType>>,
+                public EnableCreateMethod<Stencil<ValueType, IndexType>>,
+                public ConvertibleTo<Csr<ValueType, IndexType>>,
+                public ConvertibleTo<Dense<ValueType>>,
+                public WritableToMatrixData<ValueType, IndexType> {
+    friend class EnableCreateMethod<Stencil>;
+    friend class EnablePolymorphicObject<Stencil, LinOp>;
+
+public:
+    using EnableLinOp<Stencil>::convert_to;
+    using EnableLinOp<Stencil>::move_to;
+
+    using value_type = ValueType;
+    using index_type = IndexType;
+    using mat_data = matrix_data<ValueType, IndexType>;
+
+    void convert_to(Csr<ValueType, IndexType>* result) const override;
+
+    void move_to(Csr<ValueType, IndexType>* result) override;
+
+    void convert_to(Dense<ValueType>* result) const override;
+
+    void move_to(Dense<ValueType>* result) override;
+
+    void write(mat_data& data) const override;
+
+    /**
+     * Returns the size of the grid the stencil is applied on.
+     *
+     * @return the number of grid points in each dimension
+     */
+    const dim<3>& get_grid_size() const noexcept { return grid_size_; }
+
+    /**
+     * Returns the number of points of the stencil.
+     *
+     * @return the number of points of the stencil
+     */
+    size_type get_num_points() const noexcept
+    {
+        return offsets_.get_num_elems() / 3;
+    }
+
+    /**
+     * Returns whether the coefficients vary over the grid.
+     *
+     * @return true if there is a coefficient per stencil point and grid point,
+     *         false if there is a single coefficient per stencil point.
+     */
+    bool has_variable_coefficients() const noexcept
+    {
+        return coefficients_.get_num_elems() != this->get_num_points();
+    }
+
+    /**
+     * Returns the offsets of the stencil points, with the three offsets of
+     * each point stored consecutively.
+     *
+     * @return the offsets of the stencil points
+     *
+     * @note the offsets can not be modified, since they determine the sparsity
+     *       pattern of the operator.
+     */
+    const index_type* get_const_offsets() const noexcept
+    {
+        return offsets_.get_const_data();
+    }
+
+    /**
+     * Returns the coefficients of the stencil points.
+     *
+     * @return the coefficients of the stencil points
+     */
+    value_type* get_coefficients() noexcept
+    {
+        return coefficients_.get_data();
+    }
+
+    /**
+     * @copydoc Stencil::get_coefficients()
+     *
+     * @note This is the constant version of the function, which can be
+     *       significantly more memory efficient than the non-constant version,
+     *       so always prefer this version.
+     */
+    const value_type* get_const_coefficients() const noexcept
+    {
+        return coefficients_.get_const_data();
+    }
+
+    /**
+     * Returns the number of coefficients stored.
+     *
+     * @return the number of coefficients stored
+     */
+    size_type get_num_stored_coefficients() const noexcept
+    {
+        return coefficients_.get_num_elems();
+    }
+
+    /**
+     * Copy-assigns a Stencil. Preserves the executor, copies the grid size,
+     * offsets and coefficients.
+     */
+    Stencil& operator=(const Stencil&);
+
+    /**
+     * Move-assigns a Stencil. Preserves the executor, moves the data and
+     * leaves the moved-from object in an empty state (empty grid with
+     * unchanged executor and no stencil points).
+     */
+    Stencil& operator=(Stencil&&);
+
+    /**
+     * Copy-constructs a Stencil. Inherits the executor and the data.
+     */
+    Stencil(const Stencil&);
+
+    /**
+     * Move-constructs a Stencil. Inherits the executor, moves the data and
+     * leaves the moved-from object in an empty state (empty grid with
+     * unchanged executor and no stencil points).
+     */
+    Stencil(Stencil&&);
+
+protected:
+    /**
+     * Creates an empty stencil on an empty grid.
+     *
+     * @param exec  Executor associated to the stencil
+     */
+    Stencil(std::shared_ptr<const Executor> exec)
+        : Stencil(std::move(exec), dim<3>{0, 0, 0}, array<index_type>{},
+                  array<value_type>{})
+    {}
+
+    /**
+     * Creates a stencil operator on a structured grid.
+     *
+     * @param exec  Executor associated to the stencil
+     * @param grid_size  number of grid points in each dimension
+     * @param offsets  the offsets (dx, dy, dz) of the stencil points, stored
+     *                 consecutively
+     * @param coefficients  the coefficients of the stencil points, either one
+     *                      per stencil point, or one per stencil point and
+     *                      grid point.
+     *
+     * @note If `offsets` or `coefficients` are not on the same executor as
+     *       the stencil, they will be copied to it.
+     */
+    Stencil(std::shared_ptr<const Executor> exec, const dim<3>& grid_size,
+            array<index_type> offsets, array<value_type> coefficients);
+
+    void apply_impl(const LinOp* b, LinOp* x) const override;
+
+    void apply_impl(const LinOp* alpha, const LinOp* b, const LinOp* beta,
+                    LinOp* x) const override;
+
+private:
+    dim<3> grid_size_;
+    array<index_type> offsets_;
+    array<value_type> coefficients_;
+};
+
+
+}  // namespace matrix
+}  // namespace gko
+
+
+#endif  // GKO_PUBLIC_CORE_MATRIX_STENCIL_HPP_
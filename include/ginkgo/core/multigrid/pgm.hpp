@@ -64,6 +64,13 @@ namespace multigrid {
  * un-aggregated elements are assigned to an aggregated group
  * or are left alone.
  *
+ * If the system matrix is an experimental::distributed::Matrix, each process
+ * aggregates its local rows independently, so the aggregates never cross
+ * process boundaries. The coarse matrix, prolongation and restriction are then
+ * distributed matrices as well. Once the coarse problem becomes too small (see
+ * min_coarse_rows_per_rank), the coarse rows are agglomerated onto fewer
+ * processes.
+ *
  * @tparam ValueType  precision of matrix elements
  * @tparam IndexType  precision of matrix indexes
  *
@@ -151,6 +158,17 @@ public:
          * incorrect.
          */
         bool GKO_FACTORY_PARAMETER_SCALAR(skip_sorting, false);
+
+        /**
+         * The minimal average number of coarse rows per process for
+         * distributed system matrices. If the coarse matrix has fewer rows
+         * than this value times the number of processes, its rows are
+         * agglomerated onto `max(1, coarse_rows / min_coarse_rows_per_rank)`
+         * evenly spaced processes, while the remaining processes keep no rows.
+         * The default value 0 disables the agglomeration. It is ignored for
+         * non-distributed system matrices.
+         */
+        size_type GKO_FACTORY_PARAMETER_SCALAR(min_coarse_rows_per_rank, 0u);
     };
     GKO_ENABLE_LIN_OP_FACTORY(Pgm, parameters, Factory);
     GKO_ENABLE_BUILD_METHOD(Factory);
@@ -189,6 +207,13 @@ protected:
 
     void generate();
 
+#if GINKGO_BUILD_MPI
+    /**
+     * Generates the multigrid level for a distributed system matrix.
+     */
+    void generate_distributed();
+#endif
+
 private:
     std::shared_ptr<const LinOp> system_matrix_{};
     array<IndexType> agg_;
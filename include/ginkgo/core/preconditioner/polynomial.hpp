@@ -0,0 +1,275 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2022, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+
+#ifndef GKO_PUBLIC_CORE_PRECONDITIONER_POLYNOMIAL_HPP_
+#define GKO_PUBLIC_CORE_PRECONDITIONER_POLYNOMIAL_HPP_
+
+
+#include <memory>
+#include <vector>
+
+
+#include <ginkgo/core/base/abstract_factory.hpp>
+#include <ginkgo/core/base/lin_op.hpp>
+#include <ginkgo/core/base/types.hpp>
+
+
+namespace gko {
+namespace preconditioner {
+namespace polynomial {
+
+
+/**
+ * kind defines how the coefficients of the polynomial preconditioner are
+ * computed.
+ * - neumann: truncated Neumann series of the scaled system matrix
+ *   $p(A) = \omega \sum_{k=0}^{d} (I - \omega A)^k$ with
+ *   $\omega = 1 / \lambda_{max}$.
+ * - chebyshev: the polynomial of the Chebyshev iteration on the interval
+ *   $[\lambda_{min}, \lambda_{max}]$, which minimizes the maximum of the
+ *   residual polynomial $1 - \lambda p(\lambda)$ on this interval.
+ * - least_squares: the polynomial minimizing the residual polynomial
+ *   $1 - \lambda p(\lambda)$ in the least squares sense on
+ *   $[\lambda_{min}, \lambda_{max}]$, applied by the Horner scheme.
+ */
+enum class kind { neumann, chebyshev, least_squares };
+
+
+}  // namespace polynomial
+
+
+/**
+ * A polynomial preconditioner approximates the inverse of the system matrix
+ * by a polynomial $p(A)$ of degree $d$. Applying it only requires $d$
+ * sparse matrix-vector products and fused vector updates, so it has the same
+ * parallelism as the SpMV and does not need a factorization or triangular
+ * solves.
+ *
+ * The coefficients of the polynomial depend on an interval
+ * $[\lambda_{min}, \lambda_{max}]$ enclosing the spectrum of the system
+ * matrix. If the upper bound is not provided, it is estimated by a few
+ * iterations of the power method (and enlarged by 10% as safeguard). If the
+ * lower bound is not provided, it is set to a fixed fraction of the upper
+ * bound. The preconditioner is therefore intended for matrices with a real,
+ * positive spectrum, e.g. symmetric positive definite matrices, or as a
+ * smoother in multigrid, where only the upper part of the spectrum has to
+ * be damped.
+ *
+ * The system matrix can be any LinOp, including distributed matrices, in
+ * which case the right hand side and solution have to be distributed
+ * vectors as well.
+ *
+ * See Saad, Y., "Iterative Methods for Sparse Linear Systems", Section 12.3
+ * for the Chebyshev and least-squares polynomials.
+ *
+ * @note This class is not thread safe (even a const object is not) because it
+ *       uses an internal cache to accelerate multiple (sequential) applies.
+ *
+ * @tparam ValueType  precision of the vectors the preconditioner is applied
+ *                    to
+ *
+ * @ingroup precond
+ * @ingroup LinOp
+ */
+template <typename ValueType = default_precision>
+class Polynomial : public EnableLinOp<Polynomial<ValueType>> {
+    friend class EnableLinOp<Polynomial>;
+    friend class EnablePolymorphicObject<Polynomial, LinOp>;
+
+public:
+    using EnableLinOp<Polynomial>::convert_to;
+    using EnableLinOp<Polynomial>::move_to;
+    using value_type = ValueType;
+
+    /**
+     * Returns the system matrix the polynomial is applied to.
+     *
+     * @return  the system matrix
+     */
+    std::shared_ptr<const LinOp> get_system_matrix() const
+    {
+        return system_matrix_;
+    }
+
+    /**
+     * Returns the upper bound of the spectrum used to compute the
+     * polynomial.
+     *
+     * @return  the (estimated) largest eigenvalue
+     */
+    double get_max_eigenvalue() const noexcept { return max_eigenvalue_; }
+
+    /**
+     * Returns the lower bound of the spectrum used to compute the
+     * polynomial.
+     *
+     * @return  the (estimated) smallest eigenvalue
+     */
+    double get_min_eigenvalue() const noexcept { return min_eigenvalue_; }
+
+    /**
+     * Returns the coefficients of the least-squares polynomial in the
+     * monomial basis of $A / \lambda_{max}$, starting with the constant term.
+     * It is empty for the other kinds of polynomials.
+     *
+     * @return  the polynomial coefficients
+     */
+    const std::vector<double>& get_coefficients() const noexcept
+    {
+        return coefficients_;
+    }
+
+    GKO_CREATE_FACTORY_PARAMETERS(parameters, Factory)
+    {
+        /**
+         * The kind of polynomial.
+         */
+        polynomial::kind GKO_FACTORY_PARAMETER_SCALAR(
+            kind, polynomial::kind::chebyshev);
+
+        /**
+         * The degree of the polynomial, which equals the number of
+         * matrix-vector products per application.
+         */
+        size_type GKO_FACTORY_PARAMETER_SCALAR(degree, 3u);
+
+        /**
+         * Upper bound of the spectrum of the system matrix. If it is zero,
+         * the bound is estimated by the power method.
+         */
+        double GKO_FACTORY_PARAMETER_SCALAR(max_eigenvalue, 0.0);
+
+        /**
+         * Lower bound of the spectrum of the system matrix. If it is zero,
+         * it is set to max_eigenvalue / eigenvalue_ratio. It is not used by
+         * the Neumann series.
+         */
+        double GKO_FACTORY_PARAMETER_SCALAR(min_eigenvalue, 0.0);
+
+        /**
+         * The ratio between the upper and lower bound of the spectrum used
+         * when min_eigenvalue is not set.
+         */
+        double GKO_FACTORY_PARAMETER_SCALAR(eigenvalue_ratio, 30.0);
+
+        /**
+         * The number of power iterations used to estimate max_eigenvalue.
+         */
+        size_type GKO_FACTORY_PARAMETER_SCALAR(power_iterations, 10u);
+    };
+    GKO_ENABLE_LIN_OP_FACTORY(Polynomial, parameters, Factory);
+    GKO_ENABLE_BUILD_METHOD(Factory);
+
+protected:
+    /**
+     * Creates an empty polynomial preconditioner.
+     *
+     * @param exec  the executor this object is assigned to
+     */
+    explicit Polynomial(std::shared_ptr<const Executor> exec)
+        : EnableLinOp<Polynomial>(std::move(exec)),
+          max_eigenvalue_{},
+          min_eigenvalue_{}
+    {}
+
+    /**
+     * Creates a polynomial preconditioner from a matrix using a
+     * Polynomial::Factory.
+     *
+     * @param factory  the factory to use to create the preconditoner
+     * @param system_matrix  the matrix this preconditioner should be created
+     *                       from
+     */
+    explicit Polynomial(const Factory* factory,
+                        std::shared_ptr<const LinOp> system_matrix)
+        : EnableLinOp<Polynomial>(factory->get_executor(),
+                                  system_matrix->get_size()),
+          parameters_{factory->get_parameters()},
+          system_matrix_{std::move(system_matrix)},
+          max_eigenvalue_{},
+          min_eigenvalue_{}
+    {
+        this->generate();
+    }
+
+    /**
+     * Computes the spectral bounds and the polynomial coefficients.
+     */
+    void generate();
+
+    /**
+     * Estimates the largest eigenvalue of the system matrix by the power
+     * method.
+     *
+     * @return  the estimate of the largest eigenvalue
+     */
+    double estimate_max_eigenvalue() const;
+
+    template <typename VectorType>
+    void apply_dense_impl(const VectorType* b, VectorType* x) const;
+
+    void apply_impl(const LinOp* b, LinOp* x) const override;
+
+    void apply_impl(const LinOp* alpha, const LinOp* b, const LinOp* beta,
+                    LinOp* x) const override;
+
+private:
+    std::shared_ptr<const LinOp> system_matrix_;
+    double max_eigenvalue_;
+    double min_eigenvalue_;
+    std::vector<double> coefficients_;
+
+    /**
+     * Manages the work vectors of the apply, so there is no need to allocate
+     * them every time the preconditioner is applied.
+     * A copy or move of the preconditioner does not copy the cache.
+     */
+    mutable struct cache_struct {
+        cache_struct() = default;
+        ~cache_struct() = default;
+        cache_struct(const cache_struct&) {}
+        cache_struct(cache_struct&&) {}
+        cache_struct& operator=(const cache_struct&) { return *this; }
+        cache_struct& operator=(cache_struct&&) { return *this; }
+        std::unique_ptr<LinOp> r{};
+        std::unique_ptr<LinOp> d{};
+        std::unique_ptr<LinOp> ad{};
+    } cache_;
+};
+
+
+}  // namespace preconditioner
+}  // namespace gko
+
+
+#endif  // GKO_PUBLIC_CORE_PRECONDITIONER_POLYNOMIAL_HPP_
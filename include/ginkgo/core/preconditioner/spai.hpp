@@ -0,0 +1,210 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2022, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+
+#ifndef GKO_PUBLIC_CORE_PRECONDITIONER_SPAI_HPP_
+#define GKO_PUBLIC_CORE_PRECONDITIONER_SPAI_HPP_
+
+
+#include <memory>
+#include <type_traits>
+
+
+#include <ginkgo/core/base/composition.hpp>
+#include <ginkgo/core/base/executor.hpp>
+#include <ginkgo/core/base/lin_op.hpp>
+#include <ginkgo/core/matrix/csr.hpp>
+
+
+namespace gko {
+namespace preconditioner {
+
+
+/**
+ * This enum lists the types of the adaptive SPAI preconditioner.
+ *
+ * The SPAI can either be generated for a general square matrix or an spd
+ * matrix, in which case a factorized approximate inverse is computed.
+ */
+enum struct spai_type { general, spd };
+
+
+/**
+ * The adaptive Sparse Approximate Inverse (SPAI) preconditioner computes a
+ * sparse approximate inverse of a square matrix A whose sparsity pattern is
+ * not fixed in advance, but extended row by row where this reduces the
+ * approximation error the most.
+ *
+ * For a general matrix, each row m_i of the approximate inverse M minimizes
+ * $\|m_i^T A - e_i^T\|_2$ on its current pattern. Starting from the pattern of
+ * A, the pattern is extended in each adaptive step by the entries which
+ * reduce the residual the most (see Grote, M. J., Huckle, T., "Parallel
+ * Preconditioning with Sparse Approximate Inverses", SIAM J. Sci. Comput.,
+ * 1997). Applying the preconditioner computes $M x$.
+ *
+ * For an spd matrix, a lower triangular factor G with $G A G^H \approx I$ is
+ * computed (Factorized Sparse Approximate Inverse, FSAI). Starting from the
+ * lower triangular part of A, each row is extended by the entries with the
+ * largest gradient of the Kaporin condition number (see Janna, C.,
+ * Ferronato, M., "Adaptive Pattern Research for Block FSAI Preconditioning",
+ * SIAM J. Sci. Comput., 2011). Applying the preconditioner computes
+ * $G^H G x$.
+ *
+ * In contrast to Isai, which uses a fixed pattern, the rows are generated
+ * independently from each other by solving small dense least-squares or spd
+ * systems, so the generation parallelizes across rows. Applying the
+ * preconditioner only needs sparse matrix-vector products.
+ *
+ * @note The generation is only implemented for the reference and OpenMP
+ *       executors.
+ *
+ * @tparam SpaiType  determines if the SPAI is generated for a general square
+ *                   matrix or an spd matrix
+ * @tparam ValueType  precision of matrix elements
+ * @tparam IndexType  precision of matrix indexes
+ *
+ * @ingroup precond
+ * @ingroup LinOp
+ */
+template <spai_type SpaiType, typename ValueType, typename IndexType>
+class Spai : public EnableLinOp<Spai<SpaiType, ValueType, IndexType>> {
+    friend class EnableLinOp<Spai>;
+    friend class EnablePolymorphicObject<Spai, LinOp>;
+
+public:
+    using value_type = ValueType;
+    using index_type = IndexType;
+    using Comp = Composition<ValueType>;
+    using Csr = matrix::Csr<ValueType, IndexType>;
+    static constexpr spai_type type{SpaiType};
+
+    /**
+     * Returns the approximate inverse of the given matrix (either a CSR matrix
+     * for SpaiType general or a composition of two CSR matrices for SpaiType
+     * spd).
+     *
+     * @returns the generated approximate inverse
+     */
+    std::shared_ptr<const typename std::conditional<SpaiType == spai_type::spd,
+                                                    Comp, Csr>::type>
+    get_approximate_inverse() const
+    {
+        return as<typename std::conditional<SpaiType == spai_type::spd, Comp,
+                                            Csr>::type>(approximate_inverse_);
+    }
+
+    GKO_CREATE_FACTORY_PARAMETERS(parameters, Factory)
+    {
+        /**
+         * @brief Optimization parameter that skips the sorting of the input
+         *        matrix (only skip if it is known that it is already sorted).
+         */
+        bool GKO_FACTORY_PARAMETER_SCALAR(skip_sorting, false);
+
+        /**
+         * The number of adaptive steps in which the pattern of each row is
+         * extended. With 0 steps, the pattern of A (or its lower triangular
+         * part for spd matrices) is used. Negative values are not supported.
+         */
+        int GKO_FACTORY_PARAMETER_SCALAR(adaptive_steps, 2);
+
+        /**
+         * The maximum number of entries added to each row in every adaptive
+         * step.
+         */
+        size_type GKO_FACTORY_PARAMETER_SCALAR(entries_per_step, 4u);
+
+        /**
+         * A row is not extended any further once the norm of its residual
+         * (general) or its relative largest possible reduction of the Kaporin
+         * functional (spd) is below this tolerance.
+         */
+        double GKO_FACTORY_PARAMETER_SCALAR(tolerance, 0.0);
+    };
+    GKO_ENABLE_LIN_OP_FACTORY(Spai, parameters, Factory);
+    GKO_ENABLE_BUILD_METHOD(Factory);
+
+protected:
+    explicit Spai(std::shared_ptr<const Executor> exec)
+        : EnableLinOp<Spai>(std::move(exec))
+    {}
+
+    /**
+     * Creates a Spai preconditioner from a matrix using a Spai::Factory.
+     *
+     * @param factory  the factory to use to create the preconditoner
+     * @param system_matrix  the matrix for which a SPAI is to be computed
+     */
+    explicit Spai(const Factory* factory,
+                  std::shared_ptr<const LinOp> system_matrix)
+        : EnableLinOp<Spai>(factory->get_executor(), system_matrix->get_size()),
+          parameters_{factory->get_parameters()}
+    {
+        generate_inverse(system_matrix);
+    }
+
+    void apply_impl(const LinOp* b, LinOp* x) const override
+    {
+        approximate_inverse_->apply(b, x);
+    }
+
+    void apply_impl(const LinOp* alpha, const LinOp* b, const LinOp* beta,
+                    LinOp* x) const override
+    {
+        approximate_inverse_->apply(alpha, b, beta, x);
+    }
+
+private:
+    /**
+     * Generates the approximate inverse and stores the result in
+     * `approximate_inverse_`.
+     *
+     * @param system_matrix  the source matrix
+     */
+    void generate_inverse(std::shared_ptr<const LinOp> system_matrix);
+
+    std::shared_ptr<LinOp> approximate_inverse_;
+};
+
+
+template <typename ValueType = default_precision, typename IndexType = int32>
+using GeneralSpai = Spai<spai_type::general, ValueType, IndexType>;
+
+template <typename ValueType = default_precision, typename IndexType = int32>
+using SpdSpai = Spai<spai_type::spd, ValueType, IndexType>;
+
+
+}  // namespace preconditioner
+}  // namespace gko
+
+
+#endif  // GKO_PUBLIC_CORE_PRECONDITIONER_SPAI_HPP_
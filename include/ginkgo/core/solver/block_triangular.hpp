@@ -0,0 +1,285 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2022, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#ifndef GKO_PUBLIC_CORE_SOLVER_BLOCK_TRIANGULAR_HPP_
+#define GKO_PUBLIC_CORE_SOLVER_BLOCK_TRIANGULAR_HPP_
+
+
+#include <memory>
+#include <utility>
+
+
+#include <ginkgo/core/base/abstract_factory.hpp>
+#include <ginkgo/core/base/array.hpp>
+#include <ginkgo/core/base/dim.hpp>
+#include <ginkgo/core/base/exception_helpers.hpp>
+#include <ginkgo/core/base/lin_op.hpp>
+#include <ginkgo/core/base/polymorphic_object.hpp>
+#include <ginkgo/core/base/types.hpp>
+#include <ginkgo/core/base/utils.hpp>
+#include <ginkgo/core/matrix/fbcsr.hpp>
+#include <ginkgo/core/solver/solver_base.hpp>
+
+
+namespace gko {
+namespace solver {
+
+
+template <typename ValueType, typename IndexType>
+class BlockUpperTrs;
+
+
+/**
+ * BlockLowerTrs is the triangular solver which solves the system L x = b, when
+ * L is a lower block triangular matrix stored in the FBCSR format. If the
+ * matrix is not in FBCSR, then the generate step converts it into an FBCSR
+ * matrix with block size 1. The generation fails if the matrix is not
+ * convertible to FBCSR.
+ *
+ * The dense diagonal blocks are inverted during the generation, so the solve
+ * only consists of small dense block-vector products. Missing diagonal blocks
+ * are treated as identity blocks.
+ *
+ * @tparam ValueType  precision of matrix elements
+ * @tparam IndexType  precision of matrix indices
+ *
+ * @ingroup solvers
+ * @ingroup LinOp
+ */
+template <typename ValueType = default_precision, typename IndexType = int32>
+class BlockLowerTrs
+    : public EnableLinOp<BlockLowerTrs<ValueType, IndexType>>,
+      public EnableSolverBase<BlockLowerTrs<ValueType, IndexType>,
+                              matrix::Fbcsr<ValueType, IndexType>>,
+      public Transposable {
+    friend class EnableLinOp<BlockLowerTrs>;
+    friend class EnablePolymorphicObject<BlockLowerTrs, LinOp>;
+    friend class BlockUpperTrs<ValueType, IndexType>;
+
+public:
+    using value_type = ValueType;
+    using index_type = IndexType;
+    using transposed_type = BlockUpperTrs<ValueType, IndexType>;
+
+    std::unique_ptr<LinOp> transpose() const override;
+
+    std::unique_ptr<LinOp> conj_transpose() const override;
+
+    GKO_CREATE_FACTORY_PARAMETERS(parameters, Factory)
+    {
+        /**
+         * Should the solver use the diagonal blocks of the system matrix
+         * (false) or should it assume they are identity blocks (true)?
+         */
+        bool GKO_FACTORY_PARAMETER_SCALAR(unit_diagonal, false);
+    };
+    GKO_ENABLE_LIN_OP_FACTORY(BlockLowerTrs, parameters, Factory);
+    GKO_ENABLE_BUILD_METHOD(Factory);
+
+    /**
+     * Copy-constructs a triangular solver. Preserves the executor,
+     * shallow-copies the system matrix. The inverted diagonal blocks will be
+     * regenerated.
+     */
+    BlockLowerTrs(const BlockLowerTrs&);
+
+    /**
+     * Move-constructs a triangular solver. Preserves the executor, moves the
+     * system matrix and the inverted diagonal blocks. Moved-from object is
+     * empty (0x0 and nullptr system matrix)
+     */
+    BlockLowerTrs(BlockLowerTrs&&);
+
+    /**
+     * Copy-assigns a triangular solver. Preserves the executor, shallow-copies
+     * the system matrix. If the executors mismatch, clones system matrix onto
+     * this executor. The inverted diagonal blocks will be regenerated.
+     */
+    BlockLowerTrs& operator=(const BlockLowerTrs&);
+
+    /**
+     * Move-assigns a triangular solver. Preserves the executor, moves the
+     * system matrix. If the executors mismatch, clones system matrix onto
+     * this executor and regenerates the inverted diagonal blocks. Moved-from
+     * object is empty (0x0 and nullptr system matrix)
+     */
+    BlockLowerTrs& operator=(BlockLowerTrs&&);
+
+protected:
+    using FbcsrMatrix = matrix::Fbcsr<ValueType, IndexType>;
+
+    void apply_impl(const LinOp* b, LinOp* x) const override;
+
+    void apply_impl(const LinOp* alpha, const LinOp* b, const LinOp* beta,
+                    LinOp* x) const override;
+
+    /**
+     * Inverts the diagonal blocks of the system matrix.
+     */
+    void generate();
+
+    explicit BlockLowerTrs(std::shared_ptr<const Executor> exec)
+        : EnableLinOp<BlockLowerTrs>(std::move(exec))
+    {}
+
+    explicit BlockLowerTrs(const Factory* factory,
+                           std::shared_ptr<const LinOp> system_matrix)
+        : EnableLinOp<BlockLowerTrs>(factory->get_executor(),
+                                     gko::transpose(system_matrix->get_size())),
+          EnableSolverBase<BlockLowerTrs, FbcsrMatrix>{
+              copy_and_convert_to<FbcsrMatrix>(factory->get_executor(),
+                                               system_matrix)},
+          parameters_{factory->get_parameters()}
+    {
+        this->generate();
+    }
+
+private:
+    array<ValueType> diag_inv_;
+};
+
+
+/**
+ * BlockUpperTrs is the triangular solver which solves the system U x = b, when
+ * U is an upper block triangular matrix stored in the FBCSR format. If the
+ * matrix is not in FBCSR, then the generate step converts it into an FBCSR
+ * matrix with block size 1. The generation fails if the matrix is not
+ * convertible to FBCSR.
+ *
+ * The dense diagonal blocks are inverted during the generation, so the solve
+ * only consists of small dense block-vector products. Missing diagonal blocks
+ * are treated as identity blocks.
+ *
+ * @tparam ValueType  precision of matrix elements
+ * @tparam IndexType  precision of matrix indices
+ *
+ * @ingroup solvers
+ * @ingroup LinOp
+ */
+template <typename ValueType = default_precision, typename IndexType = int32>
+class BlockUpperTrs
+    : public EnableLinOp<BlockUpperTrs<ValueType, IndexType>>,
+      public EnableSolverBase<BlockUpperTrs<ValueType, IndexType>,
+                              matrix::Fbcsr<ValueType, IndexType>>,
+      public Transposable {
+    friend class EnableLinOp<BlockUpperTrs>;
+    friend class EnablePolymorphicObject<BlockUpperTrs, LinOp>;
+    friend class BlockLowerTrs<ValueType, IndexType>;
+
+public:
+    using value_type = ValueType;
+    using index_type = IndexType;
+    using transposed_type = BlockLowerTrs<ValueType, IndexType>;
+
+    std::unique_ptr<LinOp> transpose() const override;
+
+    std::unique_ptr<LinOp> conj_transpose() const override;
+
+    GKO_CREATE_FACTORY_PARAMETERS(parameters, Factory)
+    {
+        /**
+         * Should the solver use the diagonal blocks of the system matrix
+         * (false) or should it assume they are identity blocks (true)?
+         */
+        bool GKO_FACTORY_PARAMETER_SCALAR(unit_diagonal, false);
+    };
+    GKO_ENABLE_LIN_OP_FACTORY(BlockUpperTrs, parameters, Factory);
+    GKO_ENABLE_BUILD_METHOD(Factory);
+
+    /**
+     * Copy-constructs a triangular solver. Preserves the executor,
+     * shallow-copies the system matrix. The inverted diagonal blocks will be
+     * regenerated.
+     */
+    BlockUpperTrs(const BlockUpperTrs&);
+
+    /**
+     * Move-constructs a triangular solver. Preserves the executor, moves the
+     * system matrix and the inverted diagonal blocks. Moved-from object is
+     * empty (0x0 and nullptr system matrix)
+     */
+    BlockUpperTrs(BlockUpperTrs&&);
+
+    /**
+     * Copy-assigns a triangular solver. Preserves the executor, shallow-copies
+     * the system matrix. If the executors mismatch, clones system matrix onto
+     * this executor. The inverted diagonal blocks will be regenerated.
+     */
+    BlockUpperTrs& operator=(const BlockUpperTrs&);
+
+    /**
+     * Move-assigns a triangular solver. Preserves the executor, moves the
+     * system matrix. If the executors mismatch, clones system matrix onto
+     * this executor and regenerates the inverted diagonal blocks. Moved-from
+     * object is empty (0x0 and nullptr system matrix)
+     */
+    BlockUpperTrs& operator=(BlockUpperTrs&&);
+
+protected:
+    using FbcsrMatrix = matrix::Fbcsr<ValueType, IndexType>;
+
+    void apply_impl(const LinOp* b, LinOp* x) const override;
+
+    void apply_impl(const LinOp* alpha, const LinOp* b, const LinOp* beta,
+                    LinOp* x) const override;
+
+    /**
+     * Inverts the diagonal blocks of the system matrix.
+     */
+    void generate();
+
+    explicit BlockUpperTrs(std::shared_ptr<const Executor> exec)
+        : EnableLinOp<BlockUpperTrs>(std::move(exec))
+    {}
+
+    explicit BlockUpperTrs(const Factory* factory,
+                           std::shared_ptr<const LinOp> system_matrix)
+        : EnableLinOp<BlockUpperTrs>(factory->get_executor(),
+                                     gko::transpose(system_matrix->get_size())),
+          EnableSolverBase<BlockUpperTrs, FbcsrMatrix>{
+              copy_and_convert_to<FbcsrMatrix>(factory->get_executor(),
+                                               system_matrix)},
+          parameters_{factory->get_parameters()}
+    {
+        this->generate();
+    }
+
+private:
+    array<ValueType> diag_inv_;
+};
+
+
+}  // namespace solver
+}  // namespace gko
+
+
+#endif  // GKO_PUBLIC_CORE_SOLVER_BLOCK_TRIANGULAR_HPP_
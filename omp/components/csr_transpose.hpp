@@ -0,0 +1,139 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2022, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#ifndef GKO_OMP_COMPONENTS_CSR_TRANSPOSE_HPP_
+#define GKO_OMP_COMPONENTS_CSR_TRANSPOSE_HPP_
+
+
+#include <algorithm>
+
+
+#include <omp.h>
+
+
+#include <ginkgo/core/base/array.hpp>
+#include <ginkgo/core/base/executor.hpp>
+#include <ginkgo/core/base/math.hpp>
+
+
+#include "core/components/prefix_sum_kernels.hpp"
+
+
+namespace gko {
+namespace kernels {
+namespace omp {
+
+
+/**
+ * Computes the sparsity pattern of the transpose of a CSR matrix in
+ * parallel. The rows are split into contiguous chunks with similar numbers
+ * of nonzeros, every chunk counts its column occurrences in a private
+ * histogram, and a prefix sum over these histograms yields a unique output
+ * position for every nonzero. The row indices within each transposed row
+ * are therefore sorted, like in a sequential transposition.
+ *
+ * Calls entry_cb(in_nz, out_nz) for each nonzero, where in_nz is its
+ * position in the input and out_nz its position in the transpose.
+ *
+ * The number of chunks is limited such that the histograms use at most
+ * twice as much memory as the column indices of the input.
+ */
+template <typename IndexType, typename EntryCallback>
+void abstract_transpose(std::shared_ptr<const OmpExecutor> exec,
+                        size_type num_rows, size_type num_cols,
+                        const IndexType* row_ptrs, const IndexType* col_idxs,
+                        IndexType* out_row_ptrs, IndexType* out_col_idxs,
+                        EntryCallback entry_cb)
+{
+    const auto nnz = static_cast<size_type>(row_ptrs[num_rows]);
+    const auto max_chunks = std::max<size_type>(
+        1, 2 * nnz / std::max<size_type>(num_cols, 1));
+    const auto num_chunks = std::max<size_type>(
+        1, std::min({static_cast<size_type>(omp_get_max_threads()),
+                     max_chunks, num_rows}));
+    array<IndexType> chunk_rows{exec, num_chunks + 1};
+    array<IndexType> counts{exec, num_chunks * num_cols};
+    const auto chunk_rows_ptr = chunk_rows.get_data();
+    const auto counts_ptr = counts.get_data();
+#pragma omp parallel for
+    for (size_type chunk = 0; chunk <= num_chunks; ++chunk) {
+        // first row whose nonzeros start at or after the chunk boundary
+        const auto nz_begin = static_cast<IndexType>(nnz * chunk / num_chunks);
+        chunk_rows_ptr[chunk] = static_cast<IndexType>(
+            std::lower_bound(row_ptrs, row_ptrs + num_rows, nz_begin) -
+            row_ptrs);
+    }
+    chunk_rows_ptr[num_chunks] = static_cast<IndexType>(num_rows);
+#pragma omp parallel for
+    for (size_type chunk = 0; chunk < num_chunks; ++chunk) {
+        const auto chunk_counts = counts_ptr + chunk * num_cols;
+        std::fill_n(chunk_counts, num_cols, zero<IndexType>());
+        for (auto nz = row_ptrs[chunk_rows_ptr[chunk]];
+             nz < row_ptrs[chunk_rows_ptr[chunk + 1]]; ++nz) {
+            chunk_counts[col_idxs[nz]]++;
+        }
+    }
+    // turn the per-chunk counts into offsets within each output row
+#pragma omp parallel for
+    for (size_type col = 0; col < num_cols; ++col) {
+        IndexType offset{};
+        for (size_type chunk = 0; chunk < num_chunks; ++chunk) {
+            const auto count = counts_ptr[chunk * num_cols + col];
+            counts_ptr[chunk * num_cols + col] = offset;
+            offset += count;
+        }
+        out_row_ptrs[col] = offset;
+    }
+    out_row_ptrs[num_cols] = zero<IndexType>();
+    components::prefix_sum(exec, out_row_ptrs, num_cols + 1);
+#pragma omp parallel for
+    for (size_type chunk = 0; chunk < num_chunks; ++chunk) {
+        const auto chunk_offsets = counts_ptr + chunk * num_cols;
+        for (auto row = chunk_rows_ptr[chunk];
+             row < chunk_rows_ptr[chunk + 1]; ++row) {
+            for (auto nz = row_ptrs[row]; nz < row_ptrs[row + 1]; ++nz) {
+                const auto col = col_idxs[nz];
+                const auto out_nz = out_row_ptrs[col] + chunk_offsets[col]++;
+                out_col_idxs[out_nz] = row;
+                entry_cb(nz, out_nz);
+            }
+        }
+    }
+}
+
+
+}  // namespace omp
+}  // namespace kernels
+}  // namespace gko
+
+
+#endif  // GKO_OMP_COMPONENTS_CSR_TRANSPOSE_HPP_
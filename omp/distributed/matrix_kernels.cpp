@@ -264,6 +264,48 @@ GKO_INSTANTIATE_FOR_EACH_VALUE_AND_LOCAL_GLOBAL_INDEX_TYPE(
     GKO_DECLARE_BUILD_LOCAL_NONLOCAL);
 
 
+template <typename ValueType, typename LocalIndexType>
+void row_subset_spmv(
+    std::shared_ptr<const DefaultExecutor> exec,
+    const array<LocalIndexType>& rows, const matrix::Dense<ValueType>* alpha,
+    const matrix::Csr<ValueType, LocalIndexType>* local_mtx,
+    const matrix::Dense<ValueType>* local_b,
+    const matrix::Csr<ValueType, LocalIndexType>* non_local_mtx,
+    const matrix::Dense<ValueType>* recv_b,
+    const matrix::Dense<ValueType>* beta, matrix::Dense<ValueType>* x)
+{
+    const auto row_dot = [](const matrix::Csr<ValueType, LocalIndexType>* mtx,
+                            const matrix::Dense<ValueType>* b,
+                            LocalIndexType row, size_type col) {
+        const auto row_ptrs = mtx->get_const_row_ptrs();
+        const auto col_idxs = mtx->get_const_col_idxs();
+        const auto vals = mtx->get_const_values();
+        auto sum = zero<ValueType>();
+        for (auto nz = row_ptrs[row]; nz < row_ptrs[row + 1]; ++nz) {
+            sum += vals[nz] * b->at(col_idxs[nz], col);
+        }
+        return sum;
+    };
+    const auto row_idxs = rows.get_const_data();
+    const auto num_rhs = x->get_size()[1];
+#pragma omp parallel for
+    for (size_type i = 0; i < rows.get_num_elems(); ++i) {
+        const auto row = row_idxs[i];
+        for (size_type col = 0; col < num_rhs; ++col) {
+            auto sum = row_dot(local_mtx, local_b, row, col);
+            if (non_local_mtx) {
+                sum += row_dot(non_local_mtx, recv_b, row, col);
+            }
+            x->at(row, col) = alpha ? alpha->at(0, 0) * sum +
+                                          beta->at(0, 0) * x->at(row, col)
+                                    : sum;
+        }
+    }
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(GKO_DECLARE_ROW_SUBSET_SPMV);
+
+
 }  // namespace distributed_matrix
 }  // namespace omp
 }  // namespace kernels
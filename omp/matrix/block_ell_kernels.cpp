@@ -0,0 +1,382 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2022, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#include "core/matrix/block_ell_kernels.hpp"
+
+
+#include <algorithm>
+#include <vector>
+
+
+#include <omp.h>
+
+
+#include <ginkgo/core/base/math.hpp>
+#include <ginkgo/core/matrix/csr.hpp>
+#include <ginkgo/core/matrix/dense.hpp>
+
+
+#include "core/synthesizer/implementation_selection.hpp"
+
+
+namespace gko {
+namespace kernels {
+namespace omp {
+/**
+ * @brief The blocked ELL matrix format namespace.
+ * @ref BlockEll
+ * @ingroup block_ell
+ */
+namespace block_ell {
+namespace {
+
+
+// block sizes with a fully unrolled SpMV kernel
+constexpr int max_unrolled_block_size = 8;
+using unrolled_block_sizes = syn::value_list<int, 1, 2, 3, 4, 5, 6, 7, 8>;
+
+
+/**
+ * Register-blocked SpMV: the input block of every stored block is loaded once
+ * and multiplied with the whole block, accumulating a block row of the result
+ * in registers. Padding blocks are stored after all nonzero blocks of a block
+ * row, so the first one ends the block row.
+ */
+template <int block_size, typename ValueType, typename IndexType,
+          typename OutClosure>
+void spmv_unrolled(syn::value_list<int, block_size>,
+                   const matrix::BlockEll<ValueType, IndexType>* a,
+                   const matrix::Dense<ValueType>* b, OutClosure out)
+{
+    constexpr int block_area = block_size * block_size;
+    const auto num_block_rows = static_cast<int64>(a->get_num_block_rows());
+    const auto num_stored =
+        static_cast<int64>(a->get_num_stored_blocks_per_row());
+    const auto num_cols = static_cast<int64>(b->get_size()[1]);
+    const auto col_idxs = a->get_const_col_idxs();
+    const auto vals = a->get_const_values();
+    const auto b_vals = b->get_const_values();
+    const auto b_stride = static_cast<int64>(b->get_stride());
+#pragma omp parallel for
+    for (int64 block_row = 0; block_row < num_block_rows; block_row++) {
+        for (int64 j = 0; j < num_cols; j++) {
+            ValueType sum[block_size];
+            ValueType in[block_size];
+            for (int local_row = 0; local_row < block_size; local_row++) {
+                sum[local_row] = zero<ValueType>();
+            }
+            for (int64 k = 0; k < num_stored; k++) {
+                const auto block = k * num_block_rows + block_row;
+                const auto block_col = col_idxs[block];
+                if (block_col == invalid_index<IndexType>()) {
+                    break;
+                }
+                const auto block_vals = vals + block * block_area;
+                const auto block_in =
+                    b_vals + block_col * block_size * b_stride + j;
+                for (int local_col = 0; local_col < block_size; local_col++) {
+                    in[local_col] = block_in[local_col * b_stride];
+                }
+                for (int local_row = 0; local_row < block_size; local_row++) {
+                    for (int local_col = 0; local_col < block_size;
+                         local_col++) {
+                        sum[local_row] +=
+                            block_vals[local_row * block_size + local_col] *
+                            in[local_col];
+                    }
+                }
+            }
+            for (int local_row = 0; local_row < block_size; local_row++) {
+                out(block_row * block_size + local_row, j, sum[local_row]);
+            }
+        }
+    }
+}
+
+GKO_ENABLE_IMPLEMENTATION_SELECTION(select_spmv_unrolled, spmv_unrolled);
+
+
+template <typename ValueType, typename IndexType, typename OutClosure>
+void spmv_generic(const matrix::BlockEll<ValueType, IndexType>* a,
+                  const matrix::Dense<ValueType>* b, OutClosure out)
+{
+    const int64 bs = a->get_block_size();
+    const auto num_block_rows = static_cast<int64>(a->get_num_block_rows());
+    const auto num_stored =
+        static_cast<int64>(a->get_num_stored_blocks_per_row());
+    const auto num_cols = static_cast<int64>(b->get_size()[1]);
+    const auto col_idxs = a->get_const_col_idxs();
+    const auto vals = a->get_const_values();
+#pragma omp parallel for
+    for (int64 row = 0; row < num_block_rows * bs; row++) {
+        const auto block_row = row / bs;
+        const auto local_row = row % bs;
+        for (int64 j = 0; j < num_cols; j++) {
+            auto sum = zero<ValueType>();
+            for (int64 k = 0; k < num_stored; k++) {
+                const auto block = k * num_block_rows + block_row;
+                const auto block_col = col_idxs[block];
+                if (block_col == invalid_index<IndexType>()) {
+                    break;
+                }
+                const auto block_vals = vals + (block * bs + local_row) * bs;
+                for (int64 local_col = 0; local_col < bs; local_col++) {
+                    sum += block_vals[local_col] *
+                           b->at(block_col * bs + local_col, j);
+                }
+            }
+            out(row, j, sum);
+        }
+    }
+}
+
+
+template <typename ValueType, typename IndexType, typename OutClosure>
+void spmv_blocks(const matrix::BlockEll<ValueType, IndexType>* a,
+                 const matrix::Dense<ValueType>* b, OutClosure out)
+{
+    const auto bs = a->get_block_size();
+    if (bs > max_unrolled_block_size) {
+        spmv_generic(a, b, out);
+        return;
+    }
+    select_spmv_unrolled(
+        unrolled_block_sizes(),
+        [bs](int unrolled_block_size) { return bs == unrolled_block_size; },
+        syn::value_list<int>(), syn::type_list<>(), a, b, out);
+}
+
+
+template <typename IndexType>
+void collect_block_cols(const IndexType* row_ptrs, const IndexType* col_idxs,
+                        int64 block_row, int block_size,
+                        std::vector<IndexType>& block_cols)
+{
+    block_cols.clear();
+    for (auto nz = row_ptrs[block_row * block_size];
+         nz < row_ptrs[(block_row + 1) * block_size]; nz++) {
+        block_cols.push_back(col_idxs[nz] / block_size);
+    }
+    std::sort(block_cols.begin(), block_cols.end());
+    block_cols.erase(std::unique(block_cols.begin(), block_cols.end()),
+                     block_cols.end());
+}
+
+
+}  // anonymous namespace
+
+
+template <typename ValueType, typename IndexType>
+void spmv(std::shared_ptr<const OmpExecutor> exec,
+          const matrix::BlockEll<ValueType, IndexType>* a,
+          const matrix::Dense<ValueType>* b, matrix::Dense<ValueType>* c)
+{
+    spmv_blocks(a, b, [&](int64 row, int64 col, ValueType value) {
+        c->at(row, col) = value;
+    });
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(
+    GKO_DECLARE_BLOCK_ELL_SPMV_KERNEL);
+
+
+template <typename ValueType, typename IndexType>
+void advanced_spmv(std::shared_ptr<const OmpExecutor> exec,
+                   const matrix::Dense<ValueType>* alpha,
+                   const matrix::BlockEll<ValueType, IndexType>* a,
+                   const matrix::Dense<ValueType>* b,
+                   const matrix::Dense<ValueType>* beta,
+                   matrix::Dense<ValueType>* c)
+{
+    const auto valpha = alpha->at(0, 0);
+    const auto vbeta = beta->at(0, 0);
+    spmv_blocks(a, b, [&](int64 row, int64 col, ValueType value) {
+        c->at(row, col) = vbeta * c->at(row, col) + valpha * value;
+    });
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(
+    GKO_DECLARE_BLOCK_ELL_ADVANCED_SPMV_KERNEL);
+
+
+template <typename ValueType, typename IndexType>
+void compute_max_blocks_per_row(
+    std::shared_ptr<const OmpExecutor> exec,
+    const matrix::Csr<ValueType, IndexType>* source, int block_size,
+    size_type& result)
+{
+    const auto row_ptrs = source->get_const_row_ptrs();
+    const auto col_idxs = source->get_const_col_idxs();
+    const auto num_block_rows =
+        static_cast<int64>(source->get_size()[0] / block_size);
+    size_type max_blocks{};
+#pragma omp parallel
+    {
+        std::vector<IndexType> block_cols;
+#pragma omp for reduction(max : max_blocks)
+        for (int64 block_row = 0; block_row < num_block_rows; block_row++) {
+            collect_block_cols(row_ptrs, col_idxs, block_row, block_size,
+                               block_cols);
+            max_blocks = std::max(max_blocks, block_cols.size());
+        }
+    }
+    result = max_blocks;
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(
+    GKO_DECLARE_BLOCK_ELL_COMPUTE_MAX_BLOCKS_PER_ROW_KERNEL);
+
+
+template <typename ValueType, typename IndexType>
+void fill_in_from_csr(std::shared_ptr<const OmpExecutor> exec,
+                      const matrix::Csr<ValueType, IndexType>* source,
+                      matrix::BlockEll<ValueType, IndexType>* result)
+{
+    const auto bs = result->get_block_size();
+    const auto block_area = static_cast<int64>(bs) * bs;
+    const auto num_block_rows =
+        static_cast<int64>(result->get_num_block_rows());
+    const auto num_stored =
+        static_cast<int64>(result->get_num_stored_blocks_per_row());
+    const auto row_ptrs = source->get_const_row_ptrs();
+    const auto in_cols = source->get_const_col_idxs();
+    const auto in_vals = source->get_const_values();
+    const auto col_idxs = result->get_col_idxs();
+    const auto vals = result->get_values();
+#pragma omp parallel
+    {
+        std::vector<IndexType> block_cols;
+#pragma omp for
+        for (int64 block_row = 0; block_row < num_block_rows; block_row++) {
+            collect_block_cols(row_ptrs, in_cols, block_row, bs, block_cols);
+            for (int64 k = 0; k < num_stored; k++) {
+                const auto block = k * num_block_rows + block_row;
+                col_idxs[block] = k < static_cast<int64>(block_cols.size())
+                                      ? block_cols[k]
+                                      : invalid_index<IndexType>();
+                std::fill_n(vals + block * block_area, block_area,
+                            zero<ValueType>());
+            }
+            for (int local_row = 0; local_row < bs; local_row++) {
+                const auto row = block_row * bs + local_row;
+                for (auto nz = row_ptrs[row]; nz < row_ptrs[row + 1]; nz++) {
+                    const auto k = std::lower_bound(block_cols.begin(),
+                                                    block_cols.end(),
+                                                    in_cols[nz] / bs) -
+                                   block_cols.begin();
+                    const auto block = k * num_block_rows + block_row;
+                    vals[(block * bs + local_row) * bs + in_cols[nz] % bs] =
+                        in_vals[nz];
+                }
+            }
+        }
+    }
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(
+    GKO_DECLARE_BLOCK_ELL_FILL_IN_FROM_CSR_KERNEL);
+
+
+template <typename ValueType, typename IndexType>
+void count_nonzeros_per_row(
+    std::shared_ptr<const OmpExecutor> exec,
+    const matrix::BlockEll<ValueType, IndexType>* source, IndexType* result)
+{
+    const auto bs = source->get_block_size();
+    const auto num_block_rows =
+        static_cast<int64>(source->get_num_block_rows());
+    const auto num_stored =
+        static_cast<int64>(source->get_num_stored_blocks_per_row());
+    const auto col_idxs = source->get_const_col_idxs();
+#pragma omp parallel for
+    for (int64 block_row = 0; block_row < num_block_rows; block_row++) {
+        IndexType num_blocks{};
+        for (int64 k = 0; k < num_stored; k++) {
+            if (col_idxs[k * num_block_rows + block_row] !=
+                invalid_index<IndexType>()) {
+                num_blocks++;
+            }
+        }
+        for (int local_row = 0; local_row < bs; local_row++) {
+            result[block_row * bs + local_row] = num_blocks * bs;
+        }
+    }
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(
+    GKO_DECLARE_BLOCK_ELL_COUNT_NONZEROS_PER_ROW_KERNEL);
+
+
+template <typename ValueType, typename IndexType>
+void convert_to_csr(std::shared_ptr<const OmpExecutor> exec,
+                    const matrix::BlockEll<ValueType, IndexType>* source,
+                    matrix::Csr<ValueType, IndexType>* result)
+{
+    const auto bs = source->get_block_size();
+    const auto num_block_rows =
+        static_cast<int64>(source->get_num_block_rows());
+    const auto num_stored =
+        static_cast<int64>(source->get_num_stored_blocks_per_row());
+    const auto col_idxs = source->get_const_col_idxs();
+    const auto vals = source->get_const_values();
+    const auto row_ptrs = result->get_const_row_ptrs();
+    const auto out_cols = result->get_col_idxs();
+    const auto out_vals = result->get_values();
+#pragma omp parallel for
+    for (int64 row = 0; row < num_block_rows * bs; row++) {
+        const auto block_row = row / bs;
+        const auto local_row = row % bs;
+        auto out_nz = row_ptrs[row];
+        for (int64 k = 0; k < num_stored; k++) {
+            const auto block = k * num_block_rows + block_row;
+            const auto block_col = col_idxs[block];
+            if (block_col == invalid_index<IndexType>()) {
+                break;
+            }
+            for (int local_col = 0; local_col < bs; local_col++) {
+                out_cols[out_nz] = block_col * bs + local_col;
+                out_vals[out_nz] =
+                    vals[(block * bs + local_row) * bs + local_col];
+                out_nz++;
+            }
+        }
+    }
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(
+    GKO_DECLARE_BLOCK_ELL_CONVERT_TO_CSR_KERNEL);
+
+
+}  // namespace block_ell
+}  // namespace omp
+}  // namespace kernels
+}  // namespace gko
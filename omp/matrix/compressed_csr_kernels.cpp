@@ -0,0 +1,311 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2022, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#include "core/matrix/compressed_csr_kernels.hpp"
+
+
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+
+
+#include <omp.h>
+
+
+#include <ginkgo/core/base/exception_helpers.hpp>
+#include <ginkgo/core/base/math.hpp>
+#include <ginkgo/core/matrix/csr.hpp>
+#include <ginkgo/core/matrix/dense.hpp>
+
+
+namespace gko {
+namespace kernels {
+namespace omp {
+/**
+ * @brief The compressed CSR matrix format namespace.
+ * @ref CompressedCsr
+ * @ingroup compressed_csr
+ */
+namespace compressed_csr {
+namespace {
+
+
+uint8 get_delta_width(uint64 span)
+{
+    if (span <= 0xffu) {
+        return 1;
+    } else if (span <= 0xffffu) {
+        return 2;
+    } else if (span <= 0xffffffffu) {
+        return 4;
+    }
+    return 8;
+}
+
+
+/**
+ * The deltas of a row, packed into the bytes of its 64 bit words. Accessing
+ * the words through pointers to narrower integer types would violate strict
+ * aliasing, so the deltas are copied from and to the bytes with std::memcpy,
+ * which compiles to plain loads and stores.
+ */
+template <typename DeltaType, typename ByteType>
+struct packed_deltas {
+    using delta_type = DeltaType;
+
+    DeltaType operator[](size_type k) const
+    {
+        DeltaType delta;
+        std::memcpy(&delta, bytes + k * sizeof(DeltaType), sizeof(DeltaType));
+        return delta;
+    }
+
+    void set(size_type k, DeltaType delta) const
+    {
+        std::memcpy(bytes + k * sizeof(DeltaType), &delta, sizeof(DeltaType));
+    }
+
+    ByteType* bytes;
+};
+
+
+/**
+ * Calls `fn` with the deltas of a row, accessed as the unsigned integer type
+ * matching its delta width.
+ */
+template <typename WordType, typename Function>
+void dispatch_width(WordType* row_words, uint8 width, Function fn)
+{
+    using byte_type = std::conditional_t<std::is_const<WordType>::value,
+                                         const unsigned char, unsigned char>;
+    const auto bytes = reinterpret_cast<byte_type*>(row_words);
+    switch (width) {
+    case 1:
+        fn(packed_deltas<uint8, byte_type>{bytes});
+        break;
+    case 2:
+        fn(packed_deltas<uint16, byte_type>{bytes});
+        break;
+    case 4:
+        fn(packed_deltas<uint32, byte_type>{bytes});
+        break;
+    default:
+        fn(packed_deltas<uint64, byte_type>{bytes});
+    }
+}
+
+
+template <typename ValueType, typename IndexType, typename OutputFunction>
+void spmv_rows(const matrix::CompressedCsr<ValueType, IndexType>* a,
+               const matrix::Dense<ValueType>* b, OutputFunction out)
+{
+    const auto row_ptrs = a->get_const_row_ptrs();
+    const auto bases = a->get_const_col_bases();
+    const auto widths = a->get_const_col_widths();
+    const auto offsets = a->get_const_col_offsets();
+    const auto deltas = a->get_const_col_deltas();
+    const auto vals = a->get_const_values();
+    const auto num_rhs = b->get_size()[1];
+#pragma omp parallel for
+    for (size_type row = 0; row < a->get_size()[0]; row++) {
+        const auto begin = row_ptrs[row];
+        const auto end = row_ptrs[row + 1];
+        const auto base = bases[row];
+        // the switch on the width is hoisted out of the inner loop, so each
+        // row is processed by a loop specialized for its delta type
+        dispatch_width(deltas + offsets[row], widths[row],
+                       [&](auto row_deltas) {
+                           for (size_type j = 0; j < num_rhs; j++) {
+                               auto sum = zero<ValueType>();
+                               for (auto nz = begin; nz < end; nz++) {
+                                   const auto col =
+                                       base + static_cast<IndexType>(
+                                                  row_deltas[nz - begin]);
+                                   sum += vals[nz] * b->at(col, j);
+                               }
+                               out(row, j, sum);
+                           }
+                       });
+    }
+}
+
+
+}  // anonymous namespace
+
+
+template <typename ValueType, typename IndexType>
+void spmv(std::shared_ptr<const OmpExecutor> exec,
+          const matrix::CompressedCsr<ValueType, IndexType>* a,
+          const matrix::Dense<ValueType>* b, matrix::Dense<ValueType>* c)
+{
+    spmv_rows(a, b, [c](size_type row, size_type j, ValueType sum) {
+        c->at(row, j) = sum;
+    });
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(
+    GKO_DECLARE_COMPRESSED_CSR_SPMV_KERNEL);
+
+
+template <typename ValueType, typename IndexType>
+void advanced_spmv(std::shared_ptr<const OmpExecutor> exec,
+                   const matrix::Dense<ValueType>* alpha,
+                   const matrix::CompressedCsr<ValueType, IndexType>* a,
+                   const matrix::Dense<ValueType>* b,
+                   const matrix::Dense<ValueType>* beta,
+                   matrix::Dense<ValueType>* c)
+{
+    const auto valpha = alpha->at(0, 0);
+    const auto vbeta = beta->at(0, 0);
+    spmv_rows(a, b, [&](size_type row, size_type j, ValueType sum) {
+        c->at(row, j) = vbeta * c->at(row, j) + valpha * sum;
+    });
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(
+    GKO_DECLARE_COMPRESSED_CSR_ADVANCED_SPMV_KERNEL);
+
+
+template <typename ValueType, typename IndexType>
+void count_row_words(std::shared_ptr<const OmpExecutor> exec,
+                     const matrix::Csr<ValueType, IndexType>* source,
+                     uint8* col_widths, IndexType* row_words)
+{
+    const auto row_ptrs = source->get_const_row_ptrs();
+    const auto col_idxs = source->get_const_col_idxs();
+#pragma omp parallel for
+    for (size_type row = 0; row < source->get_size()[0]; row++) {
+        const auto begin = row_ptrs[row];
+        const auto end = row_ptrs[row + 1];
+        uint8 width = 1;
+        if (begin < end) {
+            const auto minmax =
+                std::minmax_element(col_idxs + begin, col_idxs + end);
+            width = get_delta_width(
+                static_cast<uint64>(*minmax.second - *minmax.first));
+        }
+        col_widths[row] = width;
+        row_words[row] =
+            static_cast<IndexType>(ceildiv((end - begin) * int64{width}, 8));
+    }
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(
+    GKO_DECLARE_COMPRESSED_CSR_COUNT_ROW_WORDS_KERNEL);
+
+
+template <typename ValueType, typename IndexType>
+void compress_from_csr(std::shared_ptr<const OmpExecutor> exec,
+                       const matrix::Csr<ValueType, IndexType>* source,
+                       matrix::CompressedCsr<ValueType, IndexType>* result)
+{
+    const auto num_rows = source->get_size()[0];
+    const auto row_ptrs = source->get_const_row_ptrs();
+    const auto col_idxs = source->get_const_col_idxs();
+    const auto vals = source->get_const_values();
+    const auto widths = result->get_const_col_widths();
+    const auto offsets = result->get_const_col_offsets();
+    auto out_row_ptrs = result->get_row_ptrs();
+    auto out_vals = result->get_values();
+    auto out_bases = result->get_col_bases();
+    auto out_deltas = result->get_col_deltas();
+#pragma omp parallel for
+    for (size_type row = 0; row < num_rows; row++) {
+        const auto begin = row_ptrs[row];
+        const auto end = row_ptrs[row + 1];
+        const auto base =
+            begin < end ? *std::min_element(col_idxs + begin, col_idxs + end)
+                        : IndexType{};
+        out_row_ptrs[row + 1] = end;
+        out_bases[row] = base;
+        std::copy(vals + begin, vals + end, out_vals + begin);
+        auto row_words = out_deltas + offsets[row];
+        // zero the padding at the end of the row
+        std::fill(row_words, out_deltas + offsets[row + 1], uint64{});
+        dispatch_width(row_words, widths[row], [&](auto typed_deltas) {
+            using delta_type = typename decltype(typed_deltas)::delta_type;
+            for (auto nz = begin; nz < end; nz++) {
+                typed_deltas.set(nz - begin,
+                                 static_cast<delta_type>(col_idxs[nz] - base));
+            }
+        });
+    }
+    out_row_ptrs[0] = row_ptrs[0];
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(
+    GKO_DECLARE_COMPRESSED_CSR_COMPRESS_FROM_CSR_KERNEL);
+
+
+template <typename ValueType, typename IndexType>
+void decompress_to_csr(
+    std::shared_ptr<const OmpExecutor> exec,
+    const matrix::CompressedCsr<ValueType, IndexType>* source,
+    matrix::Csr<ValueType, IndexType>* result)
+{
+    const auto num_rows = source->get_size()[0];
+    const auto row_ptrs = source->get_const_row_ptrs();
+    const auto bases = source->get_const_col_bases();
+    const auto widths = source->get_const_col_widths();
+    const auto offsets = source->get_const_col_offsets();
+    const auto deltas = source->get_const_col_deltas();
+    const auto vals = source->get_const_values();
+    auto out_row_ptrs = result->get_row_ptrs();
+    auto out_col_idxs = result->get_col_idxs();
+    auto out_vals = result->get_values();
+#pragma omp parallel for
+    for (size_type row = 0; row < num_rows; row++) {
+        const auto begin = row_ptrs[row];
+        const auto end = row_ptrs[row + 1];
+        const auto base = bases[row];
+        out_row_ptrs[row + 1] = end;
+        std::copy(vals + begin, vals + end, out_vals + begin);
+        dispatch_width(deltas + offsets[row], widths[row],
+                       [&](auto row_deltas) {
+                           for (auto nz = begin; nz < end; nz++) {
+                               out_col_idxs[nz] =
+                                   base + static_cast<IndexType>(
+                                              row_deltas[nz - begin]);
+                           }
+                       });
+    }
+    out_row_ptrs[0] = row_ptrs[0];
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(
+    GKO_DECLARE_COMPRESSED_CSR_DECOMPRESS_TO_CSR_KERNEL);
+
+
+}  // namespace compressed_csr
+}  // namespace omp
+}  // namespace kernels
+}  // namespace gko
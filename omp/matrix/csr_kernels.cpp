@@ -54,11 +54,13 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "core/base/allocator.hpp"
 #include "core/base/index_set_kernels.hpp"
 #include "core/base/iterator_factory.hpp"
+#include "core/base/mixed_precision_types.hpp"
 #include "core/base/utils.hpp"
 #include "core/components/fill_array_kernels.hpp"
 #include "core/components/prefix_sum_kernels.hpp"
 #include "core/matrix/csr_builder.hpp"
 #include "omp/components/csr_spgeam.hpp"
+#include "omp/components/csr_transpose.hpp"
 
 
 namespace gko {
@@ -134,95 +136,307 @@ GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(
     GKO_DECLARE_CSR_ADVANCED_SPMV_KERNEL);
 
 
+template <typename InputValueType, typename MatrixValueType,
+          typename OutputValueType, typename IndexType>
+void mixed_spmv(std::shared_ptr<const OmpExecutor> exec,
+                const matrix::Csr<MatrixValueType, IndexType>* a,
+                const matrix::Dense<InputValueType>* b,
+                matrix::Dense<OutputValueType>* c)
+{
+    using arithmetic_type =
+        highest_precision<InputValueType, OutputValueType, MatrixValueType>;
+    auto row_ptrs = a->get_const_row_ptrs();
+    auto col_idxs = a->get_const_col_idxs();
+    auto vals = a->get_const_values();
+
+#pragma omp parallel for
+    for (size_type row = 0; row < a->get_size()[0]; ++row) {
+        for (size_type j = 0; j < c->get_size()[1]; ++j) {
+            auto sum = zero<arithmetic_type>();
+            for (auto k = row_ptrs[row]; k < row_ptrs[row + 1]; ++k) {
+                sum += static_cast<arithmetic_type>(vals[k]) *
+                       static_cast<arithmetic_type>(b->at(col_idxs[k], j));
+            }
+            c->at(row, j) = static_cast<OutputValueType>(sum);
+        }
+    }
+}
+
+GKO_INSTANTIATE_FOR_EACH_MIXED_VALUE_AND_INDEX_TYPE(
+    GKO_DECLARE_CSR_MIXED_SPMV_KERNEL);
+
+
+template <typename InputValueType, typename MatrixValueType,
+          typename OutputValueType, typename IndexType>
+void advanced_mixed_spmv(std::shared_ptr<const OmpExecutor> exec,
+                         const matrix::Dense<MatrixValueType>* alpha,
+                         const matrix::Csr<MatrixValueType, IndexType>* a,
+                         const matrix::Dense<InputValueType>* b,
+                         const matrix::Dense<OutputValueType>* beta,
+                         matrix::Dense<OutputValueType>* c)
+{
+    using arithmetic_type =
+        highest_precision<InputValueType, OutputValueType, MatrixValueType>;
+    auto row_ptrs = a->get_const_row_ptrs();
+    auto col_idxs = a->get_const_col_idxs();
+    auto vals = a->get_const_values();
+    const auto valpha = static_cast<arithmetic_type>(alpha->at(0, 0));
+    const auto vbeta = static_cast<arithmetic_type>(beta->at(0, 0));
+
+#pragma omp parallel for
+    for (size_type row = 0; row < a->get_size()[0]; ++row) {
+        for (size_type j = 0; j < c->get_size()[1]; ++j) {
+            auto sum = zero<arithmetic_type>();
+            for (auto k = row_ptrs[row]; k < row_ptrs[row + 1]; ++k) {
+                sum += static_cast<arithmetic_type>(vals[k]) *
+                       static_cast<arithmetic_type>(b->at(col_idxs[k], j));
+            }
+            c->at(row, j) = static_cast<OutputValueType>(
+                vbeta * static_cast<arithmetic_type>(c->at(row, j)) +
+                valpha * sum);
+        }
+    }
+}
+
+GKO_INSTANTIATE_FOR_EACH_MIXED_VALUE_AND_INDEX_TYPE(
+    GKO_DECLARE_CSR_ADVANCED_MIXED_SPMV_KERNEL);
+
+
 namespace {
 
 
 /**
  * @internal
  *
- * Entry in a heap storing a column index and associated non-zero index
- * (and row end) from a matrix.
+ * Accumulates the entries of a single row of a sparse matrix product.
+ *
+ * Each distinct column is assigned a slot in a compact list of entries.
+ * The mapping from columns to slots uses a dense array if the row can
+ * touch a large fraction of all columns, and a hash table with linear
+ * probing otherwise. The dense array is only allocated when it is first
+ * needed, and it is never reset: a row stamp marks the valid entries.
  *
  * @tparam ValueType  The value type for matrices.
  * @tparam IndexType  The index type for matrices.
  */
 template <typename ValueType, typename IndexType>
-struct col_heap_element {
-    using value_type = ValueType;
-    using index_type = IndexType;
-    using matrix_type = matrix::Csr<ValueType, IndexType>;
+class spgemm_accumulator {
+public:
+    spgemm_accumulator(std::shared_ptr<const OmpExecutor> exec,
+                       size_type num_cols)
+        : num_cols_{num_cols},
+          use_dense_{},
+          hash_mask_{},
+          stamp_{},
+          size_{},
+          hash_cols_(exec),
+          hash_slots_(exec),
+          dense_stamps_(exec),
+          dense_slots_(exec),
+          cols_(exec),
+          vals_(exec)
+    {}
 
-    IndexType idx;
-    IndexType end;
-    IndexType col;
+    /**
+     * Prepares the accumulation of a new row.
+     *
+     * @param max_entries  an upper bound for the number of distinct columns
+     *                     in the row, e.g. the number of products
+     */
+    void start_row(size_type max_entries)
+    {
+        max_entries = std::min(max_entries, num_cols_);
+        size_ = 0;
+        if (cols_.size() < max_entries) {
+            cols_.resize(max_entries);
+            vals_.resize(max_entries);
+        }
+        size_type hash_size = 1;
+        while (hash_size < 2 * max_entries) {
+            hash_size *= 2;
+        }
+        // a dense array is cheaper if it is not much larger than the table
+        use_dense_ = num_cols_ <= 4 * hash_size;
+        if (use_dense_) {
+            if (dense_stamps_.size() < num_cols_) {
+                dense_stamps_.assign(num_cols_, IndexType{});
+                dense_slots_.resize(num_cols_);
+            }
+            stamp_++;
+        } else {
+            if (hash_cols_.size() < hash_size) {
+                hash_cols_.resize(hash_size);
+                hash_slots_.resize(hash_size);
+            }
+            hash_mask_ = hash_size - 1;
+            std::fill_n(hash_cols_.begin(), hash_size, invalid_index());
+        }
+    }
 
-    ValueType val() const { return zero<ValueType>(); }
+    /** Adds val to the entry in column col, creating it if necessary. */
+    void add(IndexType col, ValueType val)
+    {
+        auto& slot = find_or_insert(col);
+        vals_[slot] += val;
+    }
 
-    col_heap_element(IndexType idx, IndexType end, IndexType col, ValueType)
-        : idx{idx}, end{end}, col{col}
-    {}
+    /** Creates the entry in column col without changing its value. */
+    void add(IndexType col) { find_or_insert(col); }
+
+    /** Adds val to the entry in column col if it exists, else drops it. */
+    void add_if_present(IndexType col, ValueType val)
+    {
+        const auto slot = find(col);
+        if (slot != invalid_index()) {
+            vals_[slot] += val;
+        }
+    }
+
+    /** Returns the number of distinct columns accumulated so far. */
+    size_type size() const { return size_; }
+
+    /**
+     * Copies the accumulated entries to the given output arrays, sorted by
+     * column index.
+     */
+    void write_sorted(IndexType* out_cols, ValueType* out_vals) const
+    {
+        std::copy_n(cols_.begin(), size_, out_cols);
+        std::copy_n(vals_.begin(), size_, out_vals);
+        auto it = detail::make_zip_iterator(out_cols, out_vals);
+        std::sort(it, it + size_, [](auto t1, auto t2) {
+            return std::get<0>(t1) < std::get<0>(t2);
+        });
+    }
+
+    /** Copies the accumulated values in the order they were inserted. */
+    void write_unsorted(ValueType* out_vals) const
+    {
+        std::copy_n(vals_.begin(), size_, out_vals);
+    }
+
+    /** Copies the sorted column indices of the accumulated entries. */
+    void write_sorted(IndexType* out_cols) const
+    {
+        std::copy_n(cols_.begin(), size_, out_cols);
+        std::sort(out_cols, out_cols + size_);
+    }
+
+private:
+    IndexType find(IndexType col) const
+    {
+        if (use_dense_) {
+            return dense_stamps_[col] == stamp_ ? dense_slots_[col]
+                                                : invalid_index();
+        }
+        auto pos = hash(col);
+        while (hash_cols_[pos] != col) {
+            if (hash_cols_[pos] == invalid_index()) {
+                return invalid_index();
+            }
+            pos = (pos + 1) & hash_mask_;
+        }
+        return hash_slots_[pos];
+    }
+
+    IndexType& find_or_insert(IndexType col)
+    {
+        if (use_dense_) {
+            auto& slot = dense_slots_[col];
+            if (dense_stamps_[col] != stamp_) {
+                dense_stamps_[col] = stamp_;
+                slot = new_slot(col);
+            }
+            return slot;
+        }
+        auto pos = hash(col);
+        while (hash_cols_[pos] != col) {
+            if (hash_cols_[pos] == invalid_index()) {
+                hash_cols_[pos] = col;
+                hash_slots_[pos] = new_slot(col);
+                break;
+            }
+            pos = (pos + 1) & hash_mask_;
+        }
+        return hash_slots_[pos];
+    }
+
+    // multiplicative hashing, the table size is a power of two
+    size_type hash(IndexType col) const
+    {
+        return (static_cast<size_type>(col) * 2654435761u) & hash_mask_;
+    }
+
+    IndexType new_slot(IndexType col)
+    {
+        cols_[size_] = col;
+        vals_[size_] = zero<ValueType>();
+        return static_cast<IndexType>(size_++);
+    }
+
+    static constexpr IndexType invalid_index() { return IndexType{-1}; }
+
+    size_type num_cols_;
+    bool use_dense_;
+    size_type hash_mask_;
+    IndexType stamp_;
+    size_type size_;
+    vector<IndexType> hash_cols_;
+    vector<IndexType> hash_slots_;
+    vector<IndexType> dense_stamps_;
+    vector<IndexType> dense_slots_;
+    vector<IndexType> cols_;
+    vector<ValueType> vals_;
 };
 
 
 /**
  * @internal
  *
- * Entry in a heap storing an entry (value and column index) and associated
- * non-zero index (and row end) from a matrix.
- *
- * @tparam ValueType  The value type for matrices.
- * @tparam IndexType  The index type for matrices.
+ * Returns the number of products contributing to a row of a * b, which is
+ * an upper bound for the number of nonzeros in that row of the product.
  */
 template <typename ValueType, typename IndexType>
-struct val_heap_element {
-    using value_type = ValueType;
-    using index_type = IndexType;
-    using matrix_type = matrix::Csr<ValueType, IndexType>;
-
-    IndexType idx;
-    IndexType end;
-    IndexType col;
-    ValueType val_;
-
-    ValueType val() const { return val_; }
-
-    val_heap_element(IndexType idx, IndexType end, IndexType col, ValueType val)
-        : idx{idx}, end{end}, col{col}, val_{val}
-    {}
-};
+size_type spgemm_row_products(const matrix::Csr<ValueType, IndexType>* a,
+                              const matrix::Csr<ValueType, IndexType>* b,
+                              size_type row)
+{
+    const auto a_row_ptrs = a->get_const_row_ptrs();
+    const auto a_col_idxs = a->get_const_col_idxs();
+    const auto b_row_ptrs = b->get_const_row_ptrs();
+    size_type count{};
+    for (auto a_nz = a_row_ptrs[row]; a_nz < a_row_ptrs[row + 1]; ++a_nz) {
+        const auto b_row = a_col_idxs[a_nz];
+        count += b_row_ptrs[b_row + 1] - b_row_ptrs[b_row];
+    }
+    return count;
+}
 
 
 /**
  * @internal
  *
- * Restores the binary heap condition downwards from a given index.
- *
- * The heap condition is: col(child) >= col(parent)
- *
- * @param heap  a pointer to the array containing the heap elements.
- * @param idx  the index of the starting heap node that potentially
- *             violates the heap condition.
- * @param size  the number of elements in the heap.
- * @tparam HeapElement  the element type in the heap. See col_heap_element and
- *                      val_heap_element
+ * Adds scale times a row of a * b to the accumulator.
  */
-template <typename HeapElement>
-void sift_down(HeapElement* heap, typename HeapElement::index_type idx,
-               typename HeapElement::index_type size)
+template <typename ValueType, typename IndexType>
+void spgemm_accumulate_row(spgemm_accumulator<ValueType, IndexType>& acc,
+                           const matrix::Csr<ValueType, IndexType>* a,
+                           const matrix::Csr<ValueType, IndexType>* b,
+                           ValueType scale, size_type row)
 {
-    auto curcol = heap[idx].col;
-    while (idx * 2 + 1 < size) {
-        auto lchild = idx * 2 + 1;
-        auto rchild = min(lchild + 1, size - 1);
-        auto lcol = heap[lchild].col;
-        auto rcol = heap[rchild].col;
-        auto mincol = min(lcol, rcol);
-        if (mincol >= curcol) {
-            break;
+    const auto a_row_ptrs = a->get_const_row_ptrs();
+    const auto a_col_idxs = a->get_const_col_idxs();
+    const auto a_vals = a->get_const_values();
+    const auto b_row_ptrs = b->get_const_row_ptrs();
+    const auto b_col_idxs = b->get_const_col_idxs();
+    const auto b_vals = b->get_const_values();
+    for (auto a_nz = a_row_ptrs[row]; a_nz < a_row_ptrs[row + 1]; ++a_nz) {
+        const auto b_row = a_col_idxs[a_nz];
+        const auto a_val = scale * a_vals[a_nz];
+        for (auto b_nz = b_row_ptrs[b_row]; b_nz < b_row_ptrs[b_row + 1];
+             ++b_nz) {
+            acc.add(b_col_idxs[b_nz], a_val * b_vals[b_nz]);
         }
-        auto minchild = lcol == mincol ? lchild : rchild;
-        std::swap(heap[minchild], heap[idx]);
-        idx = minchild;
     }
 }
 
@@ -230,95 +444,25 @@ void sift_down(HeapElement* heap, typename HeapElement::index_type idx,
 /**
  * @internal
  *
- * Generic SpGEMM implementation for a single output row of A * B using binary
- * heap-based multiway merging.
- *
- * @param row  The row for which to compute the SpGEMM
- * @param a  The input matrix A
- * @param b  The input matrix B (its column indices must be sorted within each
- *           row!)
- * @param heap  The heap to use for this implementation. It must have as many
- *              entries as the input row has non-zeros.
- * @param init_cb  function to initialize the state for a single row. Its return
- *                 value will be updated by subsequent calls of other callbacks,
- *                 and then returned by this function. Its signature must be
- *                 compatible with `return_type state = init_cb(row)`.
- * @param step_cb  function that will be called for each accumulation from an
- *                 entry of B into the output state. Its signature must be
- *                 compatible with `step_cb(value, column, state)`.
- * @param col_cb  function that will be called once for each output column after
- *                all accumulations into it are completed. Its signature must be
- *                compatible with `col_cb(column, state)`.
- * @return the value initialized by init_cb and updated by step_cb and col_cb
- * @note If the columns of B are not sorted, the output may have duplicate
- *       column entries.
- *
- * @tparam HeapElement  the heap element type. See col_heap_element and
- *                      val_heap_element
- * @tparam InitCallback  functor type for init_cb
- * @tparam StepCallback  functor type for step_cb
- * @tparam ColCallback  functor type for col_cb
+ * Adds the sparsity pattern of a row of a * b to the accumulator.
  */
-template <typename HeapElement, typename InitCallback, typename StepCallback,
-          typename ColCallback>
-auto spgemm_multiway_merge(size_type row,
-                           const typename HeapElement::matrix_type* a,
-                           const typename HeapElement::matrix_type* b,
-                           HeapElement* heap, InitCallback init_cb,
-                           StepCallback step_cb, ColCallback col_cb)
-    -> decltype(init_cb(0))
+template <typename ValueType, typename IndexType>
+void spgemm_insert_row(spgemm_accumulator<ValueType, IndexType>& acc,
+                       const matrix::Csr<ValueType, IndexType>* a,
+                       const matrix::Csr<ValueType, IndexType>* b,
+                       size_type row)
 {
-    auto a_row_ptrs = a->get_const_row_ptrs();
-    auto a_cols = a->get_const_col_idxs();
-    auto a_vals = a->get_const_values();
-    auto b_row_ptrs = b->get_const_row_ptrs();
-    auto b_cols = b->get_const_col_idxs();
-    auto b_vals = b->get_const_values();
-    auto a_begin = a_row_ptrs[row];
-    auto a_end = a_row_ptrs[row + 1];
-
-    using index_type = typename HeapElement::index_type;
-    constexpr auto sentinel = std::numeric_limits<index_type>::max();
-
-    auto state = init_cb(row);
-
-    // initialize the heap
-    for (auto a_nz = a_begin; a_nz < a_end; ++a_nz) {
-        auto b_row = a_cols[a_nz];
-        auto b_begin = b_row_ptrs[b_row];
-        auto b_end = b_row_ptrs[b_row + 1];
-        heap[a_nz] = {b_begin, b_end,
-                      checked_load(b_cols, b_begin, b_end, sentinel),
-                      a_vals[a_nz]};
-    }
-
-    if (a_begin != a_end) {
-        // make heap:
-        auto a_size = a_end - a_begin;
-        for (auto i = (a_size - 2) / 2; i >= 0; --i) {
-            sift_down(heap + a_begin, i, a_size);
-        }
-        auto& top = heap[a_begin];
-        auto& bot = heap[a_end - 1];
-        auto col = top.col;
-
-        while (top.col != sentinel) {
-            step_cb(b_vals[top.idx] * top.val(), top.col, state);
-            // move to the next element
-            top.idx++;
-            top.col = checked_load(b_cols, top.idx, top.end, sentinel);
-            // restore heap property
-            // pop_heap swaps top and bot, we need to prevent that
-            // so that we do a simple sift_down instead
-            sift_down(heap + a_begin, index_type{}, a_size);
-            if (top.col != col) {
-                col_cb(col, state);
-            }
-            col = top.col;
+    const auto a_row_ptrs = a->get_const_row_ptrs();
+    const auto a_col_idxs = a->get_const_col_idxs();
+    const auto b_row_ptrs = b->get_const_row_ptrs();
+    const auto b_col_idxs = b->get_const_col_idxs();
+    for (auto a_nz = a_row_ptrs[row]; a_nz < a_row_ptrs[row + 1]; ++a_nz) {
+        const auto b_row = a_col_idxs[a_nz];
+        for (auto b_nz = b_row_ptrs[b_row]; b_nz < b_row_ptrs[b_row + 1];
+             ++b_nz) {
+            acc.add(b_col_idxs[b_nz]);
         }
     }
-
-    return state;
 }
 
 
@@ -332,33 +476,25 @@ void spgemm(std::shared_ptr<const OmpExecutor> exec,
             matrix::Csr<ValueType, IndexType>* c)
 {
     auto num_rows = a->get_size()[0];
+    auto num_cols = b->get_size()[1];
     auto c_row_ptrs = c->get_row_ptrs();
 
-    array<col_heap_element<ValueType, IndexType>> col_heap_array(
-        exec, a->get_num_stored_elements());
-
-    auto col_heap = col_heap_array.get_data();
-
-    // first sweep: count nnz for each row
-#pragma omp parallel for
-    for (size_type a_row = 0; a_row < num_rows; ++a_row) {
-        c_row_ptrs[a_row] = spgemm_multiway_merge(
-            a_row, a, b, col_heap, [](size_type) { return IndexType{}; },
-            [](ValueType, IndexType, IndexType&) {},
-            [](IndexType, IndexType& nnz) { nnz++; });
+    // symbolic phase: count nnz for each row
+#pragma omp parallel
+    {
+        spgemm_accumulator<ValueType, IndexType> acc{exec, num_cols};
+#pragma omp for schedule(dynamic, 64)
+        for (size_type a_row = 0; a_row < num_rows; ++a_row) {
+            acc.start_row(spgemm_row_products(a, b, a_row));
+            spgemm_insert_row(acc, a, b, a_row);
+            c_row_ptrs[a_row] = static_cast<IndexType>(acc.size());
+        }
     }
 
-    col_heap_array.clear();
-
-    array<val_heap_element<ValueType, IndexType>> heap_array(
-        exec, a->get_num_stored_elements());
-
-    auto heap = heap_array.get_data();
-
     // build row pointers
     components::prefix_sum(exec, c_row_ptrs, num_rows + 1);
 
-    // second sweep: accumulate non-zeros
+    // numeric phase: accumulate non-zeros
     auto new_nnz = c_row_ptrs[num_rows];
     matrix::CsrBuilder<ValueType, IndexType> c_builder{c};
     auto& c_col_idxs_array = c_builder.get_col_idx_array();
@@ -368,21 +504,16 @@ void spgemm(std::shared_ptr<const OmpExecutor> exec,
     auto c_col_idxs = c_col_idxs_array.get_data();
     auto c_vals = c_vals_array.get_data();
 
-#pragma omp parallel for
-    for (size_type a_row = 0; a_row < num_rows; ++a_row) {
-        spgemm_multiway_merge(
-            a_row, a, b, heap,
-            [&](size_type row) {
-                return std::make_pair(zero<ValueType>(), c_row_ptrs[row]);
-            },
-            [](ValueType val, IndexType,
-               std::pair<ValueType, IndexType>& state) { state.first += val; },
-            [&](IndexType col, std::pair<ValueType, IndexType>& state) {
-                c_col_idxs[state.second] = col;
-                c_vals[state.second] = state.first;
-                state.first = zero<ValueType>();
-                state.second++;
-            });
+#pragma omp parallel
+    {
+        spgemm_accumulator<ValueType, IndexType> acc{exec, num_cols};
+#pragma omp for schedule(dynamic, 64)
+        for (size_type a_row = 0; a_row < num_rows; ++a_row) {
+            acc.start_row(c_row_ptrs[a_row + 1] - c_row_ptrs[a_row]);
+            spgemm_accumulate_row(acc, a, b, one<ValueType>(), a_row);
+            acc.write_sorted(c_col_idxs + c_row_ptrs[a_row],
+                             c_vals + c_row_ptrs[a_row]);
+        }
     }
 }
 
@@ -399,49 +530,35 @@ void advanced_spgemm(std::shared_ptr<const OmpExecutor> exec,
                      matrix::Csr<ValueType, IndexType>* c)
 {
     auto num_rows = a->get_size()[0];
+    auto num_cols = b->get_size()[1];
     auto valpha = alpha->at(0, 0);
     auto vbeta = beta->at(0, 0);
-    constexpr auto sentinel = std::numeric_limits<IndexType>::max();
-
-    // first sweep: count nnz for each row
     auto c_row_ptrs = c->get_row_ptrs();
     auto d_row_ptrs = d->get_const_row_ptrs();
     auto d_cols = d->get_const_col_idxs();
     auto d_vals = d->get_const_values();
 
-    array<val_heap_element<ValueType, IndexType>> heap_array(
-        exec, a->get_num_stored_elements());
-
-    auto heap = heap_array.get_data();
-    auto col_heap =
-        reinterpret_cast<col_heap_element<ValueType, IndexType>*>(heap);
-
-    // first sweep: count nnz for each row
-#pragma omp parallel for
-    for (size_type a_row = 0; a_row < num_rows; ++a_row) {
-        auto d_nz = d_row_ptrs[a_row];
-        auto d_end = d_row_ptrs[a_row + 1];
-        auto d_col = checked_load(d_cols, d_nz, d_end, sentinel);
-        c_row_ptrs[a_row] = spgemm_multiway_merge(
-            a_row, a, b, col_heap, [](size_type row) { return IndexType{}; },
-            [](ValueType, IndexType, IndexType&) {},
-            [&](IndexType col, IndexType& nnz) {
-                // skip smaller elements from d
-                while (d_col <= col) {
-                    d_nz++;
-                    nnz += d_col != col;
-                    d_col = checked_load(d_cols, d_nz, d_end, sentinel);
-                }
-                nnz++;
-            });
-        // handle the remaining columns from d
-        c_row_ptrs[a_row] += d_end - d_nz;
+    // symbolic phase: count nnz for each row
+#pragma omp parallel
+    {
+        spgemm_accumulator<ValueType, IndexType> acc{exec, num_cols};
+#pragma omp for schedule(dynamic, 64)
+        for (size_type a_row = 0; a_row < num_rows; ++a_row) {
+            const auto d_begin = d_row_ptrs[a_row];
+            const auto d_end = d_row_ptrs[a_row + 1];
+            acc.start_row(spgemm_row_products(a, b, a_row) + d_end - d_begin);
+            for (auto d_nz = d_begin; d_nz < d_end; ++d_nz) {
+                acc.add(d_cols[d_nz]);
+            }
+            spgemm_insert_row(acc, a, b, a_row);
+            c_row_ptrs[a_row] = static_cast<IndexType>(acc.size());
+        }
     }
 
     // build row pointers
     components::prefix_sum(exec, c_row_ptrs, num_rows + 1);
 
-    // second sweep: accumulate non-zeros
+    // numeric phase: accumulate non-zeros
     auto new_nnz = c_row_ptrs[num_rows];
     matrix::CsrBuilder<ValueType, IndexType> c_builder{c};
     auto& c_col_idxs_array = c_builder.get_col_idx_array();
@@ -451,53 +568,19 @@ void advanced_spgemm(std::shared_ptr<const OmpExecutor> exec,
     auto c_col_idxs = c_col_idxs_array.get_data();
     auto c_vals = c_vals_array.get_data();
 
-#pragma omp parallel for
-    for (size_type a_row = 0; a_row < num_rows; ++a_row) {
-        auto d_nz = d_row_ptrs[a_row];
-        auto d_end = d_row_ptrs[a_row + 1];
-        auto d_col = checked_load(d_cols, d_nz, d_end, sentinel);
-        auto d_val = checked_load(d_vals, d_nz, d_end, zero<ValueType>());
-        auto c_nz =
-            spgemm_multiway_merge(
-                a_row, a, b, heap,
-                [&](size_type row) {
-                    return std::make_pair(zero<ValueType>(), c_row_ptrs[row]);
-                },
-                [](ValueType val, IndexType,
-                   std::pair<ValueType, IndexType>& state) {
-                    state.first += val;
-                },
-                [&](IndexType col, std::pair<ValueType, IndexType>& state) {
-                    // handle smaller elements from d
-                    ValueType part_d_val{};
-                    while (d_col <= col) {
-                        if (d_col == col) {
-                            part_d_val = d_val;
-                        } else {
-                            c_col_idxs[state.second] = d_col;
-                            c_vals[state.second] = vbeta * d_val;
-                            state.second++;
-                        }
-                        d_nz++;
-                        d_col = checked_load(d_cols, d_nz, d_end, sentinel);
-                        d_val = checked_load(d_vals, d_nz, d_end,
-                                             zero<ValueType>());
-                    }
-                    c_col_idxs[state.second] = col;
-                    c_vals[state.second] =
-                        vbeta * part_d_val + valpha * state.first;
-                    state.first = zero<ValueType>();
-                    state.second++;
-                })
-                .second;
-        // handle remaining elements from d
-        while (d_col < sentinel) {
-            c_col_idxs[c_nz] = d_col;
-            c_vals[c_nz] = vbeta * d_val;
-            c_nz++;
-            d_nz++;
-            d_col = checked_load(d_cols, d_nz, d_end, sentinel);
-            d_val = checked_load(d_vals, d_nz, d_end, zero<ValueType>());
+#pragma omp parallel
+    {
+        spgemm_accumulator<ValueType, IndexType> acc{exec, num_cols};
+#pragma omp for schedule(dynamic, 64)
+        for (size_type a_row = 0; a_row < num_rows; ++a_row) {
+            acc.start_row(c_row_ptrs[a_row + 1] - c_row_ptrs[a_row]);
+            for (auto d_nz = d_row_ptrs[a_row]; d_nz < d_row_ptrs[a_row + 1];
+                 ++d_nz) {
+                acc.add(d_cols[d_nz], vbeta * d_vals[d_nz]);
+            }
+            spgemm_accumulate_row(acc, a, b, valpha, a_row);
+            acc.write_sorted(c_col_idxs + c_row_ptrs[a_row],
+                             c_vals + c_row_ptrs[a_row]);
         }
     }
 }
@@ -506,6 +589,58 @@ GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(
     GKO_DECLARE_CSR_ADVANCED_SPGEMM_KERNEL);
 
 
+template <typename ValueType, typename IndexType>
+void masked_spgemm(std::shared_ptr<const OmpExecutor> exec,
+                   const matrix::Csr<ValueType, IndexType>* a,
+                   const matrix::Csr<ValueType, IndexType>* b,
+                   matrix::Csr<ValueType, IndexType>* c)
+{
+    auto num_rows = a->get_size()[0];
+    auto num_cols = b->get_size()[1];
+    auto a_row_ptrs = a->get_const_row_ptrs();
+    auto a_col_idxs = a->get_const_col_idxs();
+    auto a_vals = a->get_const_values();
+    auto b_row_ptrs = b->get_const_row_ptrs();
+    auto b_col_idxs = b->get_const_col_idxs();
+    auto b_vals = b->get_const_values();
+    auto c_row_ptrs = c->get_const_row_ptrs();
+    auto c_col_idxs = c->get_const_col_idxs();
+    auto c_vals = c->get_values();
+
+#pragma omp parallel
+    {
+        // maps the columns of a row of c to their positions in the row
+        spgemm_accumulator<ValueType, IndexType> acc{exec, num_cols};
+#pragma omp for schedule(dynamic, 64)
+        for (size_type row = 0; row < num_rows; ++row) {
+            const auto c_begin = c_row_ptrs[row];
+            const auto c_size = c_row_ptrs[row + 1] - c_begin;
+            if (c_size == 0) {
+                continue;
+            }
+            acc.start_row(c_size);
+            for (auto c_nz = c_begin; c_nz < c_row_ptrs[row + 1]; ++c_nz) {
+                acc.add(c_col_idxs[c_nz]);
+            }
+            for (auto a_nz = a_row_ptrs[row]; a_nz < a_row_ptrs[row + 1];
+                 ++a_nz) {
+                const auto b_row = a_col_idxs[a_nz];
+                const auto a_val = a_vals[a_nz];
+                for (auto b_nz = b_row_ptrs[b_row];
+                     b_nz < b_row_ptrs[b_row + 1]; ++b_nz) {
+                    acc.add_if_present(b_col_idxs[b_nz], a_val * b_vals[b_nz]);
+                }
+            }
+            // the accumulator stores the entries in insertion order
+            acc.write_unsorted(c_vals + c_begin);
+        }
+    }
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(
+    GKO_DECLARE_CSR_MASKED_SPGEMM_KERNEL);
+
+
 template <typename ValueType, typename IndexType>
 void spgeam(std::shared_ptr<const OmpExecutor> exec,
             const matrix::Dense<ValueType>* alpha,
@@ -649,49 +784,21 @@ GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(
     GKO_DECLARE_CSR_CONVERT_TO_FBCSR_KERNEL);
 
 
-template <typename ValueType, typename IndexType, typename UnaryOperator>
-inline void convert_csr_to_csc(size_type num_rows, const IndexType* row_ptrs,
-                               const IndexType* col_idxs,
-                               const ValueType* csr_vals, IndexType* row_idxs,
-                               IndexType* col_ptrs, ValueType* csc_vals,
-                               UnaryOperator op)
-{
-    for (size_type row = 0; row < num_rows; ++row) {
-        for (auto i = row_ptrs[row]; i < row_ptrs[row + 1]; ++i) {
-            const auto dest_idx = col_ptrs[col_idxs[i]]++;
-            row_idxs[dest_idx] = row;
-            csc_vals[dest_idx] = op(csr_vals[i]);
-        }
-    }
-}
-
-
 template <typename ValueType, typename IndexType, typename UnaryOperator>
 void transpose_and_transform(std::shared_ptr<const OmpExecutor> exec,
                              matrix::Csr<ValueType, IndexType>* trans,
                              const matrix::Csr<ValueType, IndexType>* orig,
                              UnaryOperator op)
 {
-    auto trans_row_ptrs = trans->get_row_ptrs();
-    auto orig_row_ptrs = orig->get_const_row_ptrs();
-    auto trans_col_idxs = trans->get_col_idxs();
-    auto orig_col_idxs = orig->get_const_col_idxs();
-    auto trans_vals = trans->get_values();
     auto orig_vals = orig->get_const_values();
-
-    auto orig_num_cols = orig->get_size()[1];
-    auto orig_num_rows = orig->get_size()[0];
-    auto orig_nnz = orig_row_ptrs[orig_num_rows];
-
-    components::fill_array(exec, trans_row_ptrs, orig_num_cols + 1,
-                           IndexType{});
-    for (size_type i = 0; i < orig_nnz; i++) {
-        trans_row_ptrs[orig_col_idxs[i] + 1]++;
-    }
-    components::prefix_sum(exec, trans_row_ptrs + 1, orig_num_cols);
-
-    convert_csr_to_csc(orig_num_rows, orig_row_ptrs, orig_col_idxs, orig_vals,
-                       trans_col_idxs, trans_row_ptrs + 1, trans_vals, op);
+    auto trans_vals = trans->get_values();
+    abstract_transpose(
+        exec, orig->get_size()[0], orig->get_size()[1],
+        orig->get_const_row_ptrs(), orig->get_const_col_idxs(),
+        trans->get_row_ptrs(), trans->get_col_idxs(),
+        [&](IndexType in_nz, IndexType out_nz) {
+            trans_vals[out_nz] = op(orig_vals[in_nz]);
+        });
 }
 
 
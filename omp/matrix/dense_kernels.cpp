@@ -54,6 +54,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "accessor/block_col_major.hpp"
 #include "accessor/range.hpp"
+#include "core/base/allocator.hpp"
 #include "core/components/prefix_sum_kernels.hpp"
 
 
@@ -109,65 +110,238 @@ GKO_INSTANTIATE_FOR_EACH_VALUE_TYPE(
     GKO_DECLARE_DENSE_COMPUTE_NORM2_DISPATCH_KERNEL);
 
 
+namespace {
+
+
+// Blocking parameters of the packed GEMM: the micro-kernel keeps a
+// gemm_mr x gemm_nr tile of C in registers while streaming through packed
+// micro-panels of A and B. A gemm_mc x gemm_kc block of A is sized for the
+// L2 cache, a gemm_kc x gemm_nr micro-panel of B for the L1 cache.
+constexpr size_type gemm_mr = 4;
+constexpr size_type gemm_nr = 8;
+constexpr size_type gemm_mc = 64;
+constexpr size_type gemm_kc = 256;
+constexpr size_type gemm_nc = 256;
+
+
+// packs rows [row_begin, row_end) and columns [k_begin, k_end) of a into
+// gemm_mr-row micro-panels stored column by column, padded with zeros
 template <typename ValueType>
-void simple_apply(std::shared_ptr<const DefaultExecutor> exec,
-                  const matrix::Dense<ValueType>* a,
-                  const matrix::Dense<ValueType>* b,
-                  matrix::Dense<ValueType>* c)
+void gemm_pack_a(const matrix::Dense<ValueType>* a, size_type row_begin,
+                 size_type row_end, size_type k_begin, size_type k_end,
+                 ValueType* GKO_RESTRICT packed)
 {
-#pragma omp parallel for
-    for (size_type row = 0; row < c->get_size()[0]; ++row) {
-        for (size_type col = 0; col < c->get_size()[1]; ++col) {
-            c->at(row, col) = zero<ValueType>();
+    const auto kc = k_end - k_begin;
+    for (auto panel = row_begin; panel < row_end; panel += gemm_mr) {
+        const auto panel_packed = packed + (panel - row_begin) * kc;
+        for (size_type i = 0; i < gemm_mr; ++i) {
+            const auto row = panel + i;
+            if (row < row_end) {
+                const auto a_row = a->get_const_values() +
+                                   row * a->get_stride() + k_begin;
+                for (size_type k = 0; k < kc; ++k) {
+                    panel_packed[k * gemm_mr + i] = a_row[k];
+                }
+            } else {
+                for (size_type k = 0; k < kc; ++k) {
+                    panel_packed[k * gemm_mr + i] = zero<ValueType>();
+                }
+            }
         }
     }
+}
 
-#pragma omp parallel for
-    for (size_type row = 0; row < c->get_size()[0]; ++row) {
-        for (size_type inner = 0; inner < a->get_size()[1]; ++inner) {
-            for (size_type col = 0; col < c->get_size()[1]; ++col) {
-                c->at(row, col) += a->at(row, inner) * b->at(inner, col);
+
+// packs rows [k_begin, k_end) and columns [col_begin, col_end) of b into
+// gemm_nr-column micro-panels stored row by row, padded with zeros
+template <typename ValueType>
+void gemm_pack_b(const matrix::Dense<ValueType>* b, size_type k_begin,
+                 size_type k_end, size_type col_begin, size_type col_end,
+                 ValueType* GKO_RESTRICT packed)
+{
+    const auto kc = k_end - k_begin;
+    for (auto panel = col_begin; panel < col_end; panel += gemm_nr) {
+        const auto panel_packed = packed + (panel - col_begin) * kc;
+        const auto panel_cols = std::min(gemm_nr, col_end - panel);
+        for (size_type k = 0; k < kc; ++k) {
+            const auto b_row =
+                b->get_const_values() + (k_begin + k) * b->get_stride() + panel;
+            size_type j = 0;
+            for (; j < panel_cols; ++j) {
+                panel_packed[k * gemm_nr + j] = b_row[j];
+            }
+            for (; j < gemm_nr; ++j) {
+                panel_packed[k * gemm_nr + j] = zero<ValueType>();
             }
         }
     }
 }
 
-GKO_INSTANTIATE_FOR_EACH_VALUE_TYPE(GKO_DECLARE_DENSE_SIMPLE_APPLY_KERNEL);
-
 
 template <typename ValueType>
-void apply(std::shared_ptr<const DefaultExecutor> exec,
-           const matrix::Dense<ValueType>* alpha,
-           const matrix::Dense<ValueType>* a, const matrix::Dense<ValueType>* b,
-           const matrix::Dense<ValueType>* beta, matrix::Dense<ValueType>* c)
+void gemm_micro_kernel(size_type kc, const ValueType* GKO_RESTRICT a,
+                       const ValueType* GKO_RESTRICT b,
+                       ValueType (&tile)[gemm_mr][gemm_nr])
 {
-    if (is_nonzero(beta->at(0, 0))) {
-#pragma omp parallel for
-        for (size_type row = 0; row < c->get_size()[0]; ++row) {
-            for (size_type col = 0; col < c->get_size()[1]; ++col) {
-                c->at(row, col) *= beta->at(0, 0);
+    // accumulate in a local array so it can be kept in registers
+    ValueType sum[gemm_mr][gemm_nr]{};
+    for (size_type k = 0; k < kc; ++k) {
+        for (size_type i = 0; i < gemm_mr; ++i) {
+            const auto a_val = a[k * gemm_mr + i];
+            for (size_type j = 0; j < gemm_nr; ++j) {
+                sum[i][j] += a_val * b[k * gemm_nr + j];
             }
         }
+    }
+    for (size_type i = 0; i < gemm_mr; ++i) {
+        for (size_type j = 0; j < gemm_nr; ++j) {
+            tile[i][j] = sum[i][j];
+        }
+    }
+}
+
+
+// stores alpha * update into c, combined with beta * c for the first
+// contribution. A missing beta overwrites c without reading it.
+template <typename ValueType>
+void gemm_update(ValueType& c, ValueType alpha, ValueType update,
+                 const ValueType* beta, bool first)
+{
+    if (!first) {
+        c += alpha * update;
+    } else if (beta) {
+        c = *beta * c + alpha * update;
     } else {
+        c = alpha * update;
+    }
+}
+
+
+/**
+ * Computes c = alpha * a * b + beta * c, or c = alpha * a * b if beta is
+ * nullptr. Wide products use a packed, register-blocked algorithm
+ * parallelized over blocks of c, narrow ones (like matrix-vector products)
+ * are parallelized over the rows of c.
+ */
+template <typename ValueType>
+void gemm(std::shared_ptr<const DefaultExecutor> exec, ValueType alpha,
+          const matrix::Dense<ValueType>* a, const matrix::Dense<ValueType>* b,
+          const ValueType* beta, matrix::Dense<ValueType>* c)
+{
+    const auto num_rows = c->get_size()[0];
+    const auto num_cols = c->get_size()[1];
+    const auto num_inner = a->get_size()[1];
+    if (num_rows == 0 || num_cols == 0) {
+        return;
+    }
+    if (num_inner == 0) {
 #pragma omp parallel for
-        for (size_type row = 0; row < c->get_size()[0]; ++row) {
-            for (size_type col = 0; col < c->get_size()[1]; ++col) {
-                c->at(row, col) *= zero<ValueType>();
+        for (size_type row = 0; row < num_rows; ++row) {
+            for (size_type col = 0; col < num_cols; ++col) {
+                c->at(row, col) =
+                    beta ? *beta * c->at(row, col) : zero<ValueType>();
             }
         }
+        return;
     }
-
+    if (num_cols < gemm_nr) {
 #pragma omp parallel for
-    for (size_type row = 0; row < c->get_size()[0]; ++row) {
-        for (size_type inner = 0; inner < a->get_size()[1]; ++inner) {
-            for (size_type col = 0; col < c->get_size()[1]; ++col) {
-                c->at(row, col) +=
-                    alpha->at(0, 0) * a->at(row, inner) * b->at(inner, col);
+        for (size_type row = 0; row < num_rows; ++row) {
+            ValueType sum[gemm_nr]{};
+            for (size_type inner = 0; inner < num_inner; ++inner) {
+                const auto a_val = a->at(row, inner);
+                for (size_type col = 0; col < num_cols; ++col) {
+                    sum[col] += a_val * b->at(inner, col);
+                }
+            }
+            for (size_type col = 0; col < num_cols; ++col) {
+                gemm_update(c->at(row, col), alpha, sum[col], beta, true);
+            }
+        }
+        return;
+    }
+    // shrink the row blocks until every thread has at least one block of c
+    const auto num_col_blocks =
+        static_cast<size_type>(ceildiv(num_cols, gemm_nc));
+    const auto num_threads = static_cast<size_type>(omp_get_max_threads());
+    auto mc = gemm_mc;
+    while (mc > gemm_mr &&
+           static_cast<size_type>(ceildiv(num_rows, mc)) * num_col_blocks <
+               num_threads) {
+        mc /= 2;
+    }
+    const auto num_row_blocks = static_cast<size_type>(ceildiv(num_rows, mc));
+    const auto num_blocks = num_row_blocks * num_col_blocks;
+#pragma omp parallel
+    {
+        vector<ValueType> packed_a(mc * gemm_kc, {}, exec);
+        vector<ValueType> packed_b(gemm_kc * gemm_nc, {}, exec);
+        ValueType tile[gemm_mr][gemm_nr];
+#pragma omp for schedule(dynamic)
+        for (size_type block = 0; block < num_blocks; ++block) {
+            const auto row_begin = (block % num_row_blocks) * mc;
+            const auto row_end = std::min(row_begin + mc, num_rows);
+            const auto col_begin = (block / num_row_blocks) * gemm_nc;
+            const auto col_end = std::min(col_begin + gemm_nc, num_cols);
+            for (size_type k_begin = 0; k_begin < num_inner;
+                 k_begin += gemm_kc) {
+                const auto k_end = std::min(k_begin + gemm_kc, num_inner);
+                const auto kc = k_end - k_begin;
+                const auto first = k_begin == 0;
+                gemm_pack_b(b, k_begin, k_end, col_begin, col_end,
+                            packed_b.data());
+                gemm_pack_a(a, row_begin, row_end, k_begin, k_end,
+                            packed_a.data());
+                for (auto col = col_begin; col < col_end; col += gemm_nr) {
+                    const auto b_panel =
+                        packed_b.data() + (col - col_begin) * kc;
+                    const auto tile_cols = std::min(gemm_nr, col_end - col);
+                    for (auto row = row_begin; row < row_end;
+                         row += gemm_mr) {
+                        gemm_micro_kernel(
+                            kc, packed_a.data() + (row - row_begin) * kc,
+                            b_panel, tile);
+                        const auto tile_rows =
+                            std::min(gemm_mr, row_end - row);
+                        for (size_type i = 0; i < tile_rows; ++i) {
+                            for (size_type j = 0; j < tile_cols; ++j) {
+                                gemm_update(c->at(row + i, col + j), alpha,
+                                            tile[i][j], beta, first);
+                            }
+                        }
+                    }
+                }
             }
         }
     }
 }
 
+
+}  // namespace
+
+
+template <typename ValueType>
+void simple_apply(std::shared_ptr<const DefaultExecutor> exec,
+                  const matrix::Dense<ValueType>* a,
+                  const matrix::Dense<ValueType>* b,
+                  matrix::Dense<ValueType>* c)
+{
+    gemm(exec, one<ValueType>(), a, b, static_cast<const ValueType*>(nullptr),
+         c);
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_TYPE(GKO_DECLARE_DENSE_SIMPLE_APPLY_KERNEL);
+
+
+template <typename ValueType>
+void apply(std::shared_ptr<const DefaultExecutor> exec,
+           const matrix::Dense<ValueType>* alpha,
+           const matrix::Dense<ValueType>* a, const matrix::Dense<ValueType>* b,
+           const matrix::Dense<ValueType>* beta, matrix::Dense<ValueType>* c)
+{
+    gemm(exec, alpha->at(0, 0), a, b, beta->get_const_values(), c);
+}
+
 GKO_INSTANTIATE_FOR_EACH_VALUE_TYPE(GKO_DECLARE_DENSE_APPLY_KERNEL);
 
 
@@ -56,6 +56,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "core/components/fill_array_kernels.hpp"
 #include "core/components/prefix_sum_kernels.hpp"
 #include "core/synthesizer/implementation_selection.hpp"
+#include "omp/components/csr_transpose.hpp"
 
 
 namespace gko {
@@ -292,38 +293,6 @@ GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(
     GKO_DECLARE_FBCSR_CONVERT_TO_CSR_KERNEL);
 
 
-template <typename ValueType, typename IndexType, typename UnaryOperator,
-          bool transpose_blocks>
-void convert_fbcsr_to_fbcsc(const IndexType num_blk_rows, const int blksz,
-                            const IndexType* const row_ptrs,
-                            const IndexType* const col_idxs,
-                            const ValueType* const fbcsr_vals,
-                            IndexType* const row_idxs,
-                            IndexType* const col_ptrs,
-                            ValueType* const csc_vals, UnaryOperator op)
-{
-    auto sizes =
-        gko::to_std_array<acc::size_type>(row_ptrs[num_blk_rows], blksz, blksz);
-    const acc::range<acc::block_col_major<const ValueType, 3>> rvalues(
-        sizes, fbcsr_vals);
-    acc::range<acc::block_col_major<ValueType, 3>> cvalues(sizes, csc_vals);
-    for (IndexType brow = 0; brow < num_blk_rows; ++brow) {
-        for (auto i = row_ptrs[brow]; i < row_ptrs[brow + 1]; ++i) {
-            const auto dest_idx = col_ptrs[col_idxs[i]];
-            col_ptrs[col_idxs[i]]++;
-            row_idxs[dest_idx] = brow;
-            for (int ib = 0; ib < blksz; ib++) {
-                for (int jb = 0; jb < blksz; jb++) {
-                    cvalues(dest_idx, ib, jb) =
-                        op(transpose_blocks ? rvalues(i, jb, ib)
-                                            : rvalues(i, ib, jb));
-                }
-            }
-        }
-    }
-}
-
-
 template <typename ValueType, typename IndexType, typename UnaryOperator>
 void transpose_and_transform(
     std::shared_ptr<const OmpExecutor> exec,
@@ -331,26 +300,24 @@ void transpose_and_transform(
     const matrix::Fbcsr<ValueType, IndexType>* const orig, UnaryOperator op)
 {
     const int bs = orig->get_block_size();
-    auto trans_row_ptrs = trans->get_row_ptrs();
-    auto orig_row_ptrs = orig->get_const_row_ptrs();
-    auto trans_col_idxs = trans->get_col_idxs();
-    auto orig_col_idxs = orig->get_const_col_idxs();
-    auto trans_vals = trans->get_values();
-    auto orig_vals = orig->get_const_values();
-
-    const IndexType nbcols = orig->get_num_block_cols();
-    const IndexType nbrows = orig->get_num_block_rows();
-    auto orig_nbnz = orig_row_ptrs[nbrows];
-
-    components::fill_array(exec, trans_row_ptrs, nbcols + 1, IndexType{});
-    for (size_type i = 0; i < orig_nbnz; i++) {
-        trans_row_ptrs[orig_col_idxs[i] + 1]++;
-    }
-    components::prefix_sum(exec, trans_row_ptrs + 1, nbcols);
-
-    convert_fbcsr_to_fbcsc<ValueType, IndexType, UnaryOperator, true>(
-        nbrows, bs, orig_row_ptrs, orig_col_idxs, orig_vals, trans_col_idxs,
-        trans_row_ptrs + 1, trans_vals, op);
+    const auto nbrows = orig->get_num_block_rows();
+    const auto sizes = gko::to_std_array<acc::size_type>(
+        orig->get_num_stored_blocks(), bs, bs);
+    const acc::range<acc::block_col_major<const ValueType, 3>> orig_vals(
+        sizes, orig->get_const_values());
+    acc::range<acc::block_col_major<ValueType, 3>> trans_vals(
+        sizes, trans->get_values());
+    abstract_transpose(exec, nbrows, orig->get_num_block_cols(),
+                       orig->get_const_row_ptrs(), orig->get_const_col_idxs(),
+                       trans->get_row_ptrs(), trans->get_col_idxs(),
+                       [&](IndexType in_nz, IndexType out_nz) {
+                           for (int ib = 0; ib < bs; ib++) {
+                               for (int jb = 0; jb < bs; jb++) {
+                                   trans_vals(out_nz, ib, jb) =
+                                       op(orig_vals(in_nz, jb, ib));
+                               }
+                           }
+                       });
 }
 
 
@@ -33,9 +33,6 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "core/matrix/sellp_kernels.hpp"
 
 
-#include <array>
-
-
 #include <omp.h>
 
 
@@ -53,103 +50,114 @@ namespace omp {
 namespace sellp {
 
 
-template <int num_rhs, typename ValueType, typename IndexType, typename OutFn>
-void spmv_small_rhs(std::shared_ptr<const OmpExecutor> exec,
-                    const matrix::Sellp<ValueType, IndexType>* a,
+/**
+ * Computes the columns [rhs_begin, rhs_begin + num_rhs) of the product for the
+ * row_block consecutive rows of a slice starting at block_begin. The rows of
+ * the block are processed together, so the loads of values and column indices
+ * are contiguous. Padding entries are skipped, so they never read from b.
+ */
+template <int row_block, int num_rhs, typename ValueType, typename IndexType,
+          typename OutFn>
+void spmv_row_block(const matrix::Sellp<ValueType, IndexType>* a,
                     const matrix::Dense<ValueType>* b,
-                    matrix::Dense<ValueType>* c, OutFn out)
+                    matrix::Dense<ValueType>* c, size_type slice,
+                    size_type block_begin, size_type rhs_begin, OutFn out)
 {
-    GKO_ASSERT(b->get_size()[1] == num_rhs);
-    auto slice_lengths = a->get_const_slice_lengths();
-    auto slice_sets = a->get_const_slice_sets();
-    auto slice_size = a->get_slice_size();
-    auto slice_num = ceildiv(a->get_size()[0] + slice_size - 1, slice_size);
-#pragma omp parallel for collapse(2)
-    for (size_type slice = 0; slice < slice_num; slice++) {
-        for (size_type row = 0; row < slice_size; row++) {
-            size_type global_row = slice * slice_size + row;
-            if (global_row < a->get_size()[0]) {
-                std::array<ValueType, num_rhs> partial_sum;
-                partial_sum.fill(zero<ValueType>());
-                for (size_type i = 0; i < slice_lengths[slice]; i++) {
-                    auto val = a->val_at(row, slice_sets[slice], i);
-                    auto col = a->col_at(row, slice_sets[slice], i);
-                    if (col != invalid_index<IndexType>()) {
-#pragma unroll
-                        for (size_type j = 0; j < num_rhs; j++) {
-                            partial_sum[j] += val * b->at(col, j);
-                        }
-                    }
-                }
-#pragma unroll
-                for (size_type j = 0; j < num_rhs; j++) {
-                    [&] {
-                        c->at(global_row, j) =
-                            out(global_row, j, partial_sum[j]);
-                    }();
-                }
+    const auto vals = a->get_const_values();
+    const auto cols = a->get_const_col_idxs();
+    const auto slice_size = a->get_slice_size();
+    const auto slice_set = a->get_const_slice_sets()[slice];
+    const auto slice_length = a->get_const_slice_lengths()[slice];
+    const auto permutation = a->get_const_permutation();
+    const auto b_vals = b->get_const_values() + rhs_begin;
+    const auto b_stride = b->get_stride();
+    ValueType partial_sum[row_block][num_rhs];
+    for (int row = 0; row < row_block; row++) {
+        for (int j = 0; j < num_rhs; j++) {
+            partial_sum[row][j] = zero<ValueType>();
+        }
+    }
+    for (size_type i = 0; i < slice_length; i++) {
+        const auto offset = (slice_set + i) * slice_size + block_begin;
+        for (int row = 0; row < row_block; row++) {
+            const auto col = cols[offset + row];
+            if (col == invalid_index<IndexType>()) {
+                continue;
+            }
+            const auto val = vals[offset + row];
+            const auto b_row = b_vals + static_cast<size_type>(col) * b_stride;
+            for (int j = 0; j < num_rhs; j++) {
+                partial_sum[row][j] += val * b_row[j];
             }
         }
     }
+    const auto row_begin = slice * slice_size + block_begin;
+    for (int row = 0; row < row_block; row++) {
+        const auto global_row = row_begin + row;
+        // rows of SELL-C-sigma are stored in permuted order
+        const auto out_row =
+            permutation ? static_cast<size_type>(permutation[global_row])
+                        : global_row;
+        for (int j = 0; j < num_rhs; j++) {
+            c->at(out_row, rhs_begin + j) =
+                out(out_row, rhs_begin + j, partial_sum[row][j]);
+        }
+    }
 }
 
 
-template <int block_size, typename ValueType, typename IndexType,
+template <int row_block, typename ValueType, typename IndexType,
           typename OutFn>
-void spmv_blocked(std::shared_ptr<const OmpExecutor> exec,
-                  const matrix::Sellp<ValueType, IndexType>* a,
+void spmv_all_rhs(const matrix::Sellp<ValueType, IndexType>* a,
                   const matrix::Dense<ValueType>* b,
-                  matrix::Dense<ValueType>* c, OutFn out)
+                  matrix::Dense<ValueType>* c, size_type slice,
+                  size_type block_begin, OutFn out)
 {
-    auto slice_lengths = a->get_const_slice_lengths();
-    auto slice_sets = a->get_const_slice_sets();
-    auto slice_size = a->get_slice_size();
-    auto slice_num = ceildiv(a->get_size()[0] + slice_size - 1, slice_size);
+    constexpr int rhs_block = 4;
     const auto num_rhs = b->get_size()[1];
-    const auto rounded_rhs = num_rhs / block_size * block_size;
+    size_type rhs = 0;
+    for (; rhs + rhs_block <= num_rhs; rhs += rhs_block) {
+        spmv_row_block<row_block, rhs_block>(a, b, c, slice, block_begin, rhs,
+                                             out);
+    }
+    switch (num_rhs - rhs) {
+    case 3:
+        spmv_row_block<row_block, 3>(a, b, c, slice, block_begin, rhs, out);
+        break;
+    case 2:
+        spmv_row_block<row_block, 2>(a, b, c, slice, block_begin, rhs, out);
+        break;
+    case 1:
+        spmv_row_block<row_block, 1>(a, b, c, slice, block_begin, rhs, out);
+        break;
+    default:
+        break;
+    }
+}
+
+
+template <int row_block, typename ValueType, typename IndexType,
+          typename OutFn>
+void spmv_slices(const matrix::Sellp<ValueType, IndexType>* a,
+                 const matrix::Dense<ValueType>* b,
+                 matrix::Dense<ValueType>* c, OutFn out)
+{
+    const auto num_rows = a->get_size()[0];
+    const auto slice_size = a->get_slice_size();
+    const auto num_slices = ceildiv(num_rows, slice_size);
+    const auto blocks_per_slice = slice_size / row_block;
 #pragma omp parallel for collapse(2)
-    for (size_type slice = 0; slice < slice_num; slice++) {
-        for (size_type row = 0; row < slice_size; row++) {
-            size_type global_row = slice * slice_size + row;
-            if (global_row < a->get_size()[0]) {
-                std::array<ValueType, block_size> partial_sum;
-                for (size_type rhs_base = 0; rhs_base < rounded_rhs;
-                     rhs_base += block_size) {
-                    partial_sum.fill(zero<ValueType>());
-                    for (size_type i = 0; i < slice_lengths[slice]; i++) {
-                        auto val = a->val_at(row, slice_sets[slice], i);
-                        auto col = a->col_at(row, slice_sets[slice], i);
-                        if (col != invalid_index<IndexType>()) {
-#pragma unroll
-                            for (size_type j = 0; j < block_size; j++) {
-                                partial_sum[j] +=
-                                    val * b->at(col, j + rhs_base);
-                            }
-                        }
-                    }
-#pragma unroll
-                    for (size_type j = 0; j < block_size; j++) {
-                        [&] {
-                            c->at(global_row, j + rhs_base) =
-                                out(global_row, j + rhs_base, partial_sum[j]);
-                        }();
-                    }
-                }
-                partial_sum.fill(zero<ValueType>());
-                for (size_type i = 0; i < slice_lengths[slice]; i++) {
-                    auto val = a->val_at(row, slice_sets[slice], i);
-                    auto col = a->col_at(row, slice_sets[slice], i);
-                    if (col != invalid_index<IndexType>()) {
-                        for (size_type j = rounded_rhs; j < num_rhs; j++) {
-                            partial_sum[j - rounded_rhs] += val * b->at(col, j);
-                        }
-                    }
-                }
-                for (size_type j = rounded_rhs; j < num_rhs; j++) {
-                    [&] {
-                        c->at(global_row, j) =
-                            out(global_row, j, partial_sum[j - rounded_rhs]);
-                    }();
+    for (size_type slice = 0; slice < num_slices; slice++) {
+        for (size_type block = 0; block < blocks_per_slice; block++) {
+            const auto block_begin = block * row_block;
+            const auto row_begin = slice * slice_size + block_begin;
+            if (row_begin + row_block <= num_rows) {
+                spmv_all_rhs<row_block>(a, b, c, slice, block_begin, out);
+            } else {
+                // the padding rows of the last slice are not initialized
+                for (auto row = row_begin; row < num_rows; row++) {
+                    spmv_all_rhs<1>(a, b, c, slice,
+                                    block_begin + (row - row_begin), out);
                 }
             }
         }
@@ -157,6 +165,29 @@ void spmv_blocked(std::shared_ptr<const OmpExecutor> exec,
 }
 
 
+/**
+ * Processes the rows of each slice in blocks of 16, 8 or 4 rows if the slice
+ * size allows it, which matches the vector widths for the common slice sizes
+ * of SELL-C-sigma.
+ */
+template <typename ValueType, typename IndexType, typename OutFn>
+void spmv_dispatch(const matrix::Sellp<ValueType, IndexType>* a,
+                   const matrix::Dense<ValueType>* b,
+                   matrix::Dense<ValueType>* c, OutFn out)
+{
+    const auto slice_size = a->get_slice_size();
+    if (slice_size % 16 == 0) {
+        spmv_slices<16>(a, b, c, out);
+    } else if (slice_size % 8 == 0) {
+        spmv_slices<8>(a, b, c, out);
+    } else if (slice_size % 4 == 0) {
+        spmv_slices<4>(a, b, c, out);
+    } else {
+        spmv_slices<1>(a, b, c, out);
+    }
+}
+
+
 template <typename ValueType, typename IndexType>
 void spmv(std::shared_ptr<const OmpExecutor> exec,
           const matrix::Sellp<ValueType, IndexType>* a,
@@ -167,23 +198,7 @@ void spmv(std::shared_ptr<const OmpExecutor> exec,
         return;
     }
     auto out = [](auto, auto, auto value) { return value; };
-    if (num_rhs == 1) {
-        spmv_small_rhs<1>(exec, a, b, c, out);
-        return;
-    }
-    if (num_rhs == 2) {
-        spmv_small_rhs<2>(exec, a, b, c, out);
-        return;
-    }
-    if (num_rhs == 3) {
-        spmv_small_rhs<3>(exec, a, b, c, out);
-        return;
-    }
-    if (num_rhs == 4) {
-        spmv_small_rhs<4>(exec, a, b, c, out);
-        return;
-    }
-    spmv_blocked<4>(exec, a, b, c, out);
+    spmv_dispatch(a, b, c, out);
 }
 
 GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(GKO_DECLARE_SELLP_SPMV_KERNEL);
@@ -206,23 +221,7 @@ void advanced_spmv(std::shared_ptr<const OmpExecutor> exec,
     auto out = [&](auto i, auto j, auto value) {
         return alpha_val * value + beta_val * c->at(i, j);
     };
-    if (num_rhs == 1) {
-        spmv_small_rhs<1>(exec, a, b, c, out);
-        return;
-    }
-    if (num_rhs == 2) {
-        spmv_small_rhs<2>(exec, a, b, c, out);
-        return;
-    }
-    if (num_rhs == 3) {
-        spmv_small_rhs<3>(exec, a, b, c, out);
-        return;
-    }
-    if (num_rhs == 4) {
-        spmv_small_rhs<4>(exec, a, b, c, out);
-        return;
-    }
-    spmv_blocked<4>(exec, a, b, c, out);
+    spmv_dispatch(a, b, c, out);
 }
 
 GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(
@@ -0,0 +1,302 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2022, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#include "core/matrix/stencil_kernels.hpp"
+
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+
+#include <omp.h>
+
+
+#include <ginkgo/core/base/math.hpp>
+#include <ginkgo/core/matrix/csr.hpp>
+#include <ginkgo/core/matrix/dense.hpp>
+
+
+namespace gko {
+namespace kernels {
+namespace omp {
+/**
+ * @brief The Stencil operator namespace.
+ * @ref Stencil
+ * @ingroup stencil
+ */
+namespace stencil {
+namespace {
+
+
+// number of consecutive grid points along the first dimension a thread
+// accumulates at once
+constexpr int64 tile_size = 256;
+
+// number of grid lines along the second dimension in a block
+constexpr int64 block_size_y = 16;
+
+
+/**
+ * Applies the stencil tile by tile: every tile is a range of up to tile_size
+ * grid points along the first dimension, for which the contribution of each
+ * stencil point is a contiguous range of the input vector, so the inner loop
+ * vectorizes. The accumulated tile is passed to `out(row, col, value)`.
+ *
+ * The grid is split into blocks of tile_size x block_size_y points along the
+ * first two dimensions, and each thread streams through a range of planes
+ * along the slowest dimension for a block. This way, the input values of a
+ * block are reused by the neighboring lines and planes while they are still
+ * in cache. The range of planes is only split further if there are not
+ * enough blocks to occupy all threads.
+ */
+template <typename ValueType, typename IndexType, typename OutClosure>
+void spmv_tiles(const matrix::Stencil<ValueType, IndexType>* a,
+                const matrix::Dense<ValueType>* b, OutClosure out)
+{
+    const auto grid = a->get_grid_size();
+    const auto nx = static_cast<int64>(grid[0]);
+    const auto ny = static_cast<int64>(grid[1]);
+    const auto nz = static_cast<int64>(grid[2]);
+    const auto num_rows = static_cast<int64>(a->get_size()[0]);
+    const auto num_points = static_cast<int64>(a->get_num_points());
+    const auto num_cols = static_cast<int64>(b->get_size()[1]);
+    const auto offsets = a->get_const_offsets();
+    const auto coeffs = a->get_const_coefficients();
+    const auto variable = a->has_variable_coefficients();
+    const auto b_vals = b->get_const_values();
+    const auto b_stride = static_cast<int64>(b->get_stride());
+    const auto num_tiles = ceildiv(nx, tile_size);
+    const auto num_y_blocks = ceildiv(ny, block_size_y);
+    const auto num_z_blocks =
+        std::min(nz, ceildiv(static_cast<int64>(omp_get_max_threads()),
+                             num_tiles * num_y_blocks));
+    const auto block_size_z = ceildiv(nz, num_z_blocks);
+#pragma omp parallel for collapse(3)
+    for (int64 z_block = 0; z_block < num_z_blocks; z_block++) {
+        for (int64 y_block = 0; y_block < num_y_blocks; y_block++) {
+            for (int64 tile = 0; tile < num_tiles; tile++) {
+                const auto z_end = std::min((z_block + 1) * block_size_z, nz);
+                const auto y_end = std::min((y_block + 1) * block_size_y, ny);
+                const auto tile_begin = tile * tile_size;
+                const auto tile_end = std::min(tile_begin + tile_size, nx);
+                ValueType sum[tile_size];
+                for (auto z = z_block * block_size_z; z < z_end; z++) {
+                    for (auto y = y_block * block_size_y; y < y_end; y++) {
+                        const auto line_row = nx * (y + ny * z);
+                        for (int64 j = 0; j < num_cols; j++) {
+                            std::fill_n(sum, tile_end - tile_begin,
+                                        zero<ValueType>());
+                            for (int64 point = 0; point < num_points;
+                                 point++) {
+                                const int64 dx = offsets[3 * point];
+                                const int64 dy = offsets[3 * point + 1];
+                                const int64 dz = offsets[3 * point + 2];
+                                if (y + dy < 0 || y + dy >= ny || z + dz < 0 ||
+                                    z + dz >= nz) {
+                                    continue;
+                                }
+                                const auto begin = std::max(tile_begin, -dx);
+                                const auto end = std::min(tile_end, nx - dx);
+                                // row of the neighbor of the first grid point
+                                // of the line, which may lie outside the grid
+                                const auto in_row =
+                                    line_row + dx + nx * (dy + ny * dz);
+                                if (variable) {
+                                    const auto point_coeffs =
+                                        coeffs + point * num_rows + line_row;
+#pragma omp simd
+                                    for (auto x = begin; x < end; x++) {
+                                        sum[x - tile_begin] +=
+                                            point_coeffs[x] *
+                                            b_vals[(in_row + x) * b_stride + j];
+                                    }
+                                } else {
+                                    const auto coeff = coeffs[point];
+#pragma omp simd
+                                    for (auto x = begin; x < end; x++) {
+                                        sum[x - tile_begin] +=
+                                            coeff *
+                                            b_vals[(in_row + x) * b_stride + j];
+                                    }
+                                }
+                            }
+                            for (auto x = tile_begin; x < tile_end; x++) {
+                                out(line_row + x, j, sum[x - tile_begin]);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+
+/**
+ * Returns the stencil points sorted by the distance of their neighbor rows,
+ * which is the order of the columns in every row of the assembled matrix.
+ */
+template <typename ValueType, typename IndexType>
+std::vector<int64> get_sorted_points(
+    const matrix::Stencil<ValueType, IndexType>* a)
+{
+    const auto grid = a->get_grid_size();
+    const auto nx = static_cast<int64>(grid[0]);
+    const auto ny = static_cast<int64>(grid[1]);
+    const auto offsets = a->get_const_offsets();
+    std::vector<int64> points(a->get_num_points());
+    std::iota(points.begin(), points.end(), int64{});
+    const auto linear_offset = [&](int64 point) {
+        return offsets[3 * point] +
+               nx * (offsets[3 * point + 1] + ny * offsets[3 * point + 2]);
+    };
+    std::stable_sort(points.begin(), points.end(), [&](int64 a, int64 b) {
+        return linear_offset(a) < linear_offset(b);
+    });
+    return points;
+}
+
+
+template <typename ValueType, typename IndexType>
+bool is_inside(const matrix::Stencil<ValueType, IndexType>* a, int64 row,
+               int64 point)
+{
+    const auto grid = a->get_grid_size();
+    const auto nx = static_cast<int64>(grid[0]);
+    const auto ny = static_cast<int64>(grid[1]);
+    const auto nz = static_cast<int64>(grid[2]);
+    const auto offsets = a->get_const_offsets() + 3 * point;
+    const auto x = row % nx + offsets[0];
+    const auto y = row / nx % ny + offsets[1];
+    const auto z = row / nx / ny + offsets[2];
+    return x >= 0 && x < nx && y >= 0 && y < ny && z >= 0 && z < nz;
+}
+
+
+}  // anonymous namespace
+
+
+template <typename ValueType, typename IndexType>
+void spmv(std::shared_ptr<const OmpExecutor> exec,
+          const matrix::Stencil<ValueType, IndexType>* a,
+          const matrix::Dense<ValueType>* b, matrix::Dense<ValueType>* c)
+{
+    spmv_tiles(a, b, [&](int64 row, int64 col, ValueType value) {
+        c->at(row, col) = value;
+    });
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(GKO_DECLARE_STENCIL_SPMV_KERNEL);
+
+
+template <typename ValueType, typename IndexType>
+void advanced_spmv(std::shared_ptr<const OmpExecutor> exec,
+                   const matrix::Dense<ValueType>* alpha,
+                   const matrix::Stencil<ValueType, IndexType>* a,
+                   const matrix::Dense<ValueType>* b,
+                   const matrix::Dense<ValueType>* beta,
+                   matrix::Dense<ValueType>* c)
+{
+    const auto valpha = alpha->at(0, 0);
+    const auto vbeta = beta->at(0, 0);
+    spmv_tiles(a, b, [&](int64 row, int64 col, ValueType value) {
+        c->at(row, col) = vbeta * c->at(row, col) + valpha * value;
+    });
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(
+    GKO_DECLARE_STENCIL_ADVANCED_SPMV_KERNEL);
+
+
+template <typename ValueType, typename IndexType>
+void count_nonzeros_per_row(std::shared_ptr<const OmpExecutor> exec,
+                            const matrix::Stencil<ValueType, IndexType>* source,
+                            IndexType* result)
+{
+    const auto num_rows = static_cast<int64>(source->get_size()[0]);
+    const auto num_points = static_cast<int64>(source->get_num_points());
+#pragma omp parallel for
+    for (int64 row = 0; row < num_rows; row++) {
+        IndexType count{};
+        for (int64 point = 0; point < num_points; point++) {
+            count += is_inside(source, row, point) ? 1 : 0;
+        }
+        result[row] = count;
+    }
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(
+    GKO_DECLARE_STENCIL_COUNT_NONZEROS_PER_ROW_KERNEL);
+
+
+template <typename ValueType, typename IndexType>
+void fill_in_csr(std::shared_ptr<const OmpExecutor> exec,
+                 const matrix::Stencil<ValueType, IndexType>* source,
+                 matrix::Csr<ValueType, IndexType>* result)
+{
+    const auto grid = source->get_grid_size();
+    const auto nx = static_cast<int64>(grid[0]);
+    const auto ny = static_cast<int64>(grid[1]);
+    const auto num_rows = static_cast<int64>(source->get_size()[0]);
+    const auto offsets = source->get_const_offsets();
+    const auto coeffs = source->get_const_coefficients();
+    const auto variable = source->has_variable_coefficients();
+    const auto row_ptrs = result->get_const_row_ptrs();
+    const auto col_idxs = result->get_col_idxs();
+    const auto vals = result->get_values();
+    const auto points = get_sorted_points(source);
+#pragma omp parallel for
+    for (int64 row = 0; row < num_rows; row++) {
+        auto out_nz = row_ptrs[row];
+        for (const auto point : points) {
+            if (!is_inside(source, row, point)) {
+                continue;
+            }
+            col_idxs[out_nz] = static_cast<IndexType>(
+                row + offsets[3 * point] +
+                nx * (offsets[3 * point + 1] + ny * offsets[3 * point + 2]));
+            vals[out_nz] =
+                variable ? coeffs[point * num_rows + row] : coeffs[point];
+            out_nz++;
+        }
+    }
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(
+    GKO_DECLARE_STENCIL_FILL_IN_CSR_KERNEL);
+
+
+}  // namespace stencil
+}  // namespace omp
+}  // namespace kernels
+}  // namespace gko
@@ -0,0 +1,332 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2022, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#include "core/matrix/symmetric_csr_kernels.hpp"
+
+
+#include <algorithm>
+
+
+#include <omp.h>
+
+
+#include <ginkgo/core/base/array.hpp>
+#include <ginkgo/core/base/exception_helpers.hpp>
+#include <ginkgo/core/base/math.hpp>
+#include <ginkgo/core/matrix/csr.hpp>
+#include <ginkgo/core/matrix/dense.hpp>
+
+
+#include "core/base/allocator.hpp"
+#include "core/components/prefix_sum_kernels.hpp"
+#include "core/matrix/csr_builder.hpp"
+#include "omp/components/csr_transpose.hpp"
+
+
+namespace gko {
+namespace kernels {
+namespace omp {
+/**
+ * @brief The symmetric CSR matrix format namespace.
+ * @ref SymmetricCsr
+ * @ingroup symmetric_csr
+ */
+namespace symmetric_csr {
+namespace {
+
+
+/**
+ * Computes y = A * b for the stored upper triangle and its transpose.
+ *
+ * The rows are split into one contiguous range per thread with similar
+ * numbers of nonzeros. A thread accumulates all contributions to the rows of
+ * its own range directly in y. The transposed contributions to rows after its
+ * range go to a thread-private buffer that covers the rows up to the largest
+ * column index of the range, so for banded matrices the buffers stay small.
+ * The buffers are summed up afterwards, so no atomic operations are needed.
+ */
+template <typename ValueType, typename IndexType>
+void symmetric_spmv(std::shared_ptr<const OmpExecutor> exec,
+                    const matrix::SymmetricCsr<ValueType, IndexType>* a,
+                    const matrix::Dense<ValueType>* b,
+                    matrix::Dense<ValueType>* y)
+{
+    const auto row_ptrs = a->get_const_row_ptrs();
+    const auto col_idxs = a->get_const_col_idxs();
+    const auto vals = a->get_const_values();
+    const auto hermitian = a->is_hermitian();
+    const auto num_rows = a->get_size()[0];
+    const auto num_rhs = y->get_size()[1];
+    const auto nnz = static_cast<size_type>(row_ptrs[num_rows]);
+    const auto num_threads = static_cast<size_type>(omp_get_max_threads());
+    vector<size_type> range_begins(num_threads + 1, {}, exec);
+    for (size_type tid = 0; tid < num_threads; tid++) {
+        const auto target = static_cast<IndexType>(nnz * tid / num_threads);
+        range_begins[tid] =
+            std::lower_bound(row_ptrs, row_ptrs + num_rows, target) -
+            row_ptrs;
+    }
+    range_begins[num_threads] = num_rows;
+    vector<size_type> buffer_ends(num_threads, {}, exec);
+#pragma omp parallel for
+    for (size_type tid = 0; tid < num_threads; tid++) {
+        auto buffer_end = range_begins[tid + 1];
+        for (auto row = range_begins[tid]; row < range_begins[tid + 1];
+             row++) {
+            for (auto nz = row_ptrs[row]; nz < row_ptrs[row + 1]; nz++) {
+                buffer_end = std::max(
+                    buffer_end, static_cast<size_type>(col_idxs[nz]) + 1);
+            }
+        }
+        buffer_ends[tid] = buffer_end;
+    }
+    vector<size_type> buffer_offsets(num_threads + 1, {}, exec);
+    for (size_type tid = 0; tid < num_threads; tid++) {
+        buffer_offsets[tid + 1] =
+            buffer_offsets[tid] +
+            (buffer_ends[tid] - range_begins[tid + 1]) * num_rhs;
+    }
+    vector<ValueType> buffer(buffer_offsets[num_threads], zero<ValueType>(),
+                             exec);
+#pragma omp parallel for
+    for (size_type tid = 0; tid < num_threads; tid++) {
+        const auto begin = range_begins[tid];
+        const auto end = range_begins[tid + 1];
+        const auto local_buffer = buffer.data() + buffer_offsets[tid];
+        for (auto row = begin; row < end; row++) {
+            for (size_type j = 0; j < num_rhs; j++) {
+                y->at(row, j) = zero<ValueType>();
+            }
+        }
+        for (auto row = begin; row < end; row++) {
+            for (auto nz = row_ptrs[row]; nz < row_ptrs[row + 1]; nz++) {
+                const auto col = static_cast<size_type>(col_idxs[nz]);
+                const auto val = vals[nz];
+                for (size_type j = 0; j < num_rhs; j++) {
+                    y->at(row, j) += val * b->at(col, j);
+                }
+                if (col == row) {
+                    continue;
+                }
+                const auto trans_val = hermitian ? conj(val) : val;
+                if (col < end) {
+                    for (size_type j = 0; j < num_rhs; j++) {
+                        y->at(col, j) += trans_val * b->at(row, j);
+                    }
+                } else {
+                    const auto out = local_buffer + (col - end) * num_rhs;
+                    for (size_type j = 0; j < num_rhs; j++) {
+                        out[j] += trans_val * b->at(row, j);
+                    }
+                }
+            }
+        }
+    }
+#pragma omp parallel for
+    for (size_type row = 0; row < num_rows; row++) {
+        for (size_type tid = 0; tid < num_threads; tid++) {
+            const auto buffer_begin = range_begins[tid + 1];
+            if (row >= buffer_begin && row < buffer_ends[tid]) {
+                const auto in = buffer.data() + buffer_offsets[tid] +
+                                (row - buffer_begin) * num_rhs;
+                for (size_type j = 0; j < num_rhs; j++) {
+                    y->at(row, j) += in[j];
+                }
+            }
+        }
+    }
+}
+
+
+}  // anonymous namespace
+
+
+template <typename ValueType, typename IndexType>
+void spmv(std::shared_ptr<const OmpExecutor> exec,
+          const matrix::SymmetricCsr<ValueType, IndexType>* a,
+          const matrix::Dense<ValueType>* b, matrix::Dense<ValueType>* c)
+{
+    symmetric_spmv(exec, a, b, c);
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(
+    GKO_DECLARE_SYMMETRIC_CSR_SPMV_KERNEL);
+
+
+template <typename ValueType, typename IndexType>
+void advanced_spmv(std::shared_ptr<const OmpExecutor> exec,
+                   const matrix::Dense<ValueType>* alpha,
+                   const matrix::SymmetricCsr<ValueType, IndexType>* a,
+                   const matrix::Dense<ValueType>* b,
+                   const matrix::Dense<ValueType>* beta,
+                   matrix::Dense<ValueType>* c)
+{
+    auto product = matrix::Dense<ValueType>::create(exec, c->get_size());
+    symmetric_spmv(exec, a, b, product.get());
+    const auto valpha = alpha->at(0, 0);
+    const auto vbeta = beta->at(0, 0);
+#pragma omp parallel for
+    for (size_type row = 0; row < c->get_size()[0]; row++) {
+        for (size_type j = 0; j < c->get_size()[1]; j++) {
+            c->at(row, j) =
+                valpha * product->at(row, j) + vbeta * c->at(row, j);
+        }
+    }
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(
+    GKO_DECLARE_SYMMETRIC_CSR_ADVANCED_SPMV_KERNEL);
+
+
+template <typename ValueType, typename IndexType>
+void count_upper_nonzeros_per_row(
+    std::shared_ptr<const OmpExecutor> exec,
+    const matrix::Csr<ValueType, IndexType>* source, IndexType* result)
+{
+    const auto row_ptrs = source->get_const_row_ptrs();
+    const auto col_idxs = source->get_const_col_idxs();
+#pragma omp parallel for
+    for (size_type row = 0; row < source->get_size()[0]; row++) {
+        IndexType count{};
+        for (auto nz = row_ptrs[row]; nz < row_ptrs[row + 1]; nz++) {
+            if (static_cast<size_type>(col_idxs[nz]) >= row) {
+                count++;
+            }
+        }
+        result[row] = count;
+    }
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(
+    GKO_DECLARE_SYMMETRIC_CSR_COUNT_UPPER_NONZEROS_PER_ROW_KERNEL);
+
+
+template <typename ValueType, typename IndexType>
+void extract_upper(std::shared_ptr<const OmpExecutor> exec,
+                   const matrix::Csr<ValueType, IndexType>* source,
+                   matrix::SymmetricCsr<ValueType, IndexType>* result)
+{
+    const auto in_row_ptrs = source->get_const_row_ptrs();
+    const auto in_col_idxs = source->get_const_col_idxs();
+    const auto in_vals = source->get_const_values();
+    const auto out_row_ptrs = result->get_const_row_ptrs();
+    const auto out_col_idxs = result->get_col_idxs();
+    const auto out_vals = result->get_values();
+#pragma omp parallel for
+    for (size_type row = 0; row < source->get_size()[0]; row++) {
+        auto out_nz = out_row_ptrs[row];
+        for (auto nz = in_row_ptrs[row]; nz < in_row_ptrs[row + 1]; nz++) {
+            if (static_cast<size_type>(in_col_idxs[nz]) >= row) {
+                out_col_idxs[out_nz] = in_col_idxs[nz];
+                out_vals[out_nz] = in_vals[nz];
+                out_nz++;
+            }
+        }
+    }
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(
+    GKO_DECLARE_SYMMETRIC_CSR_EXTRACT_UPPER_KERNEL);
+
+
+template <typename ValueType, typename IndexType>
+void convert_to_csr(std::shared_ptr<const OmpExecutor> exec,
+                    const matrix::SymmetricCsr<ValueType, IndexType>* source,
+                    matrix::Csr<ValueType, IndexType>* result)
+{
+    const auto num_rows = source->get_size()[0];
+    const auto in_row_ptrs = source->get_const_row_ptrs();
+    const auto in_col_idxs = source->get_const_col_idxs();
+    const auto in_vals = source->get_const_values();
+    const auto hermitian = source->is_hermitian();
+    const auto in_nnz = source->get_num_stored_elements();
+    // the lower triangle is the (conjugate) transpose of the upper triangle,
+    // the transposed diagonal entries are skipped below
+    array<IndexType> lower_row_ptrs{exec, num_rows + 1};
+    array<IndexType> lower_col_idxs{exec, in_nnz};
+    array<ValueType> lower_vals{exec, in_nnz};
+    const auto lower_ptrs = lower_row_ptrs.get_data();
+    const auto lower_cols = lower_col_idxs.get_data();
+    const auto lower_vals_ptr = lower_vals.get_data();
+    abstract_transpose(exec, num_rows, num_rows, in_row_ptrs, in_col_idxs,
+                       lower_ptrs, lower_cols,
+                       [&](IndexType in_nz, IndexType out_nz) {
+                           lower_vals_ptr[out_nz] =
+                               hermitian ? conj(in_vals[in_nz])
+                                         : in_vals[in_nz];
+                       });
+    const auto out_row_ptrs = result->get_row_ptrs();
+#pragma omp parallel for
+    for (size_type row = 0; row < num_rows; row++) {
+        auto count = in_row_ptrs[row + 1] - in_row_ptrs[row];
+        for (auto nz = lower_ptrs[row]; nz < lower_ptrs[row + 1]; nz++) {
+            if (static_cast<size_type>(lower_cols[nz]) != row) {
+                count++;
+            }
+        }
+        out_row_ptrs[row] = count;
+    }
+    components::prefix_sum(exec, out_row_ptrs, num_rows + 1);
+    const auto nnz = static_cast<size_type>(out_row_ptrs[num_rows]);
+    matrix::CsrBuilder<ValueType, IndexType> builder{result};
+    builder.get_col_idx_array().resize_and_reset(nnz);
+    builder.get_value_array().resize_and_reset(nnz);
+    const auto out_col_idxs = result->get_col_idxs();
+    const auto out_vals = result->get_values();
+    // the strictly lower entries precede the upper entries of each row, so
+    // sorted upper rows result in sorted output rows
+#pragma omp parallel for
+    for (size_type row = 0; row < num_rows; row++) {
+        auto out_nz = out_row_ptrs[row];
+        for (auto nz = lower_ptrs[row]; nz < lower_ptrs[row + 1]; nz++) {
+            if (static_cast<size_type>(lower_cols[nz]) != row) {
+                out_col_idxs[out_nz] = lower_cols[nz];
+                out_vals[out_nz] = lower_vals_ptr[nz];
+                out_nz++;
+            }
+        }
+        for (auto nz = in_row_ptrs[row]; nz < in_row_ptrs[row + 1]; nz++) {
+            out_col_idxs[out_nz] = in_col_idxs[nz];
+            out_vals[out_nz] = in_vals[nz];
+            out_nz++;
+        }
+    }
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(
+    GKO_DECLARE_SYMMETRIC_CSR_CONVERT_TO_CSR_KERNEL);
+
+
+}  // namespace symmetric_csr
+}  // namespace omp
+}  // namespace kernels
+}  // namespace gko
@@ -0,0 +1,129 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2022, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+
+#include "core/preconditioner/spai_kernels.hpp"
+
+
+#include <vector>
+
+
+#include <omp.h>
+
+
+#include <ginkgo/core/base/math.hpp>
+#include <ginkgo/core/base/types.hpp>
+#include <ginkgo/core/matrix/csr.hpp>
+#include <ginkgo/core/matrix/ell.hpp>
+
+
+#include "core/preconditioner/spai_utils.hpp"
+
+
+namespace gko {
+namespace kernels {
+namespace omp {
+/**
+ * @brief The SPAI preconditioner namespace.
+ *
+ * @ingroup spai
+ */
+namespace spai {
+
+
+template <typename ValueType, typename IndexType>
+void generate_general(std::shared_ptr<const OmpExecutor> exec,
+                      const matrix::Csr<ValueType, IndexType>* mtx,
+                      const matrix::Csr<ValueType, IndexType>* trans,
+                      int num_steps, size_type entries_per_step,
+                      remove_complex<ValueType> tolerance,
+                      matrix::Ell<ValueType, IndexType>* inverse)
+{
+    const auto num_rows = static_cast<IndexType>(mtx->get_size()[0]);
+#pragma omp parallel
+    {
+        // the rows are independent, but their cost varies with the size of
+        // the local least-squares problems
+        preconditioner::spai::row_workspace<ValueType, IndexType> ws(num_rows);
+#pragma omp for schedule(dynamic, 16)
+        for (IndexType row = 0; row < num_rows; ++row) {
+            preconditioner::spai::generate_general_row(
+                row, mtx, trans, num_steps, entries_per_step, tolerance, ws,
+                inverse);
+        }
+    }
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(
+    GKO_DECLARE_SPAI_GENERATE_GENERAL_KERNEL);
+
+
+template <typename ValueType, typename IndexType>
+void generate_spd(std::shared_ptr<const OmpExecutor> exec,
+                  const matrix::Csr<ValueType, IndexType>* mtx, int num_steps,
+                  size_type entries_per_step,
+                  remove_complex<ValueType> tolerance,
+                  matrix::Ell<ValueType, IndexType>* factor)
+{
+    const auto num_rows = static_cast<IndexType>(mtx->get_size()[0]);
+    const auto row_ptrs = mtx->get_const_row_ptrs();
+    const auto col_idxs = mtx->get_const_col_idxs();
+    const auto vals = mtx->get_const_values();
+    std::vector<ValueType> diag(num_rows, zero<ValueType>());
+#pragma omp parallel for
+    for (IndexType row = 0; row < num_rows; ++row) {
+        for (auto nz = row_ptrs[row]; nz < row_ptrs[row + 1]; ++nz) {
+            if (col_idxs[nz] == row) {
+                diag[row] = vals[nz];
+            }
+        }
+    }
+#pragma omp parallel
+    {
+        preconditioner::spai::row_workspace<ValueType, IndexType> ws(num_rows);
+#pragma omp for schedule(dynamic, 16)
+        for (IndexType row = 0; row < num_rows; ++row) {
+            preconditioner::spai::generate_spd_row(row, mtx, diag.data(),
+                                                   num_steps, entries_per_step,
+                                                   tolerance, ws, factor);
+        }
+    }
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(
+    GKO_DECLARE_SPAI_GENERATE_SPD_KERNEL);
+
+
+}  // namespace spai
+}  // namespace omp
+}  // namespace kernels
+}  // namespace gko
@@ -0,0 +1,217 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2022, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#include "core/factorization/block_ilu_kernels.hpp"
+
+
+#include <algorithm>
+
+
+#include <ginkgo/core/base/math.hpp>
+
+
+#include "core/base/allocator.hpp"
+#include "core/components/dense_block.hpp"
+
+
+namespace gko {
+namespace kernels {
+namespace reference {
+/**
+ * @brief The block ilu factorization namespace.
+ *
+ * @ingroup factor
+ */
+namespace block_ilu_factorization {
+
+
+template <typename ValueType, typename IndexType>
+void initialize_row_ptrs_l_u(
+    std::shared_ptr<const DefaultExecutor> exec,
+    const matrix::Fbcsr<ValueType, IndexType>* system_matrix,
+    IndexType* l_row_ptrs, IndexType* u_row_ptrs)
+{
+    const auto num_block_rows = system_matrix->get_num_block_rows();
+    const auto row_ptrs = system_matrix->get_const_row_ptrs();
+    const auto col_idxs = system_matrix->get_const_col_idxs();
+
+    l_row_ptrs[0] = 0;
+    u_row_ptrs[0] = 0;
+    for (IndexType row = 0; row < num_block_rows; ++row) {
+        IndexType l_nnz{};
+        IndexType u_nnz{};
+        for (auto nz = row_ptrs[row]; nz < row_ptrs[row + 1]; ++nz) {
+            const auto col = col_idxs[nz];
+            // don't count diagonal
+            l_nnz += col < row;
+            u_nnz += col > row;
+        }
+        // add diagonal again
+        l_row_ptrs[row + 1] = l_row_ptrs[row] + l_nnz + 1;
+        u_row_ptrs[row + 1] = u_row_ptrs[row] + u_nnz + 1;
+    }
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(
+    GKO_DECLARE_BLOCK_ILU_INITIALIZE_ROW_PTRS_L_U_KERNEL);
+
+
+template <typename ValueType, typename IndexType>
+void initialize_l_u(std::shared_ptr<const DefaultExecutor> exec,
+                    const matrix::Fbcsr<ValueType, IndexType>* system_matrix,
+                    matrix::Fbcsr<ValueType, IndexType>* l_factor,
+                    matrix::Fbcsr<ValueType, IndexType>* u_factor)
+{
+    const auto num_block_rows = system_matrix->get_num_block_rows();
+    const auto bs = system_matrix->get_block_size();
+    const auto block_nnz = bs * bs;
+    const auto row_ptrs = system_matrix->get_const_row_ptrs();
+    const auto col_idxs = system_matrix->get_const_col_idxs();
+    const auto vals = system_matrix->get_const_values();
+    const auto l_row_ptrs = l_factor->get_const_row_ptrs();
+    const auto l_col_idxs = l_factor->get_col_idxs();
+    const auto l_vals = l_factor->get_values();
+    const auto u_row_ptrs = u_factor->get_const_row_ptrs();
+    const auto u_col_idxs = u_factor->get_col_idxs();
+    const auto u_vals = u_factor->get_values();
+
+    for (IndexType row = 0; row < num_block_rows; ++row) {
+        auto l_nz = l_row_ptrs[row];
+        // the diagonal block is the first block of each row of U
+        const auto u_diag = u_row_ptrs[row];
+        auto u_nz = u_diag + 1;
+        u_col_idxs[u_diag] = row;
+        std::fill_n(u_vals + u_diag * block_nnz, block_nnz, zero<ValueType>());
+        for (auto nz = row_ptrs[row]; nz < row_ptrs[row + 1]; ++nz) {
+            const auto col = col_idxs[nz];
+            const auto block = vals + nz * block_nnz;
+            if (col < row) {
+                l_col_idxs[l_nz] = col;
+                std::copy_n(block, block_nnz, l_vals + l_nz * block_nnz);
+                ++l_nz;
+            } else if (col == row) {
+                std::copy_n(block, block_nnz, u_vals + u_diag * block_nnz);
+            } else {
+                u_col_idxs[u_nz] = col;
+                std::copy_n(block, block_nnz, u_vals + u_nz * block_nnz);
+                ++u_nz;
+            }
+        }
+        // the identity diagonal block is the last block of each row of L
+        l_col_idxs[l_nz] = row;
+        const auto l_diag = l_vals + l_nz * block_nnz;
+        for (int j = 0; j < bs; ++j) {
+            for (int i = 0; i < bs; ++i) {
+                l_diag[i + j * bs] =
+                    i == j ? one<ValueType>() : zero<ValueType>();
+            }
+        }
+    }
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(
+    GKO_DECLARE_BLOCK_ILU_INITIALIZE_L_U_KERNEL);
+
+
+template <typename ValueType, typename IndexType>
+void compute_lu(std::shared_ptr<const DefaultExecutor> exec,
+                matrix::Fbcsr<ValueType, IndexType>* l_factor,
+                matrix::Fbcsr<ValueType, IndexType>* u_factor)
+{
+    const auto num_block_rows = l_factor->get_num_block_rows();
+    const auto bs = l_factor->get_block_size();
+    const auto block_nnz = bs * bs;
+    const auto l_row_ptrs = l_factor->get_const_row_ptrs();
+    const auto l_col_idxs = l_factor->get_const_col_idxs();
+    const auto l_vals = l_factor->get_values();
+    const auto u_row_ptrs = u_factor->get_const_row_ptrs();
+    const auto u_col_idxs = u_factor->get_const_col_idxs();
+    const auto u_vals = u_factor->get_values();
+    // inverses of the already factorized diagonal blocks of U
+    vector<ValueType> diag_inv(num_block_rows * block_nnz, {}, exec);
+    vector<ValueType> work(block_nnz, {}, exec);
+
+    for (IndexType row = 0; row < num_block_rows; ++row) {
+        const auto u_begin = u_row_ptrs[row];
+        const auto u_end = u_row_ptrs[row + 1];
+        // skip the identity diagonal block, which is the last block of L
+        for (auto l_nz = l_row_ptrs[row]; l_nz < l_row_ptrs[row + 1] - 1;
+             ++l_nz) {
+            const auto k = l_col_idxs[l_nz];
+            // L(row, k) = A(row, k) * U(k, k)^-1
+            const auto l_block = l_vals + l_nz * block_nnz;
+            std::copy_n(l_block, block_nnz, work.begin());
+            dense_block::multiply(bs, work.data(),
+                                  diag_inv.data() + k * block_nnz, l_block);
+            // A(row, col) -= L(row, k) * U(k, col) on the pattern of A
+            auto l_search = l_nz + 1;
+            auto u_search = u_begin;
+            for (auto u_nz = u_row_ptrs[k] + 1; u_nz < u_row_ptrs[k + 1];
+                 ++u_nz) {
+                const auto col = u_col_idxs[u_nz];
+                const auto u_block = u_vals + u_nz * block_nnz;
+                if (col < row) {
+                    // the diagonal block of L bounds the search
+                    while (l_col_idxs[l_search] < col) {
+                        ++l_search;
+                    }
+                    if (l_col_idxs[l_search] == col) {
+                        dense_block::multiply_sub(
+                            bs, l_block, u_block,
+                            l_vals + l_search * block_nnz);
+                    }
+                } else {
+                    while (u_search < u_end && u_col_idxs[u_search] < col) {
+                        ++u_search;
+                    }
+                    if (u_search < u_end && u_col_idxs[u_search] == col) {
+                        dense_block::multiply_sub(
+                            bs, l_block, u_block,
+                            u_vals + u_search * block_nnz);
+                    }
+                }
+            }
+        }
+        std::copy_n(u_vals + u_begin * block_nnz, block_nnz, work.begin());
+        dense_block::invert(bs, work.data(),
+                            diag_inv.data() + row * block_nnz);
+    }
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(
+    GKO_DECLARE_BLOCK_ILU_COMPUTE_LU_KERNEL);
+
+
+}  // namespace block_ilu_factorization
+}  // namespace reference
+}  // namespace kernels
+}  // namespace gko
@@ -0,0 +1,287 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2022, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#include "core/matrix/block_ell_kernels.hpp"
+
+
+#include <algorithm>
+#include <vector>
+
+
+#include <ginkgo/core/base/math.hpp>
+#include <ginkgo/core/matrix/csr.hpp>
+#include <ginkgo/core/matrix/dense.hpp>
+
+
+namespace gko {
+namespace kernels {
+namespace reference {
+/**
+ * @brief The blocked ELL matrix format namespace.
+ * @ref BlockEll
+ * @ingroup block_ell
+ */
+namespace block_ell {
+
+
+template <typename ValueType, typename IndexType>
+void spmv(std::shared_ptr<const ReferenceExecutor> exec,
+          const matrix::BlockEll<ValueType, IndexType>* a,
+          const matrix::Dense<ValueType>* b, matrix::Dense<ValueType>* c)
+{
+    const auto bs = static_cast<size_type>(a->get_block_size());
+    const auto num_block_rows = a->get_num_block_rows();
+    const auto col_idxs = a->get_const_col_idxs();
+    const auto vals = a->get_const_values();
+    for (size_type row = 0; row < c->get_size()[0]; row++) {
+        for (size_type j = 0; j < c->get_size()[1]; j++) {
+            c->at(row, j) = zero<ValueType>();
+        }
+    }
+    for (size_type block_row = 0; block_row < num_block_rows; block_row++) {
+        for (size_type k = 0; k < a->get_num_stored_blocks_per_row(); k++) {
+            const auto block = k * num_block_rows + block_row;
+            const auto block_col = col_idxs[block];
+            if (block_col == invalid_index<IndexType>()) {
+                continue;
+            }
+            for (size_type local_row = 0; local_row < bs; local_row++) {
+                for (size_type local_col = 0; local_col < bs; local_col++) {
+                    const auto val =
+                        vals[(block * bs + local_row) * bs + local_col];
+                    const auto row = block_row * bs + local_row;
+                    const auto col = block_col * bs + local_col;
+                    for (size_type j = 0; j < c->get_size()[1]; j++) {
+                        c->at(row, j) += val * b->at(col, j);
+                    }
+                }
+            }
+        }
+    }
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(
+    GKO_DECLARE_BLOCK_ELL_SPMV_KERNEL);
+
+
+template <typename ValueType, typename IndexType>
+void advanced_spmv(std::shared_ptr<const ReferenceExecutor> exec,
+                   const matrix::Dense<ValueType>* alpha,
+                   const matrix::BlockEll<ValueType, IndexType>* a,
+                   const matrix::Dense<ValueType>* b,
+                   const matrix::Dense<ValueType>* beta,
+                   matrix::Dense<ValueType>* c)
+{
+    const auto bs = static_cast<size_type>(a->get_block_size());
+    const auto num_block_rows = a->get_num_block_rows();
+    const auto col_idxs = a->get_const_col_idxs();
+    const auto vals = a->get_const_values();
+    const auto valpha = alpha->at(0, 0);
+    const auto vbeta = beta->at(0, 0);
+    for (size_type row = 0; row < c->get_size()[0]; row++) {
+        for (size_type j = 0; j < c->get_size()[1]; j++) {
+            c->at(row, j) *= vbeta;
+        }
+    }
+    for (size_type block_row = 0; block_row < num_block_rows; block_row++) {
+        for (size_type k = 0; k < a->get_num_stored_blocks_per_row(); k++) {
+            const auto block = k * num_block_rows + block_row;
+            const auto block_col = col_idxs[block];
+            if (block_col == invalid_index<IndexType>()) {
+                continue;
+            }
+            for (size_type local_row = 0; local_row < bs; local_row++) {
+                for (size_type local_col = 0; local_col < bs; local_col++) {
+                    const auto val =
+                        valpha *
+                        vals[(block * bs + local_row) * bs + local_col];
+                    const auto row = block_row * bs + local_row;
+                    const auto col = block_col * bs + local_col;
+                    for (size_type j = 0; j < c->get_size()[1]; j++) {
+                        c->at(row, j) += val * b->at(col, j);
+                    }
+                }
+            }
+        }
+    }
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(
+    GKO_DECLARE_BLOCK_ELL_ADVANCED_SPMV_KERNEL);
+
+
+template <typename ValueType, typename IndexType>
+void compute_max_blocks_per_row(
+    std::shared_ptr<const ReferenceExecutor> exec,
+    const matrix::Csr<ValueType, IndexType>* source, int block_size,
+    size_type& result)
+{
+    const auto row_ptrs = source->get_const_row_ptrs();
+    const auto col_idxs = source->get_const_col_idxs();
+    const auto num_block_rows = source->get_size()[0] / block_size;
+    std::vector<IndexType> block_cols;
+    result = 0;
+    for (size_type block_row = 0; block_row < num_block_rows; block_row++) {
+        block_cols.clear();
+        for (auto nz = row_ptrs[block_row * block_size];
+             nz < row_ptrs[(block_row + 1) * block_size]; nz++) {
+            block_cols.push_back(col_idxs[nz] / block_size);
+        }
+        std::sort(block_cols.begin(), block_cols.end());
+        const auto num_blocks = static_cast<size_type>(
+            std::unique(block_cols.begin(), block_cols.end()) -
+            block_cols.begin());
+        result = std::max(result, num_blocks);
+    }
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(
+    GKO_DECLARE_BLOCK_ELL_COMPUTE_MAX_BLOCKS_PER_ROW_KERNEL);
+
+
+template <typename ValueType, typename IndexType>
+void fill_in_from_csr(std::shared_ptr<const ReferenceExecutor> exec,
+                      const matrix::Csr<ValueType, IndexType>* source,
+                      matrix::BlockEll<ValueType, IndexType>* result)
+{
+    const auto bs = result->get_block_size();
+    const auto num_block_rows = result->get_num_block_rows();
+    const auto num_stored = result->get_num_stored_blocks_per_row();
+    const auto row_ptrs = source->get_const_row_ptrs();
+    const auto in_cols = source->get_const_col_idxs();
+    const auto in_vals = source->get_const_values();
+    const auto col_idxs = result->get_col_idxs();
+    const auto vals = result->get_values();
+    std::fill_n(col_idxs, num_block_rows * num_stored,
+                invalid_index<IndexType>());
+    std::fill_n(vals, result->get_num_stored_elements(), zero<ValueType>());
+    std::vector<IndexType> block_cols;
+    for (size_type block_row = 0; block_row < num_block_rows; block_row++) {
+        const auto begin = row_ptrs[block_row * bs];
+        const auto end = row_ptrs[(block_row + 1) * bs];
+        block_cols.clear();
+        for (auto nz = begin; nz < end; nz++) {
+            block_cols.push_back(in_cols[nz] / bs);
+        }
+        std::sort(block_cols.begin(), block_cols.end());
+        block_cols.erase(std::unique(block_cols.begin(), block_cols.end()),
+                         block_cols.end());
+        for (size_type k = 0; k < block_cols.size(); k++) {
+            col_idxs[k * num_block_rows + block_row] = block_cols[k];
+        }
+        for (int local_row = 0; local_row < bs; local_row++) {
+            const auto row = block_row * bs + local_row;
+            for (auto nz = row_ptrs[row]; nz < row_ptrs[row + 1]; nz++) {
+                const auto k = std::lower_bound(block_cols.begin(),
+                                                block_cols.end(),
+                                                in_cols[nz] / bs) -
+                               block_cols.begin();
+                const auto block = k * num_block_rows + block_row;
+                vals[(block * bs + local_row) * bs + in_cols[nz] % bs] =
+                    in_vals[nz];
+            }
+        }
+    }
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(
+    GKO_DECLARE_BLOCK_ELL_FILL_IN_FROM_CSR_KERNEL);
+
+
+template <typename ValueType, typename IndexType>
+void count_nonzeros_per_row(
+    std::shared_ptr<const ReferenceExecutor> exec,
+    const matrix::BlockEll<ValueType, IndexType>* source, IndexType* result)
+{
+    const auto bs = source->get_block_size();
+    const auto num_block_rows = source->get_num_block_rows();
+    const auto col_idxs = source->get_const_col_idxs();
+    for (size_type block_row = 0; block_row < num_block_rows; block_row++) {
+        IndexType num_blocks{};
+        for (size_type k = 0; k < source->get_num_stored_blocks_per_row();
+             k++) {
+            if (col_idxs[k * num_block_rows + block_row] !=
+                invalid_index<IndexType>()) {
+                num_blocks++;
+            }
+        }
+        for (int local_row = 0; local_row < bs; local_row++) {
+            result[block_row * bs + local_row] = num_blocks * bs;
+        }
+    }
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(
+    GKO_DECLARE_BLOCK_ELL_COUNT_NONZEROS_PER_ROW_KERNEL);
+
+
+template <typename ValueType, typename IndexType>
+void convert_to_csr(std::shared_ptr<const ReferenceExecutor> exec,
+                    const matrix::BlockEll<ValueType, IndexType>* source,
+                    matrix::Csr<ValueType, IndexType>* result)
+{
+    const auto bs = source->get_block_size();
+    const auto num_block_rows = source->get_num_block_rows();
+    const auto col_idxs = source->get_const_col_idxs();
+    const auto vals = source->get_const_values();
+    const auto row_ptrs = result->get_const_row_ptrs();
+    const auto out_cols = result->get_col_idxs();
+    const auto out_vals = result->get_values();
+    for (size_type block_row = 0; block_row < num_block_rows; block_row++) {
+        for (int local_row = 0; local_row < bs; local_row++) {
+            auto out_nz = row_ptrs[block_row * bs + local_row];
+            for (size_type k = 0; k < source->get_num_stored_blocks_per_row();
+                 k++) {
+                const auto block = k * num_block_rows + block_row;
+                const auto block_col = col_idxs[block];
+                if (block_col == invalid_index<IndexType>()) {
+                    continue;
+                }
+                for (int local_col = 0; local_col < bs; local_col++) {
+                    out_cols[out_nz] = block_col * bs + local_col;
+                    out_vals[out_nz] =
+                        vals[(block * bs + local_row) * bs + local_col];
+                    out_nz++;
+                }
+            }
+        }
+    }
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(
+    GKO_DECLARE_BLOCK_ELL_CONVERT_TO_CSR_KERNEL);
+
+
+}  // namespace block_ell
+}  // namespace reference
+}  // namespace kernels
+}  // namespace gko
@@ -0,0 +1,298 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2022, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#include "core/matrix/compressed_csr_kernels.hpp"
+
+
+#include <algorithm>
+#include <cstring>
+
+
+#include <ginkgo/core/base/exception_helpers.hpp>
+#include <ginkgo/core/base/math.hpp>
+#include <ginkgo/core/matrix/csr.hpp>
+#include <ginkgo/core/matrix/dense.hpp>
+
+
+namespace gko {
+namespace kernels {
+namespace reference {
+/**
+ * @brief The compressed CSR matrix format namespace.
+ * @ref CompressedCsr
+ * @ingroup compressed_csr
+ */
+namespace compressed_csr {
+namespace {
+
+
+uint8 get_delta_width(uint64 span)
+{
+    if (span <= 0xffu) {
+        return 1;
+    } else if (span <= 0xffffu) {
+        return 2;
+    } else if (span <= 0xffffffffu) {
+        return 4;
+    }
+    return 8;
+}
+
+
+// the deltas are packed into the bytes of the 64 bit words, so they are
+// accessed through std::memcpy to avoid violating strict aliasing
+template <typename DeltaType>
+DeltaType load_delta(const uint64* row_words, size_type k)
+{
+    DeltaType delta;
+    std::memcpy(&delta,
+                reinterpret_cast<const unsigned char*>(row_words) +
+                    k * sizeof(DeltaType),
+                sizeof(DeltaType));
+    return delta;
+}
+
+
+template <typename DeltaType>
+void store_delta(uint64* row_words, size_type k, DeltaType delta)
+{
+    std::memcpy(
+        reinterpret_cast<unsigned char*>(row_words) + k * sizeof(DeltaType),
+        &delta, sizeof(DeltaType));
+}
+
+
+template <typename IndexType>
+IndexType decode_col(const uint64* row_words, uint8 width, IndexType base,
+                     IndexType k)
+{
+    switch (width) {
+    case 1:
+        return base + static_cast<IndexType>(load_delta<uint8>(row_words, k));
+    case 2:
+        return base + static_cast<IndexType>(load_delta<uint16>(row_words, k));
+    case 4:
+        return base + static_cast<IndexType>(load_delta<uint32>(row_words, k));
+    default:
+        return base + static_cast<IndexType>(row_words[k]);
+    }
+}
+
+
+template <typename IndexType>
+void encode_delta(uint64* row_words, uint8 width, IndexType k, uint64 delta)
+{
+    switch (width) {
+    case 1:
+        store_delta(row_words, k, static_cast<uint8>(delta));
+        break;
+    case 2:
+        store_delta(row_words, k, static_cast<uint16>(delta));
+        break;
+    case 4:
+        store_delta(row_words, k, static_cast<uint32>(delta));
+        break;
+    default:
+        row_words[k] = delta;
+    }
+}
+
+
+}  // anonymous namespace
+
+
+template <typename ValueType, typename IndexType>
+void spmv(std::shared_ptr<const ReferenceExecutor> exec,
+          const matrix::CompressedCsr<ValueType, IndexType>* a,
+          const matrix::Dense<ValueType>* b, matrix::Dense<ValueType>* c)
+{
+    const auto row_ptrs = a->get_const_row_ptrs();
+    const auto bases = a->get_const_col_bases();
+    const auto widths = a->get_const_col_widths();
+    const auto offsets = a->get_const_col_offsets();
+    const auto deltas = a->get_const_col_deltas();
+    const auto vals = a->get_const_values();
+    for (size_type row = 0; row < a->get_size()[0]; row++) {
+        const auto begin = row_ptrs[row];
+        const auto row_words = deltas + offsets[row];
+        for (size_type j = 0; j < c->get_size()[1]; j++) {
+            c->at(row, j) = zero<ValueType>();
+        }
+        for (auto nz = begin; nz < row_ptrs[row + 1]; nz++) {
+            const auto col =
+                decode_col(row_words, widths[row], bases[row], nz - begin);
+            const auto val = vals[nz];
+            for (size_type j = 0; j < c->get_size()[1]; j++) {
+                c->at(row, j) += val * b->at(col, j);
+            }
+        }
+    }
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(
+    GKO_DECLARE_COMPRESSED_CSR_SPMV_KERNEL);
+
+
+template <typename ValueType, typename IndexType>
+void advanced_spmv(std::shared_ptr<const ReferenceExecutor> exec,
+                   const matrix::Dense<ValueType>* alpha,
+                   const matrix::CompressedCsr<ValueType, IndexType>* a,
+                   const matrix::Dense<ValueType>* b,
+                   const matrix::Dense<ValueType>* beta,
+                   matrix::Dense<ValueType>* c)
+{
+    const auto row_ptrs = a->get_const_row_ptrs();
+    const auto bases = a->get_const_col_bases();
+    const auto widths = a->get_const_col_widths();
+    const auto offsets = a->get_const_col_offsets();
+    const auto deltas = a->get_const_col_deltas();
+    const auto vals = a->get_const_values();
+    const auto valpha = alpha->at(0, 0);
+    const auto vbeta = beta->at(0, 0);
+    for (size_type row = 0; row < a->get_size()[0]; row++) {
+        const auto begin = row_ptrs[row];
+        const auto row_words = deltas + offsets[row];
+        for (size_type j = 0; j < c->get_size()[1]; j++) {
+            c->at(row, j) *= vbeta;
+        }
+        for (auto nz = begin; nz < row_ptrs[row + 1]; nz++) {
+            const auto col =
+                decode_col(row_words, widths[row], bases[row], nz - begin);
+            const auto val = valpha * vals[nz];
+            for (size_type j = 0; j < c->get_size()[1]; j++) {
+                c->at(row, j) += val * b->at(col, j);
+            }
+        }
+    }
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(
+    GKO_DECLARE_COMPRESSED_CSR_ADVANCED_SPMV_KERNEL);
+
+
+template <typename ValueType, typename IndexType>
+void count_row_words(std::shared_ptr<const ReferenceExecutor> exec,
+                     const matrix::Csr<ValueType, IndexType>* source,
+                     uint8* col_widths, IndexType* row_words)
+{
+    const auto row_ptrs = source->get_const_row_ptrs();
+    const auto col_idxs = source->get_const_col_idxs();
+    for (size_type row = 0; row < source->get_size()[0]; row++) {
+        const auto begin = row_ptrs[row];
+        const auto end = row_ptrs[row + 1];
+        uint8 width = 1;
+        if (begin < end) {
+            const auto minmax =
+                std::minmax_element(col_idxs + begin, col_idxs + end);
+            const auto span =
+                static_cast<uint64>(*minmax.second - *minmax.first);
+            width = get_delta_width(span);
+        }
+        col_widths[row] = width;
+        row_words[row] =
+            static_cast<IndexType>(ceildiv((end - begin) * int64{width}, 8));
+    }
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(
+    GKO_DECLARE_COMPRESSED_CSR_COUNT_ROW_WORDS_KERNEL);
+
+
+template <typename ValueType, typename IndexType>
+void compress_from_csr(std::shared_ptr<const ReferenceExecutor> exec,
+                       const matrix::Csr<ValueType, IndexType>* source,
+                       matrix::CompressedCsr<ValueType, IndexType>* result)
+{
+    const auto num_rows = source->get_size()[0];
+    const auto row_ptrs = source->get_const_row_ptrs();
+    const auto col_idxs = source->get_const_col_idxs();
+    const auto vals = source->get_const_values();
+    const auto widths = result->get_const_col_widths();
+    const auto offsets = result->get_const_col_offsets();
+    auto out_bases = result->get_col_bases();
+    auto out_deltas = result->get_col_deltas();
+    std::copy_n(row_ptrs, num_rows + 1, result->get_row_ptrs());
+    std::copy_n(vals, row_ptrs[num_rows], result->get_values());
+    for (size_type row = 0; row < num_rows; row++) {
+        const auto begin = row_ptrs[row];
+        const auto end = row_ptrs[row + 1];
+        const auto base =
+            begin < end ? *std::min_element(col_idxs + begin, col_idxs + end)
+                        : IndexType{};
+        out_bases[row] = base;
+        // zero the padding at the end of the row
+        std::fill(out_deltas + offsets[row], out_deltas + offsets[row + 1],
+                  uint64{});
+        for (auto nz = begin; nz < end; nz++) {
+            encode_delta(out_deltas + offsets[row], widths[row], nz - begin,
+                         static_cast<uint64>(col_idxs[nz] - base));
+        }
+    }
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(
+    GKO_DECLARE_COMPRESSED_CSR_COMPRESS_FROM_CSR_KERNEL);
+
+
+template <typename ValueType, typename IndexType>
+void decompress_to_csr(
+    std::shared_ptr<const ReferenceExecutor> exec,
+    const matrix::CompressedCsr<ValueType, IndexType>* source,
+    matrix::Csr<ValueType, IndexType>* result)
+{
+    const auto num_rows = source->get_size()[0];
+    const auto row_ptrs = source->get_const_row_ptrs();
+    const auto bases = source->get_const_col_bases();
+    const auto widths = source->get_const_col_widths();
+    const auto offsets = source->get_const_col_offsets();
+    const auto deltas = source->get_const_col_deltas();
+    auto out_col_idxs = result->get_col_idxs();
+    std::copy_n(row_ptrs, num_rows + 1, result->get_row_ptrs());
+    std::copy_n(source->get_const_values(), row_ptrs[num_rows],
+                result->get_values());
+    for (size_type row = 0; row < num_rows; row++) {
+        const auto begin = row_ptrs[row];
+        for (auto nz = begin; nz < row_ptrs[row + 1]; nz++) {
+            out_col_idxs[nz] = decode_col(deltas + offsets[row], widths[row],
+                                          bases[row], nz - begin);
+        }
+    }
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(
+    GKO_DECLARE_COMPRESSED_CSR_DECOMPRESS_TO_CSR_KERNEL);
+
+
+}  // namespace compressed_csr
+}  // namespace reference
+}  // namespace kernels
+}  // namespace gko
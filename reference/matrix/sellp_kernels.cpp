@@ -63,21 +63,26 @@ void spmv(std::shared_ptr<const ReferenceExecutor> exec,
     auto slice_sets = a->get_const_slice_sets();
     auto slice_size = a->get_slice_size();
     auto slice_num = ceildiv(a->get_size()[0] + slice_size - 1, slice_size);
+    const auto permutation = a->get_const_permutation();
     for (size_type slice = 0; slice < slice_num; slice++) {
         for (size_type row = 0; row < slice_size; row++) {
             size_type global_row = slice * slice_size + row;
             if (global_row >= a->get_size()[0]) {
                 break;
             }
+            // rows of SELL-C-sigma are stored in permuted order
+            const auto out_row =
+                permutation ? static_cast<size_type>(permutation[global_row])
+                            : global_row;
             for (size_type j = 0; j < c->get_size()[1]; j++) {
-                c->at(global_row, j) = zero<ValueType>();
+                c->at(out_row, j) = zero<ValueType>();
             }
             for (size_type i = 0; i < slice_lengths[slice]; i++) {
                 auto val = a->val_at(row, slice_sets[slice], i);
                 auto col = a->col_at(row, slice_sets[slice], i);
                 if (col != invalid_index<IndexType>()) {
                     for (size_type j = 0; j < c->get_size()[1]; j++) {
-                        c->at(global_row, j) += val * b->at(col, j);
+                        c->at(out_row, j) += val * b->at(col, j);
                     }
                 }
             }
@@ -102,6 +107,7 @@ void advanced_spmv(std::shared_ptr<const ReferenceExecutor> exec,
     auto slice_sets = a->get_const_slice_sets();
     auto slice_size = a->get_slice_size();
     auto slice_num = ceildiv(a->get_size()[0] + slice_size - 1, slice_size);
+    const auto permutation = a->get_const_permutation();
     auto valpha = alpha->at(0, 0);
     auto vbeta = beta->at(0, 0);
     for (size_type slice = 0; slice < slice_num; slice++) {
@@ -110,15 +116,19 @@ void advanced_spmv(std::shared_ptr<const ReferenceExecutor> exec,
             if (global_row >= a->get_size()[0]) {
                 break;
             }
+            // rows of SELL-C-sigma are stored in permuted order
+            const auto out_row =
+                permutation ? static_cast<size_type>(permutation[global_row])
+                            : global_row;
             for (size_type j = 0; j < c->get_size()[1]; j++) {
-                c->at(global_row, j) *= vbeta;
+                c->at(out_row, j) *= vbeta;
             }
             for (size_type i = 0; i < slice_lengths[slice]; i++) {
                 auto val = a->val_at(row, slice_sets[slice], i);
                 auto col = a->col_at(row, slice_sets[slice], i);
                 if (col != invalid_index<IndexType>()) {
                     for (size_type j = 0; j < c->get_size()[1]; j++) {
-                        c->at(global_row, j) += valpha * val * b->at(col, j);
+                        c->at(out_row, j) += valpha * val * b->at(col, j);
                     }
                 }
             }
@@ -0,0 +1,209 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2022, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#include "core/matrix/stencil_kernels.hpp"
+
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+
+#include <ginkgo/core/base/math.hpp>
+#include <ginkgo/core/matrix/csr.hpp>
+#include <ginkgo/core/matrix/dense.hpp>
+
+
+namespace gko {
+namespace kernels {
+namespace reference {
+/**
+ * @brief The Stencil operator namespace.
+ * @ref Stencil
+ * @ingroup stencil
+ */
+namespace stencil {
+namespace {
+
+
+/**
+ * Computes the row of the neighbor of grid row `row` given by stencil point
+ * `point`, or returns -1 if the neighbor lies outside of the grid.
+ */
+template <typename ValueType, typename IndexType>
+int64 get_neighbor(const matrix::Stencil<ValueType, IndexType>* a, int64 row,
+                   size_type point)
+{
+    const auto grid = a->get_grid_size();
+    const auto nx = static_cast<int64>(grid[0]);
+    const auto ny = static_cast<int64>(grid[1]);
+    const auto nz = static_cast<int64>(grid[2]);
+    const auto offsets = a->get_const_offsets() + 3 * point;
+    const auto x = row % nx + offsets[0];
+    const auto y = row / nx % ny + offsets[1];
+    const auto z = row / nx / ny + offsets[2];
+    if (x < 0 || x >= nx || y < 0 || y >= ny || z < 0 || z >= nz) {
+        return -1;
+    }
+    return x + nx * (y + ny * z);
+}
+
+
+template <typename ValueType, typename IndexType>
+ValueType get_coefficient(const matrix::Stencil<ValueType, IndexType>* a,
+                          int64 row, size_type point)
+{
+    return a->has_variable_coefficients()
+               ? a->get_const_coefficients()[point * a->get_size()[0] + row]
+               : a->get_const_coefficients()[point];
+}
+
+
+}  // anonymous namespace
+
+
+template <typename ValueType, typename IndexType>
+void spmv(std::shared_ptr<const ReferenceExecutor> exec,
+          const matrix::Stencil<ValueType, IndexType>* a,
+          const matrix::Dense<ValueType>* b, matrix::Dense<ValueType>* c)
+{
+    const auto num_rows = static_cast<int64>(a->get_size()[0]);
+    for (int64 row = 0; row < num_rows; row++) {
+        for (size_type j = 0; j < c->get_size()[1]; j++) {
+            c->at(row, j) = zero<ValueType>();
+        }
+        for (size_type point = 0; point < a->get_num_points(); point++) {
+            const auto col = get_neighbor(a, row, point);
+            if (col < 0) {
+                continue;
+            }
+            const auto val = get_coefficient(a, row, point);
+            for (size_type j = 0; j < c->get_size()[1]; j++) {
+                c->at(row, j) += val * b->at(col, j);
+            }
+        }
+    }
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(GKO_DECLARE_STENCIL_SPMV_KERNEL);
+
+
+template <typename ValueType, typename IndexType>
+void advanced_spmv(std::shared_ptr<const ReferenceExecutor> exec,
+                   const matrix::Dense<ValueType>* alpha,
+                   const matrix::Stencil<ValueType, IndexType>* a,
+                   const matrix::Dense<ValueType>* b,
+                   const matrix::Dense<ValueType>* beta,
+                   matrix::Dense<ValueType>* c)
+{
+    const auto num_rows = static_cast<int64>(a->get_size()[0]);
+    const auto valpha = alpha->at(0, 0);
+    const auto vbeta = beta->at(0, 0);
+    for (int64 row = 0; row < num_rows; row++) {
+        for (size_type j = 0; j < c->get_size()[1]; j++) {
+            c->at(row, j) *= vbeta;
+        }
+        for (size_type point = 0; point < a->get_num_points(); point++) {
+            const auto col = get_neighbor(a, row, point);
+            if (col < 0) {
+                continue;
+            }
+            const auto val = valpha * get_coefficient(a, row, point);
+            for (size_type j = 0; j < c->get_size()[1]; j++) {
+                c->at(row, j) += val * b->at(col, j);
+            }
+        }
+    }
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(
+    GKO_DECLARE_STENCIL_ADVANCED_SPMV_KERNEL);
+
+
+template <typename ValueType, typename IndexType>
+void count_nonzeros_per_row(std::shared_ptr<const ReferenceExecutor> exec,
+                            const matrix::Stencil<ValueType, IndexType>* source,
+                            IndexType* result)
+{
+    const auto num_rows = static_cast<int64>(source->get_size()[0]);
+    for (int64 row = 0; row < num_rows; row++) {
+        IndexType count{};
+        for (size_type point = 0; point < source->get_num_points(); point++) {
+            count += get_neighbor(source, row, point) >= 0 ? 1 : 0;
+        }
+        result[row] = count;
+    }
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(
+    GKO_DECLARE_STENCIL_COUNT_NONZEROS_PER_ROW_KERNEL);
+
+
+template <typename ValueType, typename IndexType>
+void fill_in_csr(std::shared_ptr<const ReferenceExecutor> exec,
+                 const matrix::Stencil<ValueType, IndexType>* source,
+                 matrix::Csr<ValueType, IndexType>* result)
+{
+    const auto num_rows = static_cast<int64>(source->get_size()[0]);
+    const auto row_ptrs = result->get_const_row_ptrs();
+    const auto col_idxs = result->get_col_idxs();
+    const auto vals = result->get_values();
+    std::vector<std::pair<int64, ValueType>> row_entries;
+    for (int64 row = 0; row < num_rows; row++) {
+        row_entries.clear();
+        for (size_type point = 0; point < source->get_num_points(); point++) {
+            const auto col = get_neighbor(source, row, point);
+            if (col >= 0) {
+                row_entries.emplace_back(
+                    col, get_coefficient(source, row, point));
+            }
+        }
+        std::stable_sort(
+            row_entries.begin(), row_entries.end(),
+            [](auto a, auto b) { return a.first < b.first; });
+        auto out_nz = row_ptrs[row];
+        for (const auto& entry : row_entries) {
+            col_idxs[out_nz] = static_cast<IndexType>(entry.first);
+            vals[out_nz] = entry.second;
+            out_nz++;
+        }
+    }
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(
+    GKO_DECLARE_STENCIL_FILL_IN_CSR_KERNEL);
+
+
+}  // namespace stencil
+}  // namespace reference
+}  // namespace kernels
+}  // namespace gko
@@ -0,0 +1,243 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2022, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#include "core/matrix/symmetric_csr_kernels.hpp"
+
+
+#include <algorithm>
+
+
+#include <ginkgo/core/base/exception_helpers.hpp>
+#include <ginkgo/core/base/math.hpp>
+#include <ginkgo/core/matrix/csr.hpp>
+#include <ginkgo/core/matrix/dense.hpp>
+
+
+#include "core/base/allocator.hpp"
+#include "core/components/prefix_sum_kernels.hpp"
+#include "core/matrix/csr_builder.hpp"
+
+
+namespace gko {
+namespace kernels {
+namespace reference {
+/**
+ * @brief The symmetric CSR matrix format namespace.
+ * @ref SymmetricCsr
+ * @ingroup symmetric_csr
+ */
+namespace symmetric_csr {
+
+
+template <typename ValueType, typename IndexType>
+void spmv(std::shared_ptr<const ReferenceExecutor> exec,
+          const matrix::SymmetricCsr<ValueType, IndexType>* a,
+          const matrix::Dense<ValueType>* b, matrix::Dense<ValueType>* c)
+{
+    const auto row_ptrs = a->get_const_row_ptrs();
+    const auto col_idxs = a->get_const_col_idxs();
+    const auto vals = a->get_const_values();
+    const auto hermitian = a->is_hermitian();
+    const auto num_rows = a->get_size()[0];
+    const auto num_rhs = c->get_size()[1];
+    for (size_type row = 0; row < num_rows; row++) {
+        for (size_type j = 0; j < num_rhs; j++) {
+            c->at(row, j) = zero<ValueType>();
+        }
+    }
+    for (size_type row = 0; row < num_rows; row++) {
+        for (auto nz = row_ptrs[row]; nz < row_ptrs[row + 1]; nz++) {
+            const auto col = static_cast<size_type>(col_idxs[nz]);
+            const auto val = vals[nz];
+            for (size_type j = 0; j < num_rhs; j++) {
+                c->at(row, j) += val * b->at(col, j);
+            }
+            if (col != row) {
+                const auto trans_val = hermitian ? conj(val) : val;
+                for (size_type j = 0; j < num_rhs; j++) {
+                    c->at(col, j) += trans_val * b->at(row, j);
+                }
+            }
+        }
+    }
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(
+    GKO_DECLARE_SYMMETRIC_CSR_SPMV_KERNEL);
+
+
+template <typename ValueType, typename IndexType>
+void advanced_spmv(std::shared_ptr<const ReferenceExecutor> exec,
+                   const matrix::Dense<ValueType>* alpha,
+                   const matrix::SymmetricCsr<ValueType, IndexType>* a,
+                   const matrix::Dense<ValueType>* b,
+                   const matrix::Dense<ValueType>* beta,
+                   matrix::Dense<ValueType>* c)
+{
+    const auto row_ptrs = a->get_const_row_ptrs();
+    const auto col_idxs = a->get_const_col_idxs();
+    const auto vals = a->get_const_values();
+    const auto hermitian = a->is_hermitian();
+    const auto num_rows = a->get_size()[0];
+    const auto num_rhs = c->get_size()[1];
+    const auto valpha = alpha->at(0, 0);
+    const auto vbeta = beta->at(0, 0);
+    for (size_type row = 0; row < num_rows; row++) {
+        for (size_type j = 0; j < num_rhs; j++) {
+            c->at(row, j) *= vbeta;
+        }
+    }
+    for (size_type row = 0; row < num_rows; row++) {
+        for (auto nz = row_ptrs[row]; nz < row_ptrs[row + 1]; nz++) {
+            const auto col = static_cast<size_type>(col_idxs[nz]);
+            const auto val = valpha * vals[nz];
+            for (size_type j = 0; j < num_rhs; j++) {
+                c->at(row, j) += val * b->at(col, j);
+            }
+            if (col != row) {
+                const auto trans_val =
+                    valpha * (hermitian ? conj(vals[nz]) : vals[nz]);
+                for (size_type j = 0; j < num_rhs; j++) {
+                    c->at(col, j) += trans_val * b->at(row, j);
+                }
+            }
+        }
+    }
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(
+    GKO_DECLARE_SYMMETRIC_CSR_ADVANCED_SPMV_KERNEL);
+
+
+template <typename ValueType, typename IndexType>
+void count_upper_nonzeros_per_row(
+    std::shared_ptr<const ReferenceExecutor> exec,
+    const matrix::Csr<ValueType, IndexType>* source, IndexType* result)
+{
+    const auto row_ptrs = source->get_const_row_ptrs();
+    const auto col_idxs = source->get_const_col_idxs();
+    for (size_type row = 0; row < source->get_size()[0]; row++) {
+        result[row] = 0;
+        for (auto nz = row_ptrs[row]; nz < row_ptrs[row + 1]; nz++) {
+            if (static_cast<size_type>(col_idxs[nz]) >= row) {
+                result[row]++;
+            }
+        }
+    }
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(
+    GKO_DECLARE_SYMMETRIC_CSR_COUNT_UPPER_NONZEROS_PER_ROW_KERNEL);
+
+
+template <typename ValueType, typename IndexType>
+void extract_upper(std::shared_ptr<const ReferenceExecutor> exec,
+                   const matrix::Csr<ValueType, IndexType>* source,
+                   matrix::SymmetricCsr<ValueType, IndexType>* result)
+{
+    const auto in_row_ptrs = source->get_const_row_ptrs();
+    const auto in_col_idxs = source->get_const_col_idxs();
+    const auto in_vals = source->get_const_values();
+    const auto out_row_ptrs = result->get_const_row_ptrs();
+    const auto out_col_idxs = result->get_col_idxs();
+    const auto out_vals = result->get_values();
+    for (size_type row = 0; row < source->get_size()[0]; row++) {
+        auto out_nz = out_row_ptrs[row];
+        for (auto nz = in_row_ptrs[row]; nz < in_row_ptrs[row + 1]; nz++) {
+            if (static_cast<size_type>(in_col_idxs[nz]) >= row) {
+                out_col_idxs[out_nz] = in_col_idxs[nz];
+                out_vals[out_nz] = in_vals[nz];
+                out_nz++;
+            }
+        }
+    }
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(
+    GKO_DECLARE_SYMMETRIC_CSR_EXTRACT_UPPER_KERNEL);
+
+
+template <typename ValueType, typename IndexType>
+void convert_to_csr(std::shared_ptr<const ReferenceExecutor> exec,
+                    const matrix::SymmetricCsr<ValueType, IndexType>* source,
+                    matrix::Csr<ValueType, IndexType>* result)
+{
+    const auto num_rows = source->get_size()[0];
+    const auto in_row_ptrs = source->get_const_row_ptrs();
+    const auto in_col_idxs = source->get_const_col_idxs();
+    const auto in_vals = source->get_const_values();
+    const auto hermitian = source->is_hermitian();
+    const auto out_row_ptrs = result->get_row_ptrs();
+    std::fill_n(out_row_ptrs, num_rows + 1, 0);
+    for (size_type row = 0; row < num_rows; row++) {
+        for (auto nz = in_row_ptrs[row]; nz < in_row_ptrs[row + 1]; nz++) {
+            const auto col = in_col_idxs[nz];
+            out_row_ptrs[row]++;
+            if (static_cast<size_type>(col) != row) {
+                out_row_ptrs[col]++;
+            }
+        }
+    }
+    components::prefix_sum(exec, out_row_ptrs, num_rows + 1);
+    const auto nnz = static_cast<size_type>(out_row_ptrs[num_rows]);
+    matrix::CsrBuilder<ValueType, IndexType> builder{result};
+    builder.get_col_idx_array().resize_and_reset(nnz);
+    builder.get_value_array().resize_and_reset(nnz);
+    const auto out_col_idxs = result->get_col_idxs();
+    const auto out_vals = result->get_values();
+    // the transposed entries of a row stem from the rows above it, so they
+    // are inserted before the row's own entries and the rows stay sorted
+    vector<IndexType> out_nz(out_row_ptrs, out_row_ptrs + num_rows, exec);
+    for (size_type row = 0; row < num_rows; row++) {
+        for (auto nz = in_row_ptrs[row]; nz < in_row_ptrs[row + 1]; nz++) {
+            const auto col = in_col_idxs[nz];
+            const auto val = in_vals[nz];
+            out_col_idxs[out_nz[row]] = col;
+            out_vals[out_nz[row]] = val;
+            out_nz[row]++;
+            if (static_cast<size_type>(col) != row) {
+                out_col_idxs[out_nz[col]] = static_cast<IndexType>(row);
+                out_vals[out_nz[col]] = hermitian ? conj(val) : val;
+                out_nz[col]++;
+            }
+        }
+    }
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(
+    GKO_DECLARE_SYMMETRIC_CSR_CONVERT_TO_CSR_KERNEL);
+
+
+}  // namespace symmetric_csr
+}  // namespace reference
+}  // namespace kernels
+}  // namespace gko
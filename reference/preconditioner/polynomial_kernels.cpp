@@ -0,0 +1,113 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2022, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+
+#include "core/preconditioner/polynomial_kernels.hpp"
+
+
+#include <ginkgo/core/base/math.hpp>
+#include <ginkgo/core/base/types.hpp>
+
+
+namespace gko {
+namespace kernels {
+namespace reference {
+/**
+ * @brief The Polynomial preconditioner namespace.
+ *
+ * @ingroup polynomial
+ */
+namespace polynomial {
+
+
+template <typename ValueType>
+void horner_step(std::shared_ptr<const ReferenceExecutor> exec,
+                 ValueType alpha, const matrix::Dense<ValueType>* y,
+                 ValueType beta, ValueType gamma,
+                 const matrix::Dense<ValueType>* b,
+                 matrix::Dense<ValueType>* x)
+{
+    const auto ignore_x = is_zero(beta);
+    for (size_type i = 0; i < x->get_size()[0]; ++i) {
+        for (size_type j = 0; j < x->get_size()[1]; ++j) {
+            const auto x_part =
+                ignore_x ? zero<ValueType>() : beta * x->at(i, j);
+            x->at(i, j) = alpha * y->at(i, j) + x_part + gamma * b->at(i, j);
+        }
+    }
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_TYPE(GKO_DECLARE_POLYNOMIAL_HORNER_STEP_KERNEL);
+
+
+template <typename ValueType>
+void chebyshev_initialize(std::shared_ptr<const ReferenceExecutor> exec,
+                          const matrix::Dense<ValueType>* b,
+                          ValueType inv_theta, matrix::Dense<ValueType>* r,
+                          matrix::Dense<ValueType>* d,
+                          matrix::Dense<ValueType>* x)
+{
+    for (size_type i = 0; i < b->get_size()[0]; ++i) {
+        for (size_type j = 0; j < b->get_size()[1]; ++j) {
+            r->at(i, j) = b->at(i, j);
+            d->at(i, j) = x->at(i, j) = inv_theta * b->at(i, j);
+        }
+    }
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_TYPE(
+    GKO_DECLARE_POLYNOMIAL_CHEBYSHEV_INITIALIZE_KERNEL);
+
+
+template <typename ValueType>
+void chebyshev_step(std::shared_ptr<const ReferenceExecutor> exec,
+                    const matrix::Dense<ValueType>* ad, ValueType c_d,
+                    ValueType c_r, matrix::Dense<ValueType>* r,
+                    matrix::Dense<ValueType>* d, matrix::Dense<ValueType>* x)
+{
+    for (size_type i = 0; i < x->get_size()[0]; ++i) {
+        for (size_type j = 0; j < x->get_size()[1]; ++j) {
+            r->at(i, j) -= ad->at(i, j);
+            d->at(i, j) = c_d * d->at(i, j) + c_r * r->at(i, j);
+            x->at(i, j) += d->at(i, j);
+        }
+    }
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_TYPE(
+    GKO_DECLARE_POLYNOMIAL_CHEBYSHEV_STEP_KERNEL);
+
+
+}  // namespace polynomial
+}  // namespace reference
+}  // namespace kernels
+}  // namespace gko
@@ -0,0 +1,197 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2022, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#include "core/solver/block_trs_kernels.hpp"
+
+
+#include <algorithm>
+
+
+#include <ginkgo/core/base/math.hpp>
+#include <ginkgo/core/base/types.hpp>
+#include <ginkgo/core/matrix/dense.hpp>
+#include <ginkgo/core/matrix/fbcsr.hpp>
+
+
+#include "core/base/allocator.hpp"
+#include "core/components/dense_block.hpp"
+
+
+namespace gko {
+namespace kernels {
+namespace reference {
+/**
+ * @brief The BLOCK_TRS solver namespace.
+ *
+ * @ingroup block_trs
+ */
+namespace block_trs {
+
+
+template <typename ValueType, typename IndexType>
+void invert_diagonal(std::shared_ptr<const ReferenceExecutor> exec,
+                     const matrix::Fbcsr<ValueType, IndexType>* matrix,
+                     ValueType* diag_inv)
+{
+    const auto num_block_rows = matrix->get_num_block_rows();
+    const auto bs = matrix->get_block_size();
+    const auto block_nnz = bs * bs;
+    const auto row_ptrs = matrix->get_const_row_ptrs();
+    const auto col_idxs = matrix->get_const_col_idxs();
+    const auto vals = matrix->get_const_values();
+    vector<ValueType> work(block_nnz, {}, exec);
+
+    for (IndexType row = 0; row < num_block_rows; ++row) {
+        const auto inv = diag_inv + row * block_nnz;
+        // missing diagonal blocks are treated as identity blocks
+        for (int j = 0; j < bs; ++j) {
+            for (int i = 0; i < bs; ++i) {
+                work[i + j * bs] =
+                    i == j ? one<ValueType>() : zero<ValueType>();
+            }
+        }
+        for (auto nz = row_ptrs[row]; nz < row_ptrs[row + 1]; ++nz) {
+            if (col_idxs[nz] == row) {
+                std::copy_n(vals + nz * block_nnz, block_nnz, work.begin());
+                break;
+            }
+        }
+        dense_block::invert(bs, work.data(), inv);
+    }
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(
+    GKO_DECLARE_BLOCK_TRS_INVERT_DIAGONAL_KERNEL);
+
+
+namespace {
+
+
+template <bool lower, typename ValueType, typename IndexType>
+void solve_block_row(const matrix::Fbcsr<ValueType, IndexType>* matrix,
+                     const ValueType* diag_inv, bool unit_diag, IndexType row,
+                     size_type rhs, const matrix::Dense<ValueType>* b,
+                     matrix::Dense<ValueType>* x, ValueType* work,
+                     ValueType* x_block)
+{
+    const auto bs = matrix->get_block_size();
+    const auto block_nnz = bs * bs;
+    const auto row_ptrs = matrix->get_const_row_ptrs();
+    const auto col_idxs = matrix->get_const_col_idxs();
+    const auto vals = matrix->get_const_values();
+    for (int i = 0; i < bs; ++i) {
+        work[i] = b->at(row * bs + i, rhs);
+    }
+    for (auto nz = row_ptrs[row]; nz < row_ptrs[row + 1]; ++nz) {
+        const auto col = col_idxs[nz];
+        // only use the blocks of the respective triangle
+        if (lower ? col >= row : col <= row) {
+            continue;
+        }
+        for (int i = 0; i < bs; ++i) {
+            x_block[i] = x->at(col * bs + i, rhs);
+        }
+        dense_block::multiply_sub_vector(bs, vals + nz * block_nnz, x_block,
+                                         work);
+    }
+    if (unit_diag) {
+        for (int i = 0; i < bs; ++i) {
+            x->at(row * bs + i, rhs) = work[i];
+        }
+    } else {
+        const auto inv = diag_inv + row * block_nnz;
+        for (int i = 0; i < bs; ++i) {
+            auto value = zero<ValueType>();
+            for (int k = 0; k < bs; ++k) {
+                value += inv[i + k * bs] * work[k];
+            }
+            x->at(row * bs + i, rhs) = value;
+        }
+    }
+}
+
+
+}  // namespace
+
+
+template <typename ValueType, typename IndexType>
+void solve_lower(std::shared_ptr<const ReferenceExecutor> exec,
+                 const matrix::Fbcsr<ValueType, IndexType>* matrix,
+                 const ValueType* diag_inv, bool unit_diag,
+                 const matrix::Dense<ValueType>* b,
+                 matrix::Dense<ValueType>* x)
+{
+    const auto num_block_rows = matrix->get_num_block_rows();
+    const auto bs = matrix->get_block_size();
+    vector<ValueType> work(bs, {}, exec);
+    vector<ValueType> x_block(bs, {}, exec);
+
+    for (size_type rhs = 0; rhs < b->get_size()[1]; ++rhs) {
+        for (IndexType row = 0; row < num_block_rows; ++row) {
+            solve_block_row<true>(matrix, diag_inv, unit_diag, row, rhs, b, x,
+                                  work.data(), x_block.data());
+        }
+    }
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(
+    GKO_DECLARE_BLOCK_TRS_SOLVE_LOWER_KERNEL);
+
+
+template <typename ValueType, typename IndexType>
+void solve_upper(std::shared_ptr<const ReferenceExecutor> exec,
+                 const matrix::Fbcsr<ValueType, IndexType>* matrix,
+                 const ValueType* diag_inv, bool unit_diag,
+                 const matrix::Dense<ValueType>* b,
+                 matrix::Dense<ValueType>* x)
+{
+    const auto num_block_rows = matrix->get_num_block_rows();
+    const auto bs = matrix->get_block_size();
+    vector<ValueType> work(bs, {}, exec);
+    vector<ValueType> x_block(bs, {}, exec);
+
+    for (size_type rhs = 0; rhs < b->get_size()[1]; ++rhs) {
+        for (auto row = num_block_rows - 1; row >= 0; --row) {
+            solve_block_row<false>(matrix, diag_inv, unit_diag, row, rhs, b,
+                                   x, work.data(), x_block.data());
+        }
+    }
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(
+    GKO_DECLARE_BLOCK_TRS_SOLVE_UPPER_KERNEL);
+
+
+}  // namespace block_trs
+}  // namespace reference
+}  // namespace kernels
+}  // namespace gko
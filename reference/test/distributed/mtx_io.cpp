@@ -0,0 +1,178 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2022, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#include <ginkgo/core/distributed/mtx_io.hpp>
+
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <sstream>
+
+
+#include <gtest/gtest.h>
+
+
+#include <ginkgo/core/base/device_matrix_data.hpp>
+#include <ginkgo/core/base/executor.hpp>
+#include <ginkgo/core/base/matrix_data.hpp>
+#include <ginkgo/core/base/mtx_io.hpp>
+
+
+#include "core/test/utils.hpp"
+
+
+namespace {
+
+
+using comm_index_type = gko::experimental::distributed::comm_index_type;
+
+
+template <typename ValueLocalGlobalIndexType>
+class MtxIo : public ::testing::Test {
+protected:
+    using value_type = typename std::tuple_element<
+        0, decltype(ValueLocalGlobalIndexType())>::type;
+    using local_index_type = typename std::tuple_element<
+        1, decltype(ValueLocalGlobalIndexType())>::type;
+    using global_index_type = typename std::tuple_element<
+        2, decltype(ValueLocalGlobalIndexType())>::type;
+    using part_type =
+        gko::experimental::distributed::Partition<local_index_type,
+                                                  global_index_type>;
+    using mtx_data = gko::matrix_data<value_type, global_index_type>;
+
+    MtxIo() : ref(gko::ReferenceExecutor::create()), engine(42)
+    {
+        data = gko::test::generate_random_matrix_data<value_type,
+                                                      global_index_type>(
+            num_rows, 17, std::uniform_int_distribution<int>(0, 5),
+            std::normal_distribution<gko::remove_complex<value_type>>(),
+            engine);
+        data.ensure_row_major_order();
+        auto mapping = gko::test::generate_random_array<comm_index_type>(
+            num_rows, std::uniform_int_distribution<int>(0, num_parts - 1),
+            engine, ref);
+        partition = part_type::build_from_mapping(ref, mapping, num_parts);
+        owner = std::vector<comm_index_type>(
+            mapping.get_const_data(), mapping.get_const_data() + num_rows);
+    }
+
+    gko::device_matrix_data<value_type, global_index_type> read(
+        std::istream& is, const part_type* part, comm_index_type part_id)
+    {
+        return gko::experimental::distributed::read_binary_distributed_raw<
+            value_type>(ref, is, part, part_id);
+    }
+
+    void assert_reads_owned_rows(std::stringstream& ss)
+    {
+        for (comm_index_type part = 0; part < num_parts; part++) {
+            SCOPED_TRACE(part);
+            ss.seekg(0);
+            auto local_data =
+                read(ss, partition.get(), part).copy_to_host();
+
+            auto expected = data;
+            expected.nonzeros.erase(
+                std::remove_if(expected.nonzeros.begin(),
+                               expected.nonzeros.end(),
+                               [&](auto entry) {
+                                   return owner[entry.row] != part;
+                               }),
+                expected.nonzeros.end());
+            local_data.ensure_row_major_order();
+            ASSERT_EQ(local_data.size, data.size);
+            ASSERT_EQ(local_data.nonzeros, expected.nonzeros);
+        }
+    }
+
+    std::shared_ptr<const gko::ReferenceExecutor> ref;
+    const gko::size_type num_rows = 53;
+    const comm_index_type num_parts = 3;
+    std::default_random_engine engine;
+    mtx_data data;
+    std::unique_ptr<part_type> partition;
+    std::vector<comm_index_type> owner;
+};
+
+TYPED_TEST_SUITE(MtxIo, gko::test::ValueLocalGlobalIndexTypes,
+                 TypenameNameGenerator);
+
+
+TYPED_TEST(MtxIo, ReadsOwnedRowsFromBinary)
+{
+    std::stringstream ss;
+    gko::write_binary_raw(ss, this->data);
+
+    this->assert_reads_owned_rows(ss);
+}
+
+
+TYPED_TEST(MtxIo, ReadsOwnedRowsFromIndexedBinary)
+{
+    std::stringstream ss;
+    gko::write_binary_indexed_raw(ss, this->data, 4);
+
+    this->assert_reads_owned_rows(ss);
+}
+
+
+TYPED_TEST(MtxIo, ReadsEmptyPart)
+{
+    using global_index_type = typename TestFixture::global_index_type;
+    using part_type = typename TestFixture::part_type;
+    std::stringstream ss;
+    gko::write_binary_indexed_raw(ss, this->data, 4);
+    auto partition = part_type::build_from_contiguous(
+        this->ref, gko::array<global_index_type>{this->ref, {0, 20, 20, 53}});
+
+    auto local_data = this->read(ss, partition.get(), 1);
+
+    ASSERT_EQ(local_data.get_size(), this->data.size);
+    ASSERT_EQ(local_data.get_num_elems(), 0);
+}
+
+
+TYPED_TEST(MtxIo, ThrowsOnSizeMismatch)
+{
+    using part_type = typename TestFixture::part_type;
+    std::stringstream ss;
+    gko::write_binary_raw(ss, this->data);
+    auto partition = part_type::build_from_global_size_uniform(
+        this->ref, this->num_parts, this->num_rows + 1);
+
+    ASSERT_THROW(this->read(ss, partition.get(), 0), gko::ValueMismatch);
+}
+
+
+}  // namespace
@@ -0,0 +1,239 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2022, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+
+#include <ginkgo/core/distributed/partition_helpers.hpp>
+
+
+#include <algorithm>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <vector>
+
+
+#include <gtest/gtest.h>
+
+
+#include <ginkgo/core/base/executor.hpp>
+#include <ginkgo/core/base/matrix_data.hpp>
+#include <ginkgo/core/matrix/csr.hpp>
+
+
+#include "core/test/utils.hpp"
+
+
+namespace {
+
+
+using comm_index_type = gko::experimental::distributed::comm_index_type;
+
+
+template <typename LocalGlobalIndexType>
+class PartitionHelpers : public ::testing::Test {
+protected:
+    using local_index_type =
+        typename std::tuple_element<0, decltype(LocalGlobalIndexType())>::type;
+    using global_index_type =
+        typename std::tuple_element<1, decltype(LocalGlobalIndexType())>::type;
+    using value_type = double;
+    using part_type =
+        gko::experimental::distributed::Partition<local_index_type,
+                                                  global_index_type>;
+    using csr_type = gko::matrix::Csr<value_type, global_index_type>;
+    using mtx_data = gko::matrix_data<value_type, global_index_type>;
+
+    PartitionHelpers() : ref(gko::ReferenceExecutor::create()) {}
+
+    // 5-point stencil on a size x size grid, where grid point i is stored in
+    // row permutation[i]
+    mtx_data generate_grid(global_index_type size,
+                           std::vector<global_index_type> permutation = {})
+    {
+        if (permutation.empty()) {
+            permutation.resize(size * size);
+            std::iota(permutation.begin(), permutation.end(), 0);
+        }
+        mtx_data data{gko::dim<2>(size * size)};
+        for (global_index_type y = 0; y < size; y++) {
+            for (global_index_type x = 0; x < size; x++) {
+                const auto row = permutation[y * size + x];
+                data.nonzeros.emplace_back(row, row, 4.0);
+                if (x > 0) {
+                    data.nonzeros.emplace_back(
+                        row, permutation[y * size + x - 1], -1.0);
+                }
+                if (x < size - 1) {
+                    data.nonzeros.emplace_back(
+                        row, permutation[y * size + x + 1], -1.0);
+                }
+                if (y > 0) {
+                    data.nonzeros.emplace_back(
+                        row, permutation[(y - 1) * size + x], -1.0);
+                }
+                if (y < size - 1) {
+                    data.nonzeros.emplace_back(
+                        row, permutation[(y + 1) * size + x], -1.0);
+                }
+            }
+        }
+        data.ensure_row_major_order();
+        return data;
+    }
+
+    static std::vector<comm_index_type> get_mapping(const part_type* part)
+    {
+        std::vector<comm_index_type> mapping(part->get_size());
+        const auto range_bounds = part->get_range_bounds();
+        const auto part_ids = part->get_part_ids();
+        for (gko::size_type range = 0; range < part->get_num_ranges();
+             range++) {
+            std::fill(mapping.begin() + range_bounds[range],
+                      mapping.begin() + range_bounds[range + 1],
+                      part_ids[range]);
+        }
+        return mapping;
+    }
+
+    // number of entries coupling different parts, i.e. the halo volume
+    static gko::size_type count_cut(const mtx_data& data,
+                                    const std::vector<comm_index_type>& mapping)
+    {
+        return std::count_if(data.nonzeros.begin(), data.nonzeros.end(),
+                             [&mapping](const typename mtx_data::nonzero_type&
+                                            entry) {
+                                 return mapping[entry.row] !=
+                                        mapping[entry.column];
+                             });
+    }
+
+    std::shared_ptr<const gko::ReferenceExecutor> ref;
+};
+
+TYPED_TEST_SUITE(PartitionHelpers, gko::test::LocalGlobalIndexTypes,
+                 PairTypenameNameGenerator);
+
+
+TYPED_TEST(PartitionHelpers, BuildsSinglePartFromGraph)
+{
+    using csr_type = typename TestFixture::csr_type;
+    using local_index_type = typename TestFixture::local_index_type;
+    auto graph = csr_type::create(this->ref);
+    graph->read(this->generate_grid(5));
+
+    auto part = gko::experimental::distributed::build_partition_from_graph<
+        local_index_type>(this->ref, graph.get(), 1);
+
+    ASSERT_EQ(part->get_size(), 25);
+    ASSERT_EQ(part->get_num_parts(), 1);
+    ASSERT_EQ(part->get_part_size(0), 25);
+}
+
+
+TYPED_TEST(PartitionHelpers, BuildsBalancedPartitionFromGraph)
+{
+    using csr_type = typename TestFixture::csr_type;
+    using local_index_type = typename TestFixture::local_index_type;
+    auto data = this->generate_grid(16);
+    auto graph = csr_type::create(this->ref);
+    graph->read(data);
+
+    auto part = gko::experimental::distributed::build_partition_from_graph<
+        local_index_type>(this->ref, graph.get(), 4, 0.05);
+
+    ASSERT_EQ(part->get_size(), 256);
+    ASSERT_EQ(part->get_num_parts(), 4);
+    for (comm_index_type p = 0; p < 4; p++) {
+        ASSERT_GT(part->get_part_size(p), 0);
+        ASSERT_LE(part->get_part_size(p), 68);
+    }
+    // splitting the grid into four strips cuts 3 * 16 edges in both
+    // directions, the quadrants would cut 2 * 16
+    ASSERT_LE(this->count_cut(data, this->get_mapping(part.get())),
+              2 * 3 * 16);
+}
+
+
+TYPED_TEST(PartitionHelpers, ReducesHaloOfUnstructuredNumbering)
+{
+    using csr_type = typename TestFixture::csr_type;
+    using part_type = typename TestFixture::part_type;
+    using local_index_type = typename TestFixture::local_index_type;
+    using global_index_type = typename TestFixture::global_index_type;
+    std::vector<global_index_type> permutation(30 * 30);
+    std::iota(permutation.begin(), permutation.end(), 0);
+    std::shuffle(permutation.begin(), permutation.end(),
+                 std::default_random_engine{42});
+    auto data = this->generate_grid(30, permutation);
+    auto graph = csr_type::create(this->ref);
+    graph->read(data);
+    auto contiguous =
+        part_type::build_from_global_size_uniform(this->ref, 6, 900);
+
+    auto part = gko::experimental::distributed::build_partition_from_graph<
+        local_index_type>(this->ref, graph.get(), 6);
+
+    const auto contiguous_cut =
+        this->count_cut(data, this->get_mapping(contiguous.get()));
+    const auto cut = this->count_cut(data, this->get_mapping(part.get()));
+    ASSERT_LT(cut * 5, contiguous_cut);
+    for (comm_index_type p = 0; p < 6; p++) {
+        ASSERT_LE(part->get_part_size(p), 155);
+    }
+}
+
+
+TYPED_TEST(PartitionHelpers, BuildsSamePartitionFromMatrixData)
+{
+    using csr_type = typename TestFixture::csr_type;
+    using value_type = typename TestFixture::value_type;
+    using local_index_type = typename TestFixture::local_index_type;
+    using global_index_type = typename TestFixture::global_index_type;
+    using device_data_type =
+        gko::device_matrix_data<value_type, global_index_type>;
+    auto data = this->generate_grid(12);
+    auto graph = csr_type::create(this->ref);
+    graph->read(data);
+    auto device_data = device_data_type::create_from_host(this->ref, data);
+
+    auto part = gko::experimental::distributed::build_partition_from_graph<
+        local_index_type>(this->ref, graph.get(), 3);
+    auto data_part =
+        gko::experimental::distributed::build_partition_from_graph<
+            local_index_type>(this->ref, device_data, 3);
+
+    ASSERT_EQ(this->get_mapping(part.get()),
+              this->get_mapping(data_part.get()));
+}
+
+
+}  // namespace
@@ -0,0 +1,240 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2022, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#include <ginkgo/core/factorization/block_ilu.hpp>
+
+
+#include <initializer_list>
+#include <memory>
+
+
+#include <gtest/gtest.h>
+
+
+#include <ginkgo/core/base/executor.hpp>
+#include <ginkgo/core/factorization/ilu.hpp>
+#include <ginkgo/core/matrix/csr.hpp>
+#include <ginkgo/core/matrix/dense.hpp>
+#include <ginkgo/core/matrix/fbcsr.hpp>
+
+
+#include "core/test/utils.hpp"
+
+
+namespace {
+
+
+template <typename ValueIndexType>
+class BlockIlu : public ::testing::Test {
+protected:
+    using value_type =
+        typename std::tuple_element<0, decltype(ValueIndexType())>::type;
+    using index_type =
+        typename std::tuple_element<1, decltype(ValueIndexType())>::type;
+    using Dense = gko::matrix::Dense<value_type>;
+    using Csr = gko::matrix::Csr<value_type, index_type>;
+    using Fbcsr = gko::matrix::Fbcsr<value_type, index_type>;
+    using block_ilu_type = gko::factorization::BlockIlu<value_type, index_type>;
+    using mat_data = gko::matrix_data<value_type, index_type>;
+
+    BlockIlu()
+        : exec(gko::ReferenceExecutor::create()),
+          // clang-format off
+          block_tridiag_data({{4., 1., 1., 0., 0., 0.},
+                              {2., 4., 0., 1., 0., 0.},
+                              {1., 0., 4., 1., 1., 2.},
+                              {0., 1., -1., 4., 0., 1.},
+                              {0., 0., 1., 0., 4., 1.},
+                              {0., 0., 0., 1., 1., 4.}}),
+          general_data({{4., 1., 0., 2.},
+                        {1., 5., 1., 0.},
+                        {2., 0., 6., 1.},
+                        {0., 3., 1., 7.}}),
+          // clang-format on
+          block_tridiag(to_fbcsr(block_tridiag_data, 2)),
+          factory(block_ilu_type::build().on(exec))
+    {}
+
+    std::shared_ptr<Fbcsr> to_fbcsr(const mat_data& data, int block_size)
+    {
+        auto result = gko::share(Fbcsr::create(exec, block_size));
+        result->read(data);
+        return result;
+    }
+
+    std::unique_ptr<Dense> multiply(const Fbcsr* l, const Fbcsr* u)
+    {
+        auto l_dense = Dense::create(exec);
+        auto u_dense = Dense::create(exec);
+        l->convert_to(l_dense.get());
+        u->convert_to(u_dense.get());
+        auto result = Dense::create(exec, l->get_size());
+        l_dense->apply(u_dense.get(), result.get());
+        return result;
+    }
+
+    std::shared_ptr<const gko::ReferenceExecutor> exec;
+    mat_data block_tridiag_data;
+    mat_data general_data;
+    std::shared_ptr<Fbcsr> block_tridiag;
+    std::unique_ptr<typename block_ilu_type::Factory> factory;
+};
+
+TYPED_TEST_SUITE(BlockIlu, gko::test::ValueIndexTypes,
+                 PairTypenameNameGenerator);
+
+
+TYPED_TEST(BlockIlu, FactorsBlockDiagonalMatrix)
+{
+    using Fbcsr = typename TestFixture::Fbcsr;
+    using value_type = typename TestFixture::value_type;
+    auto mtx = this->to_fbcsr({{2., 1., 0., 0.},
+                               {1., 3., 0., 0.},
+                               {0., 0., 4., -1.},
+                               {0., 0., 2., 5.}},
+                              2);
+
+    auto factors = this->factory->generate(mtx);
+
+    ASSERT_EQ(factors->get_l_factor()->get_block_size(), 2);
+    ASSERT_EQ(factors->get_u_factor()->get_block_size(), 2);
+    GKO_ASSERT_MTX_NEAR(factors->get_l_factor(),
+                        l<value_type>({{1., 0., 0., 0.},
+                                       {0., 1., 0., 0.},
+                                       {0., 0., 1., 0.},
+                                       {0., 0., 0., 1.}}),
+                        0.0);
+    GKO_ASSERT_MTX_NEAR(factors->get_u_factor(), mtx, 0.0);
+}
+
+
+TYPED_TEST(BlockIlu, FactorsBlockTridiagonalMatrixExactly)
+{
+    using value_type = typename TestFixture::value_type;
+
+    auto factors = this->factory->generate(this->block_tridiag);
+
+    auto l_factor = factors->get_l_factor();
+    auto u_factor = factors->get_u_factor();
+    ASSERT_EQ(l_factor->get_num_stored_blocks(), 5);
+    ASSERT_EQ(u_factor->get_num_stored_blocks(), 5);
+    // block tridiagonal matrices have no fill-in
+    GKO_ASSERT_MTX_NEAR(this->multiply(l_factor.get(), u_factor.get()),
+                        this->block_tridiag, r<value_type>::value);
+}
+
+
+TYPED_TEST(BlockIlu, IsScalarIluForBlockSizeOne)
+{
+    using Csr = typename TestFixture::Csr;
+    using value_type = typename TestFixture::value_type;
+    using index_type = typename TestFixture::index_type;
+    auto mtx = this->to_fbcsr(this->general_data, 1);
+    auto csr_mtx = gko::share(Csr::create(this->exec));
+    csr_mtx->read(this->general_data);
+
+    auto factors = this->factory->generate(mtx);
+    auto scalar_factors =
+        gko::factorization::Ilu<value_type, index_type>::build()
+            .on(this->exec)
+            ->generate(csr_mtx);
+
+    GKO_ASSERT_MTX_NEAR(factors->get_l_factor(),
+                        scalar_factors->get_l_factor(), r<value_type>::value);
+    GKO_ASSERT_MTX_NEAR(factors->get_u_factor(),
+                        scalar_factors->get_u_factor(), r<value_type>::value);
+}
+
+
+TYPED_TEST(BlockIlu, ConvertsCsrWithBlockSize)
+{
+    using Csr = typename TestFixture::Csr;
+    using block_ilu_type = typename TestFixture::block_ilu_type;
+    using value_type = typename TestFixture::value_type;
+    auto csr_mtx = gko::share(Csr::create(this->exec));
+    csr_mtx->read(this->block_tridiag_data);
+
+    auto factors = block_ilu_type::build()
+                       .with_block_size(2)
+                       .on(this->exec)
+                       ->generate(csr_mtx);
+    auto expected = this->factory->generate(this->block_tridiag);
+
+    ASSERT_EQ(factors->get_l_factor()->get_block_size(), 2);
+    GKO_ASSERT_MTX_NEAR(factors->get_l_factor(), expected->get_l_factor(),
+                        0.0);
+    GKO_ASSERT_MTX_NEAR(factors->get_u_factor(), expected->get_u_factor(),
+                        0.0);
+}
+
+
+TYPED_TEST(BlockIlu, SortsUnsortedMatrix)
+{
+    using value_type = typename TestFixture::value_type;
+    auto unsorted = gko::clone(this->exec, this->block_tridiag);
+    // swap the first and the last block of the second block row
+    const auto row_ptrs = unsorted->get_const_row_ptrs();
+    const auto first = row_ptrs[1];
+    const auto last = row_ptrs[2] - 1;
+    std::swap(unsorted->get_col_idxs()[first], unsorted->get_col_idxs()[last]);
+    std::swap_ranges(unsorted->get_values() + first * 4,
+                     unsorted->get_values() + (first + 1) * 4,
+                     unsorted->get_values() + last * 4);
+
+    auto factors = this->factory->generate(gko::share(std::move(unsorted)));
+    auto expected = this->factory->generate(this->block_tridiag);
+
+    GKO_ASSERT_MTX_NEAR(factors->get_l_factor(), expected->get_l_factor(),
+                        0.0);
+    GKO_ASSERT_MTX_NEAR(factors->get_u_factor(), expected->get_u_factor(),
+                        0.0);
+}
+
+
+TYPED_TEST(BlockIlu, AddsMissingDiagonalBlockToU)
+{
+    using value_type = typename TestFixture::value_type;
+    auto mtx = this->to_fbcsr({{0., 0., 1., 0.},
+                               {0., 0., 0., 1.},
+                               {1., 0., 2., 0.},
+                               {0., 1., 0., 2.}},
+                              2);
+
+    auto factors = this->factory->generate(mtx);
+
+    ASSERT_EQ(factors->get_l_factor()->get_num_stored_blocks(), 3);
+    ASSERT_EQ(factors->get_u_factor()->get_num_stored_blocks(), 3);
+    ASSERT_EQ(factors->get_u_factor()->get_const_col_idxs()[0], 0);
+}
+
+
+}  // namespace
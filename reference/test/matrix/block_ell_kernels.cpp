@@ -0,0 +1,247 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2022, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#include <ginkgo/core/matrix/block_ell.hpp>
+
+
+#include <gtest/gtest.h>
+
+
+#include <ginkgo/core/base/exception.hpp>
+#include <ginkgo/core/base/executor.hpp>
+#include <ginkgo/core/matrix/csr.hpp>
+#include <ginkgo/core/matrix/dense.hpp>
+
+
+#include "core/test/utils.hpp"
+
+
+namespace {
+
+
+template <typename ValueIndexType>
+class BlockEll : public ::testing::Test {
+protected:
+    using value_type =
+        typename std::tuple_element<0, decltype(ValueIndexType())>::type;
+    using index_type =
+        typename std::tuple_element<1, decltype(ValueIndexType())>::type;
+    using Mtx = gko::matrix::BlockEll<value_type, index_type>;
+    using Csr = gko::matrix::Csr<value_type, index_type>;
+    using Vec = gko::matrix::Dense<value_type>;
+
+    BlockEll()
+        : exec(gko::ReferenceExecutor::create()),
+          csr(gko::initialize<Csr>({{1.0, 2.0, 0.0, 0.0, 0.0, 4.0},
+                                    {3.0, 0.0, 0.0, 0.0, 5.0, 6.0},
+                                    {0.0, 0.0, 7.0, 8.0, 0.0, 0.0},
+                                    {0.0, 0.0, 0.0, 9.0, 0.0, 0.0}},
+                                   exec)),
+          mtx(Mtx::create(exec, 2))
+    {
+        csr->convert_to(mtx.get());
+    }
+
+    std::shared_ptr<const gko::ReferenceExecutor> exec;
+    std::unique_ptr<Csr> csr;
+    std::unique_ptr<Mtx> mtx;
+};
+
+TYPED_TEST_SUITE(BlockEll, gko::test::ValueIndexTypes,
+                 PairTypenameNameGenerator);
+
+
+TYPED_TEST(BlockEll, ConvertsFromCsr)
+{
+    using value_type = typename TestFixture::value_type;
+    using index_type = typename TestFixture::index_type;
+    auto c = this->mtx->get_const_col_idxs();
+    auto v = this->mtx->get_const_values();
+
+    ASSERT_EQ(this->mtx->get_size(), gko::dim<2>(4, 6));
+    ASSERT_EQ(this->mtx->get_block_size(), 2);
+    ASSERT_EQ(this->mtx->get_num_stored_blocks_per_row(), 2);
+    ASSERT_EQ(this->mtx->get_num_stored_elements(), 16);
+    EXPECT_EQ(c[0], 0);
+    EXPECT_EQ(c[1], 1);
+    EXPECT_EQ(c[2], 2);
+    EXPECT_EQ(c[3], gko::invalid_index<index_type>());
+    const value_type expected_vals[] = {1.0, 2.0, 3.0, 0.0, 7.0, 8.0,
+                                        0.0, 9.0, 0.0, 4.0, 5.0, 6.0};
+    for (int i = 0; i < 12; i++) {
+        EXPECT_EQ(v[i], expected_vals[i]);
+    }
+}
+
+
+TYPED_TEST(BlockEll, ConvertsFromCsrWithDetectedBlockSize)
+{
+    using Mtx = typename TestFixture::Mtx;
+    using Csr = typename TestFixture::Csr;
+    auto csr = gko::initialize<Csr>({{1.0, 2.0, 0.0, 0.0},
+                                     {3.0, 4.0, 0.0, 0.0},
+                                     {0.0, 0.0, 5.0, 6.0},
+                                     {0.0, 0.0, 7.0, 8.0}},
+                                    this->exec);
+    auto result = Mtx::create(this->exec);
+
+    csr->convert_to(result.get());
+
+    ASSERT_EQ(result->get_block_size(), 2);
+    ASSERT_EQ(result->get_num_stored_blocks_per_row(), 1);
+    GKO_ASSERT_MTX_NEAR(result, csr, 0.0);
+}
+
+
+TYPED_TEST(BlockEll, ConvertFromCsrThrowsOnNonConformantBlockSize)
+{
+    using Mtx = typename TestFixture::Mtx;
+    auto result = Mtx::create(this->exec, 4);
+
+    ASSERT_THROW(this->csr->convert_to(result.get()), gko::Error);
+}
+
+
+TYPED_TEST(BlockEll, ConvertsToCsr)
+{
+    using Csr = typename TestFixture::Csr;
+    auto result = Csr::create(this->exec);
+
+    this->mtx->convert_to(result.get());
+
+    // the conversion keeps the explicit zeros of the blocks
+    ASSERT_EQ(result->get_num_stored_elements(), 12);
+    GKO_ASSERT_MTX_NEAR(result, this->csr, 0.0);
+}
+
+
+TYPED_TEST(BlockEll, MovesToCsr)
+{
+    using Csr = typename TestFixture::Csr;
+    auto result = Csr::create(this->exec);
+
+    this->mtx->move_to(result.get());
+
+    GKO_ASSERT_MTX_NEAR(result, this->csr, 0.0);
+}
+
+
+TYPED_TEST(BlockEll, ConvertsToDense)
+{
+    using Vec = typename TestFixture::Vec;
+    auto result = Vec::create(this->exec);
+
+    this->mtx->convert_to(result.get());
+
+    GKO_ASSERT_MTX_NEAR(result,
+                        l({{1.0, 2.0, 0.0, 0.0, 0.0, 4.0},
+                           {3.0, 0.0, 0.0, 0.0, 5.0, 6.0},
+                           {0.0, 0.0, 7.0, 8.0, 0.0, 0.0},
+                           {0.0, 0.0, 0.0, 9.0, 0.0, 0.0}}),
+                        0.0);
+}
+
+
+TYPED_TEST(BlockEll, AppliesToDenseVector)
+{
+    using Vec = typename TestFixture::Vec;
+    auto b = gko::initialize<Vec>({1.0, 2.0, 3.0, 4.0, 5.0, 6.0}, this->exec);
+    auto x = Vec::create(this->exec, gko::dim<2>{4, 1});
+
+    this->mtx->apply(b.get(), x.get());
+
+    GKO_ASSERT_MTX_NEAR(x, l({29.0, 64.0, 53.0, 36.0}), 0.0);
+}
+
+
+TYPED_TEST(BlockEll, AppliesToDenseMatrix)
+{
+    using Vec = typename TestFixture::Vec;
+    using T = typename TestFixture::value_type;
+    auto b = gko::initialize<Vec>(
+        {I<T>{1.0, 0.0}, I<T>{2.0, 1.0}, I<T>{3.0, 0.0}, I<T>{4.0, 1.0},
+         I<T>{5.0, 0.0}, I<T>{6.0, 1.0}},
+        this->exec);
+    auto x = Vec::create(this->exec, gko::dim<2>{4, 2});
+
+    this->mtx->apply(b.get(), x.get());
+
+    GKO_ASSERT_MTX_NEAR(
+        x, l({{29.0, 6.0}, {64.0, 6.0}, {53.0, 8.0}, {36.0, 9.0}}), 0.0);
+}
+
+
+TYPED_TEST(BlockEll, AppliesLinearCombinationToDenseVector)
+{
+    using Vec = typename TestFixture::Vec;
+    auto alpha = gko::initialize<Vec>({-1.0}, this->exec);
+    auto beta = gko::initialize<Vec>({2.0}, this->exec);
+    auto b = gko::initialize<Vec>({1.0, 2.0, 3.0, 4.0, 5.0, 6.0}, this->exec);
+    auto x = gko::initialize<Vec>({1.0, 2.0, 3.0, 4.0}, this->exec);
+
+    this->mtx->apply(alpha.get(), b.get(), beta.get(), x.get());
+
+    GKO_ASSERT_MTX_NEAR(x, l({-27.0, -60.0, -47.0, -28.0}), 0.0);
+}
+
+
+TYPED_TEST(BlockEll, ApplyFailsOnWrongInnerDimension)
+{
+    using Vec = typename TestFixture::Vec;
+    auto b = Vec::create(this->exec, gko::dim<2>{4, 1});
+    auto x = Vec::create(this->exec, gko::dim<2>{4, 1});
+
+    ASSERT_THROW(this->mtx->apply(b.get(), x.get()), gko::DimensionMismatch);
+}
+
+
+TYPED_TEST(BlockEll, ReadsAndWritesMatrixData)
+{
+    using Mtx = typename TestFixture::Mtx;
+    using value_type = typename TestFixture::value_type;
+    using index_type = typename TestFixture::index_type;
+    gko::matrix_data<value_type, index_type> data;
+    gko::matrix_data<value_type, index_type> expected;
+    this->csr->write(expected);
+    auto result = Mtx::create(this->exec, 2);
+
+    result->read(expected);
+    result->write(data);
+    data.remove_zeros();
+
+    ASSERT_EQ(result->get_block_size(), 2);
+    ASSERT_EQ(data.size, expected.size);
+    ASSERT_EQ(data.nonzeros, expected.nonzeros);
+}
+
+
+}  // namespace
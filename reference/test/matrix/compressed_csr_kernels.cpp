@@ -0,0 +1,327 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2022, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#include <ginkgo/core/matrix/compressed_csr.hpp>
+
+
+#include <cstring>
+
+
+#include <gtest/gtest.h>
+
+
+#include <ginkgo/core/base/exception.hpp>
+#include <ginkgo/core/base/executor.hpp>
+#include <ginkgo/core/matrix/csr.hpp>
+#include <ginkgo/core/matrix/dense.hpp>
+
+
+#include "core/matrix/compressed_csr_kernels.hpp"
+#include "core/test/utils.hpp"
+
+
+namespace {
+
+
+// reads the k-th delta of a row from the byte-addressed delta storage
+template <typename DeltaType>
+DeltaType load_delta(const gko::uint64* row_words, gko::size_type k)
+{
+    DeltaType delta;
+    std::memcpy(&delta,
+                reinterpret_cast<const unsigned char*>(row_words) +
+                    k * sizeof(DeltaType),
+                sizeof(DeltaType));
+    return delta;
+}
+
+
+template <typename ValueIndexType>
+class CompressedCsr : public ::testing::Test {
+protected:
+    using value_type =
+        typename std::tuple_element<0, decltype(ValueIndexType())>::type;
+    using index_type =
+        typename std::tuple_element<1, decltype(ValueIndexType())>::type;
+    using Mtx = gko::matrix::CompressedCsr<value_type, index_type>;
+    using Csr = gko::matrix::Csr<value_type, index_type>;
+    using Vec = gko::matrix::Dense<value_type>;
+
+    CompressedCsr()
+        : exec(gko::ReferenceExecutor::create()),
+          csr(Csr::create(exec)),
+          mtx(Mtx::create(exec))
+    {
+        // the rows need 1, 2, 4 bytes per column delta, the last one is empty
+        csr->read(gko::matrix_data<value_type, index_type>{{4, 70000},
+                                                            {{0, 0, 1.0},
+                                                             {0, 1, 2.0},
+                                                             {0, 2, 3.0},
+                                                             {1, 5, 4.0},
+                                                             {1, 1000, 5.0},
+                                                             {2, 10, 6.0},
+                                                             {2, 69999, 7.0}}});
+        csr->convert_to(mtx.get());
+    }
+
+    std::unique_ptr<Vec> create_vector(gko::size_type num_cols)
+    {
+        auto vec = Vec::create(exec, gko::dim<2>{70000, num_cols});
+        for (gko::size_type row = 0; row < 70000; row++) {
+            for (gko::size_type col = 0; col < num_cols; col++) {
+                vec->at(row, col) = static_cast<value_type>(
+                    static_cast<double>((row + col) % 17) - 8.0);
+            }
+        }
+        return vec;
+    }
+
+    std::shared_ptr<const gko::ReferenceExecutor> exec;
+    std::unique_ptr<Csr> csr;
+    std::unique_ptr<Mtx> mtx;
+};
+
+TYPED_TEST_SUITE(CompressedCsr, gko::test::ValueIndexTypes,
+                 PairTypenameNameGenerator);
+
+
+TYPED_TEST(CompressedCsr, ConvertsFromCsrWithSmallestDeltaWidths)
+{
+    auto b = this->mtx->get_const_col_bases();
+    auto w = this->mtx->get_const_col_widths();
+    auto o = this->mtx->get_const_col_offsets();
+    auto d = this->mtx->get_const_col_deltas();
+
+    ASSERT_EQ(this->mtx->get_size(), gko::dim<2>(4, 70000));
+    ASSERT_EQ(this->mtx->get_num_stored_elements(), 7);
+    EXPECT_EQ(b[0], 0);
+    EXPECT_EQ(b[1], 5);
+    EXPECT_EQ(b[2], 10);
+    EXPECT_EQ(w[0], 1);
+    EXPECT_EQ(w[1], 2);
+    EXPECT_EQ(w[2], 4);
+    EXPECT_EQ(o[0], 0);
+    EXPECT_EQ(o[1], 1);
+    EXPECT_EQ(o[2], 2);
+    EXPECT_EQ(o[3], 3);
+    EXPECT_EQ(o[4], 3);
+    EXPECT_EQ(load_delta<gko::uint8>(d, 2), 2);
+    EXPECT_EQ(load_delta<gko::uint16>(d + 1, 1), 995);
+    EXPECT_EQ(load_delta<gko::uint32>(d + 2, 1), 69989);
+}
+
+
+TYPED_TEST(CompressedCsr, KeepsValuesAndRowPointers)
+{
+    auto v = this->mtx->get_const_values();
+    auto r = this->mtx->get_const_row_ptrs();
+
+    EXPECT_EQ(r[0], 0);
+    EXPECT_EQ(r[1], 3);
+    EXPECT_EQ(r[2], 5);
+    EXPECT_EQ(r[3], 7);
+    EXPECT_EQ(r[4], 7);
+    for (int i = 0; i < 7; i++) {
+        EXPECT_EQ(v[i], static_cast<typename TestFixture::value_type>(i + 1));
+    }
+}
+
+
+TYPED_TEST(CompressedCsr, ConvertsUnsortedCsr)
+{
+    using Csr = typename TestFixture::Csr;
+    using Mtx = typename TestFixture::Mtx;
+    auto csr = Csr::create(this->exec, gko::dim<2>{1, 5}, 3);
+    csr->get_row_ptrs()[0] = 0;
+    csr->get_row_ptrs()[1] = 3;
+    csr->get_col_idxs()[0] = 3;
+    csr->get_col_idxs()[1] = 1;
+    csr->get_col_idxs()[2] = 4;
+    csr->get_values()[0] = 1.0;
+    csr->get_values()[1] = 2.0;
+    csr->get_values()[2] = 3.0;
+    auto mtx = Mtx::create(this->exec);
+    auto result = Csr::create(this->exec);
+
+    csr->convert_to(mtx.get());
+    mtx->convert_to(result.get());
+
+    EXPECT_EQ(mtx->get_const_col_bases()[0], 1);
+    GKO_ASSERT_MTX_EQ_SPARSITY(result, csr);
+    GKO_ASSERT_MTX_NEAR(result, csr, 0.0);
+}
+
+
+TYPED_TEST(CompressedCsr, ConvertsToCsr)
+{
+    using Csr = typename TestFixture::Csr;
+    auto result = Csr::create(this->exec);
+
+    this->mtx->convert_to(result.get());
+
+    GKO_ASSERT_MTX_EQ_SPARSITY(result, this->csr);
+    GKO_ASSERT_MTX_NEAR(result, this->csr, 0.0);
+}
+
+
+TYPED_TEST(CompressedCsr, MovesToCsr)
+{
+    using Csr = typename TestFixture::Csr;
+    auto result = Csr::create(this->exec);
+
+    this->mtx->move_to(result.get());
+
+    GKO_ASSERT_MTX_EQ_SPARSITY(result, this->csr);
+    GKO_ASSERT_MTX_NEAR(result, this->csr, 0.0);
+}
+
+
+TYPED_TEST(CompressedCsr, ConvertsToDense)
+{
+    using Csr = typename TestFixture::Csr;
+    using Mtx = typename TestFixture::Mtx;
+    using Vec = typename TestFixture::Vec;
+    // clang-format off
+    auto csr = gko::initialize<Csr>({{1.0, 0.0, 2.0},
+                                     {0.0, 3.0, 0.0},
+                                     {0.0, 0.0, 4.0}}, this->exec);
+    // clang-format on
+    auto mtx = Mtx::create(this->exec);
+    auto result = Vec::create(this->exec);
+    csr->convert_to(mtx.get());
+
+    mtx->convert_to(result.get());
+
+    GKO_ASSERT_MTX_NEAR(result, csr, 0.0);
+}
+
+
+TYPED_TEST(CompressedCsr, ConvertsEmptyMatrix)
+{
+    using Csr = typename TestFixture::Csr;
+    using Mtx = typename TestFixture::Mtx;
+    auto csr = Csr::create(this->exec);
+    auto mtx = Mtx::create(this->exec);
+    auto result = Csr::create(this->exec);
+
+    csr->convert_to(mtx.get());
+    mtx->convert_to(result.get());
+
+    ASSERT_EQ(mtx->get_num_stored_elements(), 0);
+    ASSERT_EQ(result->get_size(), gko::dim<2>{});
+    ASSERT_EQ(result->get_num_stored_elements(), 0);
+}
+
+
+TYPED_TEST(CompressedCsr, AppliesToDenseVector)
+{
+    using Vec = typename TestFixture::Vec;
+    auto x = this->create_vector(1);
+    auto y = Vec::create(this->exec, gko::dim<2>{4, 1});
+    auto expected = y->clone();
+
+    this->mtx->apply(x.get(), y.get());
+
+    this->csr->apply(x.get(), expected.get());
+    GKO_ASSERT_MTX_NEAR(y, expected, 0.0);
+}
+
+
+TYPED_TEST(CompressedCsr, AppliesToDenseMatrix)
+{
+    using Vec = typename TestFixture::Vec;
+    auto x = this->create_vector(3);
+    auto y = Vec::create(this->exec, gko::dim<2>{4, 3});
+    auto expected = y->clone();
+
+    this->mtx->apply(x.get(), y.get());
+
+    this->csr->apply(x.get(), expected.get());
+    GKO_ASSERT_MTX_NEAR(y, expected, 0.0);
+}
+
+
+TYPED_TEST(CompressedCsr, AppliesLinearCombinationToDenseMatrix)
+{
+    using Vec = typename TestFixture::Vec;
+    using T = typename TestFixture::value_type;
+    auto alpha = gko::initialize<Vec>({-1.0}, this->exec);
+    auto beta = gko::initialize<Vec>({2.0}, this->exec);
+    auto x = this->create_vector(2);
+    auto y = gko::initialize<Vec>(
+        {I<T>{1.0, 2.0}, I<T>{3.0, 4.0}, I<T>{5.0, 6.0}, I<T>{7.0, 8.0}},
+        this->exec);
+    auto expected = y->clone();
+
+    this->mtx->apply(alpha.get(), x.get(), beta.get(), y.get());
+
+    this->csr->apply(alpha.get(), x.get(), beta.get(), expected.get());
+    GKO_ASSERT_MTX_NEAR(y, expected, 0.0);
+}
+
+
+TYPED_TEST(CompressedCsr, ApplyFailsOnWrongInnerDimension)
+{
+    using Vec = typename TestFixture::Vec;
+    auto x = Vec::create(this->exec, gko::dim<2>{2});
+    auto y = Vec::create(this->exec, gko::dim<2>{4});
+
+    ASSERT_THROW(this->mtx->apply(x.get(), y.get()), gko::DimensionMismatch);
+}
+
+
+TEST(CompressedCsrWideRows, UsesEightByteDeltas)
+{
+    using Csr = gko::matrix::Csr<double, gko::int64>;
+    using Mtx = gko::matrix::CompressedCsr<double, gko::int64>;
+    auto exec = gko::ReferenceExecutor::create();
+    const gko::int64 num_cols = gko::int64{1} << 33;
+    auto csr = Csr::create(exec, gko::dim<2>{1, num_cols}, 2);
+    csr->get_row_ptrs()[0] = 0;
+    csr->get_row_ptrs()[1] = 2;
+    csr->get_col_idxs()[0] = 1;
+    csr->get_col_idxs()[1] = num_cols - 1;
+    csr->get_values()[0] = 1.0;
+    csr->get_values()[1] = 2.0;
+    auto mtx = Mtx::create(exec);
+    auto result = Csr::create(exec);
+
+    csr->convert_to(mtx.get());
+    mtx->convert_to(result.get());
+
+    EXPECT_EQ(mtx->get_const_col_widths()[0], 8);
+    EXPECT_EQ(mtx->get_const_col_offsets()[1], 2);
+    GKO_ASSERT_MTX_EQ_SPARSITY(result, csr);
+}
+
+
+}  // namespace
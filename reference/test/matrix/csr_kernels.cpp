@@ -383,6 +383,36 @@ TYPED_TEST(Csr, AppliesToMixedDenseVector)
 }
 
 
+TYPED_TEST(Csr, AppliesMixedDenseVectorToDenseVector)
+{
+    using Vec = typename TestFixture::Vec;
+    using MixedVec = typename TestFixture::MixedVec;
+    using T = typename TestFixture::value_type;
+    auto x = gko::initialize<MixedVec>({2.0, 1.0, 4.0}, this->exec);
+    auto y = Vec::create(this->exec, gko::dim<2>{2, 1});
+
+    this->mtx->apply(x.get(), y.get());
+
+    EXPECT_EQ(y->at(0), T{13.0});
+    EXPECT_EQ(y->at(1), T{5.0});
+}
+
+
+TYPED_TEST(Csr, AppliesDenseVectorToMixedDenseVector)
+{
+    using Vec = typename TestFixture::Vec;
+    using MixedVec = typename TestFixture::MixedVec;
+    using MixedT = typename MixedVec::value_type;
+    auto x = gko::initialize<Vec>({2.0, 1.0, 4.0}, this->exec);
+    auto y = MixedVec::create(this->exec, gko::dim<2>{2, 1});
+
+    this->mtx->apply(x.get(), y.get());
+
+    EXPECT_EQ(y->at(0), MixedT{13.0});
+    EXPECT_EQ(y->at(1), MixedT{5.0});
+}
+
+
 TYPED_TEST(Csr, AppliesToDenseMatrix)
 {
     using Vec = typename TestFixture::Vec;
@@ -432,6 +462,23 @@ TYPED_TEST(Csr, AppliesLinearCombinationToMixedDenseVector)
 }
 
 
+TYPED_TEST(Csr, AppliesLinearCombinationOfMixedDenseVectorToDenseVector)
+{
+    using Vec = typename TestFixture::Vec;
+    using MixedVec = typename TestFixture::MixedVec;
+    using T = typename TestFixture::value_type;
+    auto alpha = gko::initialize<Vec>({-1.0}, this->exec);
+    auto beta = gko::initialize<MixedVec>({2.0}, this->exec);
+    auto x = gko::initialize<MixedVec>({2.0, 1.0, 4.0}, this->exec);
+    auto y = gko::initialize<Vec>({1.0, 2.0}, this->exec);
+
+    this->mtx->apply(alpha.get(), x.get(), beta.get(), y.get());
+
+    EXPECT_EQ(y->at(0), T{-11.0});
+    EXPECT_EQ(y->at(1), T{-1.0});
+}
+
+
 TYPED_TEST(Csr, AppliesLinearCombinationToDenseMatrix)
 {
     using Vec = typename TestFixture::Vec;
@@ -483,6 +530,63 @@ TYPED_TEST(Csr, AppliesToCsrMatrix)
 }
 
 
+TYPED_TEST(Csr, MultipliesWithCsrMatrixMasked)
+{
+    using Mtx = typename TestFixture::Mtx;
+    using T = typename TestFixture::value_type;
+    using index_type = typename TestFixture::index_type;
+    // the full product is
+    // 13  5 31
+    // 15  5 40
+    auto result = Mtx::create(this->exec);
+    result->read(gko::matrix_data<T, index_type>{
+        gko::dim<2>{2, 3}, {{0, 0, 1.0}, {0, 2, 2.0}, {1, 1, 3.0}}});
+
+    this->mtx->multiply_masked(this->mtx3_unsorted.get(), result.get());
+
+    ASSERT_EQ(result->get_num_stored_elements(), 3);
+    auto c = result->get_const_col_idxs();
+    auto v = result->get_const_values();
+    EXPECT_EQ(c[0], 0);
+    EXPECT_EQ(c[1], 2);
+    EXPECT_EQ(c[2], 1);
+    EXPECT_EQ(v[0], T{13});
+    EXPECT_EQ(v[1], T{31});
+    EXPECT_EQ(v[2], T{5});
+}
+
+
+TYPED_TEST(Csr, MultiplyMaskedSetsEntriesWithoutContributionsToZero)
+{
+    using Mtx = typename TestFixture::Mtx;
+    using T = typename TestFixture::value_type;
+    using index_type = typename TestFixture::index_type;
+    auto b = Mtx::create(this->exec);
+    b->read(gko::matrix_data<T, index_type>{gko::dim<2>{3, 3}, {{0, 0, 1.0}}});
+    auto result = Mtx::create(this->exec);
+    result->read(gko::matrix_data<T, index_type>{
+        gko::dim<2>{2, 3}, {{0, 0, 7.0}, {0, 1, 7.0}, {1, 2, 7.0}}});
+
+    this->mtx->multiply_masked(b.get(), result.get());
+
+    auto v = result->get_const_values();
+    EXPECT_EQ(v[0], T{1});
+    EXPECT_EQ(v[1], T{0});
+    EXPECT_EQ(v[2], T{0});
+}
+
+
+TYPED_TEST(Csr, MultiplyMaskedFailsForWrongDimensions)
+{
+    using Mtx = typename TestFixture::Mtx;
+    auto result = Mtx::create(this->exec, gko::dim<2>{3, 3});
+
+    ASSERT_THROW(
+        this->mtx->multiply_masked(this->mtx3_unsorted.get(), result.get()),
+        gko::DimensionMismatch);
+}
+
+
 TYPED_TEST(Csr, AppliesLinearCombinationToCsrMatrix)
 {
     using Vec = typename TestFixture::Vec;
@@ -768,6 +768,132 @@ TYPED_TEST(Sellp, AdvancedAppliesToMixedComplex)
 }
 
 
+TYPED_TEST(Sellp, ConvertsFromCsrWithSortingWindow)
+{
+    using Mtx = typename TestFixture::Mtx;
+    using Csr = typename TestFixture::Csr;
+    // clang-format off
+    auto csr = gko::initialize<Csr>({{1.0, 0.0, 0.0, 0.0},
+                                     {2.0, 3.0, 4.0, 0.0},
+                                     {0.0, 5.0, 0.0, 0.0},
+                                     {6.0, 7.0, 8.0, 9.0}}, this->exec);
+    // clang-format on
+    auto sellp = Mtx::create(this->exec, gko::dim<2>{}, 2, 1, 0, 4);
+
+    csr->convert_to(sellp.get());
+
+    ASSERT_EQ(sellp->get_sorting_window(), 4);
+    ASSERT_NE(sellp->get_const_permutation(), nullptr);
+    auto perm = sellp->get_const_permutation();
+    EXPECT_EQ(perm[0], 3);
+    EXPECT_EQ(perm[1], 1);
+    EXPECT_EQ(perm[2], 0);
+    EXPECT_EQ(perm[3], 2);
+    EXPECT_EQ(sellp->get_const_slice_lengths()[0], 4);
+    EXPECT_EQ(sellp->get_const_slice_lengths()[1], 1);
+    EXPECT_EQ(sellp->get_total_cols(), 5);
+    GKO_ASSERT_MTX_NEAR(sellp, csr, 0.0);
+}
+
+
+TYPED_TEST(Sellp, AppliesWithSortingWindow)
+{
+    using Mtx = typename TestFixture::Mtx;
+    using Vec = typename TestFixture::Vec;
+    using T = typename TestFixture::value_type;
+    using index_type = typename TestFixture::index_type;
+    auto sellp = Mtx::create(this->exec, gko::dim<2>{}, 2, 1, 0, 4);
+    // clang-format off
+    sellp->read(gko::matrix_data<T, index_type>{
+        {3, 3}, {{0, 0, 1.0}, {1, 1, 5.0},
+                 {2, 0, 2.0}, {2, 1, 1.0}, {2, 2, -1.0}}});
+    auto x = gko::initialize<Vec>(
+        {I<T>{2.0, 3.0},
+         I<T>{1.0, -1.5},
+         I<T>{4.0, 2.5}}, this->exec);
+    // clang-format on
+    auto y = Vec::create(this->exec, gko::dim<2>{3, 2});
+
+    sellp->apply(x.get(), y.get());
+
+    ASSERT_NE(sellp->get_const_permutation(), nullptr);
+    // clang-format off
+    GKO_ASSERT_MTX_NEAR(y,
+                        l({{2.0,  3.0},
+                           {5.0, -7.5},
+                           {1.0,  2.0}}), 0.0);
+    // clang-format on
+}
+
+
+TYPED_TEST(Sellp, AppliesLinearCombinationWithSortingWindow)
+{
+    using Mtx = typename TestFixture::Mtx;
+    using Vec = typename TestFixture::Vec;
+    using T = typename TestFixture::value_type;
+    using index_type = typename TestFixture::index_type;
+    auto sellp = Mtx::create(this->exec, gko::dim<2>{}, 2, 1, 0, 4);
+    // clang-format off
+    sellp->read(gko::matrix_data<T, index_type>{
+        {3, 3}, {{0, 0, 1.0}, {1, 1, 5.0},
+                 {2, 0, 2.0}, {2, 1, 1.0}, {2, 2, -1.0}}});
+    // clang-format on
+    auto alpha = gko::initialize<Vec>({-1.0}, this->exec);
+    auto beta = gko::initialize<Vec>({2.0}, this->exec);
+    auto x = gko::initialize<Vec>({2.0, 1.0, 4.0}, this->exec);
+    auto y = gko::initialize<Vec>({1.0, 2.0, 3.0}, this->exec);
+
+    sellp->apply(alpha.get(), x.get(), beta.get(), y.get());
+
+    GKO_ASSERT_MTX_NEAR(y, l({0.0, -1.0, 5.0}), 0.0);
+}
+
+
+TYPED_TEST(Sellp, ConvertsWithSortingWindowToCsrAndDense)
+{
+    using Mtx = typename TestFixture::Mtx;
+    using Csr = typename TestFixture::Csr;
+    using Vec = typename TestFixture::Vec;
+    auto sellp = Mtx::create(this->exec, gko::dim<2>{}, 2, 1, 0, 4);
+    // clang-format off
+    auto dense = gko::initialize<Vec>({{1.0, 0.0, 0.0},
+                                       {0.0, 5.0, 0.0},
+                                       {2.0, 1.0, -1.0}}, this->exec);
+    // clang-format on
+    dense->convert_to(sellp.get());
+    auto csr = Csr::create(this->exec);
+    auto result = Vec::create(this->exec);
+
+    sellp->convert_to(csr.get());
+    sellp->convert_to(result.get());
+
+    ASSERT_NE(sellp->get_const_permutation(), nullptr);
+    GKO_ASSERT_MTX_NEAR(csr, dense, 0.0);
+    GKO_ASSERT_MTX_NEAR(result, dense, 0.0);
+}
+
+
+TYPED_TEST(Sellp, ExtractsDiagonalWithSortingWindow)
+{
+    using Mtx = typename TestFixture::Mtx;
+    using T = typename TestFixture::value_type;
+    using index_type = typename TestFixture::index_type;
+    auto sellp = Mtx::create(this->exec, gko::dim<2>{}, 2, 1, 0, 4);
+    // clang-format off
+    sellp->read(gko::matrix_data<T, index_type>{
+        {3, 3}, {{0, 0, 1.0}, {1, 1, 5.0},
+                 {2, 0, 2.0}, {2, 1, 1.0}, {2, 2, -1.0}}});
+    // clang-format on
+
+    auto diag = sellp->extract_diagonal();
+
+    ASSERT_EQ(diag->get_size()[0], 3);
+    ASSERT_EQ(diag->get_values()[0], T{1.});
+    ASSERT_EQ(diag->get_values()[1], T{5.});
+    ASSERT_EQ(diag->get_values()[2], T{-1.});
+}
+
+
 template <typename ValueIndexType>
 class SellpComplex : public ::testing::Test {
 protected:
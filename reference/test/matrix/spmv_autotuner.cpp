@@ -0,0 +1,319 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2022, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#include <ginkgo/core/matrix/spmv_autotuner.hpp>
+
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+
+#include <gtest/gtest.h>
+
+
+#include <ginkgo/core/base/exception.hpp>
+#include <ginkgo/core/base/executor.hpp>
+#include <ginkgo/core/matrix/coo.hpp>
+#include <ginkgo/core/matrix/csr.hpp>
+#include <ginkgo/core/matrix/dense.hpp>
+#include <ginkgo/core/matrix/ell.hpp>
+
+
+#include "core/test/utils.hpp"
+
+
+namespace {
+
+
+template <typename ValueIndexType>
+class SpmvAutotuner : public ::testing::Test {
+protected:
+    using value_type =
+        typename std::tuple_element<0, decltype(ValueIndexType())>::type;
+    using index_type =
+        typename std::tuple_element<1, decltype(ValueIndexType())>::type;
+    using Tuner = gko::matrix::SpmvAutotuner<value_type, index_type>;
+    using Csr = gko::matrix::Csr<value_type, index_type>;
+    using Vec = gko::matrix::Dense<value_type>;
+    using mat_data = gko::matrix_data<value_type, index_type>;
+
+    SpmvAutotuner()
+        : exec(gko::ReferenceExecutor::create()),
+          cache_file("spmv_autotuner_test_cache.txt")
+    {}
+
+    ~SpmvAutotuner() { std::remove(cache_file.c_str()); }
+
+    // creates a matrix with the given number of nonzeros in each row
+    std::unique_ptr<Csr> create_matrix(const std::vector<int>& row_lengths,
+                                       gko::size_type num_cols)
+    {
+        mat_data data{gko::dim<2>{row_lengths.size(), num_cols}};
+        for (gko::size_type row = 0; row < row_lengths.size(); row++) {
+            for (int i = 0; i < row_lengths[row]; i++) {
+                data.nonzeros.emplace_back(
+                    row, (row + 3 * i) % num_cols,
+                    static_cast<value_type>(static_cast<double>(row + i)));
+            }
+        }
+        data.ensure_row_major_order();
+        auto mtx = Csr::create(exec);
+        mtx->read(data);
+        return mtx;
+    }
+
+    std::unique_ptr<Csr> create_uniform(int size)
+    {
+        std::vector<int> row_lengths(size, 3);
+        return create_matrix(row_lengths, size);
+    }
+
+    void assert_applies_like(const gko::LinOp* tuned, const Csr* mtx)
+    {
+        auto b = gko::test::generate_random_matrix<Vec>(
+            mtx->get_size()[1], 2, std::uniform_int_distribution<>(2, 2),
+            std::normal_distribution<>(0.0, 1.0), std::default_random_engine{},
+            exec);
+        auto x = Vec::create(exec, gko::dim<2>{mtx->get_size()[0], 2});
+        auto expected = x->clone();
+
+        tuned->apply(b.get(), x.get());
+        mtx->apply(b.get(), expected.get());
+
+        GKO_ASSERT_MTX_NEAR(x, expected, r<value_type>::value);
+    }
+
+    std::shared_ptr<const gko::ReferenceExecutor> exec;
+    std::string cache_file;
+};
+
+TYPED_TEST_SUITE(SpmvAutotuner, gko::test::ValueIndexTypes,
+                 PairTypenameNameGenerator);
+
+
+TYPED_TEST(SpmvAutotuner, ComputesFeatures)
+{
+    using Tuner = typename TestFixture::Tuner;
+    auto mtx = this->create_matrix({2, 0, 3, 1}, 4);
+
+    auto features = Tuner::compute_features(mtx.get());
+
+    ASSERT_EQ(features.num_rows, 4);
+    ASSERT_EQ(features.num_cols, 4);
+    ASSERT_EQ(features.num_nonzeros, 6);
+    ASSERT_EQ(features.num_empty_rows, 1);
+    ASSERT_EQ(features.max_row_nonzeros, 3);
+    ASSERT_DOUBLE_EQ(features.mean_row_nonzeros, 1.5);
+    ASSERT_DOUBLE_EQ(features.row_nonzeros_deviation, std::sqrt(1.25));
+    ASSERT_DOUBLE_EQ(features.ell_padding, 2.0);
+    // the only slice has 64 rows of length 3
+    ASSERT_DOUBLE_EQ(features.sellp_padding, 32.0);
+}
+
+
+TYPED_TEST(SpmvAutotuner, SimilarMatricesShareKey)
+{
+    using Tuner = typename TestFixture::Tuner;
+    auto mtx1 = this->create_uniform(1000);
+    auto mtx2 = this->create_uniform(1010);
+    auto mtx3 = this->create_uniform(100);
+
+    auto key1 = Tuner::compute_features(mtx1.get()).get_key();
+    auto key2 = Tuner::compute_features(mtx2.get()).get_key();
+    auto key3 = Tuner::compute_features(mtx3.get()).get_key();
+
+    ASSERT_EQ(key1, key2);
+    ASSERT_NE(key1, key3);
+}
+
+
+TYPED_TEST(SpmvAutotuner, ModelChoosesEllForUniformRows)
+{
+    using Tuner = typename TestFixture::Tuner;
+    using Ell = gko::matrix::Ell<typename TestFixture::value_type,
+                                 typename TestFixture::index_type>;
+    auto mtx = this->create_uniform(100);
+    Tuner tuner{this->exec, gko::matrix::spmv_tuning_mode::model};
+
+    auto tuned = tuner.tune(mtx.get());
+
+    ASSERT_EQ(tuner.get_last_format(), "ell");
+    ASSERT_NE(dynamic_cast<const Ell*>(tuned.get()), nullptr);
+    ASSERT_TRUE(tuner.get_last_timings().empty());
+    this->assert_applies_like(tuned.get(), mtx.get());
+}
+
+
+TYPED_TEST(SpmvAutotuner, ModelChoosesCooForMostlyEmptyRows)
+{
+    using Tuner = typename TestFixture::Tuner;
+    std::vector<int> row_lengths(100, 0);
+    for (int i = 0; i < 10; i++) {
+        row_lengths[10 * i] = i + 1;
+    }
+    auto mtx = this->create_matrix(row_lengths, 100);
+    Tuner tuner{this->exec, gko::matrix::spmv_tuning_mode::model};
+
+    auto tuned = tuner.tune(mtx.get());
+
+    ASSERT_EQ(tuner.get_last_format(), "coo");
+    this->assert_applies_like(tuned.get(), mtx.get());
+}
+
+
+TYPED_TEST(SpmvAutotuner, ModelChoosesCsrForIrregularRows)
+{
+    using Tuner = typename TestFixture::Tuner;
+    std::vector<int> row_lengths(200);
+    for (int i = 0; i < 200; i++) {
+        row_lengths[i] = 1 + i % 5;
+    }
+    auto mtx = this->create_matrix(row_lengths, 200);
+    Tuner tuner{this->exec, gko::matrix::spmv_tuning_mode::model};
+
+    auto tuned = tuner.tune(mtx.get());
+
+    ASSERT_EQ(tuner.get_last_format(), "csr");
+    this->assert_applies_like(tuned.get(), mtx.get());
+}
+
+
+TYPED_TEST(SpmvAutotuner, ConvertsToAllCandidates)
+{
+    using Tuner = typename TestFixture::Tuner;
+    auto mtx = this->create_matrix({2, 0, 3, 1, 7, 1, 1, 2}, 10);
+    Tuner tuner{this->exec};
+
+    for (const auto& format : tuner.get_candidates()) {
+        SCOPED_TRACE(format);
+        auto converted = tuner.convert(mtx.get(), format);
+
+        ASSERT_EQ(converted->get_executor(), this->exec);
+        this->assert_applies_like(converted.get(), mtx.get());
+    }
+}
+
+
+TYPED_TEST(SpmvAutotuner, ThrowsOnUnknownFormat)
+{
+    using Tuner = typename TestFixture::Tuner;
+    auto mtx = this->create_uniform(10);
+    Tuner tuner{this->exec};
+
+    ASSERT_THROW(tuner.convert(mtx.get(), "dense"), gko::NotSupported);
+    ASSERT_THROW(tuner.convert(mtx.get(), "csr_unknown"), gko::NotSupported);
+}
+
+
+TYPED_TEST(SpmvAutotuner, TrialsTimeAllCandidates)
+{
+    using Tuner = typename TestFixture::Tuner;
+    auto mtx = this->create_uniform(100);
+    Tuner tuner{this->exec, gko::matrix::spmv_tuning_mode::trial, 2};
+
+    auto tuned = tuner.tune(mtx.get());
+
+    ASSERT_FALSE(tuner.last_from_cache());
+    ASSERT_EQ(tuner.get_last_timings().size(), tuner.get_candidates().size());
+    ASSERT_EQ(tuner.get_last_timings().count(tuner.get_last_format()), 1);
+    for (const auto& timing : tuner.get_last_timings()) {
+        ASSERT_GE(timing.second,
+                  tuner.get_last_timings().at(tuner.get_last_format()));
+    }
+    this->assert_applies_like(tuned.get(), mtx.get());
+}
+
+
+TYPED_TEST(SpmvAutotuner, PersistsDecisionsInCacheFile)
+{
+    using Tuner = typename TestFixture::Tuner;
+    auto mtx = this->create_uniform(100);
+    auto similar_mtx = this->create_uniform(101);
+    Tuner tuner{this->exec, gko::matrix::spmv_tuning_mode::trial, 2};
+    tuner.set_cache_file(this->cache_file);
+    tuner.tune(mtx.get());
+    Tuner cached_tuner{this->exec, gko::matrix::spmv_tuning_mode::trial, 2};
+
+    cached_tuner.set_cache_file(this->cache_file);
+    auto tuned = cached_tuner.tune(similar_mtx.get());
+
+    ASSERT_EQ(cached_tuner.get_cache(), tuner.get_cache());
+    ASSERT_TRUE(cached_tuner.last_from_cache());
+    ASSERT_EQ(cached_tuner.get_last_format(), tuner.get_last_format());
+    ASSERT_TRUE(cached_tuner.get_last_timings().empty());
+    this->assert_applies_like(tuned.get(), similar_mtx.get());
+}
+
+
+TYPED_TEST(SpmvAutotuner, CacheKeyDependsOnExecutorAndNumberOfRhs)
+{
+    using Tuner = typename TestFixture::Tuner;
+    auto features = Tuner::compute_features(this->create_uniform(100).get());
+    Tuner tuner{this->exec, gko::matrix::spmv_tuning_mode::trial, 2, 1};
+    Tuner multi_rhs_tuner{this->exec, gko::matrix::spmv_tuning_mode::trial, 2,
+                          4};
+    Tuner omp_tuner{gko::OmpExecutor::create(),
+                    gko::matrix::spmv_tuning_mode::trial, 2, 1};
+
+    auto key = tuner.get_cache_key(features);
+
+    ASSERT_NE(key, multi_rhs_tuner.get_cache_key(features));
+    ASSERT_NE(key, omp_tuner.get_cache_key(features));
+    ASSERT_NE(key.find(features.get_key()), std::string::npos);
+}
+
+
+TYPED_TEST(SpmvAutotuner, ModelUsesCachedDecisions)
+{
+    using Tuner = typename TestFixture::Tuner;
+    auto mtx = this->create_uniform(100);
+    Tuner tuner{this->exec, gko::matrix::spmv_tuning_mode::model};
+    auto key = tuner.get_cache_key(Tuner::compute_features(mtx.get()));
+    {
+        std::ofstream stream{this->cache_file};
+        stream << key << " sellp\n";
+    }
+
+    tuner.set_cache_file(this->cache_file);
+    auto tuned = tuner.tune(mtx.get());
+
+    ASSERT_TRUE(tuner.last_from_cache());
+    ASSERT_EQ(tuner.get_last_format(), "sellp");
+    this->assert_applies_like(tuned.get(), mtx.get());
+}
+
+
+}  // namespace
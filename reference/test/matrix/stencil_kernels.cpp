@@ -0,0 +1,281 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2022, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#include <ginkgo/core/matrix/stencil.hpp>
+
+
+#include <gtest/gtest.h>
+
+
+#include <ginkgo/core/base/exception.hpp>
+#include <ginkgo/core/base/executor.hpp>
+#include <ginkgo/core/matrix/csr.hpp>
+#include <ginkgo/core/matrix/dense.hpp>
+
+
+#include "core/matrix/stencil_kernels.hpp"
+#include "core/test/utils.hpp"
+
+
+namespace {
+
+
+template <typename ValueIndexType>
+class Stencil : public ::testing::Test {
+protected:
+    using value_type =
+        typename std::tuple_element<0, decltype(ValueIndexType())>::type;
+    using index_type =
+        typename std::tuple_element<1, decltype(ValueIndexType())>::type;
+    using Mtx = gko::matrix::Stencil<value_type, index_type>;
+    using Csr = gko::matrix::Csr<value_type, index_type>;
+    using Vec = gko::matrix::Dense<value_type>;
+
+    Stencil()
+        : exec(gko::ReferenceExecutor::create()),
+          // 5-point Laplacian on a 3 x 2 grid
+          mtx(Mtx::create(
+              exec, gko::dim<3>{3, 2, 1},
+              gko::array<index_type>{
+                  exec, {0, 0, 0, -1, 0, 0, 1, 0, 0, 0, -1, 0, 0, 1, 0}},
+              gko::array<value_type>{exec, {4.0, -1.0, -1.0, -1.0, -1.0}})),
+          // 7-point stencil with variable coefficients on a 4 x 3 x 2 grid
+          mtx3d(create_variable_stencil())
+    {}
+
+    std::unique_ptr<Mtx> create_variable_stencil()
+    {
+        const gko::size_type num_rows = 24;
+        gko::array<value_type> coeffs{exec, 7 * num_rows};
+        for (gko::size_type i = 0; i < coeffs.get_num_elems(); i++) {
+            coeffs.get_data()[i] =
+                static_cast<value_type>(static_cast<double>(i % 11) - 5.0);
+        }
+        return Mtx::create(
+            exec, gko::dim<3>{4, 3, 2},
+            gko::array<index_type>{exec, {0, 0, 0, -1, 0, 0, 1, 0, 0, 0, -1,
+                                          0, 0, 1, 0, 0, 0, -1, 0, 0, 1}},
+            std::move(coeffs));
+    }
+
+    std::unique_ptr<Vec> create_vector(gko::size_type num_rows,
+                                       gko::size_type num_cols)
+    {
+        auto vec = Vec::create(exec, gko::dim<2>{num_rows, num_cols});
+        for (gko::size_type row = 0; row < num_rows; row++) {
+            for (gko::size_type col = 0; col < num_cols; col++) {
+                vec->at(row, col) = static_cast<value_type>(
+                    static_cast<double>((3 * row + col) % 7) - 3.0);
+            }
+        }
+        return vec;
+    }
+
+    std::shared_ptr<const gko::ReferenceExecutor> exec;
+    std::unique_ptr<Mtx> mtx;
+    std::unique_ptr<Mtx> mtx3d;
+};
+
+TYPED_TEST_SUITE(Stencil, gko::test::ValueIndexTypes,
+                 PairTypenameNameGenerator);
+
+
+TYPED_TEST(Stencil, ConvertsToCsr)
+{
+    using Csr = typename TestFixture::Csr;
+    using value_type = typename TestFixture::value_type;
+    auto csr = Csr::create(this->exec);
+
+    this->mtx->convert_to(csr.get());
+
+    GKO_ASSERT_MTX_NEAR(csr,
+                        l<value_type>({{4.0, -1.0, 0.0, -1.0, 0.0, 0.0},
+                                       {-1.0, 4.0, -1.0, 0.0, -1.0, 0.0},
+                                       {0.0, -1.0, 4.0, 0.0, 0.0, -1.0},
+                                       {-1.0, 0.0, 0.0, 4.0, -1.0, 0.0},
+                                       {0.0, -1.0, 0.0, -1.0, 4.0, -1.0},
+                                       {0.0, 0.0, -1.0, 0.0, -1.0, 4.0}}),
+                        0.0);
+    ASSERT_EQ(csr->get_num_stored_elements(), 20);
+    ASSERT_TRUE(csr->is_sorted_by_column_index());
+}
+
+
+TYPED_TEST(Stencil, MovesToCsr)
+{
+    using Csr = typename TestFixture::Csr;
+    auto csr = Csr::create(this->exec);
+    auto ref_csr = Csr::create(this->exec);
+    this->mtx->convert_to(ref_csr.get());
+
+    this->mtx->move_to(csr.get());
+
+    GKO_ASSERT_MTX_NEAR(csr, ref_csr, 0.0);
+}
+
+
+TYPED_TEST(Stencil, ConvertsVariableCoefficientsToCsr)
+{
+    using Csr = typename TestFixture::Csr;
+    using value_type = typename TestFixture::value_type;
+    auto csr = Csr::create(this->exec);
+
+    this->mtx3d->convert_to(csr.get());
+
+    // 24 diagonal entries, 18 entries each for the x neighbors, 16 for the y
+    // neighbors and 12 for the z neighbors
+    ASSERT_EQ(csr->get_size(), gko::dim<2>(24, 24));
+    ASSERT_EQ(csr->get_num_stored_elements(), 24 + 2 * (18 + 16 + 12));
+    ASSERT_TRUE(csr->is_sorted_by_column_index());
+    // row 5 is grid point (1, 1, 0)
+    auto row_ptrs = csr->get_const_row_ptrs();
+    auto col_idxs = csr->get_const_col_idxs();
+    auto vals = csr->get_const_values();
+    const auto begin = row_ptrs[5];
+    ASSERT_EQ(row_ptrs[6] - begin, 6);
+    EXPECT_EQ(col_idxs[begin], 1);
+    EXPECT_EQ(col_idxs[begin + 1], 4);
+    EXPECT_EQ(col_idxs[begin + 2], 5);
+    EXPECT_EQ(col_idxs[begin + 3], 6);
+    EXPECT_EQ(col_idxs[begin + 4], 9);
+    EXPECT_EQ(col_idxs[begin + 5], 17);
+    // the coefficient of point p in row r is (p * 24 + r) % 11 - 5
+    EXPECT_EQ(vals[begin], value_type{-5.0});
+    EXPECT_EQ(vals[begin + 1], value_type{2.0});
+    EXPECT_EQ(vals[begin + 2], value_type{0.0});
+    EXPECT_EQ(vals[begin + 3], value_type{4.0});
+    EXPECT_EQ(vals[begin + 4], value_type{-3.0});
+    EXPECT_EQ(vals[begin + 5], value_type{1.0});
+}
+
+
+TYPED_TEST(Stencil, ConvertsToDense)
+{
+    using Vec = typename TestFixture::Vec;
+    using value_type = typename TestFixture::value_type;
+    auto dense = Vec::create(this->exec);
+
+    this->mtx->convert_to(dense.get());
+
+    GKO_ASSERT_MTX_NEAR(dense,
+                        l<value_type>({{4.0, -1.0, 0.0, -1.0, 0.0, 0.0},
+                                       {-1.0, 4.0, -1.0, 0.0, -1.0, 0.0},
+                                       {0.0, -1.0, 4.0, 0.0, 0.0, -1.0},
+                                       {-1.0, 0.0, 0.0, 4.0, -1.0, 0.0},
+                                       {0.0, -1.0, 0.0, -1.0, 4.0, -1.0},
+                                       {0.0, 0.0, -1.0, 0.0, -1.0, 4.0}}),
+                        0.0);
+}
+
+
+TYPED_TEST(Stencil, ConvertsEmptyStencil)
+{
+    using Mtx = typename TestFixture::Mtx;
+    using Csr = typename TestFixture::Csr;
+    auto empty = Mtx::create(this->exec);
+    auto csr = Csr::create(this->exec);
+
+    empty->convert_to(csr.get());
+
+    ASSERT_EQ(csr->get_size(), gko::dim<2>{});
+    ASSERT_EQ(csr->get_num_stored_elements(), 0);
+    ASSERT_EQ(*csr->get_const_row_ptrs(), 0);
+}
+
+
+TYPED_TEST(Stencil, AppliesToDenseVector)
+{
+    using Csr = typename TestFixture::Csr;
+    using value_type = typename TestFixture::value_type;
+    auto b = this->create_vector(24, 1);
+    auto x = this->create_vector(24, 1);
+    auto expected = x->clone();
+    auto csr = Csr::create(this->exec);
+    this->mtx3d->convert_to(csr.get());
+    csr->apply(b.get(), expected.get());
+
+    this->mtx3d->apply(b.get(), x.get());
+
+    GKO_ASSERT_MTX_NEAR(x, expected, r<value_type>::value);
+}
+
+
+TYPED_TEST(Stencil, AppliesToDenseMatrix)
+{
+    using value_type = typename TestFixture::value_type;
+    auto b = this->create_vector(6, 3);
+    auto x = this->create_vector(6, 3);
+
+    this->mtx->apply(b.get(), x.get());
+
+    // b(row, col) = (3 * row + col) % 7 - 3
+    GKO_ASSERT_MTX_NEAR(x,
+                        l<value_type>({{-11.0, -9.0, -7.0},
+                                       {-2.0, 6.0, 14.0},
+                                       {14.0, -12.0, -10.0},
+                                       {-3.0, -1.0, 8.0},
+                                       {11.0, 12.0, -15.0},
+                                       {-13.0, -4.0, 5.0}}),
+                        r<value_type>::value);
+}
+
+
+TYPED_TEST(Stencil, AppliesLinearCombinationToDenseMatrix)
+{
+    using Csr = typename TestFixture::Csr;
+    using Vec = typename TestFixture::Vec;
+    using value_type = typename TestFixture::value_type;
+    auto alpha = gko::initialize<Vec>({-1.0}, this->exec);
+    auto beta = gko::initialize<Vec>({2.0}, this->exec);
+    auto b = this->create_vector(24, 3);
+    auto x = this->create_vector(24, 3);
+    auto expected = x->clone();
+    auto csr = Csr::create(this->exec);
+    this->mtx3d->convert_to(csr.get());
+    csr->apply(alpha.get(), b.get(), beta.get(), expected.get());
+
+    this->mtx3d->apply(alpha.get(), b.get(), beta.get(), x.get());
+
+    GKO_ASSERT_MTX_NEAR(x, expected, r<value_type>::value);
+}
+
+
+TYPED_TEST(Stencil, ApplyFailsOnWrongInnerDimension)
+{
+    auto b = this->create_vector(5, 1);
+    auto x = this->create_vector(6, 1);
+
+    ASSERT_THROW(this->mtx->apply(b.get(), x.get()), gko::DimensionMismatch);
+}
+
+
+}  // namespace
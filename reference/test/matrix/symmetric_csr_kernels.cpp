@@ -0,0 +1,292 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2022, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#include <ginkgo/core/matrix/symmetric_csr.hpp>
+
+
+#include <gtest/gtest.h>
+
+
+#include <ginkgo/core/base/exception.hpp>
+#include <ginkgo/core/base/executor.hpp>
+#include <ginkgo/core/matrix/csr.hpp>
+#include <ginkgo/core/matrix/dense.hpp>
+
+
+#include "core/matrix/symmetric_csr_kernels.hpp"
+#include "core/test/utils.hpp"
+
+
+namespace {
+
+
+template <typename ValueIndexType>
+class SymmetricCsr : public ::testing::Test {
+protected:
+    using value_type =
+        typename std::tuple_element<0, decltype(ValueIndexType())>::type;
+    using index_type =
+        typename std::tuple_element<1, decltype(ValueIndexType())>::type;
+    using Mtx = gko::matrix::SymmetricCsr<value_type, index_type>;
+    using Csr = gko::matrix::Csr<value_type, index_type>;
+    using Vec = gko::matrix::Dense<value_type>;
+
+    SymmetricCsr()
+        : exec(gko::ReferenceExecutor::create()), mtx(Mtx::create(exec))
+    {
+        // clang-format off
+        csr = gko::initialize<Csr>({{1.0, 0.0, 2.0},
+                                    {0.0, 3.0, 0.0},
+                                    {2.0, 0.0, 4.0}}, exec);
+        // clang-format on
+        csr->convert_to(mtx.get());
+    }
+
+    std::shared_ptr<const gko::ReferenceExecutor> exec;
+    std::unique_ptr<Csr> csr;
+    std::unique_ptr<Mtx> mtx;
+};
+
+TYPED_TEST_SUITE(SymmetricCsr, gko::test::ValueIndexTypes,
+                 PairTypenameNameGenerator);
+
+
+TYPED_TEST(SymmetricCsr, ConvertsFromCsrKeepingUpperTriangle)
+{
+    using value_type = typename TestFixture::value_type;
+    auto v = this->mtx->get_const_values();
+    auto c = this->mtx->get_const_col_idxs();
+    auto r = this->mtx->get_const_row_ptrs();
+
+    ASSERT_EQ(this->mtx->get_size(), gko::dim<2>(3, 3));
+    ASSERT_EQ(this->mtx->get_num_stored_elements(), 4);
+    EXPECT_EQ(r[0], 0);
+    EXPECT_EQ(r[1], 2);
+    EXPECT_EQ(r[2], 3);
+    EXPECT_EQ(r[3], 4);
+    EXPECT_EQ(c[0], 0);
+    EXPECT_EQ(c[1], 2);
+    EXPECT_EQ(c[2], 1);
+    EXPECT_EQ(c[3], 2);
+    EXPECT_EQ(v[0], value_type{1.0});
+    EXPECT_EQ(v[1], value_type{2.0});
+    EXPECT_EQ(v[2], value_type{3.0});
+    EXPECT_EQ(v[3], value_type{4.0});
+}
+
+
+TYPED_TEST(SymmetricCsr, ConvertFromNonSquareCsrFails)
+{
+    using Csr = typename TestFixture::Csr;
+    auto csr = Csr::create(this->exec, gko::dim<2>{2, 3});
+
+    ASSERT_THROW(csr->convert_to(this->mtx.get()), gko::DimensionMismatch);
+}
+
+
+TYPED_TEST(SymmetricCsr, AppliesToDenseVector)
+{
+    using Vec = typename TestFixture::Vec;
+    auto x = gko::initialize<Vec>({2.0, 1.0, 4.0}, this->exec);
+    auto y = Vec::create(this->exec, gko::dim<2>{3, 1});
+
+    this->mtx->apply(x.get(), y.get());
+
+    GKO_ASSERT_MTX_NEAR(y, l({10.0, 3.0, 20.0}), 0.0);
+}
+
+
+TYPED_TEST(SymmetricCsr, AppliesToDenseMatrix)
+{
+    using Vec = typename TestFixture::Vec;
+    using T = typename TestFixture::value_type;
+    // clang-format off
+    auto x = gko::initialize<Vec>(
+        {I<T>{2.0, 3.0},
+         I<T>{1.0, -1.5},
+         I<T>{4.0, 2.5}}, this->exec);
+    // clang-format on
+    auto y = Vec::create(this->exec, gko::dim<2>{3, 2});
+
+    this->mtx->apply(x.get(), y.get());
+
+    // clang-format off
+    GKO_ASSERT_MTX_NEAR(y,
+                        l({{10.0,  8.0},
+                           { 3.0, -4.5},
+                           {20.0, 16.0}}), 0.0);
+    // clang-format on
+}
+
+
+TYPED_TEST(SymmetricCsr, AppliesLinearCombinationToDenseVector)
+{
+    using Vec = typename TestFixture::Vec;
+    auto alpha = gko::initialize<Vec>({-1.0}, this->exec);
+    auto beta = gko::initialize<Vec>({2.0}, this->exec);
+    auto x = gko::initialize<Vec>({2.0, 1.0, 4.0}, this->exec);
+    auto y = gko::initialize<Vec>({1.0, 2.0, 3.0}, this->exec);
+
+    this->mtx->apply(alpha.get(), x.get(), beta.get(), y.get());
+
+    GKO_ASSERT_MTX_NEAR(y, l({-8.0, 1.0, -14.0}), 0.0);
+}
+
+
+TYPED_TEST(SymmetricCsr, ApplyFailsOnWrongInnerDimension)
+{
+    using Vec = typename TestFixture::Vec;
+    auto x = Vec::create(this->exec, gko::dim<2>{2});
+    auto y = Vec::create(this->exec, gko::dim<2>{3});
+
+    ASSERT_THROW(this->mtx->apply(x.get(), y.get()), gko::DimensionMismatch);
+}
+
+
+TYPED_TEST(SymmetricCsr, ConvertsToCsr)
+{
+    using Csr = typename TestFixture::Csr;
+    auto result = Csr::create(this->exec);
+
+    this->mtx->convert_to(result.get());
+
+    GKO_ASSERT_MTX_NEAR(result, this->csr, 0.0);
+    GKO_ASSERT_MTX_EQ_SPARSITY(result, this->csr);
+    ASSERT_TRUE(result->is_sorted_by_column_index());
+}
+
+
+TYPED_TEST(SymmetricCsr, ConvertsToDense)
+{
+    using Vec = typename TestFixture::Vec;
+    auto result = Vec::create(this->exec);
+
+    this->mtx->convert_to(result.get());
+
+    GKO_ASSERT_MTX_NEAR(result, this->csr, 0.0);
+}
+
+
+TYPED_TEST(SymmetricCsr, ConvertsEmptyToCsr)
+{
+    using Mtx = typename TestFixture::Mtx;
+    using Csr = typename TestFixture::Csr;
+    auto empty = Mtx::create(this->exec);
+    auto result = Csr::create(this->exec);
+
+    empty->convert_to(result.get());
+
+    ASSERT_EQ(result->get_size(), gko::dim<2>{});
+    ASSERT_EQ(result->get_num_stored_elements(), 0);
+}
+
+
+template <typename ValueIndexType>
+class SymmetricCsrComplex : public ::testing::Test {
+protected:
+    using value_type =
+        typename std::tuple_element<0, decltype(ValueIndexType())>::type;
+    using index_type =
+        typename std::tuple_element<1, decltype(ValueIndexType())>::type;
+    using Mtx = gko::matrix::SymmetricCsr<value_type, index_type>;
+    using Csr = gko::matrix::Csr<value_type, index_type>;
+    using Vec = gko::matrix::Dense<value_type>;
+
+    SymmetricCsrComplex() : exec(gko::ReferenceExecutor::create())
+    {
+        using T = value_type;
+        // clang-format off
+        upper = gko::initialize<Csr>({{T{1.0, 0.0}, T{0.0, 1.0}},
+                                      {T{0.0, 0.0}, T{2.0, 0.0}}}, exec);
+        // clang-format on
+    }
+
+    std::shared_ptr<const gko::ReferenceExecutor> exec;
+    std::unique_ptr<Csr> upper;
+};
+
+TYPED_TEST_SUITE(SymmetricCsrComplex, gko::test::ComplexValueIndexTypes,
+                 PairTypenameNameGenerator);
+
+
+TYPED_TEST(SymmetricCsrComplex, AppliesSymmetric)
+{
+    using Mtx = typename TestFixture::Mtx;
+    using Vec = typename TestFixture::Vec;
+    using T = typename TestFixture::value_type;
+    auto mtx = Mtx::create(this->exec);
+    this->upper->convert_to(mtx.get());
+    auto x = gko::initialize<Vec>({T{1.0, 0.0}, T{1.0, 0.0}}, this->exec);
+    auto y = Vec::create(this->exec, gko::dim<2>{2, 1});
+
+    mtx->apply(x.get(), y.get());
+
+    GKO_ASSERT_MTX_NEAR(y, l({T{1.0, 1.0}, T{2.0, 1.0}}), 0.0);
+}
+
+
+TYPED_TEST(SymmetricCsrComplex, AppliesHermitian)
+{
+    using Mtx = typename TestFixture::Mtx;
+    using Vec = typename TestFixture::Vec;
+    using T = typename TestFixture::value_type;
+    auto mtx = Mtx::create(this->exec, gko::dim<2>{}, 0, true);
+    this->upper->convert_to(mtx.get());
+    auto x = gko::initialize<Vec>({T{1.0, 0.0}, T{1.0, 0.0}}, this->exec);
+    auto y = Vec::create(this->exec, gko::dim<2>{2, 1});
+
+    mtx->apply(x.get(), y.get());
+
+    ASSERT_TRUE(mtx->is_hermitian());
+    GKO_ASSERT_MTX_NEAR(y, l({T{1.0, 1.0}, T{2.0, -1.0}}), 0.0);
+}
+
+
+TYPED_TEST(SymmetricCsrComplex, ConvertsHermitianToCsr)
+{
+    using Mtx = typename TestFixture::Mtx;
+    using Csr = typename TestFixture::Csr;
+    using T = typename TestFixture::value_type;
+    auto mtx = Mtx::create(this->exec, gko::dim<2>{}, 0, true);
+    this->upper->convert_to(mtx.get());
+    auto result = Csr::create(this->exec);
+
+    mtx->convert_to(result.get());
+
+    GKO_ASSERT_MTX_NEAR(result,
+                        l({{T{1.0, 0.0}, T{0.0, 1.0}},
+                           {T{0.0, -1.0}, T{2.0, 0.0}}}),
+                        0.0);
+}
+
+
+}  // namespace
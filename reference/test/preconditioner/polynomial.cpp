@@ -0,0 +1,328 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2022, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+
+#include <ginkgo/core/preconditioner/polynomial.hpp>
+
+
+#include <memory>
+
+
+#include <gtest/gtest.h>
+
+
+#include <ginkgo/core/base/exception.hpp>
+#include <ginkgo/core/matrix/csr.hpp>
+#include <ginkgo/core/matrix/dense.hpp>
+#include <ginkgo/core/solver/cg.hpp>
+#include <ginkgo/core/stop/iteration.hpp>
+#include <ginkgo/core/stop/residual_norm.hpp>
+
+
+#include "core/test/utils.hpp"
+
+
+namespace {
+
+
+template <typename T>
+class Polynomial : public ::testing::Test {
+protected:
+    using value_type = T;
+    using Poly = gko::preconditioner::Polynomial<value_type>;
+    using Mtx = gko::matrix::Csr<value_type, gko::int32>;
+    using Vec = gko::matrix::Dense<value_type>;
+
+    Polynomial()
+        : exec(gko::ReferenceExecutor::create()),
+          mtx(gko::initialize<Mtx>(
+              {{2.0, -1.0, 0.0}, {-1.0, 2.0, -1.0}, {0.0, -1.0, 2.0}}, exec)),
+          b(gko::initialize<Vec>({1.0, 2.0, 3.0}, exec)),
+          x(Vec::create(exec, gko::dim<2>{3, 1}))
+    {}
+
+    std::unique_ptr<Mtx> laplacian(gko::size_type n)
+    {
+        gko::matrix_data<value_type, gko::int32> data{gko::dim<2>{n, n}};
+        for (gko::int32 i = 0; i < static_cast<gko::int32>(n); ++i) {
+            if (i > 0) {
+                data.nonzeros.emplace_back(i, i - 1, -1.0);
+            }
+            data.nonzeros.emplace_back(i, i, 2.0);
+            if (i < static_cast<gko::int32>(n) - 1) {
+                data.nonzeros.emplace_back(i, i + 1, -1.0);
+            }
+        }
+        auto result = Mtx::create(exec);
+        result->read(data);
+        return result;
+    }
+
+    std::shared_ptr<const gko::ReferenceExecutor> exec;
+    std::shared_ptr<Mtx> mtx;
+    std::unique_ptr<Vec> b;
+    std::unique_ptr<Vec> x;
+};
+
+TYPED_TEST_SUITE(Polynomial, gko::test::ValueTypes, TypenameNameGenerator);
+
+
+TYPED_TEST(Polynomial, EstimatesMaxEigenvalue)
+{
+    using Mtx = typename TestFixture::Mtx;
+    using Poly = typename TestFixture::Poly;
+    auto diag = gko::share(gko::initialize<Mtx>({{1.0, 0.0, 0.0, 0.0},
+                                                 {0.0, 1.0, 0.0, 0.0},
+                                                 {0.0, 0.0, 1.0, 0.0},
+                                                 {0.0, 0.0, 0.0, 10.0}},
+                                                this->exec));
+
+    auto poly = Poly::build().on(this->exec)->generate(diag);
+
+    // the estimate is enlarged by 10%
+    ASSERT_NEAR(poly->get_max_eigenvalue(), 11.0, 1e-3);
+    ASSERT_NEAR(poly->get_min_eigenvalue(), 11.0 / 30.0, 1e-3);
+}
+
+
+TYPED_TEST(Polynomial, UsesProvidedEigenvalueBounds)
+{
+    using Poly = typename TestFixture::Poly;
+
+    auto poly = Poly::build()
+                    .with_max_eigenvalue(4.0)
+                    .with_eigenvalue_ratio(8.0)
+                    .on(this->exec)
+                    ->generate(this->mtx);
+
+    ASSERT_EQ(poly->get_max_eigenvalue(), 4.0);
+    ASSERT_EQ(poly->get_min_eigenvalue(), 0.5);
+    ASSERT_EQ(poly->get_system_matrix(), this->mtx);
+}
+
+
+TYPED_TEST(Polynomial, ThrowsOnInvalidEigenvalueBounds)
+{
+    using Poly = typename TestFixture::Poly;
+
+    ASSERT_THROW(Poly::build()
+                     .with_max_eigenvalue(1.0)
+                     .with_min_eigenvalue(2.0)
+                     .on(this->exec)
+                     ->generate(this->mtx),
+                 gko::UnsupportedMatrixProperty);
+}
+
+
+TYPED_TEST(Polynomial, AppliesNeumannSeriesOfDegreeZero)
+{
+    using Poly = typename TestFixture::Poly;
+    using Vec = typename TestFixture::Vec;
+    using value_type = typename TestFixture::value_type;
+    auto poly = Poly::build()
+                    .with_kind(gko::preconditioner::polynomial::kind::neumann)
+                    .with_degree(0u)
+                    .with_max_eigenvalue(4.0)
+                    .on(this->exec)
+                    ->generate(this->mtx);
+
+    poly->apply(this->b.get(), this->x.get());
+
+    GKO_ASSERT_MTX_NEAR(this->x, l<value_type>({0.25, 0.5, 0.75}),
+                        r<value_type>::value);
+}
+
+
+TYPED_TEST(Polynomial, AppliesNeumannSeriesOfDegreeOne)
+{
+    using Poly = typename TestFixture::Poly;
+    using value_type = typename TestFixture::value_type;
+    auto poly = Poly::build()
+                    .with_kind(gko::preconditioner::polynomial::kind::neumann)
+                    .with_degree(1u)
+                    .with_max_eigenvalue(4.0)
+                    .on(this->exec)
+                    ->generate(this->mtx);
+
+    poly->apply(this->b.get(), this->x.get());
+
+    // x = w b + (I - w A) w b with w = 1 / 4
+    GKO_ASSERT_MTX_NEAR(this->x, l<value_type>({0.5, 1.0, 1.25}),
+                        r<value_type>::value);
+}
+
+
+TYPED_TEST(Polynomial, AppliesChebyshevPolynomialOfDegreeOne)
+{
+    using Poly = typename TestFixture::Poly;
+    using value_type = typename TestFixture::value_type;
+    auto poly =
+        Poly::build()
+            .with_kind(gko::preconditioner::polynomial::kind::chebyshev)
+            .with_degree(1u)
+            .with_max_eigenvalue(4.0)
+            .with_min_eigenvalue(0.5)
+            .on(this->exec)
+            ->generate(this->mtx);
+
+    poly->apply(this->b.get(), this->x.get());
+
+    // the residual polynomial is T_2((theta - l) / delta) / T_2(theta / delta)
+    // with theta = 9 / 4 and delta = 7 / 4, which results in
+    // p(A) = 32 / 113 (9 / 2 I - A / 2)
+    GKO_ASSERT_MTX_NEAR(
+        this->x, l<value_type>({144.0 / 113, 288.0 / 113, 304.0 / 113}),
+        r<value_type>::value * 10);
+}
+
+
+TYPED_TEST(Polynomial, AppliesLeastSquaresPolynomialByHorner)
+{
+    using Poly = typename TestFixture::Poly;
+    using Vec = typename TestFixture::Vec;
+    using value_type = typename TestFixture::value_type;
+    auto poly =
+        Poly::build()
+            .with_kind(gko::preconditioner::polynomial::kind::least_squares)
+            .with_degree(2u)
+            .with_max_eigenvalue(4.0)
+            .with_min_eigenvalue(0.5)
+            .on(this->exec)
+            ->generate(this->mtx);
+    const auto& coeffs = poly->get_coefficients();
+    ASSERT_EQ(coeffs.size(), 3);
+    // expected = (c_0 + c_1 A / 4 + c_2 A^2 / 16) b / 4
+    auto ab = Vec::create(this->exec, gko::dim<2>{3, 1});
+    auto aab = Vec::create(this->exec, gko::dim<2>{3, 1});
+    this->mtx->apply(this->b.get(), ab.get());
+    this->mtx->apply(ab.get(), aab.get());
+    const auto c0 = static_cast<value_type>(coeffs[0] / 4);
+    const auto c1 = static_cast<value_type>(coeffs[1] / 16);
+    const auto c2 = static_cast<value_type>(coeffs[2] / 64);
+    auto expected = Vec::create(this->exec, gko::dim<2>{3, 1});
+    for (int i = 0; i < 3; ++i) {
+        expected->at(i, 0) = c0 * this->b->at(i, 0) + c1 * ab->at(i, 0) +
+                             c2 * aab->at(i, 0);
+    }
+
+    poly->apply(this->b.get(), this->x.get());
+
+    GKO_ASSERT_MTX_NEAR(this->x, expected, r<value_type>::value * 10);
+}
+
+
+TYPED_TEST(Polynomial, LeastSquaresPolynomialDampsResidual)
+{
+    using Poly = typename TestFixture::Poly;
+    auto poly =
+        Poly::build()
+            .with_kind(gko::preconditioner::polynomial::kind::least_squares)
+            .with_degree(3u)
+            .with_max_eigenvalue(1.0)
+            .with_min_eigenvalue(0.1)
+            .on(this->exec)
+            ->generate(this->mtx);
+    const auto& coeffs = poly->get_coefficients();
+
+    // the residual polynomial 1 - t p(t) is small on the whole interval
+    for (int i = 0; i <= 100; ++i) {
+        const auto t = 0.1 + 0.9 * i / 100.0;
+        double p{};
+        for (auto it = coeffs.rbegin(); it != coeffs.rend(); ++it) {
+            p = p * t + *it;
+        }
+        ASSERT_LT(std::abs(1.0 - t * p), 0.5);
+    }
+}
+
+
+TYPED_TEST(Polynomial, AppliesLinearCombination)
+{
+    using Poly = typename TestFixture::Poly;
+    using Vec = typename TestFixture::Vec;
+    using value_type = typename TestFixture::value_type;
+    auto poly = Poly::build()
+                    .with_kind(gko::preconditioner::polynomial::kind::neumann)
+                    .with_degree(0u)
+                    .with_max_eigenvalue(4.0)
+                    .on(this->exec)
+                    ->generate(this->mtx);
+    auto alpha = gko::initialize<Vec>({2.0}, this->exec);
+    auto beta = gko::initialize<Vec>({-1.0}, this->exec);
+    auto x = gko::initialize<Vec>({1.0, 1.0, 1.0}, this->exec);
+
+    poly->apply(alpha.get(), this->b.get(), beta.get(), x.get());
+
+    GKO_ASSERT_MTX_NEAR(x, l<value_type>({-0.5, 0.0, 0.5}),
+                        r<value_type>::value);
+}
+
+
+TYPED_TEST(Polynomial, AcceleratesCg)
+{
+    using Poly = typename TestFixture::Poly;
+    using Vec = typename TestFixture::Vec;
+    using value_type = typename TestFixture::value_type;
+    using Cg = gko::solver::Cg<value_type>;
+    const gko::size_type n = 50;
+    auto mtx = gko::share(this->laplacian(n));
+    auto b = Vec::create(this->exec, gko::dim<2>{n, 1});
+    b->fill(gko::one<value_type>());
+    auto x = Vec::create(this->exec, gko::dim<2>{n, 1});
+    x->fill(gko::zero<value_type>());
+    auto solver_factory =
+        Cg::build()
+            .with_preconditioner(
+                Poly::build().with_degree(5u).on(this->exec))
+            .with_criteria(
+                gko::stop::Iteration::build().with_max_iters(12u).on(
+                    this->exec),
+                gko::stop::ResidualNorm<value_type>::build()
+                    .with_reduction_factor(1e-5)
+                    .on(this->exec))
+            .on(this->exec);
+
+    solver_factory->generate(mtx)->apply(b.get(), x.get());
+
+    // plain CG needs 25 iterations to reach this residual norm
+    auto res = gko::clone(b);
+    mtx->apply(gko::initialize<Vec>({-1.0}, this->exec).get(), x.get(),
+               gko::initialize<Vec>({1.0}, this->exec).get(), res.get());
+    auto res_norm =
+        gko::matrix::Dense<gko::remove_complex<value_type>>::create(
+            this->exec, gko::dim<2>{1, 1});
+    res->compute_norm2(res_norm.get());
+    ASSERT_LT(res_norm->at(0, 0), 1e-3);
+}
+
+
+}  // namespace
@@ -0,0 +1,245 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2022, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+
+#include <ginkgo/core/preconditioner/spai.hpp>
+
+
+#include <memory>
+
+
+#include <gtest/gtest.h>
+
+
+#include <ginkgo/core/base/composition.hpp>
+#include <ginkgo/core/matrix/csr.hpp>
+#include <ginkgo/core/matrix/dense.hpp>
+
+
+#include "core/preconditioner/spai_kernels.hpp"
+#include "core/test/utils.hpp"
+
+
+namespace {
+
+
+template <typename ValueIndexType>
+class Spai : public ::testing::Test {
+protected:
+    using value_type =
+        typename std::tuple_element<0, decltype(ValueIndexType())>::type;
+    using index_type =
+        typename std::tuple_element<1, decltype(ValueIndexType())>::type;
+    using GeneralSpai =
+        gko::preconditioner::GeneralSpai<value_type, index_type>;
+    using SpdSpai = gko::preconditioner::SpdSpai<value_type, index_type>;
+    using Csr = gko::matrix::Csr<value_type, index_type>;
+    using Dense = gko::matrix::Dense<value_type>;
+
+    Spai()
+        : exec(gko::ReferenceExecutor::create()),
+          bidiag(gko::initialize<Csr>(
+              {{2.0, 1.0, 0.0}, {0.0, 2.0, 1.0}, {0.0, 0.0, 2.0}}, exec)),
+          bidiag_dense(gko::initialize<Dense>(
+              {{2.0, 1.0, 0.0}, {0.0, 2.0, 1.0}, {0.0, 0.0, 2.0}}, exec)),
+          spd(gko::initialize<Csr>({{4.0, -1.0, 0.0, 0.0},
+                                    {-1.0, 4.0, -1.0, 0.0},
+                                    {0.0, -1.0, 4.0, -1.0},
+                                    {0.0, 0.0, -1.0, 4.0}},
+                                   exec)),
+          spd_dense(gko::initialize<Dense>({{4.0, -1.0, 0.0, 0.0},
+                                            {-1.0, 4.0, -1.0, 0.0},
+                                            {0.0, -1.0, 4.0, -1.0},
+                                            {0.0, 0.0, -1.0, 4.0}},
+                                           exec))
+    {}
+
+    std::shared_ptr<const gko::ReferenceExecutor> exec;
+    std::shared_ptr<Csr> bidiag;
+    std::shared_ptr<Dense> bidiag_dense;
+    std::shared_ptr<Csr> spd;
+    std::shared_ptr<Dense> spd_dense;
+};
+
+TYPED_TEST_SUITE(Spai, gko::test::ValueIndexTypes, PairTypenameNameGenerator);
+
+
+TYPED_TEST(Spai, GeneralSpaiInvertsDiagonalMatrix)
+{
+    using GeneralSpai = typename TestFixture::GeneralSpai;
+    using Csr = typename TestFixture::Csr;
+    using value_type = typename TestFixture::value_type;
+    auto diag = gko::share(gko::initialize<Csr>(
+        {{2.0, 0.0, 0.0}, {0.0, 4.0, 0.0}, {0.0, 0.0, -1.0}}, this->exec));
+
+    auto spai = GeneralSpai::build().on(this->exec)->generate(diag);
+
+    GKO_ASSERT_MTX_NEAR(spai->get_approximate_inverse(),
+                        l({{0.5, 0.0, 0.0}, {0.0, 0.25, 0.0}, {0.0, 0.0, -1.0}}),
+                        r<value_type>::value);
+}
+
+
+TYPED_TEST(Spai, GeneralSpaiWithoutAdaptiveStepsKeepsPattern)
+{
+    using GeneralSpai = typename TestFixture::GeneralSpai;
+
+    auto spai = GeneralSpai::build()
+                    .with_adaptive_steps(0)
+                    .on(this->exec)
+                    ->generate(this->bidiag);
+
+    GKO_ASSERT_MTX_EQ_SPARSITY(spai->get_approximate_inverse(), this->bidiag);
+}
+
+
+TYPED_TEST(Spai, GeneralSpaiWithLargeToleranceKeepsPattern)
+{
+    using GeneralSpai = typename TestFixture::GeneralSpai;
+
+    auto spai = GeneralSpai::build()
+                    .with_tolerance(10.0)
+                    .on(this->exec)
+                    ->generate(this->bidiag);
+
+    GKO_ASSERT_MTX_EQ_SPARSITY(spai->get_approximate_inverse(), this->bidiag);
+}
+
+
+TYPED_TEST(Spai, GeneralSpaiAdaptsPatternToExactInverse)
+{
+    using GeneralSpai = typename TestFixture::GeneralSpai;
+    using value_type = typename TestFixture::value_type;
+
+    auto spai = GeneralSpai::build()
+                    .with_adaptive_steps(1)
+                    .with_entries_per_step(1u)
+                    .on(this->exec)
+                    ->generate(this->bidiag);
+
+    GKO_ASSERT_MTX_NEAR(spai->get_approximate_inverse(),
+                        l({{0.5, -0.25, 0.125}, {0.0, 0.5, -0.25},
+                           {0.0, 0.0, 0.5}}),
+                        r<value_type>::value);
+}
+
+
+TYPED_TEST(Spai, GeneralSpaiAppliesApproximateInverse)
+{
+    using GeneralSpai = typename TestFixture::GeneralSpai;
+    using Dense = typename TestFixture::Dense;
+    using value_type = typename TestFixture::value_type;
+    auto spai = GeneralSpai::build().on(this->exec)->generate(this->bidiag);
+    auto x = Dense::create(this->exec, gko::dim<2>{3, 3});
+
+    spai->apply(this->bidiag_dense.get(), x.get());
+
+    GKO_ASSERT_MTX_NEAR(
+        x, l({{1.0, 0.0, 0.0}, {0.0, 1.0, 0.0}, {0.0, 0.0, 1.0}}),
+        r<value_type>::value);
+}
+
+
+TYPED_TEST(Spai, SpdSpaiWithoutAdaptiveStepsIsFsai)
+{
+    using SpdSpai = typename TestFixture::SpdSpai;
+    using Csr = typename TestFixture::Csr;
+    using Dense = typename TestFixture::Dense;
+    using value_type = typename TestFixture::value_type;
+
+    auto spai = SpdSpai::build()
+                    .with_adaptive_steps(0)
+                    .on(this->exec)
+                    ->generate(this->spd);
+
+    auto factor = gko::as<Csr>(
+        spai->get_approximate_inverse()->get_operators()[1]);
+    GKO_ASSERT_MTX_EQ_SPARSITY(
+        factor, l<value_type>({{1.0, 0.0, 0.0, 0.0},
+                               {1.0, 1.0, 0.0, 0.0},
+                               {0.0, 1.0, 1.0, 0.0},
+                               {0.0, 0.0, 1.0, 1.0}}));
+    // G A G^T has a unit diagonal
+    auto ga = Dense::create(this->exec, gko::dim<2>{4, 4});
+    auto gagt = Dense::create(this->exec, gko::dim<2>{4, 4});
+    factor->apply(this->spd_dense.get(), ga.get());
+    factor->apply(gko::as<Dense>(ga->conj_transpose()).get(), gagt.get());
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_NEAR(gko::real(gagt->at(i, i)), 1.0, r<value_type>::value);
+    }
+}
+
+
+TYPED_TEST(Spai, SpdSpaiAdaptsPatternToExactInverse)
+{
+    using SpdSpai = typename TestFixture::SpdSpai;
+    using Dense = typename TestFixture::Dense;
+    using value_type = typename TestFixture::value_type;
+    auto spai = SpdSpai::build()
+                    .with_adaptive_steps(2)
+                    .with_entries_per_step(1u)
+                    .on(this->exec)
+                    ->generate(this->spd);
+    auto x = Dense::create(this->exec, gko::dim<2>{4, 4});
+
+    spai->apply(this->spd_dense.get(), x.get());
+
+    GKO_ASSERT_MTX_NEAR(x,
+                        l({{1.0, 0.0, 0.0, 0.0},
+                           {0.0, 1.0, 0.0, 0.0},
+                           {0.0, 0.0, 1.0, 0.0},
+                           {0.0, 0.0, 0.0, 1.0}}),
+                        r<value_type>::value * 10);
+}
+
+
+TYPED_TEST(Spai, SpdSpaiAppliesLinearCombination)
+{
+    using SpdSpai = typename TestFixture::SpdSpai;
+    using Dense = typename TestFixture::Dense;
+    using value_type = typename TestFixture::value_type;
+    auto spai = SpdSpai::build().on(this->exec)->generate(this->spd);
+    auto b = gko::initialize<Dense>({1.0, 2.0, 3.0, 4.0}, this->exec);
+    auto x = gko::initialize<Dense>({1.0, 1.0, 1.0, 1.0}, this->exec);
+    auto expected = gko::clone(x);
+    auto alpha = gko::initialize<Dense>({2.0}, this->exec);
+    auto beta = gko::initialize<Dense>({-1.0}, this->exec);
+    spai->get_approximate_inverse()->apply(alpha.get(), b.get(), beta.get(),
+                                           expected.get());
+
+    spai->apply(alpha.get(), b.get(), beta.get(), x.get());
+
+    GKO_ASSERT_MTX_NEAR(x, expected, r<value_type>::value);
+}
+
+
+}  // namespace
@@ -0,0 +1,265 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2022, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#include <ginkgo/core/solver/block_triangular.hpp>
+
+
+#include <memory>
+
+
+#include <gtest/gtest.h>
+
+
+#include <ginkgo/core/base/executor.hpp>
+#include <ginkgo/core/factorization/block_ilu.hpp>
+#include <ginkgo/core/matrix/dense.hpp>
+#include <ginkgo/core/matrix/fbcsr.hpp>
+#include <ginkgo/core/preconditioner/ilu.hpp>
+
+
+#include "core/solver/block_trs_kernels.hpp"
+#include "core/test/utils.hpp"
+
+
+namespace {
+
+
+template <typename ValueIndexType>
+class BlockTrs : public ::testing::Test {
+protected:
+    using value_type =
+        typename std::tuple_element<0, decltype(ValueIndexType())>::type;
+    using index_type =
+        typename std::tuple_element<1, decltype(ValueIndexType())>::type;
+    using Dense = gko::matrix::Dense<value_type>;
+    using Fbcsr = gko::matrix::Fbcsr<value_type, index_type>;
+    using LowerSolver = gko::solver::BlockLowerTrs<value_type, index_type>;
+    using UpperSolver = gko::solver::BlockUpperTrs<value_type, index_type>;
+    using mat_data = gko::matrix_data<value_type, index_type>;
+    template <typename T>
+    using I = std::initializer_list<T>;
+
+    BlockTrs()
+        : exec(gko::ReferenceExecutor::create()),
+          // clang-format off
+          lower_data({{2., 1., 0., 0., 0., 0.},
+                      {1., 3., 0., 0., 0., 0.},
+                      {1., 0., 2., 0., 0., 0.},
+                      {0., 1., 1., 1., 0., 0.},
+                      {1., 2., 0., 1., 4., 1.},
+                      {0., 0., 1., 0., 0., 2.}}),
+          unit_lower_data({{1., 0., 0., 0., 0., 0.},
+                           {0., 1., 0., 0., 0., 0.},
+                           {1., 0., 1., 0., 0., 0.},
+                           {0., 1., 0., 1., 0., 0.},
+                           {1., 2., 0., 1., 1., 0.},
+                           {0., 0., 1., 0., 0., 1.}}),
+          // clang-format on
+          lower(to_fbcsr(lower_data)),
+          upper(gko::as<Fbcsr>(lower->transpose())),
+          x_expected(gko::initialize<Dense>({I<value_type>{1., -1.},
+                                             I<value_type>{2., 0.},
+                                             I<value_type>{3., 1.},
+                                             I<value_type>{4., -2.},
+                                             I<value_type>{5., 0.5},
+                                             I<value_type>{6., 2.}},
+                                            exec)),
+          b(Dense::create(exec, gko::dim<2>{6, 2})),
+          x(Dense::create(exec, gko::dim<2>{6, 2}))
+    {}
+
+    std::shared_ptr<Fbcsr> to_fbcsr(const mat_data& data)
+    {
+        auto result = gko::share(Fbcsr::create(exec, 2));
+        result->read(data);
+        return result;
+    }
+
+    std::shared_ptr<const gko::ReferenceExecutor> exec;
+    mat_data lower_data;
+    mat_data unit_lower_data;
+    std::shared_ptr<Fbcsr> lower;
+    std::shared_ptr<Fbcsr> upper;
+    std::shared_ptr<Dense> x_expected;
+    std::shared_ptr<Dense> b;
+    std::shared_ptr<Dense> x;
+};
+
+TYPED_TEST_SUITE(BlockTrs, gko::test::ValueIndexTypes,
+                 PairTypenameNameGenerator);
+
+
+TYPED_TEST(BlockTrs, SolvesLowerBlockTriangularSystem)
+{
+    using LowerSolver = typename TestFixture::LowerSolver;
+    using value_type = typename TestFixture::value_type;
+    this->lower->apply(this->x_expected.get(), this->b.get());
+    auto solver = LowerSolver::build().on(this->exec)->generate(this->lower);
+
+    solver->apply(this->b.get(), this->x.get());
+
+    GKO_ASSERT_MTX_NEAR(this->x, this->x_expected, r<value_type>::value * 10);
+}
+
+
+TYPED_TEST(BlockTrs, SolvesUpperBlockTriangularSystem)
+{
+    using UpperSolver = typename TestFixture::UpperSolver;
+    using value_type = typename TestFixture::value_type;
+    this->upper->apply(this->x_expected.get(), this->b.get());
+    auto solver = UpperSolver::build().on(this->exec)->generate(this->upper);
+
+    solver->apply(this->b.get(), this->x.get());
+
+    GKO_ASSERT_MTX_NEAR(this->x, this->x_expected, r<value_type>::value * 10);
+}
+
+
+TYPED_TEST(BlockTrs, SolvesLowerSystemWithUnitDiagonal)
+{
+    using LowerSolver = typename TestFixture::LowerSolver;
+    using value_type = typename TestFixture::value_type;
+    this->to_fbcsr(this->unit_lower_data)
+        ->apply(this->x_expected.get(), this->b.get());
+    auto solver = LowerSolver::build()
+                      .with_unit_diagonal(true)
+                      .on(this->exec)
+                      ->generate(this->lower);
+
+    solver->apply(this->b.get(), this->x.get());
+
+    GKO_ASSERT_MTX_NEAR(this->x, this->x_expected, r<value_type>::value * 10);
+}
+
+
+TYPED_TEST(BlockTrs, IgnoresBlocksOutsideOfTriangle)
+{
+    using LowerSolver = typename TestFixture::LowerSolver;
+    using value_type = typename TestFixture::value_type;
+    this->lower->apply(this->x_expected.get(), this->b.get());
+    auto full = this->to_fbcsr(this->lower_data);
+    full->read({{2., 1., 0., 0., 7., 7.},
+                {1., 3., 0., 0., 7., 7.},
+                {1., 0., 2., 0., 0., 0.},
+                {0., 1., 1., 1., 0., 0.},
+                {1., 2., 0., 1., 4., 1.},
+                {0., 0., 1., 0., 0., 2.}});
+    auto solver = LowerSolver::build().on(this->exec)->generate(full);
+
+    solver->apply(this->b.get(), this->x.get());
+
+    GKO_ASSERT_MTX_NEAR(this->x, this->x_expected, r<value_type>::value * 10);
+}
+
+
+TYPED_TEST(BlockTrs, AppliesLinearCombination)
+{
+    using LowerSolver = typename TestFixture::LowerSolver;
+    using Dense = typename TestFixture::Dense;
+    using value_type = typename TestFixture::value_type;
+    this->lower->apply(this->x_expected.get(), this->b.get());
+    auto alpha = gko::initialize<Dense>({2.0}, this->exec);
+    auto beta = gko::initialize<Dense>({-1.0}, this->exec);
+    this->x->fill(1.0);
+    auto expected = gko::clone(this->x_expected);
+    expected->scale(alpha.get());
+    expected->add_scaled(gko::initialize<Dense>({-1.0}, this->exec).get(),
+                         this->x.get());
+    auto solver = LowerSolver::build().on(this->exec)->generate(this->lower);
+
+    solver->apply(alpha.get(), this->b.get(), beta.get(), this->x.get());
+
+    GKO_ASSERT_MTX_NEAR(this->x, expected, r<value_type>::value * 10);
+}
+
+
+TYPED_TEST(BlockTrs, TransposedLowerSolverSolvesUpperSystem)
+{
+    using LowerSolver = typename TestFixture::LowerSolver;
+    using UpperSolver = typename TestFixture::UpperSolver;
+    using value_type = typename TestFixture::value_type;
+    this->upper->apply(this->x_expected.get(), this->b.get());
+    auto solver = LowerSolver::build().on(this->exec)->generate(this->lower);
+
+    auto transposed = gko::as<UpperSolver>(solver->transpose());
+    transposed->apply(this->b.get(), this->x.get());
+
+    GKO_ASSERT_MTX_NEAR(this->x, this->x_expected, r<value_type>::value * 10);
+}
+
+
+TYPED_TEST(BlockTrs, CanBeCopied)
+{
+    using LowerSolver = typename TestFixture::LowerSolver;
+    using value_type = typename TestFixture::value_type;
+    this->lower->apply(this->x_expected.get(), this->b.get());
+    auto solver = LowerSolver::build().on(this->exec)->generate(this->lower);
+    auto copy = LowerSolver::build().on(this->exec)->generate(this->upper);
+
+    copy->copy_from(gko::lend(solver));
+    copy->apply(this->b.get(), this->x.get());
+
+    GKO_ASSERT_MTX_NEAR(this->x, this->x_expected, r<value_type>::value * 10);
+}
+
+
+TYPED_TEST(BlockTrs, WorksAsIluPreconditionerWithBlockIlu)
+{
+    using LowerSolver = typename TestFixture::LowerSolver;
+    using UpperSolver = typename TestFixture::UpperSolver;
+    using value_type = typename TestFixture::value_type;
+    using index_type = typename TestFixture::index_type;
+    using Precond =
+        gko::preconditioner::Ilu<LowerSolver, UpperSolver, false, index_type>;
+    // block tridiagonal matrices have an exact block ILU(0) factorization
+    auto mtx = this->to_fbcsr({{4., 1., 1., 0., 0., 0.},
+                               {2., 4., 0., 1., 0., 0.},
+                               {1., 0., 4., 1., 1., 2.},
+                               {0., 1., -1., 4., 0., 1.},
+                               {0., 0., 1., 0., 4., 1.},
+                               {0., 0., 0., 1., 1., 4.}});
+    mtx->apply(this->x_expected.get(), this->b.get());
+    auto precond =
+        Precond::build()
+            .with_factorization_factory(
+                gko::factorization::BlockIlu<value_type, index_type>::build()
+                    .on(this->exec))
+            .on(this->exec)
+            ->generate(mtx);
+
+    precond->apply(this->b.get(), this->x.get());
+
+    GKO_ASSERT_MTX_NEAR(this->x, this->x_expected, r<value_type>::value * 10);
+}
+
+
+}  // namespace
@@ -0,0 +1,98 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2022, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#include <ginkgo/core/factorization/block_ilu.hpp>
+
+
+#include <memory>
+#include <random>
+
+
+#include <gtest/gtest.h>
+
+
+#include <ginkgo/core/base/executor.hpp>
+#include <ginkgo/core/matrix/fbcsr.hpp>
+
+
+#include "core/test/utils.hpp"
+#include "core/test/utils/fb_matrix_generator.hpp"
+#include "test/utils/executor.hpp"
+
+
+class BlockIlu : public CommonTestFixture {
+protected:
+    using Fbcsr = gko::matrix::Fbcsr<value_type, index_type>;
+    using factorization_type =
+        gko::factorization::BlockIlu<value_type, index_type>;
+
+    BlockIlu() : rand_engine(42) {}
+
+    void initialize_data(index_type num_brows, int block_size)
+    {
+        mtx = gko::test::generate_random_fbcsr<value_type>(
+            ref, num_brows, num_brows, block_size, true, false, rand_engine);
+        dmtx = gko::clone(exec, mtx);
+    }
+
+    std::default_random_engine rand_engine;
+    std::shared_ptr<Fbcsr> mtx;
+    std::shared_ptr<Fbcsr> dmtx;
+};
+
+
+TEST_F(BlockIlu, ComputesSameFactorsAsRef)
+{
+    initialize_data(123, 3);
+
+    auto fact = factorization_type::build().on(ref)->generate(mtx);
+    auto dfact = factorization_type::build().on(exec)->generate(dmtx);
+
+    GKO_ASSERT_MTX_NEAR(fact->get_l_factor(), dfact->get_l_factor(),
+                        r<value_type>::value * 10);
+    GKO_ASSERT_MTX_NEAR(fact->get_u_factor(), dfact->get_u_factor(),
+                        r<value_type>::value * 10);
+}
+
+
+TEST_F(BlockIlu, ComputesSameFactorsAsRefForBlockSizeSeven)
+{
+    initialize_data(40, 7);
+
+    auto fact = factorization_type::build().on(ref)->generate(mtx);
+    auto dfact = factorization_type::build().on(exec)->generate(dmtx);
+
+    GKO_ASSERT_MTX_NEAR(fact->get_l_factor(), dfact->get_l_factor(),
+                        r<value_type>::value * 10);
+    GKO_ASSERT_MTX_NEAR(fact->get_u_factor(), dfact->get_u_factor(),
+                        r<value_type>::value * 10);
+}
@@ -0,0 +1,240 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2022, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#include <ginkgo/core/matrix/block_ell.hpp>
+
+
+#include <random>
+
+
+#include <gtest/gtest.h>
+
+
+#include <ginkgo/core/base/executor.hpp>
+#include <ginkgo/core/matrix/csr.hpp>
+#include <ginkgo/core/matrix/dense.hpp>
+
+
+#include "core/matrix/block_ell_kernels.hpp"
+#include "core/test/utils.hpp"
+#include "test/utils/executor.hpp"
+
+
+class BlockEll : public CommonTestFixture {
+protected:
+    using Mtx = gko::matrix::BlockEll<value_type, index_type>;
+    using Csr = gko::matrix::Csr<value_type, index_type>;
+    using Vec = gko::matrix::Dense<value_type>;
+
+    BlockEll() : rand_engine(42) {}
+
+    std::unique_ptr<Vec> gen_vec(int num_rows, int num_cols)
+    {
+        return gko::test::generate_random_matrix<Vec>(
+            num_rows, num_cols,
+            std::uniform_int_distribution<>(num_cols, num_cols),
+            std::normal_distribution<>(-1.0, 1.0), rand_engine, ref);
+    }
+
+    // a random block pattern in which every block is dense
+    std::unique_ptr<Csr> gen_blocked_mtx(int block_size)
+    {
+        auto pattern = gko::test::generate_random_matrix<Csr>(
+            num_block_rows, num_block_cols,
+            std::uniform_int_distribution<>(0, 10),
+            std::normal_distribution<>(-1.0, 1.0), rand_engine, ref);
+        gko::matrix_data<value_type, index_type> pattern_data;
+        pattern->write(pattern_data);
+        gko::matrix_data<value_type, index_type> data{
+            gko::dim<2>{static_cast<gko::size_type>(num_block_rows) *
+                            block_size,
+                        static_cast<gko::size_type>(num_block_cols) *
+                            block_size}};
+        std::normal_distribution<> value_dist(-1.0, 1.0);
+        for (const auto& block : pattern_data.nonzeros) {
+            for (int i = 0; i < block_size; i++) {
+                for (int j = 0; j < block_size; j++) {
+                    data.nonzeros.emplace_back(
+                        block.row * block_size + i,
+                        block.column * block_size + j,
+                        gko::test::detail::get_rand_value<value_type>(
+                            value_dist, rand_engine));
+                }
+            }
+        }
+        data.ensure_row_major_order();
+        auto result = Csr::create(ref);
+        result->read(data);
+        return result;
+    }
+
+    void set_up_apply_data(int block_size, int num_rhs = 1)
+    {
+        csr = gen_blocked_mtx(block_size);
+        mtx = Mtx::create(ref, block_size);
+        csr->convert_to(mtx.get());
+        expected = gen_vec(num_block_rows * block_size, num_rhs);
+        y = gen_vec(num_block_cols * block_size, num_rhs);
+        alpha = gko::initialize<Vec>({2.0}, ref);
+        beta = gko::initialize<Vec>({-1.0}, ref);
+        dcsr = gko::clone(exec, csr);
+        dmtx = gko::clone(exec, mtx);
+        dresult = gko::clone(exec, expected);
+        dy = gko::clone(exec, y);
+        dalpha = gko::clone(exec, alpha);
+        dbeta = gko::clone(exec, beta);
+    }
+
+    // block sizes with an unrolled kernel, and one using the generic kernel
+    const std::vector<int> block_sizes{1, 2, 3, 4, 7, 8, 11};
+    const int num_block_rows = 123;
+    const int num_block_cols = 97;
+    std::default_random_engine rand_engine;
+
+    std::unique_ptr<Csr> csr;
+    std::unique_ptr<Mtx> mtx;
+    std::unique_ptr<Vec> expected;
+    std::unique_ptr<Vec> y;
+    std::unique_ptr<Vec> alpha;
+    std::unique_ptr<Vec> beta;
+
+    std::unique_ptr<Csr> dcsr;
+    std::unique_ptr<Mtx> dmtx;
+    std::unique_ptr<Vec> dresult;
+    std::unique_ptr<Vec> dy;
+    std::unique_ptr<Vec> dalpha;
+    std::unique_ptr<Vec> dbeta;
+};
+
+
+TEST_F(BlockEll, SimpleApplyIsEquivalentToRef)
+{
+    for (auto block_size : block_sizes) {
+        SCOPED_TRACE(block_size);
+        set_up_apply_data(block_size);
+
+        mtx->apply(y.get(), expected.get());
+        dmtx->apply(dy.get(), dresult.get());
+
+        GKO_ASSERT_MTX_NEAR(dresult, expected, r<value_type>::value);
+    }
+}
+
+
+TEST_F(BlockEll, SimpleApplyToMultipleVectorsIsEquivalentToRef)
+{
+    for (auto block_size : block_sizes) {
+        SCOPED_TRACE(block_size);
+        set_up_apply_data(block_size, 3);
+
+        mtx->apply(y.get(), expected.get());
+        dmtx->apply(dy.get(), dresult.get());
+
+        GKO_ASSERT_MTX_NEAR(dresult, expected, r<value_type>::value);
+    }
+}
+
+
+TEST_F(BlockEll, AdvancedApplyIsEquivalentToRef)
+{
+    for (auto block_size : block_sizes) {
+        SCOPED_TRACE(block_size);
+        set_up_apply_data(block_size, 2);
+
+        mtx->apply(alpha.get(), y.get(), beta.get(), expected.get());
+        dmtx->apply(dalpha.get(), dy.get(), dbeta.get(), dresult.get());
+
+        GKO_ASSERT_MTX_NEAR(dresult, expected, r<value_type>::value);
+    }
+}
+
+
+TEST_F(BlockEll, ApplyIsEquivalentToCsr)
+{
+    set_up_apply_data(3);
+    auto csr_result = dresult->clone();
+
+    dmtx->apply(dy.get(), dresult.get());
+    dcsr->apply(dy.get(), csr_result.get());
+
+    GKO_ASSERT_MTX_NEAR(dresult, csr_result, r<value_type>::value);
+}
+
+
+TEST_F(BlockEll, ConvertFromCsrIsEquivalentToRef)
+{
+    for (auto block_size : block_sizes) {
+        SCOPED_TRACE(block_size);
+        set_up_apply_data(block_size);
+        auto dresult_mtx = Mtx::create(exec, block_size);
+
+        dcsr->convert_to(dresult_mtx.get());
+
+        ASSERT_EQ(dresult_mtx->get_num_stored_blocks_per_row(),
+                  mtx->get_num_stored_blocks_per_row());
+        GKO_ASSERT_ARRAY_EQ(
+            gko::array<index_type>::const_view(
+                exec, dresult_mtx->get_num_stored_elements() /
+                          (block_size * block_size),
+                dresult_mtx->get_const_col_idxs()),
+            gko::array<index_type>::const_view(
+                ref, mtx->get_num_stored_elements() /
+                         (block_size * block_size),
+                mtx->get_const_col_idxs()));
+        GKO_ASSERT_MTX_NEAR(dresult_mtx, mtx, 0.0);
+    }
+}
+
+
+TEST_F(BlockEll, ConvertToCsrIsEquivalentToRef)
+{
+    for (auto block_size : block_sizes) {
+        SCOPED_TRACE(block_size);
+        set_up_apply_data(block_size);
+        auto result_csr = Csr::create(ref);
+        auto dresult_csr = Csr::create(exec);
+
+        mtx->convert_to(result_csr.get());
+        dmtx->convert_to(dresult_csr.get());
+
+        GKO_ASSERT_MTX_EQ_SPARSITY(dresult_csr, result_csr);
+        GKO_ASSERT_MTX_NEAR(dresult_csr, result_csr, 0.0);
+    }
+}
+
+
+TEST_F(BlockEll, DetectsGeneratedBlockSize)
+{
+    set_up_apply_data(4);
+
+    ASSERT_EQ(Mtx::detect_block_size(dcsr.get()), 4);
+}
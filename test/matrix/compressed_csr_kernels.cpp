@@ -0,0 +1,231 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2022, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#include <ginkgo/core/matrix/compressed_csr.hpp>
+
+
+#include <random>
+
+
+#include <gtest/gtest.h>
+
+
+#include <ginkgo/core/base/executor.hpp>
+#include <ginkgo/core/matrix/csr.hpp>
+#include <ginkgo/core/matrix/dense.hpp>
+
+
+#include "core/matrix/compressed_csr_kernels.hpp"
+#include "core/test/utils.hpp"
+#include "test/utils/executor.hpp"
+
+
+class CompressedCsr : public CommonTestFixture {
+protected:
+    using Mtx = gko::matrix::CompressedCsr<value_type, index_type>;
+    using Csr = gko::matrix::Csr<value_type, index_type>;
+    using Vec = gko::matrix::Dense<value_type>;
+
+    CompressedCsr() : rand_engine(42) {}
+
+    std::unique_ptr<Vec> gen_vec(int num_rows, int num_cols)
+    {
+        return gko::test::generate_random_matrix<Vec>(
+            num_rows, num_cols,
+            std::uniform_int_distribution<>(num_cols, num_cols),
+            std::normal_distribution<>(-1.0, 1.0), rand_engine, ref);
+    }
+
+    void set_up_apply_data(int num_rhs = 1)
+    {
+        csr = gko::test::generate_random_matrix<Csr>(
+            mtx_size, mtx_size, std::uniform_int_distribution<>(1, mtx_size),
+            std::normal_distribution<>(-1.0, 1.0), rand_engine, ref);
+        set_up_matrix_and_vectors(mtx_size, num_rhs);
+    }
+
+    void set_up_band_apply_data(int num_rhs = 1)
+    {
+        csr = gko::test::generate_random_band_matrix<Csr>(
+            mtx_size, 3, 3, std::normal_distribution<>(-1.0, 1.0),
+            rand_engine, ref);
+        set_up_matrix_and_vectors(mtx_size, num_rhs);
+    }
+
+    void set_up_wide_apply_data(int num_rhs = 1)
+    {
+        // few nonzeros spread over many columns, so all delta widths occur
+        csr = gko::test::generate_random_matrix<Csr>(
+            mtx_size, wide_num_cols, std::uniform_int_distribution<>(0, 10),
+            std::normal_distribution<>(-1.0, 1.0), rand_engine, ref);
+        set_up_matrix_and_vectors(wide_num_cols, num_rhs);
+    }
+
+    void set_up_matrix_and_vectors(int num_cols, int num_rhs)
+    {
+        mtx = Mtx::create(ref);
+        csr->convert_to(mtx.get());
+        expected = gen_vec(mtx_size, num_rhs);
+        y = gen_vec(num_cols, num_rhs);
+        alpha = gko::initialize<Vec>({2.0}, ref);
+        beta = gko::initialize<Vec>({-1.0}, ref);
+        dcsr = gko::clone(exec, csr);
+        dmtx = gko::clone(exec, mtx);
+        dresult = gko::clone(exec, expected);
+        dy = gko::clone(exec, y);
+        dalpha = gko::clone(exec, alpha);
+        dbeta = gko::clone(exec, beta);
+    }
+
+    const int mtx_size = 357;
+    const int wide_num_cols = 100000;
+    std::default_random_engine rand_engine;
+
+    std::unique_ptr<Csr> csr;
+    std::unique_ptr<Mtx> mtx;
+    std::unique_ptr<Vec> expected;
+    std::unique_ptr<Vec> y;
+    std::unique_ptr<Vec> alpha;
+    std::unique_ptr<Vec> beta;
+
+    std::unique_ptr<Csr> dcsr;
+    std::unique_ptr<Mtx> dmtx;
+    std::unique_ptr<Vec> dresult;
+    std::unique_ptr<Vec> dy;
+    std::unique_ptr<Vec> dalpha;
+    std::unique_ptr<Vec> dbeta;
+};
+
+
+TEST_F(CompressedCsr, SimpleApplyIsEquivalentToRef)
+{
+    set_up_apply_data();
+
+    mtx->apply(y.get(), expected.get());
+    dmtx->apply(dy.get(), dresult.get());
+
+    GKO_ASSERT_MTX_NEAR(dresult, expected, r<value_type>::value);
+}
+
+
+TEST_F(CompressedCsr, SimpleApplyToMultipleVectorsIsEquivalentToRef)
+{
+    set_up_apply_data(3);
+
+    mtx->apply(y.get(), expected.get());
+    dmtx->apply(dy.get(), dresult.get());
+
+    GKO_ASSERT_MTX_NEAR(dresult, expected, r<value_type>::value);
+}
+
+
+TEST_F(CompressedCsr, AdvancedApplyIsEquivalentToRef)
+{
+    set_up_apply_data(2);
+
+    mtx->apply(alpha.get(), y.get(), beta.get(), expected.get());
+    dmtx->apply(dalpha.get(), dy.get(), dbeta.get(), dresult.get());
+
+    GKO_ASSERT_MTX_NEAR(dresult, expected, r<value_type>::value);
+}
+
+
+TEST_F(CompressedCsr, BandApplyIsEquivalentToRef)
+{
+    set_up_band_apply_data();
+
+    mtx->apply(y.get(), expected.get());
+    dmtx->apply(dy.get(), dresult.get());
+
+    GKO_ASSERT_MTX_NEAR(dresult, expected, r<value_type>::value);
+}
+
+
+TEST_F(CompressedCsr, WideApplyIsEquivalentToRef)
+{
+    set_up_wide_apply_data(2);
+
+    mtx->apply(alpha.get(), y.get(), beta.get(), expected.get());
+    dmtx->apply(dalpha.get(), dy.get(), dbeta.get(), dresult.get());
+
+    GKO_ASSERT_MTX_NEAR(dresult, expected, r<value_type>::value);
+}
+
+
+TEST_F(CompressedCsr, ApplyIsEquivalentToCsr)
+{
+    set_up_wide_apply_data();
+    auto csr_result = dresult->clone();
+
+    dmtx->apply(dy.get(), dresult.get());
+    dcsr->apply(dy.get(), csr_result.get());
+
+    GKO_ASSERT_MTX_NEAR(dresult, csr_result, r<value_type>::value);
+}
+
+
+TEST_F(CompressedCsr, ConvertFromCsrIsEquivalentToRef)
+{
+    set_up_wide_apply_data();
+    auto dresult_mtx = Mtx::create(exec);
+
+    dcsr->convert_to(dresult_mtx.get());
+
+    GKO_ASSERT_ARRAY_EQ(
+        gko::make_const_array_view(ref, mtx->get_size()[0],
+                                   mtx->get_const_col_widths()),
+        gko::make_const_array_view(exec, mtx->get_size()[0],
+                                   dresult_mtx->get_const_col_widths()));
+    GKO_ASSERT_ARRAY_EQ(
+        gko::make_const_array_view(ref, mtx->get_size()[0] + 1,
+                                   mtx->get_const_col_offsets()),
+        gko::make_const_array_view(exec, mtx->get_size()[0] + 1,
+                                   dresult_mtx->get_const_col_offsets()));
+    auto result = Csr::create(ref);
+    dresult_mtx->convert_to(result.get());
+    GKO_ASSERT_MTX_EQ_SPARSITY(result, csr);
+    GKO_ASSERT_MTX_NEAR(result, csr, 0.0);
+}
+
+
+TEST_F(CompressedCsr, ConvertToCsrIsEquivalentToRef)
+{
+    set_up_wide_apply_data();
+    auto result = Csr::create(ref);
+    auto dresult_csr = Csr::create(exec);
+
+    mtx->convert_to(result.get());
+    dmtx->convert_to(dresult_csr.get());
+
+    GKO_ASSERT_MTX_EQ_SPARSITY(dresult_csr, result);
+    GKO_ASSERT_MTX_NEAR(dresult_csr, result, 0.0);
+}
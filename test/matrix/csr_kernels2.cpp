@@ -64,7 +64,9 @@ class Csr : public CommonTestFixture {
 protected:
     using Arr = gko::array<int>;
     using Vec = gko::matrix::Dense<value_type>;
+    using MixedVec = gko::matrix::Dense<gko::next_precision<value_type>>;
     using Mtx = gko::matrix::Csr<value_type>;
+    using MixedMtx = gko::matrix::Csr<gko::next_precision<value_type>>;
     using ComplexVec = gko::matrix::Dense<std::complex<value_type>>;
     using ComplexMtx = gko::matrix::Csr<std::complex<value_type>>;
 
@@ -281,6 +283,93 @@ TEST_F(Csr, AdvancedApplyToDenseMatrixIsEquivalentToRefWithClassical)
 }
 
 
+TEST_F(Csr, MixedSimpleApplyIsEquivalentToRef)
+{
+    SKIP_IF_SINGLE_MODE;
+    set_up_apply_data<Mtx::classical>(2);
+    auto y2 = MixedVec::create(ref);
+    y->convert_to(y2.get());
+    auto dy2 = gko::clone(exec, y2);
+
+    mtx->apply(y2.get(), expected.get());
+    dmtx->apply(dy2.get(), dresult.get());
+
+    GKO_ASSERT_MTX_NEAR(dresult, expected, 1e-14);
+}
+
+
+TEST_F(Csr, MixedSimpleApplyToMixedOutputIsEquivalentToRef)
+{
+    SKIP_IF_SINGLE_MODE;
+    set_up_apply_data<Mtx::classical>(2);
+    auto expected2 = MixedVec::create(ref);
+    expected->convert_to(expected2.get());
+    auto dresult2 = gko::clone(exec, expected2);
+
+    mtx->apply(y.get(), expected2.get());
+    dmtx->apply(dy.get(), dresult2.get());
+
+    GKO_ASSERT_MTX_NEAR(dresult2, expected2, 1e-6);
+}
+
+
+TEST_F(Csr, MixedAdvancedApplyIsEquivalentToRef)
+{
+    SKIP_IF_SINGLE_MODE;
+    set_up_apply_data<Mtx::classical>(2);
+    auto y2 = MixedVec::create(ref);
+    y->convert_to(y2.get());
+    auto expected2 = MixedVec::create(ref);
+    expected->convert_to(expected2.get());
+    auto dy2 = gko::clone(exec, y2);
+    auto dresult2 = gko::clone(exec, expected2);
+
+    mtx->apply(alpha.get(), y2.get(), beta.get(), expected2.get());
+    dmtx->apply(dalpha.get(), dy2.get(), dbeta.get(), dresult2.get());
+
+    GKO_ASSERT_MTX_NEAR(dresult2, expected2, 1e-6);
+}
+
+
+#ifdef GINKGO_MIXED_PRECISION
+
+
+TEST_F(Csr, MixedMatrixSimpleApplyAccumulatesInVectorPrecision)
+{
+    SKIP_IF_SINGLE_MODE;
+    set_up_apply_data<Mtx::classical>(2);
+    auto mixed_mtx = MixedMtx::create(ref);
+    mtx->convert_to(mixed_mtx.get());
+    // the reference product uses the rounded matrix in full precision
+    mixed_mtx->convert_to(mtx.get());
+    auto dmixed_mtx = gko::clone(exec, mixed_mtx);
+
+    mtx->apply(y.get(), expected.get());
+    dmixed_mtx->apply(dy.get(), dresult.get());
+
+    GKO_ASSERT_MTX_NEAR(dresult, expected, r<value_type>::value);
+}
+
+
+TEST_F(Csr, MixedMatrixAdvancedApplyAccumulatesInVectorPrecision)
+{
+    SKIP_IF_SINGLE_MODE;
+    set_up_apply_data<Mtx::classical>(2);
+    auto mixed_mtx = MixedMtx::create(ref);
+    mtx->convert_to(mixed_mtx.get());
+    mixed_mtx->convert_to(mtx.get());
+    auto dmixed_mtx = gko::clone(exec, mixed_mtx);
+
+    mtx->apply(alpha.get(), y.get(), beta.get(), expected.get());
+    dmixed_mtx->apply(dalpha.get(), dy.get(), dbeta.get(), dresult.get());
+
+    GKO_ASSERT_MTX_NEAR(dresult, expected, r<value_type>::value);
+}
+
+
+#endif  // GINKGO_MIXED_PRECISION
+
+
 // OpenMP doesn't have strategies
 #ifndef GKO_COMPILING_OMP
 
@@ -549,6 +638,59 @@ TEST_F(Csr, SimpleApplySparseToSparseCsrMatrixIsEquivalentToRef)
 }
 
 
+TEST_F(Csr, SimpleApplyToWideSparseCsrMatrixIsEquivalentToRef)
+{
+    set_up_apply_data<Mtx::classical>();
+    auto mtx1 = gen_mtx<Mtx>(mtx->get_size()[0], mtx->get_size()[1], 0, 10);
+    auto mtx2 = gen_mtx<Mtx>(mtx->get_size()[1], 20000, 0, 10);
+    auto dmtx1 = gko::clone(exec, mtx1);
+    auto dmtx2 = gko::clone(exec, mtx2);
+    auto result = Mtx::create(ref, gko::dim<2>{mtx->get_size()[0], 20000});
+    auto dresult = Mtx::create(exec, result->get_size());
+
+    mtx1->apply(mtx2.get(), result.get());
+    dmtx1->apply(dmtx2.get(), dresult.get());
+
+    GKO_ASSERT_MTX_EQ_SPARSITY(dresult, result);
+    GKO_ASSERT_MTX_NEAR(dresult, result, r<value_type>::value);
+    ASSERT_TRUE(dresult->is_sorted_by_column_index());
+}
+
+
+TEST_F(Csr, MultiplyMaskedIsEquivalentToRef)
+{
+    set_up_apply_data<Mtx::classical>();
+    auto mtx1 = gen_mtx<Mtx>(mtx->get_size()[0], mtx->get_size()[1], 0, 10);
+    auto mtx2 =
+        gen_mtx<Mtx>(mtx->get_size()[1], square_mtx->get_size()[1], 0, 10);
+    auto mask =
+        gen_mtx<Mtx>(mtx->get_size()[0], square_mtx->get_size()[1], 0, 20);
+    auto dmtx1 = gko::clone(exec, mtx1);
+    auto dmtx2 = gko::clone(exec, mtx2);
+    auto dmask = gko::clone(exec, mask);
+
+    mtx1->multiply_masked(mtx2.get(), mask.get());
+    dmtx1->multiply_masked(dmtx2.get(), dmask.get());
+
+    GKO_ASSERT_MTX_EQ_SPARSITY(dmask, mask);
+    GKO_ASSERT_MTX_NEAR(dmask, mask, r<value_type>::value);
+}
+
+
+TEST_F(Csr, MultiplyMaskedRecomputesProduct)
+{
+    set_up_apply_data<Mtx::classical>();
+    auto trans = gko::as<Mtx>(dmtx->transpose());
+    dmtx->apply(trans.get(), square_dmtx.get());
+    auto product = gko::clone(square_dmtx);
+    square_dmtx->scale(gko::initialize<Vec>({0.0}, exec).get());
+
+    dmtx->multiply_masked(trans.get(), square_dmtx.get());
+
+    GKO_ASSERT_MTX_NEAR(square_dmtx, product, r<value_type>::value);
+}
+
+
 // TODO: broken in ROCm <= 4.5
 #ifndef GKO_COMPILING_HIP
 
@@ -649,6 +791,33 @@ TEST_F(Csr, Transpose64IsEquivalentToRef)
 }
 
 
+TEST_F(Csr, TransposeTallMatrixIsEquivalentToRef)
+{
+    // many nonzeros per column allow splitting the rows among threads
+    auto mtx = gen_mtx<Mtx>(2345, 47, 0, 10);
+    auto dmtx = gko::clone(exec, mtx);
+
+    auto trans = gko::as<Mtx>(mtx->transpose());
+    auto d_trans = gko::as<Mtx>(dmtx->transpose());
+
+    GKO_ASSERT_MTX_NEAR(d_trans, trans, 0.0);
+    ASSERT_TRUE(d_trans->is_sorted_by_column_index());
+}
+
+
+TEST_F(Csr, TransposeWideMatrixIsEquivalentToRef)
+{
+    auto mtx = gen_mtx<Mtx>(47, 2345, 0, 20);
+    auto dmtx = gko::clone(exec, mtx);
+
+    auto trans = gko::as<Mtx>(mtx->transpose());
+    auto d_trans = gko::as<Mtx>(dmtx->transpose());
+
+    GKO_ASSERT_MTX_NEAR(d_trans, trans, 0.0);
+    ASSERT_TRUE(d_trans->is_sorted_by_column_index());
+}
+
+
 TEST_F(Csr, ConjugateTransposeIsEquivalentToRef)
 {
     set_up_apply_complex_data<ComplexMtx::classical>();
@@ -296,6 +296,55 @@ TEST_F(Dense, AdvancedApplyIsEquivalentToRef)
 }
 
 
+TEST_F(Dense, SimpleApplyLargeIsEquivalentToRef)
+{
+    // sizes are chosen to not be multiples of the cache blocking
+    auto a = gen_mtx<Mtx>(131, 517);
+    auto b = gen_mtx<Mtx>(517, 263);
+    auto c = gen_mtx<Mtx>(131, 263);
+    auto da = gko::clone(exec, a);
+    auto db = gko::clone(exec, b);
+    auto dc = gko::clone(exec, c);
+
+    a->apply(b.get(), c.get());
+    da->apply(db.get(), dc.get());
+
+    GKO_ASSERT_MTX_NEAR(dc, c, r<value_type>::value * 10);
+}
+
+
+TEST_F(Dense, AdvancedApplyLargeIsEquivalentToRef)
+{
+    set_up_apply_data();
+    auto a = gen_mtx<Mtx>(131, 517);
+    auto b = gen_mtx<Mtx>(517, 263);
+    auto c = gen_mtx<Mtx>(131, 263);
+    auto da = gko::clone(exec, a);
+    auto db = gko::clone(exec, b);
+    auto dc = gko::clone(exec, c);
+
+    a->apply(alpha.get(), b.get(), beta.get(), c.get());
+    da->apply(dalpha.get(), db.get(), dbeta.get(), dc.get());
+
+    GKO_ASSERT_MTX_NEAR(dc, c, r<value_type>::value * 10);
+}
+
+
+TEST_F(Dense, AdvancedApplyToFewColumnsIsEquivalentToRef)
+{
+    set_up_apply_data();
+    auto b = gen_mtx<Mtx>(25, 3);
+    auto c = gen_mtx<Mtx>(65, 3);
+    auto db = gko::clone(exec, b);
+    auto dc = gko::clone(exec, c);
+
+    x->apply(alpha.get(), b.get(), beta.get(), c.get());
+    dx->apply(dalpha.get(), db.get(), dbeta.get(), dc.get());
+
+    GKO_ASSERT_MTX_NEAR(dc, c, r<value_type>::value);
+}
+
+
 TEST_F(Dense, AdvancedApplyMixedIsEquivalentToRef)
 {
     set_up_apply_data();
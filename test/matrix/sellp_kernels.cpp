@@ -85,6 +85,18 @@ protected:
         dbeta = gko::clone(exec, beta);
     }
 
+    void set_up_sorted_apply_matrix(int total_cols, int slice_size,
+                                    int sorting_window)
+    {
+        set_up_apply_matrix(total_cols);
+        auto csr = gen_mtx<gko::matrix::Csr<value_type>>(532, 231);
+        mtx = Mtx::create(ref, gko::dim<2>{}, slice_size,
+                          gko::matrix::default_stride_factor, 0,
+                          sorting_window);
+        csr->convert_to(mtx.get());
+        dmtx = gko::clone(exec, mtx);
+    }
+
     std::default_random_engine rand_engine;
 
     std::unique_ptr<Mtx> mtx;
@@ -125,6 +137,29 @@ TEST_F(Sellp, AdvancedApplyIsEquivalentToRef)
 }
 
 
+TEST_F(Sellp, ApplyIgnoresPaddingEntries)
+{
+    set_up_apply_matrix(3);
+    // padding entries must not pick up the NaNs in the first row of y, which
+    // is never referenced by the matrix
+    auto dense = gen_mtx(532, 231);
+    for (gko::size_type row = 0; row < dense->get_size()[0]; row++) {
+        dense->at(row, 0) = gko::zero<value_type>();
+    }
+    dense->convert_to(mtx.get());
+    dmtx = gko::clone(exec, mtx);
+    for (gko::size_type col = 0; col < y->get_size()[1]; col++) {
+        y->at(0, col) = gko::nan<value_type>();
+    }
+    dy = gko::clone(exec, y);
+
+    mtx->apply(y.get(), expected.get());
+    dmtx->apply(dy.get(), dresult.get());
+
+    GKO_ASSERT_MTX_NEAR(dresult, expected, r<value_type>::value);
+}
+
+
 TEST_F(Sellp, SimpleApplyWithSliceSizeAndStrideFactorIsEquivalentToRef)
 {
     set_up_apply_matrix(1, 32, 2);
@@ -223,6 +258,47 @@ TEST_F(Sellp, AdvancedApplyToComplexIsEquivalentToRef)
 }
 
 
+TEST_F(Sellp, SimpleApplyWithSortingWindowIsEquivalentToRef)
+{
+    for (auto slice_size : {16, 8, 12, 7}) {
+        SCOPED_TRACE(slice_size);
+        set_up_sorted_apply_matrix(1, slice_size, 64);
+
+        mtx->apply(y.get(), expected.get());
+        dmtx->apply(dy.get(), dresult.get());
+
+        GKO_ASSERT_MTX_NEAR(dresult, expected, r<value_type>::value);
+    }
+}
+
+
+TEST_F(Sellp, AdvancedApplyMultipleRHSWithSortingWindowIsEquivalentToRef)
+{
+    for (auto slice_size : {16, 8, 12, 7}) {
+        SCOPED_TRACE(slice_size);
+        set_up_sorted_apply_matrix(7, slice_size, 64);
+
+        mtx->apply(alpha.get(), y.get(), beta.get(), expected.get());
+        dmtx->apply(dalpha.get(), dy.get(), dbeta.get(), dresult.get());
+
+        GKO_ASSERT_MTX_NEAR(dresult, expected, r<value_type>::value);
+    }
+}
+
+
+TEST_F(Sellp, SortedApplyIsEquivalentToCsr)
+{
+    set_up_sorted_apply_matrix(3, 8, 32);
+    auto csr = gko::matrix::Csr<value_type>::create(ref);
+    mtx->convert_to(csr.get());
+
+    csr->apply(y.get(), expected.get());
+    dmtx->apply(dy.get(), dresult.get());
+
+    GKO_ASSERT_MTX_NEAR(dresult, expected, r<value_type>::value);
+}
+
+
 TEST_F(Sellp, ConvertToDenseIsEquivalentToRef)
 {
     set_up_apply_matrix(64);
@@ -0,0 +1,250 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2022, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#include <ginkgo/core/matrix/stencil.hpp>
+
+
+#include <random>
+#include <vector>
+
+
+#include <gtest/gtest.h>
+
+
+#include <ginkgo/core/base/executor.hpp>
+#include <ginkgo/core/matrix/csr.hpp>
+#include <ginkgo/core/matrix/dense.hpp>
+
+
+#include "core/matrix/stencil_kernels.hpp"
+#include "core/test/utils.hpp"
+#include "test/utils/executor.hpp"
+
+
+class Stencil : public CommonTestFixture {
+protected:
+    using Mtx = gko::matrix::Stencil<value_type, index_type>;
+    using Csr = gko::matrix::Csr<value_type, index_type>;
+    using Vec = gko::matrix::Dense<value_type>;
+
+    Stencil() : rand_engine(42) {}
+
+    std::unique_ptr<Vec> gen_vec(int num_rows, int num_cols)
+    {
+        return gko::test::generate_random_matrix<Vec>(
+            num_rows, num_cols,
+            std::uniform_int_distribution<>(num_cols, num_cols),
+            std::normal_distribution<>(-1.0, 1.0), rand_engine, ref);
+    }
+
+    void set_up_apply_data(gko::dim<3> grid, bool variable,
+                           int num_rhs = 1)
+    {
+        // 19-point stencil: all neighbors except for the corners of the cube
+        std::vector<index_type> offsets;
+        for (index_type dz = -1; dz <= 1; dz++) {
+            for (index_type dy = -1; dy <= 1; dy++) {
+                for (index_type dx = -1; dx <= 1; dx++) {
+                    if (dx != 0 && dy != 0 && dz != 0) {
+                        continue;
+                    }
+                    offsets.insert(offsets.end(), {dx, dy, dz});
+                }
+            }
+        }
+        const auto num_rows = static_cast<int>(grid[0] * grid[1] * grid[2]);
+        const auto num_points = static_cast<int>(offsets.size() / 3);
+        auto coeffs = gen_vec(variable ? num_points * num_rows : num_points, 1);
+        mtx = Mtx::create(
+            ref, grid,
+            gko::array<index_type>{ref, offsets.begin(), offsets.end()},
+            gko::array<value_type>{
+                ref, coeffs->get_const_values(),
+                coeffs->get_const_values() + coeffs->get_size()[0]});
+        expected = gen_vec(num_rows, num_rhs);
+        y = gen_vec(num_rows, num_rhs);
+        alpha = gko::initialize<Vec>({2.0}, ref);
+        beta = gko::initialize<Vec>({-1.0}, ref);
+        dmtx = gko::clone(exec, mtx);
+        dresult = gko::clone(exec, expected);
+        dy = gko::clone(exec, y);
+        dalpha = gko::clone(exec, alpha);
+        dbeta = gko::clone(exec, beta);
+    }
+
+    // the first dimension spans several tiles with a partial one at the end
+    const gko::dim<3> grid_size{300, 7, 5};
+    std::default_random_engine rand_engine;
+
+    std::unique_ptr<Mtx> mtx;
+    std::unique_ptr<Vec> expected;
+    std::unique_ptr<Vec> y;
+    std::unique_ptr<Vec> alpha;
+    std::unique_ptr<Vec> beta;
+
+    std::unique_ptr<Mtx> dmtx;
+    std::unique_ptr<Vec> dresult;
+    std::unique_ptr<Vec> dy;
+    std::unique_ptr<Vec> dalpha;
+    std::unique_ptr<Vec> dbeta;
+};
+
+
+TEST_F(Stencil, SimpleApplyIsEquivalentToRef)
+{
+    set_up_apply_data(grid_size, false);
+
+    mtx->apply(y.get(), expected.get());
+    dmtx->apply(dy.get(), dresult.get());
+
+    GKO_ASSERT_MTX_NEAR(dresult, expected, r<value_type>::value);
+}
+
+
+TEST_F(Stencil, SimpleApplyToMultipleVectorsIsEquivalentToRef)
+{
+    set_up_apply_data(grid_size, false, 3);
+
+    mtx->apply(y.get(), expected.get());
+    dmtx->apply(dy.get(), dresult.get());
+
+    GKO_ASSERT_MTX_NEAR(dresult, expected, r<value_type>::value);
+}
+
+
+TEST_F(Stencil, AdvancedApplyIsEquivalentToRef)
+{
+    set_up_apply_data(grid_size, false, 3);
+
+    mtx->apply(alpha.get(), y.get(), beta.get(), expected.get());
+    dmtx->apply(dalpha.get(), dy.get(), dbeta.get(), dresult.get());
+
+    GKO_ASSERT_MTX_NEAR(dresult, expected, r<value_type>::value);
+}
+
+
+TEST_F(Stencil, VariableApplyIsEquivalentToRef)
+{
+    set_up_apply_data(grid_size, true, 3);
+
+    mtx->apply(y.get(), expected.get());
+    dmtx->apply(dy.get(), dresult.get());
+
+    GKO_ASSERT_MTX_NEAR(dresult, expected, r<value_type>::value);
+}
+
+
+TEST_F(Stencil, VariableAdvancedApplyIsEquivalentToRef)
+{
+    set_up_apply_data(grid_size, true);
+
+    mtx->apply(alpha.get(), y.get(), beta.get(), expected.get());
+    dmtx->apply(dalpha.get(), dy.get(), dbeta.get(), dresult.get());
+
+    GKO_ASSERT_MTX_NEAR(dresult, expected, r<value_type>::value);
+}
+
+
+TEST_F(Stencil, OneDimensionalApplyIsEquivalentToRef)
+{
+    set_up_apply_data(gko::dim<3>{1000, 1, 1}, false);
+
+    mtx->apply(y.get(), expected.get());
+    dmtx->apply(dy.get(), dresult.get());
+
+    GKO_ASSERT_MTX_NEAR(dresult, expected, r<value_type>::value);
+}
+
+
+TEST_F(Stencil, TwoDimensionalApplyIsEquivalentToRef)
+{
+    set_up_apply_data(gko::dim<3>{300, 40, 1}, true);
+
+    mtx->apply(y.get(), expected.get());
+    dmtx->apply(dy.get(), dresult.get());
+
+    GKO_ASSERT_MTX_NEAR(dresult, expected, r<value_type>::value);
+}
+
+
+TEST_F(Stencil, ApplyOnManyLinesAndPlanesIsEquivalentToRef)
+{
+    set_up_apply_data(gko::dim<3>{40, 37, 11}, false, 2);
+
+    mtx->apply(y.get(), expected.get());
+    dmtx->apply(dy.get(), dresult.get());
+
+    GKO_ASSERT_MTX_NEAR(dresult, expected, r<value_type>::value);
+}
+
+
+TEST_F(Stencil, ConvertToCsrIsEquivalentToRef)
+{
+    set_up_apply_data(grid_size, false);
+    auto csr = Csr::create(ref);
+    auto dcsr = Csr::create(exec);
+
+    mtx->convert_to(csr.get());
+    dmtx->convert_to(dcsr.get());
+
+    GKO_ASSERT_MTX_NEAR(dcsr, csr, 0.0);
+    GKO_ASSERT_MTX_EQ_SPARSITY(dcsr, csr);
+    ASSERT_TRUE(dcsr->is_sorted_by_column_index());
+}
+
+
+TEST_F(Stencil, ConvertVariableToCsrIsEquivalentToRef)
+{
+    set_up_apply_data(grid_size, true);
+    auto csr = Csr::create(ref);
+    auto dcsr = Csr::create(exec);
+
+    mtx->convert_to(csr.get());
+    dmtx->convert_to(dcsr.get());
+
+    GKO_ASSERT_MTX_NEAR(dcsr, csr, 0.0);
+    GKO_ASSERT_MTX_EQ_SPARSITY(dcsr, csr);
+}
+
+
+TEST_F(Stencil, ApplyIsEquivalentToCsr)
+{
+    set_up_apply_data(grid_size, true, 3);
+    auto dcsr = Csr::create(exec);
+    dmtx->convert_to(dcsr.get());
+    auto dexpected = dresult->clone();
+
+    dcsr->apply(dy.get(), dexpected.get());
+    dmtx->apply(dy.get(), dresult.get());
+
+    GKO_ASSERT_MTX_NEAR(dresult, dexpected, r<value_type>::value);
+}
@@ -0,0 +1,223 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2022, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#include <ginkgo/core/matrix/symmetric_csr.hpp>
+
+
+#include <random>
+
+
+#include <gtest/gtest.h>
+
+
+#include <ginkgo/core/base/executor.hpp>
+#include <ginkgo/core/matrix/csr.hpp>
+#include <ginkgo/core/matrix/dense.hpp>
+
+
+#include "core/matrix/symmetric_csr_kernels.hpp"
+#include "core/test/utils.hpp"
+#include "test/utils/executor.hpp"
+
+
+class SymmetricCsr : public CommonTestFixture {
+protected:
+    using Mtx = gko::matrix::SymmetricCsr<value_type, index_type>;
+    using Csr = gko::matrix::Csr<value_type, index_type>;
+    using Vec = gko::matrix::Dense<value_type>;
+    using ComplexMtx =
+        gko::matrix::SymmetricCsr<std::complex<value_type>, index_type>;
+    using ComplexCsr = gko::matrix::Csr<std::complex<value_type>, index_type>;
+    using ComplexVec = gko::matrix::Dense<std::complex<value_type>>;
+
+    SymmetricCsr() : rand_engine(42) {}
+
+    template <typename MtxType = Vec, typename... Args>
+    std::unique_ptr<MtxType> gen_mtx(int num_rows, int num_cols,
+                                     int min_nnz_row, Args&&... args)
+    {
+        return gko::test::generate_random_matrix<MtxType>(
+            num_rows, num_cols,
+            std::uniform_int_distribution<>(min_nnz_row, num_cols),
+            std::normal_distribution<>(-1.0, 1.0), rand_engine, ref,
+            std::forward<Args>(args)...);
+    }
+
+    void set_up_apply_data(int num_rhs = 1)
+    {
+        mtx = gen_mtx<Mtx>(mtx_size, mtx_size, 1);
+        set_up_vectors(num_rhs);
+    }
+
+    void set_up_band_apply_data(int num_rhs = 1)
+    {
+        mtx = gko::test::generate_random_band_matrix<Mtx>(
+            mtx_size, 3, 3, std::normal_distribution<>(-1.0, 1.0),
+            rand_engine, ref);
+        set_up_vectors(num_rhs);
+    }
+
+    void set_up_vectors(int num_rhs)
+    {
+        expected = gen_mtx(mtx_size, num_rhs, 1);
+        y = gen_mtx(mtx_size, num_rhs, 1);
+        alpha = gko::initialize<Vec>({2.0}, ref);
+        beta = gko::initialize<Vec>({-1.0}, ref);
+        dmtx = gko::clone(exec, mtx);
+        dresult = gko::clone(exec, expected);
+        dy = gko::clone(exec, y);
+        dalpha = gko::clone(exec, alpha);
+        dbeta = gko::clone(exec, beta);
+    }
+
+    const int mtx_size = 357;
+    std::default_random_engine rand_engine;
+
+    std::unique_ptr<Mtx> mtx;
+    std::unique_ptr<Vec> expected;
+    std::unique_ptr<Vec> y;
+    std::unique_ptr<Vec> alpha;
+    std::unique_ptr<Vec> beta;
+
+    std::unique_ptr<Mtx> dmtx;
+    std::unique_ptr<Vec> dresult;
+    std::unique_ptr<Vec> dy;
+    std::unique_ptr<Vec> dalpha;
+    std::unique_ptr<Vec> dbeta;
+};
+
+
+TEST_F(SymmetricCsr, SimpleApplyIsEquivalentToRef)
+{
+    set_up_apply_data();
+
+    mtx->apply(y.get(), expected.get());
+    dmtx->apply(dy.get(), dresult.get());
+
+    GKO_ASSERT_MTX_NEAR(dresult, expected, r<value_type>::value);
+}
+
+
+TEST_F(SymmetricCsr, SimpleApplyToMultipleVectorsIsEquivalentToRef)
+{
+    set_up_apply_data(3);
+
+    mtx->apply(y.get(), expected.get());
+    dmtx->apply(dy.get(), dresult.get());
+
+    GKO_ASSERT_MTX_NEAR(dresult, expected, r<value_type>::value);
+}
+
+
+TEST_F(SymmetricCsr, AdvancedApplyIsEquivalentToRef)
+{
+    set_up_apply_data(3);
+
+    mtx->apply(alpha.get(), y.get(), beta.get(), expected.get());
+    dmtx->apply(dalpha.get(), dy.get(), dbeta.get(), dresult.get());
+
+    GKO_ASSERT_MTX_NEAR(dresult, expected, r<value_type>::value);
+}
+
+
+TEST_F(SymmetricCsr, BandApplyIsEquivalentToRef)
+{
+    set_up_band_apply_data(2);
+
+    mtx->apply(alpha.get(), y.get(), beta.get(), expected.get());
+    dmtx->apply(dalpha.get(), dy.get(), dbeta.get(), dresult.get());
+
+    GKO_ASSERT_MTX_NEAR(dresult, expected, r<value_type>::value);
+}
+
+
+TEST_F(SymmetricCsr, ApplyIsEquivalentToExpandedCsr)
+{
+    set_up_apply_data(2);
+    auto csr = Csr::create(ref);
+    mtx->convert_to(csr.get());
+
+    csr->apply(y.get(), expected.get());
+    dmtx->apply(dy.get(), dresult.get());
+
+    GKO_ASSERT_MTX_NEAR(dresult, expected, r<value_type>::value);
+}
+
+
+TEST_F(SymmetricCsr, HermitianApplyIsEquivalentToRef)
+{
+    auto cmtx = gen_mtx<ComplexMtx>(mtx_size, mtx_size, 1, gko::dim<2>{},
+                                    gko::size_type{}, true);
+    auto dcmtx = gko::clone(exec, cmtx);
+    auto b = gen_mtx<ComplexVec>(mtx_size, 2, 1);
+    auto db = gko::clone(exec, b);
+    auto x = gen_mtx<ComplexVec>(mtx_size, 2, 1);
+    auto dx = gko::clone(exec, x);
+
+    cmtx->apply(b.get(), x.get());
+    dcmtx->apply(db.get(), dx.get());
+
+    ASSERT_TRUE(dcmtx->is_hermitian());
+    GKO_ASSERT_MTX_NEAR(dx, x, r<value_type>::value);
+}
+
+
+TEST_F(SymmetricCsr, ConvertFromCsrIsEquivalentToRef)
+{
+    auto csr = gen_mtx<Csr>(mtx_size, mtx_size, 1);
+    auto dcsr = gko::clone(exec, csr);
+    auto result = Mtx::create(ref);
+    auto dresult = Mtx::create(exec);
+
+    csr->convert_to(result.get());
+    dcsr->convert_to(dresult.get());
+
+    GKO_ASSERT_MTX_NEAR(dresult, result, 0.0);
+    GKO_ASSERT_MTX_EQ_SPARSITY(dresult, result);
+}
+
+
+TEST_F(SymmetricCsr, ConvertToCsrIsEquivalentToRef)
+{
+    auto cmtx = gen_mtx<ComplexMtx>(mtx_size, mtx_size, 1, gko::dim<2>{},
+                                    gko::size_type{}, true);
+    auto dcmtx = gko::clone(exec, cmtx);
+    auto result = ComplexCsr::create(ref);
+    auto dresult = ComplexCsr::create(exec);
+
+    cmtx->convert_to(result.get());
+    dcmtx->convert_to(dresult.get());
+
+    GKO_ASSERT_MTX_NEAR(dresult, result, 0.0);
+    GKO_ASSERT_MTX_EQ_SPARSITY(dresult, result);
+    ASSERT_TRUE(dresult->is_sorted_by_column_index());
+}
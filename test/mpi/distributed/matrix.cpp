@@ -43,6 +43,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ginkgo/config.hpp>
 #include <ginkgo/core/base/array.hpp>
+#include <ginkgo/core/base/matrix_assembly_data.hpp>
 #include <ginkgo/core/base/matrix_data.hpp>
 #include <ginkgo/core/distributed/matrix.hpp>
 #include <ginkgo/core/distributed/partition.hpp>
@@ -150,6 +151,51 @@ TYPED_TEST(MatrixCreation, ReadsDistributedGlobalData)
 }
 
 
+TYPED_TEST(MatrixCreation, ReadsDistributedAssemblyData)
+{
+    using value_type = typename TestFixture::value_type;
+    using global_index_type = typename TestFixture::global_index_type;
+    using csr = typename TestFixture::local_matrix_type;
+    I<I<value_type>> res_local[] = {{{0, 1}, {0, 3}}, {{6, 0}, {0, 8}}, {{10}}};
+    I<I<value_type>> res_non_local[] = {
+        {{0, 2}, {4, 0}}, {{5, 0}, {0, 7}}, {{9}}};
+    auto rank = this->dist_mat->get_communicator().rank();
+    // every rank contributes to arbitrary rows, and all ranks contribute to
+    // the last diagonal entry
+    gko::matrix_assembly_data<value_type, global_index_type> data{this->size};
+    for (gko::size_type i = 0; i + 1 < this->mat_input.nonzeros.size(); i++) {
+        const auto& entry = this->mat_input.nonzeros[i];
+        if (static_cast<int>(i % 3) == rank) {
+            data.add_value(entry.row, entry.column, entry.value);
+        }
+    }
+    data.add_value(4, 4, rank == 0 ? 4 : 3);
+
+    this->dist_mat->read_distributed(data, this->row_part.get());
+
+    GKO_ASSERT_MTX_NEAR(gko::as<csr>(this->dist_mat->get_local_matrix()),
+                        res_local[rank], 0);
+    GKO_ASSERT_MTX_NEAR(gko::as<csr>(this->dist_mat->get_non_local_matrix()),
+                        res_non_local[rank], 0);
+}
+
+
+TYPED_TEST(MatrixCreation, ReadsDistributedOnlyCommunicatesWithNeighbors)
+{
+    using comm_index_type = gko::experimental::distributed::comm_index_type;
+    I<comm_index_type> send_neighbors[] = {{1, 2}, {0}, {1}};
+    I<comm_index_type> recv_neighbors[] = {{1}, {0, 2}, {0}};
+    auto rank = this->dist_mat->get_communicator().rank();
+
+    this->dist_mat->read_distributed(this->mat_input, this->row_part.get());
+
+    ASSERT_EQ(this->dist_mat->get_send_neighbors(),
+              std::vector<comm_index_type>(send_neighbors[rank]));
+    ASSERT_EQ(this->dist_mat->get_recv_neighbors(),
+              std::vector<comm_index_type>(recv_neighbors[rank]));
+}
+
+
 TYPED_TEST(MatrixCreation, ReadsDistributedLocalData)
 {
     using value_type = typename TestFixture::value_type;
@@ -188,6 +234,165 @@ TYPED_TEST(MatrixCreation, ReadsDistributedWithColPartition)
 }
 
 
+TYPED_TEST(MatrixCreation, RedistributesToNewPartition)
+{
+    using dist_mtx_type = typename TestFixture::dist_mtx_type;
+    using csr = typename TestFixture::local_matrix_type;
+    auto expected = dist_mtx_type::create(this->exec, this->comm);
+    expected->read_distributed(this->mat_input, this->col_part.get());
+    this->dist_mat->read_distributed(this->mat_input, this->row_part.get());
+
+    this->dist_mat->redistribute(this->col_part.get());
+
+    GKO_ASSERT_EQUAL_DIMENSIONS(this->dist_mat, expected);
+    GKO_ASSERT_MTX_NEAR(gko::as<csr>(this->dist_mat->get_local_matrix()),
+                        gko::as<csr>(expected->get_local_matrix()), 0);
+    GKO_ASSERT_MTX_NEAR(gko::as<csr>(this->dist_mat->get_non_local_matrix()),
+                        gko::as<csr>(expected->get_non_local_matrix()), 0);
+    ASSERT_EQ(this->dist_mat->get_send_neighbors(),
+              expected->get_send_neighbors());
+    ASSERT_EQ(this->dist_mat->get_recv_neighbors(),
+              expected->get_recv_neighbors());
+}
+
+
+TYPED_TEST(MatrixCreation, RedistributesWithColPartition)
+{
+    using dist_mtx_type = typename TestFixture::dist_mtx_type;
+    using csr = typename TestFixture::local_matrix_type;
+    auto expected = dist_mtx_type::create(this->exec, this->comm);
+    expected->read_distributed(this->mat_input, this->col_part.get(),
+                               this->row_part.get());
+    this->dist_mat->read_distributed(this->mat_input, this->row_part.get(),
+                                     this->col_part.get());
+
+    this->dist_mat->redistribute(this->col_part.get(), this->row_part.get());
+
+    GKO_ASSERT_MTX_NEAR(gko::as<csr>(this->dist_mat->get_local_matrix()),
+                        gko::as<csr>(expected->get_local_matrix()), 0);
+    GKO_ASSERT_MTX_NEAR(gko::as<csr>(this->dist_mat->get_non_local_matrix()),
+                        gko::as<csr>(expected->get_non_local_matrix()), 0);
+}
+
+
+TYPED_TEST(MatrixCreation, Transposes)
+{
+    using dist_mtx_type = typename TestFixture::dist_mtx_type;
+    using csr = typename TestFixture::local_matrix_type;
+    auto expected = dist_mtx_type::create(this->exec, this->comm);
+    auto transposed_input = this->mat_input;
+    for (auto& entry : transposed_input.nonzeros) {
+        std::swap(entry.row, entry.column);
+    }
+    transposed_input.ensure_row_major_order();
+    expected->read_distributed(transposed_input, this->col_part.get(),
+                               this->row_part.get());
+    this->dist_mat->read_distributed(this->mat_input, this->row_part.get(),
+                                     this->col_part.get());
+
+    auto result = gko::as<dist_mtx_type>(this->dist_mat->transpose());
+
+    GKO_ASSERT_EQUAL_DIMENSIONS(result, gko::transpose(this->size));
+    GKO_ASSERT_MTX_NEAR(gko::as<csr>(result->get_local_matrix()),
+                        gko::as<csr>(expected->get_local_matrix()), 0);
+    GKO_ASSERT_MTX_NEAR(gko::as<csr>(result->get_non_local_matrix()),
+                        gko::as<csr>(expected->get_non_local_matrix()), 0);
+}
+
+
+TYPED_TEST(MatrixCreation, ConjTransposes)
+{
+    using value_type = typename TestFixture::value_type;
+    using dist_mtx_type = typename TestFixture::dist_mtx_type;
+    using csr = typename TestFixture::local_matrix_type;
+    auto input = this->mat_input;
+    for (auto& entry : input.nonzeros) {
+        entry.value = gko::test::detail::get_rand_value<value_type>(
+            std::normal_distribution<gko::remove_complex<value_type>>(),
+            this->engine);
+    }
+    auto transposed_input = input;
+    for (auto& entry : transposed_input.nonzeros) {
+        std::swap(entry.row, entry.column);
+        entry.value = gko::conj(entry.value);
+    }
+    transposed_input.ensure_row_major_order();
+    auto expected = dist_mtx_type::create(this->exec, this->comm);
+    expected->read_distributed(transposed_input, this->row_part.get());
+    this->dist_mat->read_distributed(input, this->row_part.get());
+
+    auto result = gko::as<dist_mtx_type>(this->dist_mat->conj_transpose());
+
+    GKO_ASSERT_MTX_NEAR(gko::as<csr>(result->get_local_matrix()),
+                        gko::as<csr>(expected->get_local_matrix()), 0);
+    GKO_ASSERT_MTX_NEAR(gko::as<csr>(result->get_non_local_matrix()),
+                        gko::as<csr>(expected->get_non_local_matrix()), 0);
+}
+
+
+TYPED_TEST(MatrixCreation, MultipliesSameAsCsr)
+{
+    using value_type = typename TestFixture::value_type;
+    using global_index_type = typename TestFixture::global_index_type;
+    using dist_mtx_type = typename TestFixture::dist_mtx_type;
+    using csr = typename TestFixture::local_matrix_type;
+    using global_csr = gko::matrix::Csr<value_type, global_index_type>;
+    auto global_mtx = global_csr::create(this->exec);
+    auto global_product = global_csr::create(this->exec, this->size);
+    global_mtx->read(this->mat_input);
+    global_mtx->apply(global_mtx.get(), global_product.get());
+    typename TestFixture::matrix_data product_data;
+    global_product->write(product_data);
+    auto expected = dist_mtx_type::create(this->exec, this->comm);
+    expected->read_distributed(product_data, this->row_part.get(),
+                               this->row_part.get());
+    this->dist_mat->read_distributed(this->mat_input, this->row_part.get(),
+                                     this->col_part.get());
+    auto other = dist_mtx_type::create(this->exec, this->comm);
+    other->read_distributed(this->mat_input, this->col_part.get(),
+                            this->row_part.get());
+
+    auto result = this->dist_mat->multiply(other.get());
+
+    GKO_ASSERT_MTX_NEAR(gko::as<csr>(result->get_local_matrix()),
+                        gko::as<csr>(expected->get_local_matrix()),
+                        r<value_type>::value);
+    GKO_ASSERT_MTX_NEAR(gko::as<csr>(result->get_non_local_matrix()),
+                        gko::as<csr>(expected->get_non_local_matrix()),
+                        r<value_type>::value);
+}
+
+
+TYPED_TEST(MatrixCreation, MultiplyThrowsOnMismatchingPartitions)
+{
+    using dist_mtx_type = typename TestFixture::dist_mtx_type;
+    this->dist_mat->read_distributed(this->mat_input, this->row_part.get(),
+                                     this->col_part.get());
+    auto other = dist_mtx_type::create(this->exec, this->comm);
+    other->read_distributed(this->mat_input, this->row_part.get(),
+                            this->row_part.get());
+
+    ASSERT_THROW(this->dist_mat->multiply(other.get()),
+                 gko::UnsupportedMatrixProperty);
+}
+
+
+TYPED_TEST(MatrixCreation, MultiplyThrowsWithoutPartitions)
+{
+    using dist_mtx_type = typename TestFixture::dist_mtx_type;
+    auto other = dist_mtx_type::create(this->exec, this->comm);
+
+    ASSERT_THROW(this->dist_mat->multiply(other.get()),
+                 gko::UnsupportedMatrixProperty);
+}
+
+
+TYPED_TEST(MatrixCreation, TransposeThrowsWithoutPartitions)
+{
+    ASSERT_THROW(this->dist_mat->transpose(), gko::UnsupportedMatrixProperty);
+}
+
+
 #endif
 
 
@@ -254,10 +459,10 @@ public:
 
     void SetUp() override { ASSERT_EQ(comm.size(), 3); }
 
-    void assert_local_vector_equal_to_global_vector(const dist_vec_type* dist,
-                                                    const dense_vec_type* dense,
-                                                    const part_type* part,
-                                                    int rank)
+    void assert_local_vector_equal_to_global_vector(
+        const dist_vec_type* dist, const dense_vec_type* dense,
+        const part_type* part, int rank,
+        gko::remove_complex<value_type> tolerance = r<value_type>::value)
     {
         auto host_part = gko::clone(this->ref, part);
         auto range_bounds = host_part->get_range_bounds();
@@ -277,7 +482,7 @@ public:
         auto gathered_local = dense->row_gather(&gather_idxs_view);
 
         GKO_ASSERT_MTX_NEAR(dist->get_local_vector(), gathered_local.get(),
-                            r<value_type>::value);
+                            tolerance);
     }
 
     void init_large(gko::size_type num_rows, gko::size_type num_cols)
@@ -444,6 +649,246 @@ TYPED_TEST(Matrix, CanAdvancedApplyToMultipleVectorsLarge)
 }
 
 
+TYPED_TEST(Matrix, CanApplyToMultipleVectorsLargeWithInteriorBoundarySplit)
+{
+    this->init_large(100, 17);
+    this->dist_mat_large->set_overlap_mode(
+        gko::experimental::distributed::overlap_mode::interior_boundary);
+
+    this->dist_mat_large->apply(this->x.get(), this->y.get());
+    this->csr_mat->apply(this->dense_x.get(), this->dense_y.get());
+
+    this->assert_local_vector_equal_to_global_vector(
+        this->y.get(), this->dense_y.get(), this->row_part_large.get(),
+        this->comm.rank());
+}
+
+
+TYPED_TEST(Matrix, CanAdvancedApplyWithInteriorBoundarySplit)
+{
+    using value_type = typename TestFixture::value_type;
+    using index_type = typename TestFixture::global_index_type;
+    using part_type = typename TestFixture::part_type;
+    using dist_mtx_type = typename TestFixture::dist_mtx_type;
+    const index_type size = 30;
+    gko::matrix_data<value_type, index_type> mat_md{
+        gko::dim<2>{static_cast<gko::size_type>(size)}};
+    for (index_type row = 0; row < size; ++row) {
+        for (auto col : {row - 1, row, row + 1}) {
+            if (col >= 0 && col < size) {
+                mat_md.nonzeros.emplace_back(
+                    row, col, static_cast<value_type>(row + 2 * col + 1));
+            }
+        }
+    }
+    auto vec_md =
+        gko::test::generate_random_matrix_data<value_type, index_type>(
+            size, 3, std::uniform_int_distribution<int>(3, 3),
+            std::normal_distribution<gko::remove_complex<value_type>>(),
+            this->engine);
+    auto part = part_type::build_from_global_size_uniform(
+        this->exec, this->comm.size(), size);
+    auto dist_mat = dist_mtx_type::create(this->exec, this->comm);
+    dist_mat->read_distributed(mat_md, part.get());
+    dist_mat->set_overlap_mode(
+        gko::experimental::distributed::overlap_mode::interior_boundary);
+    this->csr_mat->read(mat_md);
+    this->x->read_distributed(vec_md, part.get());
+    this->y->read_distributed(vec_md, part.get());
+    this->dense_x->read(vec_md);
+    this->dense_y->read(vec_md);
+    auto rank = this->comm.rank();
+
+    dist_mat->apply(this->alpha.get(), this->x.get(), this->beta.get(),
+                    this->y.get());
+    this->csr_mat->apply(this->alpha.get(), this->dense_x.get(),
+                         this->beta.get(), this->dense_y.get());
+
+    ASSERT_EQ(dist_mat->get_boundary_rows().get_num_elems(),
+              rank == 1 ? 2 : 1);
+    ASSERT_EQ(dist_mat->get_interior_rows().get_num_elems(),
+              rank == 1 ? 8 : 9);
+    this->assert_local_vector_equal_to_global_vector(
+        this->y.get(), this->dense_y.get(), part.get(), rank);
+}
+
+
+TYPED_TEST(Matrix, CanApplyToMultipleVectorsLargeWithNodeAwareCommunication)
+{
+    this->init_large(100, 17);
+    this->dist_mat_large->set_node_aware_communication(true, 17);
+
+    this->dist_mat_large->apply(this->x.get(), this->y.get());
+    this->csr_mat->apply(this->dense_x.get(), this->dense_y.get());
+
+    ASSERT_TRUE(this->dist_mat_large->get_node_aware_communication());
+    ASSERT_EQ(this->dist_mat_large->get_node_aware_max_num_cols(), 17);
+    this->assert_local_vector_equal_to_global_vector(
+        this->y.get(), this->dense_y.get(), this->row_part_large.get(),
+        this->comm.rank());
+}
+
+
+TYPED_TEST(Matrix, CanApplyWithNodeAwareCommunicationEnabledBeforeRead)
+{
+    this->dist_mat_large->set_node_aware_communication(true, 17);
+    this->init_large(100, 17);
+
+    this->dist_mat_large->apply(this->x.get(), this->y.get());
+    this->csr_mat->apply(this->dense_x.get(), this->dense_y.get());
+
+    this->assert_local_vector_equal_to_global_vector(
+        this->y.get(), this->dense_y.get(), this->row_part_large.get(),
+        this->comm.rank());
+}
+
+
+TYPED_TEST(Matrix, AppliesToMoreColumnsThanNodeAwareCapacity)
+{
+    this->init_large(100, 17);
+    this->dist_mat_large->set_node_aware_communication(true, 4);
+
+    this->dist_mat_large->apply(this->x.get(), this->y.get());
+    this->csr_mat->apply(this->dense_x.get(), this->dense_y.get());
+
+    this->assert_local_vector_equal_to_global_vector(
+        this->y.get(), this->dense_y.get(), this->row_part_large.get(),
+        this->comm.rank());
+}
+
+
+TYPED_TEST(Matrix, UnpacksNodeLocalHaloValues)
+{
+    this->init_large(100, 17);
+    auto exact = gko::clone(this->dist_mat_large);
+    auto local_x = this->x->get_local_vector();
+    exact->communicate(local_x).wait();
+    exact->unpack_recv_buffer();
+    this->dist_mat_large->set_node_aware_communication(true, 17);
+
+    for (int i = 0; i < 3; i++) {
+        this->dist_mat_large->communicate(local_x).wait();
+        this->dist_mat_large->unpack_recv_buffer();
+
+        GKO_ASSERT_MTX_NEAR(this->dist_mat_large->get_recv_buffer(),
+                            exact->get_recv_buffer(), 0);
+    }
+}
+
+
+TYPED_TEST(Matrix, CanAdvancedApplyRepeatedlyWithNodeAwareCommunication)
+{
+    this->init_large(100, 17);
+    this->dist_mat_large->set_node_aware_communication(true, 17);
+    this->dist_mat_large->set_overlap_mode(
+        gko::experimental::distributed::overlap_mode::interior_boundary);
+
+    for (int i = 0; i < 3; i++) {
+        this->dist_mat_large->apply(this->alpha.get(), this->x.get(),
+                                    this->beta.get(), this->y.get());
+        this->csr_mat->apply(this->alpha.get(), this->dense_x.get(),
+                             this->beta.get(), this->dense_y.get());
+    }
+
+    this->assert_local_vector_equal_to_global_vector(
+        this->y.get(), this->dense_y.get(), this->row_part_large.get(),
+        this->comm.rank());
+}
+
+
+TYPED_TEST(Matrix, CopyKeepsNodeAwareCommunication)
+{
+    this->init_large(100, 17);
+    this->dist_mat_large->set_node_aware_communication(true, 17);
+    this->dist_mat_large->apply(this->x.get(), this->y.get());
+
+    auto copy = gko::clone(this->dist_mat_large);
+    copy->apply(this->x.get(), this->y.get());
+    this->csr_mat->apply(this->dense_x.get(), this->dense_y.get());
+
+    ASSERT_TRUE(copy->get_node_aware_communication());
+    this->assert_local_vector_equal_to_global_vector(
+        this->y.get(), this->dense_y.get(), this->row_part_large.get(),
+        this->comm.rank());
+}
+
+
+TYPED_TEST(Matrix, CanApplyToMultipleVectorsLargeWithReducedPrecisionComm)
+{
+    using value_type = typename TestFixture::value_type;
+    this->init_large(100, 17);
+    this->dist_mat_large->set_reduced_precision_communication(true);
+
+    this->dist_mat_large->apply(this->x.get(), this->y.get());
+    this->csr_mat->apply(this->dense_x.get(), this->dense_y.get());
+
+    this->assert_local_vector_equal_to_global_vector(
+        this->y.get(), this->dense_y.get(), this->row_part_large.get(),
+        this->comm.rank(),
+        r_mixed<value_type, gko::next_precision<value_type>>());
+}
+
+
+TYPED_TEST(Matrix, CanAdvancedApplyWithReducedPrecisionCommAndBoundarySplit)
+{
+    using value_type = typename TestFixture::value_type;
+    this->init_large(100, 17);
+    this->dist_mat_large->set_overlap_mode(
+        gko::experimental::distributed::overlap_mode::interior_boundary);
+    this->dist_mat_large->set_reduced_precision_communication(true);
+
+    this->dist_mat_large->apply(this->alpha.get(), this->x.get(),
+                                this->beta.get(), this->y.get());
+    this->csr_mat->apply(this->alpha.get(), this->dense_x.get(),
+                         this->beta.get(), this->dense_y.get());
+
+    this->assert_local_vector_equal_to_global_vector(
+        this->y.get(), this->dense_y.get(), this->row_part_large.get(),
+        this->comm.rank(),
+        r_mixed<value_type, gko::next_precision<value_type>>());
+}
+
+
+TYPED_TEST(Matrix, CanSwitchOffReducedPrecisionCommBetweenApplies)
+{
+    this->init_large(100, 17);
+    this->dist_mat_large->set_reduced_precision_communication(true);
+    this->dist_mat_large->apply(this->x.get(), this->y.get());
+    auto copy = gko::clone(this->dist_mat_large);
+
+    this->dist_mat_large->set_reduced_precision_communication(false);
+    this->dist_mat_large->apply(this->x.get(), this->y.get());
+    this->csr_mat->apply(this->dense_x.get(), this->dense_y.get());
+
+    ASSERT_TRUE(copy->get_reduced_precision_communication());
+    this->assert_local_vector_equal_to_global_vector(
+        this->y.get(), this->dense_y.get(), this->row_part_large.get(),
+        this->comm.rank());
+}
+
+
+TYPED_TEST(Matrix, UnpacksHaloWithPrecisionUsedByCommunicate)
+{
+    using value_type = typename TestFixture::value_type;
+    this->init_large(100, 17);
+    auto exact = gko::clone(this->dist_mat_large);
+    auto local_x = this->x->get_local_vector();
+    exact->communicate(local_x).wait();
+    exact->unpack_recv_buffer();
+    this->dist_mat_large->set_reduced_precision_communication(true);
+
+    auto req = this->dist_mat_large->communicate(local_x);
+    req.wait();
+    // changing the setting must not affect an exchange already started
+    this->dist_mat_large->set_reduced_precision_communication(false);
+    this->dist_mat_large->unpack_recv_buffer();
+
+    const auto tol = r_mixed<value_type, gko::next_precision<value_type>>();
+    GKO_ASSERT_MTX_NEAR(this->dist_mat_large->get_recv_buffer(),
+                        exact->get_recv_buffer(), tol);
+}
+
+
 TYPED_TEST(Matrix, CanConvertToNextPrecision)
 {
     using T = typename TestFixture::value_type;
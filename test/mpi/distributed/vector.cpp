@@ -44,6 +44,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ginkgo/core/base/array.hpp>
 #include <ginkgo/core/base/matrix_data.hpp>
 #include <ginkgo/core/distributed/partition.hpp>
+#include <ginkgo/core/distributed/reduction_batch.hpp>
 #include <ginkgo/core/distributed/vector.hpp>
 #include <ginkgo/core/log/logger.hpp>
 
@@ -307,6 +308,44 @@ TYPED_TEST(VectorCreation, CanReadLocalMatrixDataSomeEmpty)
 }
 
 
+TYPED_TEST(VectorCreation, CanRedistribute)
+{
+    using part_type = typename TestFixture::part_type;
+    using comm_index_type = gko::experimental::distributed::comm_index_type;
+    auto new_part = gko::share(part_type::build_from_mapping(
+        this->exec, {this->exec, I<comm_index_type>{2, 0, 1, 1, 0, 2}}, 3));
+    auto vec = TestFixture::dist_vec_type::create(this->exec, this->comm);
+    auto expected = TestFixture::dist_vec_type::create(this->exec, this->comm);
+    vec->read_distributed(this->md, this->part.get());
+    expected->read_distributed(this->md, new_part.get());
+
+    vec->redistribute(this->part.get(), new_part.get());
+
+    GKO_ASSERT_EQUAL_DIMENSIONS(vec, expected);
+    GKO_ASSERT_MTX_NEAR(vec->get_local_vector(), expected->get_local_vector(),
+                        0.0);
+}
+
+
+TYPED_TEST(VectorCreation, CanRedistributeSomeEmpty)
+{
+    using part_type = typename TestFixture::part_type;
+    auto new_part = gko::share(part_type::build_from_contiguous(
+        this->exec, {this->exec, {0, 0, 6, 6}}));
+    auto vec = TestFixture::dist_vec_type::create(this->exec, this->comm);
+    auto expected = TestFixture::dist_vec_type::create(this->exec, this->comm);
+    vec->read_distributed(this->md, this->part.get());
+    expected->read_distributed(this->md, new_part.get());
+
+    vec->redistribute(this->part.get(), new_part.get());
+
+    GKO_ASSERT_EQUAL_DIMENSIONS(vec->get_local_vector(),
+                                expected->get_local_vector());
+    GKO_ASSERT_MTX_NEAR(vec->get_local_vector(), expected->get_local_vector(),
+                        0.0);
+}
+
+
 #endif
 
 
@@ -543,6 +582,137 @@ TYPED_TEST(VectorReductions, ComputesNorm1WithTmpIsSameAsDense)
 }
 
 
+TYPED_TEST(VectorReductions, ReductionBatchIsSameAsDense)
+{
+    using value_type = typename TestFixture::value_type;
+    this->init_result();
+    auto conj_res = gko::clone(this->res);
+    auto dense_conj_res = gko::clone(this->dense_res);
+    gko::experimental::distributed::ReductionBatch<value_type> batch{
+        this->exec, this->comm};
+
+    batch.add_dot(this->x.get(), this->y.get(), this->res.get());
+    batch.add_conj_dot(this->x.get(), this->y.get(), conj_res.get());
+    batch.add_norm2(this->x.get(), this->real_res.get());
+    batch.reduce();
+    this->dense_x->compute_dot(this->dense_y.get(), this->dense_res.get());
+    this->dense_x->compute_conj_dot(this->dense_y.get(),
+                                    dense_conj_res.get());
+    this->dense_x->compute_norm2(this->dense_real_res.get());
+
+    ASSERT_EQ(batch.get_num_values(), 0);
+    GKO_ASSERT_MTX_NEAR(this->res, this->dense_res, r<value_type>::value);
+    GKO_ASSERT_MTX_NEAR(conj_res, dense_conj_res, r<value_type>::value);
+    GKO_ASSERT_MTX_NEAR(this->real_res, this->dense_real_res,
+                        r<value_type>::value);
+}
+
+
+TYPED_TEST(VectorReductions, ReductionBatchStartWaitIsSameAsDense)
+{
+    using value_type = typename TestFixture::value_type;
+    this->init_result();
+    gko::experimental::distributed::ReductionBatch<value_type> batch{
+        this->exec, this->comm};
+    batch.add_dot(this->x.get(), this->y.get(), this->res.get());
+    batch.add_norm2(this->y.get(), this->real_res.get());
+
+    batch.start();
+    ASSERT_TRUE(batch.is_pending());
+    ASSERT_EQ(batch.get_num_values(), 2 * this->size[1]);
+    this->dense_x->compute_dot(this->dense_y.get(), this->dense_res.get());
+    this->dense_y->compute_norm2(this->dense_real_res.get());
+    batch.wait();
+
+    ASSERT_FALSE(batch.is_pending());
+    GKO_ASSERT_MTX_NEAR(this->res, this->dense_res, r<value_type>::value);
+    GKO_ASSERT_MTX_NEAR(this->real_res, this->dense_real_res,
+                        r<value_type>::value);
+}
+
+
+TYPED_TEST(VectorReductions, ReductionBatchCanBeReused)
+{
+    using value_type = typename TestFixture::value_type;
+    this->init_result();
+    gko::experimental::distributed::ReductionBatch<value_type> batch{
+        this->exec, this->comm};
+    batch.add_norm2(this->x.get(), this->real_res.get());
+    batch.reduce();
+
+    batch.add_dot(this->y.get(), this->y.get(), this->res.get());
+    batch.reduce();
+    this->dense_x->compute_norm2(this->dense_real_res.get());
+    this->dense_y->compute_dot(this->dense_y.get(), this->dense_res.get());
+
+    GKO_ASSERT_MTX_NEAR(this->res, this->dense_res, r<value_type>::value);
+    GKO_ASSERT_MTX_NEAR(this->real_res, this->dense_real_res,
+                        r<value_type>::value);
+}
+
+
+TYPED_TEST(VectorReductions, ReductionBatchWithoutReductionsDoesNothing)
+{
+    using value_type = typename TestFixture::value_type;
+    gko::experimental::distributed::ReductionBatch<value_type> batch{
+        this->exec, this->comm};
+
+    batch.reduce();
+
+    ASSERT_FALSE(batch.is_pending());
+    ASSERT_EQ(batch.get_num_values(), 0);
+}
+
+
+TYPED_TEST(VectorReductions, ReductionBatchWithEmptyVectorsDoesNothing)
+{
+    using value_type = typename TestFixture::value_type;
+    using dist_vec_type = typename TestFixture::dist_vec_type;
+    using dense_type = typename TestFixture::dense_type;
+    using real_dense_type = typename TestFixture::real_dense_type;
+    auto empty = dist_vec_type::create(this->exec, this->comm);
+    auto res = dense_type::create(this->exec, gko::dim<2>{1, 0});
+    auto real_res = real_dense_type::create(this->exec, gko::dim<2>{1, 0});
+    gko::experimental::distributed::ReductionBatch<value_type> batch{
+        this->exec, this->comm};
+    batch.add_dot(empty.get(), empty.get(), res.get());
+    batch.add_norm2(empty.get(), real_res.get());
+
+    batch.reduce();
+
+    ASSERT_FALSE(batch.is_pending());
+    ASSERT_EQ(batch.get_num_values(), 0);
+    GKO_ASSERT_EQUAL_DIMENSIONS(res, gko::dim<2>(1, 0));
+}
+
+
+TYPED_TEST(VectorReductions, ReductionBatchThrowsOnAddWhilePending)
+{
+    using value_type = typename TestFixture::value_type;
+    this->init_result();
+    gko::experimental::distributed::ReductionBatch<value_type> batch{
+        this->exec, this->comm};
+    batch.add_dot(this->x.get(), this->y.get(), this->res.get());
+    batch.start();
+
+    ASSERT_THROW(batch.add_norm2(this->x.get(), this->real_res.get()),
+                 gko::ValueMismatch);
+    batch.wait();
+}
+
+
+TYPED_TEST(VectorReductions, ReductionBatchThrowsOnWrongResultSize)
+{
+    using value_type = typename TestFixture::value_type;
+    gko::experimental::distributed::ReductionBatch<value_type> batch{
+        this->exec, this->comm};
+    auto result = TestFixture::dense_type::create(this->exec, gko::dim<2>{1});
+
+    ASSERT_THROW(batch.add_dot(this->x.get(), this->y.get(), result.get()),
+                 gko::DimensionMismatch);
+}
+
+
 TYPED_TEST(VectorReductions, ComputeDotCopiesToHostOnlyIfNecessary)
 {
     this->init_result();
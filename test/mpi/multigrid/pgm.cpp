@@ -0,0 +1,261 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2022, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+
+#include <memory>
+
+
+#include <gtest/gtest.h>
+
+
+#include <ginkgo/core/base/matrix_data.hpp>
+#include <ginkgo/core/distributed/matrix.hpp>
+#include <ginkgo/core/distributed/partition.hpp>
+#include <ginkgo/core/distributed/preconditioner/schwarz.hpp>
+#include <ginkgo/core/distributed/vector.hpp>
+#include <ginkgo/core/factorization/lu.hpp>
+#include <ginkgo/core/matrix/csr.hpp>
+#include <ginkgo/core/matrix/dense.hpp>
+#include <ginkgo/core/multigrid/pgm.hpp>
+#include <ginkgo/core/preconditioner/jacobi.hpp>
+#include <ginkgo/core/solver/direct.hpp>
+#include <ginkgo/core/solver/multigrid.hpp>
+#include <ginkgo/core/stop/iteration.hpp>
+#include <ginkgo/core/stop/residual_norm.hpp>
+
+
+#include "core/test/utils.hpp"
+#include "test/utils/mpi/executor.hpp"
+
+
+template <typename ValueType>
+class Pgm : public CommonMpiTestFixture {
+protected:
+    using value_type = ValueType;
+    using local_index_type = gko::int32;
+    using global_index_type = gko::int64;
+    using part_type =
+        gko::experimental::distributed::Partition<local_index_type,
+                                                  global_index_type>;
+    using dist_mtx_type =
+        gko::experimental::distributed::Matrix<value_type, local_index_type,
+                                               global_index_type>;
+    using dist_vec_type = gko::experimental::distributed::Vector<value_type>;
+    using local_vec_type = gko::matrix::Dense<value_type>;
+    using pgm_type = gko::multigrid::Pgm<value_type, local_index_type>;
+    using schwarz_type =
+        gko::experimental::distributed::preconditioner::Schwarz<
+            value_type, local_index_type, global_index_type>;
+    using jacobi_type =
+        gko::preconditioner::Jacobi<value_type, local_index_type>;
+    using direct_type =
+        gko::experimental::solver::Direct<value_type, local_index_type>;
+    using lu_type =
+        gko::experimental::factorization::Lu<value_type, local_index_type>;
+    using mg_type = gko::solver::Multigrid;
+
+    Pgm() : size{num_rows, num_rows}, mat_input{size}
+    {
+        // 1D Laplacian
+        for (global_index_type i = 0; i < num_rows; i++) {
+            if (i > 0) {
+                mat_input.nonzeros.emplace_back(i, i - 1, -1);
+            }
+            mat_input.nonzeros.emplace_back(i, i, 2);
+            if (i < num_rows - 1) {
+                mat_input.nonzeros.emplace_back(i, i + 1, -1);
+            }
+        }
+        part = gko::share(
+            part_type::build_from_global_size_uniform(exec, 3, num_rows));
+        mat = gko::share(dist_mtx_type::create(exec, comm));
+        mat->read_distributed(mat_input, part.get());
+    }
+
+    void SetUp() override { ASSERT_EQ(comm.size(), 3); }
+
+    std::unique_ptr<dist_vec_type> create_vector(
+        std::shared_ptr<const part_type> vec_part, value_type start)
+    {
+        gko::matrix_data<value_type, global_index_type> data{
+            gko::dim<2>{vec_part->get_size(), 1}};
+        for (global_index_type i = 0; i < vec_part->get_size(); i++) {
+            data.nonzeros.emplace_back(i, 0,
+                                       start + static_cast<value_type>(i));
+        }
+        auto vec = dist_vec_type::create(exec, comm);
+        vec->read_distributed(data, vec_part.get());
+        return vec;
+    }
+
+    // checks coarse == restrict * fine * prolong by applying both to a vector
+    void assert_is_galerkin_product(const pgm_type* pgm)
+    {
+        auto coarse = gko::as<dist_mtx_type>(pgm->get_coarse_op());
+        auto coarse_part = coarse->get_row_partition();
+        auto v = create_vector(coarse_part, comm.rank() + 1);
+        auto result = create_vector(coarse_part, 0);
+        auto expected = create_vector(coarse_part, 0);
+        auto fine_v = create_vector(part, 0);
+        auto fine_av = create_vector(part, 0);
+
+        coarse->apply(v.get(), result.get());
+        pgm->get_prolong_op()->apply(v.get(), fine_v.get());
+        mat->apply(fine_v.get(), fine_av.get());
+        pgm->get_restrict_op()->apply(fine_av.get(), expected.get());
+
+        GKO_ASSERT_MTX_NEAR(result->get_local_vector(),
+                            expected->get_local_vector(),
+                            r<value_type>::value);
+    }
+
+    static constexpr global_index_type num_rows = 15;
+    gko::dim<2> size;
+    gko::matrix_data<value_type, global_index_type> mat_input;
+    std::shared_ptr<part_type> part;
+    std::shared_ptr<dist_mtx_type> mat;
+};
+
+TYPED_TEST_SUITE(Pgm, gko::test::ValueTypes, TypenameNameGenerator);
+
+
+TYPED_TEST(Pgm, KeepsAggregatesLocal)
+{
+    using index_type = typename TestFixture::local_index_type;
+    auto pgm = TestFixture::pgm_type::build()
+                   .with_deterministic(true)
+                   .on(this->exec)
+                   ->generate(this->mat);
+    auto coarse =
+        gko::as<typename TestFixture::dist_mtx_type>(pgm->get_coarse_op());
+    auto num_local_rows = this->part->get_part_size(this->comm.rank());
+    auto num_local_coarse =
+        coarse->get_row_partition()->get_part_size(this->comm.rank());
+    gko::array<index_type> agg(this->exec->get_master(), num_local_rows);
+    agg.get_executor()->copy_from(this->exec.get(), num_local_rows,
+                                  pgm->get_const_agg(), agg.get_data());
+
+    ASSERT_LT(coarse->get_size()[0], this->size[0]);
+    ASSERT_GT(num_local_coarse, 0);
+    for (index_type i = 0; i < num_local_rows; i++) {
+        ASSERT_GE(agg.get_const_data()[i], 0);
+        ASSERT_LT(agg.get_const_data()[i], num_local_coarse);
+    }
+}
+
+
+TYPED_TEST(Pgm, CoarseMatrixIsGalerkinProduct)
+{
+    auto pgm = TestFixture::pgm_type::build()
+                   .with_deterministic(true)
+                   .on(this->exec)
+                   ->generate(this->mat);
+
+    this->assert_is_galerkin_product(pgm.get());
+}
+
+
+TYPED_TEST(Pgm, AgglomeratesSmallCoarseLevel)
+{
+    auto pgm = TestFixture::pgm_type::build()
+                   .with_deterministic(true)
+                   .with_min_coarse_rows_per_rank(100u)
+                   .on(this->exec)
+                   ->generate(this->mat);
+    auto coarse =
+        gko::as<typename TestFixture::dist_mtx_type>(pgm->get_coarse_op());
+    auto coarse_part = coarse->get_row_partition();
+
+    ASSERT_EQ(coarse_part->get_part_size(0), coarse->get_size()[0]);
+    ASSERT_EQ(coarse_part->get_part_size(1), 0);
+    ASSERT_EQ(coarse_part->get_part_size(2), 0);
+    this->assert_is_galerkin_product(pgm.get());
+}
+
+
+TYPED_TEST(Pgm, MultigridSolvesDistributedSystem)
+{
+    using value_type = typename TestFixture::value_type;
+    auto exec = this->exec;
+    const gko::remove_complex<value_type> tol = 1e3 * r<value_type>::value;
+    auto smoother = gko::share(
+        TestFixture::schwarz_type::build()
+            .with_local_solver(
+                TestFixture::jacobi_type::build().with_max_block_size(1u).on(
+                    exec))
+            .on(exec));
+    // the coarsest level lives on a single rank, so block Jacobi is exact
+    auto coarsest = gko::share(
+        TestFixture::schwarz_type::build()
+            .with_local_solver(
+                TestFixture::direct_type::build()
+                    .with_factorization(TestFixture::lu_type::build()
+                                            .with_symmetric_sparsity(true)
+                                            .on(exec))
+                    .on(exec))
+            .on(exec));
+    auto solver =
+        TestFixture::mg_type::build()
+            .with_mg_level(TestFixture::pgm_type::build()
+                               .with_deterministic(true)
+                               .with_min_coarse_rows_per_rank(4u)
+                               .on(exec))
+            .with_pre_smoother(smoother)
+            .with_coarsest_solver(coarsest)
+            .with_min_coarse_rows(4u)
+            .with_criteria(
+                gko::stop::Iteration::build().with_max_iters(100u).on(exec),
+                gko::stop::ResidualNorm<value_type>::build()
+                    .with_reduction_factor(tol)
+                    .on(exec))
+            .on(exec)
+            ->generate(this->mat);
+    auto b = this->create_vector(this->part, 1);
+    auto x = this->create_vector(this->part, 0);
+    x->fill(gko::zero<value_type>());
+    auto res = gko::clone(b);
+    auto one = gko::initialize<typename TestFixture::local_vec_type>(
+        {gko::one<value_type>()}, exec);
+    auto neg_one = gko::initialize<typename TestFixture::local_vec_type>(
+        {-gko::one<value_type>()}, exec);
+
+    solver->apply(b.get(), x.get());
+
+    this->mat->apply(neg_one.get(), x.get(), one.get(), res.get());
+    auto b_norm = gko::matrix::Dense<gko::remove_complex<value_type>>::create(
+        exec->get_master(), gko::dim<2>{1, 1});
+    auto res_norm = gko::clone(b_norm);
+    b->compute_norm2(b_norm.get());
+    res->compute_norm2(res_norm.get());
+    ASSERT_GT(solver->get_mg_level_list().size(), 1);
+    ASSERT_LE(res_norm->at(0, 0), tol * b_norm->at(0, 0));
+}
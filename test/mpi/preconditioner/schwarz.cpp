@@ -0,0 +1,250 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2022, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+
+#include <memory>
+
+
+#include <gtest/gtest.h>
+
+
+#include <ginkgo/core/base/matrix_data.hpp>
+#include <ginkgo/core/distributed/matrix.hpp>
+#include <ginkgo/core/distributed/partition.hpp>
+#include <ginkgo/core/distributed/preconditioner/schwarz.hpp>
+#include <ginkgo/core/distributed/vector.hpp>
+#include <ginkgo/core/factorization/lu.hpp>
+#include <ginkgo/core/matrix/csr.hpp>
+#include <ginkgo/core/matrix/dense.hpp>
+#include <ginkgo/core/solver/direct.hpp>
+
+
+#include "core/test/utils.hpp"
+#include "test/utils/mpi/executor.hpp"
+
+
+template <typename ValueType>
+class Schwarz : public CommonMpiTestFixture {
+protected:
+    using value_type = ValueType;
+    using local_index_type = gko::int32;
+    using global_index_type = gko::int64;
+    using part_type =
+        gko::experimental::distributed::Partition<local_index_type,
+                                                  global_index_type>;
+    using dist_mtx_type =
+        gko::experimental::distributed::Matrix<value_type, local_index_type,
+                                               global_index_type>;
+    using dist_vec_type = gko::experimental::distributed::Vector<value_type>;
+    using local_matrix_type = gko::matrix::Csr<value_type, local_index_type>;
+    using schwarz_type =
+        gko::experimental::distributed::preconditioner::Schwarz<
+            value_type, local_index_type, global_index_type>;
+    using direct_type =
+        gko::experimental::solver::Direct<value_type, local_index_type>;
+    using lu_type =
+        gko::experimental::factorization::Lu<value_type, local_index_type>;
+
+    Schwarz()
+        : size{5, 5},
+          mat_input{size,
+                    {{0, 0, 4},
+                     {0, 1, -1},
+                     {0, 4, -2},
+                     {1, 0, -1},
+                     {1, 1, 4},
+                     {1, 2, -1},
+                     {2, 1, -1},
+                     {2, 2, 4},
+                     {2, 3, -1},
+                     {3, 2, -1},
+                     {3, 3, 4},
+                     {3, 4, -1},
+                     {4, 0, -2},
+                     {4, 3, -1},
+                     {4, 4, 4}}},
+          vec_input{I<I<value_type>>{{1}, {2}, {3}, {4}, {5}}}
+    {
+        part = gko::share(part_type::build_from_contiguous(
+            exec, gko::array<global_index_type>(
+                      exec, I<global_index_type>{0, 2, 4, 5})));
+        mat = gko::share(dist_mtx_type::create(exec, comm));
+        mat->read_distributed(mat_input, part.get());
+        b = dist_vec_type::create(exec, comm);
+        b->read_distributed(vec_input, part.get());
+        x = dist_vec_type::create(exec, comm);
+        x->read_distributed(vec_input, part.get());
+        x->fill(gko::zero<value_type>());
+        direct_factory = gko::share(
+            direct_type::build()
+                .with_factorization(
+                    lu_type::build().with_symmetric_sparsity(true).on(exec))
+                .on(exec));
+    }
+
+    void SetUp() override { ASSERT_EQ(comm.size(), 3); }
+
+    gko::dim<2> size;
+    gko::matrix_data<value_type, global_index_type> mat_input;
+    gko::matrix_data<value_type, global_index_type> vec_input;
+    std::shared_ptr<part_type> part;
+    std::shared_ptr<dist_mtx_type> mat;
+    std::unique_ptr<dist_vec_type> b;
+    std::unique_ptr<dist_vec_type> x;
+    std::shared_ptr<typename direct_type::Factory> direct_factory;
+};
+
+TYPED_TEST_SUITE(Schwarz, gko::test::ValueTypes, TypenameNameGenerator);
+
+
+TYPED_TEST(Schwarz, BuildsBlockJacobiWithoutOverlap)
+{
+    using value_type = typename TestFixture::value_type;
+    using csr = typename TestFixture::local_matrix_type;
+    I<I<value_type>> res_local[] = {{{4, -1}, {-1, 4}}, {{4, -1}, {-1, 4}},
+                                    {{4}}};
+    auto rank = this->comm.rank();
+
+    auto precond = TestFixture::schwarz_type::build()
+                       .with_local_solver(this->direct_factory)
+                       .on(this->exec)
+                       ->generate(this->mat);
+
+    GKO_ASSERT_MTX_NEAR(gko::as<csr>(precond->get_local_matrix()),
+                        res_local[rank], 0);
+}
+
+
+TYPED_TEST(Schwarz, AppliesBlockJacobiWithoutOverlap)
+{
+    using value_type = typename TestFixture::value_type;
+    I<I<value_type>> result[] = {
+        {{2.0 / 5}, {3.0 / 5}}, {{16.0 / 15}, {19.0 / 15}}, {{5.0 / 4}}};
+    auto rank = this->comm.rank();
+    auto precond = TestFixture::schwarz_type::build()
+                       .with_local_solver(this->direct_factory)
+                       .on(this->exec)
+                       ->generate(this->mat);
+
+    precond->apply(this->b.get(), this->x.get());
+
+    GKO_ASSERT_MTX_NEAR(this->x->get_local_vector(), result[rank],
+                        r<value_type>::value);
+}
+
+
+TYPED_TEST(Schwarz, BuildsOverlappingLocalMatrix)
+{
+    using value_type = typename TestFixture::value_type;
+    using csr = typename TestFixture::local_matrix_type;
+    // the halo rows are ordered by owning rank, then by global index
+    I<I<value_type>> res_local[] = {
+        {{4, -1, 0, -2}, {-1, 4, -1, 0}, {0, -1, 4, 0}, {-2, 0, 0, 4}},
+        {{4, -1, -1, 0}, {-1, 4, 0, -1}, {-1, 0, 4, 0}, {0, -1, 0, 4}},
+        {{4, -2, -1}, {-2, 4, 0}, {-1, 0, 4}}};
+    auto rank = this->comm.rank();
+
+    auto precond = TestFixture::schwarz_type::build()
+                       .with_local_solver(this->direct_factory)
+                       .with_overlap(1u)
+                       .on(this->exec)
+                       ->generate(this->mat);
+
+    GKO_ASSERT_MTX_NEAR(gko::as<csr>(precond->get_local_matrix()),
+                        res_local[rank], 0);
+}
+
+
+TYPED_TEST(Schwarz, ThrowsOnOverlapWithDifferentRowAndColPartition)
+{
+    using part_type = typename TestFixture::part_type;
+    using dist_mtx_type = typename TestFixture::dist_mtx_type;
+    auto col_part = gko::share(part_type::build_from_mapping(
+        this->exec,
+        gko::array<gko::experimental::distributed::comm_index_type>(
+            this->exec,
+            I<gko::experimental::distributed::comm_index_type>{1, 1, 2, 0,
+                                                               0}),
+        3));
+    auto mat = gko::share(dist_mtx_type::create(this->exec, this->comm));
+    mat->read_distributed(this->mat_input, this->part.get(), col_part.get());
+    auto factory = TestFixture::schwarz_type::build()
+                       .with_local_solver(this->direct_factory)
+                       .with_overlap(1u)
+                       .on(this->exec);
+
+    ASSERT_THROW(factory->generate(mat), gko::NotSupported);
+}
+
+
+TYPED_TEST(Schwarz, AppliesRestrictedAdditiveSchwarz)
+{
+    using value_type = typename TestFixture::value_type;
+    I<I<value_type>> result[] = {{{127.0 / 82}, {47.0 / 41}},
+                                 {{294.0 / 209}, {371.0 / 209}},
+                                 {{26.0 / 11}}};
+    auto rank = this->comm.rank();
+    auto precond = TestFixture::schwarz_type::build()
+                       .with_local_solver(this->direct_factory)
+                       .with_overlap(1u)
+                       .on(this->exec)
+                       ->generate(this->mat);
+
+    precond->apply(this->b.get(), this->x.get());
+
+    GKO_ASSERT_MTX_NEAR(this->x->get_local_vector(), result[rank],
+                        r<value_type>::value);
+}
+
+
+TYPED_TEST(Schwarz, AdvancedAppliesRestrictedAdditiveSchwarz)
+{
+    using value_type = typename TestFixture::value_type;
+    using dense_type = gko::matrix::Dense<value_type>;
+    I<I<value_type>> result[] = {{{2 * 127.0 / 82 - 1}, {2 * 47.0 / 41 - 2}},
+                                 {{2 * 294.0 / 209 - 3}, {2 * 371.0 / 209 - 4}},
+                                 {{2 * 26.0 / 11 - 5}}};
+    auto rank = this->comm.rank();
+    auto alpha = gko::initialize<dense_type>({2.0}, this->exec);
+    auto beta = gko::initialize<dense_type>({-1.0}, this->exec);
+    this->x->copy_from(this->b.get());
+    auto precond = TestFixture::schwarz_type::build()
+                       .with_local_solver(this->direct_factory)
+                       .with_overlap(1u)
+                       .on(this->exec)
+                       ->generate(this->mat);
+
+    precond->apply(alpha.get(), this->b.get(), beta.get(), this->x.get());
+
+    GKO_ASSERT_MTX_NEAR(this->x->get_local_vector(), result[rank],
+                        10 * r<value_type>::value);
+}
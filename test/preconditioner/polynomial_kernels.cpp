@@ -0,0 +1,216 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2022, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+
+#include "core/preconditioner/polynomial_kernels.hpp"
+
+
+#include <random>
+
+
+#include <gtest/gtest.h>
+
+
+#include <ginkgo/core/base/executor.hpp>
+#include <ginkgo/core/matrix/csr.hpp>
+#include <ginkgo/core/matrix/dense.hpp>
+#include <ginkgo/core/preconditioner/polynomial.hpp>
+
+
+#include "core/test/utils.hpp"
+#include "core/utils/matrix_utils.hpp"
+#include "test/utils/executor.hpp"
+
+
+class Polynomial : public CommonTestFixture {
+protected:
+    using Mtx = gko::matrix::Dense<value_type>;
+    using Csr = gko::matrix::Csr<value_type, index_type>;
+    using Poly = gko::preconditioner::Polynomial<value_type>;
+    using kind = gko::preconditioner::polynomial::kind;
+
+    Polynomial() : rand_engine(15) {}
+
+    std::unique_ptr<Mtx> gen_mtx(gko::size_type num_rows,
+                                 gko::size_type num_cols, gko::size_type stride)
+    {
+        auto tmp_mtx = gko::test::generate_random_matrix<Mtx>(
+            num_rows, num_cols,
+            std::uniform_int_distribution<>(num_cols, num_cols),
+            std::normal_distribution<value_type>(-1.0, 1.0), rand_engine, ref);
+        auto result = Mtx::create(ref, gko::dim<2>{num_rows, num_cols}, stride);
+        result->copy_from(tmp_mtx.get());
+        return result;
+    }
+
+    void initialize_data()
+    {
+        gko::size_type m = 597;
+        gko::size_type n = 43;
+        b = gen_mtx(m, n, n + 2);
+        y = gen_mtx(m, n, n + 1);
+        r = gen_mtx(m, n, n);
+        d = gen_mtx(m, n, n + 3);
+        x = gen_mtx(m, n, n + 2);
+        auto data =
+            gko::test::generate_random_matrix_data<value_type, index_type>(
+                m, m, std::uniform_int_distribution<>(2, 10),
+                std::normal_distribution<value_type>(0.0, 1.0), rand_engine);
+        gko::utils::make_hpd(data);
+        mtx = gko::share(Csr::create(ref));
+        mtx->read(data);
+
+        d_b = gko::clone(exec, b);
+        d_y = gko::clone(exec, y);
+        d_r = gko::clone(exec, r);
+        d_d = gko::clone(exec, d);
+        d_x = gko::clone(exec, x);
+        d_mtx = gko::share(gko::clone(exec, mtx));
+    }
+
+    void test_apply(kind poly_kind)
+    {
+        initialize_data();
+        auto factory = Poly::build()
+                           .with_kind(poly_kind)
+                           .with_degree(4u)
+                           .with_max_eigenvalue(30.0)
+                           .with_min_eigenvalue(1.0);
+
+        factory.on(ref)->generate(mtx)->apply(b.get(), x.get());
+        factory.on(exec)->generate(d_mtx)->apply(d_b.get(), d_x.get());
+
+        GKO_ASSERT_MTX_NEAR(d_x, x, ::r<value_type>::value * 10);
+    }
+
+    std::default_random_engine rand_engine;
+
+    std::unique_ptr<Mtx> b;
+    std::unique_ptr<Mtx> y;
+    std::unique_ptr<Mtx> r;
+    std::unique_ptr<Mtx> d;
+    std::unique_ptr<Mtx> x;
+    std::shared_ptr<Csr> mtx;
+
+    std::unique_ptr<Mtx> d_b;
+    std::unique_ptr<Mtx> d_y;
+    std::unique_ptr<Mtx> d_r;
+    std::unique_ptr<Mtx> d_d;
+    std::unique_ptr<Mtx> d_x;
+    std::shared_ptr<Csr> d_mtx;
+};
+
+
+TEST_F(Polynomial, HornerStepIsEquivalentToRef)
+{
+    initialize_data();
+    const value_type alpha = 0.5;
+    const value_type beta = -1.5;
+    const value_type gamma = 2.0;
+
+    gko::kernels::reference::polynomial::horner_step(
+        ref, alpha, y.get(), beta, gamma, b.get(), x.get());
+    gko::kernels::EXEC_NAMESPACE::polynomial::horner_step(
+        exec, alpha, d_y.get(), beta, gamma, d_b.get(), d_x.get());
+
+    GKO_ASSERT_MTX_NEAR(d_x, x, ::r<value_type>::value);
+}
+
+
+TEST_F(Polynomial, HornerStepIgnoresXForZeroBetaLikeRef)
+{
+    initialize_data();
+    const value_type alpha = 0.5;
+    const value_type gamma = 2.0;
+    x->fill(gko::nan<value_type>());
+    d_x->fill(gko::nan<value_type>());
+
+    gko::kernels::reference::polynomial::horner_step(
+        ref, alpha, y.get(), gko::zero<value_type>(), gamma, b.get(),
+        x.get());
+    gko::kernels::EXEC_NAMESPACE::polynomial::horner_step(
+        exec, alpha, d_y.get(), gko::zero<value_type>(), gamma, d_b.get(),
+        d_x.get());
+
+    GKO_ASSERT_MTX_NEAR(d_x, x, ::r<value_type>::value);
+}
+
+
+TEST_F(Polynomial, ChebyshevInitializeIsEquivalentToRef)
+{
+    initialize_data();
+    const value_type inv_theta = 0.25;
+
+    gko::kernels::reference::polynomial::chebyshev_initialize(
+        ref, b.get(), inv_theta, r.get(), d.get(), x.get());
+    gko::kernels::EXEC_NAMESPACE::polynomial::chebyshev_initialize(
+        exec, d_b.get(), inv_theta, d_r.get(), d_d.get(), d_x.get());
+
+    GKO_ASSERT_MTX_NEAR(d_r, r, 0);
+    GKO_ASSERT_MTX_NEAR(d_d, d, ::r<value_type>::value);
+    GKO_ASSERT_MTX_NEAR(d_x, x, ::r<value_type>::value);
+}
+
+
+TEST_F(Polynomial, ChebyshevStepIsEquivalentToRef)
+{
+    initialize_data();
+    const value_type c_d = 0.3;
+    const value_type c_r = 1.7;
+
+    gko::kernels::reference::polynomial::chebyshev_step(
+        ref, y.get(), c_d, c_r, r.get(), d.get(), x.get());
+    gko::kernels::EXEC_NAMESPACE::polynomial::chebyshev_step(
+        exec, d_y.get(), c_d, c_r, d_r.get(), d_d.get(), d_x.get());
+
+    GKO_ASSERT_MTX_NEAR(d_r, r, ::r<value_type>::value);
+    GKO_ASSERT_MTX_NEAR(d_d, d, ::r<value_type>::value);
+    GKO_ASSERT_MTX_NEAR(d_x, x, ::r<value_type>::value);
+}
+
+
+TEST_F(Polynomial, NeumannApplyIsEquivalentToRef)
+{
+    test_apply(kind::neumann);
+}
+
+
+TEST_F(Polynomial, ChebyshevApplyIsEquivalentToRef)
+{
+    test_apply(kind::chebyshev);
+}
+
+
+TEST_F(Polynomial, LeastSquaresApplyIsEquivalentToRef)
+{
+    test_apply(kind::least_squares);
+}
@@ -0,0 +1,142 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2022, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+
+#include <ginkgo/core/preconditioner/spai.hpp>
+
+
+#include <random>
+
+
+#include <gtest/gtest.h>
+
+
+#include <ginkgo/core/base/composition.hpp>
+#include <ginkgo/core/base/executor.hpp>
+#include <ginkgo/core/matrix/csr.hpp>
+#include <ginkgo/core/matrix/dense.hpp>
+
+
+#include "core/preconditioner/spai_kernels.hpp"
+#include "core/test/utils.hpp"
+#include "core/utils/matrix_utils.hpp"
+#include "test/utils/executor.hpp"
+
+
+class Spai : public CommonTestFixture {
+protected:
+    using Csr = gko::matrix::Csr<value_type, index_type>;
+    using Dense = gko::matrix::Dense<value_type>;
+    using GeneralSpai =
+        gko::preconditioner::GeneralSpai<value_type, index_type>;
+    using SpdSpai = gko::preconditioner::SpdSpai<value_type, index_type>;
+
+    Spai() : rand_engine(42) {}
+
+    void initialize_data(bool hpd)
+    {
+        gko::size_type n = 493;
+        auto data =
+            gko::test::generate_random_matrix_data<value_type, index_type>(
+                n, n, std::uniform_int_distribution<>(1, 8),
+                std::normal_distribution<value_type>(0.0, 1.0), rand_engine);
+        if (hpd) {
+            gko::utils::make_hpd(data);
+        } else {
+            gko::utils::make_diag_dominant(data);
+        }
+        mtx = gko::share(Csr::create(ref));
+        mtx->read(data);
+        b = gko::test::generate_random_matrix<Dense>(
+            n, 3, std::uniform_int_distribution<>(3, 3),
+            std::normal_distribution<value_type>(0.0, 1.0), rand_engine, ref);
+        x = Dense::create(ref, gko::dim<2>{n, 3});
+        d_mtx = gko::share(gko::clone(exec, mtx));
+        d_b = gko::clone(exec, b);
+        d_x = gko::clone(exec, x);
+    }
+
+    std::default_random_engine rand_engine;
+
+    std::shared_ptr<Csr> mtx;
+    std::unique_ptr<Dense> b;
+    std::unique_ptr<Dense> x;
+
+    std::shared_ptr<Csr> d_mtx;
+    std::unique_ptr<Dense> d_b;
+    std::unique_ptr<Dense> d_x;
+};
+
+
+TEST_F(Spai, GeneralSpaiIsEquivalentToRef)
+{
+    initialize_data(false);
+    auto factory = GeneralSpai::build().with_adaptive_steps(3);
+
+    auto spai = factory.on(ref)->generate(mtx);
+    auto d_spai = factory.on(exec)->generate(d_mtx);
+
+    GKO_ASSERT_MTX_EQ_SPARSITY(d_spai->get_approximate_inverse(),
+                               spai->get_approximate_inverse());
+    GKO_ASSERT_MTX_NEAR(d_spai->get_approximate_inverse(),
+                        spai->get_approximate_inverse(),
+                        r<value_type>::value * 10);
+}
+
+
+TEST_F(Spai, SpdSpaiIsEquivalentToRef)
+{
+    initialize_data(true);
+    auto factory = SpdSpai::build().with_adaptive_steps(3);
+
+    auto spai = factory.on(ref)->generate(mtx);
+    auto d_spai = factory.on(exec)->generate(d_mtx);
+    auto factor =
+        gko::as<Csr>(spai->get_approximate_inverse()->get_operators()[1]);
+    auto d_factor =
+        gko::as<Csr>(d_spai->get_approximate_inverse()->get_operators()[1]);
+
+    GKO_ASSERT_MTX_EQ_SPARSITY(d_factor, factor);
+    GKO_ASSERT_MTX_NEAR(d_factor, factor, r<value_type>::value * 10);
+}
+
+
+TEST_F(Spai, SpdSpaiApplyIsEquivalentToRef)
+{
+    initialize_data(true);
+    auto factory = SpdSpai::build();
+
+    factory.on(ref)->generate(mtx)->apply(b.get(), x.get());
+    factory.on(exec)->generate(d_mtx)->apply(d_b.get(), d_x.get());
+
+    GKO_ASSERT_MTX_NEAR(d_x, x, r<value_type>::value * 10);
+}
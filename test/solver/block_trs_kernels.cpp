@@ -0,0 +1,125 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2022, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#include <ginkgo/core/solver/block_triangular.hpp>
+
+
+#include <memory>
+#include <random>
+
+
+#include <gtest/gtest.h>
+
+
+#include <ginkgo/core/base/executor.hpp>
+#include <ginkgo/core/matrix/dense.hpp>
+#include <ginkgo/core/matrix/fbcsr.hpp>
+
+
+#include "core/test/utils.hpp"
+#include "core/test/utils/fb_matrix_generator.hpp"
+#include "test/utils/executor.hpp"
+
+
+class BlockTrs : public CommonTestFixture {
+protected:
+    using Fbcsr = gko::matrix::Fbcsr<value_type, index_type>;
+    using Dense = gko::matrix::Dense<value_type>;
+    using lower_type = gko::solver::BlockLowerTrs<value_type, index_type>;
+    using upper_type = gko::solver::BlockUpperTrs<value_type, index_type>;
+
+    BlockTrs() : rand_engine(42) {}
+
+    void initialize_data(index_type num_brows, int block_size, int num_rhs)
+    {
+        mtx = gko::test::generate_random_fbcsr<value_type>(
+            ref, num_brows, num_brows, block_size, true, false, rand_engine);
+        const auto num_rows = num_brows * block_size;
+        b = gko::test::generate_random_matrix<Dense>(
+            num_rows, num_rhs,
+            std::uniform_int_distribution<>(num_rhs, num_rhs),
+            std::normal_distribution<>(-1.0, 1.0), rand_engine, ref);
+        x = Dense::create(ref, gko::dim<2>(num_rows, num_rhs));
+        dmtx = gko::clone(exec, mtx);
+        db = gko::clone(exec, b);
+        dx = gko::clone(exec, x);
+    }
+
+    std::default_random_engine rand_engine;
+    std::shared_ptr<Fbcsr> mtx;
+    std::shared_ptr<Fbcsr> dmtx;
+    std::unique_ptr<Dense> b;
+    std::unique_ptr<Dense> db;
+    std::unique_ptr<Dense> x;
+    std::unique_ptr<Dense> dx;
+};
+
+
+TEST_F(BlockTrs, LowerSolveIsEquivalentToRef)
+{
+    initialize_data(97, 3, 1);
+
+    lower_type::build().on(ref)->generate(mtx)->apply(b.get(), x.get());
+    lower_type::build().on(exec)->generate(dmtx)->apply(db.get(), dx.get());
+
+    GKO_ASSERT_MTX_NEAR(x, dx, r<value_type>::value * 100);
+}
+
+
+TEST_F(BlockTrs, UpperSolveMultipleRhsIsEquivalentToRef)
+{
+    initialize_data(97, 4, 5);
+
+    upper_type::build().on(ref)->generate(mtx)->apply(b.get(), x.get());
+    upper_type::build().on(exec)->generate(dmtx)->apply(db.get(), dx.get());
+
+    GKO_ASSERT_MTX_NEAR(x, dx, r<value_type>::value * 100);
+}
+
+
+TEST_F(BlockTrs, UnitDiagonalLowerSolveIsEquivalentToRef)
+{
+    initialize_data(97, 2, 3);
+
+    lower_type::build()
+        .with_unit_diagonal(true)
+        .on(ref)
+        ->generate(mtx)
+        ->apply(b.get(), x.get());
+    lower_type::build()
+        .with_unit_diagonal(true)
+        .on(exec)
+        ->generate(dmtx)
+        ->apply(db.get(), dx.get());
+
+    GKO_ASSERT_MTX_NEAR(x, dx, r<value_type>::value * 100);
+}